@@ -183,6 +183,12 @@
 
   \snippet cs_user_parameters-base.c setup_log
 
+  Field statistics may be logged one logged time step later (or at the
+  end of the computation), so that the associated parallel reductions
+  do not synchronize the time loop.
+
+  \snippet cs_user_parameters-base.c setup_log_deferred
+
   Change a property's label (here for density, first checking if it
   is variable). A field's name cannot be changed, but its label,
   used for logging and postprocessing output, may be redefined.
@@ -363,6 +369,16 @@
 
   \snippet cs_user_parameters-linear_solvers.c sles_user_1
 
+  \subsection cs_user_parameters_h_sles_tuning_1 Example: run-time solver selection
+
+  The following example shows how to let the code select the fastest
+  solver and preconditioner combination for the pressure during the
+  first time steps. Timings are logged in the performance log, and
+  the selection is saved in the checkpoint directory so that a restarted
+  computation may reuse it.
+
+  \snippet cs_user_parameters-linear_solvers.c sles_tuning_1
+
   \subsection cs_user_parameters_h_sles_verbosity_1 Changing the verbosity
 
   By default, a linear solver uses the same verbosity as its matching variable,
@@ -57,6 +57,7 @@
 #include "ecs_file.h"
 #include "ecs_mem.h"
 #include "ecs_tab.h"
+#include "ecs_timer.h"
 
 
 /*----------------------------------------------------------------------------
@@ -98,11 +99,30 @@
 
 #include "ecs_maillage_priv.h"
 
+#if defined(HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 
 /*============================================================================
  *                              Fonctions privées
  *============================================================================*/
 
+/*----------------------------------------------------------------------------
+ *  Fonction d'affichage d'une durée d'étape
+ *----------------------------------------------------------------------------*/
+
+static void
+_maillage_aff_temps(const char  *descr,
+                    double       duree)
+{
+  printf("    ");
+  ecs_print_padded_str(descr, ECS_LNG_AFF_STR - 2);
+  printf(" : %*.*f\n",
+         ECS_LNG_AFF_REE_MANTIS, ECS_LNG_AFF_REE_PRECIS,
+         (float)duree);
+}
+
 /*----------------------------------------------------------------------------
  *  Fonction d'impression d'une table avec position réglée en ASCII
  *----------------------------------------------------------------------------*/
@@ -1261,6 +1281,9 @@ ecs_maillage__connect_descend(ecs_maillage_t * maillage)
 
   ecs_size_t nbr_fac_old = 0;
 
+  int n_threads = 1;
+  double t0, t1, t2, t3;
+
   /*xxxxxxxxxxxxxxxxxxxxxxxxxxx Instructions xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx*/
 
   assert(maillage != NULL);
@@ -1274,6 +1297,8 @@ ecs_maillage__connect_descend(ecs_maillage_t * maillage)
   /* Decompose cells into faces */
   /*----------------------------*/
 
+  t0 = ecs_timer_wtime();
+
   if (maillage->table_def[ECS_ENTMAIL_FAC] != NULL)
     nbr_fac_old = ecs_table__ret_elt_nbr(maillage->table_def[ECS_ENTMAIL_FAC]);
 
@@ -1282,6 +1307,8 @@ ecs_maillage__connect_descend(ecs_maillage_t * maillage)
 
   assert(maillage->table_att[ECS_ENTMAIL_FAC] == NULL);
 
+  t1 = ecs_timer_wtime();
+
   /* Merge coincident vertices (update face connectivity ) */
   /*-------------------------------------------------------*/
 
@@ -1289,6 +1316,8 @@ ecs_maillage__connect_descend(ecs_maillage_t * maillage)
                                  &(maillage->vertex_coords),
                                  maillage->table_def[ECS_ENTMAIL_FAC]);
 
+  t2 = ecs_timer_wtime();
+
   /* Merge faces with the same definition */
   /*--------------------------------------*/
 
@@ -1328,6 +1357,20 @@ ecs_maillage__connect_descend(ecs_maillage_t * maillage)
   /* Remove degenerate (empty) faces if present */
 
   _maillage__nettoie_descend(maillage);
+
+  t3 = ecs_timer_wtime();
+
+  /* Log timings */
+
+#if defined(HAVE_OPENMP)
+  n_threads = omp_get_max_threads();
+#endif
+
+  printf(_("\n  Descending connectivity (%d thread(s)):\n\n"), n_threads);
+
+  _maillage_aff_temps(_("Decomposition of cells into faces (sec)"), t1 - t0);
+  _maillage_aff_temps(_("Merging of coincident vertices    (sec)"), t2 - t1);
+  _maillage_aff_temps(_("Merging of identical faces        (sec)"), t3 - t2);
 }
 
 /*----------------------------------------------------------------------------
@@ -75,6 +75,10 @@
 
 #include "ecs_table_priv.h"
 
+#if defined(HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 
 /*============================================================================
  *                       Macros globales au fichier
@@ -83,6 +87,12 @@
 /* Longueur maximale du nom d'un type d'élément (+1 pour le `\0' !) */
 #define ECS_LOC_LNG_MAX_NOM_TYP    11
 
+/* Nombre minimal d'éléments pour le traitement multi-thread */
+#define ECS_LOC_THR_MIN          128
+
+/* Taille des blocs triés par insertion avant fusion */
+#define ECS_LOC_TRI_BLOC          32
+
 #if !defined(FLT_MAX)
 #define FLT_MAX HUGE_VAL
 #endif
@@ -103,6 +113,32 @@ prod_vect[2] = vect1[0] * vect2[1] - vect2[0] * vect1[1]   )
  + ((vect2[0] * vect1[2] - vect1[0] * vect2[2]) * vect3[1]) \
  + ((vect1[0] * vect2[1] - vect2[0] * vect1[1]) * vect3[2]) )
 
+/*============================================================================
+ *                         Définitions de types locaux
+ *============================================================================*/
+
+/* Forme canonique d'un élément pour la fusion par tri */
+
+typedef struct {
+
+  ecs_int_t   v[2];      /* Deux premiers sous-éléments de la forme
+                            canonique (pour comparaison rapide) */
+  ecs_int_t   ind;       /* Indice de l'élément */
+
+} _canon_t;
+
+/* Données de comparaison des formes canoniques */
+
+typedef struct {
+
+  const ecs_table_t  *table_def;  /* Définition des éléments */
+  const ecs_size_t   *pos_min;    /* Position du sous-élément de plus petit
+                                     numéro de chaque élément */
+  const signed char  *sgn;        /* Sens de parcours de la forme canonique
+                                     de chaque élément */
+
+} _canon_ctx_t;
+
 /*============================================================================
  *                              Fonctions privees
  *============================================================================*/
@@ -1402,490 +1438,464 @@ _orient_polyhedron(const ecs_coord_t   coord[],
   return retval;
 }
 
-/*============================================================================
- *                             Fonctions publiques
- *============================================================================*/
-
 /*----------------------------------------------------------------------------
- *  Fonction qui réalise le tri des types géométriques
- *  La fonction affiche le nombre d'éléments par type géométrique
+ *  Fonction qui renvoie le nombre de threads utilisables pour un
+ *  traitement portant sur n éléments
  *----------------------------------------------------------------------------*/
 
-ecs_tab_int_t
-ecs_table_def__trie_typ(ecs_table_t  *this_table_def,
-                        int           dim_elt)
+static int
+_table_def__n_threads(size_t  n)
 {
-  size_t       ielt;
-  size_t       nbr_elt;
-  size_t       nbr_som;
+  int n_t = 1;
 
-  ecs_tab_int_t   tab_typ_geo_ord;
-  ecs_tab_int_t   tab_typ_geo;
-  ecs_tab_int_t   vect_renum;
+  if (n > ECS_LOC_THR_MIN) {
+#if defined(HAVE_OPENMP)
+    n_t = omp_get_max_threads();
+#endif
+  }
 
-  ecs_elt_typ_t   typ_geo;
+  return n_t;
+}
 
-  const ecs_elt_typ_t  *typ_geo_base;
+/*----------------------------------------------------------------------------
+ *  Fonction qui détermine la forme canonique d'un élément défini par une
+ *  liste cyclique de sous-éléments : départ sur le sous-élément de plus
+ *  petit numéro, et sens de parcours donnant la plus petite séquence.
+ *
+ *  Renvoie 1 si l'élément est dégénéré (moins de 2 sous-éléments, ou
+ *  sous-éléments répétés), auquel cas la forme canonique n'est pas définie.
+ *----------------------------------------------------------------------------*/
 
-  const int lng_imp = ECS_LNG_AFF_STR - ECS_LOC_LNG_MAX_NOM_TYP;
+static int
+_table_def__canonique(const ecs_table_t  *table_def,
+                      size_t              ind,
+                      ecs_size_t         *pos_min,
+                      signed char        *sgn,
+                      _canon_t           *canon)
+{
+  size_t i, j, k;
 
-  /*xxxxxxxxxxxxxxxxxxxxxxxxxxx Instructions xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx*/
+  const size_t s_id = table_def->pos[ind] - 1;
+  const size_t e_id = table_def->pos[ind + 1] - 1;
+  const size_t n = e_id - s_id;
+  const ecs_int_t *val = table_def->val + s_id;
 
-  assert(this_table_def != NULL);
+  size_t i_min = 0;
+  int retval = 0;
 
-  vect_renum.nbr = 0   ;
-  vect_renum.val = NULL;
+  *pos_min = s_id;
+  *sgn = 1;
 
-  nbr_elt = this_table_def->nbr;
+  canon->v[0] = 0;
+  canon->v[1] = 0;
+  canon->ind = ind;
 
-  if (nbr_elt == 0)
-    return vect_renum;
+  if (n < 2)
+    return 1;
 
-  /* Détermination de base du type d'élément "classique" */
+  for (i = 0; i < n; i++) {
+    ecs_int_t v = ECS_ABS(val[i]);
+    if (v < ECS_ABS(val[i_min]))
+      i_min = i;
+    for (j = i + 1; j < n; j++) {
+      if (v == ECS_ABS(val[j]))
+        retval = 1;
+    }
+  }
 
-  assert(dim_elt >=2 && dim_elt <= 3);
+  *pos_min = s_id + i_min;
 
-  typ_geo_base = ecs_glob_typ_elt[dim_elt - 2];
+  canon->v[0] = ECS_ABS(val[i_min]);
+  canon->v[1] = ECS_ABS(val[(i_min + 1) % n]);
 
-  /* Si tous les éléments sont de même type, rien à faire */
-  /*------------------------------------------------------*/
+  /* Pour 2 sous-éléments, les deux sens de parcours sont identiques ;
+     on conserve l'orientation relative au premier sous-élément */
 
-  if (this_table_def->pos == NULL) {
+  if (n == 2) {
+    if (i_min != 0)
+      *sgn = -1;
+    return retval;
+  }
 
-    if (this_table_def->pas < 9)
-      typ_geo = typ_geo_base[this_table_def->pas];
-    else if (dim_elt == 2)
-      typ_geo = ECS_ELT_TYP_FAC_POLY;
-    else if (dim_elt == 3)
-      typ_geo = ECS_ELT_TYP_CEL_POLY;
-    else
-      typ_geo = ECS_ELT_TYP_NUL;
+  for (k = 1; k < n && retval == 0; k++) {
+    ecs_int_t v_f = ECS_ABS(val[(i_min + k) % n]);
+    ecs_int_t v_b = ECS_ABS(val[(i_min + n - k) % n]);
+    if (v_f != v_b) {
+      if (v_b < v_f) {
+        *sgn = -1;
+        canon->v[1] = ECS_ABS(val[(i_min + n - 1) % n]);
+      }
+      break;
+    }
+  }
 
-    printf("  %-*s%*.*s : %*lu\n",
-           lng_imp, _("Number of elements"),
-           ECS_LOC_LNG_MAX_NOM_TYP, ECS_LOC_LNG_MAX_NOM_TYP,
-           ecs_fic_elt_typ_liste_c[typ_geo].nom,
-           ECS_LNG_AFF_ENT, (unsigned long)nbr_elt);
+  return retval;
+}
 
-  }
+/*----------------------------------------------------------------------------
+ *  Fonction qui compare les formes canoniques de deux éléments
+ *----------------------------------------------------------------------------*/
 
-  /* Si tous les éléments ne sont pas de même type */
-  /*-----------------------------------------------*/
+static inline int
+_table_def__compare_canon(const _canon_ctx_t  *ctx,
+                          const _canon_t      *c_0,
+                          const _canon_t      *c_1)
+{
+  size_t k;
 
-  else {
+  if (c_0->v[0] != c_1->v[0])
+    return (c_0->v[0] < c_1->v[0]) ? -1 : 1;
+  else if (c_0->v[1] != c_1->v[1])
+    return (c_0->v[1] < c_1->v[1]) ? -1 : 1;
 
-    /* Construction d'un tableau temporaire de type géométrique */
+  /* Comparaison complète si les premiers sous-éléments sont identiques */
 
-    tab_typ_geo.nbr = nbr_elt;
-    ECS_MALLOC(tab_typ_geo.val, tab_typ_geo.nbr, ecs_int_t);
+  const ecs_table_t *table_def = ctx->table_def;
+  const size_t ind_0 = c_0->ind, ind_1 = c_1->ind;
 
-    for (ielt = 0; ielt < nbr_elt; ielt++) {
+  const size_t s_0 = table_def->pos[ind_0] - 1;
+  const size_t n_0 = table_def->pos[ind_0 + 1] - 1 - s_0;
+  const size_t s_1 = table_def->pos[ind_1] - 1;
+  const size_t n_1 = table_def->pos[ind_1 + 1] - 1 - s_1;
 
-      nbr_som =   this_table_def->pos[ielt + 1]
-                - this_table_def->pos[ielt];
+  if (n_0 != n_1)
+    return (n_0 < n_1) ? -1 : 1;
 
-      if (nbr_som < 9)
-        tab_typ_geo.val[ielt] = typ_geo_base[nbr_som];
+  const size_t p_0 = ctx->pos_min[ind_0] - s_0;
+  const size_t p_1 = ctx->pos_min[ind_1] - s_1;
 
-      else if (dim_elt == 2)
-        tab_typ_geo.val[ielt] = ECS_ELT_TYP_FAC_POLY;
+  const size_t d_0 = (ctx->sgn[ind_0] > 0) ? 1 : n_0 - 1;
+  const size_t d_1 = (ctx->sgn[ind_1] > 0) ? 1 : n_1 - 1;
 
-      else if (dim_elt == 3)
-        tab_typ_geo.val[ielt] = ECS_ELT_TYP_CEL_POLY;
+  for (k = 2; k < n_0; k++) {
 
-      else
-        tab_typ_geo.val[ielt] = ECS_ELT_TYP_NUL;
+    ecs_int_t v_0 = ECS_ABS(table_def->val[s_0 + (p_0 + k*d_0) % n_0]);
+    ecs_int_t v_1 = ECS_ABS(table_def->val[s_1 + (p_1 + k*d_1) % n_1]);
 
-    }
+    if (v_0 != v_1)
+      return (v_0 < v_1) ? -1 : 1;
 
-    /* On regarde si les types géométriques ne sont pas deja ordonnés */
+  }
 
-    ielt = 1;
-    while (ielt < nbr_elt                                     &&
-           tab_typ_geo.val[ielt] >= tab_typ_geo.val[ielt - 1]   )
-      ielt++;
+  return 0;
+}
 
-    if (ielt < nbr_elt) {
+/*----------------------------------------------------------------------------
+ *  Fonction d'ordre total sur les éléments : forme canonique, puis indice
+ *----------------------------------------------------------------------------*/
 
-      /* Les types géométriques ne sont pas ordonnés */
-      /* On ordonne les types géométriques */
+static inline int
+_table_def__ordre_canon(const _canon_ctx_t  *ctx,
+                        const _canon_t      *c_0,
+                        const _canon_t      *c_1)
+{
+  int retval = _table_def__compare_canon(ctx, c_0, c_1);
 
-      vect_renum.nbr = nbr_elt;
-      ECS_MALLOC(vect_renum.val, nbr_elt, ecs_int_t);
+  if (retval == 0 && c_0->ind != c_1->ind)
+    retval = (c_0->ind < c_1->ind) ? -1 : 1;
 
+  return retval;
+}
 
-      tab_typ_geo_ord = ecs_tab_int__trie_et_renvoie(tab_typ_geo,
-                                                     vect_renum);
+/*----------------------------------------------------------------------------
+ *  Fonction qui fusionne deux listes ordonnées d'éléments, la liste
+ *  résultante étant répartie entre les threads (découpage par recherche
+ *  dichotomique du point de coupure de chaque portion de la liste fusionnée)
+ *----------------------------------------------------------------------------*/
 
-      /*
-        `vect_renum' prend pour indice les indices nouveaux, et ses valeurs
-        contiennent les indices anciens correspondants
-        On inverse le contenu de `vect_renum' :
-        à chaque indice ancien, `vect_renum' donne la valeur du nouvel indice
-      */
+static void
+_table_def__fusion_listes(const _canon_ctx_t  *ctx,
+                          const _canon_t      *a,
+                          size_t               n_a,
+                          const _canon_t      *b,
+                          size_t               n_b,
+                          _canon_t            *c)
+{
+  const size_t n_c = n_a + n_b;
 
-      ecs_tab_int__inverse(&vect_renum);
+# pragma omp parallel if (n_c > ECS_LOC_THR_MIN)
+  {
+    size_t c_id[2], a_id[2], b_id[2];
+    int t_id = 0, n_t = 1;
 
-      ECS_FREE(tab_typ_geo.val);
+#if defined(HAVE_OPENMP)
+    t_id = omp_get_thread_num();
+    n_t = omp_get_num_threads();
+#endif
 
-      tab_typ_geo.val = tab_typ_geo_ord.val;
+    c_id[0] = (n_c * (size_t)t_id) / (size_t)n_t;
+    c_id[1] = (n_c * (size_t)(t_id + 1)) / (size_t)n_t;
 
-      tab_typ_geo_ord.nbr = 0;
-      tab_typ_geo_ord.val = NULL;
+    /* Nombre d'éléments de a parmi les c_id premiers de la fusion */
 
+    for (int l = 0; l < 2; l++) {
+      size_t k = c_id[l];
+      size_t lo = (k > n_b) ? k - n_b : 0;
+      size_t hi = (k < n_a) ? k : n_a;
+      while (lo < hi) {
+        size_t i = (lo + hi) / 2;
+        size_t j = k - i;
+        if (j > 0 && _table_def__ordre_canon(ctx, a + i, b + j - 1) < 0)
+          lo = i + 1;
+        else
+          hi = i;
+      }
+      a_id[l] = lo;
+      b_id[l] = k - lo;
     }
 
-    /* Message d'information sur la composition des éléments du maillage */
-
     {
-      ecs_int_t val_typ_ref;
-      size_t    nbr_val_typ_geo;
-
-      size_t    cpt_ielt = 0;
-
-      while (cpt_ielt < nbr_elt) {
+      size_t i = a_id[0], j = b_id[0], k = c_id[0];
 
-        val_typ_ref = tab_typ_geo.val[cpt_ielt];
+      while (i < a_id[1] && j < b_id[1]) {
+        if (_table_def__ordre_canon(ctx, a + i, b + j) < 0)
+          c[k++] = a[i++];
+        else
+          c[k++] = b[j++];
+      }
+      while (i < a_id[1])
+        c[k++] = a[i++];
+      while (j < b_id[1])
+        c[k++] = b[j++];
+    }
+  }
+}
 
-        /* On compte le nombre d'éléments ayant le même type géométrique */
+/*----------------------------------------------------------------------------
+ *  Fonction qui trie une portion de liste d'éléments selon leur forme
+ *  canonique (tri par insertion de blocs, puis fusions successives)
+ *----------------------------------------------------------------------------*/
 
-        nbr_val_typ_geo = 0;
+static void
+_table_def__tri_canon_loc(const _canon_ctx_t  *ctx,
+                          size_t               n,
+                          _canon_t            *canon,
+                          _canon_t            *tmp)
+{
+  size_t i, j, l;
+
+  _canon_t *src = canon, *dest = tmp, *swap;
+
+  for (i = 0; i < n; i += ECS_LOC_TRI_BLOC) {
+    size_t e = (i + ECS_LOC_TRI_BLOC < n) ? i + ECS_LOC_TRI_BLOC : n;
+    for (j = i + 1; j < e; j++) {
+      _canon_t c = canon[j];
+      for (l = j;
+           l > i && _table_def__ordre_canon(ctx, canon + l - 1, &c) > 0;
+           l--)
+        canon[l] = canon[l-1];
+      canon[l] = c;
+    }
+  }
 
-        for (ielt = cpt_ielt;
-             ielt < nbr_elt && tab_typ_geo.val[ielt] == val_typ_ref; ielt++)
-          nbr_val_typ_geo++;
+  for (size_t w = ECS_LOC_TRI_BLOC; w < n; w *= 2) {
 
-        printf("  %-*s%*.*s : %*lu\n",
-               lng_imp, _("Number of elements"),
-               ECS_LOC_LNG_MAX_NOM_TYP, ECS_LOC_LNG_MAX_NOM_TYP,
-               ecs_fic_elt_typ_liste_c[val_typ_ref].nom,
-               ECS_LNG_AFF_ENT, (unsigned long)nbr_val_typ_geo);
+    for (i = 0; i < n; i += 2*w) {
 
-        cpt_ielt += nbr_val_typ_geo;
+      size_t m = (i + w < n) ? i + w : n;
+      size_t e = (i + 2*w < n) ? i + 2*w : n;
+      size_t i_a = i, i_b = m, k = i;
 
+      while (i_a < m && i_b < e) {
+        if (_table_def__ordre_canon(ctx, src + i_a, src + i_b) < 0)
+          dest[k++] = src[i_a++];
+        else
+          dest[k++] = src[i_b++];
       }
-    }
+      while (i_a < m)
+        dest[k++] = src[i_a++];
+      while (i_b < e)
+        dest[k++] = src[i_b++];
 
-    /* Le tableau de type géométrique n'est plus nécessaire */
+    }
 
-    tab_typ_geo.nbr = 0;
-    ECS_FREE(tab_typ_geo.val);
+    swap = src; src = dest; dest = swap;
 
   }
 
-  /* Renvoi du vecteur de renumérotation */
-  /*-------------------------------------*/
-
-  return vect_renum;
+  if (src != canon)
+    memcpy(canon, src, n*sizeof(_canon_t));
 }
 
 /*----------------------------------------------------------------------------
- *  Fonction qui construit
- *   les définitions des faces par décomposition des tables des cellules
+ *  Fonction qui trie les éléments selon leur forme canonique, puis leur
+ *  indice ; chaque thread trie une portion de la liste, et les portions
+ *  sont ensuite fusionnées deux à deux.
  *----------------------------------------------------------------------------*/
 
-void
-ecs_table_def__decompose_cel(ecs_table_t  **table_def_fac,
-                             ecs_table_t   *table_def_cel)
+static void
+_table_def__tri_canon(const _canon_ctx_t  *ctx,
+                      size_t               n,
+                      _canon_t            *canon)
 {
-  size_t      nbr_cel;
-  size_t      nbr_def;
-  size_t      nbr_fac;
-  size_t      nbr_fac_old;
-  size_t      nbr_val_cel;
-  size_t      nbr_val_fac;
-  size_t      nbr_val_fac_old;
-  size_t      ind_pos_cel;
-  size_t      ind_pos_loc;
-  size_t      ind_pos_sui;
-  size_t      nbr_pos_loc;
-  ecs_int_t   num_def;
-  ecs_int_t   marqueur_fin;
-
-  size_t      isom;
-  size_t      icel;
-  int         idef;
-  size_t      cpt_fac;
-  int         ifac;
+  size_t i;
 
-  ecs_int_t   typ_geo_cel;        /* Type géométrique élément en cours */
+  const int n_t = _table_def__n_threads(n);
 
-  ecs_int_t typ_geo_base[9] = {ECS_ELT_TYP_NUL,
-                               ECS_ELT_TYP_NUL,
-                               ECS_ELT_TYP_NUL,
-                               ECS_ELT_TYP_NUL,
-                               ECS_ELT_TYP_CEL_TETRA,
-                               ECS_ELT_TYP_CEL_PYRAM,
-                               ECS_ELT_TYP_CEL_PRISM,
-                               ECS_ELT_TYP_NUL,
-                               ECS_ELT_TYP_CEL_HEXA};
+  size_t *bornes = NULL;
+  _canon_t *tmp = NULL, *src = canon, *dest = NULL, *swap;
 
-  ecs_size_t   *def_cel_fac_pos = NULL;
-  ecs_int_t    *def_cel_fac_val = NULL;
+  ECS_MALLOC(tmp, n, _canon_t);
+  ECS_MALLOC(bornes, n_t + 1, size_t);
 
-  /*xxxxxxxxxxxxxxxxxxxxxxxxxxx Instructions xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx*/
+  for (i = 0; i < (size_t)n_t + 1; i++)
+    bornes[i] = (n * i) / (size_t)n_t;
 
-  /*=================*/
-  /* Initialisations */
-  /*=================*/
+# pragma omp parallel for num_threads(n_t)
+  for (i = 0; i < (size_t)n_t; i++)
+    _table_def__tri_canon_loc(ctx,
+                              bornes[i+1] - bornes[i],
+                              canon + bornes[i],
+                              tmp + bornes[i]);
 
-  nbr_cel  = table_def_cel->nbr;
+  dest = tmp;
 
-  ecs_table__regle_en_pos(table_def_cel);
+  for (int w = 1; w < n_t; w *= 2) {
 
-  /* Construction, pour les cellules, des tables principaux */
-  /*--------------------------------------------------------*/
+    for (i = 0; i < (size_t)n_t; i += 2*w) {
 
-  /* Boucle de comptage pour l'allocation des sous-éléments */
-  /*--------------------------------------------------------*/
+      size_t s_id = bornes[i];
+      size_t m_id = bornes[(i + w < (size_t)n_t) ? i + w : (size_t)n_t];
+      size_t e_id = bornes[(i + 2*w < (size_t)n_t) ? i + 2*w : (size_t)n_t];
 
-  if (*table_def_fac != NULL) {
-    nbr_fac_old = (*table_def_fac)->nbr;
-    nbr_val_fac_old = ecs_table__ret_val_nbr(*table_def_fac);
-  }
-  else {
-    nbr_fac_old = 0;
-    nbr_val_fac_old = 0;
-  }
+      _table_def__fusion_listes(ctx,
+                                src + s_id, m_id - s_id,
+                                src + m_id, e_id - m_id,
+                                dest + s_id);
 
-  nbr_fac     = 0;
-  nbr_val_fac = 0;
-  nbr_def     = 0;
+    }
 
-  for (icel = 0; icel < nbr_cel; icel++ ) {
+    swap = src; src = dest; dest = swap;
 
-    ind_pos_cel = table_def_cel->pos[icel] - 1;
+  }
 
-    nbr_val_cel = table_def_cel->pos[icel + 1] - 1 - ind_pos_cel;
+  if (src != canon)
+    memcpy(canon, src, n*sizeof(_canon_t));
 
-    /* Traitement des cellules "classiques" */
-    /*--------------------------------------*/
+  ECS_FREE(bornes);
+  ECS_FREE(tmp);
+}
 
-    if (nbr_val_cel < 9) {
+/*----------------------------------------------------------------------------
+ *  Fonction qui détermine, par tri des formes canoniques, la
+ *  correspondance entre éléments de même définition.
+ *
+ *  Pour chaque élément, tab_transf->val reçoit le numéro de l'élément
+ *  fusionné, et signe_elt->val (si non NULL) l'orientation relative au
+ *  premier élément de même définition. Le résultat est identique à celui
+ *  de la recherche séquentielle pour des éléments non dégénérés.
+ *
+ *  Renvoie false sans rien modifier si des éléments dégénérés sont présents.
+ *----------------------------------------------------------------------------*/
 
-      typ_geo_cel = typ_geo_base[nbr_val_cel];
+static bool
+_table_def__fusion_tri(const ecs_table_t  *table_def,
+                       ecs_tab_int_t      *tab_transf,
+                       ecs_tab_int_t      *signe_elt)
+{
+  size_t i;
+  size_t n_degen = 0;
 
-      /* Boucle sur les sous-éléments définissant la cellulle */
+  const size_t n = table_def->nbr;
 
-      for (ifac = 0;
-           ifac < ecs_fic_elt_typ_liste_c[typ_geo_cel].nbr_sous_elt;
-           ifac++ ) {
+  ecs_size_t   *pos_min = NULL;
+  signed char  *sgn = NULL;
+  _canon_t     *canon = NULL;
 
-        const ecs_sous_elt_t  * sous_elt
-          = &(ecs_fic_elt_typ_liste_c[typ_geo_cel].sous_elt[ifac]);
+  _canon_ctx_t  ctx;
 
-        nbr_fac++;
+  ECS_MALLOC(pos_min, n, ecs_size_t);
+  ECS_MALLOC(sgn, n, signed char);
+  ECS_MALLOC(canon, n, _canon_t);
 
-        for (idef = 0;
-             idef < (ecs_fic_elt_typ_liste_c[sous_elt->elt_typ]).nbr_som;
-             idef++);
+# pragma omp parallel for reduction(+:n_degen) if (n > ECS_LOC_THR_MIN)
+  for (i = 0; i < n; i++)
+    n_degen += _table_def__canonique(table_def, i,
+                                     pos_min + i, sgn + i, canon + i);
 
-        nbr_val_fac += idef;
+  if (n_degen > 0) {
+    ECS_FREE(canon);
+    ECS_FREE(pos_min);
+    ECS_FREE(sgn);
+    return false;
+  }
 
-      }
+  ctx.table_def = table_def;
+  ctx.pos_min = pos_min;
+  ctx.sgn = sgn;
 
-    }
+  _table_def__tri_canon(&ctx, n, canon);
 
-    /* Traitement des éléments de type "polyèdre" */
-    /*--------------------------------------------*/
+  /* Parcours des séries d'éléments de même forme canonique ; chaque
+     série est traitée par le thread sur la portion duquel elle débute,
+     son premier élément étant celui de plus petit indice */
 
-    else {
+# pragma omp parallel if (n > ECS_LOC_THR_MIN)
+  {
+    size_t s_id = 0, e_id = n;
 
-      ind_pos_sui = table_def_cel->pos[icel + 1] - 1;
-      nbr_pos_loc = ind_pos_sui - ind_pos_cel;
+#if defined(HAVE_OPENMP)
+    int t_id = omp_get_thread_num();
+    int n_t = omp_get_num_threads();
+    s_id = (n * (size_t)t_id) / (size_t)n_t;
+    e_id = (n * (size_t)(t_id + 1)) / (size_t)n_t;
+#endif
 
-      /* Convention : définition nodale cellule->sommets avec numéros de
-         premiers sommets répétés en fin de liste pour marquer la fin
-         de chaque face */
+    while (   s_id > 0 && s_id < e_id
+           && _table_def__compare_canon(&ctx,
+                                        canon + s_id - 1,
+                                        canon + s_id) == 0)
+      s_id++;
 
-      marqueur_fin = -1;
+    for (size_t j = s_id; j < e_id; ) {
 
-      for (isom = ind_pos_cel; isom < ind_pos_sui; isom++) {
+      const _canon_t *c_ref = canon + j;
+      size_t k = j;
 
-        if (table_def_cel->val[isom] != marqueur_fin) {
-          nbr_val_fac += 1;
-          if (marqueur_fin == -1)
-            marqueur_fin = table_def_cel->val[isom];
-        }
-        else {
-          marqueur_fin = -1;
-          nbr_fac += 1;
-        }
+      do {
+        ecs_int_t ind = canon[k].ind;
+        tab_transf->val[ind] = c_ref->ind;
+        if (signe_elt != NULL)
+          signe_elt->val[ind] = sgn[ind] * sgn[c_ref->ind];
+        k++;
+      } while (   k < n
+               && _table_def__compare_canon(&ctx, c_ref, canon + k) == 0);
 
-      }
+      j = k;
 
     }
+  }
 
-  } /* Fin de la boucle de comptage sur les cellules */
+  ECS_FREE(canon);
+  ECS_FREE(sgn);
+  ECS_FREE(pos_min);
 
-  /* Allocation et initialisation pour les faces  */
-  /*  des tableaux associés aux définitions       */
-  /*----------------------------------------------*/
-
-  nbr_fac += nbr_fac_old;
-  nbr_val_fac += nbr_val_fac_old;
-
-  if (*table_def_fac != NULL) {
-    ecs_table__regle_en_pos(*table_def_fac);
-    (*table_def_fac)->nbr = nbr_fac;
-    ECS_REALLOC((*table_def_fac)->pos, nbr_fac + 1, ecs_size_t);
-    ECS_REALLOC((*table_def_fac)->val, nbr_val_fac, ecs_int_t);
-  }
-  else {
-    *table_def_fac = ecs_table__alloue(nbr_fac,
-                                       nbr_val_fac);
-    (*table_def_fac)->pos[0] = 1;
-  }
-
-  ECS_MALLOC(def_cel_fac_pos, nbr_cel + 1, ecs_size_t);
-  ECS_MALLOC(def_cel_fac_val, nbr_fac - nbr_fac_old, ecs_int_t);
-
-  def_cel_fac_pos[0] = 1;
-
-  /*=======================================*/
-  /* Boucle sur les cellules à transformer */
-  /*=======================================*/
-
-  cpt_fac = nbr_fac_old;
-  nbr_def = nbr_val_fac_old;
-
-  for (icel = 0; icel < nbr_cel; icel++ ) {
-
-    ind_pos_cel = table_def_cel->pos[icel] - 1;
-
-    nbr_val_cel = table_def_cel->pos[icel + 1] - 1 - ind_pos_cel;
-
-    /*--------------------------------------*/
-    /* Traitement des éléments "classiques" */
-    /*--------------------------------------*/
-
-    if (nbr_val_cel < 9) {
-
-      typ_geo_cel = typ_geo_base[nbr_val_cel];
-
-      /* Boucle sur les faces définissant la cellulle */
-      /*==============================================*/
-
-      for (ifac = 0;
-           ifac < ecs_fic_elt_typ_liste_c[typ_geo_cel].nbr_sous_elt;
-           ifac++ ) {
-
-        const ecs_sous_elt_t  * sous_elt
-          = &(ecs_fic_elt_typ_liste_c[typ_geo_cel].sous_elt[ifac]);
-
-        /* Boucle sur les sommets définissant la face */
-        /*--------------------------------------------*/
-
-        for (idef = 0;
-             idef < (ecs_fic_elt_typ_liste_c[sous_elt->elt_typ]).nbr_som;
-             idef++) {
-
-          /* Définition de la face en fonction des sommets */
-
-          num_def = sous_elt->som[idef];
-
-          (*table_def_fac)->val[nbr_def++]
-            = table_def_cel->val[ind_pos_cel + num_def - 1];
-
-        }
-
-        /* Position de la face dans sa définition en fonction des sommets */
-        /*----------------------------------------------------------------*/
-
-        (*table_def_fac)->pos[cpt_fac + 1]
-          = (*table_def_fac)->pos[cpt_fac] + idef;
-
-        /* Détermination de la cellule en fonction des faces */
-        /*---------------------------------------------------*/
-
-        def_cel_fac_val[cpt_fac - nbr_fac_old] = cpt_fac + 1;
-
-        cpt_fac++;
-
-      } /* Fin de la boucle sur les faces d'une cellule */
-
-    }
-
-
-    /*--------------------------------------------*/
-    /* Traitement des éléments de type "polyèdre" */
-    /*--------------------------------------------*/
-
-    else {
-
-      /* Boucle sur les faces définissant le polyèdre */
-      /*==============================================*/
-
-      ifac = 0;
-      marqueur_fin = -1;
-
-      nbr_pos_loc = table_def_cel->pos[icel + 1] - 1 - ind_pos_cel;
-
-      for (ind_pos_loc = 0; ind_pos_loc < nbr_pos_loc; ind_pos_loc++) {
-
-        /* Définition de la face en fonction des sommets */
-
-        if (table_def_cel->val[ind_pos_cel + ind_pos_loc] != marqueur_fin) {
-
-          (*table_def_fac)->val[nbr_def++]
-            = table_def_cel->val[ind_pos_cel + ind_pos_loc];
-
-          if (marqueur_fin == -1)
-            marqueur_fin = table_def_cel->val[ind_pos_cel + ind_pos_loc];
-
-        }
-
-        /* Position de la face dans sa définition en fonction des sommets */
-
-        else {
-
-          (*table_def_fac)->pos[cpt_fac + 1] = nbr_def + 1;
-
-          marqueur_fin = -1;
-
-          def_cel_fac_val[cpt_fac - nbr_fac_old] = cpt_fac + 1;
-
-          /* Incrémentation du nombre de faces */
-
-          ifac++;
-          cpt_fac++;
-
-        }
-
-      } /* Fin de la boucle sur les faces du polyèdre */
+  /* Numérotation des éléments fusionnés dans l'ordre de première
+     apparition, comme pour la recherche séquentielle */
 
+  {
+    ecs_int_t cpt = 0;
+    for (i = 0; i < n; i++) {
+      if (tab_transf->val[i] == (ecs_int_t)i)
+        tab_transf->val[i] = cpt++;
+      else
+        tab_transf->val[i] = tab_transf->val[tab_transf->val[i]];
     }
+  }
 
-    /* A ce point, on a : ifac
-       = ecs_fic_elt_typ_liste_c[table_typ_geo_cel->val[icel]].nbr_sous_elt
-       pour des éléments classiques, et ifac est égal au nombre de faces pour
-       des éléments polyédriques. */
-
-    def_cel_fac_pos[icel + 1] = def_cel_fac_pos[icel] + ifac;
-
-  } /* Fin de la boucle sur les éléments */
-
-  /* Mise à jour de la table */
-  /*-------------------------*/
-
-  ECS_FREE(table_def_cel->pos);
-  ECS_FREE(table_def_cel->val);
-
-  table_def_cel->pos = def_cel_fac_pos;
-  table_def_cel->val = def_cel_fac_val;
-
-  /* ecs_table__pos_en_regle(*table_def_fac); */
-  ecs_table__pos_en_regle(table_def_cel);
+  return true;
 }
 
 /*----------------------------------------------------------------------------
- *  Fonction qui realise la fusion des definitions des elements
+ *  Fonction qui détermine, par recherche séquentielle parmi les éléments
+ *  de même sous-élément de plus petit numéro, la correspondance entre
+ *  éléments de même définition (voir _table_def__fusion_tri).
  *----------------------------------------------------------------------------*/
 
-ecs_tab_int_t
-ecs_table_def__fusionne(ecs_table_t    *table_def,
-                        size_t         *nbr_elt_cpct,
-                        ecs_tab_int_t  *signe_elt)
+static void
+_table_def__fusion_rech(const ecs_table_t  *table_def,
+                        ecs_tab_int_t      *tab_transf,
+                        ecs_tab_int_t      *signe_elt)
 {
   size_t           cpt_sup_fin;
   size_t           ind_cmp;
@@ -1895,15 +1905,12 @@ ecs_table_def__fusionne(ecs_table_t    *table_def,
   size_t           ind_pos;
   size_t           ind_pos_loc;
   size_t           ind_sup;
-  size_t           nbr_sup_ini;
   size_t           nbr_inf;
   ecs_int_t        num_inf;
   ecs_int_t        num_inf_loc;
   ecs_int_t        num_inf_min;
   ecs_int_t        num_inf_min_cmp;
   size_t           pos_cmp;
-  size_t           pos_cpt;
-  size_t           pos_sup;
   int              sgn;
 
   size_t           ind_pos_sup[3];
@@ -1914,43 +1921,14 @@ ecs_table_def__fusionne(ecs_table_t    *table_def,
   ecs_size_t      *pos_recherche = NULL;
   ecs_int_t       *val_recherche = NULL;
 
-  ecs_tab_int_t    tab_transf;    /* Tableau de transformation */
-
   /*xxxxxxxxxxxxxxxxxxxxxxxxxxx Instructions xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx*/
 
-  ecs_table__regle_en_pos(table_def);
-
-  /* Fusion des definitions des elements sur la liste initiale  */
-  /*------------------------------------------------------------*/
-
-  /* Initialisations avec précautions pour cas vide */
-
-  tab_transf.nbr = 0;
-  tab_transf.val = NULL;
-
-  if (table_def == NULL)
-    return tab_transf;
-
-  if (table_def == NULL)
-    return tab_transf;
-
-  nbr_sup_ini = table_def->nbr;
-  cpt_sup_fin = 0;
-
-  if (nbr_sup_ini < 1)
-    return tab_transf;
-
-  if (signe_elt != NULL) {
-    signe_elt->nbr = nbr_sup_ini;
-    ECS_MALLOC(signe_elt->val, nbr_sup_ini, ecs_int_t);
-  }
-
   /* Comptage du nombre de sous-entités */
 
   nbr_inf = 0;
 
   for (ind_sup = 0;
-       ind_sup < table_def->pos[nbr_sup_ini] - 1;
+       ind_sup < table_def->pos[table_def->nbr] - 1;
        ind_sup++) {
     num_inf = table_def->val[ind_sup];
     if ((size_t)(ECS_ABS(num_inf)) > nbr_inf)
@@ -2030,14 +2008,6 @@ ecs_table_def__fusionne(ecs_table_t    *table_def,
   cpt_ref_inf.nbr = 0;
   ECS_FREE(cpt_ref_inf.val);
 
-  /* Allocation du tableau de transformation */
-
-  tab_transf = ecs_tab_int__cree(nbr_sup_ini);
-
-  for (ind_sup = 0; ind_sup < nbr_sup_ini; ind_sup++)
-    tab_transf.val[ind_sup] = ind_sup;
-
-
   /* Boucle principale de recherche sur les éléments supérieurs */
   /*------------------------------------------------------------*/
 
@@ -2046,7 +2016,7 @@ ecs_table_def__fusionne(ecs_table_t    *table_def,
     la boucle commence donc au deuxième
   */
 
-  tab_transf.val[0] = 0;
+  tab_transf->val[0] = 0;
 
   if (signe_elt != NULL)
     signe_elt->val[0] = 1;
@@ -2175,7 +2145,7 @@ ecs_table_def__fusionne(ecs_table_t    *table_def,
 
       }
 
-      tab_transf.val[ind_sup] = tab_transf.val[ind_cmp];
+      tab_transf->val[ind_sup] = tab_transf->val[ind_cmp];
 
       if (signe_elt != NULL)
         signe_elt->val[ind_sup] = sgn;
@@ -2183,7 +2153,7 @@ ecs_table_def__fusionne(ecs_table_t    *table_def,
     }
     else {
 
-      tab_transf.val[ind_sup] = cpt_sup_fin++;
+      tab_transf->val[ind_sup] = cpt_sup_fin++;
 
       if (signe_elt != NULL)
         signe_elt->val[ind_sup] = 1;
@@ -2197,6 +2167,515 @@ ecs_table_def__fusionne(ecs_table_t    *table_def,
 
   ECS_FREE(pos_recherche);
   ECS_FREE(val_recherche);
+}
+
+/*============================================================================
+ *                             Fonctions publiques
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ *  Fonction qui réalise le tri des types géométriques
+ *  La fonction affiche le nombre d'éléments par type géométrique
+ *----------------------------------------------------------------------------*/
+
+ecs_tab_int_t
+ecs_table_def__trie_typ(ecs_table_t  *this_table_def,
+                        int           dim_elt)
+{
+  size_t       ielt;
+  size_t       nbr_elt;
+  size_t       nbr_som;
+
+  ecs_tab_int_t   tab_typ_geo_ord;
+  ecs_tab_int_t   tab_typ_geo;
+  ecs_tab_int_t   vect_renum;
+
+  ecs_elt_typ_t   typ_geo;
+
+  const ecs_elt_typ_t  *typ_geo_base;
+
+  const int lng_imp = ECS_LNG_AFF_STR - ECS_LOC_LNG_MAX_NOM_TYP;
+
+  /*xxxxxxxxxxxxxxxxxxxxxxxxxxx Instructions xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx*/
+
+  assert(this_table_def != NULL);
+
+  vect_renum.nbr = 0   ;
+  vect_renum.val = NULL;
+
+  nbr_elt = this_table_def->nbr;
+
+  if (nbr_elt == 0)
+    return vect_renum;
+
+  /* Détermination de base du type d'élément "classique" */
+
+  assert(dim_elt >=2 && dim_elt <= 3);
+
+  typ_geo_base = ecs_glob_typ_elt[dim_elt - 2];
+
+  /* Si tous les éléments sont de même type, rien à faire */
+  /*------------------------------------------------------*/
+
+  if (this_table_def->pos == NULL) {
+
+    if (this_table_def->pas < 9)
+      typ_geo = typ_geo_base[this_table_def->pas];
+    else if (dim_elt == 2)
+      typ_geo = ECS_ELT_TYP_FAC_POLY;
+    else if (dim_elt == 3)
+      typ_geo = ECS_ELT_TYP_CEL_POLY;
+    else
+      typ_geo = ECS_ELT_TYP_NUL;
+
+    printf("  %-*s%*.*s : %*lu\n",
+           lng_imp, _("Number of elements"),
+           ECS_LOC_LNG_MAX_NOM_TYP, ECS_LOC_LNG_MAX_NOM_TYP,
+           ecs_fic_elt_typ_liste_c[typ_geo].nom,
+           ECS_LNG_AFF_ENT, (unsigned long)nbr_elt);
+
+  }
+
+  /* Si tous les éléments ne sont pas de même type */
+  /*-----------------------------------------------*/
+
+  else {
+
+    /* Construction d'un tableau temporaire de type géométrique */
+
+    tab_typ_geo.nbr = nbr_elt;
+    ECS_MALLOC(tab_typ_geo.val, tab_typ_geo.nbr, ecs_int_t);
+
+    for (ielt = 0; ielt < nbr_elt; ielt++) {
+
+      nbr_som =   this_table_def->pos[ielt + 1]
+                - this_table_def->pos[ielt];
+
+      if (nbr_som < 9)
+        tab_typ_geo.val[ielt] = typ_geo_base[nbr_som];
+
+      else if (dim_elt == 2)
+        tab_typ_geo.val[ielt] = ECS_ELT_TYP_FAC_POLY;
+
+      else if (dim_elt == 3)
+        tab_typ_geo.val[ielt] = ECS_ELT_TYP_CEL_POLY;
+
+      else
+        tab_typ_geo.val[ielt] = ECS_ELT_TYP_NUL;
+
+    }
+
+    /* On regarde si les types géométriques ne sont pas deja ordonnés */
+
+    ielt = 1;
+    while (ielt < nbr_elt                                     &&
+           tab_typ_geo.val[ielt] >= tab_typ_geo.val[ielt - 1]   )
+      ielt++;
+
+    if (ielt < nbr_elt) {
+
+      /* Les types géométriques ne sont pas ordonnés */
+      /* On ordonne les types géométriques */
+
+      vect_renum.nbr = nbr_elt;
+      ECS_MALLOC(vect_renum.val, nbr_elt, ecs_int_t);
+
+
+      tab_typ_geo_ord = ecs_tab_int__trie_et_renvoie(tab_typ_geo,
+                                                     vect_renum);
+
+      /*
+        `vect_renum' prend pour indice les indices nouveaux, et ses valeurs
+        contiennent les indices anciens correspondants
+        On inverse le contenu de `vect_renum' :
+        à chaque indice ancien, `vect_renum' donne la valeur du nouvel indice
+      */
+
+      ecs_tab_int__inverse(&vect_renum);
+
+      ECS_FREE(tab_typ_geo.val);
+
+      tab_typ_geo.val = tab_typ_geo_ord.val;
+
+      tab_typ_geo_ord.nbr = 0;
+      tab_typ_geo_ord.val = NULL;
+
+    }
+
+    /* Message d'information sur la composition des éléments du maillage */
+
+    {
+      ecs_int_t val_typ_ref;
+      size_t    nbr_val_typ_geo;
+
+      size_t    cpt_ielt = 0;
+
+      while (cpt_ielt < nbr_elt) {
+
+        val_typ_ref = tab_typ_geo.val[cpt_ielt];
+
+        /* On compte le nombre d'éléments ayant le même type géométrique */
+
+        nbr_val_typ_geo = 0;
+
+        for (ielt = cpt_ielt;
+             ielt < nbr_elt && tab_typ_geo.val[ielt] == val_typ_ref; ielt++)
+          nbr_val_typ_geo++;
+
+        printf("  %-*s%*.*s : %*lu\n",
+               lng_imp, _("Number of elements"),
+               ECS_LOC_LNG_MAX_NOM_TYP, ECS_LOC_LNG_MAX_NOM_TYP,
+               ecs_fic_elt_typ_liste_c[val_typ_ref].nom,
+               ECS_LNG_AFF_ENT, (unsigned long)nbr_val_typ_geo);
+
+        cpt_ielt += nbr_val_typ_geo;
+
+      }
+    }
+
+    /* Le tableau de type géométrique n'est plus nécessaire */
+
+    tab_typ_geo.nbr = 0;
+    ECS_FREE(tab_typ_geo.val);
+
+  }
+
+  /* Renvoi du vecteur de renumérotation */
+  /*-------------------------------------*/
+
+  return vect_renum;
+}
+
+/*----------------------------------------------------------------------------
+ *  Fonction qui construit
+ *   les définitions des faces par décomposition des tables des cellules
+ *----------------------------------------------------------------------------*/
+
+void
+ecs_table_def__decompose_cel(ecs_table_t  **table_def_fac,
+                             ecs_table_t   *table_def_cel)
+{
+  size_t      nbr_cel;
+  size_t      nbr_fac;
+  size_t      nbr_fac_old;
+  size_t      nbr_val_fac;
+  size_t      nbr_val_fac_old;
+  size_t      icel;
+
+  ecs_int_t typ_geo_base[9] = {ECS_ELT_TYP_NUL,
+                               ECS_ELT_TYP_NUL,
+                               ECS_ELT_TYP_NUL,
+                               ECS_ELT_TYP_NUL,
+                               ECS_ELT_TYP_CEL_TETRA,
+                               ECS_ELT_TYP_CEL_PYRAM,
+                               ECS_ELT_TYP_CEL_PRISM,
+                               ECS_ELT_TYP_NUL,
+                               ECS_ELT_TYP_CEL_HEXA};
+
+  ecs_size_t   *def_cel_fac_pos = NULL;
+  ecs_int_t    *def_cel_fac_val = NULL;
+  ecs_size_t   *cel_val_idx = NULL;
+
+  ecs_size_t   *fac_pos = NULL;
+  ecs_int_t    *fac_val = NULL;
+
+  /*xxxxxxxxxxxxxxxxxxxxxxxxxxx Instructions xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx*/
+
+  /*=================*/
+  /* Initialisations */
+  /*=================*/
+
+  nbr_cel  = table_def_cel->nbr;
+
+  ecs_table__regle_en_pos(table_def_cel);
+
+  if (*table_def_fac != NULL) {
+    nbr_fac_old = (*table_def_fac)->nbr;
+    nbr_val_fac_old = ecs_table__ret_val_nbr(*table_def_fac);
+  }
+  else {
+    nbr_fac_old = 0;
+    nbr_val_fac_old = 0;
+  }
+
+  /* Boucle de comptage pour l'allocation des sous-éléments */
+  /*--------------------------------------------------------*/
+
+  /*
+    Le nombre de faces et de valeurs de chaque cellule est d'abord
+    stocké en position icel + 1, puis transformé en index, de manière
+    à ce que chaque cellule puisse ensuite être décomposée indépendamment
+    (et donc en parallèle).
+  */
+
+  ECS_MALLOC(def_cel_fac_pos, nbr_cel + 1, ecs_size_t);
+  ECS_MALLOC(cel_val_idx, nbr_cel + 1, ecs_size_t);
+
+# pragma omp parallel for if (nbr_cel > ECS_LOC_THR_MIN)
+  for (icel = 0; icel < nbr_cel; icel++) {
+
+    const size_t ind_pos_cel = table_def_cel->pos[icel] - 1;
+    const size_t ind_pos_sui = table_def_cel->pos[icel + 1] - 1;
+    const size_t nbr_val_cel = ind_pos_sui - ind_pos_cel;
+
+    size_t nbr_fac_cel = 0;
+    size_t nbr_val_cel_fac = 0;
+
+    /* Traitement des cellules "classiques" */
+
+    if (nbr_val_cel < 9) {
+
+      const ecs_int_t typ_geo_cel = typ_geo_base[nbr_val_cel];
+
+      for (int ifac = 0;
+           ifac < ecs_fic_elt_typ_liste_c[typ_geo_cel].nbr_sous_elt;
+           ifac++) {
+
+        const ecs_sous_elt_t  * sous_elt
+          = &(ecs_fic_elt_typ_liste_c[typ_geo_cel].sous_elt[ifac]);
+
+        nbr_fac_cel++;
+        nbr_val_cel_fac
+          += (ecs_fic_elt_typ_liste_c[sous_elt->elt_typ]).nbr_som;
+
+      }
+
+    }
+
+    /* Traitement des éléments de type "polyèdre" */
+
+    else {
+
+      /* Convention : définition nodale cellule->sommets avec numéros de
+         premiers sommets répétés en fin de liste pour marquer la fin
+         de chaque face */
+
+      ecs_int_t marqueur_fin = -1;
+
+      for (size_t isom = ind_pos_cel; isom < ind_pos_sui; isom++) {
+
+        if (table_def_cel->val[isom] != marqueur_fin) {
+          nbr_val_cel_fac += 1;
+          if (marqueur_fin == -1)
+            marqueur_fin = table_def_cel->val[isom];
+        }
+        else {
+          marqueur_fin = -1;
+          nbr_fac_cel += 1;
+        }
+
+      }
+
+    }
+
+    def_cel_fac_pos[icel + 1] = nbr_fac_cel;
+    cel_val_idx[icel + 1] = nbr_val_cel_fac;
+
+  } /* Fin de la boucle de comptage sur les cellules */
+
+  def_cel_fac_pos[0] = 1;
+  cel_val_idx[0] = nbr_val_fac_old;
+
+  for (icel = 0; icel < nbr_cel; icel++) {
+    def_cel_fac_pos[icel + 1] += def_cel_fac_pos[icel];
+    cel_val_idx[icel + 1] += cel_val_idx[icel];
+  }
+
+  /* Allocation et initialisation pour les faces  */
+  /*  des tableaux associés aux définitions       */
+  /*----------------------------------------------*/
+
+  nbr_fac = nbr_fac_old + def_cel_fac_pos[nbr_cel] - 1;
+  nbr_val_fac = cel_val_idx[nbr_cel];
+
+  if (*table_def_fac != NULL) {
+    ecs_table__regle_en_pos(*table_def_fac);
+    (*table_def_fac)->nbr = nbr_fac;
+    ECS_REALLOC((*table_def_fac)->pos, nbr_fac + 1, ecs_size_t);
+    ECS_REALLOC((*table_def_fac)->val, nbr_val_fac, ecs_int_t);
+  }
+  else {
+    *table_def_fac = ecs_table__alloue(nbr_fac,
+                                       nbr_val_fac);
+    (*table_def_fac)->pos[0] = 1;
+  }
+
+  ECS_MALLOC(def_cel_fac_val, nbr_fac - nbr_fac_old, ecs_int_t);
+
+  fac_pos = (*table_def_fac)->pos;
+  fac_val = (*table_def_fac)->val;
+
+  /*=======================================*/
+  /* Boucle sur les cellules à transformer */
+  /*=======================================*/
+
+# pragma omp parallel for if (nbr_cel > ECS_LOC_THR_MIN)
+  for (icel = 0; icel < nbr_cel; icel++) {
+
+    const size_t ind_pos_cel = table_def_cel->pos[icel] - 1;
+    const size_t nbr_val_cel = table_def_cel->pos[icel + 1] - 1 - ind_pos_cel;
+
+    size_t cpt_fac = nbr_fac_old + def_cel_fac_pos[icel] - 1;
+    size_t nbr_def = cel_val_idx[icel];
+
+    /*--------------------------------------*/
+    /* Traitement des éléments "classiques" */
+    /*--------------------------------------*/
+
+    if (nbr_val_cel < 9) {
+
+      const ecs_int_t typ_geo_cel = typ_geo_base[nbr_val_cel];
+
+      /* Boucle sur les faces définissant la cellulle */
+      /*==============================================*/
+
+      for (int ifac = 0;
+           ifac < ecs_fic_elt_typ_liste_c[typ_geo_cel].nbr_sous_elt;
+           ifac++) {
+
+        const ecs_sous_elt_t  * sous_elt
+          = &(ecs_fic_elt_typ_liste_c[typ_geo_cel].sous_elt[ifac]);
+
+        /* Définition de la face en fonction des sommets */
+
+        for (int idef = 0;
+             idef < (ecs_fic_elt_typ_liste_c[sous_elt->elt_typ]).nbr_som;
+             idef++) {
+
+          ecs_int_t num_def = sous_elt->som[idef];
+
+          fac_val[nbr_def++] = table_def_cel->val[ind_pos_cel + num_def - 1];
+
+        }
+
+        /* Position de la face dans sa définition en fonction des sommets */
+
+        fac_pos[cpt_fac + 1] = nbr_def + 1;
+
+        /* Détermination de la cellule en fonction des faces */
+
+        def_cel_fac_val[cpt_fac - nbr_fac_old] = cpt_fac + 1;
+
+        cpt_fac++;
+
+      } /* Fin de la boucle sur les faces d'une cellule */
+
+    }
+
+    /*--------------------------------------------*/
+    /* Traitement des éléments de type "polyèdre" */
+    /*--------------------------------------------*/
+
+    else {
+
+      ecs_int_t marqueur_fin = -1;
+
+      for (size_t ind_pos_loc = 0; ind_pos_loc < nbr_val_cel; ind_pos_loc++) {
+
+        /* Définition de la face en fonction des sommets */
+
+        if (table_def_cel->val[ind_pos_cel + ind_pos_loc] != marqueur_fin) {
+
+          fac_val[nbr_def++] = table_def_cel->val[ind_pos_cel + ind_pos_loc];
+
+          if (marqueur_fin == -1)
+            marqueur_fin = table_def_cel->val[ind_pos_cel + ind_pos_loc];
+
+        }
+
+        /* Position de la face dans sa définition en fonction des sommets */
+
+        else {
+
+          fac_pos[cpt_fac + 1] = nbr_def + 1;
+
+          marqueur_fin = -1;
+
+          def_cel_fac_val[cpt_fac - nbr_fac_old] = cpt_fac + 1;
+
+          cpt_fac++;
+
+        }
+
+      } /* Fin de la boucle sur les faces du polyèdre */
+
+    }
+
+    assert(cpt_fac == nbr_fac_old + def_cel_fac_pos[icel + 1] - 1);
+    assert(nbr_def == cel_val_idx[icel + 1]);
+
+  } /* Fin de la boucle sur les éléments */
+
+  ECS_FREE(cel_val_idx);
+
+  /* Mise à jour de la table */
+  /*-------------------------*/
+
+  ECS_FREE(table_def_cel->pos);
+  ECS_FREE(table_def_cel->val);
+
+  table_def_cel->pos = def_cel_fac_pos;
+  table_def_cel->val = def_cel_fac_val;
+
+  /* ecs_table__pos_en_regle(*table_def_fac); */
+  ecs_table__pos_en_regle(table_def_cel);
+}
+
+/*----------------------------------------------------------------------------
+ *  Fonction qui realise la fusion des definitions des elements
+ *----------------------------------------------------------------------------*/
+
+ecs_tab_int_t
+ecs_table_def__fusionne(ecs_table_t    *table_def,
+                        size_t         *nbr_elt_cpct,
+                        ecs_tab_int_t  *signe_elt)
+{
+  size_t           cpt_sup_fin;
+  size_t           ind_sup;
+  size_t           nbr_sup_ini;
+  size_t           pos_cpt;
+  size_t           pos_sup;
+
+  ecs_tab_int_t    tab_transf;    /* Tableau de transformation */
+
+  /*xxxxxxxxxxxxxxxxxxxxxxxxxxx Instructions xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx*/
+
+  ecs_table__regle_en_pos(table_def);
+
+  /* Fusion des definitions des elements sur la liste initiale  */
+  /*------------------------------------------------------------*/
+
+  /* Initialisations avec précautions pour cas vide */
+
+  tab_transf.nbr = 0;
+  tab_transf.val = NULL;
+
+  if (table_def == NULL)
+    return tab_transf;
+
+  if (table_def == NULL)
+    return tab_transf;
+
+  nbr_sup_ini = table_def->nbr;
+  cpt_sup_fin = 0;
+
+  if (nbr_sup_ini < 1)
+    return tab_transf;
+
+  if (signe_elt != NULL) {
+    signe_elt->nbr = nbr_sup_ini;
+    ECS_MALLOC(signe_elt->val, nbr_sup_ini, ecs_int_t);
+  }
+
+  tab_transf = ecs_tab_int__cree(nbr_sup_ini);
+
+  /* Recherche des éléments de même définition, par tri des formes
+     canoniques en multi-thread si possible, ou par recherche séquentielle
+     (le résultat étant identique) */
+
+  if (   _table_def__n_threads(nbr_sup_ini) < 2
+      || _table_def__fusion_tri(table_def, &tab_transf, signe_elt) == false)
+    _table_def__fusion_rech(table_def, &tab_transf, signe_elt);
 
   /* Compactage de la définition */
   /*-----------------------------*/
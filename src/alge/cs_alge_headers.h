@@ -53,6 +53,7 @@
 #include "cs_sles.h"
 #include "cs_sles_it.h"
 #include "cs_sles_pc.h"
+#include "cs_sles_tuning.h"
 
 // Avoid extra warnings by not including this by default...
 // #include "cs_sles_petsc.h"
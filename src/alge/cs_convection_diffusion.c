@@ -66,6 +66,7 @@
 #include "cs_parameters.h"
 #include "cs_porous_model.h"
 #include "cs_prototypes.h"
+#include "cs_scratch.h"
 #include "cs_timer.h"
 #include "cs_stokes_model.h"
 #include "cs_boundary_conditions.h"
@@ -1716,9 +1717,11 @@ cs_convection_diffusion_scalar(int                       idtvar,
 
   /* Initialization */
 
-  /* Allocate work arrays */
+  /* Allocate work arrays (from scratch memory) */
 
-  BFT_MALLOC(grad, n_cells_ext, cs_real_3_t);
+  cs_scratch_mark_t s_mark = cs_scratch_mark();
+
+  CS_SCRATCH_ALLOC(grad, n_cells_ext, cs_real_3_t);
 
   /* Choose gradient type */
 
@@ -1748,14 +1751,14 @@ cs_convection_diffusion_scalar(int                       idtvar,
     /* NVD/TVD limiters */
     if (ischcp == 4) {
       limiter_choice = cs_field_get_key_int(f, key_lim_choice);
-      BFT_MALLOC(local_max, n_cells_ext, cs_real_t);
-      BFT_MALLOC(local_min, n_cells_ext, cs_real_t);
+      CS_SCRATCH_ALLOC(local_max, n_cells_ext, cs_real_t);
+      CS_SCRATCH_ALLOC(local_min, n_cells_ext, cs_real_t);
       cs_field_local_extrema_scalar(f_id,
                                     halo_type,
                                     local_max,
                                     local_min);
       if (limiter_choice >= CS_NVD_VOF_HRIC) {
-        BFT_MALLOC(courant, n_cells_ext, cs_real_t);
+        CS_SCRATCH_ALLOC(courant, n_cells_ext, cs_real_t);
         cs_cell_courant_number(f_id, courant);
       }
     }
@@ -1880,7 +1883,7 @@ cs_convection_diffusion_scalar(int                       idtvar,
     /* Compute cell gradient used in slope test */
     if (isstpp == 0) {
 
-      BFT_MALLOC(gradst, n_cells_ext, cs_real_3_t);
+      CS_SCRATCH_ALLOC(gradst, n_cells_ext, cs_real_3_t);
 
 #     pragma omp parallel for
       for (cs_lnum_t cell_id = 0; cell_id < n_cells_ext; cell_id++) {
@@ -1904,7 +1907,7 @@ cs_convection_diffusion_scalar(int                       idtvar,
     /* Pure SOLU scheme */
     if (ischcp == 2) {
 
-      BFT_MALLOC(gradup, n_cells_ext, cs_real_3_t);
+      CS_SCRATCH_ALLOC(gradup, n_cells_ext, cs_real_3_t);
 
 #     pragma omp parallel for
       for (cs_lnum_t cell_id = 0; cell_id < n_cells_ext; cell_id++) {
@@ -2989,12 +2992,7 @@ cs_convection_diffusion_scalar(int                       idtvar,
   }
 
   /* Free memory */
-  BFT_FREE(grad);
-  BFT_FREE(gradup);
-  BFT_FREE(gradst);
-  BFT_FREE(local_max);
-  BFT_FREE(local_min);
-  BFT_FREE(courant);
+  cs_scratch_release(s_mark);
 }
 
 /*----------------------------------------------------------------------------*/
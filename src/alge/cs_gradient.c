@@ -65,6 +65,7 @@
 #include "cs_mesh_quantities.h"
 #include "cs_porous_model.h"
 #include "cs_prototypes.h"
+#include "cs_scratch.h"
 #include "cs_timer.h"
 #include "cs_timer_stats.h"
 #include "cs_bad_cells_regularisation.h"
@@ -1753,7 +1754,9 @@ _iterative_scalar_gradient(const cs_mesh_t                *m,
     return;
   }
 
-  BFT_MALLOC(rhs, n_cells_ext, cs_real_3_t);
+  cs_scratch_mark_t s_mark = cs_scratch_mark();
+
+  CS_SCRATCH_ALLOC(rhs, n_cells_ext, cs_real_3_t);
 
   /* Vector OijFij is computed in CLDijP */
 
@@ -2178,7 +2181,7 @@ _iterative_scalar_gradient(const cs_mesh_t                *m,
   if (gradient_info != NULL)
     _gradient_info_update_iter(gradient_info, n_sweeps);
 
-  BFT_FREE(rhs);
+  cs_scratch_release(s_mark);
 }
 
 /*----------------------------------------------------------------------------
@@ -2652,8 +2655,10 @@ _lsq_scalar_gradient(const cs_mesh_t                *m,
   /* Compute Right-Hand Side */
   /*-------------------------*/
 
+  cs_scratch_mark_t s_mark = cs_scratch_mark();
+
   cs_real_4_t  *restrict rhsv;
-  BFT_MALLOC(rhsv, n_cells_ext, cs_real_4_t);
+  CS_SCRATCH_ALLOC(rhsv, n_cells_ext, cs_real_4_t);
 
 # pragma omp parallel for
   for (cs_lnum_t c_id = 0; c_id < n_cells_ext; c_id++) {
@@ -3124,7 +3129,7 @@ _lsq_scalar_gradient(const cs_mesh_t                *m,
 
   _sync_scalar_gradient_halo(m, CS_HALO_STANDARD, idimtr, grad);
 
-  BFT_FREE(rhsv);
+  cs_scratch_release(s_mark);
 }
 
 /*----------------------------------------------------------------------------
@@ -3192,11 +3197,13 @@ _lsq_scalar_gradient_ani(const cs_mesh_t               *m,
   bool  *coupled_faces = (cpl == NULL) ?
     NULL : (bool *)cpl->coupled_faces;
 
+  cs_scratch_mark_t s_mark = cs_scratch_mark();
+
   cs_real_4_t  *restrict rhsv;
-  BFT_MALLOC(rhsv, n_cells_ext, cs_real_4_t);
+  CS_SCRATCH_ALLOC(rhsv, n_cells_ext, cs_real_4_t);
 
   cs_real_33_t  *restrict cocg = NULL;
-  BFT_MALLOC(cocg, n_cells_ext, cs_real_33_t);
+  CS_SCRATCH_ALLOC(cocg, n_cells_ext, cs_real_33_t);
 
 # pragma omp parallel for
   for (cs_lnum_t cell_id = 0; cell_id < n_cells_ext; cell_id++) {
@@ -3362,8 +3369,7 @@ _lsq_scalar_gradient_ani(const cs_mesh_t               *m,
 
   _sync_scalar_gradient_halo(m, CS_HALO_STANDARD, idimtr, grad);
 
-  BFT_FREE(cocg);
-  BFT_FREE(rhsv);
+  cs_scratch_release(s_mark);
 }
 
 /*----------------------------------------------------------------------------
@@ -5495,7 +5501,9 @@ _iterative_vector_gradient(const cs_mesh_t               *m,
   bool  *coupled_faces = (cpl == NULL) ?
     NULL : (bool *)cpl->coupled_faces;
 
-  BFT_MALLOC(rhs, n_cells_ext, cs_real_33_t);
+  cs_scratch_mark_t s_mark = cs_scratch_mark();
+
+  CS_SCRATCH_ALLOC(rhs, n_cells_ext, cs_real_33_t);
 
   /* Gradient reconstruction to handle non-orthogonal meshes */
   /*---------------------------------------------------------*/
@@ -5698,7 +5706,7 @@ _iterative_vector_gradient(const cs_mesh_t               *m,
   if (gradient_info != NULL)
     _gradient_info_update_iter(gradient_info, isweep);
 
-  BFT_FREE(rhs);
+  cs_scratch_release(s_mark);
 }
 
 /*----------------------------------------------------------------------------
@@ -5781,7 +5789,9 @@ _iterative_tensor_gradient(const cs_mesh_t              *m,
   if (cocg == NULL)
     cocg = _compute_cell_cocg_it(m, fvq, NULL, gq);
 
-  BFT_MALLOC(rhs, n_cells_ext, cs_real_63_t);
+  cs_scratch_mark_t s_mark = cs_scratch_mark();
+
+  CS_SCRATCH_ALLOC(rhs, n_cells_ext, cs_real_63_t);
 
   /* Gradient reconstruction to handle non-orthogonal meshes */
   /*---------------------------------------------------------*/
@@ -5971,7 +5981,7 @@ _iterative_tensor_gradient(const cs_mesh_t              *m,
   if (gradient_info != NULL)
     _gradient_info_update_iter(gradient_info, isweep);
 
-  BFT_FREE(rhs);
+  cs_scratch_release(s_mark);
 }
 
 /*----------------------------------------------------------------------------
@@ -6463,7 +6473,9 @@ _lsq_vector_gradient(const cs_mesh_t               *m,
 
   cs_real_33_t *rhs;
 
-  BFT_MALLOC(rhs, n_cells_ext, cs_real_33_t);
+  cs_scratch_mark_t s_mark = cs_scratch_mark();
+
+  CS_SCRATCH_ALLOC(rhs, n_cells_ext, cs_real_33_t);
 
   bool  *coupled_faces = (cpl == NULL) ?
     NULL : (bool *)cpl->coupled_faces;
@@ -6697,7 +6709,7 @@ _lsq_vector_gradient(const cs_mesh_t               *m,
       cs_halo_perio_sync_var_tens(m->halo, halo_type, (cs_real_t *)gradv);
   }
 
-  BFT_FREE(rhs);
+  cs_scratch_release(s_mark);
 }
 
 /*----------------------------------------------------------------------------
@@ -7109,7 +7121,9 @@ _lsq_tensor_gradient(const cs_mesh_t              *m,
 
   cs_real_63_t *rhs;
 
-  BFT_MALLOC(rhs, n_cells_ext, cs_real_63_t);
+  cs_scratch_mark_t s_mark = cs_scratch_mark();
+
+  CS_SCRATCH_ALLOC(rhs, n_cells_ext, cs_real_63_t);
 
   /* Compute Right-Hand Side */
   /*-------------------------*/
@@ -7326,7 +7340,7 @@ _lsq_tensor_gradient(const cs_mesh_t              *m,
       cs_halo_perio_sync_var_tens(m->halo, halo_type, (cs_real_t *)gradt);
   }
 
-  BFT_FREE(rhs);
+  cs_scratch_release(s_mark);
 }
 
 /*----------------------------------------------------------------------------
@@ -831,20 +831,17 @@ _post_function(void                  *sles_p,
 
   /* Check for mesh location */
 
-  int location_id = 0, flag = 0;
+  int location_id = 0;
   if (sp->n_rows == mesh->n_cells)
     location_id = CS_MESH_LOCATION_CELLS;
   else if (sp->n_rows == mesh->n_vertices)
     location_id = CS_MESH_LOCATION_VERTICES;
 
-  flag = location_id;
-  cs_parall_max(1, CS_INT_TYPE, &flag);
-  if (flag == location_id)
-    flag = 0;
-  else
-    flag =1;
-  cs_parall_max(1, CS_INT_TYPE, &flag);
-  if (flag != 0)
+  /* Location must be the same on all ranks (max == min) */
+
+  int flag[2] = {location_id, -location_id};
+  cs_parall_max(2, CS_INT_TYPE, flag);
+  if (flag[0] != -flag[1])
     return;
 
   strcpy(base_name, "Residual");
@@ -1878,19 +1875,17 @@ cs_sles_post_error_output_def(const char          *name,
 
     /* Check for mesh location */
 
-    int location_id = 0, flag = 0;
+    int location_id = 0;
     if (n_rows == mesh->n_cells)
       location_id = CS_MESH_LOCATION_CELLS;
     else if (n_rows == mesh->n_vertices)
       location_id = CS_MESH_LOCATION_VERTICES;
-    flag = location_id;
-    cs_parall_max(1, CS_INT_TYPE, &flag);
-    if (flag == location_id)
-      flag = 0;
-    else
-      flag =1;
-    cs_parall_max(1, CS_INT_TYPE, &flag);
-    if (flag != 0)
+
+    /* Location must be the same on all ranks (max == min) */
+
+    int flag[2] = {location_id, -location_id};
+    cs_parall_max(2, CS_INT_TYPE, flag);
+    if (flag[0] != -flag[1])
       return;
 
     /* Now generate output */
@@ -64,6 +64,7 @@
 #include "cs_sles.h"
 #include "cs_sles_it.h"
 #include "cs_sles_pc.h"
+#include "cs_sles_tuning.h"
 #include "cs_timer.h"
 
 /*----------------------------------------------------------------------------
@@ -340,6 +341,7 @@ cs_sles_default_finalize(void)
 {
   cs_sles_log(CS_LOG_PERFORMANCE);
 
+  cs_sles_tuning_finalize();
   cs_multigrid_finalize();
   cs_sles_finalize();
 }
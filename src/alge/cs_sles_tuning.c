@@ -0,0 +1,1319 @@
+/*============================================================================
+ * Sparse Linear Equation Solver run-time tuning
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#if defined(HAVE_MPI)
+#include <mpi.h>
+#endif
+
+/*----------------------------------------------------------------------------
+ * Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "bft_mem.h"
+#include "bft_error.h"
+#include "bft_printf.h"
+
+#include "cs_base.h"
+#include "cs_file.h"
+#include "cs_log.h"
+#include "cs_matrix.h"
+#include "cs_multigrid.h"
+#include "cs_sles.h"
+#include "cs_sles_it.h"
+#include "cs_sles_pc.h"
+#include "cs_timer.h"
+
+/*----------------------------------------------------------------------------
+ *  Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_sles_tuning.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Additional doxygen documentation
+ *============================================================================*/
+
+/*!
+  \file cs_sles_tuning.c
+        Run-time tuning of iterative linear solvers.
+
+  A self-tuning solver wraps a set of candidate iterative solver and
+  preconditioner combinations. During a tuning phase, successive solves
+  are handled by each candidate in turn, and the wall-clock time to
+  reach the required tolerance (including setup) is measured. The
+  fastest candidate is then used for subsequent solves, until an
+  optional re-evaluation interval is reached.
+
+  Candidates failing to converge during the tuning phase are discarded,
+  and the system is then solved again using the reference candidate
+  (the first one defined, or the previously selected one), so that
+  tuning does not alter the solution process.
+
+  Selections may be saved at the end of a run and reused by a later run
+  (see \ref cs_sles_tuning_save and \ref cs_sles_tuning_load).
+*/
+
+/*! \cond DOXYGEN_SHOULD_SKIP_THIS */
+
+/*=============================================================================
+ * Local Macro Definitions
+ *============================================================================*/
+
+/*=============================================================================
+ * Local Structure Definitions
+ *============================================================================*/
+
+/* Tuning candidate */
+/*------------------*/
+
+typedef struct {
+
+  cs_sles_it_type_t          type;          /* solver type */
+  cs_sles_tuning_pc_type_t   pc_type;       /* preconditioner type */
+
+  bool                       available;     /* usable for current matrix */
+
+  cs_sles_it_t              *it;            /* associated solver context
+                                               (built on first use) */
+
+  int                        n_trials;      /* number of trials in current
+                                               tuning phase */
+  int                        n_failed;      /* number of failed trials in
+                                               current tuning phase */
+  double                     t_trial;       /* accumulated trial wall time */
+  double                     t_mean;        /* mean trial wall time at last
+                                               selection, or < 0 */
+  int                        n_selected;    /* number of times selected */
+
+} cs_sles_tuning_candidate_t;
+
+/* Self-tuning solver context */
+/*----------------------------*/
+
+struct _cs_sles_tuning_t {
+
+  int                          n_max_iter;       /* maximum number of
+                                                    iterations */
+  int                          n_rounds;         /* number of trials per
+                                                    candidate */
+  int                          reeval_interval;  /* number of solves after
+                                                    which tuning is
+                                                    restarted (0: never) */
+
+  bool                         user_candidates;  /* candidates defined
+                                                    by user */
+
+  int                          n_candidates;     /* number of candidates */
+  int                          n_max_candidates; /* allocated candidates */
+  cs_sles_tuning_candidate_t  *candidates;       /* array of candidates */
+
+  char                        *name;             /* associated system name */
+
+  int                          trial_id;         /* trial counter in
+                                                    current tuning phase */
+  int                          selected_id;      /* selected candidate id,
+                                                    or -1 while tuning */
+  int                          ref_id;           /* reference candidate id */
+
+  int                          n_solves;         /* number of solves */
+  int                          n_since_selection;/* solves since selection */
+  int                          n_tunings;        /* number of tuning phases
+                                                    completed */
+  bool                         from_stored;      /* selection from previous
+                                                    run */
+
+  cs_timer_counter_t           t_tune;           /* time in tuning phases */
+  cs_timer_counter_t           t_solve;          /* total solution time */
+
+};
+
+/*============================================================================
+ *  Global variables
+ *============================================================================*/
+
+/* Names for preconditioner types */
+
+const char *cs_sles_tuning_pc_type_name[]
+  = {N_("Jacobi"),
+     N_("polynomial, degree 1"),
+     N_("multigrid, V-cycle"),
+     N_("multigrid, K-cycle")};
+
+/* Registered self-tuning solvers (for results output) */
+
+static int _n_tuners = 0;
+static int _n_max_tuners = 0;
+static cs_sles_tuning_t **_tuners = NULL;
+
+/* Results from a previous run */
+
+static bool _stored_loaded = false;
+static int _n_stored = 0;
+static char **_stored_names = NULL;
+static int *_stored_selection = NULL;
+
+static const char _default_load_path[] = "restart/sles_tuning.csv";
+static const char _default_save_path[] = "checkpoint/sles_tuning.csv";
+
+/*============================================================================
+ * Private function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Register a self-tuning solver.
+ *
+ * parameters:
+ *   c <-- pointer to solver context
+ *----------------------------------------------------------------------------*/
+
+static void
+_register_tuner(cs_sles_tuning_t  *c)
+{
+  if (_n_tuners >= _n_max_tuners) {
+    _n_max_tuners = CS_MAX(_n_max_tuners*2, 4);
+    BFT_REALLOC(_tuners, _n_max_tuners, cs_sles_tuning_t *);
+  }
+  _tuners[_n_tuners++] = c;
+}
+
+/*----------------------------------------------------------------------------
+ * Unregister a self-tuning solver.
+ *
+ * parameters:
+ *   c <-- pointer to solver context
+ *----------------------------------------------------------------------------*/
+
+static void
+_unregister_tuner(const cs_sles_tuning_t  *c)
+{
+  int j = 0;
+  for (int i = 0; i < _n_tuners; i++) {
+    if (_tuners[i] != c)
+      _tuners[j++] = _tuners[i];
+  }
+  _n_tuners = j;
+
+  if (_n_tuners == 0) {
+    _n_max_tuners = 0;
+    BFT_FREE(_tuners);
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Add a candidate to a self-tuning solver if not already present.
+ *
+ * parameters:
+ *   c           <-> pointer to solver context
+ *   solver_type <-- iterative solver type
+ *   pc_type     <-- preconditioner type
+ *----------------------------------------------------------------------------*/
+
+static void
+_add_candidate(cs_sles_tuning_t          *c,
+               cs_sles_it_type_t          solver_type,
+               cs_sles_tuning_pc_type_t   pc_type)
+{
+  for (int i = 0; i < c->n_candidates; i++) {
+    if (   c->candidates[i].type == solver_type
+        && c->candidates[i].pc_type == pc_type)
+      return;
+  }
+
+  if (c->n_candidates >= c->n_max_candidates) {
+    c->n_max_candidates = CS_MAX(c->n_max_candidates*2, 8);
+    BFT_REALLOC(c->candidates, c->n_max_candidates,
+                cs_sles_tuning_candidate_t);
+  }
+
+  cs_sles_tuning_candidate_t *cand = c->candidates + c->n_candidates;
+
+  cand->type = solver_type;
+  cand->pc_type = pc_type;
+  cand->available = true;
+  cand->it = NULL;
+  cand->n_trials = 0;
+  cand->n_failed = 0;
+  cand->t_trial = 0;
+  cand->t_mean = -1;
+  cand->n_selected = 0;
+
+  c->n_candidates += 1;
+}
+
+/*----------------------------------------------------------------------------
+ * Return (and build if needed) the solver associated with a candidate.
+ *
+ * parameters:
+ *   c    <-- pointer to solver context
+ *   cand <-> pointer to candidate
+ *
+ * returns:
+ *   pointer to iterative solver context
+ *----------------------------------------------------------------------------*/
+
+static cs_sles_it_t *
+_candidate_solver(const cs_sles_tuning_t      *c,
+                  cs_sles_tuning_candidate_t  *cand)
+{
+  if (cand->it == NULL) {
+
+    int poly_degree = -1;
+    if (cand->pc_type == CS_SLES_TUNING_PC_JACOBI)
+      poly_degree = 0;
+    else if (cand->pc_type == CS_SLES_TUNING_PC_POLY_1)
+      poly_degree = 1;
+
+    cand->it = cs_sles_it_create(cand->type,
+                                 poly_degree,
+                                 c->n_max_iter,
+                                 true);
+
+    if (cand->pc_type == CS_SLES_TUNING_PC_MG_V_CYCLE) {
+      cs_sles_pc_t *pc = cs_multigrid_pc_create(CS_MULTIGRID_V_CYCLE);
+      cs_sles_it_transfer_pc(cand->it, &pc);
+    }
+    else if (cand->pc_type == CS_SLES_TUNING_PC_MG_K_CYCLE) {
+      cs_sles_pc_t *pc = cs_multigrid_pc_create(CS_MULTIGRID_K_CYCLE);
+      cs_sles_it_transfer_pc(cand->it, &pc);
+    }
+
+  }
+
+  return cand->it;
+}
+
+/*----------------------------------------------------------------------------
+ * Reset tuning phase counters.
+ *
+ * parameters:
+ *   c <-> pointer to solver context
+ *----------------------------------------------------------------------------*/
+
+static void
+_reset_tuning(cs_sles_tuning_t  *c)
+{
+  c->trial_id = 0;
+  c->selected_id = -1;
+
+  for (int i = 0; i < c->n_candidates; i++) {
+    c->candidates[i].n_trials = 0;
+    c->candidates[i].n_failed = 0;
+    c->candidates[i].t_trial = 0;
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Apply selection stored by a previous run, if present.
+ *
+ * parameters:
+ *   c <-> pointer to solver context
+ *----------------------------------------------------------------------------*/
+
+static void
+_apply_stored(cs_sles_tuning_t  *c)
+{
+  for (int i = 0; i < _n_stored; i++) {
+
+    if (strcmp(_stored_names[i], c->name) != 0)
+      continue;
+
+    for (int j = 0; j < c->n_candidates; j++) {
+      cs_sles_tuning_candidate_t *cand = c->candidates + j;
+      if (   (int)(cand->type) == _stored_selection[i*2]
+          && (int)(cand->pc_type) == _stored_selection[i*2+1]
+          && cand->available) {
+        c->selected_id = j;
+        c->ref_id = j;
+        c->n_since_selection = 0;
+        c->from_stored = true;
+        cand->n_selected += 1;
+        return;
+      }
+    }
+
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Ensure candidates are defined and checked for a given matrix.
+ *
+ * parameters:
+ *   c    <-> pointer to solver context
+ *   name <-- system name
+ *   a    <-- matrix
+ *----------------------------------------------------------------------------*/
+
+static void
+_ensure_candidates(cs_sles_tuning_t   *c,
+                   const char         *name,
+                   const cs_matrix_t  *a)
+{
+  if (c->name != NULL)
+    return;
+
+  BFT_MALLOC(c->name, strlen(name) + 1, char);
+  strcpy(c->name, name);
+
+  /* Multigrid preconditioning is only handled for scalar MSR matrices */
+
+  bool mg_ok = false;
+  if (   cs_matrix_get_type(a) == CS_MATRIX_MSR
+      && cs_matrix_get_diag_block_size(a)[0] == 1)
+    mg_ok = true;
+
+  if (c->user_candidates == false) {
+
+    /* The first candidate is the reference, and matches the default
+       choice in cs_sles_default.c */
+
+    if (cs_matrix_is_symmetric(a)) {
+      if (mg_ok) {
+        if (cs_glob_n_threads > 1)
+          _add_candidate(c, CS_SLES_FCG, CS_SLES_TUNING_PC_MG_V_CYCLE);
+        else
+          _add_candidate(c, CS_SLES_PCG, CS_SLES_TUNING_PC_MG_V_CYCLE);
+      }
+      _add_candidate(c, CS_SLES_PCG, CS_SLES_TUNING_PC_JACOBI);
+      _add_candidate(c, CS_SLES_PCG, CS_SLES_TUNING_PC_POLY_1);
+      _add_candidate(c, CS_SLES_FCG, CS_SLES_TUNING_PC_JACOBI);
+      _add_candidate(c, CS_SLES_FCG, CS_SLES_TUNING_PC_MG_V_CYCLE);
+      _add_candidate(c, CS_SLES_FCG, CS_SLES_TUNING_PC_MG_K_CYCLE);
+    }
+    else {
+      _add_candidate(c, CS_SLES_BICGSTAB, CS_SLES_TUNING_PC_JACOBI);
+      _add_candidate(c, CS_SLES_BICGSTAB, CS_SLES_TUNING_PC_POLY_1);
+      _add_candidate(c, CS_SLES_GMRES, CS_SLES_TUNING_PC_JACOBI);
+      _add_candidate(c, CS_SLES_GMRES, CS_SLES_TUNING_PC_POLY_1);
+      _add_candidate(c, CS_SLES_BICGSTAB, CS_SLES_TUNING_PC_MG_V_CYCLE);
+      _add_candidate(c, CS_SLES_GMRES, CS_SLES_TUNING_PC_MG_V_CYCLE);
+    }
+
+  }
+
+  for (int i = 0; i < c->n_candidates; i++) {
+    cs_sles_tuning_candidate_t *cand = c->candidates + i;
+    if (   cand->pc_type == CS_SLES_TUNING_PC_MG_V_CYCLE
+        || cand->pc_type == CS_SLES_TUNING_PC_MG_K_CYCLE)
+      cand->available = mg_ok;
+  }
+
+  c->ref_id = -1;
+  for (int i = 0; i < c->n_candidates && c->ref_id < 0; i++) {
+    if (c->candidates[i].available)
+      c->ref_id = i;
+  }
+
+  if (c->ref_id < 0)
+    bft_error(__FILE__, __LINE__, 0,
+              _("%s: no usable candidate for system \"%s\"."),
+              __func__, name);
+
+  /* Reuse results from a previous run if available */
+
+  if (_stored_loaded == false)
+    cs_sles_tuning_load(NULL);
+
+  _apply_stored(c);
+}
+
+/*----------------------------------------------------------------------------
+ * Return id of next candidate to try in the current tuning phase.
+ *
+ * parameters:
+ *   c <-> pointer to solver context
+ *
+ * returns:
+ *   id of candidate to try, or -1 if tuning phase is complete
+ *----------------------------------------------------------------------------*/
+
+static int
+_next_trial(cs_sles_tuning_t  *c)
+{
+  int n_trials_max = c->n_rounds * c->n_candidates;
+
+  while (c->trial_id < n_trials_max) {
+    int cand_id = c->trial_id % c->n_candidates;
+    c->trial_id += 1;
+    const cs_sles_tuning_candidate_t *cand = c->candidates + cand_id;
+    if (cand->available && cand->n_failed == 0)
+      return cand_id;
+  }
+
+  return -1;
+}
+
+/*----------------------------------------------------------------------------
+ * Select fastest candidate at the end of a tuning phase.
+ *
+ * parameters:
+ *   c         <-> pointer to solver context
+ *   verbosity <-- verbosity level
+ *----------------------------------------------------------------------------*/
+
+static void
+_select(cs_sles_tuning_t  *c,
+        int                verbosity)
+{
+  const int n = c->n_candidates;
+
+  double *t_mean;
+  BFT_MALLOC(t_mean, n, double);
+
+  for (int i = 0; i < n; i++) {
+    const cs_sles_tuning_candidate_t *cand = c->candidates + i;
+    if (cand->available && cand->n_trials > 0 && cand->n_failed == 0)
+      t_mean[i] = cand->t_trial / cand->n_trials;
+    else
+      t_mean[i] = -1;
+  }
+
+  /* Use maximum value for comparisons, so all ranks make the same choice */
+
+#if defined(HAVE_MPI)
+
+  if (cs_glob_n_ranks > 1) {
+    double *t_local;
+    BFT_MALLOC(t_local, n, double);
+    for (int i = 0; i < n; i++)
+      t_local[i] = t_mean[i];
+    MPI_Allreduce(t_local, t_mean, n, MPI_DOUBLE, MPI_MAX, cs_glob_mpi_comm);
+    BFT_FREE(t_local);
+  }
+
+#endif
+
+  const int ref_id = c->ref_id;
+  int s_id = ref_id;
+
+  for (int i = 0; i < n; i++) {
+    if (t_mean[i] > 0 && (t_mean[s_id] <= 0 || t_mean[i] < t_mean[s_id]))
+      s_id = i;
+  }
+
+  for (int i = 0; i < n; i++)
+    c->candidates[i].t_mean = t_mean[i];
+
+  BFT_FREE(t_mean);
+
+  c->selected_id = s_id;
+  c->ref_id = s_id;
+  c->n_since_selection = 0;
+  c->n_tunings += 1;
+  c->from_stored = false;
+
+  cs_sles_tuning_candidate_t *s_cand = c->candidates + s_id;
+  s_cand->n_selected += 1;
+
+  /* Free setup data of candidates not selected */
+
+  for (int i = 0; i < n; i++) {
+    if (i != s_id && c->candidates[i].it != NULL)
+      cs_sles_it_free(c->candidates[i].it);
+  }
+
+  if (verbosity > 0)
+    cs_log_printf(CS_LOG_DEFAULT,
+                  _("  %s: selected solver %s with %s preconditioning\n"
+                    "    (mean time %12.5e s, reference %12.5e s)\n"),
+                  c->name,
+                  _(cs_sles_it_type_name[s_cand->type]),
+                  _(cs_sles_tuning_pc_type_name[s_cand->pc_type]),
+                  s_cand->t_mean,
+                  c->candidates[ref_id].t_mean);
+}
+
+/*----------------------------------------------------------------------------
+ * Parse stored results buffer.
+ *
+ * parameters:
+ *   buf <-> buffer (modified by parsing)
+ *----------------------------------------------------------------------------*/
+
+static void
+_parse_stored(char  *buf)
+{
+  char *line = buf;
+
+  while (line != NULL && *line != '\0') {
+
+    char *next = strchr(line, '\n');
+    if (next != NULL) {
+      *next = '\0';
+      next += 1;
+    }
+
+    /* Format: name;solver type;preconditioner type */
+
+    char *s1 = strrchr(line, ';');
+    char *s0 = NULL;
+    if (s1 != NULL) {
+      *s1 = '\0';
+      s0 = strrchr(line, ';');
+      if (s0 != NULL)
+        *s0 = '\0';
+    }
+
+    if (line[0] != '#' && s0 != NULL && s0 > line) {
+
+      int type_id = atoi(s0 + 1);
+      int pc_id = atoi(s1 + 1);
+
+      if (   type_id >= 0 && type_id < CS_SLES_N_IT_TYPES
+          && pc_id >= 0 && pc_id < CS_SLES_TUNING_N_PC_TYPES) {
+
+        BFT_REALLOC(_stored_names, _n_stored + 1, char *);
+        BFT_REALLOC(_stored_selection, (_n_stored + 1)*2, int);
+
+        BFT_MALLOC(_stored_names[_n_stored], strlen(line) + 1, char);
+        strcpy(_stored_names[_n_stored], line);
+        _stored_selection[_n_stored*2] = type_id;
+        _stored_selection[_n_stored*2 + 1] = pc_id;
+
+        _n_stored += 1;
+
+      }
+    }
+
+    line = next;
+  }
+}
+
+/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Define and associate a self-tuning linear system solver
+ *        for a given field or equation name.
+ *
+ * If this system did not previously exist, it is added to the list of
+ * "known" systems. Otherwise, its definition is replaced by the one
+ * defined here.
+ *
+ * This is a utility function: if finer control is needed, see
+ * \ref cs_sles_define and \ref cs_sles_tuning_create.
+ *
+ * \param[in]  f_id        associated field id, or < 0
+ * \param[in]  name        associated name if f_id < 0, or NULL
+ * \param[in]  n_max_iter  maximum number of iterations for candidates
+ *
+ * \return  pointer to newly created tuning solver info object.
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_sles_tuning_t *
+cs_sles_tuning_define(int          f_id,
+                      const char  *name,
+                      int          n_max_iter)
+{
+  cs_sles_tuning_t *c = cs_sles_tuning_create(n_max_iter);
+
+  cs_sles_define(f_id,
+                 name,
+                 c,
+                 "cs_sles_tuning_t",
+                 cs_sles_tuning_setup,
+                 cs_sles_tuning_solve,
+                 cs_sles_tuning_free,
+                 cs_sles_tuning_log,
+                 cs_sles_tuning_copy,
+                 cs_sles_tuning_destroy);
+
+  return c;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Create self-tuning linear system solver info and context.
+ *
+ * If no candidate is added using \ref cs_sles_tuning_add_candidate,
+ * a default candidate set based on the matrix properties is built
+ * upon the first setup.
+ *
+ * \param[in]  n_max_iter  maximum number of iterations for candidates
+ *
+ * \return  pointer to newly created solver info object.
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_sles_tuning_t *
+cs_sles_tuning_create(int  n_max_iter)
+{
+  cs_sles_tuning_t *c;
+
+  BFT_MALLOC(c, 1, cs_sles_tuning_t);
+
+  c->n_max_iter = n_max_iter;
+  c->n_rounds = 2;
+  c->reeval_interval = 0;
+
+  c->user_candidates = false;
+
+  c->n_candidates = 0;
+  c->n_max_candidates = 0;
+  c->candidates = NULL;
+
+  c->name = NULL;
+
+  c->trial_id = 0;
+  c->selected_id = -1;
+  c->ref_id = 0;
+
+  c->n_solves = 0;
+  c->n_since_selection = 0;
+  c->n_tunings = 0;
+  c->from_stored = false;
+
+  CS_TIMER_COUNTER_INIT(c->t_tune);
+  CS_TIMER_COUNTER_INIT(c->t_solve);
+
+  _register_tuner(c);
+
+  return c;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Destroy self-tuning linear system solver info and context.
+ *
+ * \param[in, out]  context  pointer to solver info and context
+ *                           (actual type: cs_sles_tuning_t  **)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_destroy(void  **context)
+{
+  cs_sles_tuning_t *c = (cs_sles_tuning_t *)(*context);
+
+  if (c != NULL) {
+
+    for (int i = 0; i < c->n_candidates; i++) {
+      if (c->candidates[i].it != NULL) {
+        void *it = c->candidates[i].it;
+        cs_sles_it_destroy(&it);
+        c->candidates[i].it = NULL;
+      }
+    }
+
+    BFT_FREE(c->candidates);
+    BFT_FREE(c->name);
+
+    _unregister_tuner(c);
+
+    BFT_FREE(c);
+    *context = c;
+
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Create self-tuning linear system solver info and context
+ *        based on existing info and context.
+ *
+ * \param[in]  context  pointer to reference info and context
+ *                      (actual type: cs_sles_tuning_t  *)
+ *
+ * \return  pointer to newly created solver info object
+ *          (actual type: cs_sles_tuning_t  *)
+ */
+/*----------------------------------------------------------------------------*/
+
+void *
+cs_sles_tuning_copy(const void  *context)
+{
+  cs_sles_tuning_t *d = NULL;
+
+  if (context != NULL) {
+    const cs_sles_tuning_t *c = context;
+    d = cs_sles_tuning_create(c->n_max_iter);
+    cs_sles_tuning_set_options(d, c->n_rounds, c->reeval_interval);
+    if (c->user_candidates) {
+      for (int i = 0; i < c->n_candidates; i++)
+        cs_sles_tuning_add_candidate(d,
+                                     c->candidates[i].type,
+                                     c->candidates[i].pc_type);
+    }
+  }
+
+  return d;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Add a candidate solver and preconditioner combination.
+ *
+ * The first candidate added is used as a reference, so it should be
+ * the most robust one.
+ *
+ * \param[in, out]  context      pointer to solver info and context
+ * \param[in]       solver_type  iterative solver type
+ * \param[in]       pc_type      preconditioner type
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_add_candidate(cs_sles_tuning_t          *context,
+                             cs_sles_it_type_t          solver_type,
+                             cs_sles_tuning_pc_type_t   pc_type)
+{
+  cs_sles_tuning_t *c = context;
+
+  if (c->name != NULL)
+    bft_error(__FILE__, __LINE__, 0,
+              _("%s: candidates for system \"%s\" may not be added\n"
+                "after the first setup."),
+              __func__, c->name);
+
+  if (solver_type >= CS_SLES_N_IT_TYPES || solver_type == CS_SLES_JACOBI)
+    bft_error(__FILE__, __LINE__, 0,
+              _("%s: solver type %s is not a Krylov solver."),
+              __func__, _(cs_sles_it_type_name[solver_type]));
+
+  c->user_candidates = true;
+
+  _add_candidate(c, solver_type, pc_type);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set tuning options.
+ *
+ * \param[in, out]  context          pointer to solver info and context
+ * \param[in]       n_rounds         number of timed solves per candidate
+ * \param[in]       reeval_interval  number of solves with the selected
+ *                                   candidate after which tuning is
+ *                                   restarted (0 for never)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_set_options(cs_sles_tuning_t  *context,
+                           int                n_rounds,
+                           int                reeval_interval)
+{
+  cs_sles_tuning_t *c = context;
+
+  c->n_rounds = CS_MAX(n_rounds, 1);
+  c->reeval_interval = CS_MAX(reeval_interval, 0);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Setup self-tuning linear equation solver.
+ *
+ * During a tuning phase, the setup of each candidate is deferred to the
+ * matching solve, so that it is included in the measured time.
+ *
+ * \param[in, out]  context    pointer to solver info and context
+ *                             (actual type: cs_sles_tuning_t  *)
+ * \param[in]       name       pointer to system name
+ * \param[in]       a          associated matrix
+ * \param[in]       verbosity  associated verbosity
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_setup(void               *context,
+                     const char         *name,
+                     const cs_matrix_t  *a,
+                     int                 verbosity)
+{
+  cs_sles_tuning_t *c = context;
+
+  _ensure_candidates(c, name, a);
+
+  if (c->selected_id > -1) {
+    cs_sles_tuning_candidate_t *cand = c->candidates + c->selected_id;
+    cs_sles_it_setup(_candidate_solver(c, cand), name, a, verbosity);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Call self-tuning linear equation solver.
+ *
+ * \param[in, out]  context        pointer to solver info and context
+ *                                 (actual type: cs_sles_tuning_t  *)
+ * \param[in]       name           pointer to system name
+ * \param[in]       a              matrix
+ * \param[in]       verbosity      associated verbosity
+ * \param[in]       rotation_mode  halo update option for rotational
+ *                                 periodicity
+ * \param[in]       precision      solver precision
+ * \param[in]       r_norm         residue normalization
+ * \param[out]      n_iter         number of "equivalent" iterations
+ * \param[out]      residue        residue
+ * \param[in]       rhs            right hand side
+ * \param[in, out]  vx             system solution
+ * \param[in]       aux_size       number of elements in aux_vectors
+ *                                 (in bytes)
+ * \param           aux_vectors    optional working area
+ *                                 (internal allocation if NULL)
+ *
+ * \return  convergence state
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_sles_convergence_state_t
+cs_sles_tuning_solve(void                *context,
+                     const char          *name,
+                     const cs_matrix_t   *a,
+                     int                  verbosity,
+                     cs_halo_rotation_t   rotation_mode,
+                     double               precision,
+                     double               r_norm,
+                     int                 *n_iter,
+                     double              *residue,
+                     const cs_real_t     *rhs,
+                     cs_real_t           *vx,
+                     size_t               aux_size,
+                     void                *aux_vectors)
+{
+  cs_sles_tuning_t *c = context;
+
+  cs_timer_t t0 = cs_timer_time();
+
+  _ensure_candidates(c, name, a);
+
+  c->n_solves += 1;
+
+  int cand_id = c->selected_id;
+  bool trial = false;
+
+  if (cand_id < 0) {
+    cand_id = _next_trial(c);
+    if (cand_id < 0) {
+      _select(c, verbosity);
+      cand_id = c->selected_id;
+    }
+    else
+      trial = true;
+  }
+
+  cs_sles_tuning_candidate_t *cand = c->candidates + cand_id;
+
+  /* Save initial solution in case a trial candidate fails */
+
+  cs_real_t *vx_save = NULL;
+  cs_lnum_t n_vals = 0;
+
+  if (trial && cand_id != c->ref_id) {
+    n_vals =   cs_matrix_get_n_rows(a)
+             * cs_matrix_get_diag_block_size(a)[0];
+    BFT_MALLOC(vx_save, n_vals, cs_real_t);
+    memcpy(vx_save, vx, n_vals*sizeof(cs_real_t));
+  }
+
+  cs_timer_t t1 = cs_timer_time();
+
+  cs_sles_convergence_state_t cvg
+    = cs_sles_it_solve(_candidate_solver(c, cand),
+                       name,
+                       a,
+                       verbosity,
+                       rotation_mode,
+                       precision,
+                       r_norm,
+                       n_iter,
+                       residue,
+                       rhs,
+                       vx,
+                       aux_size,
+                       aux_vectors);
+
+  if (trial) {
+
+    cs_timer_t t2 = cs_timer_time();
+    cs_timer_counter_t t_trial = cs_timer_diff(&t1, &t2);
+
+    cand->n_trials += 1;
+
+    if (cvg == CS_SLES_CONVERGED)
+      cand->t_trial += t_trial.wall_nsec*1e-9;
+
+    else {
+
+      cand->n_failed += 1;
+
+      if (verbosity > 0)
+        cs_log_printf(CS_LOG_DEFAULT,
+                      _("  %s: tuning candidate %s with %s preconditioning"
+                        " discarded (no convergence)\n"),
+                      name,
+                      _(cs_sles_it_type_name[cand->type]),
+                      _(cs_sles_tuning_pc_type_name[cand->pc_type]));
+
+      /* Solve again with reference candidate */
+
+      if (vx_save != NULL) {
+        memcpy(vx, vx_save, n_vals*sizeof(cs_real_t));
+        cs_sles_tuning_candidate_t *ref_cand = c->candidates + c->ref_id;
+        cvg = cs_sles_it_solve(_candidate_solver(c, ref_cand),
+                               name,
+                               a,
+                               verbosity,
+                               rotation_mode,
+                               precision,
+                               r_norm,
+                               n_iter,
+                               residue,
+                               rhs,
+                               vx,
+                               aux_size,
+                               aux_vectors);
+      }
+
+    }
+
+    /* Avoid keeping multiple setups (such as multigrid hierarchies)
+       in memory during tuning */
+
+    if (cand_id != c->ref_id)
+      cs_sles_it_free(cand->it);
+
+    BFT_FREE(vx_save);
+
+    cs_timer_t t3 = cs_timer_time();
+    cs_timer_counter_add_diff(&(c->t_tune), &t0, &t3);
+
+  }
+
+  /* Restart tuning periodically if requested */
+
+  else if (c->reeval_interval > 0) {
+    c->n_since_selection += 1;
+    if (c->n_since_selection >= c->reeval_interval)
+      _reset_tuning(c);
+  }
+
+  cs_timer_t t4 = cs_timer_time();
+  cs_timer_counter_add_diff(&(c->t_solve), &t0, &t4);
+
+  return cvg;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Free self-tuning linear equation solver setup context.
+ *
+ * This function frees resolution-related data of all candidates,
+ * but does not free the whole context, as info used for logging
+ * (especially performance data) is maintained.
+ *
+ * \param[in, out]  context  pointer to solver info and context
+ *                           (actual type: cs_sles_tuning_t  *)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_free(void  *context)
+{
+  cs_sles_tuning_t *c = context;
+
+  for (int i = 0; i < c->n_candidates; i++) {
+    if (c->candidates[i].it != NULL)
+      cs_sles_it_free(c->candidates[i].it);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Log self-tuning linear equation solver info.
+ *
+ * \param[in]  context   pointer to solver info and context
+ *                       (actual type: cs_sles_tuning_t  *)
+ * \param[in]  log_type  log type
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_log(const void  *context,
+                   cs_log_t     log_type)
+{
+  const cs_sles_tuning_t  *c = context;
+
+  if (log_type == CS_LOG_SETUP) {
+
+    cs_log_printf(log_type,
+                  _("  Solver type:                       self-tuning\n"
+                    "  Timed solves per candidate:        %d\n"
+                    "  Re-evaluation interval:            %d\n"
+                    "  Maximum number of iterations:      %d\n"),
+                  c->n_rounds, c->reeval_interval, c->n_max_iter);
+
+    if (c->user_candidates) {
+      cs_log_printf(log_type, _("  Candidates:\n"));
+      for (int i = 0; i < c->n_candidates; i++)
+        cs_log_printf(log_type,
+                      "    %-32s %s\n",
+                      _(cs_sles_it_type_name[c->candidates[i].type]),
+                      _(cs_sles_tuning_pc_type_name[c->candidates[i].pc_type]));
+    }
+    else
+      cs_log_printf(log_type,
+                    _("  Candidates:                        automatic\n"));
+
+  }
+
+  else if (log_type == CS_LOG_PERFORMANCE) {
+
+    cs_log_printf(log_type,
+                  _("\n"
+                    "  Solver type:                   self-tuning\n"
+                    "  Number of calls:               %12d\n"
+                    "  Number of tuning phases:       %12d\n"
+                    "  Total tuning time:             %12.3f\n"
+                    "  Total solution time:           %12.3f\n"),
+                  c->n_solves, c->n_tunings,
+                  c->t_tune.wall_nsec*1e-9,
+                  c->t_solve.wall_nsec*1e-9);
+
+    if (c->from_stored)
+      cs_log_printf(log_type,
+                    _("  Selection reused from previous run\n"));
+
+    cs_log_printf(log_type,
+                  _("\n"
+                    "  Candidate                                      "
+                    "          mean time  selected\n"));
+
+    for (int i = 0; i < c->n_candidates; i++) {
+      const cs_sles_tuning_candidate_t *cand = c->candidates + i;
+      char cand_name[64];
+      snprintf(cand_name, 63, "%s, %s",
+               _(cs_sles_it_type_name[cand->type]),
+               _(cs_sles_tuning_pc_type_name[cand->pc_type]));
+      cand_name[63] = '\0';
+      char mark = (i == c->selected_id) ? '*' : ' ';
+      if (cand->available == false)
+        cs_log_printf(log_type,
+                      "  %-50s        n/a  %8d\n",
+                      cand_name, cand->n_selected);
+      else if (cand->t_mean < 0)
+        cs_log_printf(log_type,
+                      "  %-50s          -  %8d %c\n",
+                      cand_name, cand->n_selected, mark);
+      else
+        cs_log_printf(log_type,
+                      "  %-50s %12.5e  %8d %c\n",
+                      cand_name, cand->t_mean, cand->n_selected, mark);
+    }
+
+    for (int i = 0; i < c->n_candidates; i++) {
+      const cs_sles_tuning_candidate_t *cand = c->candidates + i;
+      if (cand->it != NULL && cand->n_selected > 0)
+        cs_sles_it_log(cand->it, log_type);
+    }
+
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return the id of the currently selected candidate.
+ *
+ * \param[in]  context  pointer to solver info and context
+ *
+ * \return  id of selected candidate, or -1 if tuning is in progress
+ */
+/*----------------------------------------------------------------------------*/
+
+int
+cs_sles_tuning_get_selected(const cs_sles_tuning_t  *context)
+{
+  return context->selected_id;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Read tuning results saved by a previous run.
+ *
+ * Results are read on rank 0 and broadcast to other ranks. Matching
+ * systems will use the stored selection upon their first setup, without
+ * a tuning phase (periodic re-evaluation still applies).
+ *
+ * \param[in]  path  path to results file
+ *                   (if NULL, "restart/sles_tuning.csv" is used)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_load(const char  *path)
+{
+  const char *_path = (path != NULL) ? path : _default_load_path;
+
+  _stored_loaded = true;
+
+  long buf_size = 0;
+  char *buf = NULL;
+
+  if (cs_glob_rank_id < 1) {
+
+    FILE *f = fopen(_path, "r");
+
+    if (f != NULL) {
+      if (fseek(f, 0, SEEK_END) == 0)
+        buf_size = ftell(f);
+      if (buf_size > 0 && fseek(f, 0, SEEK_SET) == 0) {
+        BFT_MALLOC(buf, buf_size + 1, char);
+        buf_size = fread(buf, 1, buf_size, f);
+        buf[buf_size] = '\0';
+      }
+      else
+        buf_size = 0;
+      fclose(f);
+    }
+    else if (path != NULL)
+      bft_printf(_("\n"
+                   " Warning: linear solver tuning results file\n"
+                   "   \"%s\" could not be read.\n"), _path);
+
+  }
+
+#if defined(HAVE_MPI)
+
+  if (cs_glob_n_ranks > 1) {
+    MPI_Bcast(&buf_size, 1, MPI_LONG, 0, cs_glob_mpi_comm);
+    if (buf_size > 0) {
+      if (cs_glob_rank_id > 0)
+        BFT_MALLOC(buf, buf_size + 1, char);
+      MPI_Bcast(buf, buf_size + 1, MPI_CHAR, 0, cs_glob_mpi_comm);
+    }
+  }
+
+#endif
+
+  if (buf_size > 0)
+    _parse_stored(buf);
+
+  BFT_FREE(buf);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Save tuning results so as to be reused by a later run.
+ *
+ * Only systems for which a selection was made are saved. Results are
+ * written by rank 0 only.
+ *
+ * \param[in]  path  path to results file
+ *                   (if NULL, "checkpoint/sles_tuning.csv" is used)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_save(const char  *path)
+{
+  if (cs_glob_rank_id > 0)
+    return;
+
+  const char *_path = path;
+
+  if (path == NULL) {
+    if (cs_file_mkdir_default("checkpoint") != 0)
+      return;
+    _path = _default_save_path;
+  }
+
+  FILE *f = fopen(_path, "w");
+
+  if (f == NULL) {
+    bft_printf(_("\n"
+                 " Warning: linear solver tuning results file\n"
+                 "   \"%s\" could not be written.\n"), _path);
+    return;
+  }
+
+  fprintf(f, "# Linear solver tuning results\n"
+          "# system;solver type id;preconditioner type id\n");
+
+  for (int i = 0; i < _n_tuners; i++) {
+    const cs_sles_tuning_t *c = _tuners[i];
+    if (c->name != NULL && c->ref_id > -1
+        && (c->n_tunings > 0 || c->from_stored)) {
+      const cs_sles_tuning_candidate_t *cand = c->candidates + c->ref_id;
+      fprintf(f, "%s;%d;%d\n", c->name, (int)cand->type, (int)cand->pc_type);
+    }
+  }
+
+  fclose(f);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Finalize linear solver tuning API.
+ *
+ * Results are saved if at least one self-tuning solver has made
+ * a selection, and stored results are freed.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_finalize(void)
+{
+  bool have_results = false;
+
+  for (int i = 0; i < _n_tuners; i++) {
+    if (_tuners[i]->n_tunings > 0 || _tuners[i]->from_stored)
+      have_results = true;
+  }
+
+  if (have_results)
+    cs_sles_tuning_save(NULL);
+
+  for (int i = 0; i < _n_stored; i++)
+    BFT_FREE(_stored_names[i]);
+  BFT_FREE(_stored_names);
+  BFT_FREE(_stored_selection);
+  _n_stored = 0;
+  _stored_loaded = false;
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
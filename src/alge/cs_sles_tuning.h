@@ -0,0 +1,337 @@
+#ifndef __CS_SLES_TUNING_H__
+#define __CS_SLES_TUNING_H__
+
+/*============================================================================
+ * Sparse Linear Equation Solver run-time tuning
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "cs_base.h"
+#include "cs_halo_perio.h"
+#include "cs_matrix.h"
+#include "cs_sles.h"
+#include "cs_sles_it.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*============================================================================
+ * Macro definitions
+ *============================================================================*/
+
+/*============================================================================
+ * Type definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Preconditioner types which may be associated with tuning candidates
+ *----------------------------------------------------------------------------*/
+
+typedef enum {
+
+  CS_SLES_TUNING_PC_JACOBI,      /*!< Jacobi (diagonal) preconditioner */
+  CS_SLES_TUNING_PC_POLY_1,      /*!< Neumann polynomial of degree 1 */
+  CS_SLES_TUNING_PC_MG_V_CYCLE,  /*!< Multigrid V-cycle preconditioner */
+  CS_SLES_TUNING_PC_MG_K_CYCLE,  /*!< Multigrid K-cycle preconditioner */
+
+  CS_SLES_TUNING_N_PC_TYPES      /*!< Number of preconditioner types */
+
+} cs_sles_tuning_pc_type_t;
+
+/* Linear solver tuning context (opaque) */
+
+typedef struct _cs_sles_tuning_t  cs_sles_tuning_t;
+
+/*============================================================================
+ *  Global variables
+ *============================================================================*/
+
+/* Names for preconditioner types */
+
+extern const char *cs_sles_tuning_pc_type_name[];
+
+/*=============================================================================
+ * Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Define and associate a self-tuning linear system solver
+ *        for a given field or equation name.
+ *
+ * If this system did not previously exist, it is added to the list of
+ * "known" systems. Otherwise, its definition is replaced by the one
+ * defined here.
+ *
+ * This is a utility function: if finer control is needed, see
+ * \ref cs_sles_define and \ref cs_sles_tuning_create.
+ *
+ * \param[in]  f_id        associated field id, or < 0
+ * \param[in]  name        associated name if f_id < 0, or NULL
+ * \param[in]  n_max_iter  maximum number of iterations for candidates
+ *
+ * \return  pointer to newly created tuning solver info object.
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_sles_tuning_t *
+cs_sles_tuning_define(int          f_id,
+                      const char  *name,
+                      int          n_max_iter);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Create self-tuning linear system solver info and context.
+ *
+ * If no candidate is added using \ref cs_sles_tuning_add_candidate,
+ * a default candidate set based on the matrix properties is built
+ * upon the first setup.
+ *
+ * \param[in]  n_max_iter  maximum number of iterations for candidates
+ *
+ * \return  pointer to newly created solver info object.
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_sles_tuning_t *
+cs_sles_tuning_create(int  n_max_iter);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Destroy self-tuning linear system solver info and context.
+ *
+ * \param[in, out]  context  pointer to solver info and context
+ *                           (actual type: cs_sles_tuning_t  **)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_destroy(void  **context);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Create self-tuning linear system solver info and context
+ *        based on existing info and context.
+ *
+ * \param[in]  context  pointer to reference info and context
+ *                      (actual type: cs_sles_tuning_t  *)
+ *
+ * \return  pointer to newly created solver info object
+ *          (actual type: cs_sles_tuning_t  *)
+ */
+/*----------------------------------------------------------------------------*/
+
+void *
+cs_sles_tuning_copy(const void  *context);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Add a candidate solver and preconditioner combination.
+ *
+ * The first candidate added is used as a reference, so it should be
+ * the most robust one.
+ *
+ * \param[in, out]  context      pointer to solver info and context
+ * \param[in]       solver_type  iterative solver type
+ * \param[in]       pc_type      preconditioner type
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_add_candidate(cs_sles_tuning_t          *context,
+                             cs_sles_it_type_t          solver_type,
+                             cs_sles_tuning_pc_type_t   pc_type);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set tuning options.
+ *
+ * \param[in, out]  context          pointer to solver info and context
+ * \param[in]       n_rounds         number of timed solves per candidate
+ * \param[in]       reeval_interval  number of solves with the selected
+ *                                   candidate after which tuning is
+ *                                   restarted (0 for never)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_set_options(cs_sles_tuning_t  *context,
+                           int                n_rounds,
+                           int                reeval_interval);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Setup self-tuning linear equation solver.
+ *
+ * \param[in, out]  context    pointer to solver info and context
+ *                             (actual type: cs_sles_tuning_t  *)
+ * \param[in]       name       pointer to system name
+ * \param[in]       a          associated matrix
+ * \param[in]       verbosity  associated verbosity
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_setup(void               *context,
+                     const char         *name,
+                     const cs_matrix_t  *a,
+                     int                 verbosity);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Call self-tuning linear equation solver.
+ *
+ * \param[in, out]  context        pointer to solver info and context
+ *                                 (actual type: cs_sles_tuning_t  *)
+ * \param[in]       name           pointer to system name
+ * \param[in]       a              matrix
+ * \param[in]       verbosity      associated verbosity
+ * \param[in]       rotation_mode  halo update option for rotational
+ *                                 periodicity
+ * \param[in]       precision      solver precision
+ * \param[in]       r_norm         residue normalization
+ * \param[out]      n_iter         number of "equivalent" iterations
+ * \param[out]      residue        residue
+ * \param[in]       rhs            right hand side
+ * \param[in, out]  vx             system solution
+ * \param[in]       aux_size       number of elements in aux_vectors
+ *                                 (in bytes)
+ * \param           aux_vectors    optional working area
+ *                                 (internal allocation if NULL)
+ *
+ * \return  convergence state
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_sles_convergence_state_t
+cs_sles_tuning_solve(void                *context,
+                     const char          *name,
+                     const cs_matrix_t   *a,
+                     int                  verbosity,
+                     cs_halo_rotation_t   rotation_mode,
+                     double               precision,
+                     double               r_norm,
+                     int                 *n_iter,
+                     double              *residue,
+                     const cs_real_t     *rhs,
+                     cs_real_t           *vx,
+                     size_t               aux_size,
+                     void                *aux_vectors);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Free self-tuning linear equation solver setup context.
+ *
+ * This function frees resolution-related data of all candidates,
+ * but does not free the whole context, as info used for logging
+ * (especially performance data) is maintained.
+ *
+ * \param[in, out]  context  pointer to solver info and context
+ *                           (actual type: cs_sles_tuning_t  *)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_free(void  *context);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Log self-tuning linear equation solver info.
+ *
+ * \param[in]  context   pointer to solver info and context
+ *                       (actual type: cs_sles_tuning_t  *)
+ * \param[in]  log_type  log type
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_log(const void  *context,
+                   cs_log_t     log_type);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return the id of the currently selected candidate.
+ *
+ * \param[in]  context  pointer to solver info and context
+ *
+ * \return  id of selected candidate, or -1 if tuning is in progress
+ */
+/*----------------------------------------------------------------------------*/
+
+int
+cs_sles_tuning_get_selected(const cs_sles_tuning_t  *context);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Read tuning results saved by a previous run.
+ *
+ * Results are read on rank 0 and broadcast to other ranks. Matching
+ * systems will use the stored selection upon their first setup, without
+ * a tuning phase (periodic re-evaluation still applies).
+ *
+ * \param[in]  path  path to results file
+ *                   (if NULL, "restart/sles_tuning.csv" is used)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_load(const char  *path);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Save tuning results so as to be reused by a later run.
+ *
+ * Only systems for which a selection was made are saved. Results are
+ * written by rank 0 only.
+ *
+ * \param[in]  path  path to results file
+ *                   (if NULL, "checkpoint/sles_tuning.csv" is used)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_save(const char  *path);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Finalize linear solver tuning API.
+ *
+ * Results are saved if at least one self-tuning solver has made
+ * a selection, and stored results are freed.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_sles_tuning_finalize(void);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_SLES_TUNING_H__ */
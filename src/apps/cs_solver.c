@@ -76,6 +76,7 @@
 #include "cs_lagr.h"
 #include "cs_lagr_tracking.h"
 #include "cs_les_inflow.h"
+#include "cs_load_balance.h"
 #include "cs_log.h"
 #include "cs_log_setup.h"
 #include "cs_log_iteration.h"
@@ -106,6 +107,7 @@
 #include "cs_sles.h"
 #include "cs_sles_default.h"
 #include "cs_sat_coupling.h"
+#include "cs_scratch.h"
 #include "cs_syr_coupling.h"
 #include "cs_system_info.h"
 #include "cs_time_moment.h"
@@ -115,6 +117,7 @@
 #include "cs_turbomachinery.h"
 #include "cs_volume_mass_injection.h"
 #include "cs_volume_zone.h"
+#include "cs_wall_distance_geom.h"
 
 /*----------------------------------------------------------------------------*/
 
@@ -458,6 +461,10 @@ _run(void)
 
     cs_inflow_finalize();
 
+    /* Finalize geometric wall distance computation */
+
+    cs_wall_distance_geom_finalize();
+
   }
 
   /* Finalize user extra operations */
@@ -561,8 +568,10 @@ _run(void)
 
   /* CPU times and memory management finalization */
 
+  cs_load_balance_log_finalize();
   cs_all_to_all_log_finalize();
   cs_io_log_finalize();
+  cs_scratch_finalize();
 
   cs_timer_stats_finalize();
 
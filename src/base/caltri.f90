@@ -248,9 +248,15 @@ if (iilagr.gt.0) then
   lagr_stats_id = timer_stats_create("stages", &
                                      "lagrangian_stage", &
                                      "Lagrangian Module")
+  stats_id = timer_stats_create("lagrangian_stage", &
+                                "particle_injection_stage", &
+                                "particle injection")
   stats_id = timer_stats_create("lagrangian_stage", &
                                 "particle_displacement_stage", &
                                 "particle displacement")
+  stats_id = timer_stats_create("lagrangian_stage", &
+                                "particle_statistics_stage", &
+                                "particle statistics")
 endif
 
 !===============================================================================
@@ -477,6 +483,8 @@ call fldtri
 
 call field_allocate_or_map_all
 
+call cs_numa_log_placement
+
 call field_get_val_s_by_name('dt', dt)
 
 call iniva0(nscal)
@@ -849,6 +857,14 @@ call pstvar(nvar, nscal)
 
 call timer_stats_stop(post_stats_id)
 
+! Dynamic load balancing does not handle the following (legacy) arrays
+
+if (ncpdct.gt.0) call load_balance_disable('head losses')
+if (nctsmt.gt.0) call load_balance_disable('mass source terms')
+if (nftcdt.gt.0) call load_balance_disable('wall condensation')
+if (icondv.eq.0) call load_balance_disable('volume condensation')
+if (nent.gt.0) call load_balance_disable('synthetic turbulence inlets')
+
 ! Start time loop
 
  100  continue
@@ -1129,6 +1145,30 @@ if (itrale.le.0) then
   write(nfecra,3012)titer2-titer1
 endif
 
+!===============================================================================
+! Dynamic load balancing
+!===============================================================================
+
+if (itrale.gt.0 .and. ntcabs.lt.ntmabs) then
+
+  mesh_modified = cs_load_balance_time_step()
+
+  if (mesh_modified) then
+
+    ! Update mappings of arrays reallocated by the redistribution
+
+    call boundary_conditions_update_mesh
+    call fldtri
+    call field_get_val_s_by_name('dt', dt)
+
+    if (iilagr.gt.0) then
+      call map_lagr_arrays(tslagr)
+    endif
+
+  endif
+
+endif
+
 !===============================================================================
 ! End of time loop
 !===============================================================================
@@ -82,6 +82,11 @@ BEGIN_C_DECLS
   \var CS_ALL_TO_ALL_CRYSTAL_ROUTER
        Use crystal router algorithm
 
+  \var CS_ALL_TO_ALL_HIERARCHICAL
+       Use MPI_Alltoall and MPI_Alltoallv sequences, with data aggregated
+       on one rank per compute node (or group of ranks on a node) before
+       inter-node exchange, and scattered locally afterwards
+
   \paragraph all_to_all_flags Using flags
   \parblock
 
@@ -153,8 +158,35 @@ typedef struct {
   int             n_ranks;           /* Number of ranks associated with
                                         communicator */
 
+  struct _hier_comm_t  *hc;          /* Associated node hierarchy for
+                                        hierarchical exchanges, or NULL */
+
 } _mpi_all_to_all_caller_t;
 
+/* Rank hierarchy for hierarchical exchanges */
+
+typedef struct _hier_comm_t {
+
+  MPI_Comm        comm;              /* Parent MPI communicator */
+  int             group_size_max;    /* Maximum group size used for build */
+
+  MPI_Comm        intra_comm;        /* Intra-group communicator */
+  MPI_Comm        inter_comm;        /* Inter-group communicator for group
+                                        leaders (MPI_COMM_NULL on others) */
+
+  int             n_ranks;           /* Number of ranks in comm */
+  int             n_groups;          /* Number of groups */
+  int             intra_rank;        /* Rank id in intra-group communicator */
+  int             intra_size;        /* Size of local group */
+
+  int            *group_index;       /* Index of ranks in group_ranks
+                                        (size: n_groups + 1) */
+  int            *group_ranks;       /* Ranks of each group, ordered */
+  int            *rank_group;        /* Group id for each rank */
+  int            *rank_pos;          /* Position of each rank in group */
+
+} _hier_comm_t;
+
 #endif /* defined(HAVE_MPI) */
 
 /* Structure used to redistribute data */
@@ -218,8 +250,21 @@ struct _cs_all_to_all_t {
 
 static cs_all_to_all_type_t _all_to_all_type = CS_ALL_TO_ALL_MPI_DEFAULT;
 
+/* Maximum group size for hierarchical exchanges (0 for compute node) */
+
+static int _hier_group_size_max = 0;
+
 #if defined(HAVE_MPI)
 
+/* Rank hierarchies for hierarchical exchanges are attached to their
+   parent communicator as attributes, so they are destroyed with it;
+   communicators with an attached hierarchy are also listed, so as to
+   release remaining hierarchies on finalization */
+
+static int        _hier_comm_keyval = MPI_KEYVAL_INVALID;
+static int        _n_hier_comms = 0;
+static MPI_Comm  *_hier_comms = NULL;
+
 /* Call counter and timer: 0: total, 1: metadata comm, 2: data comm */
 
 static size_t              _all_to_all_calls[3] = {0, 0, 0};
@@ -335,6 +380,545 @@ _compute_displ(int        n_ranks,
   return total_count;
 }
 
+/*----------------------------------------------------------------------------
+ * Build rank hierarchy for hierarchical exchanges.
+ *
+ * Ranks are grouped by shared-memory compute node (when available), and
+ * node groups are split further when larger than the given maximum
+ * group size.
+ *
+ * parameters:
+ *   comm           <-- associated MPI communicator
+ *   group_size_max <-- maximum group size, or 0 for no limit
+ *
+ * returns:
+ *   pointer to new rank hierarchy structure
+ *---------------------------------------------------------------------------*/
+
+static _hier_comm_t *
+_hier_comm_create(MPI_Comm  comm,
+                  int       group_size_max)
+{
+  int rank_id;
+  MPI_Comm node_comm = MPI_COMM_NULL;
+
+  _hier_comm_t *hc;
+  BFT_MALLOC(hc, 1, _hier_comm_t);
+
+  hc->comm = comm;
+  hc->group_size_max = group_size_max;
+
+  MPI_Comm_rank(comm, &rank_id);
+  MPI_Comm_size(comm, &(hc->n_ranks));
+
+  /* Group ranks by compute node, then limit group size */
+
+#if (MPI_VERSION < 3)
+  if (group_size_max > 0)
+    MPI_Comm_split(comm, rank_id / group_size_max, rank_id, &node_comm);
+  else
+    MPI_Comm_split(comm, 0, rank_id, &node_comm);
+#else
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank_id,
+                      MPI_INFO_NULL, &node_comm);
+#endif
+
+  {
+    int node_rank, node_size;
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_size(node_comm, &node_size);
+    if (group_size_max > 0 && node_size > group_size_max) {
+      MPI_Comm_split(node_comm, node_rank / group_size_max, node_rank,
+                     &(hc->intra_comm));
+      MPI_Comm_free(&node_comm);
+    }
+    else
+      hc->intra_comm = node_comm;
+  }
+
+  MPI_Comm_rank(hc->intra_comm, &(hc->intra_rank));
+  MPI_Comm_size(hc->intra_comm, &(hc->intra_size));
+
+  /* Group leaders (first rank of each group) build inter-group
+     communicator, ordered by global rank */
+
+  int color = (hc->intra_rank == 0) ? 0 : MPI_UNDEFINED;
+  MPI_Comm_split(comm, color, rank_id, &(hc->inter_comm));
+
+  /* Identify groups based on leader's global rank */
+
+  int leader_rank = rank_id;
+  MPI_Bcast(&leader_rank, 1, MPI_INT, 0, hc->intra_comm);
+
+  BFT_MALLOC(hc->rank_group, hc->n_ranks, int);
+  BFT_MALLOC(hc->rank_pos, hc->n_ranks, int);
+
+  MPI_Allgather(&leader_rank, 1, MPI_INT, hc->rank_group, 1, MPI_INT, comm);
+
+  /* Leaders have increasing global ranks, so compact numbering
+     based on leader rank is consistent with inter_comm ranks */
+
+  hc->n_groups = 0;
+  for (int i = 0; i < hc->n_ranks; i++) {
+    if (hc->rank_group[i] == i) {
+      hc->rank_pos[i] = hc->n_groups;
+      hc->n_groups += 1;
+    }
+  }
+  for (int i = 0; i < hc->n_ranks; i++)
+    hc->rank_group[i] = hc->rank_pos[hc->rank_group[i]];
+
+  BFT_MALLOC(hc->group_index, hc->n_groups + 1, int);
+  BFT_MALLOC(hc->group_ranks, hc->n_ranks, int);
+
+  for (int i = 0; i < hc->n_groups + 1; i++)
+    hc->group_index[i] = 0;
+  for (int i = 0; i < hc->n_ranks; i++)
+    hc->group_index[hc->rank_group[i] + 1] += 1;
+  for (int i = 0; i < hc->n_groups; i++)
+    hc->group_index[i+1] += hc->group_index[i];
+
+  /* Intra-group communicators are ordered by global rank */
+
+  for (int i = 0; i < hc->n_ranks; i++) {
+    int g_id = hc->rank_group[i];
+    int j = hc->group_index[g_id];
+    hc->group_index[g_id] += 1;
+    hc->group_ranks[j] = i;
+  }
+  for (int i = hc->n_groups; i > 0; i--)
+    hc->group_index[i] = hc->group_index[i-1];
+  hc->group_index[0] = 0;
+
+  for (int i = 0; i < hc->n_groups; i++) {
+    for (int j = hc->group_index[i]; j < hc->group_index[i+1]; j++)
+      hc->rank_pos[hc->group_ranks[j]] = j - hc->group_index[i];
+  }
+
+  return hc;
+}
+
+/*----------------------------------------------------------------------------
+ * Destroy rank hierarchy for hierarchical exchanges.
+ *
+ * parameters:
+ *   hc <-> pointer to pointer to rank hierarchy structure
+ *---------------------------------------------------------------------------*/
+
+static void
+_hier_comm_destroy(_hier_comm_t  **hc)
+{
+  _hier_comm_t *_hc = *hc;
+
+  if (_hc->inter_comm != MPI_COMM_NULL)
+    MPI_Comm_free(&(_hc->inter_comm));
+  MPI_Comm_free(&(_hc->intra_comm));
+
+  BFT_FREE(_hc->group_ranks);
+  BFT_FREE(_hc->group_index);
+  BFT_FREE(_hc->rank_pos);
+  BFT_FREE(_hc->rank_group);
+
+  BFT_FREE(*hc);
+}
+
+/*----------------------------------------------------------------------------
+ * Delete callback for rank hierarchy attribute of a communicator.
+ *
+ * This is called by MPI when the parent communicator is freed or when
+ * the attribute is deleted.
+ *
+ * parameters:
+ *   comm         <-- parent MPI communicator
+ *   keyval       <-- associated key value
+ *   attr_val     <-> pointer to rank hierarchy structure
+ *   extra_state  <-- unused
+ *
+ * returns:
+ *   MPI_SUCCESS
+ *---------------------------------------------------------------------------*/
+
+static int
+_hier_comm_delete_attr(MPI_Comm   comm,
+                       int        keyval,
+                       void      *attr_val,
+                       void      *extra_state)
+{
+  CS_UNUSED(keyval);
+  CS_UNUSED(extra_state);
+
+  _hier_comm_t *hc = attr_val;
+  _hier_comm_destroy(&hc);
+
+  for (int i = 0; i < _n_hier_comms; i++) {
+    if (_hier_comms[i] == comm) {
+      _n_hier_comms -= 1;
+      _hier_comms[i] = _hier_comms[_n_hier_comms];
+      break;
+    }
+  }
+
+  return MPI_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------
+ * Return rank hierarchy associated with a communicator.
+ *
+ * Hierarchies are built upon first use and attached to the communicator
+ * (or rebuilt if the maximum group size has changed), so this is a
+ * collective operation on the given communicator.
+ *
+ * parameters:
+ *   comm <-- associated MPI communicator
+ *
+ * returns:
+ *   pointer to rank hierarchy structure, or NULL if a hierarchical
+ *   exchange would not be useful (single group or single rank groups).
+ *---------------------------------------------------------------------------*/
+
+static _hier_comm_t *
+_hier_comm_get(MPI_Comm  comm)
+{
+  _hier_comm_t *hc = NULL;
+  int flag = 0;
+
+  if (_hier_comm_keyval == MPI_KEYVAL_INVALID)
+    MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN,
+                           _hier_comm_delete_attr,
+                           &_hier_comm_keyval,
+                           NULL);
+  else
+    MPI_Comm_get_attr(comm, _hier_comm_keyval, &hc, &flag);
+
+  if (flag && hc->group_size_max != _hier_group_size_max) {
+    MPI_Comm_delete_attr(comm, _hier_comm_keyval);
+    flag = 0;
+  }
+
+  if (!flag) {
+    hc = _hier_comm_create(comm, _hier_group_size_max);
+    MPI_Comm_set_attr(comm, _hier_comm_keyval, hc);
+    BFT_REALLOC(_hier_comms, _n_hier_comms + 1, MPI_Comm);
+    _hier_comms[_n_hier_comms] = comm;
+    _n_hier_comms += 1;
+  }
+
+  if (hc->n_groups < 2 || hc->n_groups == hc->n_ranks)
+    hc = NULL;
+
+  return hc;
+}
+
+/*----------------------------------------------------------------------------
+ * Node-aware (hierarchical) equivalent of MPI_Alltoallv.
+ *
+ * Data is gathered on the leader rank of each group, exchanged between
+ * group leaders only, and scattered back to destination ranks, so
+ * the number of inter-node messages is reduced from n_ranks^2 to
+ * n_groups^2. Received data is ordered by source rank, as with
+ * MPI_Alltoallv.
+ *
+ * If send_count and recv_count are NULL, exactly one element is
+ * exchanged with each rank (as with MPI_Alltoall with a count of 1).
+ *
+ * parameters:
+ *   hc         <-- associated rank hierarchy
+ *   sendbuf    <-- send buffer
+ *   send_count <-- number of elements to send to each rank, or NULL
+ *   send_displ <-- displacement of elements to send to each rank, or NULL
+ *   recvbuf    --> receive buffer
+ *   recv_count <-- number of elements to receive from each rank, or NULL
+ *   recv_displ <-- displacement of elements received from each rank,
+ *                  or NULL
+ *   datatype   <-- MPI datatype of exchanged elements
+ *---------------------------------------------------------------------------*/
+
+static void
+_hier_alltoallv(const _hier_comm_t  *hc,
+                const void          *sendbuf,
+                const int            send_count[],
+                const int            send_displ[],
+                void                *recvbuf,
+                const int            recv_count[],
+                const int            recv_displ[],
+                MPI_Datatype         datatype)
+{
+  const int n_ranks = hc->n_ranks;
+  const int n_groups = hc->n_groups;
+  const int l_size = hc->intra_size;
+  const bool is_leader = (hc->intra_rank == 0);
+
+  MPI_Aint lb, extent;
+  MPI_Type_get_extent(datatype, &lb, &extent);
+  const size_t e_size = extent;
+
+  int *_send_count = NULL;
+
+  if (send_count == NULL) {
+    BFT_MALLOC(_send_count, n_ranks, int);
+    for (int i = 0; i < n_ranks; i++)
+      _send_count[i] = 1;
+    send_count = _send_count;
+  }
+
+  /* Pack send data contiguously if required */
+
+  const unsigned char *_sendbuf = sendbuf;
+  unsigned char *send_tmp = NULL;
+
+  int n_send = 0;
+  {
+    bool contiguous = true;
+    for (int i = 0; i < n_ranks; i++) {
+      if (send_displ != NULL && send_displ[i] != n_send)
+        contiguous = false;
+      n_send += send_count[i];
+    }
+    if (!contiguous) {
+      BFT_MALLOC(send_tmp, n_send*e_size, unsigned char);
+      size_t k = 0;
+      for (int i = 0; i < n_ranks; i++) {
+        size_t n = send_count[i]*e_size;
+        memcpy(send_tmp + k, _sendbuf + send_displ[i]*e_size, n);
+        k += n;
+      }
+      _sendbuf = send_tmp;
+    }
+  }
+
+  /* Gather counts and data on group leader */
+
+  int *l_count = NULL, *l_n = NULL, *l_displ = NULL;
+  unsigned char *l_buf = NULL;
+
+  if (is_leader) {
+    BFT_MALLOC(l_count, l_size*n_ranks, int);
+    BFT_MALLOC(l_n, l_size, int);
+    BFT_MALLOC(l_displ, l_size + 1, int);
+  }
+
+  MPI_Gather(send_count, n_ranks, MPI_INT,
+             l_count, n_ranks, MPI_INT, 0, hc->intra_comm);
+  MPI_Gather(&n_send, 1, MPI_INT, l_n, 1, MPI_INT, 0, hc->intra_comm);
+
+  if (is_leader) {
+    l_displ[0] = 0;
+    for (int l = 0; l < l_size; l++)
+      l_displ[l+1] = l_displ[l] + l_n[l];
+    BFT_MALLOC(l_buf, l_displ[l_size]*e_size, unsigned char);
+  }
+
+  MPI_Gatherv(_sendbuf, n_send, datatype,
+              l_buf, l_n, l_displ, datatype, 0, hc->intra_comm);
+
+  BFT_FREE(send_tmp);
+  BFT_FREE(_send_count);
+
+  /* Exchange between group leaders */
+
+  int *r_count = NULL, *r_n = NULL, *r_displ = NULL;
+  unsigned char *r_buf = NULL;
+
+  if (is_leader) {
+
+    int *g_s_count, *g_r_count, *g_s_displ, *g_r_displ;
+    BFT_MALLOC(g_s_count, n_groups*4 + 2, int);
+    g_r_count = g_s_count + n_groups;
+    g_s_displ = g_r_count + n_groups;
+    g_r_displ = g_s_displ + n_groups + 1;
+
+    /* Counts metadata: block for group G ordered by (r in G, l) */
+
+    int *s_meta, *r_meta;
+    BFT_MALLOC(s_meta, n_ranks*l_size, int);
+
+    for (int g = 0, k = 0; g < n_groups; g++) {
+      int n_g = hc->group_index[g+1] - hc->group_index[g];
+      g_s_count[g] = n_g * l_size;
+      for (int j = hc->group_index[g]; j < hc->group_index[g+1]; j++) {
+        int r = hc->group_ranks[j];
+        for (int l = 0; l < l_size; l++)
+          s_meta[k++] = l_count[l*n_ranks + r];
+      }
+    }
+
+    /* Receive from group H: ordered by (r in local group, l' in H) */
+
+    for (int g = 0; g < n_groups; g++) {
+      int n_g = hc->group_index[g+1] - hc->group_index[g];
+      g_r_count[g] = l_size * n_g;
+    }
+
+    _compute_displ(n_groups, g_s_count, g_s_displ);
+    _compute_displ(n_groups, g_r_count, g_r_displ);
+
+    BFT_MALLOC(r_meta, n_ranks*l_size, int);
+
+    MPI_Alltoallv(s_meta, g_s_count, g_s_displ, MPI_INT,
+                  r_meta, g_r_count, g_r_displ, MPI_INT,
+                  hc->inter_comm);
+
+    /* Reorder gathered data by (G, r in G, l) */
+
+    int *l_r_displ;
+    BFT_MALLOC(l_r_displ, l_size*n_ranks, int);
+    for (int l = 0; l < l_size; l++) {
+      int k = l_displ[l];
+      for (int r = 0; r < n_ranks; r++) {
+        l_r_displ[l*n_ranks + r] = k;
+        k += l_count[l*n_ranks + r];
+      }
+    }
+
+    unsigned char *s_buf;
+    BFT_MALLOC(s_buf, l_displ[l_size]*e_size, unsigned char);
+
+    size_t s_k = 0;
+    for (int g = 0; g < n_groups; g++) {
+      size_t s_k0 = s_k;
+      for (int j = hc->group_index[g]; j < hc->group_index[g+1]; j++) {
+        int r = hc->group_ranks[j];
+        for (int l = 0; l < l_size; l++) {
+          size_t n = l_count[l*n_ranks + r]*e_size;
+          memcpy(s_buf + s_k,
+                 l_buf + (size_t)(l_r_displ[l*n_ranks + r])*e_size,
+                 n);
+          s_k += n;
+        }
+      }
+      g_s_count[g] = (s_k - s_k0) / e_size;
+    }
+
+    BFT_FREE(l_r_displ);
+    BFT_FREE(l_buf);
+
+    /* Received data counts per (H, r in local group, l' in H) */
+
+    for (int g = 0; g < n_groups; g++) {
+      int n_g = hc->group_index[g+1] - hc->group_index[g];
+      int n = 0;
+      for (int k = 0; k < l_size*n_g; k++)
+        n += r_meta[g_r_displ[g] + k];
+      g_r_count[g] = n;
+    }
+
+    _compute_displ(n_groups, g_s_count, g_s_displ);
+    size_t n_r_g = _compute_displ(n_groups, g_r_count, g_r_displ);
+
+    unsigned char *g_buf;
+    BFT_MALLOC(g_buf, n_r_g*e_size, unsigned char);
+
+    MPI_Alltoallv(s_buf, g_s_count, g_s_displ, datatype,
+                  g_buf, g_r_count, g_r_displ, datatype,
+                  hc->inter_comm);
+
+    BFT_FREE(s_buf);
+
+    /* Reorder received data by (local destination rank, source rank);
+       r_count[p*n_ranks + s] is the count from rank s to local rank p */
+
+    BFT_MALLOC(r_count, l_size*n_ranks, int);
+    int *r_src_displ;
+    BFT_MALLOC(r_src_displ, l_size*n_ranks, int);
+
+    {
+      size_t k = 0;
+      int m = 0;
+      for (int g = 0; g < n_groups; g++) {
+        const int *g_ranks = hc->group_ranks + hc->group_index[g];
+        int n_g = hc->group_index[g+1] - hc->group_index[g];
+        for (int p = 0; p < l_size; p++) {
+          for (int l = 0; l < n_g; l++) {
+            int c = r_meta[m++];
+            r_count[p*n_ranks + g_ranks[l]] = c;
+            r_src_displ[p*n_ranks + g_ranks[l]] = k;
+            k += c;
+          }
+        }
+      }
+    }
+
+    BFT_FREE(r_meta);
+    BFT_FREE(s_meta);
+
+    BFT_MALLOC(r_n, l_size, int);
+    BFT_MALLOC(r_displ, l_size + 1, int);
+    r_displ[0] = 0;
+    for (int p = 0; p < l_size; p++) {
+      int n = 0;
+      for (int s = 0; s < n_ranks; s++)
+        n += r_count[p*n_ranks + s];
+      r_n[p] = n;
+      r_displ[p+1] = r_displ[p] + n;
+    }
+
+    BFT_MALLOC(r_buf, r_displ[l_size]*e_size, unsigned char);
+
+    {
+      size_t k = 0;
+      for (int p = 0; p < l_size; p++) {
+        for (int s = 0; s < n_ranks; s++) {
+          size_t n = r_count[p*n_ranks + s]*e_size;
+          memcpy(r_buf + k,
+                 g_buf + (size_t)(r_src_displ[p*n_ranks + s])*e_size,
+                 n);
+          k += n;
+        }
+      }
+    }
+
+    BFT_FREE(r_src_displ);
+    BFT_FREE(g_buf);
+    BFT_FREE(g_s_count);
+  }
+
+  BFT_FREE(l_displ);
+  BFT_FREE(l_n);
+  BFT_FREE(l_count);
+
+  /* Scatter data to destination ranks */
+
+  int n_recv = 0;
+  MPI_Scatter(r_n, 1, MPI_INT, &n_recv, 1, MPI_INT, 0, hc->intra_comm);
+
+  unsigned char *_recvbuf = recvbuf;
+  unsigned char *recv_tmp = NULL;
+
+  if (recv_count != NULL && recv_displ != NULL) {
+    bool contiguous = true;
+    int n = 0;
+    for (int i = 0; i < n_ranks; i++) {
+      if (recv_displ[i] != n)
+        contiguous = false;
+      n += recv_count[i];
+    }
+    if (!contiguous) {
+      BFT_MALLOC(recv_tmp, n_recv*e_size, unsigned char);
+      _recvbuf = recv_tmp;
+    }
+  }
+
+  MPI_Scatterv(r_buf, r_n, r_displ, datatype,
+               _recvbuf, n_recv, datatype, 0, hc->intra_comm);
+
+  if (recv_tmp != NULL) {
+    size_t k = 0;
+    for (int i = 0; i < n_ranks; i++) {
+      size_t n = recv_count[i]*e_size;
+      memcpy((unsigned char *)recvbuf + recv_displ[i]*e_size,
+             recv_tmp + k,
+             n);
+      k += n;
+    }
+    BFT_FREE(recv_tmp);
+  }
+
+  BFT_FREE(r_buf);
+  BFT_FREE(r_displ);
+  BFT_FREE(r_n);
+  BFT_FREE(r_count);
+}
+
 /*----------------------------------------------------------------------------
  * First stage of creation for an MPI_Alltoall(v) caller for strided data.
  *
@@ -395,6 +979,8 @@ _alltoall_caller_create_meta(int        flags,
 
   dc->comp_type = MPI_BYTE;
 
+  dc->hc = NULL;
+
   /* Return pointer to structure */
 
   return dc;
@@ -842,9 +1428,15 @@ _alltoall_caller_exchange_meta(_mpi_all_to_all_caller_t  *dc,
 
   cs_timer_t t0 = cs_timer_time();
 
-  MPI_Alltoall(dc->send_count, 1, MPI_INT,
-               dc->recv_count, 1, MPI_INT,
-               dc->comm);
+  if (dc->hc != NULL)
+    _hier_alltoallv(dc->hc,
+                    dc->send_count, NULL, NULL,
+                    dc->recv_count, NULL, NULL,
+                    MPI_INT);
+  else
+    MPI_Alltoall(dc->send_count, 1, MPI_INT,
+                 dc->recv_count, 1, MPI_INT,
+                 dc->comm);
 
   cs_timer_t t1 = cs_timer_time();
   cs_timer_counter_add_diff(_all_to_all_timers + CS_ALL_TO_ALL_TIME_METADATA,
@@ -893,9 +1485,17 @@ _alltoall_caller_exchange_s(cs_all_to_all_t           *d,
 
   cs_timer_t t0 = cs_timer_time();
 
-  MPI_Alltoallv(dc->send_buffer, dc->send_count, dc->send_displ, dc->comp_type,
-                _recv_data, dc->recv_count, dc->recv_displ, dc->comp_type,
-                dc->comm);
+  if (dc->hc != NULL)
+    _hier_alltoallv(dc->hc,
+                    dc->send_buffer, dc->send_count, dc->send_displ,
+                    _recv_data, dc->recv_count, dc->recv_displ,
+                    dc->comp_type);
+  else
+    MPI_Alltoallv(dc->send_buffer, dc->send_count, dc->send_displ,
+                  dc->comp_type,
+                  _recv_data, dc->recv_count, dc->recv_displ,
+                  dc->comp_type,
+                  dc->comm);
 
   cs_timer_t t1 = cs_timer_time();
   cs_timer_counter_add_diff(_all_to_all_timers + CS_ALL_TO_ALL_TIME_EXCHANGE,
@@ -1009,9 +1609,17 @@ _alltoall_caller_exchange_i(cs_all_to_all_t           *d,
 
   cs_timer_t t0 = cs_timer_time();
 
-  MPI_Alltoallv(dc->send_buffer, dc->send_count, dc->send_displ, dc->comp_type,
-                _recv_data, dc->recv_count, dc->recv_displ, dc->comp_type,
-                dc->comm);
+  if (dc->hc != NULL)
+    _hier_alltoallv(dc->hc,
+                    dc->send_buffer, dc->send_count, dc->send_displ,
+                    _recv_data, dc->recv_count, dc->recv_displ,
+                    dc->comp_type);
+  else
+    MPI_Alltoallv(dc->send_buffer, dc->send_count, dc->send_displ,
+                  dc->comp_type,
+                  _recv_data, dc->recv_count, dc->recv_displ,
+                  dc->comp_type,
+                  dc->comm);
 
   cs_timer_t t1 = cs_timer_time();
   cs_timer_counter_add_diff(_all_to_all_timers + CS_ALL_TO_ALL_TIME_EXCHANGE,
@@ -1317,8 +1925,11 @@ cs_all_to_all_create(size_t            n_elts,
   /* Create substructures based on info available at this stage
      (for Crystal Router, delay creation as data is not passed yet) */
 
-  if (d->type == CS_ALL_TO_ALL_MPI_DEFAULT)
+  if (d->type != CS_ALL_TO_ALL_CRYSTAL_ROUTER) {
     d->dc = _alltoall_caller_create_meta(flags, comm);
+    if (d->type == CS_ALL_TO_ALL_HIERARCHICAL)
+      d->dc->hc = _hier_comm_get(comm);
+  }
 
   t1 = cs_timer_time();
   cs_timer_counter_add_diff(_all_to_all_timers + CS_ALL_TO_ALL_TIME_TOTAL,
@@ -1406,8 +2017,11 @@ cs_all_to_all_create_from_block(size_t                 n_elts,
   /* Create substructures based on info available at this stage
      (for Crystal Router, delay creation as data is not passed yet) */
 
-  if (d->type == CS_ALL_TO_ALL_MPI_DEFAULT)
+  if (d->type != CS_ALL_TO_ALL_CRYSTAL_ROUTER) {
     d->dc = _alltoall_caller_create_meta(flags, comm);
+    if (d->type == CS_ALL_TO_ALL_HIERARCHICAL)
+      d->dc->hc = _hier_comm_get(comm);
+  }
 
   t1 = cs_timer_time();
   cs_timer_counter_add_diff(_all_to_all_timers + CS_ALL_TO_ALL_TIME_TOTAL,
@@ -1552,6 +2166,7 @@ cs_all_to_all_n_elts_dest(cs_all_to_all_t  *d)
 
     switch(d->type) {
     case CS_ALL_TO_ALL_MPI_DEFAULT:
+    case CS_ALL_TO_ALL_HIERARCHICAL:
       {
         _alltoall_caller_exchange_meta(d->dc,
                                        d->n_elts_src,
@@ -1685,6 +2300,7 @@ cs_all_to_all_copy_array(cs_all_to_all_t   *d,
   switch(d->type) {
 
   case CS_ALL_TO_ALL_MPI_DEFAULT:
+  case CS_ALL_TO_ALL_HIERARCHICAL:
     {
       if (d->n_elts_dest < 0) { /* Exchange metadata if not done yet */
         _alltoall_caller_exchange_meta(d->dc,
@@ -1944,6 +2560,7 @@ cs_all_to_all_copy_indexed(cs_all_to_all_t  *d,
   switch(d->type) {
 
   case CS_ALL_TO_ALL_MPI_DEFAULT:
+  case CS_ALL_TO_ALL_HIERARCHICAL:
     {
       if (d->n_elts_dest < 0) { /* Exchange metadata if not done yet */
         _alltoall_caller_exchange_meta(d->dc,
@@ -2097,6 +2714,7 @@ cs_all_to_all_get_src_rank(cs_all_to_all_t  *d)
   switch(d->type) {
 
   case CS_ALL_TO_ALL_MPI_DEFAULT:
+  case CS_ALL_TO_ALL_HIERARCHICAL:
     {
       int i;
       cs_lnum_t j;
@@ -2154,10 +2772,50 @@ cs_all_to_all_set_type(cs_all_to_all_type_t  t)
   _all_to_all_type = t;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Get maximum rank group size for hierarchical all-to-all exchanges.
+ *
+ * \return  maximum number of ranks in a group, or 0 if groups match
+ *          compute nodes
+ */
+/*----------------------------------------------------------------------------*/
+
+int
+cs_all_to_all_get_hierarchy_group_size(void)
+{
+  return _hier_group_size_max;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set maximum rank group size for hierarchical all-to-all exchanges.
+ *
+ * By default, ranks sharing a compute node form a group, whose first rank
+ * aggregates data exchanged with other groups. Setting a maximum group
+ * size splits nodes into smaller groups, which may reduce the load on
+ * group leaders on nodes with many ranks.
+ *
+ * This setting applies to distributors created after this call.
+ *
+ * \param  group_size  maximum number of ranks in a group,
+ *                     or 0 for groups matching compute nodes
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_all_to_all_set_hierarchy_group_size(int  group_size)
+{
+  _hier_group_size_max = CS_MAX(group_size, 0);
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Log performance information relative to instrumented all-to-all
  * distribution.
+ *
+ * Communicator hierarchies used for hierarchical exchanges which are
+ * still attached to communicators are also freed.
  */
 /*----------------------------------------------------------------------------*/
 
@@ -2172,11 +2830,18 @@ cs_all_to_all_log_finalize(void)
   size_t name_width = 0;
 
   const char *method_name[] = {N_("MPI_Alltoall and MPI_Alltoallv"),
-                               N_("Crystal Router algorithm")};
+                               N_("Crystal Router algorithm"),
+                               N_("Node-aware hierarchical MPI_Alltoallv")};
   const char *timer_name[] = {N_("Total:"),
                               N_("Metadata exchange:"),
                               N_("Data exchange:")};
 
+  while (_n_hier_comms > 0)
+    MPI_Comm_delete_attr(_hier_comms[_n_hier_comms - 1], _hier_comm_keyval);
+  BFT_FREE(_hier_comms);
+  if (_hier_comm_keyval != MPI_KEYVAL_INVALID)
+    MPI_Comm_free_keyval(&_hier_comm_keyval);
+
   if (_all_to_all_calls[0] <= 0)
     return;
 
@@ -2184,6 +2849,12 @@ cs_all_to_all_log_finalize(void)
                 _("\nInstrumented all-to-all operations (using %s):\n\n"),
                 _(method_name[_all_to_all_type]));
 
+  if (   _all_to_all_type == CS_ALL_TO_ALL_HIERARCHICAL
+      && _hier_group_size_max > 0)
+    cs_log_printf(CS_LOG_PERFORMANCE,
+                  _("  (groups of at most %d ranks per node)\n\n"),
+                  _hier_group_size_max);
+
   /* Determine width */
 
   for (i = 0; i < 3; i++) {
@@ -65,7 +65,8 @@ BEGIN_C_DECLS
 typedef enum {
 
   CS_ALL_TO_ALL_MPI_DEFAULT,
-  CS_ALL_TO_ALL_CRYSTAL_ROUTER
+  CS_ALL_TO_ALL_CRYSTAL_ROUTER,
+  CS_ALL_TO_ALL_HIERARCHICAL
 
 } cs_all_to_all_type_t;
 
@@ -379,10 +380,44 @@ cs_all_to_all_get_type(void);
 void
 cs_all_to_all_set_type(cs_all_to_all_type_t  t);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Get maximum rank group size for hierarchical all-to-all exchanges.
+ *
+ * \return  maximum number of ranks in a group, or 0 if groups match
+ *          compute nodes
+ */
+/*----------------------------------------------------------------------------*/
+
+int
+cs_all_to_all_get_hierarchy_group_size(void);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set maximum rank group size for hierarchical all-to-all exchanges.
+ *
+ * By default, ranks sharing a compute node form a group, whose first rank
+ * aggregates data exchanged with other groups. Setting a maximum group
+ * size splits nodes into smaller groups, which may reduce the load on
+ * group leaders on nodes with many ranks.
+ *
+ * This setting applies to distributors created after this call.
+ *
+ * \param  group_size  maximum number of ranks in a group,
+ *                     or 0 for groups matching compute nodes
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_all_to_all_set_hierarchy_group_size(int  group_size);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Log performance information relative to instrumented all-to-all
  * distribution.
+ *
+ * Communicator hierarchies used for hierarchical exchanges which are
+ * still attached to communicators are also freed.
  */
 /*----------------------------------------------------------------------------*/
 
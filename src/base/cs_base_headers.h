@@ -61,13 +61,16 @@
 #include "cs_interface.h"
 #include "cs_interpolate.h"
 #include "cs_internal_coupling.h"
+#include "cs_load_balance.h"
 #include "cs_log.h"
+#include "cs_log_iteration.h"
 #include "cs_map.h"
 #include "cs_mass_source_terms.h"
 #include "cs_math.h"
 #include "cs_measures_util.h"
 #include "cs_notebook.h"
 #include "cs_numbering.h"
+#include "cs_numa.h"
 #include "cs_order.h"
 #include "cs_parall.h"
 #include "cs_param_types.h"
@@ -89,6 +92,7 @@
 #include "cs_restart_map.h"
 #include "cs_rotation.h"
 #include "cs_sat_coupling.h"
+#include "cs_scratch.h"
 #include "cs_selector.h"
 #include "cs_stokes_model.h"
 #include "cs_syr_coupling.h"
@@ -103,6 +107,7 @@
 #include "cs_volume_mass_injection.h"
 #include "cs_volume_zone.h"
 #include "cs_vof.h"
+#include "cs_wall_distance_geom.h"
 #include "cs_wall_functions.h"
 #include "cs_zone.h"
 
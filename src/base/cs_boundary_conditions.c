@@ -59,6 +59,7 @@
 #include "cs_field_operator.h"
 #include "cs_flag_check.h"
 #include "cs_halo.h"
+#include "cs_load_balance.h"
 #include "cs_math.h"
 #include "cs_mesh.h"
 #include "cs_mesh_connect.h"
@@ -773,6 +774,31 @@ cs_boundary_conditions_free(void)
   BFT_FREE(_bc_face_zone);
 }
 
+/*----------------------------------------------------------------------------
+ * Redistribute the boundary conditions face type and face zone arrays
+ * during a mesh redistribution (see cs_load_balance.c).
+ *----------------------------------------------------------------------------*/
+
+void
+cs_boundary_conditions_redistribute(void)
+{
+  void *p = _bc_type;
+  cs_load_balance_redistribute_array(CS_MESH_LOCATION_BOUNDARY_FACES,
+                                     CS_INT_TYPE,
+                                     1,
+                                     &p);
+  _bc_type = p;
+  cs_glob_bc_type = _bc_type;
+
+  p = _bc_face_zone;
+  cs_load_balance_redistribute_array(CS_MESH_LOCATION_BOUNDARY_FACES,
+                                     CS_INT_TYPE,
+                                     1,
+                                     &p);
+  _bc_face_zone = p;
+  cs_glob_bc_face_zone = _bc_face_zone;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Set convective oulet boundary condition for a scalar.
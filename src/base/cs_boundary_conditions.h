@@ -192,6 +192,14 @@ cs_boundary_conditions_create(void);
 void
 cs_boundary_conditions_free(void);
 
+/*----------------------------------------------------------------------------
+ * Redistribute the boundary conditions face type and face zone arrays
+ * during a mesh redistribution (see cs_load_balance.c).
+ *----------------------------------------------------------------------------*/
+
+void
+cs_boundary_conditions_redistribute(void);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Set Neumann BC for a scalar for a given face.
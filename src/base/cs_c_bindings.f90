@@ -1064,6 +1064,39 @@ module cs_c_bindings
 
     !---------------------------------------------------------------------------
 
+    ! Interface to C function disabling dynamic load balancing.
+
+    subroutine cs_load_balance_disable(reason) &
+      bind(C, name='cs_load_balance_disable')
+      use, intrinsic :: iso_c_binding
+      implicit none
+      character(kind=c_char, len=1), dimension(*), intent(in) :: reason
+    end subroutine cs_load_balance_disable
+
+    !---------------------------------------------------------------------------
+
+    ! Interface to C function checking load imbalance at the end of a time
+    ! step, and redistributing the mesh and associated data if needed.
+
+    function cs_load_balance_time_step() result(redistributed) &
+      bind(C, name='cs_load_balance_time_step')
+      use, intrinsic :: iso_c_binding
+      implicit none
+      logical(kind=c_bool) :: redistributed
+    end function cs_load_balance_time_step
+
+    !---------------------------------------------------------------------------
+
+    ! Interface to C function logging a memory placement report.
+
+    subroutine cs_numa_log_placement()  &
+      bind(C, name='cs_numa_log_placement')
+      use, intrinsic :: iso_c_binding
+      implicit none
+    end subroutine cs_numa_log_placement
+
+    !---------------------------------------------------------------------------
+
     ! Interface to C function checking the presence of a control file
     ! and dealing with the interactive control.
 
@@ -2369,6 +2402,19 @@ module cs_c_bindings
 
     !---------------------------------------------------------------------------
 
+    !> \brief  Update wall distance using the geometric method.
+
+    !> \param[in]  bc_type  boundary condition type
+
+    subroutine cs_wall_distance_geom_update(bc_type)            &
+        bind(C, name='cs_wall_distance_geom_update')
+      use, intrinsic :: iso_c_binding
+      implicit none
+      integer(kind=c_int), dimension(*) :: bc_type
+    end subroutine cs_wall_distance_geom_update
+
+    !---------------------------------------------------------------------------
+
     !> \brief  Check calculation parameters.
 
     subroutine parameters_check() &
@@ -4902,6 +4948,31 @@ contains
 
   !=============================================================================
 
+  !> \brief Disable dynamic load balancing for the current computation.
+
+  !> \param[in]   reason   short description of the reason
+
+  subroutine load_balance_disable(reason)
+
+    use, intrinsic :: iso_c_binding
+    implicit none
+
+    ! Arguments
+
+    character(len=*), intent(in) :: reason
+
+    ! Local variables
+
+    character(len=len_trim(reason)+1, kind=c_char) :: c_reason
+
+    c_reason = trim(reason)//c_null_char
+
+    call cs_load_balance_disable(c_reason)
+
+  end subroutine load_balance_disable
+
+  !=============================================================================
+
   !> \brief  Add field defining a general solved variable, with default options.
 
   !> \param[in]  name           field name
@@ -50,6 +50,7 @@
 #include "cs_map.h"
 #include "cs_parall.h"
 #include "cs_mesh_location.h"
+#include "cs_numa.h"
 
 /*----------------------------------------------------------------------------
  * Header for the current file
@@ -526,27 +527,37 @@ _field_create(const char   *name,
  * allocate and initialize a field values array.
  *
  * parameters:
- *   n_elts  <-- number of associated elements
- *   dim     <-- associated dimension
- *   val_old <-- pointer to previous array in case of reallocation
- *               (usually NULL)
+ *   location_id <-- associated mesh location id
+ *   n_elts      <-- number of associated elements
+ *   dim         <-- associated dimension
+ *   val_old     <-- pointer to previous array in case of reallocation
+ *                   (usually NULL)
  *
  * returns  pointer to new field values.
  *----------------------------------------------------------------------------*/
 
 static cs_real_t *
-_add_val(cs_lnum_t   n_elts,
-         int         dim,
-         cs_real_t  *val_old)
+_add_val(int          location_id,
+         cs_lnum_t    n_elts,
+         int          dim,
+         cs_real_t   *val_old)
 {
   cs_real_t  *val = val_old;
 
-  BFT_REALLOC(val, n_elts*dim, cs_real_t);
-
   /* Initialize field. This should not be necessary, but when using
      threads with Open MP, this should help ensure that the memory will
      first be touched by the same core that will later operate on
-     this memory, usually leading to better core/memory affinity. */
+     this memory, usually leading to better core/memory affinity.
+     New arrays are touched based on the thread ranges of the location's
+     numbering, which are those used by threaded loops. */
+
+  if (val == NULL) {
+    const cs_numbering_t *numbering = cs_numa_location_numbering(location_id);
+    CS_NUMA_MALLOC(val, n_elts, dim, cs_real_t, numbering);
+    return val;
+  }
+
+  BFT_REALLOC(val, n_elts*dim, cs_real_t);
 
   const cs_lnum_t _n_elts = dim * n_elts;
 # pragma omp parallel for if (_n_elts > CS_THR_MIN)
@@ -1693,7 +1704,8 @@ cs_field_set_n_time_vals(cs_field_t  *f,
     else { /* if (n_time_vals_ini < _n_time_vals) */
       if (f->is_owner) {
         const cs_lnum_t *n_elts = cs_mesh_location_get_n_elts(f->location_id);
-        f->val_pre = _add_val(n_elts[2], f->dim, f->val_pre);
+        f->val_pre = _add_val(f->location_id, n_elts[2], f->dim,
+                               f->val_pre);
       }
     }
   }
@@ -1720,7 +1732,8 @@ cs_field_allocate_values(cs_field_t  *f)
     /* Initialization */
 
     for (ii = 0; ii < f->n_time_vals; ii++)
-      f->vals[ii] = _add_val(n_elts[2], f->dim, f->vals[ii]);
+      f->vals[ii] = _add_val(f->location_id, n_elts[2], f->dim,
+                             f->vals[ii]);
 
     f->val = f->vals[0];
     if (f->n_time_vals > 1)
@@ -0,0 +1,1196 @@
+/*============================================================================
+ * Dynamic load balancing during the computation.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*----------------------------------------------------------------------------
+ * Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "bft_error.h"
+#include "bft_mem.h"
+#include "bft_printf.h"
+
+#include "cs_1d_wall_thermal.h"
+#include "cs_ale.h"
+#include "cs_all_to_all.h"
+#include "cs_base.h"
+#include "cs_block_dist.h"
+#include "cs_boundary_conditions.h"
+#include "cs_boundary_zone.h"
+#include "cs_cell_to_vertex.h"
+#include "cs_domain.h"
+#include "cs_ext_neighborhood.h"
+#include "cs_field.h"
+#include "cs_gradient.h"
+#include "cs_gradient_perio.h"
+#include "cs_halo.h"
+#include "cs_halo_perio.h"
+#include "cs_internal_coupling.h"
+#include "cs_lagr.h"
+#include "cs_lagr_particle.h"
+#include "cs_les_balance.h"
+#include "cs_log.h"
+#include "cs_matrix_default.h"
+#include "cs_mesh.h"
+#include "cs_mesh_adjacencies.h"
+#include "cs_mesh_bad_cells.h"
+#include "cs_mesh_builder.h"
+#include "cs_mesh_from_builder.h"
+#include "cs_mesh_location.h"
+#include "cs_mesh_quantities.h"
+#include "cs_mesh_to_builder.h"
+#include "cs_numa.h"
+#include "cs_parall.h"
+#include "cs_part_to_block.h"
+#include "cs_partition.h"
+#include "cs_physical_model.h"
+#include "cs_porous_model.h"
+#include "cs_post.h"
+#include "cs_preprocess.h"
+#include "cs_prototypes.h"
+#include "cs_rad_transfer.h"
+#include "cs_range_set.h"
+#include "cs_renumber.h"
+#include "cs_sat_coupling.h"
+#include "cs_stokes_model.h"
+#include "cs_syr_coupling.h"
+#include "cs_time_moment.h"
+#include "cs_time_step.h"
+#include "cs_timer.h"
+#include "cs_timer_stats.h"
+#include "cs_turbomachinery.h"
+#include "cs_vof.h"
+#include "cs_volume_zone.h"
+
+/*----------------------------------------------------------------------------
+ * Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_load_balance.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Additional Doxygen documentation
+ *============================================================================*/
+
+/*!
+  \file cs_load_balance.c
+        Dynamic load balancing during the computation.
+
+  When enabled, the estimated load of each rank is checked periodically,
+  based on the measured cost of the fluid and Lagrangian stages. The fluid
+  cost is assumed proportional to the number of cells, and the Lagrangian
+  cost proportional to the number of particles. When the ratio of the
+  maximum to the mean estimated load exceeds a given threshold, the mesh
+  is repartitioned using cell weights based on this cost model (with
+  separate fluid and particle constraints when particles are present,
+  balanced independently by METIS or ParMETIS), and fields,
+  boundary condition types, time moments and particles are migrated to
+  the new distribution.
+
+  Models whose data is not handled by the redistribution steps disable
+  load balancing (with a logged explanation).
+*/
+
+/*! \cond DOXYGEN_SHOULD_SKIP_THIS */
+
+/*=============================================================================
+ * Local Macro Definitions
+ *============================================================================*/
+
+#define _N_BASE_LOCATIONS  4
+
+/*=============================================================================
+ * Local Type Definitions
+ *============================================================================*/
+
+/* Redistribution info for a given base mesh location */
+
+typedef struct {
+
+  cs_lnum_t              n_prev;      /* number of elements before */
+  cs_gnum_t             *prev_gnum;   /* global numbers before */
+
+  cs_block_dist_info_t   bi;          /* block distribution info */
+
+#if defined(HAVE_MPI)
+  cs_part_to_block_t    *p_to_b;      /* previous elements to block */
+  cs_all_to_all_t       *b_to_n;      /* block to new elements */
+#endif
+
+  cs_lnum_t              n_b_recv;    /* elements received by block
+                                         from new elements */
+  cs_gnum_t             *b_gnum;      /* matching global numbers */
+
+} _location_redistribution_t;
+
+/*============================================================================
+ * Static global variables
+ *============================================================================*/
+
+static int     _check_interval = 0;
+static double  _imbalance_threshold = 1.2;
+
+static bool  _disabled = false;
+static bool  _checked_models = false;
+
+/* Cost measurement */
+
+static bool        _t_prev_set = false;
+static cs_timer_t  _t_prev;
+static double      _t_lagr_prev = 0.;
+
+/* Current redistribution info (only during redistribution) */
+
+static bool  _redistributing = false;
+static _location_redistribution_t  _loc_r[_N_BASE_LOCATIONS];
+static int  *_prev_cell_rank = NULL;
+
+/* Logging */
+
+static int                 _n_checks = 0;
+static int                 _n_redistributions = 0;
+static double              _imbalance_max[2] = {0., 0.};
+static cs_timer_counter_t  _t_redistribute;
+
+/*============================================================================
+ * Private function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Return index of a base mesh location, or -1 for other locations.
+ *
+ * parameters:
+ *   location_id <-- mesh location id
+ *
+ * returns:
+ *   index of base location, or -1
+ *----------------------------------------------------------------------------*/
+
+static inline int
+_base_location_index(int  location_id)
+{
+  if (   location_id >= CS_MESH_LOCATION_CELLS
+      && location_id <= CS_MESH_LOCATION_VERTICES)
+    return location_id - CS_MESH_LOCATION_CELLS;
+
+  return -1;
+}
+
+/*----------------------------------------------------------------------------
+ * Return current sizes and global numbering of a base mesh location.
+ *
+ * parameters:
+ *   m         <-- pointer to mesh
+ *   l_idx     <-- base location index
+ *   n_elts    --> number of elements
+ *   n_alloc   --> number of elements to allocate for arrays
+ *   n_g_elts  --> global number of elements
+ *
+ * returns:
+ *   pointer to global numbering
+ *----------------------------------------------------------------------------*/
+
+static const cs_gnum_t *
+_location_sizes(const cs_mesh_t  *m,
+                int               l_idx,
+                cs_lnum_t        *n_elts,
+                cs_lnum_t        *n_alloc,
+                cs_gnum_t        *n_g_elts)
+{
+  const cs_gnum_t *gnum = NULL;
+
+  switch(l_idx) {
+  case 0:
+    *n_elts = m->n_cells;
+    *n_alloc = m->n_cells_with_ghosts;
+    *n_g_elts = m->n_g_cells;
+    gnum = m->global_cell_num;
+    break;
+  case 1:
+    *n_elts = m->n_i_faces;
+    *n_alloc = m->n_i_faces;
+    *n_g_elts = m->n_g_i_faces;
+    gnum = m->global_i_face_num;
+    break;
+  case 2:
+    *n_elts = m->n_b_faces;
+    *n_alloc = m->n_b_faces;
+    *n_g_elts = m->n_g_b_faces;
+    gnum = m->global_b_face_num;
+    break;
+  default:
+    *n_elts = m->n_vertices;
+    *n_alloc = m->n_vertices;
+    *n_g_elts = m->n_g_vertices;
+    gnum = m->global_vtx_num;
+  }
+
+  return gnum;
+}
+
+/*----------------------------------------------------------------------------
+ * Check whether active models are compatible with load balancing.
+ *
+ * returns:
+ *   NULL if compatible, or reason for incompatibility
+ *----------------------------------------------------------------------------*/
+
+static const char *
+_incompatible_model(void)
+{
+  if (cs_glob_n_ranks < 2)
+    return N_("serial run");
+
+  /* Coal combustion data is stored in fields */
+
+  const int *pm_flag = cs_glob_physical_model_flag;
+  if (pm_flag[CS_PHYSICAL_MODEL_FLAG] > 0) {
+    for (int i = CS_COMBUSTION_3PT; i < CS_N_PHYSICAL_MODEL_TYPES; i++) {
+      if (   pm_flag[i] >= 0
+          && i != CS_COMBUSTION_PCLC && i != CS_COMBUSTION_COAL)
+        return N_("specific physical model");
+    }
+  }
+  if (cs_glob_rad_transfer_params->type != CS_RAD_TRANSFER_NONE)
+    return N_("radiative transfer");
+  if (cs_turbomachinery_get_model() != CS_TURBOMACHINERY_NONE)
+    return N_("turbomachinery model");
+  if (cs_glob_ale > 0)
+    return N_("ALE (mesh deformation)");
+  if (cs_glob_porous_model > 0)
+    return N_("porosity model");
+  if (cs_get_glob_stokes_model()->fluid_solid)
+    return N_("fluid-solid model");
+  if (cs_get_glob_vof_parameters()->vof_model & CS_VOF_MERKLE_MASS_TRANSFER)
+    return N_("cavitation mass transfer");
+  if (cs_domain_get_cdo_mode(cs_glob_domain) != CS_DOMAIN_CDO_MODE_OFF)
+    return N_("CDO schemes");
+  if (cs_internal_coupling_n_couplings() > 0)
+    return N_("internal coupling");
+  if (cs_glob_1d_wall_thermal != NULL && cs_glob_1d_wall_thermal->nfpt1t > 0)
+    return N_("1D wall thermal model");
+  if (cs_glob_les_balance->i_les_balance != 0)
+    return N_("LES balance");
+  if (cs_sat_coupling_n_couplings() > 0 || cs_syr_coupling_n_couplings() > 0)
+    return N_("code coupling");
+
+  const int n_fields = cs_field_n_fields();
+  for (int f_id = 0; f_id < n_fields; f_id++) {
+    const cs_field_t *f = cs_field_by_id(f_id);
+    if (   f->is_owner && f->location_id != CS_MESH_LOCATION_NONE
+        && _base_location_index(f->location_id) < 0)
+      return N_("fields defined on mesh subsets");
+  }
+
+  return NULL;
+}
+
+/*----------------------------------------------------------------------------
+ * Estimate per-rank loads and per-element costs since the last check.
+ *
+ * parameters:
+ *   c_cell  --> estimated cost per cell
+ *   c_part  --> estimated cost per particle
+ *
+ * returns:
+ *   ratio of maximum to mean estimated rank load
+ *----------------------------------------------------------------------------*/
+
+static double
+_estimate_imbalance(double  *c_cell,
+                    double  *c_part)
+{
+  double imbalance = 1.;
+
+  cs_timer_t t_now = cs_timer_time();
+  double t_wall = (  (t_now.wall_sec - _t_prev.wall_sec)*1e9
+                   + (t_now.wall_nsec - _t_prev.wall_nsec))*1e-9;
+  _t_prev = t_now;
+
+  double t_lagr = 0.;
+  int lagr_stats_id = cs_timer_stats_id_by_name("lagrangian_stage");
+  if (lagr_stats_id > -1) {
+    cs_timer_counter_t t_tot = cs_timer_stats_get_total(lagr_stats_id);
+    double t_lagr_tot = t_tot.wall_nsec*1e-9;
+    t_lagr = t_lagr_tot - _t_lagr_prev;
+    _t_lagr_prev = t_lagr_tot;
+  }
+
+  cs_lnum_t n_part = 0;
+  if (cs_glob_lagr_particle_set != NULL)
+    n_part = cs_glob_lagr_particle_set->n_particles;
+
+  /* Sums: fluid time, cells, Lagrangian time, particles */
+
+  double s[4] = {CS_MAX(t_wall - t_lagr, 0.),
+                 cs_glob_mesh->n_cells,
+                 t_lagr,
+                 n_part};
+
+  cs_parall_sum(4, CS_DOUBLE, s);
+
+  *c_cell = (s[1] > 0) ? s[0] / s[1] : 0.;
+  *c_part = (s[3] > 0) ? s[2] / s[3] : 0.;
+
+  double load[2];
+  load[0] = *c_cell * cs_glob_mesh->n_cells + *c_part * n_part;
+  load[1] = load[0];
+
+  cs_parall_max(1, CS_DOUBLE, load);
+  cs_parall_sum(1, CS_DOUBLE, load + 1);
+
+  double load_mean = load[1] / cs_glob_n_ranks;
+  if (load_mean > 0)
+    imbalance = load[0] / load_mean;
+
+  return imbalance;
+}
+
+/*----------------------------------------------------------------------------
+ * Estimate imbalance for the current distribution and given costs.
+ *
+ * parameters:
+ *   c_cell  <-- estimated cost per cell
+ *   c_part  <-- estimated cost per particle
+ *
+ * returns:
+ *   ratio of maximum to mean estimated rank load
+ *----------------------------------------------------------------------------*/
+
+static double
+_current_imbalance(double  c_cell,
+                   double  c_part)
+{
+  cs_lnum_t n_part = 0;
+  if (cs_glob_lagr_particle_set != NULL)
+    n_part = cs_glob_lagr_particle_set->n_particles;
+
+  double load[2];
+  load[0] = c_cell * cs_glob_mesh->n_cells + c_part * n_part;
+  load[1] = load[0];
+
+  cs_parall_max(1, CS_DOUBLE, load);
+  cs_parall_sum(1, CS_DOUBLE, load + 1);
+
+  double load_mean = load[1] / cs_glob_n_ranks;
+
+  return (load_mean > 0) ? load[0] / load_mean : 1.;
+}
+
+#if defined(HAVE_MPI)
+
+/*----------------------------------------------------------------------------
+ * Save previous global numbering of base mesh locations.
+ *
+ * parameters:
+ *   m <-- pointer to mesh
+ *----------------------------------------------------------------------------*/
+
+static void
+_save_prev_numbering(const cs_mesh_t  *m)
+{
+  for (int l_idx = 0; l_idx < _N_BASE_LOCATIONS; l_idx++) {
+
+    _location_redistribution_t *lr = _loc_r + l_idx;
+
+    cs_lnum_t n_elts, n_alloc;
+    cs_gnum_t n_g_elts;
+    const cs_gnum_t *gnum = _location_sizes(m, l_idx,
+                                            &n_elts, &n_alloc, &n_g_elts);
+
+    lr->n_prev = n_elts;
+    BFT_MALLOC(lr->prev_gnum, n_elts, cs_gnum_t);
+    memcpy(lr->prev_gnum, gnum, n_elts*sizeof(cs_gnum_t));
+
+    lr->bi = cs_block_dist_compute_sizes(cs_glob_rank_id,
+                                         cs_glob_n_ranks,
+                                         1,
+                                         0,
+                                         n_g_elts);
+
+    lr->p_to_b = NULL;
+    lr->b_to_n = NULL;
+    lr->n_b_recv = 0;
+    lr->b_gnum = NULL;
+
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Ensure distributors for a given location are built.
+ *
+ * This is a collective operation.
+ *
+ * parameters:
+ *   l_idx <-- base location index
+ *----------------------------------------------------------------------------*/
+
+static void
+_ensure_distributors(int  l_idx)
+{
+  _location_redistribution_t *lr = _loc_r + l_idx;
+
+  if (lr->b_to_n != NULL)
+    return;
+
+  cs_lnum_t n_elts, n_alloc;
+  cs_gnum_t n_g_elts;
+  const cs_gnum_t *gnum = _location_sizes(cs_glob_mesh, l_idx,
+                                          &n_elts, &n_alloc, &n_g_elts);
+
+  lr->p_to_b = cs_part_to_block_create_by_gnum(cs_glob_mpi_comm,
+                                               lr->bi,
+                                               lr->n_prev,
+                                               lr->prev_gnum);
+
+  lr->b_to_n = cs_all_to_all_create_from_block(n_elts,
+                                               CS_ALL_TO_ALL_NEED_SRC_RANK,
+                                               gnum,
+                                               lr->bi,
+                                               cs_glob_mpi_comm);
+
+  lr->b_gnum = cs_all_to_all_copy_array(lr->b_to_n,
+                                        CS_GNUM_TYPE,
+                                        1,
+                                        false, /* reverse */
+                                        gnum,
+                                        NULL);
+
+  lr->n_b_recv = cs_all_to_all_n_elts_dest(lr->b_to_n);
+}
+
+/*----------------------------------------------------------------------------
+ * Free redistribution info.
+ *----------------------------------------------------------------------------*/
+
+static void
+_free_redistribution_info(void)
+{
+  for (int l_idx = 0; l_idx < _N_BASE_LOCATIONS; l_idx++) {
+    _location_redistribution_t *lr = _loc_r + l_idx;
+    if (lr->p_to_b != NULL)
+      cs_part_to_block_destroy(&(lr->p_to_b));
+    if (lr->b_to_n != NULL)
+      cs_all_to_all_destroy(&(lr->b_to_n));
+    BFT_FREE(lr->b_gnum);
+    BFT_FREE(lr->prev_gnum);
+    lr->n_prev = 0;
+    lr->n_b_recv = 0;
+  }
+
+  BFT_FREE(_prev_cell_rank);
+}
+
+/*----------------------------------------------------------------------------
+ * Compute new rank of previous cells.
+ *----------------------------------------------------------------------------*/
+
+static void
+_compute_prev_cell_rank(void)
+{
+  _ensure_distributors(0);
+
+  _location_redistribution_t *lr = _loc_r;
+
+  const cs_gnum_t g_start = lr->bi.gnum_range[0];
+  const cs_lnum_t n_b = lr->bi.gnum_range[1] - lr->bi.gnum_range[0];
+
+  /* Ranks of new cells, on block distribution */
+
+  int *src_rank = cs_all_to_all_get_src_rank(lr->b_to_n);
+
+  int *b_rank;
+  BFT_MALLOC(b_rank, n_b, int);
+
+  for (cs_lnum_t i = 0; i < lr->n_b_recv; i++)
+    b_rank[lr->b_gnum[i] - g_start] = src_rank[i];
+
+  BFT_FREE(src_rank);
+
+  /* Send back to previous cells */
+
+  cs_all_to_all_t *d
+    = cs_all_to_all_create_from_block(lr->n_prev,
+                                      0,
+                                      lr->prev_gnum,
+                                      lr->bi,
+                                      cs_glob_mpi_comm);
+
+  cs_gnum_t *r_gnum = cs_all_to_all_copy_array(d,
+                                               CS_GNUM_TYPE,
+                                               1,
+                                               false, /* reverse */
+                                               lr->prev_gnum,
+                                               NULL);
+
+  cs_lnum_t n_r = cs_all_to_all_n_elts_dest(d);
+
+  int *r_rank;
+  BFT_MALLOC(r_rank, n_r, int);
+  for (cs_lnum_t i = 0; i < n_r; i++)
+    r_rank[i] = b_rank[r_gnum[i] - g_start];
+
+  BFT_FREE(r_gnum);
+  BFT_FREE(b_rank);
+
+  BFT_MALLOC(_prev_cell_rank, lr->n_prev, int);
+
+  cs_all_to_all_copy_array(d,
+                           CS_INT_TYPE,
+                           1,
+                           true, /* reverse */
+                           r_rank,
+                           _prev_cell_rank);
+
+  BFT_FREE(r_rank);
+
+  cs_all_to_all_destroy(&d);
+}
+
+/*----------------------------------------------------------------------------
+ * Compute cell weights for partitioning, on the builder's block
+ * distribution.
+ *
+ * When particles are present, two constraints are used (fluid and
+ * particle cost), so that partitioners handling multiple constraints
+ * balance both phases (which are separated by synchronizations)
+ * independently. Otherwise, a single constraint is used.
+ *
+ * parameters:
+ *   mb            <-- pointer to mesh builder
+ *   c_cell        <-- estimated cost per cell
+ *   c_part        <-- estimated cost per particle
+ *   n_constraints --> number of weights per cell
+ *
+ * returns:
+ *   cell weights on mb->cell_bi block distribution (interlaced)
+ *----------------------------------------------------------------------------*/
+
+static double *
+_block_cell_weights(const cs_mesh_builder_t  *mb,
+                    double                    c_cell,
+                    double                    c_part,
+                    int                      *n_constraints)
+{
+  const _location_redistribution_t *lr = _loc_r;
+  const cs_lnum_t n_cells = lr->n_prev;
+
+  const cs_lagr_particle_set_t *p_set = cs_glob_lagr_particle_set;
+
+  cs_gnum_t n_g_particles = (p_set != NULL) ? p_set->n_particles : 0;
+  cs_parall_counter(&n_g_particles, 1);
+
+  const int stride = (n_g_particles > 0 && c_part > 0) ? 2 : 1;
+
+  double *cell_weight;
+  BFT_MALLOC(cell_weight, n_cells*stride, double);
+
+  /* Avoid zero weights if no time was measured */
+
+  double w_cell = (c_cell > 0) ? c_cell : 1.;
+
+  for (cs_lnum_t i = 0; i < n_cells; i++) {
+    cell_weight[i*stride] = w_cell;
+    if (stride > 1)
+      cell_weight[i*stride + 1] = 0;
+  }
+
+  if (stride > 1) {
+    for (cs_lnum_t i = 0; i < p_set->n_particles; i++) {
+      cs_lnum_t c_id = cs_lagr_particles_get_lnum(p_set, i, CS_LAGR_CELL_ID);
+      if (c_id > -1 && c_id < n_cells)
+        cell_weight[c_id*stride + 1] += c_part;
+    }
+  }
+
+  cs_lnum_t n_b_cells = mb->cell_bi.gnum_range[1] - mb->cell_bi.gnum_range[0];
+
+  double *b_cell_weight;
+  BFT_MALLOC(b_cell_weight, n_b_cells*stride, double);
+
+  cs_part_to_block_t *d
+    = cs_part_to_block_create_by_gnum(cs_glob_mpi_comm,
+                                      mb->cell_bi,
+                                      n_cells,
+                                      lr->prev_gnum);
+
+  cs_part_to_block_copy_array(d,
+                              CS_DOUBLE,
+                              stride,
+                              cell_weight,
+                              b_cell_weight);
+
+  cs_part_to_block_destroy(&d);
+
+  BFT_FREE(cell_weight);
+
+  *n_constraints = stride;
+
+  return b_cell_weight;
+}
+
+/*----------------------------------------------------------------------------
+ * Rebuild mesh and associated structures using weighted partitioning.
+ *
+ * parameters:
+ *   c_cell  <-- estimated cost per cell
+ *   c_part  <-- estimated cost per particle
+ *----------------------------------------------------------------------------*/
+
+static void
+_rebuild_mesh(double  c_cell,
+              double  c_part)
+{
+  cs_mesh_t *m = cs_glob_mesh;
+  cs_mesh_quantities_t *mq = cs_glob_mesh_quantities;
+
+  cs_halo_type_t halo_type = m->halo_type;
+
+  if (m->vtx_range_set != NULL)
+    cs_range_set_destroy(&(m->vtx_range_set));
+
+  cs_glob_mesh_builder = cs_mesh_builder_create();
+  cs_mesh_builder_t *mb = cs_glob_mesh_builder;
+
+  cs_mesh_to_builder(m, mb, true, NULL);
+
+  int n_constraints = 1;
+  double *cell_weight = _block_cell_weights(mb, c_cell, c_part,
+                                            &n_constraints);
+
+  cs_partition_set_cell_constraint_weights(n_constraints, cell_weight);
+
+  cs_partition(m, mb, CS_PARTITION_MAIN);
+  cs_mesh_from_builder(m, mb);
+  cs_mesh_init_halo(m, mb, halo_type);
+  cs_mesh_update_auxiliary(m);
+
+  cs_mesh_builder_destroy(&cs_glob_mesh_builder);
+
+  m->n_b_faces_all = m->n_b_faces;
+  m->n_g_b_faces_all = m->n_g_b_faces;
+
+  cs_renumber_mesh(m);
+
+  cs_mesh_init_group_classes(m);
+
+  /* Compute geometric quantities related to the mesh */
+
+  cs_mesh_quantities_free_all(mq);
+  cs_mesh_quantities_compute(m, mq);
+  cs_mesh_bad_cells_detect(m, mq);
+  cs_user_mesh_bad_cells_tag(m, mq);
+
+  cs_ext_neighborhood_reduce(m, mq);
+
+  /* Initialize selectors and locations for the mesh */
+
+  cs_mesh_init_selectors();
+  cs_mesh_location_build(m, -1);
+  cs_volume_zone_build_all(true);
+  cs_boundary_zone_build_all(true);
+
+  /* Update Fortran mesh sizes and quantities */
+
+  cs_preprocess_mesh_update_fortran();
+
+  /* Update mesh-related structures of other APIs */
+
+  cs_gradient_free_quantities();
+  cs_cell_to_vertex_free();
+  cs_mesh_adjacencies_update_mesh();
+
+  cs_gradient_perio_update_mesh();
+  cs_matrix_update_mesh();
+}
+
+/*----------------------------------------------------------------------------
+ * Redistribute owned field values and boundary condition coefficients.
+ *----------------------------------------------------------------------------*/
+
+static void
+_redistribute_fields(void)
+{
+  const cs_halo_t *halo = cs_glob_mesh->halo;
+  const int n_fields = cs_field_n_fields();
+  const int coupled_key_id = cs_field_key_id_try("coupled");
+
+  for (int f_id = 0; f_id < n_fields; f_id++) {
+
+    cs_field_t *f = cs_field_by_id(f_id);
+
+    if (f->is_owner == false || _base_location_index(f->location_id) < 0)
+      continue;
+
+    for (int kk = 0; kk < f->n_time_vals; kk++) {
+
+      void *p = f->vals[kk];
+      cs_load_balance_redistribute_array(f->location_id,
+                                         CS_REAL_TYPE,
+                                         f->dim,
+                                         &p);
+      f->vals[kk] = p;
+
+      if (   f->location_id == CS_MESH_LOCATION_CELLS
+          && f->dim == 3 && halo != NULL)
+        cs_halo_perio_sync_var_vect(halo,
+                                    CS_HALO_EXTENDED,
+                                    f->vals[kk],
+                                    f->dim);
+
+    }
+
+    f->val = f->vals[0];
+    if (f->n_time_vals > 1) f->val_pre = f->vals[1];
+
+    /* Boundary condition coefficients */
+
+    cs_field_bc_coeffs_t *bc_coeffs = f->bc_coeffs;
+
+    if (bc_coeffs == NULL)
+      continue;
+
+    int a_mult = f->dim;
+    int b_mult = f->dim;
+
+    if (f->type & CS_FIELD_VARIABLE && coupled_key_id > -1) {
+      if (cs_field_get_key_int(f, coupled_key_id))
+        b_mult *= f->dim;
+    }
+
+    cs_real_t **a_vals[] = {&(bc_coeffs->a), &(bc_coeffs->af),
+                            &(bc_coeffs->ad), &(bc_coeffs->ac)};
+    cs_real_t **b_vals[] = {&(bc_coeffs->b), &(bc_coeffs->bf),
+                            &(bc_coeffs->bd), &(bc_coeffs->bc)};
+    cs_real_t **h_vals[] = {&(bc_coeffs->hint), &(bc_coeffs->hext)};
+
+    for (int i = 0; i < 10; i++) {
+      cs_real_t **v;
+      int stride;
+      if (i < 4) {
+        v = a_vals[i];
+        stride = a_mult;
+      }
+      else if (i < 8) {
+        v = b_vals[i-4];
+        stride = b_mult;
+      }
+      else {
+        v = h_vals[i-8];
+        stride = 1;
+      }
+      if (*v != NULL) {
+        void *p = *v;
+        cs_load_balance_redistribute_array(bc_coeffs->location_id,
+                                           CS_REAL_TYPE,
+                                           stride,
+                                           &p);
+        *v = p;
+      }
+    }
+
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Redistribute the mesh and associated data.
+ *
+ * parameters:
+ *   c_cell  <-- estimated cost per cell
+ *   c_part  <-- estimated cost per particle
+ *----------------------------------------------------------------------------*/
+
+static void
+_redistribute(double  c_cell,
+              double  c_part)
+{
+  cs_timer_t t0 = cs_timer_time();
+
+  int t_stat_id = cs_timer_stats_id_by_name("mesh_processing");
+  int t_top_id = cs_timer_stats_switch(t_stat_id);
+
+  _redistributing = true;
+
+  _save_prev_numbering(cs_glob_mesh);
+
+  _rebuild_mesh(c_cell, c_part);
+
+  _compute_prev_cell_rank();
+
+  /* Migrate data */
+
+  _redistribute_fields();
+
+  cs_boundary_conditions_redistribute();
+  cs_time_moment_redistribute();
+
+  if (cs_glob_lagr_time_scheme->iilagr != CS_LAGR_OFF)
+    cs_lagr_redistribute();
+
+  _free_redistribution_info();
+
+  _redistributing = false;
+
+  /* Update postprocessing meshes */
+
+  cs_post_rebuild_meshes();
+
+  cs_timer_stats_switch(t_top_id);
+
+  cs_timer_t t1 = cs_timer_time();
+  cs_timer_counter_add_diff(&_t_redistribute, &t0, &t1);
+}
+
+#endif /* defined(HAVE_MPI) */
+
+/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set dynamic load balancing options.
+ *
+ * Load balancing is disabled by default (check interval 0).
+ *
+ * \param[in]  check_interval       number of time steps between imbalance
+ *                                  checks, or 0 to disable
+ * \param[in]  imbalance_threshold  ratio of maximum to mean estimated rank
+ *                                  load above which the mesh is
+ *                                  redistributed (> 1)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_load_balance_set_options(int     check_interval,
+                            double  imbalance_threshold)
+{
+  _check_interval = CS_MAX(check_interval, 0);
+
+  if (imbalance_threshold > 1.)
+    _imbalance_threshold = imbalance_threshold;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Disable dynamic load balancing for the current computation.
+ *
+ * This is used by models whose data is not handled by the redistribution
+ * steps; the reason is logged once if load balancing was requested.
+ *
+ * \param[in]  reason  short description of the reason
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_load_balance_disable(const char  *reason)
+{
+  if (_check_interval > 0 && _disabled == false)
+    cs_log_printf(CS_LOG_DEFAULT,
+                  _("\n"
+                    "Dynamic load balancing disabled (%s).\n"),
+                  _(reason));
+
+  _disabled = true;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Check for load imbalance at the end of a time step and
+ *        redistribute the mesh and associated data if needed.
+ *
+ * \return  true if the mesh was redistributed, false otherwise
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_load_balance_time_step(void)
+{
+  bool retval = false;
+
+  if (_check_interval < 1 || _disabled)
+    return retval;
+
+  if (_checked_models == false) {
+    const char *reason = _incompatible_model();
+    _checked_models = true;
+    if (reason != NULL) {
+      cs_load_balance_disable(reason);
+      return retval;
+    }
+    CS_TIMER_COUNTER_INIT(_t_redistribute);
+  }
+
+  /* Initialize time measurement on first call */
+
+  if (_t_prev_set == false) {
+    _t_prev = cs_timer_time();
+    int lagr_stats_id = cs_timer_stats_id_by_name("lagrangian_stage");
+    if (lagr_stats_id > -1)
+      _t_lagr_prev = cs_timer_stats_get_total(lagr_stats_id).wall_nsec*1e-9;
+    _t_prev_set = true;
+    return retval;
+  }
+
+  const cs_time_step_t *ts = cs_glob_time_step;
+
+  if (ts->nt_cur % _check_interval != 0)
+    return retval;
+
+#if defined(HAVE_MPI)
+
+  double c_cell = 0, c_part = 0;
+  double imbalance = _estimate_imbalance(&c_cell, &c_part);
+
+  _n_checks += 1;
+  _imbalance_max[0] = CS_MAX(_imbalance_max[0], imbalance);
+
+  if (imbalance <= _imbalance_threshold)
+    return retval;
+
+  cs_log_printf(CS_LOG_DEFAULT,
+                _("\n"
+                  "Dynamic load balancing at time step %d:\n"
+                  "  estimated load imbalance (max/mean): %6.3f\n"),
+                ts->nt_cur, imbalance);
+
+  _redistribute(c_cell, c_part);
+
+  double imbalance_new = _current_imbalance(c_cell, c_part);
+
+  cs_log_printf(CS_LOG_DEFAULT,
+                _("  after redistribution:                %6.3f\n"),
+                imbalance_new);
+
+  _n_redistributions += 1;
+  _imbalance_max[1] = CS_MAX(_imbalance_max[1], imbalance_new);
+
+  /* Restart time measurement, so as to ignore redistribution cost */
+
+  _t_prev = cs_timer_time();
+
+  retval = true;
+
+#endif
+
+  return retval;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Redistribute an array defined on a base mesh location.
+ *
+ * This function may only be called by the redistribution hooks of other
+ * modules, during a redistribution operation. Supported locations are
+ * cells, interior faces, boundary faces, and vertices. For cells, the
+ * array is resized to the number of cells with ghosts, and ghost values
+ * are synchronized.
+ *
+ * \param[in]       location_id  associated base mesh location id
+ * \param[in]       datatype     data type of array elements
+ * \param[in]       stride       number of values per element
+ * \param[in, out]  array        pointer to array, reallocated
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_load_balance_redistribute_array(int             location_id,
+                                   cs_datatype_t   datatype,
+                                   int             stride,
+                                   void          **array)
+{
+  int l_idx = _base_location_index(location_id);
+
+  if (_redistributing == false || l_idx < 0)
+    bft_error(__FILE__, __LINE__, 0,
+              _("%s may only be called during a redistribution,\n"
+                "for a base mesh location (%d here)."),
+              __func__, location_id);
+
+#if defined(HAVE_MPI)
+
+  _ensure_distributors(l_idx);
+
+  _location_redistribution_t *lr = _loc_r + l_idx;
+
+  const size_t elt_size = cs_datatype_size[datatype] * stride;
+  const cs_gnum_t g_start = lr->bi.gnum_range[0];
+  const cs_lnum_t n_b = lr->bi.gnum_range[1] - lr->bi.gnum_range[0];
+
+  /* Previous distribution to block */
+
+  unsigned char *b_vals, *s_vals;
+  BFT_MALLOC(b_vals, n_b*elt_size, unsigned char);
+
+  cs_part_to_block_copy_array(lr->p_to_b,
+                              datatype,
+                              stride,
+                              *array,
+                              b_vals);
+
+  BFT_FREE(*array);
+
+  /* Block to new distribution */
+
+  BFT_MALLOC(s_vals, lr->n_b_recv*elt_size, unsigned char);
+
+  for (cs_lnum_t i = 0; i < lr->n_b_recv; i++)
+    memcpy(s_vals + i*elt_size,
+           b_vals + (lr->b_gnum[i] - g_start)*elt_size,
+           elt_size);
+
+  BFT_FREE(b_vals);
+
+  cs_lnum_t n_elts, n_alloc;
+  cs_gnum_t n_g_elts;
+  _location_sizes(cs_glob_mesh, l_idx, &n_elts, &n_alloc, &n_g_elts);
+
+  /* Place new array based on the new numbering's thread ranges */
+
+  unsigned char *n_vals;
+  CS_NUMA_MALLOC(n_vals, n_alloc, elt_size, unsigned char,
+                 cs_numa_location_numbering(location_id));
+
+  cs_all_to_all_copy_array(lr->b_to_n,
+                           datatype,
+                           stride,
+                           true, /* reverse */
+                           s_vals,
+                           n_vals);
+
+  BFT_FREE(s_vals);
+
+  if (location_id == CS_MESH_LOCATION_CELLS && cs_glob_mesh->halo != NULL)
+    cs_halo_sync_untyped(cs_glob_mesh->halo,
+                         CS_HALO_EXTENDED,
+                         elt_size,
+                         n_vals);
+
+  *array = n_vals;
+
+#endif
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return global numbers of elements of a base mesh location before
+ *        redistribution.
+ *
+ * This function may only be called during a redistribution operation.
+ *
+ * \param[in]   location_id  associated base mesh location id
+ * \param[out]  n_elts       number of elements before redistribution
+ *
+ * \return  pointer to global element numbers before redistribution
+ */
+/*----------------------------------------------------------------------------*/
+
+const cs_gnum_t *
+cs_load_balance_get_prev_gnum(int         location_id,
+                              cs_lnum_t  *n_elts)
+{
+  int l_idx = _base_location_index(location_id);
+
+  if (_redistributing == false || l_idx < 0)
+    bft_error(__FILE__, __LINE__, 0,
+              _("%s may only be called during a redistribution,\n"
+                "for a base mesh location (%d here)."),
+              __func__, location_id);
+
+  *n_elts = _loc_r[l_idx].n_prev;
+
+  return _loc_r[l_idx].prev_gnum;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return new rank of cells before redistribution.
+ *
+ * This function may only be called during a redistribution operation.
+ *
+ * \return  pointer to destination rank of each previous cell
+ */
+/*----------------------------------------------------------------------------*/
+
+const int *
+cs_load_balance_get_prev_cell_rank(void)
+{
+  if (_redistributing == false)
+    bft_error(__FILE__, __LINE__, 0,
+              _("%s may only be called during a redistribution."),
+              __func__);
+
+  return _prev_cell_rank;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Log load balancing performance info at the end of the computation.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_load_balance_log_finalize(void)
+{
+  if (_n_checks < 1)
+    return;
+
+  cs_log_printf(CS_LOG_PERFORMANCE,
+                _("\nDynamic load balancing:\n\n"
+                  "  Number of imbalance checks:      %d\n"
+                  "  Maximum estimated imbalance:     %6.3f\n"
+                  "  Number of redistributions:       %d\n"),
+                _n_checks, _imbalance_max[0], _n_redistributions);
+
+  if (_n_redistributions > 0)
+    cs_log_printf(CS_LOG_PERFORMANCE,
+                  _("  Maximum imbalance after update:  %6.3f\n"
+                    "  Redistribution time:          %12.5f s\n"),
+                  _imbalance_max[1], _t_redistribute.wall_nsec*1e-9);
+
+  cs_log_printf(CS_LOG_PERFORMANCE, "\n");
+  cs_log_separator(CS_LOG_PERFORMANCE);
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
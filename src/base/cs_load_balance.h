@@ -0,0 +1,167 @@
+#ifndef __CS_LOAD_BALANCE_H__
+#define __CS_LOAD_BALANCE_H__
+
+/*============================================================================
+ * Dynamic load balancing during the computation.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*============================================================================
+ * Macro definitions
+ *============================================================================*/
+
+/*============================================================================
+ * Type definitions
+ *============================================================================*/
+
+/*============================================================================
+ * Global variables
+ *============================================================================*/
+
+/*=============================================================================
+ * Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set dynamic load balancing options.
+ *
+ * Load balancing is disabled by default (check interval 0).
+ *
+ * \param[in]  check_interval       number of time steps between imbalance
+ *                                  checks, or 0 to disable
+ * \param[in]  imbalance_threshold  ratio of maximum to mean estimated rank
+ *                                  load above which the mesh is
+ *                                  redistributed (> 1)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_load_balance_set_options(int     check_interval,
+                            double  imbalance_threshold);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Disable dynamic load balancing for the current computation.
+ *
+ * This is used by models whose data is not handled by the redistribution
+ * steps; the reason is logged once if load balancing was requested.
+ *
+ * \param[in]  reason  short description of the reason
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_load_balance_disable(const char  *reason);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Check for load imbalance at the end of a time step and
+ *        redistribute the mesh and associated data if needed.
+ *
+ * \return  true if the mesh was redistributed, false otherwise
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_load_balance_time_step(void);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Redistribute an array defined on a base mesh location.
+ *
+ * This function may only be called by the redistribution hooks of other
+ * modules, during a redistribution operation. Supported locations are
+ * cells, interior faces, boundary faces, and vertices. For cells, the
+ * array is resized to the number of cells with ghosts, and ghost values
+ * are synchronized.
+ *
+ * \param[in]       location_id  associated base mesh location id
+ * \param[in]       datatype     data type of array elements
+ * \param[in]       stride       number of values per element
+ * \param[in, out]  array        pointer to array, reallocated
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_load_balance_redistribute_array(int             location_id,
+                                   cs_datatype_t   datatype,
+                                   int             stride,
+                                   void          **array);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return global numbers of elements of a base mesh location before
+ *        redistribution.
+ *
+ * This function may only be called during a redistribution operation.
+ *
+ * \param[in]   location_id  associated base mesh location id
+ * \param[out]  n_elts       number of elements before redistribution
+ *
+ * \return  pointer to global element numbers before redistribution
+ */
+/*----------------------------------------------------------------------------*/
+
+const cs_gnum_t *
+cs_load_balance_get_prev_gnum(int         location_id,
+                              cs_lnum_t  *n_elts);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return new rank of cells before redistribution.
+ *
+ * This function may only be called during a redistribution operation.
+ *
+ * \return  pointer to destination rank of each previous cell
+ */
+/*----------------------------------------------------------------------------*/
+
+const int *
+cs_load_balance_get_prev_cell_rank(void);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Log load balancing performance info at the end of the computation.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_load_balance_log_finalize(void);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_LOAD_BALANCE_H__ */
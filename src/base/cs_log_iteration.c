@@ -117,6 +117,33 @@ typedef struct {
 
 } cs_log_clip_t;
 
+/* Field statistics for a given mesh location */
+/*---------------------------------------------*/
+
+typedef struct {
+
+  int        loc_id;          /* Associated mesh location id */
+
+  int        n_fields;        /* Number of logged fields */
+  int        n_fields_max;    /* Size of f_id array */
+  int       *f_id;            /* Ids of logged fields */
+
+  int        log_count;       /* Number of logged values */
+  int        log_count_max;   /* Size of values arrays */
+
+  cs_lnum_t  have_weight;     /* Are weighted values available ? */
+  double     total_weight;    /* Total weight, or -1 */
+  cs_gnum_t  n_g_elts;        /* Global number of elements */
+
+  size_t     max_name_width;  /* Maximum name width */
+
+  double    *vmin;            /* Minimum values */
+  double    *vmax;            /* Maximum values */
+  double    *vsum;            /* Sum of values */
+  double    *wsum;            /* Weighted sum of values */
+
+} cs_log_field_loc_t;
+
 /*============================================================================
  * Static global variables
  *============================================================================*/
@@ -143,6 +170,34 @@ static double *_clips_vmin = NULL;
 static double *_clips_vmax = NULL;
 static cs_log_clip_t  *_clips = NULL;
 
+/* Reduced values (possibly pending), used for printing */
+
+static cs_log_field_loc_t  _field_locs[4] = {{0}};
+
+static int _sstats_r_size = 0;
+static int _sstats_r_size_max = 0;
+static double *_sstats_r_vmin = NULL;
+static double *_sstats_r_vmax = NULL;
+static double *_sstats_r_vsum = NULL;
+static double *_sstats_r_wsum = NULL;
+static cs_gnum_t *_sstats_r_n_g_elts = NULL;
+static double *_sstats_r_t_weight = NULL;
+
+static int _clips_r_size = 0;
+static int _clips_r_size_max = 0;
+static cs_gnum_t *_clips_r_count = NULL;
+static double *_clips_r_vmin = NULL;
+static double *_clips_r_vmax = NULL;
+
+/* Deferred logging */
+
+static bool _log_deferred = false;
+static int _log_nt_pending = -1;       /* time step of pending log, or -1 */
+static bool _log_pending_clips = false;
+static bool _log_pending_sstats = false;
+
+static cs_parall_batch_t  *_log_batch = NULL;
+
 static cs_time_plot_t  *_l2_residual_plot = NULL;
 
 /*============================================================================
@@ -508,22 +563,16 @@ _log_clip_info(const char        *prefix,
 }
 
 /*----------------------------------------------------------------------------
- * Main logging output of variables.
+ * Compute local field statistics for the current time step, and register
+ * them for global reduction.
+ *
+ * parameters:
+ *   batch <-> reduction batch
  *----------------------------------------------------------------------------*/
 
 static void
-_log_fields(void)
+_log_fields_prepare(cs_parall_batch_t  *batch)
 {
-  int f_id, li, log_count;
-
-  int log_count_max = 0;
-  int fpe_flag = 0;
-  int     *log_id = NULL, *moment_id = NULL;
-  double  *vmin = NULL, *vmax = NULL, *vsum = NULL, *wsum = NULL;
-
-  char tmp_s[5][64] =  {"", "", "", "", ""};
-
-  const char _underline[] = "---------------------------------";
   const int n_fields = cs_field_n_fields();
   const int n_moments = cs_time_moment_n_moments();
   const int log_key_id = cs_field_key_id("log");
@@ -538,19 +587,11 @@ _log_fields(void)
   cs_mesh_t *m = cs_glob_mesh;
   const cs_mesh_quantities_t *mq = cs_glob_mesh_quantities;
 
-  /* Allocate working arrays */
-
-  log_count_max = n_fields;
-
-  BFT_MALLOC(log_id, n_fields, int);
-  BFT_MALLOC(vmin, log_count_max, double);
-  BFT_MALLOC(vmax, log_count_max, double);
-  BFT_MALLOC(vsum, log_count_max, double);
-  BFT_MALLOC(wsum, log_count_max, double);
+  int *moment_id = NULL;
 
   if (n_moments > 0) {
     BFT_MALLOC(moment_id, n_fields, int);
-    for (f_id = 0; f_id < n_fields; f_id++)
+    for (int f_id = 0; f_id < n_fields; f_id++)
       moment_id[f_id] = -1;
     for (int m_id = 0; m_id < n_moments; m_id++) {
       const cs_field_t *f = cs_time_moment_get_field(m_id);
@@ -561,106 +602,116 @@ _log_fields(void)
 
   /* Loop on locations */
 
-  for (li = 0; li < 4; li++) {
+  for (int li = 0; li < 4; li++) {
+
+    cs_log_field_loc_t *fl = _field_locs + li;
 
-    size_t max_name_width = cs_log_strlen(_("field"));
     int loc_id = m_l[li];
-    cs_lnum_t have_weight = 0;
-    double total_weight = -1;
-    cs_gnum_t n_g_elts = 0;
     cs_real_t *gather_array = NULL; /* only if CS_MESH_LOCATION_VERTICES */
     const cs_lnum_t *n_elts = cs_mesh_location_get_n_elts(loc_id);
     const cs_lnum_t _n_elts = n_elts[0];
     const cs_real_t *weight = NULL;
 
+    fl->loc_id = loc_id;
+    fl->n_fields = 0;
+    fl->log_count = 0;
+    fl->have_weight = 0;
+    fl->total_weight = -1;
+    fl->n_g_elts = 0;
+    fl->max_name_width = cs_log_strlen(_("field"));
+
     if (mq != NULL) {
       switch(loc_id) {
       case CS_MESH_LOCATION_CELLS:
-        n_g_elts = m->n_g_cells;
+        fl->n_g_elts = m->n_g_cells;
         weight = mq->cell_vol;
-        have_weight = 1;
-        total_weight = mq->tot_vol;
+        fl->have_weight = 1;
+        fl->total_weight = mq->tot_vol;
         break;
       case CS_MESH_LOCATION_INTERIOR_FACES:
-        n_g_elts = m->n_g_i_faces;
+        fl->n_g_elts = m->n_g_i_faces;
         weight = mq->i_face_surf;
-        cs_array_reduce_sum_l(_n_elts, 1, NULL, weight, &total_weight);
-        cs_parall_sum(1, CS_DOUBLE, &total_weight);
-        have_weight = 1;
+        cs_array_reduce_sum_l(_n_elts, 1, NULL, weight, &(fl->total_weight));
+        cs_parall_batch_add(batch, CS_PARALL_SUM, 1, CS_DOUBLE,
+                            &(fl->total_weight));
+        fl->have_weight = 1;
         break;
       case CS_MESH_LOCATION_BOUNDARY_FACES:
-        n_g_elts = m->n_g_b_faces;
+        fl->n_g_elts = m->n_g_b_faces;
         weight = mq->b_face_surf;
-        cs_array_reduce_sum_l(_n_elts, 1, NULL, weight, &total_weight);
-        cs_parall_sum(1, CS_DOUBLE, &total_weight);
-        have_weight = 1;
+        cs_array_reduce_sum_l(_n_elts, 1, NULL, weight, &(fl->total_weight));
+        cs_parall_batch_add(batch, CS_PARALL_SUM, 1, CS_DOUBLE,
+                            &(fl->total_weight));
+        fl->have_weight = 1;
         break;
       case CS_MESH_LOCATION_VERTICES:
-        n_g_elts = m->n_g_vertices;
-        have_weight = 0;
+        fl->n_g_elts = m->n_g_vertices;
+        fl->have_weight = 0;
         BFT_MALLOC(gather_array, m->n_vertices, cs_real_t);
         break;
       default:
-        n_g_elts = _n_elts;
-        cs_parall_counter(&n_g_elts, 1);
+        fl->n_g_elts = _n_elts;
+        cs_parall_batch_add(batch, CS_PARALL_SUM, 1, CS_GNUM_TYPE,
+                            &(fl->n_g_elts));
         break;
       }
     }
 
-    if (n_g_elts == 0)
+    if (fl->n_g_elts == 0)
       continue;
 
-    /* First loop on fields */
-
-    log_count = 0;
-
-    for (f_id = 0; f_id < n_fields; f_id++) {
+    /* Loop on fields */
 
-      int _dim, c_id;
+    for (int f_id = 0; f_id < n_fields; f_id++) {
 
       const cs_field_t  *f = cs_field_by_id(f_id);
 
-      if (f->location_id != loc_id || ! (cs_field_get_key_int(f, log_key_id))) {
-        log_id[f_id] = -1;
+      if (f->location_id != loc_id || ! (cs_field_get_key_int(f, log_key_id)))
         continue;
-      }
 
       /* Only log active moments */
 
       if (moment_id != NULL) {
         if (moment_id[f_id] > -1) {
-          if (!cs_time_moment_is_active(moment_id[f_id])) {
-            log_id[f_id] = -1;
+          if (!cs_time_moment_is_active(moment_id[f_id]))
             continue;
-          }
         }
       }
 
       /* Position in log */
 
-      log_id[f_id] = log_count;
+      int log_count = fl->log_count;
+      int _dim = (f->dim == 3) ? 4 : f->dim;
 
-      _dim = (f->dim == 3) ? 4 : f->dim;
+      if (fl->n_fields >= fl->n_fields_max) {
+        fl->n_fields_max = CS_MAX(fl->n_fields_max*2, n_fields);
+        BFT_REALLOC(fl->f_id, fl->n_fields_max, int);
+      }
 
-      while (log_count + _dim > log_count_max) {
-        log_count_max *= 2;
-        BFT_REALLOC(vmin, log_count_max, double);
-        BFT_REALLOC(vmax, log_count_max, double);
-        BFT_REALLOC(vsum, log_count_max, double);
-        BFT_REALLOC(wsum, log_count_max, double);
+      if (log_count + _dim > fl->log_count_max) {
+        fl->log_count_max = CS_MAX(fl->log_count_max, n_fields);
+        while (log_count + _dim > fl->log_count_max)
+          fl->log_count_max *= 2;
+        BFT_REALLOC(fl->vmin, fl->log_count_max, double);
+        BFT_REALLOC(fl->vmax, fl->log_count_max, double);
+        BFT_REALLOC(fl->vsum, fl->log_count_max, double);
+        BFT_REALLOC(fl->wsum, fl->log_count_max, double);
       }
 
-      if (have_weight && (f->type & CS_FIELD_INTENSIVE)) {
+      fl->f_id[fl->n_fields] = f_id;
+      fl->n_fields += 1;
+
+      if (fl->have_weight && (f->type & CS_FIELD_INTENSIVE)) {
         cs_array_reduce_simple_stats_l_w(_n_elts,
                                          f->dim,
                                          NULL,
                                          NULL,
                                          f->val,
                                          weight,
-                                         vmin + log_count,
-                                         vmax + log_count,
-                                         vsum + log_count,
-                                         wsum + log_count);
+                                         fl->vmin + log_count,
+                                         fl->vmax + log_count,
+                                         fl->vsum + log_count,
+                                         fl->wsum + log_count);
 
       }
       else {
@@ -692,17 +743,15 @@ _log_fields(void)
                                        f->dim,
                                        NULL,
                                        field_val,
-                                       vmin + log_count,
-                                       vmax + log_count,
-                                       vsum + log_count);
+                                       fl->vmin + log_count,
+                                       fl->vmax + log_count,
+                                       fl->vsum + log_count);
 
-        if (have_weight) {
-          for (c_id = 0; c_id < _dim; c_id++)
-            wsum[log_count + c_id] = 0.;
-        }
+        for (int c_id = 0; c_id < _dim; c_id++)
+          fl->wsum[log_count + c_id] = 0.;
       }
 
-      log_count += _dim;
+      fl->log_count += _dim;
 
       const char *name = cs_field_get_key_str(f, label_key_id);
       if (name == NULL)
@@ -714,33 +763,79 @@ _log_fields(void)
       else if (f->dim > 3)
         l_name_width += 4;
 
-      max_name_width = CS_MAX(max_name_width, l_name_width);
+      fl->max_name_width = CS_MAX(fl->max_name_width, l_name_width);
 
-    } /* End of first loop on fields */
+    } /* End of loop on fields */
 
     if (gather_array != NULL)
       BFT_FREE(gather_array);
 
-    if (log_count < 1)
+    if (fl->log_count < 1)
       continue;
 
-    /* Group MPI operations if required */
+    /* Group MPI operations */
 
-    cs_parall_min(log_count, CS_DOUBLE, vmin);
-    cs_parall_max(log_count, CS_DOUBLE, vmax);
-    cs_parall_sum(log_count, CS_DOUBLE, vsum);
+    cs_parall_batch_add(batch, CS_PARALL_MIN, fl->log_count, CS_DOUBLE,
+                        fl->vmin);
+    cs_parall_batch_add(batch, CS_PARALL_MAX, fl->log_count, CS_DOUBLE,
+                        fl->vmax);
+    cs_parall_batch_add(batch, CS_PARALL_SUM, fl->log_count, CS_DOUBLE,
+                        fl->vsum);
+    cs_parall_batch_add(batch, CS_PARALL_MAX, 1, CS_LNUM_TYPE,
+                        &(fl->have_weight));
+    cs_parall_batch_add(batch, CS_PARALL_SUM, fl->log_count, CS_DOUBLE,
+                        fl->wsum);
 
-#   if defined(HAVE_MPI)
-    cs_parall_counter_max(&have_weight, 1);
-    if (have_weight)
-      cs_parall_sum(log_count, CS_DOUBLE, wsum);
-#   endif
+  } /* End of loop on mesh locations */
+
+  BFT_FREE(moment_id);
+}
+
+/*----------------------------------------------------------------------------
+ * Main logging output of variables, based on reduced statistics.
+ *----------------------------------------------------------------------------*/
+
+static void
+_log_fields_print(void)
+{
+  int fpe_flag = 0;
+  int *moment_id = NULL;
+
+  char tmp_s[5][64] =  {"", "", "", "", ""};
+
+  const char _underline[] = "---------------------------------";
+  const int n_fields = cs_field_n_fields();
+  const int n_moments = cs_time_moment_n_moments();
+  const int label_key_id = cs_field_key_id("label");
+
+  if (n_moments > 0) {
+    BFT_MALLOC(moment_id, n_fields, int);
+    for (int f_id = 0; f_id < n_fields; f_id++)
+      moment_id[f_id] = -1;
+    for (int m_id = 0; m_id < n_moments; m_id++) {
+      const cs_field_t *f = cs_time_moment_get_field(m_id);
+      if (f != NULL)
+        moment_id[f->id] = m_id;
+    }
+  }
+
+  /* Loop on locations */
+
+  for (int li = 0; li < 4; li++) {
+
+    const cs_log_field_loc_t *fl = _field_locs + li;
+
+    if (fl->n_g_elts == 0 || fl->log_count < 1)
+      continue;
+
+    const int have_weight = fl->have_weight;
+    const double total_weight = fl->total_weight;
 
     /* Print headers */
 
-    max_name_width = CS_MIN(max_name_width, 63);
+    size_t max_name_width = CS_MIN(fl->max_name_width, 63);
 
-    const char *loc_name = _(cs_mesh_location_get_name(loc_id));
+    const char *loc_name = _(cs_mesh_location_get_name(fl->loc_id));
     size_t loc_name_w = cs_log_strlen(loc_name);
 
     cs_log_printf(CS_LOG_DEFAULT,
@@ -785,21 +880,18 @@ _log_fields(void)
                     "-  %s  %s  %s  %s\n",
                     tmp_s[0], tmp_s[1], tmp_s[2], tmp_s[3]);
 
-    /* Second loop on fields */
-
-    log_count = 0;
+    /* Loop on logged fields */
 
-    for (f_id = 0; f_id < n_fields; f_id++) {
+    int log_count = 0;
 
-      int _dim;
-      if (log_id[f_id] < 0)
-        continue;
+    for (int i = 0; i < fl->n_fields; i++) {
 
+      const int f_id = fl->f_id[i];
       const cs_field_t  *f = cs_field_by_id(f_id);
 
       /* Position in log */
 
-      _dim = (f->dim == 3) ? 4 : f->dim;
+      int _dim = (f->dim == 3) ? 4 : f->dim;
 
       const char *name = cs_field_get_key_str(f, label_key_id);
       if (name == NULL)
@@ -821,12 +913,12 @@ _log_fields(void)
                       name,
                       max_name_width,
                       f->dim,
-                      n_g_elts,
+                      fl->n_g_elts,
                       t_weight,
-                      vmin + log_count,
-                      vmax + log_count,
-                      vsum + log_count,
-                      wsum + log_count,
+                      fl->vmin + log_count,
+                      fl->vmax + log_count,
+                      fl->vsum + log_count,
+                      fl->wsum + log_count,
                       &fpe_flag);
 
       log_count += _dim;
@@ -841,27 +933,86 @@ _log_fields(void)
                 _("Invalid (not-a-number) values detected for a field."));
 
   BFT_FREE(moment_id);
-  BFT_FREE(wsum);
-  BFT_FREE(vsum);
-  BFT_FREE(vmax);
-  BFT_FREE(vmin);
-  BFT_FREE(log_id);
 
   cs_log_printf(CS_LOG_DEFAULT, "\n");
 }
 
 /*----------------------------------------------------------------------------
- * Main logging output of additional simple statistics
+ * Copy local additional simple statistics, and register them for
+ * global reduction.
+ *
+ * parameters:
+ *   batch <-> reduction batch
+ *----------------------------------------------------------------------------*/
+
+static void
+_log_sstats_prepare(cs_parall_batch_t  *batch)
+{
+  const cs_mesh_quantities_t *mq = cs_glob_mesh_quantities;
+  const int n_locations = cs_mesh_location_n_locations();
+
+  /* Copy values */
+
+  if (_sstats_r_size_max < _sstats_val_size) {
+    _sstats_r_size_max = _sstats_val_size;
+    BFT_REALLOC(_sstats_r_vmin, _sstats_r_size_max, double);
+    BFT_REALLOC(_sstats_r_vmax, _sstats_r_size_max, double);
+    BFT_REALLOC(_sstats_r_vsum, _sstats_r_size_max, double);
+    BFT_REALLOC(_sstats_r_wsum, _sstats_r_size_max, double);
+  }
+  _sstats_r_size = _sstats_val_size;
+
+  memcpy(_sstats_r_vmin, _sstats_vmin, _sstats_val_size*sizeof(double));
+  memcpy(_sstats_r_vmax, _sstats_vmax, _sstats_val_size*sizeof(double));
+  memcpy(_sstats_r_vsum, _sstats_vsum, _sstats_val_size*sizeof(double));
+  memcpy(_sstats_r_wsum, _sstats_wsum, _sstats_val_size*sizeof(double));
+
+  /* Global number of elements and total weight of locations */
+
+  BFT_REALLOC(_sstats_r_n_g_elts, n_locations, cs_gnum_t);
+  BFT_REALLOC(_sstats_r_t_weight, n_locations, double);
+
+  for (int loc_id = 0; loc_id < n_locations; loc_id++) {
+    _sstats_r_n_g_elts[loc_id] = cs_mesh_location_get_n_elts(loc_id)[0];
+    _sstats_r_t_weight[loc_id] = -1;
+  }
+
+  if (mq != NULL) {
+    const cs_mesh_t *m = cs_glob_mesh;
+    _sstats_r_t_weight[CS_MESH_LOCATION_CELLS] = mq->tot_vol;
+    cs_array_reduce_sum_l(m->n_i_faces, 1, NULL, mq->i_face_surf,
+                          _sstats_r_t_weight + CS_MESH_LOCATION_INTERIOR_FACES);
+    cs_array_reduce_sum_l(m->n_b_faces, 1, NULL, mq->b_face_surf,
+                          _sstats_r_t_weight + CS_MESH_LOCATION_BOUNDARY_FACES);
+    cs_parall_batch_add(batch, CS_PARALL_SUM, 2, CS_DOUBLE,
+                        _sstats_r_t_weight + CS_MESH_LOCATION_INTERIOR_FACES);
+  }
+
+  /* Group MPI operations */
+
+  cs_parall_batch_add(batch, CS_PARALL_SUM, n_locations, CS_GNUM_TYPE,
+                      _sstats_r_n_g_elts);
+
+  cs_parall_batch_add(batch, CS_PARALL_MIN, _sstats_val_size, CS_DOUBLE,
+                      _sstats_r_vmin);
+  cs_parall_batch_add(batch, CS_PARALL_MAX, _sstats_val_size, CS_DOUBLE,
+                      _sstats_r_vmax);
+  cs_parall_batch_add(batch, CS_PARALL_SUM, _sstats_val_size, CS_DOUBLE,
+                      _sstats_r_vsum);
+  cs_parall_batch_add(batch, CS_PARALL_SUM, _sstats_val_size, CS_DOUBLE,
+                      _sstats_r_wsum);
+}
+
+/*----------------------------------------------------------------------------
+ * Main logging output of additional simple statistics, based on reduced
+ * values.
  *----------------------------------------------------------------------------*/
 
 static void
-_log_sstats(void)
+_log_sstats_print(void)
 {
   int     stat_id;
   int     fpe_flag = 0;
-  double _boundary_surf = -1;
-  double _interior_surf = -1;
-  double  *vmin = NULL, *vmax = NULL, *vsum = NULL, *wsum = NULL;
 
   char tmp_s[5][64] =  {"", "", "", "", ""};
 
@@ -870,25 +1021,6 @@ _log_sstats(void)
   const cs_mesh_t *m = cs_glob_mesh;
   const cs_mesh_quantities_t *mq = cs_glob_mesh_quantities;
 
-  /* Allocate working arrays */
-
-  BFT_MALLOC(vmin, _sstats_val_size, double);
-  BFT_MALLOC(vmax, _sstats_val_size, double);
-  BFT_MALLOC(vsum, _sstats_val_size, double);
-  BFT_MALLOC(wsum, _sstats_val_size, double);
-
-  memcpy(vmin, _sstats_vmin, _sstats_val_size*sizeof(double));
-  memcpy(vmax, _sstats_vmax, _sstats_val_size*sizeof(double));
-  memcpy(vsum, _sstats_vsum, _sstats_val_size*sizeof(double));
-  memcpy(wsum, _sstats_wsum, _sstats_val_size*sizeof(double));
-
-  /* Group MPI operations if required */
-
-  cs_parall_min(_sstats_val_size, CS_DOUBLE, vmin);
-  cs_parall_max(_sstats_val_size, CS_DOUBLE, vmax);
-  cs_parall_sum(_sstats_val_size, CS_DOUBLE, vsum);
-  cs_parall_sum(_sstats_val_size, CS_DOUBLE, wsum);
-
   /* Loop on statistics */
 
   int sstat_cat_start = 0;
@@ -911,12 +1043,15 @@ _log_sstats(void)
     const size_t cat_name_w = cs_log_strlen(_(cat_name));
     size_t max_name_width = cat_name_w;
 
-    /* Now separate by mesh location */
+    /* Now separate by mesh location
+       (ignoring statistics added after values were reduced) */
 
     int loc_min = cs_mesh_location_n_locations() + 1;
     int loc_max = -1;
 
     for (stat_id = sstat_cat_start; stat_id < sstat_cat_end; stat_id++) {
+      if (_sstats[stat_id].v_idx >= _sstats_r_size)
+        continue;
       int loc_id = _sstats[stat_id].loc_id;
       loc_min = CS_MIN(loc_min, loc_id);
       loc_max = CS_MAX(loc_max, loc_id);
@@ -926,7 +1061,8 @@ _log_sstats(void)
 
       int n_loc_stats = 0;
       for (stat_id = sstat_cat_start; stat_id < sstat_cat_end; stat_id++) {
-        if (_sstats[stat_id].loc_id == loc_id)
+        if (   _sstats[stat_id].loc_id == loc_id
+            && _sstats[stat_id].v_idx < _sstats_r_size)
           n_loc_stats++;
       }
       if (n_loc_stats == 0)
@@ -935,9 +1071,6 @@ _log_sstats(void)
       cs_gnum_t n_g_elts = 0;
       int have_weight = 0;
       double total_weight = -1;
-      const cs_lnum_t *n_elts = cs_mesh_location_get_n_elts(loc_id);;
-      const cs_lnum_t _n_elts = n_elts[0];
-      const cs_real_t *weight = NULL;
       const char *loc_name = _(cs_mesh_location_get_name(loc_id));
       size_t loc_name_w = cs_log_strlen(loc_name);
 
@@ -945,30 +1078,14 @@ _log_sstats(void)
         switch(loc_id) {
         case CS_MESH_LOCATION_CELLS:
           n_g_elts = m->n_g_cells;
-          weight = mq->cell_vol;
           have_weight = 1;
-          total_weight = mq->tot_vol;
           break;
         case CS_MESH_LOCATION_INTERIOR_FACES:
           n_g_elts = m->n_g_i_faces;
-          weight = mq->i_face_surf;
-          if (_interior_surf < 0) {
-            cs_array_reduce_sum_l(_n_elts, 1, NULL, weight, &_interior_surf);
-            cs_parall_sum(1, CS_DOUBLE, &_interior_surf);
-            if (_interior_surf < 0) _interior_surf = 0; /* just to be safe */
-          }
-          total_weight = _interior_surf;
           have_weight = 1;
           break;
         case CS_MESH_LOCATION_BOUNDARY_FACES:
           n_g_elts = m->n_g_b_faces;
-          weight = mq->b_face_surf;
-          if (_boundary_surf < 0) {
-            cs_array_reduce_sum_l(_n_elts, 1, NULL, weight, &_boundary_surf);
-            cs_parall_sum(1, CS_DOUBLE, &_boundary_surf);
-            if (_boundary_surf < 0) _boundary_surf = 0; /* just to be safe */
-          }
-          total_weight = _boundary_surf;
           have_weight = 1;
           break;
         case CS_MESH_LOCATION_VERTICES:
@@ -976,14 +1093,18 @@ _log_sstats(void)
           have_weight = 0;
           break;
         default:
-          n_g_elts = _n_elts;
-          cs_parall_counter(&n_g_elts, 1);
+          n_g_elts = _sstats_r_n_g_elts[loc_id];
           break;
         }
+        if (have_weight) {
+          total_weight = _sstats_r_t_weight[loc_id];
+          if (total_weight < 0) total_weight = 0; /* just to be safe */
+        }
       }
 
       for (stat_id = sstat_cat_start; stat_id < sstat_cat_end; stat_id++) {
-        if (_sstats[stat_id].loc_id == loc_id) {
+        if (   _sstats[stat_id].loc_id == loc_id
+            && _sstats[stat_id].v_idx < _sstats_r_size) {
           const char *stat_name
             = cs_map_name_to_id_reverse(_name_map, _sstats[stat_id].name_id);
           size_t name_width = strlen(stat_name);
@@ -997,7 +1118,6 @@ _log_sstats(void)
                       "  ** Computed values on %s\n"
                       "     -------------------%.*s\n"),
                     loc_name, (int)loc_name_w, _underline);
-
       cs_log_strpad(tmp_s[0], _(cat_name), max_name_width, 64);
       cs_log_strpadl(tmp_s[1], _("minimum"), 14, 64);
       cs_log_strpadl(tmp_s[2], _("maximum"), 14, 64);
@@ -1038,7 +1158,9 @@ _log_sstats(void)
 
       for (stat_id = sstat_cat_start; stat_id < sstat_cat_end; stat_id++) {
 
-        if (_sstats[stat_id].loc_id != loc_id)
+        const int v_idx = _sstats[stat_id].v_idx;
+
+        if (_sstats[stat_id].loc_id != loc_id || v_idx >= _sstats_r_size)
           continue;
 
         const char *name
@@ -1054,10 +1176,10 @@ _log_sstats(void)
                         _sstats[stat_id].dim,
                         n_g_elts,
                         t_weight,
-                        vmin + stat_id,
-                        vmax + stat_id,
-                        vsum + stat_id,
-                        wsum + stat_id,
+                        _sstats_r_vmin + v_idx,
+                        _sstats_r_vmax + v_idx,
+                        _sstats_r_vsum + v_idx,
+                        _sstats_r_wsum + v_idx,
                         &fpe_flag);
 
       } /* End of loop on stats */
@@ -1073,14 +1195,10 @@ _log_sstats(void)
     bft_error(__FILE__, __LINE__, 0,
                 _("Invalid (not-a-number) values detected for a statistic."));
 
-  BFT_FREE(wsum);
-  BFT_FREE(vsum);
-  BFT_FREE(vmax);
-  BFT_FREE(vmin);
-
   cs_log_printf(CS_LOG_DEFAULT, "\n");
 }
 
+
 /*----------------------------------------------------------------------------
  * Add or update clipping info for a given array
  *
@@ -1195,16 +1313,46 @@ _add_clipping(int               name_id,
 }
 
 /*----------------------------------------------------------------------------
- * Main logging output of additional clippings
+ * Copy local clipping info, and register it for global reduction.
+ *
+ * parameters:
+ *   batch <-> reduction batch
+ *----------------------------------------------------------------------------*/
+
+static void
+_log_clips_prepare(cs_parall_batch_t  *batch)
+{
+  if (_clips_r_size_max < _clips_val_size) {
+    _clips_r_size_max = _clips_val_size;
+    BFT_REALLOC(_clips_r_vmin, _clips_r_size_max, double);
+    BFT_REALLOC(_clips_r_vmax, _clips_r_size_max, double);
+    BFT_REALLOC(_clips_r_count, _clips_r_size_max*2, cs_gnum_t);
+  }
+  _clips_r_size = _clips_val_size;
+
+  memcpy(_clips_r_vmin, _clips_vmin, _clips_val_size*sizeof(double));
+  memcpy(_clips_r_vmax, _clips_vmax, _clips_val_size*sizeof(double));
+  memcpy(_clips_r_count, _clips_count, _clips_val_size*sizeof(cs_gnum_t)*2);
+
+  /* Group MPI operations */
+
+  cs_parall_batch_add(batch, CS_PARALL_MIN, _clips_val_size, CS_DOUBLE,
+                      _clips_r_vmin);
+  cs_parall_batch_add(batch, CS_PARALL_MAX, _clips_val_size, CS_DOUBLE,
+                      _clips_r_vmax);
+  cs_parall_batch_add(batch, CS_PARALL_SUM, _clips_val_size*2, CS_GNUM_TYPE,
+                      _clips_r_count);
+}
+
+/*----------------------------------------------------------------------------
+ * Main logging output of additional clippings, based on reduced values.
  *----------------------------------------------------------------------------*/
 
 static void
-_log_clips(void)
+_log_clips_print(void)
 {
   int     clip_id;
   int     type_idx[] = {0, 0, 0};
-  double  *vmin = NULL, *vmax = NULL;
-  cs_gnum_t  *vcount = NULL;
   size_t max_name_width = cs_log_strlen(_("field"));
   const int label_key_id = cs_field_key_id("label");
 
@@ -1213,22 +1361,6 @@ _log_clips(void)
   const char *_cat_name[] = {N_("field"), N_("value")};
   const char *_cat_prefix[] = {"a  ", "a   "};
 
-  /* Allocate working arrays */
-
-  BFT_MALLOC(vmin, _clips_val_size, double);
-  BFT_MALLOC(vmax, _clips_val_size, double);
-  BFT_MALLOC(vcount, _clips_val_size*2, cs_gnum_t);
-
-  memcpy(vmin, _clips_vmin, _clips_val_size*sizeof(double));
-  memcpy(vmax, _clips_vmax, _clips_val_size*sizeof(double));
-  memcpy(vcount, _clips_count, _clips_val_size*sizeof(cs_gnum_t)*2);
-
-  /* Group MPI operations if required */
-
-  cs_parall_min(_clips_val_size, CS_DOUBLE, vmin);
-  cs_parall_max(_clips_val_size, CS_DOUBLE, vmax);
-  cs_parall_sum(_clips_val_size*2, CS_GNUM_TYPE, vcount);
-
   /* Fist loop on clippings for counting */
 
   for (clip_id = 0; clip_id < _n_clips; clip_id++) {
@@ -1324,6 +1456,9 @@ _log_clips(void)
 
       int v_idx = _clips[clip_id].v_idx;
 
+      if (v_idx >= _clips_r_size) /* added after values were reduced */
+        continue;
+
       const char *name = NULL;
       int f_id = _clips[clip_id].f_id;
       if (f_id > -1) {
@@ -1341,21 +1476,49 @@ _log_clips(void)
                       name,
                       max_name_width,
                      _clips[clip_id].dim,
-                     vcount + v_idx*2,
-                     vcount + v_idx*2 + 1,
-                     vmin + v_idx,
-                     vmax + v_idx);
+                     _clips_r_count + v_idx*2,
+                     _clips_r_count + v_idx*2 + 1,
+                     _clips_r_vmin + v_idx,
+                     _clips_r_vmax + v_idx);
     }
 
   }
 
-  BFT_FREE(vcount);
-  BFT_FREE(vmax);
-  BFT_FREE(vmin);
-
   cs_log_printf(CS_LOG_DEFAULT, "\n");
 }
 
+/*----------------------------------------------------------------------------
+ * Complete reductions of the pending log and print it.
+ *----------------------------------------------------------------------------*/
+
+static void
+_log_pending(void)
+{
+  if (_log_nt_pending < 0)
+    return;
+
+  cs_parall_batch_wait(_log_batch);
+
+  const cs_time_step_t *ts = cs_glob_time_step;
+
+  if (_log_nt_pending != ts->nt_cur)
+    cs_log_printf(CS_LOG_DEFAULT,
+                  _("\n"
+                    "  ** Values at time step %d (deferred)\n"
+                    "     ---------------------------------\n"),
+                  _log_nt_pending);
+
+  _log_nt_pending = -1;
+
+  if (_log_pending_clips)
+    _log_clips_print();
+
+  _log_fields_print();
+
+  if (_log_pending_sstats)
+    _log_sstats_print();
+}
+
 /*============================================================================
  * Fortran wrapper function definitions
  *============================================================================*/
@@ -1375,6 +1538,38 @@ _log_clips(void)
 void
 cs_log_iteration_destroy_all(void)
 {
+  _log_pending();
+
+  cs_parall_batch_destroy(&_log_batch);
+
+  for (int li = 0; li < 4; li++) {
+    cs_log_field_loc_t *fl = _field_locs + li;
+    fl->n_fields = 0;
+    fl->n_fields_max = 0;
+    fl->log_count = 0;
+    fl->log_count_max = 0;
+    BFT_FREE(fl->f_id);
+    BFT_FREE(fl->vmin);
+    BFT_FREE(fl->vmax);
+    BFT_FREE(fl->vsum);
+    BFT_FREE(fl->wsum);
+  }
+
+  _sstats_r_size = 0;
+  _sstats_r_size_max = 0;
+  BFT_FREE(_sstats_r_vmin);
+  BFT_FREE(_sstats_r_vmax);
+  BFT_FREE(_sstats_r_vsum);
+  BFT_FREE(_sstats_r_wsum);
+  BFT_FREE(_sstats_r_n_g_elts);
+  BFT_FREE(_sstats_r_t_weight);
+
+  _clips_r_size = 0;
+  _clips_r_size_max = 0;
+  BFT_FREE(_clips_r_count);
+  BFT_FREE(_clips_r_vmin);
+  BFT_FREE(_clips_r_vmax);
+
   if (_category_map != NULL) {
     _sstats_val_size = 0;
     _sstats_val_size_max = 0;
@@ -1415,13 +1610,36 @@ cs_log_iteration_destroy_all(void)
 void
 cs_log_iteration(void)
 {
-  if (_n_clips > 0)
-    _log_clips();
+  const cs_time_step_t *ts = cs_glob_time_step;
 
-  _log_fields();
+  /* Complete and print previous log if deferred */
 
-  if (_n_sstats > 0)
-    _log_sstats();
+  _log_pending();
+
+  /* Compute local values and start grouped reductions */
+
+  if (_log_batch == NULL)
+    _log_batch = cs_parall_batch_create();
+
+  _log_pending_clips = (_n_clips > 0) ? true : false;
+  _log_pending_sstats = (_n_sstats > 0) ? true : false;
+
+  if (_log_pending_clips)
+    _log_clips_prepare(_log_batch);
+
+  _log_fields_prepare(_log_batch);
+
+  if (_log_pending_sstats)
+    _log_sstats_prepare(_log_batch);
+
+  cs_parall_batch_start(_log_batch);
+
+  _log_nt_pending = ts->nt_cur;
+
+  /* Print now unless deferred (never deferring the last time step) */
+
+  if (_log_deferred == false || ts->nt_cur >= ts->nt_max)
+    _log_pending();
 
   cs_time_moment_log_iteration();
   cs_lagr_stat_log_iteration();
@@ -1431,6 +1649,28 @@ cs_log_iteration(void)
   cs_ctwr_log_balance();
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set whether logging of field and other array statistics is
+ *        deferred.
+ *
+ * Statistics are always reduced using a single grouped non-blocking
+ * operation. When logging is deferred, that operation is completed and
+ * the matching statistics are printed only at the next logged time step
+ * (or at the end of the computation), so that logging does not
+ * synchronize the time loop. Checks for invalid (not-a-number) values
+ * are deferred accordingly.
+ *
+ * \param[in]  deferred  true if logging is deferred, false otherwise
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_log_iteration_set_deferred(bool  deferred)
+{
+  _log_deferred = deferred;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Add or update array not saved as permanent field to iteration log.
@@ -76,6 +76,16 @@ cs_log_iteration_destroy_all(void);
 void
 cs_log_iteration(void);
 
+/*----------------------------------------------------------------------------
+ * Set whether logging of field and other array statistics is deferred.
+ *
+ * parameters:
+ *   deferred <-- true if logging is deferred, false otherwise
+ *----------------------------------------------------------------------------*/
+
+void
+cs_log_iteration_set_deferred(bool  deferred);
+
 /*----------------------------------------------------------------------------
  * Add or update array not saved as permanent field to iteration log.
  *
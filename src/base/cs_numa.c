@@ -0,0 +1,830 @@
+/*============================================================================
+ * NUMA-aware memory placement of large arrays.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+/* On glibc-based systems, define _GNU_SOURCE so as to enable the syscall()
+   function, used for NUMA node queries; _GNU_SOURCE must be defined before
+   including any headers, to ensure the correct feature macros are defined
+   first. */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#  define _GNU_SOURCE
+#endif
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined(HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+
+#if defined(HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+/*----------------------------------------------------------------------------
+ * Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "bft_mem.h"
+#include "bft_printf.h"
+
+#include "cs_field.h"
+#include "cs_log.h"
+#include "cs_mesh.h"
+#include "cs_mesh_location.h"
+#include "cs_mesh_quantities.h"
+#include "cs_parall.h"
+
+/*----------------------------------------------------------------------------
+ * Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_numa.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Additional doxygen documentation
+ *============================================================================*/
+
+/*!
+  \file cs_numa.c
+        NUMA-aware memory placement of large arrays.
+
+  On multi-socket nodes, memory pages are usually placed on the NUMA node
+  of the thread which first touches them. Large mesh and field arrays are
+  thus initialized in parallel, using the same thread ranges as the
+  threaded loops operating on them (based on the associated
+  \ref cs_numbering_t structure), so that these loops mostly access local
+  memory.
+*/
+
+/*! \cond DOXYGEN_SHOULD_SKIP_THIS */
+
+/*=============================================================================
+ * Local macro definitions
+ *============================================================================*/
+
+/* Size above which huge pages are advised */
+
+#define _HUGE_PAGE_SIZE  2097152
+
+/* Maximum number of sampled pages per array for placement report */
+
+#define _N_SAMPLES_MAX  256
+
+#if defined(__linux__) && defined(SYS_move_pages) && defined(SYS_getcpu)
+#define _HAVE_NUMA_QUERY 1
+#endif
+
+/*============================================================================
+ * Type definitions
+ *============================================================================*/
+
+/* Page placement counters for a category of arrays */
+
+typedef struct {
+
+  cs_gnum_t  n_sampled;   /* number of sampled pages */
+  cs_gnum_t  n_present;   /* number of sampled pages present in memory */
+  cs_gnum_t  n_local;     /* number of pages on expected thread's node */
+
+} _placement_count_t;
+
+/*============================================================================
+ * Static global variables
+ *============================================================================*/
+
+static bool  _huge_pages = false;
+static bool  _placement_log = true;
+
+/*============================================================================
+ * Private function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Compute array index range for a given thread, consistent with an
+ * OpenMP static schedule.
+ *
+ * parameters:
+ *   n       <-- size of array
+ *   n_t     <-- number of threads
+ *   t_id    <-- thread id
+ *   s_id    --> start index for the current thread
+ *   e_id    --> past-the-end index for the current thread
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_static_range(cs_lnum_t   n,
+              int         n_t,
+              int         t_id,
+              cs_lnum_t  *s_id,
+              cs_lnum_t  *e_id)
+{
+  cs_lnum_t q = n / n_t;
+  cs_lnum_t r = n % n_t;
+
+  if (t_id < r) {
+    *s_id = (q+1)*t_id;
+    *e_id = *s_id + q + 1;
+  }
+  else {
+    *s_id = (q+1)*r + q*(t_id - r);
+    *e_id = *s_id + q;
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Return the thread which handles a given index with an OpenMP static
+ * schedule (reciprocal of _static_range).
+ *
+ * parameters:
+ *   n       <-- size of array
+ *   n_t     <-- number of threads
+ *   i       <-- index
+ *
+ * returns:
+ *   id of associated thread
+ *----------------------------------------------------------------------------*/
+
+static inline int
+_static_owner(cs_lnum_t  n,
+              int        n_t,
+              cs_lnum_t  i)
+{
+  cs_lnum_t q = n / n_t;
+  cs_lnum_t r = n % n_t;
+
+  if (i < (q+1)*r)
+    return i / (q+1);
+  else if (q > 0)
+    return r + (i - (q+1)*r) / q;
+  else
+    return n_t - 1;
+}
+
+/*----------------------------------------------------------------------------
+ * Return the number of elements covered by a threaded numbering,
+ * or 0 if the numbering is not usable for placement.
+ *
+ * parameters:
+ *   numbering <-- associated numbering, or NULL
+ *   n_elts    <-- number of elements
+ *
+ * returns:
+ *   number of elements whose placement is based on the numbering
+ *----------------------------------------------------------------------------*/
+
+static cs_lnum_t
+_n_numbered_elts(const cs_numbering_t  *numbering,
+                 cs_lnum_t              n_elts)
+{
+  cs_lnum_t n_numbered = 0;
+
+  if (numbering == NULL)
+    return 0;
+
+  if (numbering->n_threads < 2)
+    return 0;
+
+  const int n_groups = numbering->n_groups;
+  const cs_lnum_t *group_index = numbering->group_index;
+
+  for (int t_id = 0; t_id < numbering->n_threads; t_id++) {
+    for (int g_id = 0; g_id < n_groups; g_id++) {
+      cs_lnum_t e_id = group_index[(t_id*n_groups + g_id)*2 + 1];
+      if (e_id > n_numbered)
+        n_numbered = e_id;
+    }
+  }
+
+  if (n_numbered > n_elts)
+    n_numbered = 0;
+
+  return n_numbered;
+}
+
+/*----------------------------------------------------------------------------
+ * Copy or zero elements of an array based on the thread ranges of a given
+ * numbering.
+ *
+ * parameters:
+ *   numbering <-- associated numbering, or NULL
+ *   n_elts    <-- number of elements
+ *   elt_size  <-- element size
+ *   src       <-- source array, or NULL for zeroing
+ *   dest      <-> destination array
+ *----------------------------------------------------------------------------*/
+
+static void
+_placed_copy(const cs_numbering_t  *numbering,
+             cs_lnum_t              n_elts,
+             size_t                 elt_size,
+             const void            *src,
+             void                  *dest)
+{
+  const unsigned char *_src = src;
+  unsigned char *_dest = dest;
+
+  const cs_lnum_t n_numbered = _n_numbered_elts(numbering, n_elts);
+
+  if (n_numbered > 0) {
+
+    const int n_threads = numbering->n_threads;
+    const int n_groups = numbering->n_groups;
+    const cs_lnum_t *group_index = numbering->group_index;
+
+#   pragma omp parallel for
+    for (int t_id = 0; t_id < n_threads; t_id++) {
+      for (int g_id = 0; g_id < n_groups; g_id++) {
+        cs_lnum_t s_id = group_index[(t_id*n_groups + g_id)*2];
+        cs_lnum_t e_id = group_index[(t_id*n_groups + g_id)*2 + 1];
+        if (e_id > s_id) {
+          size_t n_bytes = (size_t)(e_id - s_id) * elt_size;
+          if (_src != NULL)
+            memcpy(_dest + s_id*elt_size, _src + s_id*elt_size, n_bytes);
+          else
+            memset(_dest + s_id*elt_size, 0, n_bytes);
+        }
+      }
+    }
+
+  }
+
+  /* Remaining elements (all elements for non-threaded numberings) */
+
+  const cs_lnum_t n_rem = n_elts - n_numbered;
+
+  if (n_rem < 1)
+    return;
+
+  unsigned char *_dest_r = _dest + n_numbered*elt_size;
+  const unsigned char *_src_r = (_src != NULL) ? _src + n_numbered*elt_size
+                                               : NULL;
+
+# pragma omp parallel if (n_rem > CS_THR_MIN)
+  {
+    int t_id = 0, n_t = 1;
+#if defined(HAVE_OPENMP)
+    t_id = omp_get_thread_num();
+    n_t = omp_get_num_threads();
+#endif
+
+    cs_lnum_t s_id, e_id;
+    _static_range(n_rem, n_t, t_id, &s_id, &e_id);
+
+    if (e_id > s_id) {
+      size_t n_bytes = (size_t)(e_id - s_id) * elt_size;
+      if (_src_r != NULL)
+        memcpy(_dest_r + s_id*elt_size, _src_r + s_id*elt_size, n_bytes);
+      else
+        memset(_dest_r + s_id*elt_size, 0, n_bytes);
+    }
+  }
+}
+
+#if defined(_HAVE_NUMA_QUERY)
+
+/*----------------------------------------------------------------------------
+ * Determine the NUMA node of each OpenMP thread.
+ *
+ * parameters:
+ *   n_threads   --> number of threads
+ *
+ * returns:
+ *   NUMA node of each thread (to be freed by caller)
+ *----------------------------------------------------------------------------*/
+
+static int *
+_thread_nodes(int  *n_threads)
+{
+  int *thread_node = NULL;
+  int n_t = 1;
+
+#if defined(HAVE_OPENMP)
+  n_t = omp_get_max_threads();
+#endif
+
+  BFT_MALLOC(thread_node, n_t, int);
+
+# pragma omp parallel num_threads(n_t)
+  {
+    int t_id = 0;
+#if defined(HAVE_OPENMP)
+    t_id = omp_get_thread_num();
+#endif
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0)
+      node = 0;
+    thread_node[t_id] = node;
+  }
+
+  *n_threads = n_t;
+
+  return thread_node;
+}
+
+/*----------------------------------------------------------------------------
+ * Sample page placement of an array.
+ *
+ * parameters:
+ *   numbering   <-- associated numbering, or NULL
+ *   n_elts      <-- number of elements
+ *   elt_size    <-- element size
+ *   p           <-- pointer to array
+ *   n_threads   <-- number of OpenMP threads
+ *   thread_node <-- NUMA node of each thread
+ *   count       <-> placement counters
+ *----------------------------------------------------------------------------*/
+
+static void
+_sample_placement(const cs_numbering_t  *numbering,
+                  cs_lnum_t              n_elts,
+                  size_t                 elt_size,
+                  const void            *p,
+                  int                    n_threads,
+                  const int              thread_node[],
+                  _placement_count_t    *count)
+{
+  if (p == NULL || n_elts < 1 || elt_size < 1)
+    return;
+
+  const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  const uintptr_t a_start = (uintptr_t)p;
+  const uintptr_t a_end = a_start + (uintptr_t)n_elts*elt_size;
+
+  uintptr_t p_start = a_start & ~(page_size - 1);
+  size_t n_pages = (a_end - p_start + page_size - 1) / page_size;
+
+  /* Skip first and last pages, usually shared with other arrays */
+
+  if (n_pages < 3)
+    return;
+
+  size_t n_samples = CS_MIN(n_pages - 2, _N_SAMPLES_MAX);
+  size_t step = (n_pages - 2) / n_samples;
+
+  void **pages = NULL;
+  int *expected = NULL, *status = NULL;
+  BFT_MALLOC(pages, n_samples, void *);
+  BFT_MALLOC(expected, n_samples, int);
+  BFT_MALLOC(status, n_samples, int);
+
+  const cs_lnum_t n_numbered = _n_numbered_elts(numbering, n_elts);
+
+  for (size_t i = 0; i < n_samples; i++) {
+
+    uintptr_t page = p_start + (1 + i*step)*page_size;
+    cs_lnum_t elt_id = (page + page_size/2 - a_start) / elt_size;
+    int t_id = -1;
+
+    if (elt_id < n_numbered) {
+      const int n_groups = numbering->n_groups;
+      const cs_lnum_t *group_index = numbering->group_index;
+      for (int j = 0; j < numbering->n_threads && t_id < 0; j++) {
+        for (int g_id = 0; g_id < n_groups; g_id++) {
+          if (   elt_id >= group_index[(j*n_groups + g_id)*2]
+              && elt_id < group_index[(j*n_groups + g_id)*2 + 1]) {
+            t_id = _static_owner(numbering->n_threads, n_threads, j);
+            break;
+          }
+        }
+      }
+    }
+    else if (elt_id < n_elts)
+      t_id = _static_owner(n_elts - n_numbered, n_threads,
+                           elt_id - n_numbered);
+
+    pages[i] = (void *)page;
+    expected[i] = (t_id > -1) ? thread_node[t_id] : -1;
+    status[i] = -1;
+  }
+
+  if (syscall(SYS_move_pages, 0, n_samples, pages, NULL, status, 0) == 0) {
+    for (size_t i = 0; i < n_samples; i++) {
+      count->n_sampled += 1;
+      if (status[i] >= 0) {
+        count->n_present += 1;
+        if (status[i] == expected[i])
+          count->n_local += 1;
+      }
+    }
+  }
+
+  BFT_FREE(status);
+  BFT_FREE(expected);
+  BFT_FREE(pages);
+}
+
+/*----------------------------------------------------------------------------
+ * Return the size of anonymous memory backed by huge pages for the
+ * current process, in kB (or 0 if not available).
+ *----------------------------------------------------------------------------*/
+
+static unsigned long long
+_anon_huge_pages_kb(void)
+{
+  unsigned long long kb = 0;
+
+  FILE *f = fopen("/proc/self/smaps_rollup", "r");
+  if (f != NULL) {
+    char buf[128];
+    while (fgets(buf, sizeof(buf), f) != NULL) {
+      if (strncmp(buf, "AnonHugePages:", 14) == 0) {
+        kb = strtoull(buf + 14, NULL, 10);
+        break;
+      }
+    }
+    fclose(f);
+  }
+
+  return kb;
+}
+
+#endif /* defined(_HAVE_NUMA_QUERY) */
+
+/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set NUMA-related memory placement options.
+ *
+ * \param[in]  huge_pages     if true, advise the system to use (transparent)
+ *                            huge pages for large arrays
+ * \param[in]  placement_log  if true, log a memory placement report after
+ *                            field values are allocated
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_numa_set_options(bool  huge_pages,
+                    bool  placement_log)
+{
+  _huge_pages = huge_pages;
+  _placement_log = placement_log;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return the numbering associated with a base mesh location.
+ *
+ * \param[in]  location_id  mesh location id
+ *
+ * \return  pointer to associated numbering, or NULL if not available
+ */
+/*----------------------------------------------------------------------------*/
+
+const cs_numbering_t *
+cs_numa_location_numbering(int  location_id)
+{
+  const cs_mesh_t *m = cs_glob_mesh;
+
+  if (m == NULL)
+    return NULL;
+
+  /* Only base locations match the mesh numberings */
+
+  switch(location_id) {
+  case CS_MESH_LOCATION_CELLS:
+    return m->cell_numbering;
+  case CS_MESH_LOCATION_INTERIOR_FACES:
+    return m->i_face_numbering;
+  case CS_MESH_LOCATION_BOUNDARY_FACES:
+    return m->b_face_numbering;
+  case CS_MESH_LOCATION_VERTICES:
+    return m->vtx_numbering;
+  default:
+    break;
+  }
+
+  return NULL;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief First-touch (zero) an array based on the thread ranges of a given
+ *        numbering.
+ *
+ * Elements handled by a given thread in threaded loops using this numbering
+ * are touched by the same thread, so that on first-touch systems, the
+ * associated pages are placed on that thread's NUMA node. Elements not
+ * covered by the numbering (such as ghost cells), or all elements if the
+ * numbering is NULL or not threaded, are touched using a static thread
+ * partitioning, consistent with simple OpenMP loops.
+ *
+ * \param[in]       numbering  associated numbering, or NULL
+ * \param[in]       n_elts     number of elements
+ * \param[in]       elt_size   size of each element (in bytes)
+ * \param[in, out]  p          pointer to array
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_numa_first_touch(const cs_numbering_t  *numbering,
+                    cs_lnum_t              n_elts,
+                    size_t                 elt_size,
+                    void                  *p)
+{
+  if (p == NULL)
+    return;
+
+  _placed_copy(numbering, n_elts, elt_size, NULL, p);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Allocate an array placed based on the thread ranges of a given
+ *        numbering.
+ *
+ * This function should be called through the CS_NUMA_MALLOC macro.
+ * The returned array is zeroed, and may be freed using BFT_FREE.
+ *
+ * \param[in]  n_elts     number of elements
+ * \param[in]  elt_size   size of each element (in bytes)
+ * \param[in]  numbering  associated numbering, or NULL
+ * \param[in]  var_name   allocated variable name string
+ * \param[in]  file_name  name of calling source file
+ * \param[in]  line_num   line number in calling source file
+ *
+ * \return  pointer to allocated memory
+ */
+/*----------------------------------------------------------------------------*/
+
+void *
+cs_numa_malloc(cs_lnum_t              n_elts,
+               size_t                 elt_size,
+               const cs_numbering_t  *numbering,
+               const char            *var_name,
+               const char            *file_name,
+               int                    line_num)
+{
+  void *p = NULL;
+
+  if (n_elts < 1)
+    return NULL;
+
+  size_t size = (size_t)n_elts * elt_size;
+
+  if (_huge_pages && size >= _HUGE_PAGE_SIZE && bft_mem_have_memalign()) {
+
+    p = bft_mem_memalign(_HUGE_PAGE_SIZE, n_elts, elt_size,
+                         var_name, file_name, line_num);
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    size_t a_size = size & ~((size_t)_HUGE_PAGE_SIZE - 1);
+    if (a_size > 0)
+      madvise(p, a_size, MADV_HUGEPAGE);
+#endif
+
+  }
+  else
+    p = bft_mem_malloc(n_elts, elt_size, var_name, file_name, line_num);
+
+  _placed_copy(numbering, n_elts, elt_size, NULL, p);
+
+  return p;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Move an existing array to memory placed based on the thread ranges
+ *        of a given numbering.
+ *
+ * Values are copied in parallel, and the previous array is freed.
+ *
+ * \param[in]       numbering  associated numbering, or NULL
+ * \param[in]       n_elts     number of elements
+ * \param[in]       elt_size   size of each element (in bytes)
+ * \param[in, out]  p          pointer to array pointer
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_numa_place_array(const cs_numbering_t  *numbering,
+                    cs_lnum_t              n_elts,
+                    size_t                 elt_size,
+                    void                 **p)
+{
+  if (*p == NULL || n_elts < 1)
+    return;
+
+  void *_p_old = *p;
+  void *_p_new = cs_numa_malloc(n_elts, elt_size, numbering,
+                                "_p_new", __FILE__, __LINE__);
+
+  _placed_copy(numbering, n_elts, elt_size, _p_old, _p_new);
+
+  BFT_FREE(_p_old);
+
+  *p = _p_new;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Log a memory placement report for the main mesh and field arrays.
+ *
+ * For sampled pages of each array, the NUMA node on which the page resides
+ * is compared to that of the thread expected to operate on it.
+ * The report is logged only on the first call; this function does nothing
+ * if the report is disabled, and only logs a short message where the
+ * required system queries are not available.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_numa_log_placement(void)
+{
+  if (_placement_log == false)
+    return;
+
+  cs_log_printf(CS_LOG_PERFORMANCE,
+                _("\nMemory placement:\n\n"));
+
+  cs_log_printf(CS_LOG_PERFORMANCE,
+                _("  Huge pages advice:              %s\n"),
+                (_huge_pages) ? _("on") : _("off"));
+
+#if defined(_HAVE_NUMA_QUERY)
+
+  const cs_mesh_t *m = cs_glob_mesh;
+  const cs_mesh_quantities_t *mq = cs_glob_mesh_quantities;
+
+  int n_threads = 1;
+  int *thread_node = _thread_nodes(&n_threads);
+
+  /* Count distinct nodes used by threads */
+
+  int n_nodes = 0;
+  for (int i = 0; i < n_threads; i++) {
+    int j;
+    for (j = 0; j < i; j++) {
+      if (thread_node[j] == thread_node[i])
+        break;
+    }
+    if (j == i)
+      n_nodes++;
+  }
+
+  _placement_count_t count[3];
+  memset(count, 0, sizeof(count));
+
+  /* Mesh connectivity */
+
+  _sample_placement(m->i_face_numbering, m->n_i_faces, sizeof(cs_lnum_2_t),
+                    m->i_face_cells, n_threads, thread_node, count);
+  _sample_placement(m->b_face_numbering, m->n_b_faces, sizeof(cs_lnum_t),
+                    m->b_face_cells, n_threads, thread_node, count);
+
+  /* Mesh quantities */
+
+  if (mq != NULL) {
+    _sample_placement(m->cell_numbering, m->n_cells_with_ghosts,
+                      3*sizeof(cs_real_t), mq->cell_cen,
+                      n_threads, thread_node, count + 1);
+    _sample_placement(m->cell_numbering, m->n_cells_with_ghosts,
+                      sizeof(cs_real_t), mq->cell_vol,
+                      n_threads, thread_node, count + 1);
+    _sample_placement(m->i_face_numbering, m->n_i_faces,
+                      3*sizeof(cs_real_t), mq->i_face_normal,
+                      n_threads, thread_node, count + 1);
+    _sample_placement(m->i_face_numbering, m->n_i_faces,
+                      sizeof(cs_real_t), mq->weight,
+                      n_threads, thread_node, count + 1);
+    _sample_placement(m->b_face_numbering, m->n_b_faces,
+                      3*sizeof(cs_real_t), mq->b_face_normal,
+                      n_threads, thread_node, count + 1);
+  }
+
+  /* Field values */
+
+  const int n_fields = cs_field_n_fields();
+
+  for (int f_id = 0; f_id < n_fields; f_id++) {
+    const cs_field_t *f = cs_field_by_id(f_id);
+    if (f->is_owner == false || f->location_id == CS_MESH_LOCATION_NONE)
+      continue;
+    const cs_numbering_t *numbering
+      = cs_numa_location_numbering(f->location_id);
+    const cs_lnum_t *n_elts = cs_mesh_location_get_n_elts(f->location_id);
+    for (int i = 0; i < f->n_time_vals; i++)
+      _sample_placement(numbering, n_elts[2], f->dim*sizeof(cs_real_t),
+                        f->vals[i], n_threads, thread_node, count + 2);
+  }
+
+  BFT_FREE(thread_node);
+
+  /* Local fractions (per rank) */
+
+  double l_frac[3];
+  for (int i = 0; i < 3; i++) {
+    l_frac[i] = (count[i].n_present > 0) ?
+      (double)(count[i].n_local) / (double)(count[i].n_present) : 1.;
+  }
+
+  unsigned long long hp_kb = _anon_huge_pages_kb();
+  double hp_mb = hp_kb / 1024.;
+
+  cs_gnum_t g_count[9];
+  for (int i = 0; i < 3; i++) {
+    g_count[i*3]     = count[i].n_sampled;
+    g_count[i*3 + 1] = count[i].n_present;
+    g_count[i*3 + 2] = count[i].n_local;
+  }
+
+  cs_parall_counter(g_count, 9);
+  cs_parall_max(1, CS_INT_TYPE, &n_nodes);
+  cs_parall_min(3, CS_DOUBLE, l_frac);
+  cs_parall_sum(1, CS_DOUBLE, &hp_mb);
+
+  cs_log_printf(CS_LOG_PERFORMANCE,
+                _("  NUMA nodes used by threads:     %d\n"
+                  "  Anonymous huge pages:           %.3g MiB\n\n"),
+                n_nodes, hp_mb);
+
+  const char *category_name[] = {N_("mesh connectivity"),
+                                 N_("mesh quantities"),
+                                 N_("field values")};
+
+  cs_log_printf(CS_LOG_PERFORMANCE,
+                _("  Sampled pages on the NUMA node of the associated thread"
+                  " (local):\n\n"
+                  "                          sampled    present     local"
+                  "  min. rank\n"));
+
+  for (int i = 0; i < 3; i++) {
+
+    if (g_count[i*3] < 1)
+      continue;
+
+    double g_frac = (g_count[i*3 + 1] > 0) ?
+      100. * (double)(g_count[i*3 + 2]) / (double)(g_count[i*3 + 1]) : 100.;
+
+    cs_log_printf(CS_LOG_PERFORMANCE,
+                  "  %-20s %10llu %10llu %7.1f %%  %7.1f %%\n",
+                  _(category_name[i]),
+                  (unsigned long long)g_count[i*3],
+                  (unsigned long long)g_count[i*3 + 1],
+                  g_frac, 100.*l_frac[i]);
+  }
+
+#else
+
+  cs_log_printf(CS_LOG_PERFORMANCE,
+                _("  NUMA placement queries not available on this system.\n"));
+
+#endif /* defined(_HAVE_NUMA_QUERY) */
+
+  cs_log_printf(CS_LOG_PERFORMANCE, "\n");
+  cs_log_separator(CS_LOG_PERFORMANCE);
+
+  /* Report only once */
+
+  _placement_log = false;
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
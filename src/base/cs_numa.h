@@ -0,0 +1,191 @@
+#ifndef __CS_NUMA_H__
+#define __CS_NUMA_H__
+
+/*============================================================================
+ * NUMA-aware memory placement of large arrays.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+#include "cs_numbering.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*============================================================================
+ * Macro definitions
+ *============================================================================*/
+
+/*
+ * Allocate memory for _n_elts elements of _stride values of type _type,
+ * first touched (and zeroed) by the threads which will operate on them,
+ * based on the thread ranges of a given numbering.
+ *
+ * parameters:
+ *   _ptr       --> pointer to allocated memory.
+ *   _n_elts    <-- number of elements.
+ *   _stride    <-- number of values per element.
+ *   _type      <-- value type.
+ *   _numbering <-- associated numbering, or NULL
+ */
+
+#define CS_NUMA_MALLOC(_ptr, _n_elts, _stride, _type, _numbering) \
+_ptr = (_type *) cs_numa_malloc(_n_elts, (_stride)*sizeof(_type), \
+                                _numbering, \
+                                #_ptr, __FILE__, __LINE__)
+
+/*============================================================================
+ * Type definitions
+ *============================================================================*/
+
+/*=============================================================================
+ * Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set NUMA-related memory placement options.
+ *
+ * \param[in]  huge_pages     if true, advise the system to use (transparent)
+ *                            huge pages for large arrays
+ * \param[in]  placement_log  if true, log a memory placement report after
+ *                            field values are allocated
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_numa_set_options(bool  huge_pages,
+                    bool  placement_log);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return the numbering associated with a base mesh location.
+ *
+ * \param[in]  location_id  mesh location id
+ *
+ * \return  pointer to associated numbering, or NULL if not available
+ */
+/*----------------------------------------------------------------------------*/
+
+const cs_numbering_t *
+cs_numa_location_numbering(int  location_id);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief First-touch (zero) an array based on the thread ranges of a given
+ *        numbering.
+ *
+ * Elements handled by a given thread in threaded loops using this numbering
+ * are touched by the same thread, so that on first-touch systems, the
+ * associated pages are placed on that thread's NUMA node. Elements not
+ * covered by the numbering (such as ghost cells), or all elements if the
+ * numbering is NULL or not threaded, are touched using a static thread
+ * partitioning, consistent with simple OpenMP loops.
+ *
+ * \param[in]       numbering  associated numbering, or NULL
+ * \param[in]       n_elts     number of elements
+ * \param[in]       elt_size   size of each element (in bytes)
+ * \param[in, out]  p          pointer to array
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_numa_first_touch(const cs_numbering_t  *numbering,
+                    cs_lnum_t              n_elts,
+                    size_t                 elt_size,
+                    void                  *p);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Allocate an array placed based on the thread ranges of a given
+ *        numbering.
+ *
+ * This function should be called through the CS_NUMA_MALLOC macro.
+ * The returned array is zeroed, and may be freed using BFT_FREE.
+ *
+ * \param[in]  n_elts     number of elements
+ * \param[in]  elt_size   size of each element (in bytes)
+ * \param[in]  numbering  associated numbering, or NULL
+ * \param[in]  var_name   allocated variable name string
+ * \param[in]  file_name  name of calling source file
+ * \param[in]  line_num   line number in calling source file
+ *
+ * \return  pointer to allocated memory
+ */
+/*----------------------------------------------------------------------------*/
+
+void *
+cs_numa_malloc(cs_lnum_t              n_elts,
+               size_t                 elt_size,
+               const cs_numbering_t  *numbering,
+               const char            *var_name,
+               const char            *file_name,
+               int                    line_num);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Move an existing array to memory placed based on the thread ranges
+ *        of a given numbering.
+ *
+ * Values are copied in parallel, and the previous array is freed.
+ *
+ * \param[in]       numbering  associated numbering, or NULL
+ * \param[in]       n_elts     number of elements
+ * \param[in]       elt_size   size of each element (in bytes)
+ * \param[in, out]  p          pointer to array pointer
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_numa_place_array(const cs_numbering_t  *numbering,
+                    cs_lnum_t              n_elts,
+                    size_t                 elt_size,
+                    void                 **p);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Log a memory placement report for the main mesh and field arrays.
+ *
+ * For sampled pages of each array, the NUMA node on which the page resides
+ * is compared to that of the thread expected to operate on it.
+ * The report is logged only on the first call; this function does nothing
+ * if the report is disabled, and only logs a short message where the
+ * required system queries are not available.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_numa_log_placement(void);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_NUMA_H__ */
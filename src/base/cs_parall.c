@@ -141,6 +141,43 @@ typedef struct
   int     rank;
 } _mpi_double_int_t;
 
+/* Entry of a reduction batch */
+
+typedef struct {
+
+  cs_parall_op_t   op;         /* reduction operation */
+  int              n;          /* number of values */
+  cs_datatype_t    datatype;   /* associated datatype */
+  void            *val;        /* pointer to values */
+
+} _batch_entry_t;
+
+/* Batch of reductions; all values are packed in a single buffer of
+   doubles, with a 2-value header (number of values reduced using a
+   maximum, number of values reduced using a sum), followed by maximum
+   values (minima being negated) then sums, so that a single reduction
+   is required. */
+
+struct _cs_parall_batch_t {
+
+  int              n_entries;      /* number of registered entries */
+  int              n_entries_max;  /* allocated number of entries */
+  _batch_entry_t  *entries;        /* registered entries */
+
+  size_t           n_vals[2];      /* number of values using max and sum */
+
+  size_t           buf_size_max;   /* allocated buffer size */
+  double          *buf;            /* send and receive buffer */
+
+  bool             pending;        /* are reductions pending ? */
+
+#if defined(HAVE_MPI)
+  MPI_Datatype     mpi_type;       /* datatype for packed values */
+  MPI_Request      request;        /* associated request */
+#endif
+
+};
+
 /*============================================================================
  * Static global variables
  *============================================================================*/
@@ -151,8 +188,116 @@ typedef struct
 
 static size_t _cs_parall_min_coll_buf_size = 1024*1024*8;
 
+/* Reduction operator for batches */
+
+static MPI_Op  _batch_op = MPI_OP_NULL;
+
 #endif
 
+/*============================================================================
+ * Private function definitions
+ *============================================================================*/
+
+#if defined(HAVE_MPI)
+
+/*----------------------------------------------------------------------------
+ * Reduction function for packed batch values.
+ *
+ * parameters:
+ *   invec    <-- input vector
+ *   inoutvec <-> input-output vector
+ *   len      <-- number of packed batches
+ *   dtype    <-- MPI datatype (a contiguous set of packed values)
+ *----------------------------------------------------------------------------*/
+
+static void
+_batch_reduce(void          *invec,
+              void          *inoutvec,
+              int           *len,
+              MPI_Datatype  *dtype)
+{
+  CS_UNUSED(dtype);
+
+  const double *a = (const double *)invec;
+  double *b = (double *)inoutvec;
+
+  for (int i = 0; i < *len; i++) {
+
+    const size_t n_max = b[0];
+    const size_t n_sum = b[1];
+    const size_t n_tot = 2 + n_max + n_sum;
+
+    for (size_t j = 2; j < 2 + n_max; j++) {
+      if (a[j] > b[j])
+        b[j] = a[j];
+    }
+    for (size_t j = 2 + n_max; j < n_tot; j++)
+      b[j] += a[j];
+
+    a += n_tot;
+    b += n_tot;
+  }
+}
+
+#endif /* defined(HAVE_MPI) */
+
+/*----------------------------------------------------------------------------
+ * Pack or unpack values of a batch entry.
+ *
+ * parameters:
+ *   e      <-- pointer to batch entry
+ *   unpack <-- true for unpacking, false for packing
+ *   buf    <-> pointer to matching values in packed buffer
+ *----------------------------------------------------------------------------*/
+
+static void
+_batch_entry_copy(const _batch_entry_t  *e,
+                  bool                   unpack,
+                  double                 buf[])
+{
+  const double s = (e->op == CS_PARALL_MIN) ? -1. : 1.;
+
+#undef _BATCH_COPY
+#define _BATCH_COPY(_type) { \
+    _type *v = (_type *)(e->val); \
+    if (unpack) { \
+      for (int i = 0; i < e->n; i++) \
+        v[i] = (_type)(buf[i]*s); \
+    } \
+    else { \
+      for (int i = 0; i < e->n; i++) \
+        buf[i] = (double)(v[i])*s; \
+    } \
+  }
+
+  switch(e->datatype) {
+  case CS_FLOAT:
+    _BATCH_COPY(float);
+    break;
+  case CS_DOUBLE:
+    _BATCH_COPY(double);
+    break;
+  case CS_INT32:
+    _BATCH_COPY(int32_t);
+    break;
+  case CS_INT64:
+    _BATCH_COPY(int64_t);
+    break;
+  case CS_UINT32:
+    _BATCH_COPY(uint32_t);
+    break;
+  case CS_UINT64:
+    _BATCH_COPY(uint64_t);
+    break;
+  default:
+    bft_error(__FILE__, __LINE__, 0,
+              _("%s: datatype %s not handled."),
+              __func__, cs_datatype_name[e->datatype]);
+  }
+
+#undef _BATCH_COPY
+}
+
 /*============================================================================
  * Prototypes for functions intended for use only by Fortran wrappers.
  * (descriptions follow, with function bodies).
@@ -925,6 +1070,265 @@ cs_parall_set_min_coll_buf_size(size_t buffer_size)
 #endif
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Create a batch of reductions on the default communicator.
+ *
+ * Multiple minimum, maximum, and sum reductions may be registered in
+ * a batch, and are then handled using a single non-blocking collective
+ * operation, so that the associated synchronization may be overlapped
+ * with other operations.
+ *
+ * All values are reduced using double-precision values, so integer
+ * values are only handled exactly up to 2^53.
+ *
+ * \return  pointer to new reduction batch
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_parall_batch_t *
+cs_parall_batch_create(void)
+{
+  cs_parall_batch_t *b;
+
+  BFT_MALLOC(b, 1, cs_parall_batch_t);
+
+  b->n_entries = 0;
+  b->n_entries_max = 0;
+  b->entries = NULL;
+
+  b->n_vals[0] = 0;
+  b->n_vals[1] = 0;
+
+  b->buf_size_max = 0;
+  b->buf = NULL;
+
+  b->pending = false;
+
+#if defined(HAVE_MPI)
+  b->mpi_type = MPI_DATATYPE_NULL;
+  b->request = MPI_REQUEST_NULL;
+#endif
+
+  return b;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Destroy a batch of reductions.
+ *
+ * If reductions are pending, they are completed first.
+ *
+ * \param[in, out]  batch  pointer to reduction batch pointer
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_parall_batch_destroy(cs_parall_batch_t  **batch)
+{
+  if (batch == NULL)
+    return;
+
+  cs_parall_batch_t *b = *batch;
+
+  if (b != NULL) {
+    if (b->pending)
+      cs_parall_batch_wait(b);
+    BFT_FREE(b->buf);
+    BFT_FREE(b->entries);
+    BFT_FREE(*batch);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Register values to reduce in a batch of reductions.
+ *
+ * The values array must remain available until the matching call
+ * to \ref cs_parall_batch_wait.
+ *
+ * \param[in, out]  batch     pointer to reduction batch
+ * \param[in]       op        reduction operation
+ * \param[in]       n         number of values
+ * \param[in]       datatype  matching Code_Saturne datatype
+ * \param[in, out]  val       local values in, global values out
+ *                            (after \ref cs_parall_batch_wait) (size: n)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_parall_batch_add(cs_parall_batch_t  *batch,
+                    cs_parall_op_t      op,
+                    int                 n,
+                    cs_datatype_t       datatype,
+                    void               *val)
+{
+  cs_parall_batch_t *b = batch;
+
+  if (b->pending)
+    bft_error(__FILE__, __LINE__, 0,
+              _("%s: values may not be added to a batch with pending\n"
+                "reductions."), __func__);
+
+  if (n < 1)
+    return;
+
+  if (b->n_entries >= b->n_entries_max) {
+    b->n_entries_max = CS_MAX(b->n_entries_max*2, 8);
+    BFT_REALLOC(b->entries, b->n_entries_max, _batch_entry_t);
+  }
+
+  _batch_entry_t *e = b->entries + b->n_entries;
+
+  e->op = op;
+  e->n = n;
+  e->datatype = datatype;
+  e->val = val;
+
+  b->n_entries += 1;
+
+  if (op == CS_PARALL_SUM)
+    b->n_vals[1] += n;
+  else
+    b->n_vals[0] += n;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Start all reductions registered in a batch.
+ *
+ * \param[in, out]  batch  pointer to reduction batch
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_parall_batch_start(cs_parall_batch_t  *batch)
+{
+  cs_parall_batch_t *b = batch;
+
+  if (b->pending)
+    cs_parall_batch_wait(b);
+
+  b->pending = true;
+
+#if defined(HAVE_MPI)
+
+  if (cs_glob_n_ranks < 2 || b->n_entries == 0)
+    return;
+
+  /* Pack values */
+
+  const size_t n_tot = 2 + b->n_vals[0] + b->n_vals[1];
+
+  if (b->buf_size_max < n_tot*2) {
+    b->buf_size_max = n_tot*2;
+    BFT_REALLOC(b->buf, b->buf_size_max, double);
+  }
+
+  double *buf = b->buf;
+
+  buf[0] = b->n_vals[0];
+  buf[1] = b->n_vals[1];
+
+  size_t shift[2] = {2, 2 + b->n_vals[0]};
+
+  for (int i = 0; i < b->n_entries; i++) {
+    const _batch_entry_t *e = b->entries + i;
+    const int j = (e->op == CS_PARALL_SUM) ? 1 : 0;
+    _batch_entry_copy(e, false, buf + shift[j]);
+    shift[j] += e->n;
+  }
+
+  /* Start reduction */
+
+  if (_batch_op == MPI_OP_NULL)
+    MPI_Op_create(_batch_reduce, 1, &_batch_op);
+
+  MPI_Type_contiguous(n_tot, MPI_DOUBLE, &(b->mpi_type));
+  MPI_Type_commit(&(b->mpi_type));
+
+#if MPI_VERSION >= 3
+  MPI_Iallreduce(buf, buf + n_tot, 1, b->mpi_type, _batch_op,
+                 cs_glob_mpi_comm, &(b->request));
+#else
+  MPI_Allreduce(buf, buf + n_tot, 1, b->mpi_type, _batch_op,
+                cs_glob_mpi_comm);
+#endif
+
+#endif /* defined(HAVE_MPI) */
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Complete all reductions registered in a batch.
+ *
+ * Global values are copied to the registered arrays, and the batch
+ * is emptied so that it may be reused.
+ *
+ * \param[in, out]  batch  pointer to reduction batch
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_parall_batch_wait(cs_parall_batch_t  *batch)
+{
+  cs_parall_batch_t *b = batch;
+
+  if (b->pending == false)
+    return;
+
+#if defined(HAVE_MPI)
+
+  if (b->mpi_type != MPI_DATATYPE_NULL) {
+
+#if MPI_VERSION >= 3
+    MPI_Wait(&(b->request), MPI_STATUS_IGNORE);
+#endif
+
+    MPI_Type_free(&(b->mpi_type));
+
+    /* Unpack values */
+
+    const size_t n_tot = 2 + b->n_vals[0] + b->n_vals[1];
+    double *buf = b->buf + n_tot;
+
+    size_t shift[2] = {2, 2 + b->n_vals[0]};
+
+    for (int i = 0; i < b->n_entries; i++) {
+      const _batch_entry_t *e = b->entries + i;
+      const int j = (e->op == CS_PARALL_SUM) ? 1 : 0;
+      _batch_entry_copy(e, true, buf + shift[j]);
+      shift[j] += e->n;
+    }
+
+  }
+
+#endif /* defined(HAVE_MPI) */
+
+  b->n_entries = 0;
+  b->n_vals[0] = 0;
+  b->n_vals[1] = 0;
+
+  b->pending = false;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Query whether reductions of a batch have been started but
+ *        not completed.
+ *
+ * \param[in]  batch  pointer to reduction batch
+ *
+ * \return  true if reductions are pending, false otherwise
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_parall_batch_is_pending(const cs_parall_batch_t  *batch)
+{
+  return batch->pending;
+}
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -37,6 +37,24 @@
 
 BEGIN_C_DECLS
 
+/*============================================================================
+ * Type definitions
+ *============================================================================*/
+
+/* Reduction operation types */
+
+typedef enum {
+
+  CS_PARALL_MIN,         /* minimum */
+  CS_PARALL_MAX,         /* maximum */
+  CS_PARALL_SUM          /* sum */
+
+} cs_parall_op_t;
+
+/* Opaque batch of reductions */
+
+typedef struct _cs_parall_batch_t  cs_parall_batch_t;
+
 /*=============================================================================
  * Public function prototypes
  *============================================================================*/
@@ -339,6 +357,86 @@ cs_parall_get_min_coll_buf_size(void);
 void
 cs_parall_set_min_coll_buf_size(size_t buffer_size);
 
+/*----------------------------------------------------------------------------
+ * Create a batch of reductions on the default communicator.
+ *
+ * returns:
+ *   pointer to new reduction batch
+ *----------------------------------------------------------------------------*/
+
+cs_parall_batch_t *
+cs_parall_batch_create(void);
+
+/*----------------------------------------------------------------------------
+ * Destroy a batch of reductions.
+ *
+ * If reductions are pending, they are completed first.
+ *
+ * parameters:
+ *   batch <-> pointer to reduction batch pointer
+ *----------------------------------------------------------------------------*/
+
+void
+cs_parall_batch_destroy(cs_parall_batch_t  **batch);
+
+/*----------------------------------------------------------------------------
+ * Register values to reduce in a batch of reductions.
+ *
+ * The values array must remain available until the matching call
+ * to cs_parall_batch_wait.
+ *
+ * parameters:
+ *   batch    <-> pointer to reduction batch
+ *   op       <-- reduction operation
+ *   n        <-- number of values
+ *   datatype <-- matching Code_Saturne datatype
+ *   val      <-> local values in, global values out
+ *                (after cs_parall_batch_wait) (size: n)
+ *----------------------------------------------------------------------------*/
+
+void
+cs_parall_batch_add(cs_parall_batch_t  *batch,
+                    cs_parall_op_t      op,
+                    int                 n,
+                    cs_datatype_t       datatype,
+                    void               *val);
+
+/*----------------------------------------------------------------------------
+ * Start all reductions registered in a batch.
+ *
+ * parameters:
+ *   batch <-> pointer to reduction batch
+ *----------------------------------------------------------------------------*/
+
+void
+cs_parall_batch_start(cs_parall_batch_t  *batch);
+
+/*----------------------------------------------------------------------------
+ * Complete all reductions registered in a batch.
+ *
+ * Global values are copied to the registered arrays, and the batch
+ * is emptied so that it may be reused.
+ *
+ * parameters:
+ *   batch <-> pointer to reduction batch
+ *----------------------------------------------------------------------------*/
+
+void
+cs_parall_batch_wait(cs_parall_batch_t  *batch);
+
+/*----------------------------------------------------------------------------
+ * Query whether reductions of a batch have been started but not completed.
+ *
+ * parameters:
+ *   batch <-- pointer to reduction batch
+ *
+ * returns:
+ *   true if reductions are pending, false otherwise
+ *----------------------------------------------------------------------------*/
+
+bool
+cs_parall_batch_is_pending(const cs_parall_batch_t  *batch);
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
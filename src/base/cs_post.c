@@ -58,6 +58,7 @@
 #include "cs_mesh_connect.h"
 #include "cs_mesh_location.h"
 #include "cs_parall.h"
+#include "cs_post_util.h"
 #include "cs_prototypes.h"
 #include "cs_selector.h"
 #include "cs_timer.h"
@@ -1161,8 +1162,10 @@ _predefine_mesh(int        mesh_id,
       BFT_FREE(post_mesh->writer_id);
 
       post_mesh->exp_mesh = NULL;
-      if (post_mesh->_exp_mesh != NULL)
+      if (post_mesh->_exp_mesh != NULL) {
+        fvm_writer_mesh_cache_remove(post_mesh->_exp_mesh);
         post_mesh->_exp_mesh = fvm_nodal_destroy(post_mesh->_exp_mesh);
+      }
 
       break;
 
@@ -1271,8 +1274,10 @@ _free_mesh(int _mesh_id)
   int i;
   cs_post_mesh_t  *post_mesh = _cs_post_meshes + _mesh_id;
 
-  if (post_mesh->_exp_mesh != NULL)
+  if (post_mesh->_exp_mesh != NULL) {
+    fvm_writer_mesh_cache_remove(post_mesh->_exp_mesh);
     post_mesh->_exp_mesh = fvm_nodal_destroy(post_mesh->_exp_mesh);
+  }
 
   BFT_FREE(post_mesh->writer_id);
   post_mesh->n_writers = 0;
@@ -1838,6 +1843,11 @@ _define_mesh(cs_post_mesh_t        *post_mesh,
 
   else
     _define_regular_mesh(post_mesh);
+
+  /* Allow writers to keep work data for this mesh across outputs */
+
+  if (post_mesh->_exp_mesh != NULL)
+    fvm_writer_mesh_cache_add(post_mesh->_exp_mesh);
 }
 
 /*----------------------------------------------------------------------------
@@ -1859,8 +1869,10 @@ _redefine_mesh(cs_post_mesh_t        *post_mesh,
   if (post_mesh->exp_mesh != NULL) {
     if (post_mesh->_exp_mesh == NULL)
       return;
-    else
+    else {
+      fvm_writer_mesh_cache_remove(post_mesh->_exp_mesh);
       post_mesh->_exp_mesh = fvm_nodal_destroy(post_mesh->_exp_mesh);
+    }
   }
   post_mesh->exp_mesh = NULL;
 
@@ -3030,8 +3042,8 @@ _cs_post_output_fields(cs_post_mesh_t        *post_mesh,
                                NULL,
                                NULL,
                                NULL);
-    if (pset_on_boundary == false && cs_probe_set_get_interpolation(pset) == 1)
-      pset_interpolation = 1;
+    if (pset_on_boundary == false)
+      pset_interpolation = cs_probe_set_get_interpolation(pset);
   }
 
   /* Base output for cell and boundary meshes */
@@ -3075,6 +3087,9 @@ _cs_post_output_fields(cs_post_mesh_t        *post_mesh,
         if (   field_loc_type == CS_MESH_LOCATION_CELLS
             && pset_interpolation == 1)
           interpolate_func = cs_interpolate_from_location_p1;
+        else if (   field_loc_type == CS_MESH_LOCATION_CELLS
+                 && pset_interpolation == 2)
+          interpolate_func = cs_cell_aggregation_interpolate;
 
         cs_post_write_probe_values(post_mesh->id,
                                    CS_POST_WRITER_ALL_ASSOCIATED,
@@ -3169,6 +3184,9 @@ _cs_post_output_fields(cs_post_mesh_t        *post_mesh,
       if (   field_loc_type == CS_MESH_LOCATION_CELLS
           && pset_interpolation == 1)
         interpolate_func = cs_interpolate_from_location_p1;
+      else if (   field_loc_type == CS_MESH_LOCATION_CELLS
+               && pset_interpolation == 2)
+        interpolate_func = cs_cell_aggregation_interpolate;
 
       char interpolate_input[96];
       strncpy(interpolate_input, f->name, 95); interpolate_input[95] = '\0';
@@ -3263,8 +3281,13 @@ _cs_post_output_attached_fields(cs_post_mesh_t        *post_mesh,
                                NULL,
                                NULL,
                                NULL);
-    if (pset_on_boundary == false && cs_probe_set_get_interpolation(pset) == 1)
-      interpolate_func = cs_interpolate_from_location_p1;
+    if (pset_on_boundary == false) {
+      int pset_interpolation = cs_probe_set_get_interpolation(pset);
+      if (pset_interpolation == 1)
+        interpolate_func = cs_interpolate_from_location_p1;
+      else if (pset_interpolation == 2)
+        interpolate_func = cs_cell_aggregation_interpolate;
+    }
   }
 
   for (int i = 0; i < post_mesh->n_a_fields; i++) {
@@ -3301,10 +3324,15 @@ _cs_post_output_attached_fields(cs_post_mesh_t        *post_mesh,
         f_dim = 1;
         f_val = _val;
         name = name_buf;
-        _interpolate_func = cs_interpolate_from_location_p0;
+        if (_interpolate_func == cs_interpolate_from_location_p1)
+          _interpolate_func = cs_interpolate_from_location_p0;
       }
     }
 
+    if (   field_loc_type != CS_MESH_LOCATION_CELLS
+        && _interpolate_func == cs_cell_aggregation_interpolate)
+      _interpolate_func = cs_interpolate_from_location_p0;
+
     /* Volume or surface mesh */
 
     if (_cs_post_match_post_write_var(post_mesh, field_loc_type)) {
@@ -6313,6 +6341,60 @@ cs_post_renum_faces(const cs_lnum_t  init_i_face_num[],
   }
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Rebuild post-processing meshes after the computational mesh
+ *        has been redistributed among ranks.
+ *
+ * Meshes defined using selection criteria or functions are redefined
+ * based on the new local mesh; as their global numbering is based on
+ * that of the computational mesh, which is unchanged by redistribution,
+ * output remains consistent with previously written meshes, including
+ * for writers with a fixed mesh.
+ *
+ * Meshes defined from existing (external) exportable meshes and edges
+ * meshes (which are standalone copies) are left unchanged.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_post_rebuild_meshes(void)
+{
+  const cs_time_step_t  *ts = cs_glob_time_step;
+
+  /* Regular meshes first, as probe meshes may depend on them */
+
+  for (int pass = 0; pass < 2; pass++) {
+
+    for (int i = 0; i < _cs_post_n_meshes; i++) {
+
+      cs_post_mesh_t  *post_mesh = _cs_post_meshes + i;
+
+      bool is_dependent = (   post_mesh->ent_flag[3] != 0
+                           || post_mesh->ent_flag[4] != 0);
+
+      if (   post_mesh->exp_mesh == NULL
+          || post_mesh->_exp_mesh == NULL
+          || post_mesh->edges_ref > -1
+          || is_dependent != (pass == 1))
+        continue;
+
+      _redefine_mesh(post_mesh, ts);
+
+      if (post_mesh->exp_mesh == NULL)
+        continue;
+
+      for (int j = 0; j < post_mesh->n_writers; j++) {
+        cs_post_writer_t  *writer = _cs_post_writers + post_mesh->writer_id[j];
+        if (writer->writer != NULL)
+          _divide_poly(post_mesh, writer);
+      }
+
+    }
+
+  }
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Configure the post-processing output so that mesh connectivity
@@ -6943,6 +7025,7 @@ cs_post_time_step_end(void)
       if (   post_mesh->ent_flag[3]
           || post_mesh->mod_flag_min == FVM_WRITER_TRANSIENT_CONNECT) {
         post_mesh->exp_mesh = NULL;
+        fvm_writer_mesh_cache_remove(post_mesh->_exp_mesh);
         post_mesh->_exp_mesh = fvm_nodal_destroy(post_mesh->_exp_mesh);
       }
     }
@@ -7042,6 +7125,10 @@ cs_post_finalize(void)
 
   BFT_FREE(_cs_post_meshes);
 
+  cs_cell_aggregation_finalize();
+
+  fvm_writer_mesh_cache_remove(NULL);
+
   _cs_post_min_mesh_id = _MIN_RESERVED_MESH_ID;
   _cs_post_n_meshes = 0;
   _cs_post_n_meshes_max = 0;
@@ -1192,6 +1192,25 @@ void
 cs_post_renum_faces(const cs_lnum_t  init_i_face_num[],
                     const cs_lnum_t  init_b_face_num[]);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Rebuild post-processing meshes after the computational mesh
+ *        has been redistributed among ranks.
+ *
+ * Meshes defined using selection criteria or functions are redefined
+ * based on the new local mesh; as their global numbering is based on
+ * that of the computational mesh, which is unchanged by redistribution,
+ * output remains consistent with previously written meshes, including
+ * for writers with a fixed mesh.
+ *
+ * Meshes defined from existing (external) exportable meshes and edges
+ * meshes (which are standalone copies) are left unchanged.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_post_rebuild_meshes(void);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Configure the post-processing output so that mesh connectivity
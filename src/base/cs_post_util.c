@@ -53,10 +53,13 @@
 #include "cs_gradient.h"
 #include "cs_gradient.h"
 #include "cs_gradient_perio.h"
+#include "cs_grid.h"
 #include "cs_join.h"
 #include "cs_halo.h"
 #include "cs_halo_perio.h"
+#include "cs_interpolate.h"
 #include "cs_math.h"
+#include "cs_matrix.h"
 #include "cs_matrix_default.h"
 #include "cs_mesh.h"
 #include "cs_mesh_coherency.h"
@@ -94,6 +97,20 @@ BEGIN_C_DECLS
  * Local structure definitions
  *============================================================================*/
 
+/* Cell aggregation used for sub-sampled output */
+
+typedef struct {
+
+  int         n_cells_per_aggr;  /* Target number of cells per aggregate */
+  cs_lnum_t   n_cells;           /* Number of cells when built */
+  cs_lnum_t   n_aggr;            /* Local number of aggregates */
+
+  cs_lnum_t  *c_aggr_id;         /* Aggregate id of each cell */
+  cs_lnum_t  *a_cell_id;         /* Probe cell id of each aggregate */
+  cs_real_t  *a_vol;             /* Volume of each aggregate */
+
+} _cell_aggregation_t;
+
 /*============================================================================
  * Static global variables
  *============================================================================*/
@@ -103,10 +120,202 @@ BEGIN_C_DECLS
 int cs_glob_post_util_flag[CS_POST_UTIL_N_TYPES]
   = {-1, -1};
 
+/* Cell aggregations associated with probe sets */
+
+static int                   _n_cell_aggregations = 0;
+static _cell_aggregation_t  *_cell_aggregations = NULL;
+
 /*============================================================================
  * Private function definitions
  *============================================================================*/
 
+/*----------------------------------------------------------------------------
+ * Aggregate cells using the multigrid coarsening algorithm.
+ *
+ * A Laplacian-type matrix based on the mesh geometry is used to build the
+ * coarsening criteria. Successive coarsening steps are applied until
+ * the global mean number of cells per aggregate reaches the given
+ * target, or no further coarsening is possible. Aggregates do not
+ * cross rank boundaries.
+ *
+ * parameters:
+ *   n_cells_per_aggr <-- target mean number of cells per aggregate
+ *   c_aggr_id        --> aggregate id of each cell (size: n_cells)
+ *
+ * returns:
+ *   local number of aggregates
+ *----------------------------------------------------------------------------*/
+
+static cs_lnum_t
+_cell_aggregation(int        n_cells_per_aggr,
+                  cs_lnum_t  c_aggr_id[])
+{
+  const int max_levels = 25;
+
+  const cs_mesh_t *m = cs_glob_mesh;
+  const cs_mesh_quantities_t *mq = cs_glob_mesh_quantities;
+
+  const cs_lnum_t n_cells = m->n_cells;
+  const cs_lnum_t n_cells_ext = m->n_cells_with_ghosts;
+  const cs_lnum_t n_i_faces = m->n_i_faces;
+  const cs_lnum_2_t *i_face_cells = (const cs_lnum_2_t *)(m->i_face_cells);
+
+  /* Laplacian-type coefficients, used only for coarsening criteria */
+
+  cs_real_t *da, *xa;
+  BFT_MALLOC(da, n_cells_ext, cs_real_t);
+  BFT_MALLOC(xa, n_i_faces, cs_real_t);
+
+  for (cs_lnum_t i = 0; i < n_cells_ext; i++)
+    da[i] = 0.;
+
+  for (cs_lnum_t f_id = 0; f_id < n_i_faces; f_id++) {
+    xa[f_id] = - mq->i_face_surf[f_id] / mq->i_dist[f_id];
+    da[i_face_cells[f_id][0]] -= xa[f_id];
+    da[i_face_cells[f_id][1]] -= xa[f_id];
+  }
+
+  if (m->halo != NULL)
+    cs_halo_sync_var(m->halo, CS_HALO_STANDARD, da);
+
+  cs_matrix_structure_t *ms
+    = cs_matrix_structure_create(CS_MATRIX_NATIVE,
+                                 true,
+                                 n_cells,
+                                 n_cells_ext,
+                                 n_i_faces,
+                                 i_face_cells,
+                                 m->halo,
+                                 NULL);
+  cs_matrix_t *a = cs_matrix_create(ms);
+
+  cs_matrix_set_coefficients(a, true, NULL, NULL,
+                             n_i_faces, i_face_cells, da, xa);
+
+  /* Build grid hierarchy */
+
+  int n_levels = 1;
+  cs_grid_t *grid[25];
+
+  grid[0] = cs_grid_create_from_shared(n_i_faces,
+                                       NULL,
+                                       NULL,
+                                       i_face_cells,
+                                       mq->cell_cen,
+                                       mq->cell_vol,
+                                       mq->i_face_normal,
+                                       a,
+                                       NULL,
+                                       NULL);
+
+  while (n_levels < max_levels) {
+
+    cs_gnum_t n_g_rows = cs_grid_get_n_g_rows(grid[n_levels-1]);
+
+    if (n_g_rows * n_cells_per_aggr <= m->n_g_cells)
+      break;
+
+    cs_grid_t *c = cs_grid_coarsen(grid[n_levels-1],
+                                   CS_GRID_COARSENING_DEFAULT,
+                                   3,     /* aggregation limit */
+                                   0,     /* verbosity */
+                                   1,     /* merge stride (no merging) */
+                                   0,
+                                   0,
+                                   0.);   /* relaxation parameter */
+
+    if (cs_grid_get_n_g_rows(c) >= n_g_rows) {
+      cs_grid_destroy(&c);
+      break;
+    }
+
+    grid[n_levels++] = c;
+
+  }
+
+  /* Project aggregate ids to cells */
+
+  const cs_grid_t *g = grid[n_levels-1];
+  const cs_lnum_t n_aggr = cs_grid_get_n_rows(g);
+
+  cs_real_t *a_id_r, *c_id_r;
+  BFT_MALLOC(a_id_r, n_aggr, cs_real_t);
+  BFT_MALLOC(c_id_r, n_cells, cs_real_t);
+
+  for (cs_lnum_t i = 0; i < n_aggr; i++)
+    a_id_r[i] = i;
+
+  cs_grid_project_var(g, n_cells, a_id_r, c_id_r);
+
+  for (cs_lnum_t i = 0; i < n_cells; i++)
+    c_aggr_id[i] = (cs_lnum_t)(c_id_r[i] + 0.5);
+
+  BFT_FREE(c_id_r);
+  BFT_FREE(a_id_r);
+
+  /* Free grids and matrix */
+
+  for (int i = n_levels - 1; i > -1; i--)
+    cs_grid_destroy(grid + i);
+
+  cs_matrix_destroy(&a);
+  cs_matrix_structure_destroy(&ms);
+
+  BFT_FREE(xa);
+  BFT_FREE(da);
+
+  return n_aggr;
+}
+
+/*----------------------------------------------------------------------------
+ * Keep a cell aggregation for later averaging of probe values.
+ *
+ * An aggregation previously kept for the same target size is replaced.
+ * Ownership of the given arrays is transferred.
+ *
+ * parameters:
+ *   n_cells_per_aggr <-- target mean number of cells per aggregate
+ *   n_aggr           <-- local number of aggregates
+ *   c_aggr_id        <-- aggregate id of each cell
+ *   a_cell_id        <-- probe cell id of each aggregate
+ *   a_vol            <-- volume of each aggregate
+ *----------------------------------------------------------------------------*/
+
+static void
+_cell_aggregation_keep(int         n_cells_per_aggr,
+                       cs_lnum_t   n_aggr,
+                       cs_lnum_t  *c_aggr_id,
+                       cs_lnum_t  *a_cell_id,
+                       cs_real_t  *a_vol)
+{
+  int a_i = 0;
+
+  while (   a_i < _n_cell_aggregations
+         && _cell_aggregations[a_i].n_cells_per_aggr != n_cells_per_aggr)
+    a_i++;
+
+  if (a_i < _n_cell_aggregations) {
+    _cell_aggregation_t *ca = _cell_aggregations + a_i;
+    BFT_FREE(ca->c_aggr_id);
+    BFT_FREE(ca->a_cell_id);
+    BFT_FREE(ca->a_vol);
+  }
+  else {
+    BFT_REALLOC(_cell_aggregations, _n_cell_aggregations + 1,
+                _cell_aggregation_t);
+    _n_cell_aggregations += 1;
+  }
+
+  _cell_aggregation_t *ca = _cell_aggregations + a_i;
+
+  ca->n_cells_per_aggr = n_cells_per_aggr;
+  ca->n_cells = cs_glob_mesh->n_cells;
+  ca->n_aggr = n_aggr;
+  ca->c_aggr_id = c_aggr_id;
+  ca->a_cell_id = a_cell_id;
+  ca->a_vol = a_vol;
+}
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*============================================================================
@@ -729,6 +938,262 @@ cs_b_face_criterion_probes_define(void          *input,
   *s = _s;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Define probes based on a coarse representation of the mesh
+ *        obtained by cell aggregation.
+ *
+ * Cells are aggregated using the multigrid coarsening algorithm
+ * (see \ref cs_grid_coarsen), and one probe is defined per aggregate,
+ * at the center of the cell closest to the aggregate's center of gravity.
+ * Values output on the associated probe set are thus a point sub-sampling
+ * of the volume fields, which may be used for lightweight visualization.
+ *
+ * The aggregation is kept, so that if the probe set's "interpolation"
+ * option is set to 2, output values are averaged over each aggregate
+ * (see \ref cs_cell_aggregation_interpolate). The aggregated (coarse)
+ * mesh itself is not available for output.
+ *
+ * Here, the input points to an integer defining the target mean number
+ * of cells per aggregate (8 if NULL).
+ *
+ * \param[in]   input   pointer to target number of cells per probe
+ * \param[out]  n_elts  number of selected coordinates
+ * \param[out]  coords  coordinates of selected elements.
+ * \param[out]  s       curvilinear coordinates of selected elements
+ *                      (global aggregate number)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_cell_aggregation_probes_define(void          *input,
+                                  cs_lnum_t     *n_elts,
+                                  cs_real_3_t  **coords,
+                                  cs_real_t    **s)
+{
+  const int n_cells_per_aggr = (input != NULL) ? *((const int *)input) : 8;
+
+  const cs_mesh_t *m = cs_glob_mesh;
+  const cs_real_3_t *cell_cen
+    = (const cs_real_3_t *)(cs_glob_mesh_quantities->cell_cen);
+  const cs_real_t *cell_vol = cs_glob_mesh_quantities->cell_vol;
+
+  cs_lnum_t *c_aggr_id;
+  BFT_MALLOC(c_aggr_id, m->n_cells, cs_lnum_t);
+
+  const cs_lnum_t n_aggr = _cell_aggregation(CS_MAX(n_cells_per_aggr, 1),
+                                             c_aggr_id);
+
+  /* Aggregate centers of gravity */
+
+  cs_real_4_t *a_cog;
+  BFT_MALLOC(a_cog, n_aggr, cs_real_4_t);
+
+  for (cs_lnum_t i = 0; i < n_aggr; i++) {
+    for (int k = 0; k < 4; k++)
+      a_cog[i][k] = 0.;
+  }
+
+  for (cs_lnum_t c_id = 0; c_id < m->n_cells; c_id++) {
+    cs_lnum_t a_id = c_aggr_id[c_id];
+    for (int k = 0; k < 3; k++)
+      a_cog[a_id][k] += cell_vol[c_id]*cell_cen[c_id][k];
+    a_cog[a_id][3] += cell_vol[c_id];
+  }
+
+  cs_real_t *a_vol;
+  BFT_MALLOC(a_vol, n_aggr, cs_real_t);
+
+  for (cs_lnum_t i = 0; i < n_aggr; i++) {
+    for (int k = 0; k < 3; k++)
+      a_cog[i][k] /= a_cog[i][3];
+    a_vol[i] = a_cog[i][3];
+    a_cog[i][3] = HUGE_VAL;
+  }
+
+  /* Select cell closest to each aggregate's center */
+
+  cs_lnum_t *a_cell_id;
+  BFT_MALLOC(a_cell_id, n_aggr, cs_lnum_t);
+
+  for (cs_lnum_t c_id = 0; c_id < m->n_cells; c_id++) {
+    cs_lnum_t a_id = c_aggr_id[c_id];
+    cs_real_t d2 = cs_math_3_square_distance(a_cog[a_id], cell_cen[c_id]);
+    if (d2 < a_cog[a_id][3]) {
+      a_cog[a_id][3] = d2;
+      a_cell_id[a_id] = c_id;
+    }
+  }
+
+  BFT_FREE(a_cog);
+
+  /* Global aggregate numbering */
+
+  cs_gnum_t a_shift = 0;
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1) {
+    cs_gnum_t _n_aggr = n_aggr;
+    MPI_Scan(&_n_aggr, &a_shift, 1, CS_MPI_GNUM, MPI_SUM, cs_glob_mpi_comm);
+    a_shift -= _n_aggr;
+  }
+#endif
+
+  cs_real_3_t *_coords;
+  cs_real_t *_s;
+  BFT_MALLOC(_coords, n_aggr, cs_real_3_t);
+  BFT_MALLOC(_s, n_aggr, cs_real_t);
+
+  for (cs_lnum_t i = 0; i < n_aggr; i++) {
+    for (int k = 0; k < 3; k++)
+      _coords[i][k] = cell_cen[a_cell_id[i]][k];
+    _s[i] = a_shift + i + 1;
+  }
+
+  /* Keep aggregation for averaging of output values */
+
+  _cell_aggregation_keep(CS_MAX(n_cells_per_aggr, 1),
+                         n_aggr,
+                         c_aggr_id,
+                         a_cell_id,
+                         a_vol);
+
+  /* Set return values */
+
+  *n_elts = n_aggr;
+  *coords = _coords;
+  *s = _s;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Interpolate cell values at probes defined by
+ *        \ref cs_cell_aggregation_probes_define, using the volume-weighted
+ *        mean of values over each aggregate.
+ *
+ * Points which are not located in the probe cell of an aggregate (or
+ * values of another type than \ref cs_real_t) use a P0 interpolation.
+ *
+ * This function matches \ref cs_interpolate_from_location_t, and is used
+ * for output on probe sets whose "interpolation" option is set to 2.
+ *
+ * \param[in, out]  input           pointer to optional (untyped) value
+ *                                  or structure (unused here)
+ * \param[in]       datatype        associated datatype
+ * \param[in]       val_dim         dimension of data values
+ * \param[in]       n_points        number of interpolation points
+ * \param[in]       point_location  location of points in mesh cells
+ * \param[in]       point_coords    point coordinates
+ * \param[in]       location_vals   values at cells
+ * \param[out]      point_vals      interpolated values at points
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_cell_aggregation_interpolate(void                *input,
+                                cs_datatype_t        datatype,
+                                int                  val_dim,
+                                cs_lnum_t            n_points,
+                                const cs_lnum_t      point_location[],
+                                const cs_real_3_t    point_coords[],
+                                const void          *location_vals,
+                                void                *point_vals)
+{
+  cs_interpolate_from_location_p0(input,
+                                  datatype,
+                                  val_dim,
+                                  n_points,
+                                  point_location,
+                                  point_coords,
+                                  location_vals,
+                                  point_vals);
+
+  if (datatype != CS_REAL_TYPE)
+    return;
+
+  const cs_lnum_t n_cells = cs_glob_mesh->n_cells;
+  const cs_real_t *cell_vol = cs_glob_mesh_quantities->cell_vol;
+  const cs_real_t *c_vals = (const cs_real_t *)location_vals;
+  cs_real_t *p_vals = (cs_real_t *)point_vals;
+
+  cs_lnum_t *p_aggr_id;
+  BFT_MALLOC(p_aggr_id, n_points, cs_lnum_t);
+
+  /* Use the first aggregation for which points are at probe cells */
+
+  for (int a_i = 0; a_i < _n_cell_aggregations; a_i++) {
+
+    const _cell_aggregation_t *ca = _cell_aggregations + a_i;
+
+    if (ca->n_cells != n_cells)
+      continue;
+
+    cs_lnum_t n_matched = 0;
+
+    for (cs_lnum_t i = 0; i < n_points; i++) {
+      const cs_lnum_t c_id = point_location[i];
+      p_aggr_id[i] = -1;
+      if (c_id > -1 && c_id < n_cells) {
+        const cs_lnum_t a_id = ca->c_aggr_id[c_id];
+        if (ca->a_cell_id[a_id] == c_id) {
+          p_aggr_id[i] = a_id;
+          n_matched += 1;
+        }
+      }
+    }
+
+    if (n_matched == 0)
+      continue;
+
+    cs_real_t *a_vals;
+    BFT_MALLOC(a_vals, ca->n_aggr*val_dim, cs_real_t);
+
+    for (cs_lnum_t i = 0; i < ca->n_aggr*val_dim; i++)
+      a_vals[i] = 0.;
+
+    for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+      const cs_lnum_t a_id = ca->c_aggr_id[c_id];
+      for (int j = 0; j < val_dim; j++)
+        a_vals[a_id*val_dim + j] += cell_vol[c_id]*c_vals[c_id*val_dim + j];
+    }
+
+    for (cs_lnum_t i = 0; i < n_points; i++) {
+      const cs_lnum_t a_id = p_aggr_id[i];
+      if (a_id > -1) {
+        for (int j = 0; j < val_dim; j++)
+          p_vals[i*val_dim + j] = a_vals[a_id*val_dim + j] / ca->a_vol[a_id];
+      }
+    }
+
+    BFT_FREE(a_vals);
+
+    break;
+  }
+
+  BFT_FREE(p_aggr_id);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Free cell aggregations kept by
+ *        \ref cs_cell_aggregation_probes_define.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_cell_aggregation_finalize(void)
+{
+  for (int a_i = 0; a_i < _n_cell_aggregations; a_i++) {
+    _cell_aggregation_t *ca = _cell_aggregations + a_i;
+    BFT_FREE(ca->c_aggr_id);
+    BFT_FREE(ca->a_cell_id);
+    BFT_FREE(ca->a_vol);
+  }
+
+  BFT_FREE(_cell_aggregations);
+  _n_cell_aggregations = 0;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Compute the head of a turbomachinery (total pressure increase)
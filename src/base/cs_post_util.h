@@ -188,6 +188,83 @@ cs_b_face_criterion_probes_define(void          *input,
                                   cs_real_3_t  **coords,
                                   cs_real_t    **s);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Define probes based on a coarse representation of the mesh
+ *        obtained by cell aggregation.
+ *
+ * Cells are aggregated using the multigrid coarsening algorithm
+ * (see \ref cs_grid_coarsen), and one probe is defined per aggregate,
+ * at the center of the cell closest to the aggregate's center of gravity.
+ * Values output on the associated probe set are thus a point sub-sampling
+ * of the volume fields, which may be used for lightweight visualization.
+ *
+ * The aggregation is kept, so that if the probe set's "interpolation"
+ * option is set to 2, output values are averaged over each aggregate
+ * (see \ref cs_cell_aggregation_interpolate). The aggregated (coarse)
+ * mesh itself is not available for output.
+ *
+ * Here, the input points to an integer defining the target mean number
+ * of cells per aggregate (8 if NULL).
+ *
+ * \param[in]   input   pointer to target number of cells per probe
+ * \param[out]  n_elts  number of selected coordinates
+ * \param[out]  coords  coordinates of selected elements.
+ * \param[out]  s       curvilinear coordinates of selected elements
+ *                      (global aggregate number)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_cell_aggregation_probes_define(void          *input,
+                                  cs_lnum_t     *n_elts,
+                                  cs_real_3_t  **coords,
+                                  cs_real_t    **s);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Interpolate cell values at probes defined by
+ *        \ref cs_cell_aggregation_probes_define, using the volume-weighted
+ *        mean of values over each aggregate.
+ *
+ * Points which are not located in the probe cell of an aggregate (or
+ * values of another type than \ref cs_real_t) use a P0 interpolation.
+ *
+ * This function matches \ref cs_interpolate_from_location_t, and is used
+ * for output on probe sets whose "interpolation" option is set to 2.
+ *
+ * \param[in, out]  input           pointer to optional (untyped) value
+ *                                  or structure (unused here)
+ * \param[in]       datatype        associated datatype
+ * \param[in]       val_dim         dimension of data values
+ * \param[in]       n_points        number of interpolation points
+ * \param[in]       point_location  location of points in mesh cells
+ * \param[in]       point_coords    point coordinates
+ * \param[in]       location_vals   values at cells
+ * \param[out]      point_vals      interpolated values at points
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_cell_aggregation_interpolate(void                *input,
+                                cs_datatype_t        datatype,
+                                int                  val_dim,
+                                cs_lnum_t            n_points,
+                                const cs_lnum_t      point_location[],
+                                const cs_real_3_t    point_coords[],
+                                const void          *location_vals,
+                                void                *point_vals);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Free cell aggregations kept by
+ *        \ref cs_cell_aggregation_probes_define.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_cell_aggregation_finalize(void);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Compute the head of a turbomachinery (total pressure increase)
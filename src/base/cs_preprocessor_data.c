@@ -55,6 +55,7 @@
 #include "cs_block_dist.h"
 #include "cs_file.h"
 #include "cs_interface.h"
+#include "cs_lagr_restart.h"
 #include "cs_mesh.h"
 #include "cs_mesh_from_builder.h"
 #include "cs_mesh_group.h"
@@ -1862,6 +1863,58 @@ _read_data(int                 file_id,
   cs_io_finalize(&pp_in);
 }
 
+/*----------------------------------------------------------------------------
+ * Define partitioning weights based on particle counts from a Lagrangian
+ * checkpoint, if available.
+ *
+ * A unit (fluid) weight and the number of particles are used for each
+ * cell, as separate partitioning constraints.
+ *
+ * parameters:
+ *   mb <-- pointer to mesh builder structure
+ *----------------------------------------------------------------------------*/
+
+static void
+_set_particle_cell_weights(const cs_mesh_builder_t  *mb)
+{
+  cs_lnum_t n_b_cells = 0;
+  if (mb->cell_bi.gnum_range[1] > mb->cell_bi.gnum_range[0])
+    n_b_cells = mb->cell_bi.gnum_range[1] - mb->cell_bi.gnum_range[0];
+
+  cs_lnum_t *cell_count;
+  BFT_MALLOC(cell_count, n_b_cells, cs_lnum_t);
+
+  if (cs_lagr_restart_cell_particle_count(&(mb->cell_bi), cell_count)) {
+
+    cs_gnum_t n_g_particles = 0;
+    for (cs_lnum_t i = 0; i < n_b_cells; i++)
+      n_g_particles += cell_count[i];
+
+    cs_parall_counter(&n_g_particles, 1);
+
+    if (n_g_particles > 0) {
+
+      double *cell_weight;
+      BFT_MALLOC(cell_weight, n_b_cells*2, double);
+
+      for (cs_lnum_t i = 0; i < n_b_cells; i++) {
+        cell_weight[i*2] = 1.;
+        cell_weight[i*2 + 1] = cell_count[i];
+      }
+
+      cs_partition_set_cell_constraint_weights(2, cell_weight);
+
+      bft_printf(_("\n Partitioning weighted by %llu particles"
+                   " from Lagrangian checkpoint.\n"),
+                 (unsigned long long)n_g_particles);
+
+    }
+
+  }
+
+  BFT_FREE(cell_count);
+}
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*============================================================================
@@ -2189,9 +2242,19 @@ cs_preprocessor_data_read_mesh(cs_mesh_t          *mesh,
 
   /* Partition data */
 
-  if (! pre_partitioned)
+  if (! pre_partitioned) {
+
+    /* Balance particles also when restarting particle tracking */
+
+    if (   partition_stage == CS_PARTITION_MAIN
+        && cs_glob_n_ranks > 1
+        && mr->n_files == 1)
+      _set_particle_cell_weights(mesh_builder);
+
     cs_partition(mesh, mesh_builder, partition_stage);
 
+  }
+
   bft_printf("\n");
 
   /* Now send data to the correct rank */
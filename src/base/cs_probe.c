@@ -145,7 +145,8 @@ struct _cs_probe_set_t {
   char         *located;        /* 1 for located probes, 0 for unlocated */
 
   int           interpolation;  /* 0: no interpolation;
-                                   1: local gradient-based interpolation */
+                                   1: local gradient-based interpolation;
+                                   2: mean over cell aggregates */
 
   /* User-defined writers associated to this set of probes */
 
@@ -1289,7 +1290,9 @@ cs_probe_set_snap_mode(cs_probe_set_t   *pset,
  * - \c \b tolerance  where keyval is for instance "0.05" (default "0.10")
  * - \c \b interpolation if \ c 0, P0 interpolation (default); if \c 1,
  *         simple gradient-based interpolation for volume probes (ignored
- *         for boundaries). Other interpolation options might be added
+ *         for boundaries); if \c 2, mean over cell aggregates for probes
+ *         defined by \ref cs_cell_aggregation_probes_define (ignored for
+ *         boundaries). Other interpolation options might be added
  *         in the future.
  *
  * \param[in, out] pset     pointer to a cs_probe_set_t structure to set
@@ -484,7 +484,9 @@ cs_probe_set_snap_mode(cs_probe_set_t   *pset,
  * - \c \b tolerance  where keyval is for instance "0.05" (default "0.10")
  * - \c \b interpolation if \ c 0, P0 interpolation (default); if \c 1,
  *         simple gradient-based interpolation for volume probes (ignored
- *         for boundaries). Other interpolation options might be added
+ *         for boundaries); if \c 2, mean over cell aggregates for probes
+ *         defined by \ref cs_cell_aggregation_probes_define (ignored for
+ *         boundaries). Other interpolation options might be added
  *         in the future.
  *
  * \param[in, out] pset     pointer to a cs_probe_set_t structure to set
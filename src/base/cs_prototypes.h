@@ -91,8 +91,7 @@ extern void CS_PROCF (csinit, CSINIT)
 
 extern void CS_PROCF (distpr, DISTPR)
 (
- const int  *itypfb,    /* <-- boudnary face types */
- cs_real_t  *distpa     /* <-- wall distance */
+ const int  *itypfb     /* <-- boundary face types */
 );
 
 /*----------------------------------------------------------------------------
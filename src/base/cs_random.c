@@ -32,6 +32,7 @@
 
 #include <assert.h>
 #include <math.h>
+#include <stdint.h>
 
 /*----------------------------------------------------------------------------
  * Local headers
@@ -60,6 +61,18 @@ BEGIN_C_DECLS
   Based on the uniform, gaussian, and poisson random number generation code
   from netlib.org: lagged (-273,-607) Fibonacci; Box-Muller;
   by W.P. Petersen, IPS, ETH Zuerich.
+
+  The state of these generators is global, so they may not be called
+  from threads, and the sequence of values obtained depends on the order
+  of calls.
+
+  Counter-based generation is also provided, based on the Philox4x32-10
+  function (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3",
+  SC'11): values are a function of a key and a counter only, so a
+  \ref cs_random_stream_t stream identified by an entity id (such as a
+  particle number), a time step, and a purpose always produces the same
+  values, independently of the order of calls or of the number of
+  MPI ranks or OpenMP threads used.
 */
 
 /*! \cond DOXYGEN_SHOULD_SKIP_THIS */
@@ -68,6 +81,13 @@ BEGIN_C_DECLS
  * Macro definitions
  *============================================================================*/
 
+/* Philox4x32 multipliers and Weyl sequence key increments */
+
+#define _PHILOX_M0  0xD2511F53U
+#define _PHILOX_M1  0xCD9E8D57U
+#define _PHILOX_W0  0x9E3779B9U
+#define _PHILOX_W1  0xBB67AE85U
+
 /*============================================================================
  * Type definitions
  *============================================================================*/
@@ -90,6 +110,10 @@ static struct {
   double   e_3;
 } klotz1_1 = {{0}, 0, 0, 0.};
 
+/* Seed for counter-based generation */
+
+static uint32_t  _stream_seed = 0;
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*============================================================================
@@ -171,6 +195,130 @@ _normal00(void)
   }
 }
 
+/*----------------------------------------------------------------------------
+ * Philox4x32-10 counter-based bijection.
+ *
+ * parameters:
+ *   ctr <-- counter
+ *   key <-- key
+ *   r   --> pseudo-random output
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_philox4x32(const uint32_t  ctr[4],
+            const uint32_t  key[2],
+            uint32_t        r[4])
+{
+  uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+  uint32_t k0 = key[0], k1 = key[1];
+
+  for (int i = 0; i < 10; i++) {
+    uint64_t p0 = (uint64_t)_PHILOX_M0 * c0;
+    uint64_t p1 = (uint64_t)_PHILOX_M1 * c2;
+    uint32_t t0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+    uint32_t t2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+    c1 = (uint32_t)p1;
+    c3 = (uint32_t)p0;
+    c0 = t0;
+    c2 = t2;
+    k0 += _PHILOX_W0;
+    k1 += _PHILOX_W1;
+  }
+
+  r[0] = c0; r[1] = c1; r[2] = c2; r[3] = c3;
+}
+
+/*----------------------------------------------------------------------------
+ * Convert 64 random bits to a double in the open interval (0, 1).
+ *
+ * parameters:
+ *   hi <-- high 32 bits
+ *   lo <-- low 32 bits
+ *
+ * returns:
+ *   uniform value
+ *----------------------------------------------------------------------------*/
+
+static inline double
+_u64_to_uniform(uint32_t  hi,
+                uint32_t  lo)
+{
+  uint64_t x = ((uint64_t)hi << 32) | lo;
+
+  /* 53 random mantissa bits, shifted by half a step to exclude 0 and 1 */
+
+  return ((double)(x >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+/*----------------------------------------------------------------------------
+ * Generate uniform values for a stream, starting at a given block.
+ *
+ * Each block of the stream provides 2 values.
+ *
+ * parameters:
+ *   s     <-- stream
+ *   block <-- id of first block
+ *   n     <-- number of values to compute
+ *   a     --> pseudo-random numbers following uniform distribution
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_stream_uniform(const cs_random_stream_t  *s,
+                uint32_t                   block,
+                cs_lnum_t                  n,
+                cs_real_t                  a[])
+{
+  uint32_t ctr[4] = {s->ctr[0], s->ctr[1], s->ctr[2], block};
+  uint32_t r[4];
+
+  cs_lnum_t i = 0;
+  for (; i + 1 < n; i += 2) {
+    _philox4x32(ctr, s->key, r);
+    a[i]   = _u64_to_uniform(r[0], r[1]);
+    a[i+1] = _u64_to_uniform(r[2], r[3]);
+    ctr[3] += 1;
+  }
+  if (i < n) {
+    _philox4x32(ctr, s->key, r);
+    a[i] = _u64_to_uniform(r[0], r[1]);
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Generate normal values for a stream, starting at a given block.
+ *
+ * Each block of the stream provides 2 values, using the Box-Muller method.
+ *
+ * parameters:
+ *   s     <-- stream
+ *   block <-- id of first block
+ *   n     <-- number of values to compute
+ *   x     --> pseudo-random numbers following normal distribution
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_stream_normal(const cs_random_stream_t  *s,
+               uint32_t                   block,
+               cs_lnum_t                  n,
+               cs_real_t                  x[])
+{
+  const double twopi = 6.2831853071795862;
+
+  uint32_t ctr[4] = {s->ctr[0], s->ctr[1], s->ctr[2], block};
+  uint32_t r[4];
+
+  for (cs_lnum_t i = 0; i < n; i += 2) {
+    _philox4x32(ctr, s->key, r);
+    double u1 = _u64_to_uniform(r[0], r[1]);
+    double u2 = _u64_to_uniform(r[2], r[3]);
+    double rr = sqrt(-2.*log(u1));
+    x[i] = rr * cos(twopi*u2);
+    if (i + 1 < n)
+      x[i+1] = rr * sin(twopi*u2);
+    ctr[3] += 1;
+  }
+}
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*=============================================================================
@@ -585,6 +733,196 @@ cs_random_restore(cs_real_t  save_block[1634])
   }
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set the seed used for counter-based random number streams.
+ *
+ * The same seed should be used on all ranks so that the values generated
+ * do not depend on the domain partitioning.
+ *
+ * \param[in]  seed  stream seed (0 by default)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_stream_seed(uint32_t  seed)
+{
+  _stream_seed = seed;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Initialize a counter-based random number stream.
+ *
+ * Streams initialized with different (id, time_step, purpose) triplets
+ * produce independent sequences.
+ *
+ * \param[out]  s          stream
+ * \param[in]   id         entity id (global number) with which the stream
+ *                         is associated
+ * \param[in]   time_step  associated time step
+ * \param[in]   purpose    purpose of the stream (user-defined), so that
+ *                         separate uses for the same entity and time step
+ *                         are independent
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_stream_init(cs_random_stream_t  *s,
+                      cs_gnum_t            id,
+                      int                  time_step,
+                      int                  purpose)
+{
+  uint64_t _id = id;
+
+  s->key[0] = _stream_seed;
+  s->key[1] = (uint32_t)purpose;
+
+  s->ctr[0] = (uint32_t)(_id & 0xFFFFFFFFU);
+  s->ctr[1] = (uint32_t)(_id >> 32);
+  s->ctr[2] = (uint32_t)time_step;
+  s->ctr[3] = 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Uniform distribution values from a counter-based random number
+ *        stream.
+ *
+ * Values are in the open interval (0, 1). Each call advances the stream
+ * by (n+1)/2 blocks of 2 values, so that successive calls return
+ * independent values.
+ *
+ * \param[in, out]  s  stream
+ * \param[in]       n  number of values to compute
+ * \param[out]      a  pseudo-random numbers following uniform distribution
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_stream_uniform(cs_random_stream_t  *s,
+                         cs_lnum_t            n,
+                         cs_real_t            a[])
+{
+  if (n <= 0)
+    return;
+
+  _stream_uniform(s, s->ctr[3], n, a);
+  s->ctr[3] += (n+1)/2;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Normal distribution values from a counter-based random number
+ *        stream.
+ *
+ * Box-Muller method. Each call advances the stream by (n+1)/2 blocks of
+ * 2 values, so that successive calls return independent values.
+ *
+ * \param[in, out]  s  stream
+ * \param[in]       n  number of values to compute
+ * \param[out]      x  pseudo-random numbers following normal distribution
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_stream_normal(cs_random_stream_t  *s,
+                        cs_lnum_t            n,
+                        cs_real_t            x[])
+{
+  if (n <= 0)
+    return;
+
+  _stream_normal(s, s->ctr[3], n, x);
+  s->ctr[3] += (n+1)/2;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Uniform distribution values for a set of entities, using
+ *        counter-based random number streams.
+ *
+ * For each entity i, the stride values a[i*stride] to a[(i+1)*stride - 1]
+ * are the first values of the stream initialized by
+ * \ref cs_random_stream_init with id (ids[i] + id_shift), or (i + id_shift)
+ * if ids is NULL, so they do not depend on the number of threads, or on
+ * how entities are distributed among ranks.
+ *
+ * This function may be called from threads, or uses threads itself when
+ * called outside a parallel region.
+ *
+ * \param[in]   n_elts     number of entities
+ * \param[in]   ids        global entity ids, or NULL
+ * \param[in]   id_shift   shift applied to entity ids
+ * \param[in]   time_step  associated time step
+ * \param[in]   purpose    purpose of the streams (user-defined)
+ * \param[in]   stride     number of values per entity
+ * \param[out]  a          pseudo-random numbers following uniform
+ *                         distribution (size: n_elts*stride)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_keyed_uniform(cs_lnum_t        n_elts,
+                        const cs_gnum_t  ids[],
+                        cs_gnum_t        id_shift,
+                        int              time_step,
+                        int              purpose,
+                        cs_lnum_t        stride,
+                        cs_real_t        a[])
+{
+# pragma omp parallel for if (n_elts*stride > CS_THR_MIN)
+  for (cs_lnum_t i = 0; i < n_elts; i++) {
+    cs_random_stream_t s;
+    cs_gnum_t id = (ids != NULL) ? ids[i] : (cs_gnum_t)i;
+    cs_random_stream_init(&s, id + id_shift, time_step, purpose);
+    _stream_uniform(&s, 0, stride, a + i*stride);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Normal distribution values for a set of entities, using
+ *        counter-based random number streams.
+ *
+ * For each entity i, the stride values x[i*stride] to x[(i+1)*stride - 1]
+ * are the first values of the stream initialized by
+ * \ref cs_random_stream_init with id (ids[i] + id_shift), or (i + id_shift)
+ * if ids is NULL, so they do not depend on the number of threads, or on
+ * how entities are distributed among ranks.
+ *
+ * This function may be called from threads, or uses threads itself when
+ * called outside a parallel region.
+ *
+ * \param[in]   n_elts     number of entities
+ * \param[in]   ids        global entity ids, or NULL
+ * \param[in]   id_shift   shift applied to entity ids
+ * \param[in]   time_step  associated time step
+ * \param[in]   purpose    purpose of the streams (user-defined)
+ * \param[in]   stride     number of values per entity
+ * \param[out]  x          pseudo-random numbers following normal
+ *                         distribution (size: n_elts*stride)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_keyed_normal(cs_lnum_t        n_elts,
+                       const cs_gnum_t  ids[],
+                       cs_gnum_t        id_shift,
+                       int              time_step,
+                       int              purpose,
+                       cs_lnum_t        stride,
+                       cs_real_t        x[])
+{
+# pragma omp parallel for if (n_elts*stride > CS_THR_MIN)
+  for (cs_lnum_t i = 0; i < n_elts; i++) {
+    cs_random_stream_t s;
+    cs_gnum_t id = (ids != NULL) ? ids[i] : (cs_gnum_t)i;
+    cs_random_stream_init(&s, id + id_shift, time_step, purpose);
+    _stream_normal(&s, 0, stride, x + i*stride);
+  }
+}
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -27,6 +27,8 @@
 
 /*----------------------------------------------------------------------------*/
 
+#include <stdint.h>
+
 #if defined(HAVE_MPI)
 #include <mpi.h>
 #endif
@@ -49,6 +51,15 @@ BEGIN_C_DECLS
  * Type definitions
  *============================================================================*/
 
+/*! Counter-based random number stream */
+
+typedef struct {
+
+  uint32_t  key[2];    /*!< key (seed, purpose) */
+  uint32_t  ctr[4];    /*!< counter (entity id, time step, block) */
+
+} cs_random_stream_t;
+
 /*=============================================================================
  * Global variables
  *============================================================================*/
@@ -142,6 +153,150 @@ cs_random_save(cs_real_t  save_block[1634]);
 void
 cs_random_restore(cs_real_t  save_block[1634]);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Set the seed used for counter-based random number streams.
+ *
+ * The same seed should be used on all ranks so that the values generated
+ * do not depend on the domain partitioning.
+ *
+ * \param[in]  seed  stream seed (0 by default)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_stream_seed(uint32_t  seed);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Initialize a counter-based random number stream.
+ *
+ * Streams initialized with different (id, time_step, purpose) triplets
+ * produce independent sequences.
+ *
+ * \param[out]  s          stream
+ * \param[in]   id         entity id (global number) with which the stream
+ *                         is associated
+ * \param[in]   time_step  associated time step
+ * \param[in]   purpose    purpose of the stream (user-defined), so that
+ *                         separate uses for the same entity and time step
+ *                         are independent
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_stream_init(cs_random_stream_t  *s,
+                      cs_gnum_t            id,
+                      int                  time_step,
+                      int                  purpose);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Uniform distribution values from a counter-based random number
+ *        stream.
+ *
+ * Values are in the open interval (0, 1). Each call advances the stream
+ * by (n+1)/2 blocks of 2 values, so that successive calls return
+ * independent values.
+ *
+ * \param[in, out]  s  stream
+ * \param[in]       n  number of values to compute
+ * \param[out]      a  pseudo-random numbers following uniform distribution
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_stream_uniform(cs_random_stream_t  *s,
+                         cs_lnum_t            n,
+                         cs_real_t            a[]);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Normal distribution values from a counter-based random number
+ *        stream.
+ *
+ * Box-Muller method. Each call advances the stream by (n+1)/2 blocks of
+ * 2 values, so that successive calls return independent values.
+ *
+ * \param[in, out]  s  stream
+ * \param[in]       n  number of values to compute
+ * \param[out]      x  pseudo-random numbers following normal distribution
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_stream_normal(cs_random_stream_t  *s,
+                        cs_lnum_t            n,
+                        cs_real_t            x[]);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Uniform distribution values for a set of entities, using
+ *        counter-based random number streams.
+ *
+ * For each entity i, the stride values a[i*stride] to a[(i+1)*stride - 1]
+ * are the first values of the stream initialized by
+ * \ref cs_random_stream_init with id (ids[i] + id_shift), or (i + id_shift)
+ * if ids is NULL, so they do not depend on the number of threads, or on
+ * how entities are distributed among ranks.
+ *
+ * This function may be called from threads, or uses threads itself when
+ * called outside a parallel region.
+ *
+ * \param[in]   n_elts     number of entities
+ * \param[in]   ids        global entity ids, or NULL
+ * \param[in]   id_shift   shift applied to entity ids
+ * \param[in]   time_step  associated time step
+ * \param[in]   purpose    purpose of the streams (user-defined)
+ * \param[in]   stride     number of values per entity
+ * \param[out]  a          pseudo-random numbers following uniform
+ *                         distribution (size: n_elts*stride)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_keyed_uniform(cs_lnum_t        n_elts,
+                        const cs_gnum_t  ids[],
+                        cs_gnum_t        id_shift,
+                        int              time_step,
+                        int              purpose,
+                        cs_lnum_t        stride,
+                        cs_real_t        a[]);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Normal distribution values for a set of entities, using
+ *        counter-based random number streams.
+ *
+ * For each entity i, the stride values x[i*stride] to x[(i+1)*stride - 1]
+ * are the first values of the stream initialized by
+ * \ref cs_random_stream_init with id (ids[i] + id_shift), or (i + id_shift)
+ * if ids is NULL, so they do not depend on the number of threads, or on
+ * how entities are distributed among ranks.
+ *
+ * This function may be called from threads, or uses threads itself when
+ * called outside a parallel region.
+ *
+ * \param[in]   n_elts     number of entities
+ * \param[in]   ids        global entity ids, or NULL
+ * \param[in]   id_shift   shift applied to entity ids
+ * \param[in]   time_step  associated time step
+ * \param[in]   purpose    purpose of the streams (user-defined)
+ * \param[in]   stride     number of values per entity
+ * \param[out]  x          pseudo-random numbers following normal
+ *                         distribution (size: n_elts*stride)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_random_keyed_normal(cs_lnum_t        n_elts,
+                       const cs_gnum_t  ids[],
+                       cs_gnum_t        id_shift,
+                       int              time_step,
+                       int              purpose,
+                       cs_lnum_t        stride,
+                       cs_real_t        x[]);
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
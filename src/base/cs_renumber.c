@@ -94,6 +94,7 @@ extern "C" {
 #include "cs_join.h"
 #include "cs_mesh.h"
 #include "cs_mesh_adjacencies.h"
+#include "cs_numa.h"
 #include "cs_order.h"
 #include "cs_parall.h"
 #include "cs_post.h"
@@ -5894,6 +5895,17 @@ cs_renumber_mesh(cs_mesh_t  *mesh)
   if (mesh->vtx_numbering == NULL)
     mesh->vtx_numbering = cs_numbering_create_default(mesh->n_vertices);
 
+  /* Place face -> cells connectivity in memory based on thread ranges */
+
+  cs_numa_place_array(mesh->i_face_numbering,
+                      mesh->n_i_faces,
+                      sizeof(cs_lnum_2_t),
+                      (void **)&(mesh->i_face_cells));
+  cs_numa_place_array(mesh->b_face_numbering,
+                      CS_MAX(mesh->n_b_faces, mesh->n_b_faces_all),
+                      sizeof(cs_lnum_t),
+                      (void **)&(mesh->b_face_cells));
+
   _renumber_i_test(mesh);
   _renumber_b_test(mesh);
 
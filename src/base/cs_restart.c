@@ -3129,6 +3129,147 @@ cs_restart_read_particles(cs_restart_t  *restart,
   return retcode;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Count particles per cell in a restart file, using a given
+ *         cell block distribution.
+ *
+ * This does not require the mesh to be distributed, so it may be used
+ * before partitioning, for example to define partitioning weights.
+ * Cell global numbers are those of the mesh used when writing the
+ * restart file.
+ *
+ * \param[in]   restart     associated restart file pointer
+ * \param[in]   name        name of particles set
+ * \param[in]   cell_bi     cell block distribution info
+ * \param[out]  cell_count  number of particles for each cell of the block
+ *
+ * \return  0 (CS_RESTART_SUCCESS) in case of success,
+ *          CS_RESTART_ERR_LOCATION if the global number of cells does not
+ *          match that of the current mesh, or other error code
+ *          (CS_RESTART_ERR_xxx) in case of error
+ */
+/*----------------------------------------------------------------------------*/
+
+int
+cs_restart_read_particles_cell_count(cs_restart_t                *restart,
+                                     const char                  *name,
+                                     const cs_block_dist_info_t  *cell_bi,
+                                     cs_lnum_t                    cell_count[])
+{
+  double timing[2];
+
+  int loc_id, rec_id;
+  cs_io_sec_header_t  header;
+
+  cs_lnum_t n_b_cells = 0;
+  if (cell_bi->gnum_range[1] > cell_bi->gnum_range[0])
+    n_b_cells = cell_bi->gnum_range[1] - cell_bi->gnum_range[0];
+
+  for (cs_lnum_t i = 0; i < n_b_cells; i++)
+    cell_count[i] = 0;
+
+  /* Search for location with the same name */
+
+  for (loc_id = 0; loc_id < (int)(restart->n_locations); loc_id++) {
+    if ((strcmp((restart->location[loc_id]).name, name) == 0))
+      break;
+  }
+
+  if (loc_id >= (int)(restart->n_locations))
+    return CS_RESTART_ERR_LOCATION;
+
+  const _location_t *c_loc = restart->location + CS_MESH_LOCATION_CELLS - 1;
+  if (c_loc->n_glob_ents_f != c_loc->n_glob_ents)
+    return CS_RESTART_ERR_LOCATION;
+
+  rec_id = _restart_section_id(restart, NULL, name, "_cell_num");
+
+  if (rec_id < 0)
+    return CS_RESTART_ERR_EXISTS;
+
+  timing[0] = cs_timer_wtime();
+
+  cs_gnum_t n_glob_particles = (restart->location[loc_id]).n_glob_ents_f;
+
+  /* Read particle cell numbers to an arbitrary block distribution */
+
+  cs_block_dist_info_t part_bi
+    = cs_block_dist_compute_sizes(CS_MAX(cs_glob_rank_id, 0),
+                                  cs_glob_n_ranks,
+                                  restart->rank_step,
+                                  restart->min_block_size / sizeof(cs_gnum_t),
+                                  n_glob_particles);
+
+  cs_lnum_t n_part_block = 0;
+  if (part_bi.gnum_range[1] > part_bi.gnum_range[0])
+    n_part_block = part_bi.gnum_range[1] - part_bi.gnum_range[0];
+
+  cs_gnum_t *part_cell_num;
+  BFT_MALLOC(part_cell_num, n_part_block, cs_gnum_t);
+
+  header = cs_io_get_indexed_sec_header(restart->fh, rec_id);
+
+  cs_io_set_indexed_position(restart->fh, &header, rec_id);
+  cs_io_set_cs_gnum(&header, restart->fh);
+
+  cs_io_read_block(&header,
+                   part_bi.gnum_range[0],
+                   part_bi.gnum_range[1],
+                   part_cell_num,
+                   restart->fh);
+
+  /* Ignore particles which are not located in a cell */
+
+  cs_lnum_t n_located = 0;
+  for (cs_lnum_t i = 0; i < n_part_block; i++) {
+    if (part_cell_num[i] > 0)
+      part_cell_num[n_located++] = part_cell_num[i];
+  }
+
+#if defined(HAVE_MPI)
+
+  if (cs_glob_n_ranks > 1) {
+
+    cs_all_to_all_t *d
+      = cs_all_to_all_create_from_block(n_located,
+                                        0, /* flags */
+                                        part_cell_num,
+                                        *cell_bi,
+                                        cs_glob_mpi_comm);
+
+    cs_gnum_t *b_part_cell_num = cs_all_to_all_copy_array(d,
+                                                          CS_GNUM_TYPE,
+                                                          1,
+                                                          false,
+                                                          part_cell_num,
+                                                          NULL);
+
+    n_located = cs_all_to_all_n_elts_dest(d);
+
+    cs_all_to_all_destroy(&d);
+
+    BFT_FREE(part_cell_num);
+    part_cell_num = b_part_cell_num;
+
+  }
+
+#endif /* #if defined(HAVE_MPI) */
+
+  for (cs_lnum_t i = 0; i < n_located; i++) {
+    if (   part_cell_num[i] >= cell_bi->gnum_range[0]
+        && part_cell_num[i] < cell_bi->gnum_range[1])
+      cell_count[part_cell_num[i] - cell_bi->gnum_range[0]] += 1;
+  }
+
+  BFT_FREE(part_cell_num);
+
+  timing[1] = cs_timer_wtime();
+  _restart_wtime[restart->mode] += timing[1] - timing[0];
+
+  return CS_RESTART_SUCCESS;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Write basic particles information to a restart file.
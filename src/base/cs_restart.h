@@ -37,6 +37,7 @@
 
 #include "cs_defs.h"
 
+#include "cs_block_dist.h"
 #include "cs_time_step.h"
 
 /*----------------------------------------------------------------------------*/
@@ -709,6 +710,34 @@ cs_restart_read_particles(cs_restart_t  *restart,
                           cs_lnum_t     *particle_cell_id,
                           cs_real_t     *particle_coords);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Count particles per cell in a restart file, using a given
+ *         cell block distribution.
+ *
+ * This does not require the mesh to be distributed, so it may be used
+ * before partitioning, for example to define partitioning weights.
+ * Cell global numbers are those of the mesh used when writing the
+ * restart file.
+ *
+ * \param[in]   restart     associated restart file pointer
+ * \param[in]   name        name of particles set
+ * \param[in]   cell_bi     cell block distribution info
+ * \param[out]  cell_count  number of particles for each cell of the block
+ *
+ * \return  0 (CS_RESTART_SUCCESS) in case of success,
+ *          CS_RESTART_ERR_LOCATION if the global number of cells does not
+ *          match that of the current mesh, or other error code
+ *          (CS_RESTART_ERR_xxx) in case of error
+ */
+/*----------------------------------------------------------------------------*/
+
+int
+cs_restart_read_particles_cell_count(cs_restart_t                *restart,
+                                     const char                  *name,
+                                     const cs_block_dist_info_t  *cell_bi,
+                                     cs_lnum_t                    cell_count[]);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief  Write basic particles information to a restart file.
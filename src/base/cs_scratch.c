@@ -0,0 +1,455 @@
+/*============================================================================
+ * Scratch memory arenas for short-lived work arrays.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+/*----------------------------------------------------------------------------
+ * Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "bft_error.h"
+#include "bft_mem.h"
+#include "bft_printf.h"
+
+#include "cs_log.h"
+#include "cs_parall.h"
+
+/*----------------------------------------------------------------------------
+ * Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_scratch.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Additional doxygen documentation
+ *============================================================================*/
+
+/*!
+  \file cs_scratch.c
+        Scratch memory arenas for short-lived work arrays.
+
+  Work arrays whose lifetime is limited to a function call may be
+  allocated from a stack-like arena rather than the heap: a position in
+  the arena is obtained using \ref cs_scratch_mark, arrays are allocated
+  using \ref CS_SCRATCH_ALLOC, and all memory allocated since the mark
+  is reclaimed at once using \ref cs_scratch_release.
+
+  A shared arena is used outside OpenMP parallel regions, and each thread
+  has its own arena inside them. Arena memory is allocated by chunks
+  through \ref BFT_MEMALIGN, so it appears in the memory statistics.
+  When an arena is fully released and spans several chunks, these are
+  merged into a single chunk of the high-water size, so that once the
+  arena has grown to the size required by a time step, subsequent time
+  steps do not allocate heap memory.
+*/
+
+/*! \cond DOXYGEN_SHOULD_SKIP_THIS */
+
+/*=============================================================================
+ * Local macro definitions
+ *============================================================================*/
+
+/* Minimum chunk size */
+
+#define _CHUNK_SIZE_MIN  65536
+
+/*============================================================================
+ * Type definitions
+ *============================================================================*/
+
+/* Arena memory chunk */
+
+typedef struct {
+
+  unsigned char  *base;     /* allocated pointer */
+  unsigned char  *data;     /* aligned data pointer */
+  size_t          size;     /* usable size */
+
+} _scratch_chunk_t;
+
+/* Scratch arena */
+
+typedef struct {
+
+  int                n_chunks;       /* number of chunks */
+  int                n_chunks_max;   /* allocated number of chunks */
+  _scratch_chunk_t  *chunks;         /* chunks */
+
+  int                cur_chunk;      /* current chunk id */
+  size_t             cur_offset;     /* offset in current chunk */
+
+  size_t             size_max;       /* high-water use (bytes) */
+  unsigned long long n_allocs;       /* number of scratch allocations */
+  unsigned long long n_chunk_allocs; /* number of chunk allocations */
+
+  char               pad[CS_CL_SIZE];   /* avoid false sharing */
+
+} _scratch_arena_t;
+
+/*============================================================================
+ * Static global variables
+ *============================================================================*/
+
+static int                _n_arenas = 0;
+static _scratch_arena_t  *_arenas = NULL;
+
+/*============================================================================
+ * Private function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Initialize arenas (shared arena and one per thread).
+ *----------------------------------------------------------------------------*/
+
+static void
+_initialize_arenas(void)
+{
+  int n_threads = 1;
+
+#if defined(HAVE_OPENMP)
+  n_threads = omp_get_max_threads();
+#endif
+
+  _scratch_arena_t *arenas;
+  BFT_MALLOC(arenas, n_threads + 1, _scratch_arena_t);
+  memset(arenas, 0, (n_threads + 1)*sizeof(_scratch_arena_t));
+
+  _arenas = arenas;
+  _n_arenas = n_threads + 1;
+}
+
+/*----------------------------------------------------------------------------
+ * Return the arena associated with the calling thread.
+ *----------------------------------------------------------------------------*/
+
+static inline _scratch_arena_t *
+_arena(void)
+{
+  if (_arenas == NULL) {
+#   pragma omp critical (cs_scratch_init)
+    {
+      if (_arenas == NULL)
+        _initialize_arenas();
+    }
+  }
+
+  int a_id = 0;
+
+#if defined(HAVE_OPENMP)
+  if (omp_in_parallel()) {
+    if (omp_get_level() > 1)
+      bft_error(__FILE__, __LINE__, 0,
+                _("Scratch memory may not be used in nested parallel "
+                  "regions."));
+    a_id = omp_get_thread_num() + 1;
+    if (a_id >= _n_arenas)
+      bft_error(__FILE__, __LINE__, 0,
+                _("Scratch memory used by thread %d, but only %d threads\n"
+                  "were available when scratch arenas were initialized."),
+                a_id - 1, _n_arenas - 1);
+  }
+#endif
+
+  return _arenas + a_id;
+}
+
+/*----------------------------------------------------------------------------
+ * Allocate an arena chunk.
+ *
+ * parameters:
+ *   c    <-> chunk
+ *   size <-- requested size (multiple of CS_CL_SIZE)
+ *----------------------------------------------------------------------------*/
+
+static void
+_chunk_alloc(_scratch_chunk_t  *c,
+             size_t             size)
+{
+  if (bft_mem_have_memalign()) {
+    BFT_MEMALIGN(c->base, CS_CL_SIZE, size, unsigned char);
+    c->data = c->base;
+  }
+  else {
+    BFT_MALLOC(c->base, size + CS_CL_SIZE, unsigned char);
+    size_t r = ((uintptr_t)(c->base)) % CS_CL_SIZE;
+    c->data = (r > 0) ? c->base + (CS_CL_SIZE - r) : c->base;
+  }
+  c->size = size;
+}
+
+/*----------------------------------------------------------------------------
+ * Free arena chunks beyond a given id.
+ *
+ * parameters:
+ *   a        <-> arena
+ *   chunk_id <-- id of first chunk to free
+ *----------------------------------------------------------------------------*/
+
+static void
+_free_chunks(_scratch_arena_t  *a,
+             int                chunk_id)
+{
+  for (int i = chunk_id; i < a->n_chunks; i++) {
+    BFT_FREE(a->chunks[i].base);
+    a->chunks[i].data = NULL;
+    a->chunks[i].size = 0;
+  }
+  if (chunk_id < a->n_chunks)
+    a->n_chunks = chunk_id;
+}
+
+/*----------------------------------------------------------------------------
+ * Add a chunk to an arena, replacing chunks beyond a given id.
+ *
+ * parameters:
+ *   a        <-> arena
+ *   chunk_id <-- id of new chunk
+ *   size     <-- minimum size of new chunk
+ *----------------------------------------------------------------------------*/
+
+static void
+_add_chunk(_scratch_arena_t  *a,
+           int                chunk_id,
+           size_t             size)
+{
+  /* Grow geometrically, based on capacity of previous chunks */
+
+  size_t c_size = _CHUNK_SIZE_MIN;
+  for (int i = 0; i < chunk_id; i++)
+    c_size += a->chunks[i].size;
+  if (c_size < size)
+    c_size = size;
+
+  _free_chunks(a, chunk_id);
+
+  if (a->n_chunks >= a->n_chunks_max) {
+    a->n_chunks_max = CS_MAX(4, a->n_chunks_max*2);
+    BFT_REALLOC(a->chunks, a->n_chunks_max, _scratch_chunk_t);
+  }
+
+  _chunk_alloc(a->chunks + chunk_id, c_size);
+  a->n_chunks = chunk_id + 1;
+  a->n_chunk_allocs += 1;
+}
+
+/*! (end of \cond DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return the current position in the calling thread's scratch arena.
+ *
+ * Outside OpenMP parallel regions, the shared arena is used; inside,
+ * each thread uses its own arena.
+ *
+ * \return  current scratch arena position
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_scratch_mark_t
+cs_scratch_mark(void)
+{
+  _scratch_arena_t *a = _arena();
+
+  cs_scratch_mark_t mark = {.chunk_id = a->cur_chunk,
+                            .offset = a->cur_offset};
+
+  return mark;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Allocate memory from the calling thread's scratch arena.
+ *
+ * This function should be called through the CS_SCRATCH_ALLOC macro.
+ *
+ * \param[in]  ni         number of elements
+ * \param[in]  size       element size
+ * \param[in]  var_name   allocated variable name string
+ * \param[in]  file_name  name of calling source file
+ * \param[in]  line_num   line number in calling source file
+ *
+ * \return  pointer to allocated memory, aligned on CS_CL_SIZE bytes
+ */
+/*----------------------------------------------------------------------------*/
+
+void *
+cs_scratch_alloc(size_t       ni,
+                 size_t       size,
+                 const char  *var_name,
+                 const char  *file_name,
+                 int          line_num)
+{
+  size_t n_bytes = ni * size;
+
+  if (n_bytes == 0)
+    return NULL;
+
+  if (n_bytes / size != ni)
+    bft_error(file_name, line_num, 0,
+              _("Scratch allocation of \"%s\" (%lu x %lu bytes) overflows."),
+              var_name, (unsigned long)ni, (unsigned long)size);
+
+  n_bytes = (n_bytes + CS_CL_SIZE - 1) / CS_CL_SIZE * CS_CL_SIZE;
+
+  _scratch_arena_t *a = _arena();
+
+  int c_id = a->cur_chunk;
+
+  if (c_id < a->n_chunks) {
+    if (a->cur_offset + n_bytes > a->chunks[c_id].size) {
+      if (a->cur_offset > 0)
+        c_id += 1;
+      if (c_id >= a->n_chunks || a->chunks[c_id].size < n_bytes)
+        _add_chunk(a, c_id, n_bytes);
+      a->cur_chunk = c_id;
+      a->cur_offset = 0;
+    }
+  }
+  else
+    _add_chunk(a, c_id, n_bytes);
+
+  void *p = a->chunks[c_id].data + a->cur_offset;
+  a->cur_offset += n_bytes;
+
+  /* Update statistics */
+
+  size_t s = a->cur_offset;
+  for (int i = 0; i < c_id; i++)
+    s += a->chunks[i].size;
+  if (s > a->size_max)
+    a->size_max = s;
+
+  a->n_allocs += 1;
+
+  return p;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Release all memory allocated from the calling thread's scratch
+ *        arena since a given mark.
+ *
+ * Marks must be released in reverse order of their creation.
+ *
+ * \param[in]  mark  scratch arena position returned by cs_scratch_mark()
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_scratch_release(cs_scratch_mark_t  mark)
+{
+  _scratch_arena_t *a = _arena();
+
+  assert(   mark.chunk_id < a->cur_chunk
+         || (   mark.chunk_id == a->cur_chunk
+             && mark.offset <= a->cur_offset));
+
+  a->cur_chunk = mark.chunk_id;
+  a->cur_offset = mark.offset;
+
+  /* When the arena is empty, merge chunks so as to avoid
+     further chunk allocations for the same usage pattern */
+
+  if (a->cur_chunk == 0 && a->cur_offset == 0 && a->n_chunks > 1) {
+    _free_chunks(a, 0);
+    _add_chunk(a, 0, a->size_max);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Log scratch arena statistics and free all arenas.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_scratch_finalize(void)
+{
+  unsigned long long n_allocs[2] = {0, 0}, n_chunk_allocs[2] = {0, 0};
+  unsigned long long size_max[2] = {0, 0};
+
+  for (int i = 0; i < _n_arenas; i++) {
+    _scratch_arena_t *a = _arenas + i;
+    int j = (i == 0) ? 0 : 1;
+    n_allocs[j] += a->n_allocs;
+    n_chunk_allocs[j] += a->n_chunk_allocs;
+    size_max[j] += a->size_max;
+    _free_chunks(a, 0);
+    BFT_FREE(a->chunks);
+  }
+
+  BFT_FREE(_arenas);
+  _n_arenas = 0;
+
+  cs_parall_max(2, CS_UINT64, n_allocs);
+  cs_parall_max(2, CS_UINT64, n_chunk_allocs);
+  cs_parall_max(2, CS_UINT64, size_max);
+
+  if (n_allocs[0] + n_allocs[1] == 0)
+    return;
+
+  const char *arena_name[] = {N_("shared arena:"),
+                              N_("thread arenas:")};
+
+  cs_log_printf(CS_LOG_PERFORMANCE,
+                _("\nScratch memory (maximum per rank):\n\n"));
+
+  for (int j = 0; j < 2; j++) {
+    if (n_allocs[j] == 0)
+      continue;
+    cs_log_printf(CS_LOG_PERFORMANCE,
+                  _("  %-16s %12llu allocations, %8llu chunk allocations,\n"
+                    "  %-16s %12.3f MiB peak use\n"),
+                  _(arena_name[j]), n_allocs[j], n_chunk_allocs[j],
+                  "", size_max[j] / 1048576.);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
@@ -0,0 +1,142 @@
+#ifndef __CS_SCRATCH_H__
+#define __CS_SCRATCH_H__
+
+/*============================================================================
+ * Scratch memory arenas for short-lived work arrays.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*============================================================================
+ * Macro definitions
+ *============================================================================*/
+
+/*
+ * Allocate scratch memory for _ni elements of type _type.
+ *
+ * The returned memory is aligned on CS_CL_SIZE bytes, and is not
+ * initialized. It must not be freed using BFT_FREE, but is reclaimed
+ * by cs_scratch_release().
+ *
+ * parameters:
+ *   _ptr  --> pointer to allocated memory.
+ *   _ni   <-- number of elements.
+ *   _type <-- element type.
+ */
+
+#define CS_SCRATCH_ALLOC(_ptr, _ni, _type) \
+_ptr = (_type *) cs_scratch_alloc(_ni, sizeof(_type), \
+                                  #_ptr, __FILE__, __LINE__)
+
+/*============================================================================
+ * Type definitions
+ *============================================================================*/
+
+/*! Position in a scratch arena, used to release memory allocated after it */
+
+typedef struct {
+
+  int     chunk_id;    /*!< id of current arena chunk */
+  size_t  offset;      /*!< offset in current chunk */
+
+} cs_scratch_mark_t;
+
+/*=============================================================================
+ * Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return the current position in the calling thread's scratch arena.
+ *
+ * Outside OpenMP parallel regions, the shared arena is used; inside,
+ * each thread uses its own arena.
+ *
+ * \return  current scratch arena position
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_scratch_mark_t
+cs_scratch_mark(void);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Allocate memory from the calling thread's scratch arena.
+ *
+ * This function should be called through the CS_SCRATCH_ALLOC macro.
+ *
+ * \param[in]  ni         number of elements
+ * \param[in]  size       element size
+ * \param[in]  var_name   allocated variable name string
+ * \param[in]  file_name  name of calling source file
+ * \param[in]  line_num   line number in calling source file
+ *
+ * \return  pointer to allocated memory, aligned on CS_CL_SIZE bytes
+ */
+/*----------------------------------------------------------------------------*/
+
+void *
+cs_scratch_alloc(size_t       ni,
+                 size_t       size,
+                 const char  *var_name,
+                 const char  *file_name,
+                 int          line_num);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Release all memory allocated from the calling thread's scratch
+ *        arena since a given mark.
+ *
+ * Marks must be released in reverse order of their creation.
+ *
+ * \param[in]  mark  scratch arena position returned by cs_scratch_mark()
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_scratch_release(cs_scratch_mark_t  mark);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Log scratch arena statistics and free all arenas.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_scratch_finalize(void);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_SCRATCH_H__ */
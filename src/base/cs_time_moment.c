@@ -49,6 +49,7 @@
 #include "cs_base.h"
 #include "cs_field.h"
 #include "cs_field_pointer.h"
+#include "cs_load_balance.h"
 #include "cs_log.h"
 #include "cs_mesh.h"
 #include "cs_mesh_location.h"
@@ -975,6 +976,7 @@ _sd_moment_data(const void  *input,
 
   /* Now compute values */
 
+# pragma omp parallel for if (n_elts > CS_THR_MIN)
   for (cs_lnum_t  i = 0; i < n_elts; i++) {
     const cs_real_t *restrict v = f_val[0];
     cs_lnum_t m0 = f_dim[0];
@@ -1418,6 +1420,7 @@ _update_weight_accumulator(cs_time_moment_wa_t  *mwa,
     mwa->val0 += w[0];
   else {
     cs_lnum_t n_w_elts = cs_mesh_location_get_n_elts(mwa->location_id)[0];
+#   pragma omp parallel for if (n_w_elts > CS_THR_MIN)
     for (cs_lnum_t i = 0; i < n_w_elts; i++)
       mwa->val[i] += w[i];
   }
@@ -1442,6 +1445,163 @@ _ensure_init_moment(cs_time_moment_t  *mt)
   }
 }
 
+/*----------------------------------------------------------------------------
+ * Return values array associated with a moment, initializing it if required
+ *
+ * parameters:
+ *   mt <-- moment
+ *
+ * returns:
+ *   pointer to moment values
+ *----------------------------------------------------------------------------*/
+
+static cs_real_t *
+_moment_values(cs_time_moment_t  *mt)
+{
+  _ensure_init_moment(mt);
+
+  cs_real_t *val = mt->val;
+  if (mt->f_id > -1) {
+    cs_field_t *f = cs_field_by_id(mt->f_id);
+    val = f->val;
+  }
+
+  return val;
+}
+
+/*----------------------------------------------------------------------------
+ * Update a mean moment for a given range of elements
+ *
+ * parameters:
+ *   s_id      <-- start id of element range
+ *   e_id      <-- past-the-end id of element range
+ *   dim       <-- moment dimension
+ *   wa_stride <-- weight accumulator stride (0 or 1)
+ *   w         <-- current weight values
+ *   wa_sum    <-- accumulated weight values
+ *   x         <-- current data values
+ *   val       <-> moment values
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_update_mean(cs_lnum_t                  s_id,
+             cs_lnum_t                  e_id,
+             cs_lnum_t                  dim,
+             cs_lnum_t                  wa_stride,
+             const cs_real_t  *restrict w,
+             const cs_real_t  *restrict wa_sum,
+             const cs_real_t  *restrict x,
+             cs_real_t        *restrict val)
+{
+  for (cs_lnum_t je = s_id; je < e_id; je++) {
+    const cs_lnum_t k = je*wa_stride;
+    const double r = w[k] / (w[k] + wa_sum[k]);
+    for (cs_lnum_t l = 0; l < dim; l++) {
+      const cs_lnum_t j = je*dim + l;
+      val[j] += (x[j] - val[j]) * r;
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Update a variance moment and its associated mean for a given range
+ * of elements
+ *
+ * parameters:
+ *   s_id      <-- start id of element range
+ *   e_id      <-- past-the-end id of element range
+ *   dim       <-- moment dimension
+ *   wa_stride <-- weight accumulator stride (0 or 1)
+ *   w         <-- current weight values
+ *   wa_sum    <-- accumulated weight values
+ *   x         <-- current data values
+ *   m         <-> associated mean values
+ *   val       <-> moment values
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_update_variance(cs_lnum_t                  s_id,
+                 cs_lnum_t                  e_id,
+                 cs_lnum_t                  dim,
+                 cs_lnum_t                  wa_stride,
+                 const cs_real_t  *restrict w,
+                 const cs_real_t  *restrict wa_sum,
+                 const cs_real_t  *restrict x,
+                 cs_real_t        *restrict m,
+                 cs_real_t        *restrict val)
+{
+  for (cs_lnum_t je = s_id; je < e_id; je++) {
+    const cs_lnum_t k = je*wa_stride;
+    const double wa_sum_n = w[k] + wa_sum[k];
+    for (cs_lnum_t l = 0; l < dim; l++) {
+      const cs_lnum_t j = je*dim + l;
+      double delta = x[j] - m[j];
+      double r = delta * (w[k] / wa_sum_n);
+      double m_n = m[j] + r;
+      val[j] = (val[j]*wa_sum[k] + (w[k]*delta*(x[j]-m_n))) / wa_sum_n;
+      m[j] += r;
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Update a variance-covariance moment and its associated mean for
+ * a given range of elements
+ *
+ * parameters:
+ *   s_id      <-- start id of element range
+ *   e_id      <-- past-the-end id of element range
+ *   wa_stride <-- weight accumulator stride (0 or 1)
+ *   w         <-- current weight values
+ *   wa_sum    <-- accumulated weight values
+ *   x         <-- current data values (interleaved, size: 3)
+ *   m         <-> associated mean values (interleaved, size: 3)
+ *   val       <-> moment values (interleaved, size: 6)
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_update_variance_6(cs_lnum_t                  s_id,
+                   cs_lnum_t                  e_id,
+                   cs_lnum_t                  wa_stride,
+                   const cs_real_t  *restrict w,
+                   const cs_real_t  *restrict wa_sum,
+                   const cs_real_t  *restrict x,
+                   cs_real_t        *restrict m,
+                   cs_real_t        *restrict val)
+{
+  for (cs_lnum_t je = s_id; je < e_id; je++) {
+    double delta[3], delta_n[3], r[3], m_n[3];
+    const cs_lnum_t k = je*wa_stride;
+    const double wa_sum_n = w[k] + wa_sum[k];
+    for (cs_lnum_t l = 0; l < 3; l++) {
+      cs_lnum_t jl = je*6 + l, jml = je*3 + l;
+      delta[l]   = x[jml] - m[jml];
+      r[l] = delta[l] * (w[k] / wa_sum_n);
+      m_n[l] = m[jml] + r[l];
+      delta_n[l] = x[jml] - m_n[l];
+      val[jl] =   (val[jl]*wa_sum[k] + (w[k]*delta[l]*delta_n[l]))
+                / wa_sum_n;
+    }
+    /* Covariance terms.
+       Note we could have a symmetric formula using
+         0.5*(delta[i]*delta_n[j] + delta[j]*delta_n[i])
+       instead of
+         delta[i]*delta_n[j]
+       but unit tests in cs_moment_test.c do not seem to favor
+       one variant over the other; we use the simplest one.
+    */
+    cs_lnum_t j3 = je*6 + 3, j4 = je*6 + 4, j5 = je*6 + 5;
+    val[j3] =   (val[j3]*wa_sum[k] + (w[k]*delta[0]*delta_n[1]))
+              / wa_sum_n;
+    val[j4] =   (val[j4]*wa_sum[k] + (w[k]*delta[1]*delta_n[2]))
+              / wa_sum_n;
+    val[j5] =   (val[j5]*wa_sum[k] + (w[k]*delta[0]*delta_n[2]))
+              / wa_sum_n;
+    for (cs_lnum_t l = 0; l < 3; l++)
+      m[je*3 + l] += r[l];
+  }
+}
+
 /*============================================================================
  * Fortran wrapper function definitions
  *============================================================================*/
@@ -1962,6 +2122,64 @@ cs_time_moment_map_cell_dt(const cs_real_t  *dt)
   _p_dt = dt;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Redistribute moment accumulators during a mesh redistribution.
+ *
+ * Accumulators defined on base mesh locations are migrated; those defined
+ * on other mesh locations are resized, and their accumulation restarted.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_time_moment_redistribute(void)
+{
+  for (int i = 0; i < _n_moment_wa; i++) {
+    cs_time_moment_wa_t *mwa = _moment_wa + i;
+    if (mwa->location_id == CS_MESH_LOCATION_NONE || mwa->val == NULL)
+      continue;
+    if (mwa->location_id <= CS_MESH_LOCATION_VERTICES) {
+      void *p = mwa->val;
+      cs_load_balance_redistribute_array(mwa->location_id,
+                                         CS_REAL_TYPE,
+                                         1,
+                                         &p);
+      mwa->val = p;
+    }
+    else {
+      cs_lnum_t n_w_elts = cs_mesh_location_get_n_elts(mwa->location_id)[0];
+      BFT_REALLOC(mwa->val, n_w_elts, cs_real_t);
+      _reset_weight_accumulator(mwa);
+    }
+  }
+
+  for (int i = 0; i < _n_moments; i++) {
+    cs_time_moment_t *mt = _moment + i;
+    if (mt->f_id > -1 || mt->val == NULL)
+      continue;
+    if (mt->location_id <= CS_MESH_LOCATION_VERTICES) {
+      void *p = mt->val;
+      cs_load_balance_redistribute_array(mt->location_id,
+                                         CS_REAL_TYPE,
+                                         mt->dim,
+                                         &p);
+      mt->val = p;
+    }
+    else {
+      cs_lnum_t n_elts = cs_mesh_location_get_n_elts(mt->location_id)[0];
+      cs_lnum_t n_d_elts = n_elts*(cs_lnum_t)(mt->dim);
+      BFT_REALLOC(mt->val, n_d_elts, cs_real_t);
+      for (cs_lnum_t j = 0; j < n_d_elts; j++)
+        mt->val[j] = 0.;
+    }
+  }
+
+  /* Mapped time step is a field value array, which was reallocated */
+
+  if (_p_dt != NULL)
+    _p_dt = CS_F_(dt)->val;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Update all moment accumulators.
@@ -2022,136 +2240,170 @@ cs_time_moment_update_all(void)
       wa_cur_data[i] = NULL;
   }
 
-  /* Loop on variances first */
+  /* Determine which moments must be updated; a mean associated
+     with a variance is updated together with that variance */
 
-  for (int m_type = CS_TIME_MOMENT_VARIANCE;
-       m_type >= (int)CS_TIME_MOMENT_MEAN;
-       m_type --) {
+  int *m_update;
+  BFT_MALLOC(m_update, _n_moments, int);
 
-    for (i = 0; i < _n_moments; i++) {
+  for (i = 0; i < _n_moments; i++) {
+    cs_time_moment_t *mt = _moment + i;
+    m_update[i] = (   mt->nt_cur < ts->nt_cur
+                   && wa_cur_data[mt->wa_id] != NULL) ? 1 : 0;
+  }
 
-      cs_time_moment_t *mt = _moment + i;
-      cs_time_moment_wa_t *mwa = _moment_wa + mt->wa_id;
+  for (i = 0; i < _n_moments; i++) {
+    cs_time_moment_t *mt = _moment + i;
+    if (m_update[i] && mt->type == CS_TIME_MOMENT_VARIANCE) {
+      assert(mt->l_id > -1);
+      m_update[mt->l_id] = 0;
+    }
+  }
 
-      if (   mt->nt_cur < ts->nt_cur
-          && (int)(mt->type) == m_type
-          && (mwa->nt_start > -1 && mwa->nt_start <= ts->nt_cur)) {
+  /* Compute current data values, sharing them between moments
+     based on the same data (such as a mean and variance, or
+     moments with different weights) */
 
-        /* Current and accumulated weight */
+  cs_real_t **m_data, **m_val, **m_mean;
+  BFT_MALLOC(m_data, _n_moments, cs_real_t *);
+  BFT_MALLOC(m_val, _n_moments, cs_real_t *);
+  BFT_MALLOC(m_mean, _n_moments, cs_real_t *);
 
-        cs_lnum_t  wa_stride;
-        cs_real_t *restrict wa_sum, *restrict x;
+  for (i = 0; i < _n_moments; i++) {
 
-        cs_real_t *const restrict w = wa_cur_data[mt->wa_id];
+    cs_time_moment_t *mt = _moment + i;
 
-        if (mwa->location_id == CS_MESH_LOCATION_NONE) {
-          wa_sum = &(mwa->val0);
-          wa_stride = 0;
-        }
-        else {
-          wa_sum = mwa->val;
-          wa_stride = 1;
-        }
+    m_data[i] = NULL;
+    m_val[i] = NULL;
+    m_mean[i] = NULL;
+
+    if (m_update[i] == 0)
+      continue;
+
+    for (int j = 0; j < i; j++) {
+      const cs_time_moment_t *mt_j = _moment + j;
+      if (   m_data[j] != NULL
+          && mt_j->data_func == mt->data_func
+          && mt_j->data_input == mt->data_input
+          && mt_j->location_id == mt->location_id
+          && mt_j->data_dim == mt->data_dim) {
+        m_data[i] = m_data[j];
+        m_update[i] = 2; /* data not owned */
+        break;
+      }
+    }
+
+    if (m_data[i] == NULL) {
+      const cs_lnum_t n_elts
+        = cs_mesh_location_get_n_elts(mt->location_id)[0];
+      BFT_MALLOC(m_data[i], n_elts*mt->data_dim, cs_real_t);
+      mt->data_func(mt->data_input, m_data[i]);
+    }
 
-        /* Current value */
+    m_val[i] = _moment_values(mt);
+    if (mt->type == CS_TIME_MOMENT_VARIANCE)
+      m_mean[i] = _moment_values(_moment + mt->l_id);
 
-        const cs_lnum_t n_elts
-          = cs_mesh_location_get_n_elts(mt->location_id)[0];
-        const cs_lnum_t nd = n_elts * mt->dim;
+  }
+
+  /* Update moments sharing a weight accumulator and location
+     in a single sweep over element blocks */
 
-        BFT_MALLOC(x, nd, cs_real_t);
+  const cs_lnum_t block_size = 256;
 
-        mt->data_func(mt->data_input, x);
+  int *g_ids;
+  BFT_MALLOC(g_ids, _n_moments, int);
 
-        _ensure_init_moment(mt);
+  for (i = 0; i < _n_moments; i++) {
 
-        cs_real_t *restrict val = mt->val;
-        if (mt->f_id > -1) {
-          cs_field_t *f = cs_field_by_id(mt->f_id);
-          val = f->val;
+    if (m_update[i] == 0 || _moment[i].nt_cur == ts->nt_cur)
+      continue;
+
+    const int wa_id = _moment[i].wa_id;
+    const int location_id = _moment[i].location_id;
+
+    /* Group moments, variances first */
+
+    int n_g = 0;
+    for (int m_type = CS_TIME_MOMENT_VARIANCE;
+         m_type >= (int)CS_TIME_MOMENT_MEAN;
+         m_type --) {
+      for (int j = i; j < _n_moments; j++) {
+        cs_time_moment_t *mt = _moment + j;
+        if (   m_update[j] != 0 && mt->nt_cur < ts->nt_cur
+            && mt->wa_id == wa_id && mt->location_id == location_id
+            && (int)(mt->type) == m_type) {
+          g_ids[n_g++] = j;
+          mt->nt_cur = ts->nt_cur;
+          if (mt->type == CS_TIME_MOMENT_VARIANCE)
+            _moment[mt->l_id].nt_cur = ts->nt_cur;
         }
+      }
+    }
 
-        if (mt->type == CS_TIME_MOMENT_VARIANCE) {
+    /* Current and accumulated weight */
 
-          assert(mt->l_id > -1);
+    cs_time_moment_wa_t *mwa = _moment_wa + wa_id;
 
-          cs_time_moment_t *mt_mean = _moment + mt->l_id;
+    cs_lnum_t  wa_stride;
+    const cs_real_t *restrict wa_sum;
 
-          _ensure_init_moment(mt_mean);
-          cs_real_t *restrict m = mt_mean->val;
-          if (mt_mean->f_id > -1) {
-            cs_field_t *f_mean = cs_field_by_id(mt_mean->f_id);
-            m = f_mean->val;
-          }
+    const cs_real_t *restrict w = wa_cur_data[wa_id];
 
-          if (mt->dim == 6) { /* variance-covariance matrix */
-            assert(mt->data_dim == 3);
-            for (cs_lnum_t je = 0; je < n_elts; je++) {
-              double delta[3], delta_n[3], r[3], m_n[3];
-              const cs_lnum_t k = je*wa_stride;
-              const double wa_sum_n = w[k] + wa_sum[k];
-              for (cs_lnum_t l = 0; l < 3; l++) {
-                cs_lnum_t jl = je*6 + l, jml = je*3 + l;
-                delta[l]   = x[jml] - m[jml];
-                r[l] = delta[l] * (w[k] / wa_sum_n);
-                m_n[l] = m[jml] + r[l];
-                delta_n[l] = x[jml] - m_n[l];
-                val[jl] =   (val[jl]*wa_sum[k] + (w[k]*delta[l]*delta_n[l]))
-                          / wa_sum_n;
-              }
-              /* Covariance terms.
-                 Note we could have a symmetric formula using
-                   0.5*(delta[i]*delta_n[j] + delta[j]*delta_n[i])
-                 instead of
-                   delta[i]*delta_n[j]
-                 but unit tests in cs_moment_test.c do not seem to favor
-                 one variant over the other; we use the simplest one.
-              */
-              cs_lnum_t j3 = je*6 + 3, j4 = je*6 + 4, j5 = je*6 + 5;
-              val[j3] =   (val[j3]*wa_sum[k] + (w[k]*delta[0]*delta_n[1]))
-                        / wa_sum_n;
-              val[j4] =   (val[j4]*wa_sum[k] + (w[k]*delta[1]*delta_n[2]))
-                        / wa_sum_n;
-              val[j5] =   (val[j5]*wa_sum[k] + (w[k]*delta[0]*delta_n[2]))
-                        / wa_sum_n;
-              for (cs_lnum_t l = 0; l < 3; l++)
-                m[je*3 + l] += r[l];
-            }
-          }
+    if (mwa->location_id == CS_MESH_LOCATION_NONE) {
+      wa_sum = &(mwa->val0);
+      wa_stride = 0;
+    }
+    else {
+      wa_sum = mwa->val;
+      wa_stride = 1;
+    }
 
-          else { /* simple variance */
-            for (cs_lnum_t j = 0; j < nd; j++) {
-              const cs_lnum_t k = (j*wa_stride) / mt->dim;
-              double wa_sum_n = w[k] + wa_sum[k];
-              double delta = x[j] - m[j];
-              double r = delta * (w[k] / wa_sum_n);
-              double m_n = m[j] + r;
-              val[j] = (val[j]*wa_sum[k] + (w[k]*delta*(x[j]-m_n))) / wa_sum_n;
-              m[j] += r;
-            }
-          }
+    const cs_lnum_t n_elts = cs_mesh_location_get_n_elts(location_id)[0];
+    const cs_lnum_t n_blocks = (n_elts + block_size - 1) / block_size;
 
-          mt_mean->nt_cur = ts->nt_cur;
-        }
+#   pragma omp parallel for if (n_elts > CS_THR_MIN)
+    for (cs_lnum_t b_id = 0; b_id < n_blocks; b_id++) {
 
-        else if (mt->type == CS_TIME_MOMENT_MEAN) {
+      const cs_lnum_t s_id = b_id*block_size;
+      const cs_lnum_t e_id = CS_MIN(s_id + block_size, n_elts);
 
-          for (cs_lnum_t j = 0; j < nd; j++) {
-            const cs_lnum_t k = (j*wa_stride) / mt->dim;
-            val[j] += (x[j] - val[j]) * (w[k] / (w[k] + wa_sum[k]));
-          }
+      for (int g_id = 0; g_id < n_g; g_id++) {
+
+        const int m_id = g_ids[g_id];
+        const cs_time_moment_t *mt = _moment + m_id;
 
+        if (mt->type == CS_TIME_MOMENT_VARIANCE) {
+          if (mt->dim == 6) { /* variance-covariance matrix */
+            assert(mt->data_dim == 3);
+            _update_variance_6(s_id, e_id, wa_stride, w, wa_sum,
+                               m_data[m_id], m_mean[m_id], m_val[m_id]);
+          }
+          else /* simple variance */
+            _update_variance(s_id, e_id, mt->dim, wa_stride, w, wa_sum,
+                             m_data[m_id], m_mean[m_id], m_val[m_id]);
         }
+        else if (mt->type == CS_TIME_MOMENT_MEAN)
+          _update_mean(s_id, e_id, mt->dim, wa_stride, w, wa_sum,
+                       m_data[m_id], m_val[m_id]);
 
-        mt->nt_cur = ts->nt_cur;
+      }
 
-        BFT_FREE(x);
+    } /* End of loop on element blocks */
 
-      } /* End of test if moment is active */
+  } /* End of loop on moment groups */
 
-    } /* End of loop on moments */
+  BFT_FREE(g_ids);
+
+  for (i = 0; i < _n_moments; i++) {
+    if (m_update[i] == 1)
+      BFT_FREE(m_data[i]);
+  }
 
-  } /* End of loop on moment types */
+  BFT_FREE(m_mean);
+  BFT_FREE(m_val);
+  BFT_FREE(m_data);
+  BFT_FREE(m_update);
 
   /* Update and free weight data */
 
@@ -119,6 +119,14 @@ cs_time_moment_destroy_all(void);
 void
 cs_time_moment_map_cell_dt(const cs_real_t  *dt);
 
+/*----------------------------------------------------------------------------
+ * Redistribute moment accumulators during a mesh redistribution
+ * (see cs_load_balance.c).
+ *----------------------------------------------------------------------------*/
+
+void
+cs_time_moment_redistribute(void);
+
 /*----------------------------------------------------------------------------
  * Update all moment accumulators.
  *----------------------------------------------------------------------------*/
@@ -606,6 +606,37 @@ cs_timer_stats_is_active(int  id)
   return retval;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return the accumulated time for a given statistic.
+ *
+ * The returned value includes time accumulated since the last output,
+ * and the elapsed time since start if the statistic is currently active.
+ *
+ * \param[in]  id  id of statistic
+ *
+ * \return  total time counter for statistic (zero if id is invalid)
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_timer_counter_t
+cs_timer_stats_get_total(int  id)
+{
+  cs_timer_counter_t retval;
+  CS_TIMER_COUNTER_INIT(retval);
+
+  if (id >= 0 && id < _n_stats) {
+    cs_timer_stats_t  *s = _stats + id;
+    CS_TIMER_COUNTER_ADD(retval, s->t_tot, s->t_cur);
+    if (s->active) {
+      cs_timer_t t_now = cs_timer_time();
+      cs_timer_counter_add_diff(&retval, &(s->t_start), &t_now);
+    }
+  }
+
+  return retval;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Start a timer for a given statistic.
@@ -178,6 +178,22 @@ cs_timer_stats_set_plot(int  id,
 int
 cs_timer_stats_is_active(int  id);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return the accumulated time for a given statistic.
+ *
+ * The returned value includes time accumulated since the last output,
+ * and the elapsed time since start if the statistic is currently active.
+ *
+ * \param[in]  id  id of statistic
+ *
+ * \return  total time counter for statistic (zero if id is invalid)
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_timer_counter_t
+cs_timer_stats_get_total(int  id);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Start a timer for a given statistic.
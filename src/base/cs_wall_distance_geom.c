@@ -0,0 +1,1408 @@
+/*============================================================================
+ * Geometric wall distance computation using bounding volume hierarchies.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(HAVE_MPI)
+#include <mpi.h>
+#endif
+
+#if defined(HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+/*----------------------------------------------------------------------------
+ * Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "bft_mem.h"
+#include "bft_printf.h"
+
+#include "cs_all_to_all.h"
+#include "cs_field.h"
+#include "cs_halo.h"
+#include "cs_log.h"
+#include "cs_math.h"
+#include "cs_mesh.h"
+#include "cs_mesh_quantities.h"
+#include "cs_parall.h"
+#include "cs_parameters.h"
+#include "cs_prototypes.h"
+#include "cs_timer.h"
+
+/*----------------------------------------------------------------------------
+ * Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_wall_distance_geom.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Additional doxygen documentation
+ *============================================================================*/
+
+/*!
+  \file cs_wall_distance_geom.c
+        Geometric wall distance computation using bounding volume
+        hierarchies.
+
+  Wall faces of each rank are organized in a bounding volume hierarchy
+  (BVH), so that the nearest wall face of a given point may be found
+  in logarithmic time. The boxes of the top levels of each rank's
+  hierarchy are shared by all ranks, so as to determine which ranks
+  may hold a wall face closer than the nearest local one; the matching
+  queries are then sent to those ranks only.
+*/
+
+/*! \cond DOXYGEN_SHOULD_SKIP_THIS */
+
+/*=============================================================================
+ * Local macro definitions
+ *============================================================================*/
+
+/* Maximum number of elements in a BVH leaf */
+
+#define _BVH_LEAF_SIZE  4
+
+/* Maximum depth of a BVH (deeper nodes are merged in leaves) */
+
+#define _BVH_MAX_DEPTH  64
+
+/* Depth of BVH nodes whose bounding boxes are shared with other ranks */
+
+#define _BVH_TOP_DEPTH  3
+#define _N_RANK_BOXES   (1 << _BVH_TOP_DEPTH)
+
+/*============================================================================
+ * Type definitions
+ *============================================================================*/
+
+/* BVH node */
+
+typedef struct {
+
+  cs_real_t  box[6];       /* bounding box (min x, y, z, max x, y, z) */
+  cs_lnum_t  start;        /* id of first element (leaves) */
+  cs_lnum_t  n_elts;       /* number of elements (leaves), 0 otherwise */
+  cs_lnum_t  right;        /* id of right child (the left child is the
+                              next node) */
+
+} _bvh_node_t;
+
+/* Bounding volume hierarchy */
+
+typedef struct {
+
+  cs_lnum_t     n_elts;    /* number of elements */
+  cs_lnum_t    *elt_id;    /* element ids, in tree order */
+  cs_real_t    *elt_box;   /* element bounding boxes, in tree order */
+
+  cs_lnum_t     n_nodes;   /* number of nodes */
+  _bvh_node_t  *nodes;     /* nodes, in depth-first order */
+
+} _bvh_t;
+
+/*============================================================================
+ * Static global variables
+ *============================================================================*/
+
+/* Hierarchy of local wall faces, kept between calls */
+
+static _bvh_t  *_wall_bvh = NULL;
+
+/* Ids of wall faces used to build the hierarchy */
+
+static cs_lnum_t  *_w_face_ids = NULL;
+
+/*============================================================================
+ * Private function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Initialize a bounding box to an empty box.
+ *
+ * parameters:
+ *   box <-- bounding box
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_box_init(cs_real_t  box[6])
+{
+  for (int j = 0; j < 3; j++) {
+    box[j] = cs_math_infinite_r;
+    box[j+3] = -cs_math_infinite_r;
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Extend a bounding box with another box.
+ *
+ * parameters:
+ *   box   <-> bounding box
+ *   other <-- box to add
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_box_add(cs_real_t        box[6],
+         const cs_real_t  other[6])
+{
+  for (int j = 0; j < 3; j++) {
+    if (other[j] < box[j])
+      box[j] = other[j];
+    if (other[j+3] > box[j+3])
+      box[j+3] = other[j+3];
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Extend a bounding box with a point.
+ *
+ * parameters:
+ *   box <-> bounding box
+ *   p   <-- point coordinates
+ *----------------------------------------------------------------------------*/
+
+static inline void
+_box_add_point(cs_real_t        box[6],
+               const cs_real_t  p[3])
+{
+  for (int j = 0; j < 3; j++) {
+    if (p[j] < box[j])
+      box[j] = p[j];
+    if (p[j] > box[j+3])
+      box[j+3] = p[j];
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Return the minimum squared distance from a point to a bounding box.
+ *
+ * parameters:
+ *   box <-- bounding box
+ *   p   <-- point coordinates
+ *
+ * returns:
+ *   squared distance from p to the nearest point of the box
+ *----------------------------------------------------------------------------*/
+
+static inline cs_real_t
+_box_dist2_min(const cs_real_t  box[6],
+               const cs_real_t  p[3])
+{
+  cs_real_t d2 = 0.;
+
+  for (int j = 0; j < 3; j++) {
+    cs_real_t d = 0.;
+    if (p[j] < box[j])
+      d = box[j] - p[j];
+    else if (p[j] > box[j+3])
+      d = p[j] - box[j+3];
+    d2 += d*d;
+  }
+
+  return d2;
+}
+
+/*----------------------------------------------------------------------------
+ * Return the maximum squared distance from a point to a bounding box.
+ *
+ * Any element contained in the box is closer to the point than
+ * this distance.
+ *
+ * parameters:
+ *   box <-- bounding box
+ *   p   <-- point coordinates
+ *
+ * returns:
+ *   squared distance from p to the farthest point of the box
+ *----------------------------------------------------------------------------*/
+
+static inline cs_real_t
+_box_dist2_max(const cs_real_t  box[6],
+               const cs_real_t  p[3])
+{
+  cs_real_t d2 = 0.;
+
+  for (int j = 0; j < 3; j++) {
+    cs_real_t d = CS_MAX(CS_ABS(p[j] - box[j]), CS_ABS(box[j+3] - p[j]));
+    d2 += d*d;
+  }
+
+  return d2;
+}
+
+/*----------------------------------------------------------------------------
+ * Return the squared distance from a point to a triangle.
+ *
+ * The closest point is determined using the Voronoi regions of the
+ * triangle's vertices and edges.
+ *
+ * parameters:
+ *   p <-- point coordinates
+ *   a <-- first triangle vertex coordinates
+ *   b <-- second triangle vertex coordinates
+ *   c <-- third triangle vertex coordinates
+ *
+ * returns:
+ *   squared distance from p to the triangle
+ *----------------------------------------------------------------------------*/
+
+static cs_real_t
+_triangle_dist2(const cs_real_t  p[3],
+                const cs_real_t  a[3],
+                const cs_real_t  b[3],
+                const cs_real_t  c[3])
+{
+  cs_real_t ab[3], ac[3], ap[3], q[3];
+
+  for (int j = 0; j < 3; j++) {
+    ab[j] = b[j] - a[j];
+    ac[j] = c[j] - a[j];
+    ap[j] = p[j] - a[j];
+  }
+
+  const cs_real_t d1 = cs_math_3_dot_product(ab, ap);
+  const cs_real_t d2 = cs_math_3_dot_product(ac, ap);
+
+  if (d1 <= 0. && d2 <= 0.)
+    return cs_math_3_square_distance(p, a);
+
+  cs_real_t bp[3];
+  for (int j = 0; j < 3; j++)
+    bp[j] = p[j] - b[j];
+
+  const cs_real_t d3 = cs_math_3_dot_product(ab, bp);
+  const cs_real_t d4 = cs_math_3_dot_product(ac, bp);
+
+  if (d3 >= 0. && d4 <= d3)
+    return cs_math_3_square_distance(p, b);
+
+  const cs_real_t vc = d1*d4 - d3*d2;
+  if (vc <= 0. && d1 >= 0. && d3 <= 0.) {
+    const cs_real_t v = d1 / (d1 - d3);
+    for (int j = 0; j < 3; j++)
+      q[j] = a[j] + v*ab[j];
+    return cs_math_3_square_distance(p, q);
+  }
+
+  cs_real_t cp[3];
+  for (int j = 0; j < 3; j++)
+    cp[j] = p[j] - c[j];
+
+  const cs_real_t d5 = cs_math_3_dot_product(ab, cp);
+  const cs_real_t d6 = cs_math_3_dot_product(ac, cp);
+
+  if (d6 >= 0. && d5 <= d6)
+    return cs_math_3_square_distance(p, c);
+
+  const cs_real_t vb = d5*d2 - d1*d6;
+  if (vb <= 0. && d2 >= 0. && d6 <= 0.) {
+    const cs_real_t w = d2 / (d2 - d6);
+    for (int j = 0; j < 3; j++)
+      q[j] = a[j] + w*ac[j];
+    return cs_math_3_square_distance(p, q);
+  }
+
+  const cs_real_t va = d3*d6 - d5*d4;
+  if (va <= 0. && (d4 - d3) >= 0. && (d5 - d6) >= 0.) {
+    const cs_real_t w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    for (int j = 0; j < 3; j++)
+      q[j] = b[j] + w*(c[j] - b[j]);
+    return cs_math_3_square_distance(p, q);
+  }
+
+  /* Projection is inside the triangle */
+
+  const cs_real_t denom = va + vb + vc;
+
+  if (denom > 0.) {
+    const cs_real_t v = vb / denom;
+    const cs_real_t w = vc / denom;
+    for (int j = 0; j < 3; j++)
+      q[j] = a[j] + ab[j]*v + ac[j]*w;
+    return cs_math_3_square_distance(p, q);
+  }
+
+  /* Degenerate triangle */
+
+  return CS_MIN(cs_math_3_square_distance(p, a),
+                CS_MIN(cs_math_3_square_distance(p, b),
+                       cs_math_3_square_distance(p, c)));
+}
+
+/*----------------------------------------------------------------------------
+ * Return the squared distance from a point to a boundary face.
+ *
+ * Faces with more than 3 vertices are split into triangles joining
+ * each edge to the face center.
+ *
+ * parameters:
+ *   m          <-- pointer to mesh structure
+ *   b_face_cog <-- boundary face centers
+ *   f_id       <-- boundary face id
+ *   p          <-- point coordinates
+ *
+ * returns:
+ *   squared distance from p to the face
+ *----------------------------------------------------------------------------*/
+
+static cs_real_t
+_b_face_dist2(const cs_mesh_t  *m,
+              const cs_real_t   b_face_cog[],
+              cs_lnum_t         f_id,
+              const cs_real_t   p[3])
+{
+  const cs_lnum_t s_id = m->b_face_vtx_idx[f_id];
+  const cs_lnum_t e_id = m->b_face_vtx_idx[f_id+1];
+  const cs_lnum_t *vtx_ids = m->b_face_vtx_lst;
+  const cs_real_t *vtx_coord = m->vtx_coord;
+
+  if (e_id - s_id == 3)
+    return _triangle_dist2(p,
+                           vtx_coord + 3*vtx_ids[s_id],
+                           vtx_coord + 3*vtx_ids[s_id+1],
+                           vtx_coord + 3*vtx_ids[s_id+2]);
+
+  const cs_real_t *f_cog = b_face_cog + 3*f_id;
+
+  cs_real_t d2 = cs_math_infinite_r;
+
+  for (cs_lnum_t i = s_id; i < e_id; i++) {
+    cs_lnum_t j = (i < e_id - 1) ? i+1 : s_id;
+    cs_real_t t_d2 = _triangle_dist2(p,
+                                     f_cog,
+                                     vtx_coord + 3*vtx_ids[i],
+                                     vtx_coord + 3*vtx_ids[j]);
+    if (t_d2 < d2)
+      d2 = t_d2;
+  }
+
+  return d2;
+}
+
+/*----------------------------------------------------------------------------
+ * Compute the bounding box of a boundary face.
+ *
+ * parameters:
+ *   m          <-- pointer to mesh structure
+ *   b_face_cog <-- boundary face centers
+ *   f_id       <-- boundary face id
+ *   box        --> bounding box
+ *----------------------------------------------------------------------------*/
+
+static void
+_b_face_box(const cs_mesh_t  *m,
+            const cs_real_t   b_face_cog[],
+            cs_lnum_t         f_id,
+            cs_real_t         box[6])
+{
+  _box_init(box);
+
+  for (cs_lnum_t i = m->b_face_vtx_idx[f_id];
+       i < m->b_face_vtx_idx[f_id+1];
+       i++)
+    _box_add_point(box, m->vtx_coord + 3*m->b_face_vtx_lst[i]);
+
+  /* The face center is used for the triangulation */
+
+  _box_add_point(box, b_face_cog + 3*f_id);
+}
+
+/*----------------------------------------------------------------------------
+ * Build a BVH node and its descendants (recursive).
+ *
+ * Elements are split at the middle of the longest extent of their centers.
+ *
+ * parameters:
+ *   bvh     <-> hierarchy being built
+ *   elt_box <-- element bounding boxes (initial order)
+ *   ctr     <-> element box centers, in current tree order
+ *   start   <-- id of first element of node
+ *   n_elts  <-- number of elements of node
+ *   depth   <-- node depth
+ *
+ * returns:
+ *   id of the built node
+ *----------------------------------------------------------------------------*/
+
+static cs_lnum_t
+_bvh_build_node(_bvh_t           *bvh,
+                const cs_real_t   elt_box[],
+                cs_real_t         ctr[],
+                cs_lnum_t         start,
+                cs_lnum_t         n_elts,
+                int               depth)
+{
+  const cs_lnum_t node_id = bvh->n_nodes;
+  _bvh_node_t *node = bvh->nodes + node_id;
+
+  bvh->n_nodes += 1;
+
+  _box_init(node->box);
+
+  cs_real_t c_box[6];
+  _box_init(c_box);
+
+  for (cs_lnum_t i = start; i < start + n_elts; i++) {
+    _box_add(node->box, elt_box + 6*bvh->elt_id[i]);
+    _box_add_point(c_box, ctr + 3*i);
+  }
+
+  node->start = start;
+  node->n_elts = n_elts;
+  node->right = -1;
+
+  if (n_elts <= _BVH_LEAF_SIZE || depth >= _BVH_MAX_DEPTH)
+    return node_id;
+
+  /* Split along the longest extent of element centers */
+
+  int axis = 0;
+  for (int j = 1; j < 3; j++) {
+    if (c_box[j+3] - c_box[j] > c_box[axis+3] - c_box[axis])
+      axis = j;
+  }
+
+  const cs_real_t mid = 0.5*(c_box[axis] + c_box[axis+3]);
+
+  cs_lnum_t n_left = n_elts/2;
+
+  if (c_box[axis+3] > c_box[axis]) {
+
+    cs_lnum_t i = start, j = start + n_elts - 1;
+
+    while (i <= j) {
+      if (ctr[3*i + axis] < mid)
+        i++;
+      else {
+        cs_lnum_t t_id = bvh->elt_id[i];
+        bvh->elt_id[i] = bvh->elt_id[j];
+        bvh->elt_id[j] = t_id;
+        for (int k = 0; k < 3; k++) {
+          cs_real_t t = ctr[3*i + k];
+          ctr[3*i + k] = ctr[3*j + k];
+          ctr[3*j + k] = t;
+        }
+        j--;
+      }
+    }
+
+    n_left = i - start;
+
+  }
+
+  assert(n_left > 0 && n_left < n_elts);
+
+  node->n_elts = 0;
+
+  _bvh_build_node(bvh, elt_box, ctr, start, n_left, depth + 1);
+
+  cs_lnum_t right = _bvh_build_node(bvh, elt_box, ctr,
+                                    start + n_left, n_elts - n_left,
+                                    depth + 1);
+
+  bvh->nodes[node_id].right = right;
+
+  return node_id;
+}
+
+/*----------------------------------------------------------------------------
+ * Create a bounding volume hierarchy over a set of boxes.
+ *
+ * parameters:
+ *   n_elts  <-- number of elements
+ *   elt_box <-- element bounding boxes
+ *
+ * returns:
+ *   pointer to newly created hierarchy
+ *----------------------------------------------------------------------------*/
+
+static _bvh_t *
+_bvh_create(cs_lnum_t        n_elts,
+            const cs_real_t  elt_box[])
+{
+  _bvh_t *bvh;
+
+  BFT_MALLOC(bvh, 1, _bvh_t);
+
+  bvh->n_elts = n_elts;
+  bvh->n_nodes = 0;
+
+  BFT_MALLOC(bvh->elt_id, n_elts, cs_lnum_t);
+  BFT_MALLOC(bvh->elt_box, n_elts*6, cs_real_t);
+  BFT_MALLOC(bvh->nodes, CS_MAX(2*n_elts, 1), _bvh_node_t);
+
+  if (n_elts == 0)
+    return bvh;
+
+  cs_real_t *ctr;
+  BFT_MALLOC(ctr, n_elts*3, cs_real_t);
+
+  for (cs_lnum_t i = 0; i < n_elts; i++) {
+    bvh->elt_id[i] = i;
+    for (int j = 0; j < 3; j++)
+      ctr[i*3 + j] = 0.5*(elt_box[i*6 + j] + elt_box[i*6 + j + 3]);
+  }
+
+  _bvh_build_node(bvh, elt_box, ctr, 0, n_elts, 0);
+
+  BFT_FREE(ctr);
+
+  BFT_REALLOC(bvh->nodes, bvh->n_nodes, _bvh_node_t);
+
+  for (cs_lnum_t i = 0; i < n_elts; i++)
+    memcpy(bvh->elt_box + 6*i, elt_box + 6*bvh->elt_id[i],
+           6*sizeof(cs_real_t));
+
+  return bvh;
+}
+
+/*----------------------------------------------------------------------------
+ * Destroy a bounding volume hierarchy.
+ *
+ * parameters:
+ *   bvh <-> pointer to hierarchy
+ *----------------------------------------------------------------------------*/
+
+static void
+_bvh_destroy(_bvh_t  **bvh)
+{
+  _bvh_t *_bvh = *bvh;
+
+  if (_bvh == NULL)
+    return;
+
+  BFT_FREE(_bvh->elt_id);
+  BFT_FREE(_bvh->elt_box);
+  BFT_FREE(_bvh->nodes);
+
+  BFT_FREE(*bvh);
+}
+
+/*----------------------------------------------------------------------------
+ * Update the node bounding boxes of a hierarchy whose element boxes
+ * have changed, keeping its topology.
+ *
+ * parameters:
+ *   bvh <-> pointer to hierarchy
+ *----------------------------------------------------------------------------*/
+
+static void
+_bvh_refit(_bvh_t  *bvh)
+{
+  /* Children always follow their parent in depth-first order */
+
+  for (cs_lnum_t node_id = bvh->n_nodes - 1; node_id > -1; node_id--) {
+
+    _bvh_node_t *node = bvh->nodes + node_id;
+
+    _box_init(node->box);
+
+    if (node->n_elts > 0) {
+      for (cs_lnum_t i = node->start; i < node->start + node->n_elts; i++)
+        _box_add(node->box, bvh->elt_box + 6*i);
+    }
+    else {
+      _box_add(node->box, bvh->nodes[node_id + 1].box);
+      _box_add(node->box, bvh->nodes[node->right].box);
+    }
+
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Copy the bounding boxes of the top levels of a hierarchy.
+ *
+ * parameters:
+ *   bvh   <-- pointer to hierarchy
+ *   boxes --> bounding boxes (size: _N_RANK_BOXES*6); unused
+ *             boxes are empty
+ *----------------------------------------------------------------------------*/
+
+static void
+_bvh_top_boxes(const _bvh_t  *bvh,
+               cs_real_t      boxes[])
+{
+  for (int i = 0; i < _N_RANK_BOXES; i++)
+    _box_init(boxes + 6*i);
+
+  if (bvh->n_nodes == 0)
+    return;
+
+  cs_lnum_t stack[2*_BVH_TOP_DEPTH + 2];
+  int depth[2*_BVH_TOP_DEPTH + 2];
+  int n_stack = 1, n_boxes = 0;
+
+  stack[0] = 0;
+  depth[0] = 0;
+
+  while (n_stack > 0) {
+
+    n_stack--;
+    const _bvh_node_t *node = bvh->nodes + stack[n_stack];
+    const int n_depth = depth[n_stack];
+
+    if (node->n_elts > 0 || n_depth == _BVH_TOP_DEPTH) {
+      memcpy(boxes + 6*n_boxes, node->box, 6*sizeof(cs_real_t));
+      n_boxes++;
+    }
+    else {
+      stack[n_stack] = node->right;
+      depth[n_stack] = n_depth + 1;
+      stack[n_stack + 1] = (node - bvh->nodes) + 1;
+      depth[n_stack + 1] = n_depth + 1;
+      n_stack += 2;
+    }
+
+  }
+
+  assert(n_boxes <= _N_RANK_BOXES);
+}
+
+/*----------------------------------------------------------------------------
+ * Return the squared distance from a point to the nearest boundary face
+ * of a hierarchy.
+ *
+ * parameters:
+ *   bvh        <-- hierarchy of boundary faces
+ *   m          <-- pointer to mesh structure
+ *   b_face_cog <-- boundary face centers
+ *   p          <-- point coordinates
+ *   d2_max     <-- only faces closer than this squared distance are searched
+ *
+ * returns:
+ *   squared distance to the nearest face, or d2_max if no face is closer
+ *----------------------------------------------------------------------------*/
+
+static cs_real_t
+_bvh_nearest_face(const _bvh_t     *bvh,
+                  const cs_mesh_t  *m,
+                  const cs_real_t   b_face_cog[],
+                  const cs_real_t   p[3],
+                  cs_real_t         d2_max)
+{
+  cs_real_t d2 = d2_max;
+
+  if (bvh->n_nodes == 0)
+    return d2;
+
+  cs_lnum_t stack[_BVH_MAX_DEPTH + 2];
+  int n_stack = 1;
+
+  stack[0] = 0;
+
+  while (n_stack > 0) {
+
+    n_stack--;
+    const cs_lnum_t node_id = stack[n_stack];
+    const _bvh_node_t *node = bvh->nodes + node_id;
+
+    if (_box_dist2_min(node->box, p) >= d2)
+      continue;
+
+    if (node->n_elts > 0) {
+      for (cs_lnum_t i = node->start; i < node->start + node->n_elts; i++) {
+        if (_box_dist2_min(bvh->elt_box + 6*i, p) < d2) {
+          cs_real_t f_d2 = _b_face_dist2(m, b_face_cog, bvh->elt_id[i], p);
+          if (f_d2 < d2)
+            d2 = f_d2;
+        }
+      }
+    }
+
+    else {
+
+      /* Visit nearest child first */
+
+      cs_lnum_t c_id[2] = {node_id + 1, node->right};
+      cs_real_t c_d2[2] = {_box_dist2_min(bvh->nodes[c_id[0]].box, p),
+                           _box_dist2_min(bvh->nodes[c_id[1]].box, p)};
+
+      int near = (c_d2[1] < c_d2[0]) ? 1 : 0;
+
+      if (c_d2[1-near] < d2)
+        stack[n_stack++] = c_id[1-near];
+      if (c_d2[near] < d2)
+        stack[n_stack++] = c_id[near];
+
+    }
+
+  }
+
+  return d2;
+}
+
+#if defined(HAVE_MPI)
+
+/*----------------------------------------------------------------------------
+ * Return the minimum over the elements of a hierarchy of the maximum
+ * squared distance from a point to the element's box.
+ *
+ * parameters:
+ *   bvh    <-- hierarchy of boxes
+ *   p      <-- point coordinates
+ *   d2_max <-- initial upper bound
+ *
+ * returns:
+ *   upper bound of the squared distance from p to the nearest element
+ *----------------------------------------------------------------------------*/
+
+static cs_real_t
+_bvh_upper_bound(const _bvh_t     *bvh,
+                 const cs_real_t   p[3],
+                 cs_real_t         d2_max)
+{
+  cs_real_t d2 = d2_max;
+
+  if (bvh->n_nodes == 0)
+    return d2;
+
+  cs_lnum_t stack[_BVH_MAX_DEPTH + 2];
+  int n_stack = 1;
+
+  stack[0] = 0;
+
+  while (n_stack > 0) {
+
+    n_stack--;
+    const cs_lnum_t node_id = stack[n_stack];
+    const _bvh_node_t *node = bvh->nodes + node_id;
+
+    if (_box_dist2_min(node->box, p) >= d2)
+      continue;
+
+    if (node->n_elts > 0) {
+      for (cs_lnum_t i = node->start; i < node->start + node->n_elts; i++) {
+        cs_real_t b_d2 = _box_dist2_max(bvh->elt_box + 6*i, p);
+        if (b_d2 < d2)
+          d2 = b_d2;
+      }
+    }
+    else {
+      stack[n_stack++] = node->right;
+      stack[n_stack++] = node_id + 1;
+    }
+
+  }
+
+  return d2;
+}
+
+/*----------------------------------------------------------------------------
+ * Determine the ranks owning boxes closer to a point than a given
+ * squared distance.
+ *
+ * parameters:
+ *   bvh      <-- hierarchy of rank boxes
+ *   box_rank <-- rank associated with each box
+ *   p        <-- point coordinates
+ *   d2_max   <-- squared distance
+ *   tag      <-- tag for the current point
+ *   rank_tag <-> last tag for which each rank was selected
+ *   ranks    --> selected ranks, or NULL
+ *
+ * returns:
+ *   number of selected ranks
+ *----------------------------------------------------------------------------*/
+
+static int
+_bvh_select_ranks(const _bvh_t     *bvh,
+                  const int         box_rank[],
+                  const cs_real_t   p[3],
+                  cs_real_t         d2_max,
+                  cs_lnum_t         tag,
+                  cs_lnum_t         rank_tag[],
+                  int               ranks[])
+{
+  int n_ranks = 0;
+
+  if (bvh->n_nodes == 0)
+    return n_ranks;
+
+  cs_lnum_t stack[_BVH_MAX_DEPTH + 2];
+  int n_stack = 1;
+
+  stack[0] = 0;
+
+  while (n_stack > 0) {
+
+    n_stack--;
+    const cs_lnum_t node_id = stack[n_stack];
+    const _bvh_node_t *node = bvh->nodes + node_id;
+
+    if (_box_dist2_min(node->box, p) >= d2_max)
+      continue;
+
+    if (node->n_elts > 0) {
+      for (cs_lnum_t i = node->start; i < node->start + node->n_elts; i++) {
+        const int rank_id = box_rank[bvh->elt_id[i]];
+        if (   rank_tag[rank_id] != tag
+            && _box_dist2_min(bvh->elt_box + 6*i, p) < d2_max) {
+          rank_tag[rank_id] = tag;
+          if (ranks != NULL)
+            ranks[n_ranks] = rank_id;
+          n_ranks++;
+        }
+      }
+    }
+    else {
+      stack[n_stack++] = node->right;
+      stack[n_stack++] = node_id + 1;
+    }
+
+  }
+
+  return n_ranks;
+}
+
+/*----------------------------------------------------------------------------
+ * Update squared wall distances with faces located on other ranks.
+ *
+ * parameters:
+ *   bvh        <-- hierarchy of local wall faces
+ *   m          <-- pointer to mesh structure
+ *   b_face_cog <-- boundary face centers
+ *   cell_cen   <-- cell centers
+ *   d2         <-> squared distance to the nearest wall for each cell
+ *----------------------------------------------------------------------------*/
+
+static void
+_remote_queries(const _bvh_t       *bvh,
+                const cs_mesh_t    *m,
+                const cs_real_t     b_face_cog[],
+                const cs_real_3_t   cell_cen[],
+                cs_real_t           d2[])
+{
+  const int n_ranks = cs_glob_n_ranks;
+  const int l_rank = cs_glob_rank_id;
+  const cs_lnum_t n_cells = m->n_cells;
+
+  /* Share top-level boxes of each rank's hierarchy */
+
+  cs_real_t l_boxes[_N_RANK_BOXES*6];
+  cs_real_t *g_boxes;
+
+  _bvh_top_boxes(bvh, l_boxes);
+
+  BFT_MALLOC(g_boxes, n_ranks*_N_RANK_BOXES*6, cs_real_t);
+
+  MPI_Allgather(l_boxes, _N_RANK_BOXES*6, CS_MPI_REAL,
+                g_boxes, _N_RANK_BOXES*6, CS_MPI_REAL,
+                cs_glob_mpi_comm);
+
+  /* Hierarchy of non-empty boxes of other ranks */
+
+  cs_lnum_t n_r_boxes = 0;
+  int *box_rank;
+
+  BFT_MALLOC(box_rank, n_ranks*_N_RANK_BOXES, int);
+
+  for (int rank_id = 0; rank_id < n_ranks; rank_id++) {
+    if (rank_id == l_rank)
+      continue;
+    for (int i = 0; i < _N_RANK_BOXES; i++) {
+      const cs_real_t *box = g_boxes + (rank_id*_N_RANK_BOXES + i)*6;
+      if (box[0] <= box[3]) {
+        memmove(g_boxes + n_r_boxes*6, box, 6*sizeof(cs_real_t));
+        box_rank[n_r_boxes] = rank_id;
+        n_r_boxes++;
+      }
+    }
+  }
+
+  _bvh_t *r_bvh = _bvh_create(n_r_boxes, g_boxes);
+
+  BFT_FREE(g_boxes);
+
+  /* Count queries for each cell: ranks which may hold a wall face
+     closer than the nearest known one */
+
+  cs_lnum_t *q_idx;
+  BFT_MALLOC(q_idx, n_cells + 1, cs_lnum_t);
+
+  q_idx[0] = 0;
+
+# pragma omp parallel if (n_cells > CS_THR_MIN)
+  {
+    cs_lnum_t *rank_tag;
+    BFT_MALLOC(rank_tag, n_ranks, cs_lnum_t);
+    for (int i = 0; i < n_ranks; i++)
+      rank_tag[i] = -1;
+
+#   pragma omp for
+    for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+      const cs_real_t *p = cell_cen[c_id];
+      d2[c_id] = _bvh_upper_bound(r_bvh, p, d2[c_id]);
+      q_idx[c_id+1] = _bvh_select_ranks(r_bvh, box_rank, p, d2[c_id],
+                                        c_id, rank_tag, NULL);
+    }
+
+    BFT_FREE(rank_tag);
+  }
+
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++)
+    q_idx[c_id+1] += q_idx[c_id];
+
+  const cs_lnum_t n_queries = q_idx[n_cells];
+
+  /* Build queries: point coordinates and current upper bound */
+
+  int *dest_rank;
+  cs_real_t *q_data;
+
+  BFT_MALLOC(dest_rank, n_queries, int);
+  BFT_MALLOC(q_data, n_queries*4, cs_real_t);
+
+# pragma omp parallel if (n_cells > CS_THR_MIN)
+  {
+    cs_lnum_t *rank_tag;
+    BFT_MALLOC(rank_tag, n_ranks, cs_lnum_t);
+    for (int i = 0; i < n_ranks; i++)
+      rank_tag[i] = -1;
+
+#   pragma omp for
+    for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+      const cs_real_t *p = cell_cen[c_id];
+      _bvh_select_ranks(r_bvh, box_rank, p, d2[c_id],
+                        c_id, rank_tag, dest_rank + q_idx[c_id]);
+      for (cs_lnum_t q_id = q_idx[c_id]; q_id < q_idx[c_id+1]; q_id++) {
+        for (int j = 0; j < 3; j++)
+          q_data[q_id*4 + j] = p[j];
+        q_data[q_id*4 + 3] = d2[c_id];
+      }
+    }
+
+    BFT_FREE(rank_tag);
+  }
+
+  _bvh_destroy(&r_bvh);
+  BFT_FREE(box_rank);
+
+  /* Exchange queries and answer them */
+
+  cs_all_to_all_t *d = cs_all_to_all_create(n_queries,
+                                            0, /* flags */
+                                            NULL,
+                                            dest_rank,
+                                            cs_glob_mpi_comm);
+
+  cs_real_t *r_data = cs_all_to_all_copy_array(d,
+                                               CS_REAL_TYPE,
+                                               4,
+                                               false, /* reverse */
+                                               q_data,
+                                               NULL);
+
+  const cs_lnum_t n_r_queries = cs_all_to_all_n_elts_dest(d);
+
+  cs_real_t *r_d2;
+  BFT_MALLOC(r_d2, n_r_queries, cs_real_t);
+
+# pragma omp parallel for if (n_r_queries > CS_THR_MIN)
+  for (cs_lnum_t i = 0; i < n_r_queries; i++)
+    r_d2[i] = _bvh_nearest_face(bvh, m, b_face_cog,
+                                r_data + i*4, r_data[i*4 + 3]);
+
+  BFT_FREE(r_data);
+
+  cs_all_to_all_copy_array(d,
+                           CS_REAL_TYPE,
+                           1,
+                           true, /* reverse */
+                           r_d2,
+                           q_data);
+
+  BFT_FREE(r_d2);
+
+  cs_all_to_all_destroy(&d);
+
+  BFT_FREE(dest_rank);
+
+  /* Keep nearest */
+
+# pragma omp parallel for if (n_cells > CS_THR_MIN)
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+    for (cs_lnum_t q_id = q_idx[c_id]; q_id < q_idx[c_id+1]; q_id++) {
+      if (q_data[q_id] < d2[c_id])
+        d2[c_id] = q_data[q_id];
+    }
+  }
+
+  BFT_FREE(q_data);
+  BFT_FREE(q_idx);
+}
+
+#endif /* defined(HAVE_MPI) */
+
+/*----------------------------------------------------------------------------
+ * Log minimum and maximum wall distance.
+ *
+ * parameters:
+ *   n_cells <-- number of cells
+ *   dist    <-- wall distance
+ *   d_min   --> minimum distance
+ *   d_max   --> maximum distance
+ *----------------------------------------------------------------------------*/
+
+static void
+_dist_bounds(cs_lnum_t        n_cells,
+             const cs_real_t  dist[],
+             cs_real_t       *d_min,
+             cs_real_t       *d_max)
+{
+  cs_real_t _d_min = cs_math_big_r, _d_max = -cs_math_big_r;
+
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+    _d_min = CS_MIN(_d_min, dist[c_id]);
+    _d_max = CS_MAX(_d_max, dist[c_id]);
+  }
+
+  cs_parall_min(1, CS_REAL_TYPE, &_d_min);
+  cs_parall_max(1, CS_REAL_TYPE, &_d_max);
+
+  *d_min = _d_min;
+  *d_max = _d_max;
+}
+
+/*----------------------------------------------------------------------------
+ * Log comparison of the Poisson equation based and geometric wall
+ * distances.
+ *
+ * parameters:
+ *   n_cells  <-- number of cells
+ *   dist_ref <-- wall distance based on the Poisson equation
+ *   dist     <-- geometric wall distance
+ *   t_ref    <-- elapsed time for Poisson equation based method
+ *   t_geom   <-- elapsed time for geometric method
+ *----------------------------------------------------------------------------*/
+
+static void
+_log_comparison(cs_lnum_t        n_cells,
+                const cs_real_t  dist_ref[],
+                const cs_real_t  dist[],
+                double           t_ref,
+                double           t_geom)
+{
+  cs_real_t b_ref[2], b_geom[2];
+
+  _dist_bounds(n_cells, dist_ref, b_ref, b_ref + 1);
+  _dist_bounds(n_cells, dist, b_geom, b_geom + 1);
+
+  cs_real_t s[2] = {0., 0.};     /* sum of absolute, relative differences */
+  cs_real_t d_max[2] = {0., 0.}; /* max. absolute, relative differences */
+
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+    cs_real_t d = CS_ABS(dist_ref[c_id] - dist[c_id]);
+    cs_real_t r = (dist[c_id] > 0.) ? d / dist[c_id] : 0.;
+    s[0] += d;
+    s[1] += r;
+    d_max[0] = CS_MAX(d_max[0], d);
+    d_max[1] = CS_MAX(d_max[1], r);
+  }
+
+  cs_gnum_t n_g_cells = n_cells;
+
+  cs_parall_counter(&n_g_cells, 1);
+  cs_parall_sum(2, CS_REAL_TYPE, s);
+  cs_parall_max(2, CS_REAL_TYPE, d_max);
+
+  if (n_g_cells > 0) {
+    s[0] /= n_g_cells;
+    s[1] /= n_g_cells;
+  }
+
+  cs_log_printf
+    (CS_LOG_DEFAULT,
+     _("\n"
+       "  Wall distance: comparison of methods\n\n"
+       "                         Poisson equation     geometric\n"
+       "    Elapsed time (s)       %12.5f    %12.5f\n"
+       "    Min distance           %12.5e    %12.5e\n"
+       "    Max distance           %12.5e    %12.5e\n\n"
+       "  Difference relative to geometric distance:\n"
+       "                             absolute        relative\n"
+       "    Mean                   %12.5e    %12.5e\n"
+       "    Max                    %12.5e    %12.5e\n\n"),
+     t_ref, t_geom,
+     b_ref[0], b_geom[0],
+     b_ref[1], b_geom[1],
+     s[0], s[1],
+     d_max[0], d_max[1]);
+}
+
+/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Compute the distance from cell centers to the nearest wall face
+ *        using a geometric method.
+ *
+ * Wall faces are boundary faces whose type is \ref CS_SMOOTHWALL or
+ * \ref CS_ROUGHWALL. The distance computed is the exact distance to the
+ * (triangulated) wall faces, which may be located on any rank.
+ *
+ * The bounding volume hierarchy built over local wall faces is kept
+ * between calls, and only its bounding boxes are updated when the
+ * set of wall faces is unchanged (such as with a moving mesh).
+ *
+ * Periodicity is not taken into account.
+ *
+ * \param[in]   bc_type  type of boundary for each face
+ * \param[out]  dist     distance to the nearest wall for each cell
+ *                       (size: n_cells_with_ghosts)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_wall_distance_geom_compute(const int   bc_type[],
+                              cs_real_t   dist[])
+{
+  const cs_mesh_t *m = cs_glob_mesh;
+  const cs_mesh_quantities_t *mq = cs_glob_mesh_quantities;
+  const cs_real_3_t *cell_cen = (const cs_real_3_t *)mq->cell_cen;
+  const cs_real_t *b_face_cog = mq->b_face_cog;
+  const cs_lnum_t n_cells = m->n_cells;
+
+  cs_timer_t t0 = cs_timer_time();
+
+  /* Select wall faces */
+
+  cs_lnum_t n_w_faces = 0;
+  cs_lnum_t *w_face_ids;
+
+  BFT_MALLOC(w_face_ids, m->n_b_faces, cs_lnum_t);
+
+  for (cs_lnum_t f_id = 0; f_id < m->n_b_faces; f_id++) {
+    if (bc_type[f_id] == CS_SMOOTHWALL || bc_type[f_id] == CS_ROUGHWALL)
+      w_face_ids[n_w_faces++] = f_id;
+  }
+
+  /* Build or update hierarchy */
+
+  bool rebuild = true;
+
+  if (_wall_bvh != NULL && _wall_bvh->n_elts == n_w_faces)
+    rebuild = (n_w_faces > 0 && memcmp(_w_face_ids, w_face_ids,
+                      n_w_faces*sizeof(cs_lnum_t)) != 0);
+
+  if (rebuild) {
+
+    _bvh_destroy(&_wall_bvh);
+
+    cs_real_t *w_face_box;
+    BFT_MALLOC(w_face_box, n_w_faces*6, cs_real_t);
+
+#   pragma omp parallel for if (n_w_faces > CS_THR_MIN)
+    for (cs_lnum_t i = 0; i < n_w_faces; i++)
+      _b_face_box(m, b_face_cog, w_face_ids[i], w_face_box + 6*i);
+
+    _wall_bvh = _bvh_create(n_w_faces, w_face_box);
+
+    BFT_FREE(w_face_box);
+
+    /* Hierarchy element ids refer to the wall face list */
+
+    for (cs_lnum_t i = 0; i < n_w_faces; i++)
+      _wall_bvh->elt_id[i] = w_face_ids[_wall_bvh->elt_id[i]];
+
+    BFT_REALLOC(_w_face_ids, n_w_faces, cs_lnum_t);
+    memcpy(_w_face_ids, w_face_ids, n_w_faces*sizeof(cs_lnum_t));
+
+  }
+  else {
+
+#   pragma omp parallel for if (n_w_faces > CS_THR_MIN)
+    for (cs_lnum_t i = 0; i < n_w_faces; i++)
+      _b_face_box(m, b_face_cog, _wall_bvh->elt_id[i],
+                  _wall_bvh->elt_box + 6*i);
+
+    _bvh_refit(_wall_bvh);
+
+  }
+
+  BFT_FREE(w_face_ids);
+
+  cs_gnum_t n_g_w_faces = n_w_faces;
+  cs_parall_counter(&n_g_w_faces, 1);
+
+  cs_timer_t t1 = cs_timer_time();
+
+  /* If there is no wall, initialize to a big value */
+
+  if (n_g_w_faces == 0) {
+    for (cs_lnum_t c_id = 0; c_id < m->n_cells_with_ghosts; c_id++)
+      dist[c_id] = cs_math_big_r;
+    return;
+  }
+
+  /* Local queries */
+
+  cs_real_t *d2;
+  BFT_MALLOC(d2, n_cells, cs_real_t);
+
+# pragma omp parallel for if (n_cells > CS_THR_MIN)
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++)
+    d2[c_id] = _bvh_nearest_face(_wall_bvh, m, b_face_cog, cell_cen[c_id],
+                                 cs_math_infinite_r);
+
+  cs_timer_t t2 = cs_timer_time();
+
+  /* Queries to other ranks */
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1)
+    _remote_queries(_wall_bvh, m, b_face_cog, cell_cen, d2);
+#endif
+
+# pragma omp parallel for if (n_cells > CS_THR_MIN)
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++)
+    dist[c_id] = sqrt(d2[c_id]);
+
+  BFT_FREE(d2);
+
+  if (m->halo != NULL)
+    cs_halo_sync_var(m->halo, CS_HALO_STANDARD, dist);
+
+  cs_timer_t t3 = cs_timer_time();
+
+  /* Log */
+
+  cs_real_t d_min, d_max;
+  _dist_bounds(n_cells, dist, &d_min, &d_max);
+
+  cs_timer_counter_t dt[3];
+  CS_TIMER_COUNTER_INIT(dt[0]);
+  CS_TIMER_COUNTER_INIT(dt[1]);
+  CS_TIMER_COUNTER_INIT(dt[2]);
+  cs_timer_counter_add_diff(dt, &t0, &t1);
+  cs_timer_counter_add_diff(dt + 1, &t1, &t2);
+  cs_timer_counter_add_diff(dt + 2, &t2, &t3);
+
+  cs_log_printf
+    (CS_LOG_DEFAULT,
+     _("\n"
+       " ** WALL DISTANCE (geometric)\n"
+       "    -------------\n\n"
+       "  Number of wall faces: %llu\n"
+       "  Elapsed time (s): %s %.5f, local queries %.5f,"
+       " remote queries %.5f\n\n"
+       "  Min distance = %14.5e Max distance = %14.5e\n\n"),
+     (unsigned long long)n_g_w_faces,
+     (rebuild) ? _("tree build") : _("tree update"),
+     dt[0].wall_nsec*1e-9, dt[1].wall_nsec*1e-9, dt[2].wall_nsec*1e-9,
+     d_min, d_max);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Update the "wall_distance" field using the geometric method.
+ *
+ * If the verbosity associated with the "wall_distance" field is
+ * greater than 1, the distance is also computed using the Poisson
+ * equation based method on the first call, and the accuracy and
+ * timings of both methods are compared in the log.
+ *
+ * \param[in]   bc_type  type of boundary for each face
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_wall_distance_geom_update(const int  bc_type[])
+{
+  static bool first_call = true;
+
+  cs_field_t *f = cs_field_by_name("wall_distance");
+
+  cs_var_cal_opt_t var_cal_opt;
+  cs_field_get_key_struct(f, cs_field_key_id("var_cal_opt"), &var_cal_opt);
+
+  const cs_lnum_t n_cells = cs_glob_mesh->n_cells;
+
+  cs_real_t *dist_ref = NULL;
+  double t_ref = 0.;
+
+  if (first_call && var_cal_opt.verbosity > 1) {
+
+    cs_timer_t t0 = cs_timer_time();
+
+    CS_PROCF(distpr, DISTPR)(bc_type);
+
+    cs_timer_t t1 = cs_timer_time();
+    t_ref = cs_timer_diff(&t0, &t1).wall_nsec*1e-9;
+
+    BFT_MALLOC(dist_ref, n_cells, cs_real_t);
+    memcpy(dist_ref, f->val, n_cells*sizeof(cs_real_t));
+
+  }
+
+  first_call = false;
+
+  cs_timer_t t0 = cs_timer_time();
+
+  cs_wall_distance_geom_compute(bc_type, f->val);
+
+  cs_timer_t t1 = cs_timer_time();
+
+  if (dist_ref != NULL) {
+    _log_comparison(n_cells, dist_ref, f->val,
+                    t_ref, cs_timer_diff(&t0, &t1).wall_nsec*1e-9);
+    BFT_FREE(dist_ref);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Free structures used by the geometric wall distance computation.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_wall_distance_geom_finalize(void)
+{
+  _bvh_destroy(&_wall_bvh);
+  BFT_FREE(_w_face_ids);
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
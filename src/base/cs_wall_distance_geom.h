@@ -0,0 +1,98 @@
+#ifndef __CS_WALL_DISTANCE_GEOM_H__
+#define __CS_WALL_DISTANCE_GEOM_H__
+
+/*============================================================================
+ * Geometric wall distance computation using bounding volume hierarchies.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*============================================================================
+ *  Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Compute the distance from cell centers to the nearest wall face
+ *        using a geometric method.
+ *
+ * Wall faces are boundary faces whose type is \ref CS_SMOOTHWALL or
+ * \ref CS_ROUGHWALL. The distance computed is the exact distance to the
+ * (triangulated) wall faces, which may be located on any rank.
+ *
+ * The bounding volume hierarchy built over local wall faces is kept
+ * between calls, and only its bounding boxes are updated when the
+ * set of wall faces is unchanged (such as with a moving mesh).
+ *
+ * Periodicity is not taken into account.
+ *
+ * \param[in]   bc_type  type of boundary for each face
+ * \param[out]  dist     distance to the nearest wall for each cell
+ *                       (size: n_cells_with_ghosts)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_wall_distance_geom_compute(const int   bc_type[],
+                              cs_real_t   dist[]);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Update the "wall_distance" field using the geometric method.
+ *
+ * If the verbosity associated with the "wall_distance" field is
+ * greater than 1, the distance is also computed using the Poisson
+ * equation based method on the first call, and the accuracy and
+ * timings of both methods are compared in the log.
+ *
+ * \param[in]   bc_type  type of boundary for each face
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_wall_distance_geom_update(const int  bc_type[]);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Free structures used by the geometric wall distance computation.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_wall_distance_geom_finalize(void);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_WALL_DISTANCE_GEOM_H__ */
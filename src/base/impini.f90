@@ -504,7 +504,9 @@ endif
 '       ICDPAR = ',4x,i10,    ' ( 1: std, reread if restart',   /,&
 '                               (-1: std, recomputed if restrt',/,&
 '                               ( 2: old, reread if restart',   /,&
-'                               (-2: old, recomputed if restrt',/)
+'                               (-2: old, recomputed if restrt',/,&
+'                               ( 3: geom, reread if restart',  /,&
+'                               (-3: geom, recomputed if restrt',/)
 
 !===============================================================================
 ! 5. SCALAIRES
@@ -1056,6 +1056,11 @@ module optcal
   !> - 2: former algorithm (based on geometrical considerations), with
   !> reading of the distance to the wall from the restart file if possible\n
   !> - -2: former algorithm (based on geometrical considerations) with systematic
+  !> recalculation of the distance to the wall in case of calculation restart.\n
+  !> - 3: exact geometric distance to the wall faces, based on a bounding
+  !> volume hierarchy, with reading of the distance to the wall from the restart
+  !> file if possible\n
+  !> - -3: exact geometric distance to the wall faces with systematic
   !> recalculation of the distance to the wall in case of calculation restart.\n\n
   !> In case of restart calculation, if the position of the walls haven’t changed,
   !> reading the distance to the wall from the restart file can save a fair amount
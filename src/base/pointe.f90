@@ -554,6 +554,34 @@ contains
 
   !=============================================================================
 
+  ! Update mappings of boundary face arrays after a mesh redistribution
+
+  subroutine boundary_conditions_update_mesh
+
+    use, intrinsic :: iso_c_binding
+    use mesh
+    use cs_c_bindings
+
+    implicit none
+
+    ! Local variables
+
+    type(c_ptr) :: c_itypfb, c_izfppp
+
+    call cs_f_boundary_conditions_get_pointers(c_itypfb, c_izfppp)
+
+    call c_f_pointer(c_itypfb, itypfb, [nfabor])
+    call c_f_pointer(c_izfppp, izfppp, [nfabor])
+
+    ! Face sorting array is rebuilt at each time step
+
+    deallocate(itrifb)
+    allocate(itrifb(nfabor))
+
+  end subroutine boundary_conditions_update_mesh
+
+  !=============================================================================
+
   subroutine boundary_conditions_finalize
 
     use cs_c_bindings
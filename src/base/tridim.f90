@@ -1016,6 +1016,9 @@ do while (iterns.le.nterup)
       ! Deprecated algorithm
       else if (abs(icdpar).eq.2) then
         call distpr2(itypfb)
+      ! Geometric algorithm
+      else if (abs(icdpar).eq.3) then
+        call cs_wall_distance_geom_update(itypfb)
       endif
       ! Wall distance is not updated except if ALE is switched on
       if (iale.eq.0) imajdy = 1
@@ -557,7 +557,7 @@ enddo
 
 if (ineedy.eq.1) then
 
-  if (abs(icdpar).ne.1) then
+  if (abs(icdpar).ne.1 .and. abs(icdpar).ne.3) then
     write(nfecra,2700) icdpar
     iok = iok + 1
   endif
@@ -740,7 +740,8 @@ endif
 
 ! --- periodicite incompatible avec le mode de calcul
 !       direct de la distance a la paroi
-if (iperio.eq.1.and.ineedy.eq.1.and.abs(icdpar).eq.2) then
+if (     iperio.eq.1.and.ineedy.eq.1                                &
+    .and.(abs(icdpar).eq.2.or.abs(icdpar).eq.3)) then
   write(nfecra,5005)iperio, icdpar
   iok = iok + 1
 endif
@@ -1475,7 +1476,7 @@ endif
 '@    =========',                                               /,&
 '@    Choice of method for computing distance to the wall',     /,&
 '@',                                                            /,&
-'@  ICDPAR MUST BE AN INTEGER  EQUAL TO -2, -1, 1 or 2',        /,&
+'@  ICDPAR MUST BE AN INTEGER  EQUAL TO -3, -1, 1 or 3',        /,&
 '@  IL IS EQUAL',  i10,                                         /,&
 '@',                                                            /,&
 '@  Computation CAN NOT run',                                   /,&
@@ -1786,7 +1786,9 @@ cs_cdofb_monolithic_init_common(const cs_navsto_param_t       *nsp,
     }
     break;
 
+  case CS_NAVSTO_SLES_DIAG_SCHUR_FGMRES:
   case CS_NAVSTO_SLES_GKB_SATURNE:
+  case CS_NAVSTO_SLES_UPPER_SCHUR_FGMRES:
   case CS_NAVSTO_SLES_UZAWA_AL:
     cs_shared_range_set = connect->range_sets[CS_CDO_CONNECT_FACE_VP0];
     cs_shared_matrix_structure = cs_cdofb_vecteq_matrix_structure();
@@ -2015,6 +2017,24 @@ cs_cdofb_monolithic_init_scheme_context(const cs_navsto_param_t   *nsp,
                cs_real_t);
     break;
 
+  case CS_NAVSTO_SLES_DIAG_SCHUR_FGMRES:
+  case CS_NAVSTO_SLES_UPPER_SCHUR_FGMRES:
+    sc->init_system = _init_system_default;
+    sc->solve = cs_cdofb_monolithic_block_fgmres_solve;
+    sc->assemble = _velocity_full_assembly;
+    sc->elemental_assembly = cs_equation_assemble_set(CS_SPACE_SCHEME_CDOFB,
+                                                      CS_CDO_CONNECT_FACE_VP0);
+
+    BFT_MALLOC(sc->mav_structures, 1, cs_matrix_assembler_values_t *);
+
+    msles->graddiv_coef = nsp->gd_scale_coef;
+    msles->n_row_blocks = 1;
+    BFT_MALLOC(msles->block_matrices, 1, cs_matrix_t *);
+    BFT_MALLOC(msles->div_op,
+               3*cs_shared_connect->c2f->idx[cs_shared_quant->n_cells],
+               cs_real_t);
+    break;
+
   default:
     sc->init_system = _init_system_default;
     sc->solve = cs_cdofb_monolithic_solve;
@@ -113,6 +113,11 @@ BEGIN_C_DECLS
 
 #define CS_GKB_TRUNCATION_THRESHOLD       5
 
+/* In-house FGMRES with block preconditioner: advanced settings */
+
+#define CS_BPC_FGMRES_RESTART             30
+#define CS_BPC_VELOCITY_RTOL            1e-1
+
 /* Block size for superblock algorithm */
 
 #define CS_SBLOCK_BLOCK_SIZE 60
@@ -196,6 +201,44 @@ typedef struct {
 
 } cs_uza_builder_t;
 
+/* Structure used to solve the saddle-point problem with an in-house flexible
+ * GMRES preconditioned by a block diagonal or block upper triangular matrix:
+ *
+ *   P = | A  0 |   or   P = | A  Bt |   with  S ~ -B.diag(A)^-1.Bt
+ *       | 0 -S |            | 0  S  |
+ *
+ * Velocity arrays are stored in the gathered (algebraic) view of the
+ * velocity range set, so that dot products need no special treatment.
+ */
+
+typedef struct {
+
+  bool                    upper;       /* block upper triangular (true) or
+                                          block diagonal (false) */
+
+  /* Value of the grad-div coefficient */
+  cs_real_t               gamma;
+
+  /* Size of spaces */
+  cs_lnum_t               n_u_dofs;    /* velocity DoFs (gathered view) */
+  cs_lnum_t               n_u_scatter; /* velocity DoFs (scattered view) */
+  cs_lnum_t               n_u_cols;    /* columns of the velocity matrix */
+  cs_lnum_t               n_p_dofs;    /* pressure DoFs */
+
+  /* Approximation of the Schur complement */
+  cs_real_t              *inv_schur;   /* reciprocal of the diagonal of
+                                          B.diag(A)^-1.Bt */
+
+  /* Auxiliary vectors */
+  cs_real_t              *u_sca;       /* buffer in space M (scattered) */
+  cs_real_t              *u_col;       /* buffer in space M (matrix columns) */
+  cs_real_t              *u_rhs;       /* buffer in space M (gathered) */
+
+  cs_iter_algo_info_t    *info;        /* Information related to the
+                                          convergence of the algorithm */
+
+} cs_bpc_builder_t;
+
 /*============================================================================
  * Private variables
  *============================================================================*/
@@ -1943,6 +1986,358 @@ _uza_incr_cvg_test(cs_real_t                   delta_u_l2,
     return false;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Switch a velocity array from the scattered view to the gathered
+ *         view (in place)
+ *
+ * \param[in, out] u    velocity array (size = 3*n_faces)
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline void
+_gather_velocity(cs_real_t   *u)
+{
+  if (cs_glob_n_ranks > 1)
+    cs_range_set_gather(cs_shared_range_set,
+                        CS_REAL_TYPE, 1, /* type and stride */
+                        u, u);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Switch a velocity array from the gathered view to the scattered
+ *         view (in place)
+ *
+ * \param[in, out] u    velocity array (size = 3*n_faces)
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline void
+_scatter_velocity(cs_real_t   *u)
+{
+  if (cs_glob_n_ranks > 1)
+    cs_range_set_scatter(cs_shared_range_set,
+                         CS_REAL_TYPE, 1, /* type and stride */
+                         u, u);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Create and initialize a builder structure for the block
+ *         preconditioned FGMRES algorithm
+ *
+ * \param[in]  nsp        pointer to a cs_navsto_param_t structure
+ * \param[in]  matrix     pointer to the velocity block matrix
+ * \param[in]  div_op     pointer to the values of divergence operator
+ * \param[in]  gamma      value of the grad-div coefficient
+ * \param[in]  n_faces    number of faces
+ * \param[in]  n_cells    number of cells (pressure DoFs)
+ *
+ * \return a pointer to a new allocated builder
+ */
+/*----------------------------------------------------------------------------*/
+
+static cs_bpc_builder_t *
+_init_bpc_builder(const cs_navsto_param_t    *nsp,
+                  const cs_matrix_t          *matrix,
+                  const cs_real_t            *div_op,
+                  cs_real_t                   gamma,
+                  cs_lnum_t                   n_faces,
+                  cs_lnum_t                   n_cells)
+{
+  const cs_adjacency_t  *c2f = cs_shared_connect->c2f;
+  const cs_navsto_param_sles_t  nslesp = nsp->sles_param;
+
+  cs_bpc_builder_t  *bpc = NULL;
+
+  BFT_MALLOC(bpc, 1, cs_bpc_builder_t);
+
+  bpc->upper = (nslesp.strategy == CS_NAVSTO_SLES_UPPER_SCHUR_FGMRES);
+  bpc->gamma = gamma;
+
+  bpc->n_u_dofs = cs_matrix_get_n_rows(matrix);
+  bpc->n_u_scatter = 3*n_faces;
+  bpc->n_u_cols = cs_matrix_get_n_columns(matrix);
+  bpc->n_p_dofs = n_cells;
+
+  assert(bpc->n_u_dofs <= bpc->n_u_scatter);
+
+  BFT_MALLOC(bpc->u_sca, CS_MAX(bpc->n_u_scatter, bpc->n_u_cols), cs_real_t);
+  BFT_MALLOC(bpc->u_col, CS_MAX(bpc->n_u_scatter, bpc->n_u_cols), cs_real_t);
+  BFT_MALLOC(bpc->u_rhs, bpc->n_u_dofs, cs_real_t);
+
+  /* Diagonal approximation of the Schur complement: for each cell, the
+     diagonal entry of B.diag(A)^-1.Bt is built from the divergence operator
+     and the diagonal of the velocity block (scattered view) */
+
+  const cs_real_t  *diag = cs_matrix_get_diagonal(matrix);
+
+  cs_real_t  *d_sca = bpc->u_sca;
+  memcpy(d_sca, diag, bpc->n_u_dofs*sizeof(cs_real_t));
+  _scatter_velocity(d_sca);
+
+  BFT_MALLOC(bpc->inv_schur, n_cells, cs_real_t);
+
+# pragma omp parallel for if (n_cells > CS_THR_MIN)
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+
+    cs_real_t  s = 0;
+    for (cs_lnum_t j = c2f->idx[c_id]; j < c2f->idx[c_id+1]; j++) {
+      const cs_real_t  *_div_f = div_op + 3*j;
+      const cs_real_t  *_d_f = d_sca + 3*c2f->ids[j];
+      for (int k = 0; k < 3; k++)
+        if (fabs(_d_f[k]) > 0)
+          s += _div_f[k]*_div_f[k] / _d_f[k];
+    }
+
+    bpc->inv_schur[c_id] = (s > 0) ? 1./s : 1.;
+
+  } /* Loop on cells */
+
+  bpc->info = cs_iter_algo_define(nslesp.il_algo_verbosity,
+                                  nslesp.n_max_il_algo_iter,
+                                  nslesp.il_algo_atol,
+                                  nslesp.il_algo_rtol,
+                                  nslesp.il_algo_dtol);
+
+  return bpc;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Free a builder structure for the block preconditioned FGMRES
+ *
+ * \param[in, out]  p_bpc   double pointer to a builder structure
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_free_bpc_builder(cs_bpc_builder_t   **p_bpc)
+{
+  cs_bpc_builder_t  *bpc = *p_bpc;
+
+  if (bpc == NULL)
+    return;
+
+  BFT_FREE(bpc->inv_schur);
+
+  BFT_FREE(bpc->u_sca);
+  BFT_FREE(bpc->u_col);
+  BFT_FREE(bpc->u_rhs);
+
+  BFT_FREE(bpc->info);
+
+  BFT_FREE(bpc);
+  *p_bpc = NULL;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Add the gradient of a pressure array to a velocity array in the
+ *         gathered view: u = u + alpha.Bt.p
+ *
+ * \param[in]      div_op   pointer to the values of divergence operator
+ * \param[in]      alpha    scaling coefficient
+ * \param[in]      p        pressure array
+ * \param[in, out] bpc      pointer to a builder structure
+ * \param[in, out] u        velocity array (gathered view)
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_bpc_add_grad(const cs_real_t     *div_op,
+              cs_real_t            alpha,
+              const cs_real_t     *p,
+              cs_bpc_builder_t    *bpc,
+              cs_real_t           *u)
+{
+  _apply_div_op_transpose(div_op, p, bpc->u_sca);
+
+  if (cs_glob_n_ranks > 1)
+    cs_interface_set_sum(cs_shared_range_set->ifs,
+                         bpc->n_u_scatter,
+                         1, false, CS_REAL_TYPE, /* stride, interlaced */
+                         bpc->u_sca);
+
+  _gather_velocity(bpc->u_sca);
+
+# pragma omp parallel for if (bpc->n_u_dofs > CS_THR_MIN)
+  for (cs_lnum_t iu = 0; iu < bpc->n_u_dofs; iu++)
+    u[iu] += alpha*bpc->u_sca[iu];
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Apply the saddle-point operator: y = K.x where
+ *         K = | A  Bt |
+ *             | B  0  |
+ *         Arrays store velocity values (gathered view) first, then pressure
+ *         values.
+ *
+ * \param[in]      matrix   pointer to the velocity block matrix
+ * \param[in]      div_op   pointer to the values of divergence operator
+ * \param[in]      x        vector to multiply
+ * \param[in, out] bpc      pointer to a builder structure
+ * \param[in, out] y        resulting vector
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_bpc_matvec(const cs_matrix_t   *matrix,
+            const cs_real_t     *div_op,
+            const cs_real_t     *x,
+            cs_bpc_builder_t    *bpc,
+            cs_real_t           *y)
+{
+  const cs_real_t  *x_p = x + bpc->n_u_dofs;
+  cs_real_t  *y_p = y + bpc->n_u_dofs;
+
+  /* y_u = A.x_u + Bt.x_p */
+
+  memcpy(bpc->u_col, x, bpc->n_u_dofs*sizeof(cs_real_t));
+  cs_matrix_vector_multiply(CS_HALO_ROTATION_IGNORE, matrix, bpc->u_col, y);
+
+  _bpc_add_grad(div_op, 1., x_p, bpc, y);
+
+  /* y_p = B.x_u */
+
+  memcpy(bpc->u_sca, x, bpc->n_u_dofs*sizeof(cs_real_t));
+  _scatter_velocity(bpc->u_sca);
+
+  _apply_div_op(div_op, bpc->u_sca, y_p);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Apply the block preconditioner: z = P^-1.r
+ *         The velocity block is inverted approximately using the SLES
+ *         settings of the momentum equation with a loose tolerance.
+ *
+ * \param[in]      eqp      pointer to a cs_equation_param_t structure
+ * \param[in]      matrix   pointer to the velocity block matrix
+ * \param[in]      div_op   pointer to the values of divergence operator
+ * \param[in]      r        vector to precondition
+ * \param[in, out] sles     pointer to the SLES of the velocity block
+ * \param[in, out] bpc      pointer to a builder structure
+ * \param[in, out] z        resulting vector
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_bpc_apply(const cs_equation_param_t   *eqp,
+           const cs_matrix_t           *matrix,
+           const cs_real_t             *div_op,
+           const cs_real_t             *r,
+           cs_sles_t                   *sles,
+           cs_bpc_builder_t            *bpc,
+           cs_real_t                   *z)
+{
+  const cs_real_t  *r_p = r + bpc->n_u_dofs;
+  cs_real_t  *z_p = z + bpc->n_u_dofs;
+
+  /* Pressure block: z_p = S^-1.r_p with S ~ -B.diag(A)^-1.Bt for the upper
+     triangular variant, and its opposite for the block diagonal one */
+
+  const cs_real_t  s_sign = (bpc->upper) ? -1. : 1.;
+
+# pragma omp parallel for if (bpc->n_p_dofs > CS_THR_MIN)
+  for (cs_lnum_t ip = 0; ip < bpc->n_p_dofs; ip++)
+    z_p[ip] = s_sign * bpc->inv_schur[ip] * r_p[ip];
+
+  /* Velocity block: A.z_u = r_u (- Bt.z_p for the upper triangular case) */
+
+  memcpy(bpc->u_rhs, r, bpc->n_u_dofs*sizeof(cs_real_t));
+
+  if (bpc->upper)
+    _bpc_add_grad(div_op, -1., z_p, bpc, bpc->u_rhs);
+
+  cs_real_t  r_norm = cs_dot_xx(bpc->n_u_dofs, bpc->u_rhs);
+  cs_parall_sum(1, CS_DOUBLE, &r_norm);
+  r_norm = (r_norm > 0) ? sqrt(r_norm) : 1.;
+
+  memset(bpc->u_col, 0, bpc->n_u_cols*sizeof(cs_real_t));
+
+  int  n_iters = 0;
+  double  residual = DBL_MAX;
+
+  cs_sles_solve(sles,
+                matrix,
+                CS_HALO_ROTATION_IGNORE,
+                fmax(CS_BPC_VELOCITY_RTOL, eqp->sles_param.eps),
+                r_norm,
+                &n_iters,
+                &residual,
+                bpc->u_rhs,
+                bpc->u_col,
+                0,      /* aux. size */
+                NULL);  /* aux. buffers */
+
+  bpc->info->last_inner_iter = n_iters;
+  bpc->info->n_inner_iter += n_iters;
+
+  memcpy(z, bpc->u_col, bpc->n_u_dofs*sizeof(cs_real_t));
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Compute the dot products of a vector with a set of vectors,
+ *         using a single parallel reduction
+ *
+ * \param[in]      n      local size of vectors
+ * \param[in]      n_v    number of vectors in the set
+ * \param[in]      v      set of vectors
+ * \param[in]      w      vector
+ * \param[out]     h      resulting dot products
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_bpc_multi_dot(cs_lnum_t           n,
+               int                 n_v,
+               cs_real_t   *const  v[],
+               const cs_real_t     w[],
+               cs_real_t           h[])
+{
+  for (int i = 0; i < n_v; i++)
+    h[i] = cs_dot(n, v[i], w);
+
+  cs_parall_sum(n_v, CS_REAL_TYPE, h);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Test if one needs one more FGMRES iteration
+ *
+ * \param[in, out] bpc     pointer to a builder structure
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_bpc_cvg_test(cs_bpc_builder_t           *bpc)
+{
+  cs_iter_algo_info_t  *info = bpc->info;
+
+  if (info->res < info->tol)
+    info->cvg = CS_SLES_CONVERGED;
+
+  else if (info->n_algo_iter >= info->n_max_algo_iter)
+    info->cvg = CS_SLES_MAX_ITERATION;
+
+  else if (info->res > info->dtol * info->res0)
+    info->cvg = CS_SLES_DIVERGED;
+
+  else
+    info->cvg = CS_SLES_ITERATING;
+
+  if (info->verbosity > 0)
+    cs_log_printf(CS_LOG_DEFAULT,
+                  "### BPC.It%02d-- %5.3e %5d %6d cvg:%d\n",
+                  info->n_algo_iter, info->res,
+                  info->last_inner_iter, info->n_inner_iter,
+                  info->cvg);
+}
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*============================================================================
@@ -2170,6 +2565,13 @@ cs_cdofb_monolithic_set_sles(cs_navsto_param_t    *nsp,
     cs_equation_param_set_sles(mom_eqp);
     break;
 
+  case CS_NAVSTO_SLES_DIAG_SCHUR_FGMRES:
+  case CS_NAVSTO_SLES_UPPER_SCHUR_FGMRES:
+    /* Set solver and preconditioner for the velocity block used inside the
+     * block preconditioner (M = A + zeta * Bt*N^-1*B) */
+    cs_equation_param_set_sles(mom_eqp);
+    break;
+
 #if defined(HAVE_PETSC)
 #if PETSC_VERSION_GE(3,11,0)    /* Golub-Kahan Bi-diagonalization */
   case CS_NAVSTO_SLES_GKB_PETSC:
@@ -2971,6 +3373,254 @@ cs_cdofb_monolithic_uzawa_al_incr_solve(const cs_navsto_param_t       *nsp,
   return  n_inner_iter;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Use a restarted FGMRES algorithm with a block preconditioner
+ *         (block diagonal or block upper triangular, with a diagonal
+ *         approximation of the Schur complement) to solve the saddle-point
+ *         problem arising from CDO-Fb schemes for Stokes, Oseen and
+ *         Navier-Stokes with a monolithic coupling.
+ *         This does not rely on an external library: the velocity block is
+ *         solved using the SLES settings of the momentum equation.
+ *
+ * \param[in]      nsp      pointer to a cs_navsto_param_t structure
+ * \param[in]      eqp      pointer to a cs_equation_param_t structure
+ * \param[in, out] msles    pointer to a cs_cdofb_monolithic_sles_t structure
+ *
+ * \return the cumulated number of iterations of the solver
+ */
+/*----------------------------------------------------------------------------*/
+
+int
+cs_cdofb_monolithic_block_fgmres_solve(const cs_navsto_param_t       *nsp,
+                                       const cs_equation_param_t     *eqp,
+                                       cs_cdofb_monolithic_sles_t    *msles)
+{
+  /* Sanity checks */
+  assert(nsp != NULL);
+  assert(nsp->sles_param.strategy == CS_NAVSTO_SLES_DIAG_SCHUR_FGMRES ||
+         nsp->sles_param.strategy == CS_NAVSTO_SLES_UPPER_SCHUR_FGMRES);
+  assert(cs_shared_range_set != NULL);
+
+  const cs_matrix_t  *matrix = msles->block_matrices[0];
+  const cs_real_t  gamma = msles->graddiv_coef;
+  const cs_real_t  *div_op = msles->div_op;
+  const int  m = CS_BPC_FGMRES_RESTART;
+
+  cs_real_t  *u_f = msles->u_f;
+  cs_real_t  *p_c = msles->p_c;
+  cs_real_t  *b_f = msles->b_f;
+  cs_real_t  *b_c = msles->b_c;
+
+  /* Allocate and initialize the builder structure */
+  cs_bpc_builder_t  *bpc = _init_bpc_builder(nsp,
+                                             matrix,
+                                             div_op,
+                                             gamma,
+                                             msles->n_faces,
+                                             msles->n_cells);
+
+  cs_iter_algo_info_t  *info = bpc->info;
+
+  const cs_lnum_t  n_u = bpc->n_u_dofs;
+  const cs_lnum_t  n = n_u + bpc->n_p_dofs;
+
+  /* Krylov basis, preconditioned directions and Hessenberg matrix */
+  cs_real_t  *work = NULL, *hg = NULL;
+  BFT_MALLOC(work, (2*m + 4)*n, cs_real_t);
+  BFT_MALLOC(hg, (m+1)*m + 4*(m+1), cs_real_t);
+
+  cs_real_t  *b = work, *x = work + n, *w = work + 2*n;
+  cs_real_t  *v[CS_BPC_FGMRES_RESTART + 1], *z[CS_BPC_FGMRES_RESTART];
+  for (int i = 0; i < m + 1; i++)
+    v[i] = work + (3 + i)*n;
+  for (int i = 0; i < m; i++)
+    z[i] = work + (4 + m + i)*n;
+
+  cs_real_t  *h = hg;                 /* (m+1) x m, column by column */
+  cs_real_t  *g = hg + (m+1)*m;
+  cs_real_t  *c_rot = g + (m+1);
+  cs_real_t  *s_rot = c_rot + (m+1);
+  cs_real_t  *h2 = s_rot + (m+1);
+
+  /* Right-hand side. With the grad-div augmentation, the velocity RHS is
+     modified: b_f + gamma*Dt.W^-1.b_c */
+
+  if (cs_glob_n_ranks > 1)
+    cs_interface_set_sum(cs_shared_range_set->ifs,
+                         bpc->n_u_scatter,
+                         1, false, CS_REAL_TYPE, /* stride, interlaced */
+                         b_f);
+
+  memcpy(bpc->u_sca, b_f, bpc->n_u_scatter*sizeof(cs_real_t));
+  _gather_velocity(bpc->u_sca);
+  memcpy(b, bpc->u_sca, n_u*sizeof(cs_real_t));
+
+  if (gamma > 0) {
+
+    const cs_real_t  *cell_vol = cs_shared_quant->cell_vol;
+    cs_real_t  *wb_c = w;
+
+#   pragma omp parallel for if (bpc->n_p_dofs > CS_THR_MIN)
+    for (cs_lnum_t ip = 0; ip < bpc->n_p_dofs; ip++)
+      wb_c[ip] = b_c[ip]/cell_vol[ip];
+
+    _bpc_add_grad(div_op, gamma, wb_c, bpc, b);
+
+  }
+
+  memcpy(b + n_u, b_c, bpc->n_p_dofs*sizeof(cs_real_t));
+
+  /* Initial guess */
+  memcpy(bpc->u_sca, u_f, bpc->n_u_scatter*sizeof(cs_real_t));
+  _gather_velocity(bpc->u_sca);
+  memcpy(x, bpc->u_sca, n_u*sizeof(cs_real_t));
+  memcpy(x + n_u, p_c, bpc->n_p_dofs*sizeof(cs_real_t));
+
+  /* Main loop (one cycle of FGMRES(m) per iteration) */
+  /* ========= */
+
+  while (info->cvg == CS_SLES_ITERATING) {
+
+    /* r = b - K.x */
+    _bpc_matvec(matrix, div_op, x, bpc, w);
+
+#   pragma omp parallel for if (n > CS_THR_MIN)
+    for (cs_lnum_t i = 0; i < n; i++)
+      v[0][i] = b[i] - w[i];
+
+    cs_real_t  beta = cs_dot_xx(n, v[0]);
+    cs_parall_sum(1, CS_REAL_TYPE, &beta);
+    beta = sqrt(beta);
+
+    if (info->n_algo_iter == 0) {
+      info->res0 = beta;
+      info->tol = fmax(info->atol, info->rtol*beta);
+    }
+    info->res = beta;
+
+    if (beta < info->tol) {
+      info->cvg = CS_SLES_CONVERGED;
+      break;
+    }
+
+    const cs_real_t  inv_beta = 1./beta;
+#   pragma omp parallel for if (n > CS_THR_MIN)
+    for (cs_lnum_t i = 0; i < n; i++)
+      v[0][i] *= inv_beta;
+
+    memset(g, 0, (m+1)*sizeof(cs_real_t));
+    g[0] = beta;
+
+    int  k = 0;
+    for (int j = 0; j < m; j++) {
+
+      cs_real_t  *hj = h + j*(m+1);
+
+      /* z_j = P^-1.v_j and w = K.z_j */
+      _bpc_apply(eqp, matrix, div_op, v[j], msles->sles, bpc, z[j]);
+      _bpc_matvec(matrix, div_op, z[j], bpc, w);
+
+      /* Classical Gram-Schmidt with re-orthogonalization (one reduction per
+         pass) */
+      _bpc_multi_dot(n, j+1, v, w, hj);
+      for (int i = 0; i <= j; i++) {
+        const cs_real_t  _h = hj[i];
+        const cs_real_t  *_v = v[i];
+#       pragma omp parallel for if (n > CS_THR_MIN)
+        for (cs_lnum_t l = 0; l < n; l++)
+          w[l] -= _h*_v[l];
+      }
+
+      _bpc_multi_dot(n, j+1, v, w, h2);
+      for (int i = 0; i <= j; i++) {
+        const cs_real_t  _h = h2[i];
+        const cs_real_t  *_v = v[i];
+        hj[i] += _h;
+#       pragma omp parallel for if (n > CS_THR_MIN)
+        for (cs_lnum_t l = 0; l < n; l++)
+          w[l] -= _h*_v[l];
+      }
+
+      cs_real_t  w_norm = cs_dot_xx(n, w);
+      cs_parall_sum(1, CS_REAL_TYPE, &w_norm);
+      w_norm = sqrt(w_norm);
+      hj[j+1] = w_norm;
+
+      if (w_norm > 0) {
+        const cs_real_t  inv_norm = 1./w_norm;
+#       pragma omp parallel for if (n > CS_THR_MIN)
+        for (cs_lnum_t l = 0; l < n; l++)
+          v[j+1][l] = w[l]*inv_norm;
+      }
+
+      /* Apply the previous Givens rotations then compute the new one */
+      for (int i = 0; i < j; i++) {
+        const cs_real_t  tmp = c_rot[i]*hj[i] + s_rot[i]*hj[i+1];
+        hj[i+1] = -s_rot[i]*hj[i] + c_rot[i]*hj[i+1];
+        hj[i] = tmp;
+      }
+
+      const cs_real_t  d = sqrt(hj[j]*hj[j] + hj[j+1]*hj[j+1]);
+      if (d > 0) {
+        c_rot[j] = hj[j]/d;
+        s_rot[j] = hj[j+1]/d;
+      }
+      else {
+        c_rot[j] = 1.;
+        s_rot[j] = 0.;
+      }
+
+      hj[j] = d;
+      hj[j+1] = 0.;
+      g[j+1] = -s_rot[j]*g[j];
+      g[j] *= c_rot[j];
+
+      k = j + 1;
+
+      /* Update error norm and test if one needs one more iteration */
+      info->n_algo_iter += 1;
+      info->res = fabs(g[j+1]);
+      _bpc_cvg_test(bpc);
+
+      if (info->cvg != CS_SLES_ITERATING || !(w_norm > 0))
+        break;
+
+    } /* Inner iterations */
+
+    /* Solve the upper triangular system H.y = g (y is stored in g) and
+       update the solution x = x + Z.y */
+    for (int i = k-1; i > -1; i--) {
+      for (int l = i+1; l < k; l++)
+        g[i] -= h[l*(m+1) + i]*g[l];
+      g[i] = (fabs(h[i*(m+1) + i]) > 0) ? g[i]/h[i*(m+1) + i] : 0.;
+    }
+
+    for (int i = 0; i < k; i++) {
+      const cs_real_t  _y = g[i];
+      const cs_real_t  *_z = z[i];
+#     pragma omp parallel for if (n > CS_THR_MIN)
+      for (cs_lnum_t l = 0; l < n; l++)
+        x[l] += _y*_z[l];
+    }
+
+  } /* Restart cycles */
+
+  /* Copy back the solution */
+  memcpy(u_f, x, n_u*sizeof(cs_real_t));
+  _scatter_velocity(u_f);
+  memcpy(p_c, x + n_u, bpc->n_p_dofs*sizeof(cs_real_t));
+
+  int  n_inner_iter = info->n_inner_iter;
+
+  /* Last step: Free temporary memory */
+  BFT_FREE(work);
+  BFT_FREE(hg);
+  _free_bpc_builder(&bpc);
+
+  return  n_inner_iter;
+}
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -290,6 +290,29 @@ cs_cdofb_monolithic_uzawa_al_incr_solve(const cs_navsto_param_t       *nsp,
                                         const cs_equation_param_t     *eqp,
                                         cs_cdofb_monolithic_sles_t    *msles);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief  Use a restarted FGMRES algorithm with a block preconditioner
+ *         (block diagonal or block upper triangular, with a diagonal
+ *         approximation of the Schur complement) to solve the saddle-point
+ *         problem arising from CDO-Fb schemes for Stokes, Oseen and
+ *         Navier-Stokes with a monolithic coupling.
+ *         This does not rely on an external library: the velocity block is
+ *         solved using the SLES settings of the momentum equation.
+ *
+ * \param[in]      nsp      pointer to a cs_navsto_param_t structure
+ * \param[in]      eqp      pointer to a cs_equation_param_t structure
+ * \param[in, out] msles    pointer to a cs_cdofb_monolithic_sles_t structure
+ *
+ * \return the cumulated number of iterations of the solver
+ */
+/*----------------------------------------------------------------------------*/
+
+int
+cs_cdofb_monolithic_block_fgmres_solve(const cs_navsto_param_t       *nsp,
+                                       const cs_equation_param_t     *eqp,
+                                       cs_cdofb_monolithic_sles_t    *msles);
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -54,6 +54,7 @@
 #include "cs_mesh_deform.h"
 #include "cs_mesh_location.h"
 #include "cs_navsto_system.h"
+#include "cs_numa.h"
 #include "cs_parall.h"
 #include "cs_prototypes.h"
 #include "cs_solidification.h"
@@ -677,6 +678,8 @@ cs_domain_finalize_setup(cs_domain_t         *domain)
   /* Allocate all fields created during the setup stage */
   cs_field_allocate_or_map_all();
 
+  cs_numa_log_placement();
+
   /* Set the definition of user-defined properties and/or advection
    * fields (no more fields are created at this stage)
    * Last setting stage for equations: Associate properties to activate or not
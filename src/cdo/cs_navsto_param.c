@@ -325,7 +325,11 @@ cs_navsto_param_create(const cs_boundary_t             *boundaries,
     break;
 
   case CS_NAVSTO_COUPLING_MONOLITHIC:
+#if defined(HAVE_PETSC)
     param->sles_param.strategy = CS_NAVSTO_SLES_ADDITIVE_GMRES_BY_BLOCK;
+#else
+    param->sles_param.strategy = CS_NAVSTO_SLES_UPPER_SCHUR_FGMRES;
+#endif
     param->gd_scale_coef = 0.0;    /* Default value if not set by the user */
 
     param->velocity_ic_is_owner = false;
@@ -674,6 +678,10 @@ cs_navsto_param_set(cs_navsto_param_t    *nsp,
       nsp->sles_param.strategy = CS_NAVSTO_SLES_GKB_SATURNE;
     else if (strcmp(val, "uzawa_al") == 0 || strcmp(val, "alu") == 0)
       nsp->sles_param.strategy = CS_NAVSTO_SLES_UZAWA_AL;
+    else if (strcmp(val, "diag_schur_fgmres") == 0)
+      nsp->sles_param.strategy = CS_NAVSTO_SLES_DIAG_SCHUR_FGMRES;
+    else if (strcmp(val, "upper_schur_fgmres") == 0)
+      nsp->sles_param.strategy = CS_NAVSTO_SLES_UPPER_SCHUR_FGMRES;
 
     /* All the following options need either PETSC or MUMPS */
     /* ---------------------------------------------------- */
@@ -722,6 +730,7 @@ cs_navsto_param_set(cs_navsto_param_t    *nsp,
                 " %s: Invalid val %s related to key CS_NSKEY_SLES_STRATEGY\n"
                 " Choice between: no_block, by_locks, block_amg_cg,\n"
                 " {additive,multiplicative}_gmres, {diag,upper}_schur_gmres,\n"
+                " {diag,upper}_schur_fgmres,\n"
                 " gkb, gkb_petsc, gkb_gmres, gkb_saturne,\n"
                 " mumps, uzawa_al or alu", __func__, _val);
     }
@@ -955,6 +964,14 @@ cs_navsto_param_log(const cs_navsto_param_t    *nsp)
     cs_log_printf(CS_LOG_SETUP, "Upper block preconditioner with Schur approx."
                   " + GMRES\n");
     break;
+  case CS_NAVSTO_SLES_DIAG_SCHUR_FGMRES:
+    cs_log_printf(CS_LOG_SETUP, "Diag. block preconditioner with Schur approx."
+                  " + FGMRES (In-House)\n");
+    break;
+  case CS_NAVSTO_SLES_UPPER_SCHUR_FGMRES:
+    cs_log_printf(CS_LOG_SETUP, "Upper block preconditioner with Schur approx."
+                  " + FGMRES (In-House)\n");
+    break;
   case CS_NAVSTO_SLES_GKB_PETSC:
     cs_log_printf(CS_LOG_SETUP, "GKB algorithm (through PETSc)\n");
     break;
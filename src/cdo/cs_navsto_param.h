@@ -212,6 +212,18 @@ typedef enum {
  * library up to now.
  *
  *
+ * \var CS_NAVSTO_SLES_DIAG_SCHUR_FGMRES
+ * Associated keyword: "diag_schur_fgmres"
+ *
+ * Available choice when a monolithic approach is used (i.e. with the parameter
+ * CS_NAVSTO_COUPLING_MONOLITHIC is set as coupling algorithm). The
+ * Navier-Stokes system of equations is solved using an in-house flexible
+ * GMRES with a block diagonal preconditioner. The block 00 is A_{00} solved
+ * approximately with the SLES settings of the momentum equation (a multigrid
+ * for instance) and the block 11 is a diagonal approximation of the Schur
+ * complement. This option does not require an external library.
+ *
+ *
  * \var CS_NAVSTO_SLES_EQ_WITHOUT_BLOCK
  * Associated keyword: "no_block"
  *
@@ -293,6 +305,14 @@ typedef enum {
  * library up to now.
  *
  *
+ * \var CS_NAVSTO_SLES_UPPER_SCHUR_FGMRES
+ * Associated keyword: "upper_schur_fgmres"
+ *
+ * Same as \ref CS_NAVSTO_SLES_DIAG_SCHUR_FGMRES but with an upper triangular
+ * block preconditioner (the block 01 is also considered). This is the
+ * default strategy with a monolithic coupling when PETSc is not available.
+ *
+ *
  * \var CS_NAVSTO_SLES_UZAWA_AL
  * Associated keyword: "uzawa_al"
  * Resolution using an uzawa algorithm with an Augmented Lagrangian approach
@@ -303,6 +323,7 @@ typedef enum {
   CS_NAVSTO_SLES_ADDITIVE_GMRES_BY_BLOCK,
   CS_NAVSTO_SLES_BLOCK_MULTIGRID_CG,
   CS_NAVSTO_SLES_BY_BLOCKS,
+  CS_NAVSTO_SLES_DIAG_SCHUR_FGMRES,
   CS_NAVSTO_SLES_DIAG_SCHUR_GMRES,
   CS_NAVSTO_SLES_EQ_WITHOUT_BLOCK,
   CS_NAVSTO_SLES_GKB_PETSC,
@@ -310,6 +331,7 @@ typedef enum {
   CS_NAVSTO_SLES_GKB_SATURNE,
   CS_NAVSTO_SLES_MULTIPLICATIVE_GMRES_BY_BLOCK,
   CS_NAVSTO_SLES_MUMPS,
+  CS_NAVSTO_SLES_UPPER_SCHUR_FGMRES,
   CS_NAVSTO_SLES_UPPER_SCHUR_GMRES,
   CS_NAVSTO_SLES_UZAWA_AL,
 
@@ -429,6 +429,31 @@ fvm_writer_get_times(fvm_writer_t        *this_writer,
                      cs_timer_counter_t  *field_time,
                      cs_timer_counter_t  *flush_time);
 
+/*----------------------------------------------------------------------------
+ * Allow writer helpers to keep data associated with a given mesh
+ * (such as work buffers and part to block distributions) across
+ * successive outputs.
+ *
+ * The caller is responsible for calling fvm_writer_mesh_cache_remove()
+ * before the mesh is destroyed or its structure is modified.
+ *
+ * parameters:
+ *   mesh <-- pointer to nodal mesh structure
+ *----------------------------------------------------------------------------*/
+
+void
+fvm_writer_mesh_cache_add(const fvm_nodal_t  *mesh);
+
+/*----------------------------------------------------------------------------
+ * Free data kept by writer helpers for a given mesh.
+ *
+ * parameters:
+ *   mesh <-- pointer to nodal mesh structure, or NULL for all meshes
+ *----------------------------------------------------------------------------*/
+
+void
+fvm_writer_mesh_cache_remove(const fvm_nodal_t  *mesh);
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
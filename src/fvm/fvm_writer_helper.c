@@ -119,16 +119,331 @@ struct _fvm_writer_field_helper_t {
   int          min_block_size;             /* Minimum block size for output */
 
 #endif
+
+  int          cache_id;                   /* Id of associated mesh cache,
+                                              or -1 */
 };
 
+#if defined(HAVE_MPI)
+
+/*----------------------------------------------------------------------------
+ * Part to block distribution for a given (grouped) section or for vertices
+ *----------------------------------------------------------------------------*/
+
+typedef struct {
+
+  /* Key */
+
+  const fvm_nodal_section_t  *section;   /* First section of group,
+                                            or NULL for vertices */
+  fvm_element_t       type;              /* Exported element type */
+  int                 n_sections;        /* Number of grouped sections */
+  cs_lnum_t           n_add;             /* Number of added vertices
+                                            (for vertices) */
+  const cs_gnum_t    *g_num;             /* Global numbering of first
+                                            section, or of vertices */
+  cs_lnum_t           part_size;         /* Local number of elements */
+  cs_gnum_t           n_g_elts;          /* Global number of elements */
+  MPI_Comm            comm;              /* Associated MPI communicator */
+  int                 min_rank_step;     /* Minimum rank step for output */
+  cs_lnum_t           min_block_size;    /* Minimum block size (in
+                                            elements) for output */
+
+  /* Distribution */
+
+  cs_block_dist_info_t  bi;              /* Block distribution info */
+  cs_part_to_block_t   *d;               /* Part to block distributor */
+
+  int                *block_n_sub;       /* Number of sub-elements per
+                                            block element, or NULL */
+  cs_gnum_t           block_start;       /* Output block start (1 to n) */
+  cs_gnum_t           block_end;         /* Output block past-the-end */
+
+} _dist_cache_t;
+
+#endif /* defined(HAVE_MPI) */
+
+/*----------------------------------------------------------------------------
+ * Data associated with a given mesh, kept across outputs
+ *----------------------------------------------------------------------------*/
+
+typedef struct {
+
+  const fvm_nodal_t  *mesh;              /* Associated mesh */
+
+  size_t              buffer_size[2];    /* Work buffer sizes (in bytes) */
+  unsigned char      *buffer[2];         /* Work buffers (part, block) */
+
+#if defined(HAVE_MPI)
+  int                 n_dists;           /* Number of cached distributions */
+  _dist_cache_t      *dists;             /* Cached distributions */
+#endif
+
+} _mesh_cache_t;
+
 /*============================================================================
  * Static and constant variables
  *============================================================================*/
 
+static int             _n_mesh_caches = 0;
+static _mesh_cache_t  *_mesh_caches = NULL;
+
 /*============================================================================
  * Private function definitions
  *============================================================================*/
 
+/*----------------------------------------------------------------------------
+ * Return a work buffer of a given minimum size.
+ *
+ * If the helper is associated with a mesh cache, the buffer is kept
+ * across outputs; otherwise, it is allocated here.
+ *
+ * parameters:
+ *   h      <-- pointer to helper structure
+ *   buf_id <-- buffer id (0 for part values, 1 for block values)
+ *   size   <-- required size (in bytes)
+ *
+ * returns:
+ *   pointer to buffer, to be released using _release_work_buffer().
+ *----------------------------------------------------------------------------*/
+
+static unsigned char *
+_get_work_buffer(const fvm_writer_field_helper_t  *h,
+                 int                               buf_id,
+                 size_t                            size)
+{
+  unsigned char *buffer = NULL;
+
+  if (h->cache_id < 0)
+    BFT_MALLOC(buffer, size, unsigned char);
+
+  else {
+    _mesh_cache_t *mc = _mesh_caches + h->cache_id;
+    if (mc->buffer_size[buf_id] < size) {
+      BFT_FREE(mc->buffer[buf_id]);
+      BFT_MALLOC(mc->buffer[buf_id], size, unsigned char);
+      mc->buffer_size[buf_id] = size;
+    }
+    buffer = mc->buffer[buf_id];
+  }
+
+  return buffer;
+}
+
+/*----------------------------------------------------------------------------
+ * Release a work buffer obtained by _get_work_buffer().
+ *
+ * parameters:
+ *   h      <-- pointer to helper structure
+ *   buffer <-> pointer to buffer
+ *----------------------------------------------------------------------------*/
+
+static void
+_release_work_buffer(const fvm_writer_field_helper_t   *h,
+                     unsigned char                    **buffer)
+{
+  if (h->cache_id < 0)
+    BFT_FREE(*buffer);
+  else
+    *buffer = NULL;
+}
+
+#if defined(HAVE_MPI)
+
+/*----------------------------------------------------------------------------
+ * Free arrays and distributor of a part to block distribution structure.
+ *
+ * parameters:
+ *   dist <-> pointer to distribution structure
+ *----------------------------------------------------------------------------*/
+
+static void
+_dist_destroy(_dist_cache_t  *dist)
+{
+  cs_part_to_block_destroy(&(dist->d));
+  BFT_FREE(dist->block_n_sub);
+}
+
+/*----------------------------------------------------------------------------
+ * Search for a distribution in the mesh cache associated with a helper.
+ *
+ * parameters:
+ *   h              <-- pointer to helper structure
+ *   section        <-- first section of group, or NULL for vertices
+ *   type           <-- exported element type
+ *   n_sections     <-- number of grouped sections
+ *   n_add          <-- number of added vertices (for vertices)
+ *   g_num          <-- global numbering of first section, or of vertices
+ *   part_size      <-- local number of elements (or vertices)
+ *   n_g_elts       <-- global number of elements (or vertices)
+ *   min_block_size <-- minimum block size (in elements)
+ *
+ * returns:
+ *   pointer to cached distribution, or NULL if not present
+ *----------------------------------------------------------------------------*/
+
+static const _dist_cache_t *
+_dist_cache_find(const fvm_writer_field_helper_t  *h,
+                 const fvm_nodal_section_t        *section,
+                 fvm_element_t                     type,
+                 int                               n_sections,
+                 cs_lnum_t                         n_add,
+                 const cs_gnum_t                  *g_num,
+                 cs_lnum_t                         part_size,
+                 cs_gnum_t                         n_g_elts,
+                 cs_lnum_t                         min_block_size)
+{
+  if (h->cache_id < 0)
+    return NULL;
+
+  const _mesh_cache_t *mc = _mesh_caches + h->cache_id;
+
+  for (int i = 0; i < mc->n_dists; i++) {
+    const _dist_cache_t *dist = mc->dists + i;
+    if (   dist->section == section
+        && dist->type == type
+        && dist->n_sections == n_sections
+        && dist->n_add == n_add
+        && dist->g_num == g_num
+        && dist->part_size == part_size
+        && dist->n_g_elts == n_g_elts
+        && dist->comm == h->comm
+        && dist->min_rank_step == h->min_rank_step
+        && dist->min_block_size == min_block_size)
+      return dist;
+  }
+
+  return NULL;
+}
+
+/*----------------------------------------------------------------------------
+ * Keep a distribution in the mesh cache associated with a helper,
+ * if present.
+ *
+ * If no cache is available, the caller keeps ownership of the
+ * distribution, and must free it using _dist_destroy() after use.
+ *
+ * parameters:
+ *   h    <-- pointer to helper structure
+ *   dist <-- pointer to distribution
+ *
+ * returns:
+ *   pointer to distribution to use
+ *----------------------------------------------------------------------------*/
+
+static const _dist_cache_t *
+_dist_cache_keep(const fvm_writer_field_helper_t  *h,
+                 const _dist_cache_t              *dist)
+{
+  if (h->cache_id < 0)
+    return dist;
+
+  _mesh_cache_t *mc = _mesh_caches + h->cache_id;
+
+  BFT_REALLOC(mc->dists, mc->n_dists + 1, _dist_cache_t);
+  mc->dists[mc->n_dists] = *dist;
+  mc->n_dists += 1;
+
+  return mc->dists + mc->n_dists - 1;
+}
+
+#endif /* defined(HAVE_MPI) */
+
+/*----------------------------------------------------------------------------
+ * Return a pointer to source values which may be used directly as
+ * output values, with no conversion or copy.
+ *
+ * This is possible when the source and destination datatypes match,
+ * values of the requested component(s) are contiguous in memory
+ * with the destination stride, and the parent numbering is trivial
+ * or contiguous, relative to a single parent list.
+ *
+ * parameters (see fvm_convert_array()):
+ *   src_dim          <-- dimension of source data
+ *   src_dim_shift    <-- source data dimension shift (start index)
+ *   dest_dim         <-- destination data dimension (1 if non interlaced)
+ *   src_idx_start    <-- start index in source data
+ *   src_idx_end      <-- past-the-end index in source data
+ *   src_interlace    <-- indicates if source data is interlaced
+ *   src_datatype     <-- source data type
+ *   dest_datatype    <-- destination data type
+ *   n_parent_lists   <-- number of parent lists (if parent_num != NULL)
+ *   parent_num_shift <-- parent number to value array index shifts;
+ *                        size: n_parent_lists
+ *   parent_num       <-- if n_parent_lists > 0, parent entity numbers
+ *   src_data         <-- array of source arrays
+ *
+ * returns:
+ *   pointer to values matching src_idx_start, or NULL if values
+ *   must be converted
+ *----------------------------------------------------------------------------*/
+
+static const void *
+_direct_values(int                    src_dim,
+               int                    src_dim_shift,
+               int                    dest_dim,
+               cs_lnum_t              src_idx_start,
+               cs_lnum_t              src_idx_end,
+               cs_interlace_t         src_interlace,
+               cs_datatype_t          src_datatype,
+               cs_datatype_t          dest_datatype,
+               int                    n_parent_lists,
+               const cs_lnum_t        parent_num_shift[],
+               const cs_lnum_t        parent_num[],
+               const void      *const src_data[])
+{
+  int list_stride = 0, list_shift = 0;
+  int pl = 0;
+  cs_lnum_t id_start = src_idx_start;
+
+  if (src_datatype != dest_datatype || src_idx_end <= src_idx_start)
+    return NULL;
+
+  /* Source list and component layout */
+
+  if (dest_dim == 1 && (src_interlace == CS_NO_INTERLACE || src_dim == 1)) {
+    list_stride = src_dim;
+    list_shift = src_dim_shift;
+  }
+  else if (   dest_dim == src_dim && src_dim_shift == 0
+           && src_interlace == CS_INTERLACE)
+    list_stride = 1;
+  else
+    return NULL;
+
+  /* Parent numbering */
+
+  if (n_parent_lists > 0) {
+
+    cs_lnum_t p_start = src_idx_start, p_end = src_idx_end - 1;
+
+    if (parent_num != NULL) {
+      for (cs_lnum_t j = src_idx_start + 1; j < src_idx_end; j++) {
+        if (parent_num[j] != parent_num[j-1] + 1)
+          return NULL;
+      }
+      p_start = parent_num[src_idx_start] - 1;
+      p_end = parent_num[src_idx_end - 1] - 1;
+    }
+
+    for (pl = n_parent_lists - 1; p_start < parent_num_shift[pl]; pl--);
+    assert(pl > -1);
+
+    if (pl < n_parent_lists - 1 && p_end >= parent_num_shift[pl + 1])
+      return NULL;
+
+    id_start = p_start - parent_num_shift[pl];
+
+  }
+
+  const unsigned char *src = src_data[list_stride*pl + list_shift];
+
+  if (src == NULL)
+    return NULL;
+
+  return src + (size_t)id_start*dest_dim*cs_datatype_size[src_datatype];
+}
+
 /*----------------------------------------------------------------------------
  * Reorder data components for output if needed.
  *
@@ -305,64 +620,31 @@ _extra_vertex_get_gnum(const fvm_nodal_t  *mesh,
 }
 
 /*----------------------------------------------------------------------------
- * Output per-element field values in parallel mode.
- *
- * Note that if the output data is not interleaved, for multidimensional data,
- * the output function is called once per component, using the same buffer.
- * This is a good fit for most options, but if a format requires writing
- * additional buffering may be required in the context.
+ * Build part to block distribution for a group of exported sections.
  *
  * parameters:
- *   helper           <-> pointer to helper structure
- *   context          <-> pointer to writer context
- *   export_section   <-- pointer to section helper structure
- *   src_dim          <-- dimension of source data
- *   src_interlace    <-- indicates if field in memory is interlaced
- *   comp_order       <-- field component reordering array, or NULL
- *   n_parent_lists   <-- indicates if field values are to be obtained
- *                        directly through the local entity index (when 0) or
- *                        through the parent entity numbers (when 1 or more)
- *   parent_num_shift <-- parent list to common number index shifts;
- *                        size: n_parent_lists
- *   datatype         <-- indicates the data type of (source) field values
- *   field_values     <-- array of associated field value arrays
- *   output_func      <-- pointer to output function
- *
- * returns:
- *   pointer to next section helper structure in list
+ *   h                <-- pointer to helper structure
+ *   export_section   <-- pointer to first section helper structure of group
+ *   n_sections       <-- number of grouped sections
+ *   part_size        <-- local number of elements of grouped sections
+ *   n_g_elements     <-- global number of elements of grouped sections
+ *   have_tesselation <-- true if grouped sections are tesselated
+ *   min_block_size   <-- minimum block size (in elements)
+ *   dist             --> distribution structure
  *----------------------------------------------------------------------------*/
 
-#if defined(__INTEL_COMPILER) && defined(__KNC__)
-#pragma optimization_level 1 /* Crash with O2 on KNC with icc 14.0.0 20130728 */
-#endif
-
-static const fvm_writer_section_t *
-_field_helper_output_eg(fvm_writer_field_helper_t          *helper,
-                        void                               *context,
-                        const fvm_writer_section_t         *export_section,
-                        int                                 src_dim,
-                        cs_interlace_t                      src_interlace,
-                        const int                          *comp_order,
-                        int                                 n_parent_lists,
-                        const cs_lnum_t                     parent_num_shift[],
-                        cs_datatype_t                       datatype,
-                        const void                   *const field_values[],
-                        fvm_writer_field_output_t          *output_func)
+static void
+_element_dist_create(const fvm_writer_field_helper_t  *h,
+                     const fvm_writer_section_t       *export_section,
+                     int                               n_sections,
+                     cs_lnum_t                         part_size,
+                     cs_gnum_t                         n_g_elements,
+                     bool                              have_tesselation,
+                     cs_lnum_t                         min_block_size,
+                     _dist_cache_t                    *dist)
 {
-  fvm_writer_field_helper_t *h = helper;
-
-  cs_block_dist_info_t  bi;
-  cs_part_to_block_t  *d = NULL;
-
-  int         n_sections = 0;
-  bool        have_tesselation = false;
-  cs_lnum_t   part_size = 0, block_size = 0;
-  cs_gnum_t   block_sub_size = 0, block_start = 0, block_end = 0;
-  cs_gnum_t   n_g_elements = 0;
-
-  int  *part_n_sub = NULL, *block_n_sub = NULL;
-  unsigned char  *part_values = NULL;
-  unsigned char  *block_values = NULL, *_block_values = NULL;
+  int  *part_n_sub = NULL;
+  cs_gnum_t  block_sub_size = 0;
 
   cs_gnum_t         *_g_elt_num = NULL;
   const cs_gnum_t   *g_elt_num
@@ -370,28 +652,19 @@ _field_helper_output_eg(fvm_writer_field_helper_t          *helper,
 
   const fvm_writer_section_t  *current_section = NULL;
 
-  const size_t stride = (h->interlace == CS_INTERLACE) ? h->field_dim : 1;
-  const size_t elt_size = cs_datatype_size[h->datatype];
-  const size_t min_block_size =   h->min_block_size
-                                / (elt_size*stride);
+  /* Key */
 
-  /* Loop on sections to count output size */
-
-  current_section = export_section;
-  do {
-
-    const fvm_nodal_section_t  *section = current_section->section;
-
-    n_sections += 1;
-    n_g_elements += fvm_io_num_get_global_count(section->global_element_num);
-    part_size += fvm_io_num_get_local_count(section->global_element_num);
-    if (current_section->type != section->type)
-      have_tesselation = true;
-
-    current_section = current_section->next;
-
-  } while (   current_section != NULL
-           && current_section->continues_previous == true);
+  dist->section = export_section->section;
+  dist->type = export_section->type;
+  dist->n_sections = n_sections;
+  dist->n_add = 0;
+  dist->g_num = g_elt_num;
+  dist->part_size = part_size;
+  dist->n_g_elts = n_g_elements;
+  dist->comm = h->comm;
+  dist->min_rank_step = h->min_rank_step;
+  dist->min_block_size = min_block_size;
+  dist->block_n_sub = NULL;
 
   /* Build global numbering if necessary */
 
@@ -406,7 +679,7 @@ _field_helper_output_eg(fvm_writer_field_helper_t          *helper,
     /* loop on sections which should be appended */
 
     current_section = export_section;
-    do {
+    for (int i = 0; i < n_sections; i++) {
 
       const fvm_nodal_section_t  *section = current_section->section;
       const cs_lnum_t section_size
@@ -423,9 +696,7 @@ _field_helper_output_eg(fvm_writer_field_helper_t          *helper,
 
       current_section = current_section->next;
 
-
-    } while (   current_section != NULL
-             && current_section->continues_previous == true);
+    }
   }
 
   /* Build sub-element count if necessary */
@@ -437,7 +708,7 @@ _field_helper_output_eg(fvm_writer_field_helper_t          *helper,
     BFT_MALLOC(part_n_sub, part_size, int);
 
     current_section = export_section;
-    do {
+    for (int i = 0; i < n_sections; i++) {
 
       const fvm_nodal_section_t  *section = current_section->section;
       const cs_lnum_t section_size
@@ -458,47 +729,168 @@ _field_helper_output_eg(fvm_writer_field_helper_t          *helper,
 
       current_section = current_section->next;
 
-    } while (   current_section != NULL
-             && current_section->continues_previous == true);
+    }
   }
 
   /* Build distribution structures */
 
-  bi = cs_block_dist_compute_sizes(h->rank,
-                                   h->n_ranks,
-                                   h->min_rank_step,
-                                   min_block_size,
-                                   n_g_elements);
+  dist->bi = cs_block_dist_compute_sizes(h->rank,
+                                         h->n_ranks,
+                                         h->min_rank_step,
+                                         min_block_size,
+                                         n_g_elements);
 
-  block_size = bi.gnum_range[1] - bi.gnum_range[0];
+  const cs_lnum_t block_size = dist->bi.gnum_range[1] - dist->bi.gnum_range[0];
 
-  d = cs_part_to_block_create_by_gnum(h->comm, bi, part_size, g_elt_num);
+  dist->d = cs_part_to_block_create_by_gnum(h->comm,
+                                            dist->bi,
+                                            part_size,
+                                            g_elt_num);
 
   if (_g_elt_num != NULL)
-    cs_part_to_block_transfer_gnum(d, _g_elt_num);
-
-  g_elt_num = NULL;
-  _g_elt_num = NULL;
+    cs_part_to_block_transfer_gnum(dist->d, _g_elt_num);
 
   /* Distribute sub-element info in case of tesselation */
 
   if (have_tesselation) {
 
-    BFT_MALLOC(block_n_sub, block_size, int);
+    BFT_MALLOC(dist->block_n_sub, block_size, int);
 
-    cs_part_to_block_copy_array(d,
+    cs_part_to_block_copy_array(dist->d,
                                 CS_INT_TYPE,
                                 1,
                                 part_n_sub,
-                                block_n_sub);
+                                dist->block_n_sub);
     BFT_FREE(part_n_sub);
 
     for (cs_lnum_t j = 0; j < block_size; j++)
-      block_sub_size += block_n_sub[j];
+      block_sub_size += dist->block_n_sub[j];
+
+    MPI_Scan(&block_sub_size, &(dist->block_end), 1, CS_MPI_GNUM, MPI_SUM,
+             h->comm);
+    dist->block_end += 1;
+    dist->block_start = dist->block_end - block_sub_size;
 
   }
-  else
-    block_sub_size = block_size;
+  else {
+    dist->block_start = dist->bi.gnum_range[0];
+    dist->block_end = dist->bi.gnum_range[1];
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Output per-element field values in parallel mode.
+ *
+ * Note that if the output data is not interleaved, for multidimensional data,
+ * the output function is called once per component, using the same buffer.
+ * This is a good fit for most options, but if a format requires writing
+ * additional buffering may be required in the context.
+ *
+ * parameters:
+ *   helper           <-> pointer to helper structure
+ *   context          <-> pointer to writer context
+ *   export_section   <-- pointer to section helper structure
+ *   src_dim          <-- dimension of source data
+ *   src_interlace    <-- indicates if field in memory is interlaced
+ *   comp_order       <-- field component reordering array, or NULL
+ *   n_parent_lists   <-- indicates if field values are to be obtained
+ *                        directly through the local entity index (when 0) or
+ *                        through the parent entity numbers (when 1 or more)
+ *   parent_num_shift <-- parent list to common number index shifts;
+ *                        size: n_parent_lists
+ *   datatype         <-- indicates the data type of (source) field values
+ *   field_values     <-- array of associated field value arrays
+ *   output_func      <-- pointer to output function
+ *
+ * returns:
+ *   pointer to next section helper structure in list
+ *----------------------------------------------------------------------------*/
+
+#if defined(__INTEL_COMPILER) && defined(__KNC__)
+#pragma optimization_level 1 /* Crash with O2 on KNC with icc 14.0.0 20130728 */
+#endif
+
+static const fvm_writer_section_t *
+_field_helper_output_eg(fvm_writer_field_helper_t          *helper,
+                        void                               *context,
+                        const fvm_writer_section_t         *export_section,
+                        int                                 src_dim,
+                        cs_interlace_t                      src_interlace,
+                        const int                          *comp_order,
+                        int                                 n_parent_lists,
+                        const cs_lnum_t                     parent_num_shift[],
+                        cs_datatype_t                       datatype,
+                        const void                   *const field_values[],
+                        fvm_writer_field_output_t          *output_func)
+{
+  fvm_writer_field_helper_t *h = helper;
+
+  _dist_cache_t  _dist;
+  const _dist_cache_t  *dist = NULL;
+
+  int         n_sections = 0;
+  bool        have_tesselation = false;
+  cs_lnum_t   part_size = 0, block_size = 0;
+  cs_gnum_t   block_sub_size = 0;
+  cs_gnum_t   n_g_elements = 0;
+
+  unsigned char  *part_values = NULL;
+  unsigned char  *block_values = NULL, *_block_values = NULL;
+
+  const fvm_writer_section_t  *current_section = NULL;
+
+  const size_t stride = (h->interlace == CS_INTERLACE) ? h->field_dim : 1;
+  const size_t elt_size = cs_datatype_size[h->datatype];
+  const size_t min_block_size =   h->min_block_size
+                                / (elt_size*stride);
+
+  /* Loop on sections to count output size */
+
+  current_section = export_section;
+  do {
+
+    const fvm_nodal_section_t  *section = current_section->section;
+
+    n_sections += 1;
+    n_g_elements += fvm_io_num_get_global_count(section->global_element_num);
+    part_size += fvm_io_num_get_local_count(section->global_element_num);
+    if (current_section->type != section->type)
+      have_tesselation = true;
+
+    current_section = current_section->next;
+
+  } while (   current_section != NULL
+           && current_section->continues_previous == true);
+
+  /* Get or build distribution structures */
+
+  dist = _dist_cache_find(h,
+                          export_section->section,
+                          export_section->type,
+                          n_sections,
+                          0,
+                          fvm_io_num_get_global_num
+                            (export_section->section->global_element_num),
+                          part_size,
+                          n_g_elements,
+                          min_block_size);
+
+  if (dist == NULL) {
+    _element_dist_create(h,
+                         export_section,
+                         n_sections,
+                         part_size,
+                         n_g_elements,
+                         have_tesselation,
+                         min_block_size,
+                         &_dist);
+    dist = _dist_cache_keep(h, &_dist);
+  }
+
+  const int *block_n_sub = dist->block_n_sub;
+
+  block_size = dist->bi.gnum_range[1] - dist->bi.gnum_range[0];
+  block_sub_size = dist->block_end - dist->block_start;
 
   /* Number of loops on dimension and conversion output dimension */
 
@@ -507,26 +899,22 @@ _field_helper_output_eg(fvm_writer_field_helper_t          *helper,
 
   /* To save space, in case of tesselation, part_values and _block_values
      point to the same memory space, as they are not needed simultaneously.
-     Without tesselation, _block_values simply points to block_values */
+     Without tesselation, _block_values simply points to block_values,
+     and part_values is only allocated if source values may not be
+     used directly */
 
-  BFT_MALLOC(block_values, block_size*elt_size*stride, unsigned char);
+  block_values = _get_work_buffer(h, 1, block_size*elt_size*stride);
 
   if (have_tesselation) {
-    BFT_MALLOC(part_values,
-               (  CS_MAX(part_size, (cs_lnum_t)block_sub_size)
-                * elt_size*convert_dim),
-               unsigned char);
-    MPI_Scan(&block_sub_size, &block_end, 1, CS_MPI_GNUM, MPI_SUM, h->comm);
-    block_end += 1;
-    block_start = block_end - block_sub_size;
+    part_values = _get_work_buffer(h,
+                                   0,
+                                   (  CS_MAX(part_size,
+                                             (cs_lnum_t)block_sub_size)
+                                    * elt_size*convert_dim));
     _block_values = part_values;
   }
-  else {
-    BFT_MALLOC(part_values, part_size*elt_size*convert_dim, unsigned char);
-    block_start = bi.gnum_range[0];
-    block_end = bi.gnum_range[1];
+  else
     _block_values = block_values;
-  }
 
   /* Loop on dimension (for non-interlaced output) */
 
@@ -539,58 +927,96 @@ _field_helper_output_eg(fvm_writer_field_helper_t          *helper,
       cs_lnum_t start_id = 0;
       cs_lnum_t src_shift = 0;
 
+      const void *src_values = NULL;
+
       const int comp_id_in = comp_order != NULL ? comp_order[comp_id] : comp_id;
 
-      /* loop on sections which should be appended */
+      /* Use source values directly when possible */
 
-      current_section = export_section;
-      do {
+      if (   n_sections == 1 && have_tesselation == false
+          && (comp_order == NULL || convert_dim == 1)) {
 
-        unsigned char *_part_values =   part_values
-                                      + (size_t)start_id*elt_size*convert_dim;
-
-        const fvm_nodal_section_t  *section = current_section->section;
+        const fvm_nodal_section_t  *section = export_section->section;
 
         if (n_parent_lists == 0)
-          src_shift = current_section->num_shift;
+          src_shift = export_section->num_shift;
+
+        src_values = _direct_values(src_dim,
+                                    comp_id_in,
+                                    convert_dim,
+                                    src_shift,
+                                    section->n_elements + src_shift,
+                                    src_interlace,
+                                    datatype,
+                                    h->datatype,
+                                    n_parent_lists,
+                                    parent_num_shift,
+                                    section->parent_element_num,
+                                    field_values);
 
-        fvm_convert_array(src_dim,
-                          comp_id_in,
-                          convert_dim,
-                          src_shift,
-                          section->n_elements + src_shift,
-                          src_interlace,
-                          datatype,
-                          h->datatype,
-                          n_parent_lists,
-                          parent_num_shift,
-                          section->parent_element_num,
-                          field_values,
-                          _part_values);
+      }
 
-        start_id += fvm_io_num_get_local_count(section->global_element_num);
+      /* Otherwise, loop on sections which should be appended */
 
-        current_section = current_section->next;
+      if (src_values == NULL) {
 
-      } while (   current_section != NULL
-               && current_section->continues_previous == true);
+        const fvm_writer_section_t  *s_section = export_section;
 
-      /* Reorder components if required
-         (for interlaced output; done though dim_loops if non-interlaced) */
+        if (part_values == NULL)
+          part_values = _get_work_buffer(h,
+                                         0,
+                                         part_size*elt_size*convert_dim);
 
-      if (comp_order != NULL && convert_dim > 1)
-        _reorder_components(part_size,
+        do {
+
+          unsigned char *_part_values
+            = part_values + (size_t)start_id*elt_size*convert_dim;
+
+          const fvm_nodal_section_t  *section = s_section->section;
+
+          if (n_parent_lists == 0)
+            src_shift = s_section->num_shift;
+
+          fvm_convert_array(src_dim,
+                            comp_id_in,
                             convert_dim,
+                            src_shift,
+                            section->n_elements + src_shift,
+                            src_interlace,
+                            datatype,
                             h->datatype,
-                            comp_order,
-                            part_values);
+                            n_parent_lists,
+                            parent_num_shift,
+                            section->parent_element_num,
+                            field_values,
+                            _part_values);
+
+          start_id += fvm_io_num_get_local_count(section->global_element_num);
+
+          s_section = s_section->next;
+
+        } while (s_section != current_section);
+
+        /* Reorder components if required
+           (for interlaced output; done though dim_loops if non-interlaced) */
+
+        if (comp_order != NULL && convert_dim > 1)
+          _reorder_components(part_size,
+                              convert_dim,
+                              h->datatype,
+                              comp_order,
+                              part_values);
+
+        src_values = part_values;
+
+      }
 
       /* Distribute part values */
 
-      cs_part_to_block_copy_array(d,
+      cs_part_to_block_copy_array(dist->d,
                                   h->datatype,
                                   convert_dim,
-                                  part_values,
+                                  src_values,
                                   block_values);
 
       /* Scatter values to sub-elements in case of tesselation */
@@ -620,19 +1046,17 @@ _field_helper_output_eg(fvm_writer_field_helper_t          *helper,
                 h->datatype,
                 h->field_dim,
                 comp_id,
-                block_start,
-                block_end,
+                dist->block_start,
+                dist->block_end,
                 _block_values);
 
   } /* end of loop on spatial dimension */
 
-  BFT_FREE(block_values);
-  BFT_FREE(part_values);
+  _release_work_buffer(h, &block_values);
+  _release_work_buffer(h, &part_values);
 
-  cs_part_to_block_destroy(&d);
-
-  if (block_n_sub != NULL)
-    BFT_FREE(block_n_sub);
+  if (h->cache_id < 0)
+    _dist_destroy(&_dist);
 
   /* Return pointer to next section */
 
@@ -719,10 +1143,10 @@ _field_helper_output_el(fvm_writer_field_helper_t          *helper,
   const int n_dim_loops = (h->interlace == CS_INTERLACE) ? 1 : h->field_dim;
   const int convert_dim = (h->interlace == CS_INTERLACE) ? h->field_dim : 1;
 
-  BFT_MALLOC(values,
-             (  CS_MAX(n_elements, (cs_lnum_t)sub_size)
-              * elt_size*convert_dim),
-             unsigned char);
+  values = _get_work_buffer(h,
+                            0,
+                            (  CS_MAX(n_elements, (cs_lnum_t)sub_size)
+                             * elt_size*convert_dim));
 
   /* Loop on dimension (for non-interlaced output) */
 
@@ -803,13 +1227,6 @@ _field_helper_output_el(fvm_writer_field_helper_t          *helper,
 
     /* Write block values */
 
-    {
-      int eo = 0;
-      for (cs_lnum_t ii = 0; ii < convert_dim*sub_size; ii++) {
-        if (values[ii] != 0)
-          eo++;
-      }
-    }
     output_func(context,
                 h->datatype,
                 h->field_dim,
@@ -820,7 +1237,7 @@ _field_helper_output_el(fvm_writer_field_helper_t          *helper,
 
   } /* end of loop on spatial dimension */
 
-  BFT_FREE(values);
+  _release_work_buffer(h, &values);
 
   /* Return pointer to next section */
 
@@ -867,38 +1284,76 @@ _field_helper_output_ng(fvm_writer_field_helper_t        *helper,
 {
   fvm_writer_field_helper_t *h = helper;
 
-  cs_block_dist_info_t  bi;
+  _dist_cache_t  _dist;
+  const _dist_cache_t  *dist = NULL;
 
   cs_lnum_t       part_size = 0, block_size = 0;
   unsigned char  *part_values = NULL, *block_values = NULL;
-  cs_part_to_block_t  *d = NULL;
 
   const size_t stride = (h->interlace == CS_INTERLACE) ? h->field_dim : 1;
   const size_t elt_size = cs_datatype_size[h->datatype];
   const size_t min_block_size =   h->min_block_size
                                 / (elt_size*stride);
 
-  /* Initialize distribution info */
+  const cs_gnum_t *g_vtx_num = NULL;
+  cs_gnum_t n_g_vertices = helper->n_g_vertices_add;
 
-  fvm_writer_vertex_part_to_block_create(h->min_rank_step,
-                                         min_block_size,
-                                         helper->n_g_vertices_add,
-                                         helper->n_vertices_add,
-                                         mesh,
-                                         &bi,
-                                         &d,
-                                         h->comm);
+  if (mesh->global_vertex_num != NULL) {
+    g_vtx_num = fvm_io_num_get_global_num(mesh->global_vertex_num);
+    n_g_vertices += fvm_io_num_get_global_count(mesh->global_vertex_num);
+  }
+
+  /* Get or build distribution info */
+
+  dist = _dist_cache_find(h,
+                          NULL,
+                          FVM_N_ELEMENT_TYPES,
+                          0,
+                          helper->n_vertices_add,
+                          g_vtx_num,
+                          mesh->n_vertices + helper->n_vertices_add,
+                          n_g_vertices,
+                          min_block_size);
+
+  if (dist == NULL) {
+
+    _dist.section = NULL;
+    _dist.type = FVM_N_ELEMENT_TYPES;
+    _dist.n_sections = 0;
+    _dist.n_add = helper->n_vertices_add;
+    _dist.g_num = g_vtx_num;
+    _dist.part_size = mesh->n_vertices + helper->n_vertices_add;
+    _dist.n_g_elts = n_g_vertices;
+    _dist.comm = h->comm;
+    _dist.min_rank_step = h->min_rank_step;
+    _dist.min_block_size = min_block_size;
+    _dist.block_n_sub = NULL;
+
+    fvm_writer_vertex_part_to_block_create(h->min_rank_step,
+                                           min_block_size,
+                                           helper->n_g_vertices_add,
+                                           helper->n_vertices_add,
+                                           mesh,
+                                           &(_dist.bi),
+                                           &(_dist.d),
+                                           h->comm);
+
+    _dist.block_start = _dist.bi.gnum_range[0];
+    _dist.block_end = _dist.bi.gnum_range[1];
+
+    dist = _dist_cache_keep(h, &_dist);
 
-  part_size = cs_part_to_block_get_n_part_ents(d);
-  block_size = bi.gnum_range[1] - bi.gnum_range[0];
+  }
+
+  part_size = cs_part_to_block_get_n_part_ents(dist->d);
+  block_size = dist->bi.gnum_range[1] - dist->bi.gnum_range[0];
 
   /* Number of loops on dimension and conversion output dimension */
 
   const int n_dim_loops = (h->interlace == CS_INTERLACE) ? 1 : h->field_dim;
   const int convert_dim = (h->interlace == CS_INTERLACE) ? h->field_dim : 1;
 
-  BFT_MALLOC(part_values, part_size*elt_size*convert_dim, unsigned char);
-  BFT_MALLOC(block_values, block_size*elt_size*convert_dim, unsigned char);
+  block_values = _get_work_buffer(h, 1, block_size*elt_size*convert_dim);
 
   /* Loop on dimension (for non-interlaced output) */
 
@@ -911,87 +1366,120 @@ _field_helper_output_ng(fvm_writer_field_helper_t        *helper,
       cs_lnum_t start_id = 0;
       cs_lnum_t end_id = mesh->n_vertices;
 
+      const void *src_values = NULL;
+
       const int comp_id_in = comp_order != NULL ? comp_order[comp_id] : comp_id;
 
-      /* Distribute partition to block values */
+      /* Use source values directly when possible */
 
-      /* Main vertices */
+      if (   helper->n_vertices_add == 0
+          && (comp_order == NULL || convert_dim == 1))
+        src_values = _direct_values(src_dim,
+                                    comp_id_in,
+                                    convert_dim,
+                                    start_id,
+                                    end_id,
+                                    src_interlace,
+                                    datatype,
+                                    h->datatype,
+                                    n_parent_lists,
+                                    parent_num_shift,
+                                    mesh->parent_vertex_num,
+                                    field_values);
 
-      fvm_convert_array(src_dim,
-                        comp_id_in,
-                        convert_dim,
-                        start_id,
-                        end_id,
-                        src_interlace,
-                        datatype,
-                        h->datatype,
-                        n_parent_lists,
-                        parent_num_shift,
-                        mesh->parent_vertex_num,
-                        field_values,
-                        part_values);
+      /* Otherwise, convert values */
 
-      /* Additional vertices in case of tesselation
-         (end_id == part_size with no tesselation or if all tesselated
-         sections have been accounted for).*/
+      if (src_values == NULL) {
 
-      if (helper->n_vertices_add > 0) {
+        if (part_values == NULL)
+          part_values = _get_work_buffer(h, 0, part_size*elt_size*convert_dim);
 
-        for (cs_lnum_t j = 0; end_id < part_size && j < mesh->n_sections; j++) {
+        /* Distribute partition to block values */
 
-          const fvm_nodal_section_t  *section = mesh->sections[j];
+        /* Main vertices */
 
-          if (section->type == FVM_CELL_POLY && section->tesselation != NULL) {
+        fvm_convert_array(src_dim,
+                          comp_id_in,
+                          convert_dim,
+                          start_id,
+                          end_id,
+                          src_interlace,
+                          datatype,
+                          h->datatype,
+                          n_parent_lists,
+                          parent_num_shift,
+                          mesh->parent_vertex_num,
+                          field_values,
+                          part_values);
 
-            cs_lnum_t   n_extra_vertices
-              = fvm_tesselation_n_vertices_add(section->tesselation);
+        /* Additional vertices in case of tesselation
+           (end_id == part_size with no tesselation or if all tesselated
+           sections have been accounted for).*/
 
-            start_id = end_id;
-            end_id = start_id + n_extra_vertices;
+        if (helper->n_vertices_add > 0) {
 
-            size_t part_values_shift =   (size_t)start_id
-                                       * (size_t)convert_dim
-                                       * elt_size;
+          for (cs_lnum_t j = 0;
+               end_id < part_size && j < mesh->n_sections;
+               j++) {
 
-            fvm_tesselation_vertex_values(section->tesselation,
-                                          src_dim,
-                                          comp_id_in,
-                                          convert_dim,
-                                          0,
-                                          n_extra_vertices,
-                                          h->interlace,
-                                          datatype,
-                                          h->datatype,
-                                          n_parent_lists,
-                                          parent_num_shift,
-                                          mesh->parent_vertex_num,
-                                          field_values,
-                                          part_values + part_values_shift);
+            const fvm_nodal_section_t  *section = mesh->sections[j];
 
-          }
+            if (   section->type == FVM_CELL_POLY
+                && section->tesselation != NULL) {
 
-        } /* End of loops on tesselated sections */
+              cs_lnum_t   n_extra_vertices
+                = fvm_tesselation_n_vertices_add(section->tesselation);
 
-        assert(end_id == part_size);
+              start_id = end_id;
+              end_id = start_id + n_extra_vertices;
 
-      }
+              size_t part_values_shift =   (size_t)start_id
+                                         * (size_t)convert_dim
+                                         * elt_size;
 
-      /* Reorder components if required
-         (for interlaced output; done though dim_loops if non-interlaced) */
+              fvm_tesselation_vertex_values(section->tesselation,
+                                            src_dim,
+                                            comp_id_in,
+                                            convert_dim,
+                                            0,
+                                            n_extra_vertices,
+                                            h->interlace,
+                                            datatype,
+                                            h->datatype,
+                                            n_parent_lists,
+                                            parent_num_shift,
+                                            mesh->parent_vertex_num,
+                                            field_values,
+                                            part_values + part_values_shift);
 
-      if (comp_order != NULL && convert_dim > 1)
-        _reorder_components(part_size,
-                            convert_dim,
-                            h->datatype,
-                            comp_order,
-                            part_values);
+            }
+
+          } /* End of loops on tesselated sections */
+
+          assert(end_id == part_size);
+
+        }
+
+        /* Reorder components if required
+           (for interlaced output; done though dim_loops if non-interlaced) */
+
+        if (comp_order != NULL && convert_dim > 1)
+          _reorder_components(part_size,
+                              convert_dim,
+                              h->datatype,
+                              comp_order,
+                              part_values);
+
+        src_values = part_values;
+
+      }
 
       /* Distribute part values */
 
-      cs_part_to_block_copy_array(d,
+      cs_part_to_block_copy_array(dist->d,
                                   h->datatype,
                                   convert_dim,
-                                  part_values,
+                                  src_values,
                                   block_values);
 
     }
@@ -1000,22 +1488,23 @@ _field_helper_output_ng(fvm_writer_field_helper_t        *helper,
        (for non-interlaced output; done in fvm_convert_array if interlaced) */
 
     else
-      _zero_values(part_size, h->datatype, block_values);
+      _zero_values(block_size, h->datatype, block_values);
 
     output_func(context,
                 h->datatype,
                 h->field_dim,
                 comp_id,
-                bi.gnum_range[0],
-                bi.gnum_range[1],
+                dist->block_start,
+                dist->block_end,
                 block_values);
 
   }
 
-  BFT_FREE(block_values);
-  BFT_FREE(part_values);
+  _release_work_buffer(h, &block_values);
+  _release_work_buffer(h, &part_values);
 
-  cs_part_to_block_destroy(&d);
+  if (h->cache_id < 0)
+    _dist_destroy(&_dist);
 }
 
 #endif /* defined(HAVE_MPI) */
@@ -1070,7 +1559,7 @@ _field_helper_output_nl(fvm_writer_field_helper_t        *helper,
 
   /* Allocate buffer */
 
-  BFT_MALLOC(values, n_vertices*elt_size*convert_dim, unsigned char);
+  values = _get_work_buffer(h, 0, n_vertices*elt_size*convert_dim);
 
   /* Loop on dimension (for non-interlaced output) */
 
@@ -1176,7 +1665,7 @@ _field_helper_output_nl(fvm_writer_field_helper_t        *helper,
 
   }
 
-  BFT_FREE(values);
+  _release_work_buffer(h, &values);
 }
 
 /*============================================================================
@@ -1643,6 +2132,17 @@ fvm_writer_field_helper_create(const fvm_nodal_t          *mesh,
 
 #endif /* defined(HAVE_MPI) */
 
+  /* Associated mesh cache */
+
+  h->cache_id = -1;
+
+  for (int i = 0; mesh != NULL && i < _n_mesh_caches; i++) {
+    if (_mesh_caches[i].mesh == mesh) {
+      h->cache_id = i;
+      break;
+    }
+  }
+
   /* Compute local dimensions */
 
   if (location == FVM_WRITER_PER_ELEMENT) {
@@ -2455,6 +2955,86 @@ fvm_writer_field_component_name(char    *s,
   }
 }
 
+/*----------------------------------------------------------------------------
+ * Allow writer helpers to keep data associated with a given mesh
+ * (such as work buffers and part to block distributions) across
+ * successive outputs.
+ *
+ * The caller is responsible for calling fvm_writer_mesh_cache_remove()
+ * before the mesh is destroyed or its structure is modified.
+ *
+ * parameters:
+ *   mesh <-- pointer to nodal mesh structure
+ *----------------------------------------------------------------------------*/
+
+void
+fvm_writer_mesh_cache_add(const fvm_nodal_t  *mesh)
+{
+  if (mesh == NULL)
+    return;
+
+  for (int i = 0; i < _n_mesh_caches; i++) {
+    if (_mesh_caches[i].mesh == mesh)
+      return;
+  }
+
+  BFT_REALLOC(_mesh_caches, _n_mesh_caches + 1, _mesh_cache_t);
+
+  _mesh_cache_t *mc = _mesh_caches + _n_mesh_caches;
+
+  mc->mesh = mesh;
+  for (int i = 0; i < 2; i++) {
+    mc->buffer_size[i] = 0;
+    mc->buffer[i] = NULL;
+  }
+
+#if defined(HAVE_MPI)
+  mc->n_dists = 0;
+  mc->dists = NULL;
+#endif
+
+  _n_mesh_caches += 1;
+}
+
+/*----------------------------------------------------------------------------
+ * Free data kept by writer helpers for a given mesh.
+ *
+ * parameters:
+ *   mesh <-- pointer to nodal mesh structure, or NULL for all meshes
+ *----------------------------------------------------------------------------*/
+
+void
+fvm_writer_mesh_cache_remove(const fvm_nodal_t  *mesh)
+{
+  int j = 0;
+
+  for (int i = 0; i < _n_mesh_caches; i++) {
+
+    _mesh_cache_t *mc = _mesh_caches + i;
+
+    if (mesh == NULL || mc->mesh == mesh) {
+      for (int k = 0; k < 2; k++)
+        BFT_FREE(mc->buffer[k]);
+#if defined(HAVE_MPI)
+      for (int k = 0; k < mc->n_dists; k++)
+        _dist_destroy(mc->dists + k);
+      BFT_FREE(mc->dists);
+#endif
+    }
+    else {
+      if (j < i)
+        _mesh_caches[j] = *mc;
+      j++;
+    }
+
+  }
+
+  _n_mesh_caches = j;
+
+  if (_n_mesh_caches == 0)
+    BFT_FREE(_mesh_caches);
+}
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*----------------------------------------------------------------------------*/
@@ -51,12 +51,15 @@
 #include "bft_mem.h"
 #include "bft_printf.h"
 
+#include "cs_all_to_all.h"
 #include "cs_array.h"
 #include "cs_base.h"
+#include "cs_block_to_part.h"
 
 #include "cs_field.h"
 #include "cs_field_pointer.h"
 
+#include "cs_load_balance.h"
 #include "cs_math.h"
 #include "cs_mesh_location.h"
 
@@ -413,6 +416,10 @@ cs_lagr_coal_comb_t *cs_glob_lagr_coal_comb = &_lagr_coal_comb;
 
 cs_real_t *bound_stat = NULL;
 
+/* Number of values per source term in cs_glob_lagr_source_terms->st_val */
+
+static cs_lnum_t _n_st_vals = 0;
+
 const cs_lagr_zone_data_t     *cs_glob_lagr_boundary_conditions = NULL;
 const cs_lagr_zone_data_t     *cs_glob_lagr_volume_conditions = NULL;
 
@@ -1151,8 +1158,29 @@ cs_lagr_init_c_arrays(int          dim_cs_glob_lagr_source_terms[2],
                             st);
   }
 
+  _n_st_vals = cs_glob_mesh->n_cells_with_ghosts;
+
+  cs_lagr_map_c_arrays(dim_cs_glob_lagr_source_terms,
+                       p_cs_glob_lagr_source_terms);
+}
+
+/*----------------------------------------------------------------------------
+ * Return pointers to already allocated lagrangian arrays
+ *
+ * This function is intended for use by Fortran wrappers, after a
+ * reallocation of these arrays.
+ *
+ * parameters:
+ *   dim_cs_glob_lagr_source_terms --> dimensions for source terms pointer
+ *   p_cs_glob_lagr_source_terms   --> source terms pointer
+ *----------------------------------------------------------------------------*/
+
+void
+cs_lagr_map_c_arrays(int          dim_cs_glob_lagr_source_terms[2],
+                     cs_real_t  **p_cs_glob_lagr_source_terms)
+{
   *p_cs_glob_lagr_source_terms     = cs_glob_lagr_source_terms->st_val;
-  dim_cs_glob_lagr_source_terms[0] = cs_glob_mesh->n_cells_with_ghosts;
+  dim_cs_glob_lagr_source_terms[0] = _n_st_vals;
   dim_cs_glob_lagr_source_terms[1] = cs_glob_lagr_dim->ntersl;
 }
 
@@ -1181,7 +1209,7 @@ cs_lagr_finalize(void)
 
   /* geometry */
 
-  BFT_FREE(cs_glob_lagr_b_face_proj);
+  cs_lagr_geom_finalize();
 
   /* encrustation pointers */
 
@@ -1222,6 +1250,299 @@ cs_lagr_finalize(void)
     BFT_FREE(extra->grad_vel);
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Redistribute particles and Lagrangian arrays during a mesh
+ *        redistribution (see cs_load_balance.c).
+ *
+ * Particles are migrated to the rank owning their cell; their cell and
+ * neighbor boundary face ids are then updated to the new local numbering.
+ * Source terms, boundary statistics, precipitation model arrays, internal
+ * face conditions and statistics accumulators are migrated, and other
+ * mesh-dependent structures are rebuilt or discarded.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_redistribute(void)
+{
+  const cs_mesh_t *m = cs_glob_mesh;
+
+  /* Source terms (non-interleaved, cells with ghosts) */
+
+  const int ntersl = cs_glob_lagr_dim->ntersl;
+
+  if (cs_glob_lagr_source_terms->st_val != NULL && ntersl > 0) {
+
+    cs_lnum_t n_prev_cells;
+    cs_load_balance_get_prev_gnum(CS_MESH_LOCATION_CELLS, &n_prev_cells);
+
+    const cs_lnum_t n_cells_ext = m->n_cells_with_ghosts;
+
+    cs_real_t *st_val;
+    BFT_MALLOC(st_val, ntersl*n_cells_ext, cs_real_t);
+
+    for (int i = 0; i < ntersl; i++) {
+      cs_real_t *st;
+      BFT_MALLOC(st, n_prev_cells, cs_real_t);
+      memcpy(st,
+             cs_glob_lagr_source_terms->st_val + i*_n_st_vals,
+             n_prev_cells*sizeof(cs_real_t));
+      void *p = st;
+      cs_load_balance_redistribute_array(CS_MESH_LOCATION_CELLS,
+                                         CS_REAL_TYPE,
+                                         1,
+                                         &p);
+      st = p;
+      memcpy(st_val + i*n_cells_ext, st, n_cells_ext*sizeof(cs_real_t));
+      BFT_FREE(st);
+    }
+
+    BFT_FREE(cs_glob_lagr_source_terms->st_val);
+    cs_glob_lagr_source_terms->st_val = st_val;
+    _n_st_vals = n_cells_ext;
+
+  }
+
+  /* Boundary statistics (non-interleaved) */
+
+  const int n_boundary_stats = cs_glob_lagr_dim->n_boundary_stats;
+
+  if (bound_stat != NULL && n_boundary_stats > 0) {
+
+    cs_lnum_t n_prev_b_faces;
+    cs_load_balance_get_prev_gnum(CS_MESH_LOCATION_BOUNDARY_FACES,
+                                  &n_prev_b_faces);
+
+    cs_real_t *_bound_stat;
+    BFT_MALLOC(_bound_stat, n_boundary_stats*m->n_b_faces, cs_real_t);
+
+    for (int i = 0; i < n_boundary_stats; i++) {
+      cs_real_t *bs;
+      BFT_MALLOC(bs, n_prev_b_faces, cs_real_t);
+      memcpy(bs,
+             bound_stat + i*n_prev_b_faces,
+             n_prev_b_faces*sizeof(cs_real_t));
+      void *p = bs;
+      cs_load_balance_redistribute_array(CS_MESH_LOCATION_BOUNDARY_FACES,
+                                         CS_REAL_TYPE,
+                                         1,
+                                         &p);
+      bs = p;
+      memcpy(_bound_stat + i*m->n_b_faces, bs,
+             m->n_b_faces*sizeof(cs_real_t));
+      BFT_FREE(bs);
+    }
+
+    BFT_FREE(bound_stat);
+    bound_stat = _bound_stat;
+
+  }
+
+  /* Precipitation model (interleaved by class for dissolved mass) */
+
+  cs_lagr_precipitation_model_t *preci = cs_glob_lagr_precipitation_model;
+
+  if (cs_glob_lagr_model->precipitation == 1) {
+
+    void *p = preci->nbprec;
+    if (p != NULL) {
+      cs_load_balance_redistribute_array(CS_MESH_LOCATION_CELLS,
+                                         CS_INT_TYPE,
+                                         1,
+                                         &p);
+      preci->nbprec = p;
+    }
+
+    p = preci->solub;
+    if (p != NULL) {
+      cs_load_balance_redistribute_array(CS_MESH_LOCATION_CELLS,
+                                         CS_REAL_TYPE,
+                                         1,
+                                         &p);
+      preci->solub = p;
+    }
+
+    p = preci->mp_diss;
+    if (p != NULL && preci->nbrclas > 0) {
+      cs_load_balance_redistribute_array(CS_MESH_LOCATION_CELLS,
+                                         CS_REAL_TYPE,
+                                         preci->nbrclas,
+                                         &p);
+      preci->mp_diss = p;
+    }
+
+  }
+
+  /* Internal face conditions */
+
+  cs_lagr_internal_condition_t *internal_cond
+    = cs_glob_lagr_internal_conditions;
+
+  if (internal_cond != NULL && internal_cond->i_face_zone_id != NULL) {
+    void *p = internal_cond->i_face_zone_id;
+    cs_load_balance_redistribute_array(CS_MESH_LOCATION_INTERIOR_FACES,
+                                       CS_INT_TYPE,
+                                       1,
+                                       &p);
+    internal_cond->i_face_zone_id = p;
+  }
+
+  /* Statistics not stored as fields */
+
+  cs_lagr_stat_redistribute();
+
+  /* Work arrays (values recomputed at each time step) */
+
+  cs_lagr_extra_module_t *extra = cs_glob_lagr_extra_module;
+  if (extra->grad_pr != NULL)
+    BFT_REALLOC(extra->grad_pr, m->n_cells_with_ghosts, cs_real_3_t);
+  if (extra->grad_vel != NULL)
+    BFT_REALLOC(extra->grad_vel, m->n_cells_with_ghosts, cs_real_33_t);
+
+  /* Particles */
+
+#if defined(HAVE_MPI)
+
+  cs_lagr_particle_set_t *p_set = cs_glob_lagr_particle_set;
+
+  if (p_set != NULL) {
+
+    const cs_lagr_attribute_map_t *p_am = p_set->p_am;
+    const cs_lnum_t n_part = p_set->n_particles;
+    const bool have_face_id = (p_am->count[0][CS_LAGR_NEIGHBOR_FACE_ID] > 0);
+
+    cs_lnum_t n_prev_cells, n_prev_b_faces;
+    const cs_gnum_t *prev_cell_gnum
+      = cs_load_balance_get_prev_gnum(CS_MESH_LOCATION_CELLS, &n_prev_cells);
+    const cs_gnum_t *prev_b_face_gnum
+      = cs_load_balance_get_prev_gnum(CS_MESH_LOCATION_BOUNDARY_FACES,
+                                      &n_prev_b_faces);
+    const int *cell_rank = cs_load_balance_get_prev_cell_rank();
+
+    int *dest_rank;
+    cs_gnum_t *s_gnum;
+    BFT_MALLOC(dest_rank, n_part, int);
+    BFT_MALLOC(s_gnum, n_part*2, cs_gnum_t);
+
+    for (cs_lnum_t i = 0; i < n_part; i++) {
+      cs_lnum_t c_id = cs_lagr_particles_get_lnum(p_set, i, CS_LAGR_CELL_ID);
+      dest_rank[i] = cell_rank[c_id];
+      s_gnum[i*2] = prev_cell_gnum[c_id];
+      s_gnum[i*2 + 1] = 0;
+      if (have_face_id) {
+        cs_lnum_t f_id
+          = cs_lagr_particles_get_lnum(p_set, i, CS_LAGR_NEIGHBOR_FACE_ID);
+        if (f_id > -1)
+          s_gnum[i*2 + 1] = prev_b_face_gnum[f_id];
+      }
+    }
+
+    cs_all_to_all_t *d = cs_all_to_all_create(n_part,
+                                              0,
+                                              NULL,
+                                              dest_rank,
+                                              cs_glob_mpi_comm);
+
+    unsigned char *r_buffer
+      = cs_all_to_all_copy_array(d,
+                                 CS_CHAR,
+                                 p_am->extents,
+                                 false, /* reverse */
+                                 p_set->p_buffer,
+                                 NULL);
+
+    cs_gnum_t *r_gnum = cs_all_to_all_copy_array(d,
+                                                 CS_GNUM_TYPE,
+                                                 2,
+                                                 false, /* reverse */
+                                                 s_gnum,
+                                                 NULL);
+
+    cs_lnum_t n_recv = cs_all_to_all_n_elts_dest(d);
+
+    cs_all_to_all_destroy(&d);
+
+    BFT_FREE(s_gnum);
+    BFT_FREE(dest_rank);
+
+    if (cs_lagr_particle_set_resize(n_recv) < 0)
+      bft_error(__FILE__, __LINE__, 0,
+                _("%s: could not resize particle set to %ld particles."),
+                __func__, (long)n_recv);
+
+    memcpy(p_set->p_buffer, r_buffer, n_recv*p_am->extents);
+    p_set->n_particles = n_recv;
+    p_set->cell_sorted = false;
+
+    BFT_FREE(r_buffer);
+
+    /* Update local cell and face ids */
+
+    cs_gnum_t *r_cell_gnum, *r_face_gnum;
+    cs_lnum_t *r_id;
+    BFT_MALLOC(r_cell_gnum, n_recv, cs_gnum_t);
+    BFT_MALLOC(r_face_gnum, n_recv, cs_gnum_t);
+    BFT_MALLOC(r_id, n_recv, cs_lnum_t);
+
+    for (cs_lnum_t i = 0; i < n_recv; i++) {
+      r_cell_gnum[i] = r_gnum[i*2];
+      r_face_gnum[i] = r_gnum[i*2 + 1];
+    }
+
+    BFT_FREE(r_gnum);
+
+    cs_block_to_part_global_to_local(n_recv,
+                                     0,
+                                     m->n_cells,
+                                     false,
+                                     m->global_cell_num,
+                                     r_cell_gnum,
+                                     r_id);
+
+    for (cs_lnum_t i = 0; i < n_recv; i++) {
+      cs_lagr_particles_set_lnum(p_set, i, CS_LAGR_CELL_ID, r_id[i]);
+      cs_lagr_particles_set_lnum(p_set, i, CS_LAGR_RANK_ID, cs_glob_rank_id);
+    }
+
+    if (have_face_id) {
+      cs_block_to_part_global_to_local(n_recv,
+                                       0,
+                                       m->n_b_faces,
+                                       false,
+                                       m->global_b_face_num,
+                                       r_face_gnum,
+                                       r_id);
+      for (cs_lnum_t i = 0; i < n_recv; i++) {
+        cs_lnum_t f_id = (r_face_gnum[i] > 0) ? r_id[i] : -1;
+        cs_lagr_particles_set_lnum(p_set, i, CS_LAGR_NEIGHBOR_FACE_ID, f_id);
+      }
+    }
+
+    BFT_FREE(r_id);
+    BFT_FREE(r_face_gnum);
+    BFT_FREE(r_cell_gnum);
+
+  }
+
+#endif /* defined(HAVE_MPI) */
+
+  /* Mesh-dependent structures; temperature and Debye length arrays
+     of surface interaction models are rebuilt at the next time step */
+
+  cs_lagr_tracking_update_mesh();
+
+  if (cs_glob_lagr_model->dlvo)
+    cs_lagr_dlvo_finalize();
+  if (cs_glob_lagr_model->clogging)
+    cs_lagr_clogging_finalize();
+  if (cs_glob_lagr_model->roughness)
+    cs_lagr_roughness_finalize();
+
+  if (cs_glob_lagr_b_face_proj != NULL)
+    cs_lagr_geom();
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Provide access to injection set structure.
@@ -1914,6 +2235,11 @@ cs_lagr_solve_time_step(const int         itypfb[],
 
   _update_boundary_face_type();
 
+  /* Wall face data shared by near-wall particles for this time step */
+
+  if (lagr_model->deposition > 0)
+    cs_lagr_geom_wall_face_cache_update(vislen);
+
   /* Initialize counter */
 
   part_c->n_g_total = 0;
@@ -2231,7 +2557,6 @@ cs_lagr_solve_time_step(const int         itypfb[],
                   (const cs_real_3_t *)extra->grad_pr,
                   (const cs_real_33_t *)extra->grad_vel,
                   terbru,
-                  (const cs_real_t *)vislen,
                   &nresnew);
 
       /* Integration of SDEs for orientation of spheroids without inertia */
@@ -2303,16 +2628,46 @@ cs_lagr_solve_time_step(const int         itypfb[],
       if (   cs_glob_lagr_model->agglomeration == 1
           || cs_glob_lagr_model->fragmentation == 1 ) {
 
-        n_occupied_cells
-          = _get_n_occupied_cells(p_set, 0, p_set->n_particles);
+        const cs_lnum_t n_cells = cs_glob_mesh->n_cells;
+        const cs_lnum_t *cell_idx
+          = cs_lagr_particle_set_get_cell_index(p_set, n_cells);
+
+        if (cell_idx != NULL) {
+
+          n_occupied_cells = 0;
+          for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+            if (cell_idx[c_id+1] > cell_idx[c_id])
+              n_occupied_cells++;
+          }
+
+          BFT_MALLOC(occupied_cell_ids, n_occupied_cells, cs_lnum_t);
+          BFT_MALLOC(particle_list, n_occupied_cells+1, cs_lnum_t);
+
+          n_occupied_cells = 0;
+          for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+            if (cell_idx[c_id+1] > cell_idx[c_id]) {
+              occupied_cell_ids[n_occupied_cells] = c_id;
+              particle_list[n_occupied_cells] = cell_idx[c_id];
+              n_occupied_cells++;
+            }
+          }
+          particle_list[n_occupied_cells] = p_set->n_particles;
+
+        }
+        else {
 
-        BFT_MALLOC(occupied_cell_ids, n_occupied_cells, cs_lnum_t);
-        BFT_MALLOC(particle_list, n_occupied_cells+1, cs_lnum_t);
+          n_occupied_cells
+            = _get_n_occupied_cells(p_set, 0, p_set->n_particles);
 
-        _occupied_cells(p_set, 0, p_set->n_particles,
-                        n_occupied_cells,
-                        occupied_cell_ids,
-                        particle_list);
+          BFT_MALLOC(occupied_cell_ids, n_occupied_cells, cs_lnum_t);
+          BFT_MALLOC(particle_list, n_occupied_cells+1, cs_lnum_t);
+
+          _occupied_cells(p_set, 0, p_set->n_particles,
+                          n_occupied_cells,
+                          occupied_cell_ids,
+                          particle_list);
+
+        }
 
       }
 
@@ -2330,73 +2685,89 @@ cs_lagr_solve_time_step(const int         itypfb[],
 
         cs_lnum_t enter_parts = p_set->n_particles;
 
+        const size_t extents = p_set->p_am->extents;
+
+        /* Treat agglomeration (cells are handled in parallel, and
+           created parcels are buffered) */
+
+        cs_lnum_t *parcel_idx = NULL;
+        unsigned char *parcels = NULL;
+
+        if (cs_glob_lagr_model->agglomeration == 1) {
+
+          BFT_MALLOC(parcel_idx, n_occupied_cells+1, cs_lnum_t);
+
+          cs_lagr_agglomeration(dt[0],
+                                minimum_particle_diam,
+                                n_occupied_cells,
+                                occupied_cell_ids,
+                                particle_list,
+                                parcel_idx,
+                                &parcels);
+        }
+
+        /* Buffer used to move deleted particles at the end of each cell */
+
+        cs_lnum_t max_local_size = 0;
+        for (cs_lnum_t icell = 0; icell < n_occupied_cells; ++icell)
+          max_local_size = CS_MAX(max_local_size,
+                                  particle_list[icell+1] - particle_list[icell]);
+
+        unsigned char *swap_buffer;
+        BFT_MALLOC(swap_buffer, extents * max_local_size, unsigned char);
+
         /* Loop on all cells that contain at least one particle */
         for (cs_lnum_t icell = 0; icell < n_occupied_cells; ++icell) {
 
-          cs_lnum_t cell_id = occupied_cell_ids[icell];
-
           /* Particle indices: between start_part and end_part (list) */
           cs_lnum_t start_part = particle_list[icell];
           cs_lnum_t end_part = particle_list[icell+1];
 
-          cs_lnum_t init_particles = p_set->n_particles;
+          /* Add parcels created by agglomeration */
 
-          /* Treat agglomeration */
-          if (cs_glob_lagr_model->agglomeration == 1) {
+          cs_lnum_t inserted_parts_agglo = 0;
 
-            cs_lagr_agglomeration(cell_id,
-                                  dt[0],
-                                  minimum_particle_diam,
-                                  start_part,
-                                  end_part);
+          if (parcel_idx != NULL) {
+            inserted_parts_agglo = parcel_idx[icell+1] - parcel_idx[icell];
+            if (inserted_parts_agglo > 0) {
+              cs_lagr_particle_set_resize(  p_set->n_particles
+                                          + inserted_parts_agglo);
+              memcpy(p_set->p_buffer + extents * p_set->n_particles,
+                     parcels + extents * parcel_idx[icell],
+                     extents * inserted_parts_agglo);
+              p_set->n_particles += inserted_parts_agglo;
+            }
           }
 
-          /* Save number of created particles */
-
-          cs_lnum_t inserted_parts_agglo = p_set->n_particles - init_particles;
-
-          /* Create local buffer (deleted particles at the end) */
+          /* Move deleted particles at the end of the cell's range */
 
           cs_lnum_t local_size = end_part - start_part;
           cs_lnum_t deleted_parts = _get_n_deleted(p_set, start_part, end_part);
-          size_t swap_buffer_size =   p_set->p_am->extents
-                                    * (local_size - deleted_parts);
-          size_t swap_buffer_deleted = p_set->p_am->extents * deleted_parts;
-
-          /* Create buffers for deleted particles */
-          unsigned char * swap_buffer, *deleted_buffer;
-          BFT_MALLOC(swap_buffer, swap_buffer_size, unsigned char);
-          BFT_MALLOC(deleted_buffer, swap_buffer_deleted, unsigned char);
-
-          /* Update buffer for existing particles */
-          cs_lnum_t count_del = 0, count_swap = 0;
-          for (cs_lnum_t i = start_part; i < end_part; ++i) {
-            if (cs_lagr_particles_get_flag(p_set, i,
-                                           CS_LAGR_PART_TO_DELETE)) {
-              memcpy(deleted_buffer + p_set->p_am->extents * count_del,
-                     p_set->p_buffer + p_set->p_am->extents * i,
-                     p_set->p_am->extents);
-              count_del++;
-            }
-            else {
-              memcpy(swap_buffer + p_set->p_am->extents * count_swap,
-                     p_set->p_buffer + p_set->p_am->extents * i,
-                     p_set->p_am->extents);
-              count_swap++;
-            }
-          }
 
-          memcpy(p_set->p_buffer + p_set->p_am->extents * start_part,
-                 swap_buffer, swap_buffer_size);
-          memcpy(  p_set->p_buffer
-                 + p_set->p_am->extents * (local_size-deleted_parts+start_part),
-                 deleted_buffer, swap_buffer_deleted);
+          if (deleted_parts > 0) {
+            cs_lnum_t count_del = local_size - deleted_parts, count_swap = 0;
+            for (cs_lnum_t i = start_part; i < end_part; ++i) {
+              if (cs_lagr_particles_get_flag(p_set, i,
+                                             CS_LAGR_PART_TO_DELETE)) {
+                memcpy(swap_buffer + extents * count_del,
+                       p_set->p_buffer + extents * i,
+                       extents);
+                count_del++;
+              }
+              else {
+                memcpy(swap_buffer + extents * count_swap,
+                       p_set->p_buffer + extents * i,
+                       extents);
+                count_swap++;
+              }
+            }
 
-          BFT_FREE(deleted_buffer);
-          BFT_FREE(swap_buffer);
+            memcpy(p_set->p_buffer + extents * start_part,
+                   swap_buffer, extents * local_size);
+          }
 
           /* Treat fragmentation */
-          init_particles = p_set->n_particles;
+          cs_lnum_t init_particles = p_set->n_particles;
 
           if (cs_glob_lagr_model->fragmentation == 1) {
             cs_lagr_fragmentation(dt[0],
@@ -2412,6 +2783,10 @@ cs_lagr_solve_time_step(const int         itypfb[],
                                      + inserted_parts_agglo + inserted_parts_frag;
         }
 
+        BFT_FREE(swap_buffer);
+        BFT_FREE(parcels);
+        BFT_FREE(parcel_idx);
+
         p_set->n_particles = enter_parts;
 
         /* Introduce new particles (uniformly in the cell) */
@@ -2462,6 +2837,16 @@ cs_lagr_solve_time_step(const int         itypfb[],
         BFT_FREE(terbru);
 
       p_set->n_particles += nresnew;
+      if (nresnew > 0)
+        p_set->cell_sorted = false;
+
+      /* Sort particles by cell again after agglomeration or fragmentation
+         (existing particles may also move, so this is done only once arrays
+         indexed by particle id are freed) */
+
+      if (   cs_glob_lagr_model->agglomeration == 1
+          || cs_glob_lagr_model->fragmentation == 1)
+        cs_lagr_particle_set_sort_by_cell(p_set, cs_glob_mesh->n_cells);
 
       /* Location of particles - boundary conditions for particle positions
          ------------------------------------------------------------------ */
@@ -2646,6 +3031,10 @@ cs_lagr_solve_time_step(const int         itypfb[],
 
   cs_user_lagr_extra_operations(dt);
 
+  /* Streaming output of particle attributes */
+
+  cs_lagr_post_stream_write(ts);
+
   /* Update particle counter */
   /*-------------------------*/
 
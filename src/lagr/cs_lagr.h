@@ -135,6 +135,25 @@ enum {
   CS_LAGR_PHYS_COAL = 2
 };
 
+/*! Purposes of counter-based random number streams used by the
+    Lagrangian module (see \ref cs_random_stream_init); streams with
+    different purposes are independent */
+/*-----------------------------------------------------------------*/
+
+typedef enum {
+
+  CS_LAGR_RNG_AGGLOMERATION = 1,  /*!< agglomeration pairs */
+  CS_LAGR_RNG_INJ_RANKS,          /*!< injection: distribution
+                                       among ranks */
+  CS_LAGR_RNG_INJ_ELTS,           /*!< injection: distribution
+                                       among zone elements */
+  CS_LAGR_RNG_INJ_POSITION,       /*!< injection: position in element */
+  CS_LAGR_RNG_INJ_ATTRIBUTES,     /*!< injection: other attributes */
+  CS_LAGR_RNG_INJ_VEL_SEEN,       /*!< injection: velocity seen */
+  CS_LAGR_RNG_INJ_DEPOSITION      /*!< injection: deposition model */
+
+} cs_lagr_rng_purpose_t;
+
 /*! Fixed maximum sizes */
 /*----------------------*/
 
@@ -1348,6 +1367,21 @@ void
 cs_lagr_init_c_arrays(int          dim_cs_glob_lagr_source_terms[2],
                       cs_real_t  **p_cs_glob_lagr_source_terms);
 
+/*----------------------------------------------------------------------------
+ * Return pointers to already allocated lagrangian arrays
+ *
+ * This function is intended for use by Fortran wrappers, after a
+ * reallocation of these arrays.
+ *
+ * parameters:
+ *   dim_cs_glob_lagr_source_terms --> dimensions for source terms pointer
+ *   p_cs_glob_lagr_source_terms   --> source terms pointer
+ *----------------------------------------------------------------------------*/
+
+void
+cs_lagr_map_c_arrays(int          dim_cs_glob_lagr_source_terms[2],
+                     cs_real_t  **p_cs_glob_lagr_source_terms);
+
 /*----------------------------------------------------------------------------
  * Free lagrangian arrays
  *
@@ -1357,6 +1391,16 @@ cs_lagr_init_c_arrays(int          dim_cs_glob_lagr_source_terms[2],
 void
 cs_lagr_finalize(void);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Redistribute particles and Lagrangian arrays during a mesh
+ *        redistribution (see cs_load_balance.c).
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_redistribute(void);
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
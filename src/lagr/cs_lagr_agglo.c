@@ -57,8 +57,13 @@
 #include <math.h>
 #include <ctype.h>
 #include <float.h>
+#include <string.h>
 #include <assert.h>
 
+#if defined(HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 /*----------------------------------------------------------------------------
  *  Local headers
  *----------------------------------------------------------------------------*/
@@ -72,7 +77,10 @@
 #include "cs_field_pointer.h"
 
 #include "cs_math.h"
+#include "cs_mesh.h"
+#include "cs_mesh_quantities.h"
 #include "cs_prototypes.h"
+#include "cs_scratch.h"
 
 #include "cs_parameters.h"
 #include "cs_time_step.h"
@@ -97,6 +105,60 @@ BEGIN_C_DECLS
 
 /*! \cond DOXYGEN_SHOULD_SKIP_THIS */
 
+/*=============================================================================
+ * Local Macro definitions
+ *============================================================================*/
+
+/* Maximum number of buffered random values */
+
+#define _AGGLO_RANDOM_BUFFER_SIZE  64
+
+/*============================================================================
+ * Local Type definitions
+ *============================================================================*/
+
+/* Buffer for parcels created by agglomeration (one per thread) */
+
+typedef struct {
+
+  size_t          extents;     /* particle data extents */
+  cs_lnum_t       n_parcels;   /* number of parcels in buffer */
+  cs_lnum_t       n_max;       /* allocated number of parcels */
+  unsigned char  *p_buffer;    /* parcels data */
+
+} _parcel_buffer_t;
+
+/* Particles of a given cell, with associated created parcels */
+
+typedef struct {
+
+  const cs_lagr_attribute_map_t  *p_am;      /* particle attributes map */
+
+  unsigned char                  *p_buffer;  /* data of first particle
+                                                in cell */
+  cs_lnum_t                       n_p;       /* number of particles
+                                                in cell */
+
+  _parcel_buffer_t               *pb;        /* created parcels buffer */
+  cs_lnum_t                       pb_start;  /* id of first parcel of
+                                                cell in buffer */
+
+} _agglo_cell_t;
+
+/* Random number stream, with buffered values (values are generated by
+   blocks, whose size increases up to _AGGLO_RANDOM_BUFFER_SIZE, so that
+   few values are wasted in cells with few particles) */
+
+typedef struct {
+
+  cs_random_stream_t  rs;         /* random number stream */
+  int                 n_values;   /* number of values in buffer */
+  int                 n_used;     /* number of values used in buffer */
+
+  cs_real_t           u[_AGGLO_RANDOM_BUFFER_SIZE];  /* buffered values */
+
+} _agglo_random_t;
+
 /*=============================================================================
  * Private function definitions
  *============================================================================*/
@@ -147,7 +209,7 @@ _get_row_col(cs_lnum_t  res[2],
 
 /*----------------------------------------------------------------------------*/
 /*!
- * \brief Compare the first elements of a cs_lnum_2_t. Used in sorting
+ * \brief Compare (class, particle id) couples. Used in sorting
  */
 /*----------------------------------------------------------------------------*/
 
@@ -155,10 +217,13 @@ static int
 _compare_interface(const void  *a,
                    const void  *b)
 {
-  /* Map as 1-d array for simplification and to avoid const warnings
-     ((* (const cs_lnum_2_t *)a)[0] - (* (const cs_lnum_2_t *) b)[0]) */
+  const cs_lnum_t *_a = (const cs_lnum_t *)a;
+  const cs_lnum_t *_b = (const cs_lnum_t *)b;
+
+  if (_a[0] != _b[0])
+    return (_a[0] < _b[0]) ? -1 : 1;
 
-  return ((*(const cs_lnum_t *)a) - (*(const cs_lnum_t *)b));
+  return (_a[1] < _b[1]) ? -1 : (_a[1] > _b[1]);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -286,148 +351,345 @@ _gaps_classes(cs_lnum_2_t  *array,
   return 0;
 }
 
-/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Compute the range of handled cells associated with the current
+ *        thread, balancing the number of particles.
+ *
+ * Ranges are contiguous and ordered by thread id.
+ *
+ * \param[in]   n_cells       number of handled cells
+ * \param[in]   particle_idx  index of particles in each handled cell
+ * \param[out]  s_id          id of first cell for the current thread
+ * \param[out]  e_id          id past the last cell for the current thread
+ */
+/*----------------------------------------------------------------------------*/
 
-/*============================================================================
- * Public function definitions
- *============================================================================*/
+static void
+_thread_cell_range(cs_lnum_t         n_cells,
+                   const cs_lnum_t   particle_idx[],
+                   cs_lnum_t        *s_id,
+                   cs_lnum_t        *e_id)
+{
+#if defined(HAVE_OPENMP)
+  int t_id = omp_get_thread_num();
+  int n_t = omp_get_num_threads();
+  cs_lnum_t n = particle_idx[n_cells] - particle_idx[0];
+  cs_lnum_t t_n = (n + n_t - 1) / n_t;
+  cs_lnum_t b_id[2] = {t_id*t_n, (t_id+1)*t_n};
+
+  /* Bounds are moved to the first cell starting at or after the matching
+     particle, so that adjacent threads share the same bounds */
+
+  for (int i = 0; i < 2; i++) {
+    if (b_id[i] >= n)
+      b_id[i] = n_cells;
+    else {
+      cs_lnum_t start = 0, end = n_cells;
+      while (start < end) {
+        cs_lnum_t mid = start + (end - start)/2;
+        if (particle_idx[mid] - particle_idx[0] < b_id[i])
+          start = mid + 1;
+        else
+          end = mid;
+      }
+      b_id[i] = start;
+    }
+  }
+
+  *s_id = b_id[0];
+  *e_id = b_id[1];
+#else
+  CS_UNUSED(particle_idx);
+  *s_id = 0;
+  *e_id = n_cells;
+#endif
+}
 
 /*----------------------------------------------------------------------------*/
 /*!
- * \brief Merge two sorted arrays in a third sorted array
+ * \brief Add a parcel to a parcels buffer.
  *
- * \param[in]       arr1   first sorted array
- * \param[in]       arr2   second sorted array
- * \param[in]       n1     size of first sorted array
- * \param[in]       n2     size of second sorted array
- * \param[in, out]  arr3   preallocated array that will contain the sorted
- *                         merge of the two previous arrays
+ * \param[in, out]  pb  parcels buffer
+ *
+ * \return  pointer to added (uninitialized) parcel data
  */
 /*----------------------------------------------------------------------------*/
 
-void
-cs_lagr_agglo_merge_arrays(cs_lnum_2_t  arr1[],
-                           cs_lnum_2_t  arr2[],
-                           cs_lnum_t    n1,
-                           cs_lnum_t    n2,
-                           cs_lnum_2_t  arr3[])
+static unsigned char *
+_parcel_buffer_add(_parcel_buffer_t  *pb)
 {
-  cs_lnum_t i = 0, j = 0, k = 0;
-  /* Browse both arrays  */
-  while (i<n1 && j <n2) {
-    if (arr1[i][0] < arr2[j][0]) {
-      arr3[k][0] = arr1[i][0];
-      arr3[k][1] = arr1[i][1];
-      k++;
-      i++;
-    }
-    else {
-      arr3[k][0] = arr2[j][0];
-      arr3[k][1] = arr2[j][1];
-      k++;
-      j++;
+  if (pb->n_parcels >= pb->n_max) {
+    pb->n_max = CS_MAX(16, pb->n_max*2);
+    BFT_REALLOC(pb->p_buffer, pb->n_max*pb->extents, unsigned char);
+  }
+
+  unsigned char *p = pb->p_buffer + pb->extents*pb->n_parcels;
+  pb->n_parcels += 1;
+
+  return p;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return a pointer to particle data in a cell.
+ *
+ * Ids beyond the number of particles in the cell refer to parcels
+ * created in that cell.
+ *
+ * \param[in]  c   cell particles
+ * \param[in]  id  particle id in cell
+ *
+ * \return  pointer to particle data
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline unsigned char *
+_cell_particle(const _agglo_cell_t  *c,
+               cs_lnum_t             id)
+{
+  if (id < c->n_p)
+    return c->p_buffer + c->p_am->extents*id;
+  else
+    return c->pb->p_buffer + c->p_am->extents*(c->pb_start + id - c->n_p);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Build (class, particle id) couples for a range of particles of
+ *        a cell, sorted by class, then by particle id.
+ *
+ * A counting sort is used when class ids span a range which is small
+ * relative to the number of particles, which is the usual case.
+ *
+ * \param[in]   n         number of particles in range
+ * \param[in]   cls       class id of each particle in range
+ * \param[in]   id_shift  id (in cell) of first particle in range
+ * \param[out]  interf    sorted couples (size: n)
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_sort_by_class(cs_lnum_t        n,
+               const cs_lnum_t  cls[],
+               cs_lnum_t        id_shift,
+               cs_lnum_2_t      interf[])
+{
+  if (n < 1)
+    return;
+
+  cs_lnum_t c_min = cls[0], c_max = cls[0];
+
+  for (cs_lnum_t i = 1; i < n; i++) {
+    c_min = CS_MIN(c_min, cls[i]);
+    c_max = CS_MAX(c_max, cls[i]);
+  }
+
+  const cs_lnum_t n_cls = c_max - c_min + 1;
+
+  if (n_cls > 2*n + 64) {
+    for (cs_lnum_t i = 0; i < n; i++) {
+      interf[i][0] = cls[i];
+      interf[i][1] = id_shift + i;
     }
+    qsort(interf, n, sizeof(cs_lnum_2_t), _compare_interface);
+    return;
   }
 
-  /* Store remaining elements of first array  */
-  while (i < n1) {
-    arr3[k][0] = arr1[i][0];
-    arr3[k][1] = arr1[i][1];
-    k++;
-    i++;
+  cs_scratch_mark_t mark = cs_scratch_mark();
+
+  cs_lnum_t *cls_idx;
+  CS_SCRATCH_ALLOC(cls_idx, n_cls + 1, cs_lnum_t);
+
+  for (cs_lnum_t i = 0; i < n_cls + 1; i++)
+    cls_idx[i] = 0;
+  for (cs_lnum_t i = 0; i < n; i++)
+    cls_idx[cls[i] - c_min + 1] += 1;
+  for (cs_lnum_t i = 0; i < n_cls; i++)
+    cls_idx[i+1] += cls_idx[i];
+
+  /* Particles are visited by increasing id, so the sort is stable */
+
+  for (cs_lnum_t i = 0; i < n; i++) {
+    cs_lnum_t j = cls_idx[cls[i] - c_min]++;
+    interf[j][0] = cls[i];
+    interf[j][1] = id_shift + i;
   }
 
-  /* Store remaining elements of second array */
-  while (j < n2) {
-    arr3[k][0] = arr2[j][0];
-    arr3[k][1] = arr2[j][1];
-    k++;
-    j++;
+  cs_scratch_release(mark);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Draw a value following a uniform distribution.
+ *
+ * \param[in, out]  r  buffered random number stream
+ *
+ * \return  drawn value, in the open interval (0, 1)
+ */
+/*----------------------------------------------------------------------------*/
+
+static inline cs_real_t
+_uniform(_agglo_random_t  *r)
+{
+  if (r->n_used >= r->n_values) {
+    r->n_values = CS_MIN(2*r->n_values, _AGGLO_RANDOM_BUFFER_SIZE);
+    cs_random_stream_uniform(&(r->rs), r->n_values, r->u);
+    r->n_used = 0;
   }
+
+  return r->u[r->n_used++];
 }
 
 /*----------------------------------------------------------------------------*/
 /*!
- * \brief Agglomeration algorithm based on algorithms used in
- *        rare gas modelling.
+ * \brief Draw a value following a normal distribution (Box-Muller method).
  *
- * Parcels represent physical particles with similar properties (size).
- * The number of physical particles in a parcel is represented by
- * the statistical weight.
+ * \param[in, out]  r  buffered random number stream
  *
- * - We select randomly a number of parcels within which agglomeration
- *   is treated.
- * - We selected randomly pairs of particles and, for each pair,
- *   the number of agglomeration events is generated with
- *   a Poisson distribution that depends on the agglomeration kernel and
- *   number of each particle (i.e. statistical weight).
+ * \return  drawn value
+ */
+/*----------------------------------------------------------------------------*/
+
+static cs_real_t
+_normal(_agglo_random_t  *r)
+{
+  cs_real_t u1 = _uniform(r);
+  cs_real_t u2 = _uniform(r);
+
+  return sqrt(-2.*log(u1)) * cos(2.*cs_math_pi*u2);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Draw a value following a Poisson distribution, truncated
+ *        to a given maximum value.
  *
- * Working hypotheses:
+ * The same multiplicative method as in \ref cs_random_poisson is used,
+ * but stopped when the maximum value is reached, so the cost is bounded
+ * by that value rather than by the mean.
  *
- * 1) Discrete diameters
- *    - Minimal particle size , called a monomere (unbreakable particle)
- *    - Aggregates correponds to group of monomeres sticking together.
- *    - Each class of the parcel represent one size (stored in CS_LAGR_AGGREGATE)
- * 2) Agglomeration happens between two parcels
- * 3) Particles in the same cell are contiguous in the particle list
+ * \param[in, out]  r      buffered random number stream
+ * \param[in]       mu     mean value
+ * \param[in]       p_max  maximum value
  *
- * \param[in]  cell_id                current cell id
- * \param[in]  dt                     time step
- * \param[in]  minimum_particle_diam  minumum diameter (monomere diameter)
- * \param[in]  start_particle         index of the first particle
- * \param[in]  end_particle           index after the last particle
+ * \return  drawn value
+ */
+/*----------------------------------------------------------------------------*/
+
+static cs_lnum_t
+_poisson(_agglo_random_t  *r,
+         cs_real_t         mu,
+         cs_lnum_t         p_max)
+{
+  cs_lnum_t p = 0;
+  double q = _uniform(r);
+
+  /* Since exp(-mu) >= 1 - mu, avoid computing exp(-mu) for the most
+     frequent case where no event occurs */
+
+  if (q <= 1. - mu)
+    return 0;
+
+  const double pmu = exp(-mu);
+
+  while (q > pmu && p < p_max) {
+    p++;
+    q *= _uniform(r);
+  }
+
+  return p;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Flag a particle for deletion.
  *
- * \returns a modified list of particles, containing newly
- *          created parcels at the end
+ * \param[in, out]  particle  pointer to particle data
+ * \param[in]       p_am      particle attributes map
  */
 /*----------------------------------------------------------------------------*/
 
-cs_lnum_t
-cs_lagr_agglomeration(cs_lnum_t  cell_id,
-                      cs_real_t  dt,
-                      cs_real_t  minimum_particle_diam,
-                      cs_lnum_t  start_particle,
-                      cs_lnum_t  end_particle)
+static inline void
+_delete_particle(unsigned char                  *particle,
+                 const cs_lagr_attribute_map_t  *p_am)
 {
-  /* Initialisation */
-  cs_lnum_t ret_val = 0;
+  cs_lagr_particle_set_lnum(particle, p_am, CS_LAGR_AGGLO_CLASS_ID, 0);
+  cs_lagr_particle_set_real(particle, p_am, CS_LAGR_STAT_WEIGHT, 0);
+  cs_lagr_particle_set_lnum(particle, p_am,
+                            CS_LAGR_P_FLAG, CS_LAGR_PART_TO_DELETE);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Agglomeration in a given cell.
+ *
+ * Created parcels are appended to the cell's parcels buffer.
+ *
+ * Statistical weights and classes of the cell's particles are gathered
+ * in contiguous arrays, so that randomly selected pairs do not require
+ * accessing scattered particle data.
+ *
+ * The (class, particle id) index is only built when an agglomeration
+ * event requires looking up a parcel of a given class, or when small
+ * parcels need to be merged, so cells in which no event occurs are
+ * handled in linear time.
+ *
+ * \param[in, out]  c                      cell particles
+ * \param[in]       cell_id                cell id
+ * \param[in]       vol_cell               cell volume
+ * \param[in]       dt                     time step
+ * \param[in]       minimum_particle_diam  minumum diameter (monomere diameter)
+ * \param[in, out]  r                      buffered random number stream
+ */
+/*----------------------------------------------------------------------------*/
 
+static void
+_agglomerate_cell(_agglo_cell_t       *c,
+                  cs_lnum_t            cell_id,
+                  cs_real_t            vol_cell,
+                  cs_real_t            dt,
+                  cs_real_t            minimum_particle_diam,
+                  _agglo_random_t     *r)
+{
   // FIXME: call DLVO routine
   cs_real_t alp = 1.;                    /* Efficiency of agglomeration */
 
-  cs_real_t agglo_min_weight
-    = cs_glob_lagr_agglomeration_model->min_stat_weight; // Minimum parcel size
-  cs_real_t agglo_max_weight
-    = cs_glob_lagr_agglomeration_model->max_stat_weight; // Maximum parcel size
-  cs_lnum_t newpart = 0;
+  const cs_lagr_agglomeration_model_t *agglo_model
+    = cs_glob_lagr_agglomeration_model;
 
-  /* Get fluid and particle properties */
-  cs_lagr_particle_set_t *p_set = cs_glob_lagr_particle_set;
-  cs_mesh_quantities_t  *fvq = cs_glob_mesh_quantities;
+  cs_real_t agglo_min_weight = agglo_model->min_stat_weight; // Minimum parcel size
+  cs_real_t agglo_max_weight = agglo_model->max_stat_weight; // Maximum parcel size
+
+  const cs_lagr_attribute_map_t *p_am = c->p_am;
+  _parcel_buffer_t *pb = c->pb;
 
-  /* Get cell information */
-  cs_real_t vol_cell = fvq->cell_vol[cell_id];
   /* local number of particles  */
-  cs_lnum_t lnum_particles = end_particle - start_particle;
+  cs_lnum_t lnum_particles = c->n_p;
 
   /* Exit routine if no particles are in the cell */
   if (lnum_particles <=0) {
-    return 0;
+    return;
   }
 
-  /* Create local array (containing the class and particle index) */
-  cs_lnum_2_t *interf;
+  cs_scratch_mark_t mark = cs_scratch_mark();
+
+  /* Gather weights and classes of particles */
 
-  BFT_MALLOC(interf, lnum_particles, cs_lnum_2_t);
+  cs_real_t *p_weight;
+  cs_lnum_t *p_cls;
+  CS_SCRATCH_ALLOC(p_weight, lnum_particles, cs_real_t);
+  CS_SCRATCH_ALLOC(p_cls, lnum_particles, cs_lnum_t);
 
-  for (cs_lnum_t i = start_particle; i < end_particle; ++i) {
-    interf[i-start_particle][0]
-      = cs_lagr_particles_get_lnum(p_set, i, CS_LAGR_AGGLO_CLASS_ID);
-    interf[i-start_particle][1] = i;
+  for (cs_lnum_t i = 0; i < lnum_particles; i++) {
+    const unsigned char *part = c->p_buffer + p_am->extents*i;
+    p_weight[i] = cs_lagr_particle_get_real(part, p_am, CS_LAGR_STAT_WEIGHT);
+    p_cls[i] = cs_lagr_particle_get_lnum(part, p_am, CS_LAGR_AGGLO_CLASS_ID);
   }
 
-  /* Sort by class */
-  qsort(interf, lnum_particles, sizeof(cs_lnum_2_t), _compare_interface);
+  /* Local array (containing the class and particle index),
+     built only when needed */
+  cs_lnum_2_t *interf = NULL;
 
   /* Select pairs of particles (for agglomeration) */
   cs_gnum_t _gn_particles = lnum_particles;
@@ -456,10 +718,9 @@ cs_lagr_agglomeration(cs_lnum_t  cell_id,
     /* Evaluate number of agglomeration events */
     vp = 0;
 
-    cs_random_uniform (1, &rand);
+    rand = _uniform(r);
     cs_gnum_t pp = floor(lnum_maxpairs * rand);
 
-    // TODO check if cs_random_uniform < 1 and not <= 1
     if (pp == lnum_maxpairs) {
       pp=0;
     }
@@ -475,12 +736,10 @@ cs_lagr_agglomeration(cs_lnum_t  cell_id,
     cs_real_t cker = 0, lambda = 0;
     cs_real_2_t stat_weights;  /* Weights of the two particles */
 
-    stat_weights[0] = cs_lagr_particles_get_real
-                        (p_set, p1+start_particle, CS_LAGR_STAT_WEIGHT);
-    stat_weights[1] = cs_lagr_particles_get_real
-                        (p_set, p2+start_particle, CS_LAGR_STAT_WEIGHT);
+    stat_weights[0] = p_weight[p1];
+    stat_weights[1] = p_weight[p2];
 
-    cker = cs_glob_lagr_agglomeration_model->scalar_kernel;
+    cker = agglo_model->scalar_kernel;
 
     lambda = cker * (lnum_maxpairs / selected_val)
                   * stat_weights[0] * stat_weights[1] * dt / vol_cell;
@@ -491,69 +750,63 @@ cs_lagr_agglomeration(cs_lnum_t  cell_id,
     /* Efficiency of agglomeration */
     lambda *= alp;
 
-    // FIXME: change Poisson random generator
-    if (lambda > 700.) {
-      cs_random_normal(1, &rand);
-      vp = floor(lambda + sqrt(lambda) * rand);
-    }
-    else {
-      int _vp;
-      cs_random_poisson(1, lambda, &_vp);
-      vp = _vp;
-    }
-
-    /* Clip if vp > stat_weight */
-    if ( vp > 0 ) {
-      cs_lnum_t max_vp = round( cs_math_fmin(stat_weights[0], stat_weights[1]) );
-      /* Auto-agglomeration */
-      if (p1 == p2 && 2*vp > max_vp )
-        vp = floor( 0.5*max_vp );
-      /* Agglomeration between different clusters */
-      if ( p1 != p2 && vp > max_vp )
-        vp = max_vp ;
+    /* Number of events is clipped to the stat_weight
+       (half of it for auto-agglomeration) */
+    cs_lnum_t max_vp = round( cs_math_fmin(stat_weights[0], stat_weights[1]) );
+    if (p1 == p2)
+      max_vp = floor( 0.5*max_vp );
+
+    if (max_vp > 0) {
+      // FIXME: change Poisson random generator
+      if (lambda > 700.) {
+        rand = _normal(r);
+        vp = floor(lambda + sqrt(lambda) * rand);
+        if (vp > max_vp)
+          vp = max_vp;
+      }
+      else
+        vp = _poisson(r, lambda, max_vp);
     }
-    ret_val = 1;
 
     /* Treat agglomeration events */
     if (vp > 0) {
 
       /* Remove elements from parcels p1 and p2 */
-      cs_lagr_particles_set_real(p_set, p1+start_particle,
-                                 CS_LAGR_STAT_WEIGHT, round(stat_weights[0])- vp );
-      stat_weights[1] = cs_lagr_particles_get_real(p_set, p2+start_particle,
-                                                   CS_LAGR_STAT_WEIGHT);
-      cs_lagr_particles_set_real(p_set, p2+start_particle,
-                                 CS_LAGR_STAT_WEIGHT, round(stat_weights[1]) - vp);
+      p_weight[p1] = round(stat_weights[0]) - vp;
+      p_weight[p2] = round(p_weight[p2]) - vp;
 
       /* Add elements for parcel (p1+p2)
        * --> either add to an existing parcel (if it exists and is not too big)
        * --> or create a new parcel (otherwise) */
-      n_classes_new =   cs_lagr_particles_get_lnum
-                          (p_set, p1+start_particle, CS_LAGR_AGGLO_CLASS_ID)
-                     + cs_lagr_particles_get_lnum(p_set, p2+start_particle,
-                                                  CS_LAGR_AGGLO_CLASS_ID);
+      n_classes_new = p_cls[p1] + p_cls[p2];
 
-      if (n_classes_new > cs_glob_lagr_agglomeration_model->n_max_classes) {
+      if (n_classes_new > agglo_model->n_max_classes) {
         bft_error(__FILE__, __LINE__, 0,
                   _(" ** Lagrangian module:\n"
                     "    number of classes > n_max_classes (%d)\n"
                     "    --------------------------------\n\n"
                     " To fix this, increase "
                     " cs_glob_lagr_agglomeration_model->n_max_classes"),
-                  cs_glob_lagr_agglomeration_model->n_max_classes);
+                  agglo_model->n_max_classes);
+      }
+
+      /* Find one existing parcel with the same class (to merge with it);
+         classes of existing particles do not change here, so the
+         index is built once */
+
+      if (interf == NULL) {
+        CS_SCRATCH_ALLOC(interf, lnum_particles, cs_lnum_2_t);
+        _sort_by_class(lnum_particles, p_cls, 0, interf);
       }
 
-      /* Find one existing parcel with the same class (to merge with it) */
       cs_lnum_t position = _find_class(interf, lnum_particles, n_classes_new);
 
       if (position >= 0) {
         cs_lnum_t found_idx = interf[position][1];
-        cs_real_t stat_weight
-          = cs_lagr_particles_get_real(p_set, found_idx, CS_LAGR_STAT_WEIGHT);
+        cs_real_t stat_weight = p_weight[found_idx];
 
         if (stat_weight + vp <= agglo_max_weight) {
-          cs_lagr_particles_set_real(p_set, found_idx,
-                                     CS_LAGR_STAT_WEIGHT, round(stat_weight)+vp);
+          p_weight[found_idx] = round(stat_weight)+vp;
 
           kk--;
           continue;
@@ -565,126 +818,124 @@ cs_lagr_agglomeration(cs_lnum_t  cell_id,
 
       cs_lnum_t add_to_end = 1;
 
-      for (cs_lnum_t indx = p_set->n_particles;
-          indx < p_set->n_particles + newpart;
-          indx++) {
+      for (cs_lnum_t indx = c->n_p;
+           indx < c->n_p + pb->n_parcels - c->pb_start;
+           indx++) {
+        unsigned char *parcel = _cell_particle(c, indx);
         cs_lnum_t stat_class
-          = cs_lagr_particles_get_lnum(p_set, indx, CS_LAGR_AGGLO_CLASS_ID);
+          = cs_lagr_particle_get_lnum(parcel, p_am, CS_LAGR_AGGLO_CLASS_ID);
         cs_real_t stat_weight
-          = cs_lagr_particles_get_real(p_set, indx, CS_LAGR_STAT_WEIGHT);
+          = cs_lagr_particle_get_real(parcel, p_am, CS_LAGR_STAT_WEIGHT);
         if (   (stat_class == n_classes_new)
             && (stat_weight + vp <= agglo_max_weight)) {
-          cs_lagr_particles_set_real(p_set, indx, CS_LAGR_STAT_WEIGHT,
-                                     round(stat_weight)+vp);
+          cs_lagr_particle_set_real(parcel, p_am, CS_LAGR_STAT_WEIGHT,
+                                    round(stat_weight)+vp);
 
           add_to_end = 0;
           break;
         }
       }
 
-      /* Else, create a new parcel at the end
-         Principle: copy parcel p1 and modify its properties */
+      /* Else, create a new parcel
+         Principle: copy parcel p1 and modify its properties
+         (position, velocity, velocity seen and cell id are those of p1) */
       if ( add_to_end == 1 ) {
-        newpart++;
 
-        /* Copy parcel p1 into a new parcel */
-        cs_lnum_t inserted_parts = p_set->n_particles + newpart;
+        unsigned char *inserted = _parcel_buffer_add(pb);
+        const unsigned char *part1 = _cell_particle(c, p1);
+        const unsigned char *part2 = _cell_particle(c, p2);
 
-        cs_lagr_particle_set_resize(inserted_parts);
+        memcpy(inserted, part1, p_am->extents);
 
-        cs_lagr_part_copy(inserted_parts-1, p1+start_particle);
+        cs_lagr_particle_set_real(inserted, p_am, CS_LAGR_RANDOM_VALUE,
+                                  _uniform(r));
 
         /* Set statistical weight*/
-        cs_lagr_particles_set_real(p_set, inserted_parts-1,
-                                   CS_LAGR_STAT_WEIGHT, vp);
+        cs_lagr_particle_set_real(inserted, p_am, CS_LAGR_STAT_WEIGHT, vp);
 
         /* Set diameter (using a law based on fractal dimension of aggregates) */
         cs_real_t fractal_dim
-          = cs_lagr_particles_get_real(p_set, inserted_parts-1,
-                                       CS_LAGR_AGGLO_FRACTAL_DIM);
+          = cs_lagr_particle_get_real(inserted, p_am,
+                                      CS_LAGR_AGGLO_FRACTAL_DIM);
         cs_real_t diam = minimum_particle_diam * pow((cs_real_t)n_classes_new,
                                                      1./fractal_dim);
-        cs_lagr_particles_set_real(p_set, inserted_parts-1,
-                                   CS_LAGR_DIAMETER, diam);
+        cs_lagr_particle_set_real(inserted, p_am, CS_LAGR_DIAMETER, diam);
 
         /* Set mass (equal to the sum of the two mass) */
-        cs_real_t mass1
-          = cs_lagr_particles_get_real(p_set, p1+start_particle, CS_LAGR_MASS);
-        cs_real_t mass2
-          = cs_lagr_particles_get_real(p_set, p2+start_particle, CS_LAGR_MASS);
+        cs_real_t mass1 = cs_lagr_particle_get_real(part1, p_am, CS_LAGR_MASS);
+        cs_real_t mass2 = cs_lagr_particle_get_real(part2, p_am, CS_LAGR_MASS);
 
-        cs_lagr_particles_set_real(p_set, inserted_parts-1, CS_LAGR_MASS,
-                                   mass1 +mass2);
+        cs_lagr_particle_set_real(inserted, p_am, CS_LAGR_MASS, mass1 + mass2);
 
         /* Set cell_id and Class_id */
-        cs_lagr_particles_set_lnum(p_set, inserted_parts-1,
-                                   CS_LAGR_CELL_ID, cell_id);
-
-        cs_lagr_particles_set_lnum(p_set, inserted_parts-1,
-                                   CS_LAGR_AGGLO_CLASS_ID, n_classes_new);
-
-        /* Set particle velocity */
-
-        cs_real_t * inserted_vel
-          = cs_lagr_particles_attr(p_set, inserted_parts-1,
-                                   CS_LAGR_VELOCITY);
-        cs_real_t * p1_vel = cs_lagr_particles_attr(p_set, p1+start_particle,
-                                                    CS_LAGR_VELOCITY);
-        inserted_vel[0] = p1_vel[0];
-        inserted_vel[1] = p1_vel[1];
-        inserted_vel[2] = p1_vel[2];
-
-        /* Set particle velocity seen*/
-        cs_real_t * inserted_vel_seen
-          = cs_lagr_particles_attr(p_set, inserted_parts-1,
-                                   CS_LAGR_VELOCITY_SEEN);
-        cs_real_t * p1_vel_seen
-          = cs_lagr_particles_attr(p_set, p1+start_particle,
-                                   CS_LAGR_VELOCITY_SEEN);
-        inserted_vel_seen[0] = p1_vel_seen[0];
-        inserted_vel_seen[1] = p1_vel_seen[1];
-        inserted_vel_seen[2] = p1_vel_seen[2];
+        cs_lagr_particle_set_lnum(inserted, p_am, CS_LAGR_CELL_ID, cell_id);
+        cs_lagr_particle_set_lnum(inserted, p_am,
+                                  CS_LAGR_AGGLO_CLASS_ID, n_classes_new);
 
       }
     }
     kk--;
   }
 
-  /* Store class and index of newly created particles */
-  cs_lnum_2_t *interf_agglo;
-  BFT_MALLOC(interf_agglo, newpart, cs_lnum_2_t);
+  cs_lnum_t newpart = pb->n_parcels - c->pb_start;
+  cs_lnum_t tot_size = lnum_particles+newpart;
+
+  /* Scatter weights, and check if some parcels are small or empty */
+
+  bool has_small = false;
+
+  for (cs_lnum_t i = 0; i < lnum_particles; i++) {
+    cs_lagr_particle_set_real(c->p_buffer + p_am->extents*i, p_am,
+                              CS_LAGR_STAT_WEIGHT, p_weight[i]);
+    if (p_weight[i] <= 0. || p_weight[i] < agglo_min_weight)
+      has_small = true;
+  }
+
+  cs_lnum_t *cls_agglo;
+  CS_SCRATCH_ALLOC(cls_agglo, newpart, cs_lnum_t);
 
   for (cs_lnum_t i = 0; i < newpart; i++) {
-    cs_lnum_t curr_class = cs_lagr_particles_get_lnum
-                             (p_set, p_set->n_particles+i,
-                              CS_LAGR_AGGLO_CLASS_ID);
-    interf_agglo[i][0] = curr_class;
-    interf_agglo[i][1] = p_set->n_particles+i;
+    const unsigned char *part = _cell_particle(c, lnum_particles + i);
+    cs_real_t w = cs_lagr_particle_get_real(part, p_am, CS_LAGR_STAT_WEIGHT);
+    if (w <= 0. || w < agglo_min_weight)
+      has_small = true;
+    cls_agglo[i] = cs_lagr_particle_get_lnum(part, p_am,
+                                             CS_LAGR_AGGLO_CLASS_ID);
+  }
+
+  /* Merging or deleting parcels is needed only if some are small or empty */
+
+  if (has_small == false) {
+    cs_scratch_release(mark);
+    return;
+  }
+
+  if (interf == NULL) {
+    CS_SCRATCH_ALLOC(interf, lnum_particles, cs_lnum_2_t);
+    _sort_by_class(lnum_particles, p_cls, 0, interf);
   }
 
-  /* Sort by the class */
-  qsort(interf_agglo, newpart, sizeof(cs_lnum_2_t), _compare_interface);
+  /* Store class and index of newly created particles, sorted by class */
+  cs_lnum_2_t *interf_agglo;
+  CS_SCRATCH_ALLOC(interf_agglo, newpart, cs_lnum_2_t);
+
+  _sort_by_class(newpart, cls_agglo, lnum_particles, interf_agglo);
 
   /* Local array, containing all particles in the current cell,
      sorted by their class */
   cs_lnum_2_t  *interf_tot;
-  cs_lnum_t tot_size = lnum_particles+newpart;
-
-  BFT_MALLOC(interf_tot, tot_size, cs_lnum_2_t);
+  CS_SCRATCH_ALLOC(interf_tot, tot_size, cs_lnum_2_t);
 
   /* Merge arrays of existing particles and particles
      created by agglomeration */
   cs_lagr_agglo_merge_arrays(interf, interf_agglo,
                              lnum_particles, newpart,
                              interf_tot);
-  BFT_FREE(interf_agglo);
-  BFT_FREE(interf);
 
   cs_lnum_t nb_cls = _get_nb_classes(interf_tot, tot_size);
 
   cs_lnum_t* cls_gaps;
-
-  BFT_MALLOC(cls_gaps, tot_size+1, cs_lnum_t);
+  CS_SCRATCH_ALLOC(cls_gaps, nb_cls+1, cs_lnum_t);
 
   _gaps_classes(interf_tot, tot_size,
                 nb_cls, cls_gaps);
@@ -697,19 +948,12 @@ cs_lagr_agglomeration(cs_lnum_t  cell_id,
 
     /* Only one particle of current class */
     if (end_gap - start_gap == 1) {
-      cs_lnum_t part_idx = interf_tot[start_gap][1];
-      cs_real_t weight = cs_lagr_particles_get_real
-                          (p_set, part_idx, CS_LAGR_STAT_WEIGHT);
+      unsigned char *part = _cell_particle(c, interf_tot[start_gap][1]);
+      cs_real_t weight = cs_lagr_particle_get_real(part, p_am,
+                                                   CS_LAGR_STAT_WEIGHT);
       /* Delete particle (if weight < 0) */
-      if (weight <= 0.) {
-        cs_lagr_particles_set_lnum(p_set, part_idx,
-                                   CS_LAGR_AGGLO_CLASS_ID, 0);
-        cs_lagr_particles_set_real(p_set, part_idx, CS_LAGR_STAT_WEIGHT, 0);
-        cs_lagr_particles_set_lnum(p_set, part_idx,
-                                   CS_LAGR_P_FLAG, CS_LAGR_PART_TO_DELETE);
-
-
-      }
+      if (weight <= 0.)
+        _delete_particle(part, p_am);
 
       continue;
     }
@@ -720,9 +964,9 @@ cs_lagr_agglomeration(cs_lnum_t  cell_id,
     cs_lnum_t found_small = 0;
 
     for (cs_lnum_t idx = start_gap; idx < end_gap; ++idx) {
-      cs_lnum_t part_idx = interf_tot[idx][1];
-      cs_real_t weight = cs_lagr_particles_get_real(p_set, part_idx,
-                                                    CS_LAGR_STAT_WEIGHT);
+      unsigned char *part = _cell_particle(c, interf_tot[idx][1]);
+      cs_real_t weight = cs_lagr_particle_get_real(part, p_am,
+                                                   CS_LAGR_STAT_WEIGHT);
 
       if (weight > 0. && weight < agglo_min_weight) {
         last_small = idx;
@@ -735,14 +979,14 @@ cs_lagr_agglomeration(cs_lnum_t  cell_id,
       /* Put the small particles in a large one (if possible) */
       cs_lnum_t put_in_large = 0;
       for (cs_lnum_t idx = start_gap; idx < end_gap; ++idx) {
-        cs_lnum_t part_idx = interf_tot[idx][1];
-        cs_real_t weight = cs_lagr_particles_get_real
-                             (p_set, part_idx, CS_LAGR_STAT_WEIGHT);
+        unsigned char *part = _cell_particle(c, interf_tot[idx][1]);
+        cs_real_t weight = cs_lagr_particle_get_real(part, p_am,
+                                                     CS_LAGR_STAT_WEIGHT);
 
         if (weight >= agglo_min_weight && sum + weight < agglo_max_weight) {
           put_in_large = 1;
-          cs_lagr_particles_set_real(p_set, part_idx,
-                                     CS_LAGR_STAT_WEIGHT, sum+weight);
+          cs_lagr_particle_set_real(part, p_am, CS_LAGR_STAT_WEIGHT,
+                                    sum+weight);
           break;
         }
       }
@@ -753,48 +997,233 @@ cs_lagr_agglomeration(cs_lnum_t  cell_id,
         last_small = -1;
       }
       else {
-        cs_lagr_particles_set_real(p_set, interf_tot[last_small][1],
-                                   CS_LAGR_STAT_WEIGHT, sum);
+        cs_lagr_particle_set_real(_cell_particle(c, interf_tot[last_small][1]),
+                                  p_am, CS_LAGR_STAT_WEIGHT, sum);
       }
 
       for (cs_lnum_t idx = start_gap; idx < end_gap; ++idx) {
-        cs_lnum_t part_idx = interf_tot[idx][1];
-        cs_real_t weight = cs_lagr_particles_get_real(p_set, part_idx,
-                                                      CS_LAGR_STAT_WEIGHT);
-        if (weight > 0. && weight < agglo_min_weight && idx != last_small) {
-          cs_lagr_particles_set_lnum(p_set, part_idx,
-                                     CS_LAGR_AGGLO_CLASS_ID, 0);
-          cs_lagr_particles_set_real(p_set, part_idx, CS_LAGR_STAT_WEIGHT, 0);
-          cs_lagr_particles_set_lnum(p_set, part_idx,
-                                     CS_LAGR_P_FLAG, CS_LAGR_PART_TO_DELETE);
-
-        }
+        unsigned char *part = _cell_particle(c, interf_tot[idx][1]);
+        cs_real_t weight = cs_lagr_particle_get_real(part, p_am,
+                                                     CS_LAGR_STAT_WEIGHT);
+        if (weight > 0. && weight < agglo_min_weight && idx != last_small)
+          _delete_particle(part, p_am);
       }
     }
 
     /* Eliminate particles (if statistical weight < 0) */
     for (cs_lnum_t idx = start_gap; idx < end_gap; ++idx) {
-      cs_lnum_t part_idx = interf_tot[idx][1];
-      cs_real_t weight = cs_lagr_particles_get_real
-                           (p_set, part_idx, CS_LAGR_STAT_WEIGHT);
+      unsigned char *part = _cell_particle(c, interf_tot[idx][1]);
+      cs_real_t weight = cs_lagr_particle_get_real(part, p_am,
+                                                   CS_LAGR_STAT_WEIGHT);
 
-      if (weight <= 0.) {
-        cs_lagr_particles_set_lnum(p_set, part_idx,
-                                   CS_LAGR_AGGLO_CLASS_ID, 0);
-        cs_lagr_particles_set_real(p_set, part_idx, CS_LAGR_STAT_WEIGHT, 0);
-        cs_lagr_particles_set_lnum(p_set, part_idx,
-                                   CS_LAGR_P_FLAG, CS_LAGR_PART_TO_DELETE);
+      if (weight <= 0.)
+        _delete_particle(part, p_am);
+    }
+  }
 
-      }
+  cs_scratch_release(mark);
+}
+
+/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Merge two sorted arrays in a third sorted array
+ *
+ * \param[in]       arr1   first sorted array
+ * \param[in]       arr2   second sorted array
+ * \param[in]       n1     size of first sorted array
+ * \param[in]       n2     size of second sorted array
+ * \param[in, out]  arr3   preallocated array that will contain the sorted
+ *                         merge of the two previous arrays
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_agglo_merge_arrays(cs_lnum_2_t  arr1[],
+                           cs_lnum_2_t  arr2[],
+                           cs_lnum_t    n1,
+                           cs_lnum_t    n2,
+                           cs_lnum_2_t  arr3[])
+{
+  cs_lnum_t i = 0, j = 0, k = 0;
+  /* Browse both arrays  */
+  while (i<n1 && j <n2) {
+    if (arr1[i][0] < arr2[j][0]) {
+      arr3[k][0] = arr1[i][0];
+      arr3[k][1] = arr1[i][1];
+      k++;
+      i++;
+    }
+    else {
+      arr3[k][0] = arr2[j][0];
+      arr3[k][1] = arr2[j][1];
+      k++;
+      j++;
     }
   }
 
-  BFT_FREE(cls_gaps);
-  BFT_FREE(interf_tot);
+  /* Store remaining elements of first array  */
+  while (i < n1) {
+    arr3[k][0] = arr1[i][0];
+    arr3[k][1] = arr1[i][1];
+    k++;
+    i++;
+  }
 
-  p_set->n_particles += newpart;
+  /* Store remaining elements of second array */
+  while (j < n2) {
+    arr3[k][0] = arr2[j][0];
+    arr3[k][1] = arr2[j][1];
+    k++;
+    j++;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Agglomeration algorithm based on algorithms used in
+ *        rare gas modelling.
+ *
+ * Parcels represent physical particles with similar properties (size).
+ * The number of physical particles in a parcel is represented by
+ * the statistical weight.
+ *
+ * - We select randomly a number of parcels within which agglomeration
+ *   is treated.
+ * - We selected randomly pairs of particles and, for each pair,
+ *   the number of agglomeration events is generated with
+ *   a Poisson distribution that depends on the agglomeration kernel and
+ *   number of each particle (i.e. statistical weight).
+ *
+ * Working hypotheses:
+ *
+ * 1) Discrete diameters
+ *    - Minimal particle size , called a monomere (unbreakable particle)
+ *    - Aggregates correponds to group of monomeres sticking together.
+ *    - Each class of the parcel represent one size (stored in CS_LAGR_AGGREGATE)
+ * 2) Agglomeration happens between two parcels
+ * 3) Particles in the same cell are contiguous in the particle list
+ *
+ * Cells are handled independently (and in parallel using threads), with
+ * random numbers drawn from counter-based streams associated with each
+ * cell, so that results do not depend on the number of threads or ranks.
+ *
+ * Parcels created by agglomeration are not added to the particle set,
+ * but returned in a buffer, ordered by cell.
+ *
+ * \param[in]   dt                     time step
+ * \param[in]   minimum_particle_diam  minumum diameter (monomere diameter)
+ * \param[in]   n_cells                number of cells to handle
+ * \param[in]   cell_ids               ids of cells to handle
+ * \param[in]   particle_idx           index of particles in each handled
+ *                                     cell (size: n_cells + 1)
+ * \param[out]  parcel_idx             index of created parcels for each
+ *                                     handled cell (size: n_cells + 1)
+ * \param[out]  parcels                created parcels data (to be freed
+ *                                     by the caller)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_agglomeration(cs_real_t          dt,
+                      cs_real_t          minimum_particle_diam,
+                      cs_lnum_t          n_cells,
+                      const cs_lnum_t    cell_ids[],
+                      const cs_lnum_t    particle_idx[],
+                      cs_lnum_t          parcel_idx[],
+                      unsigned char    **parcels)
+{
+  cs_lagr_particle_set_t *p_set = cs_glob_lagr_particle_set;
+  const cs_lagr_attribute_map_t *p_am = p_set->p_am;
+
+  const cs_real_t *cell_vol = cs_glob_mesh_quantities->cell_vol;
+  const cs_gnum_t *global_cell_num = cs_glob_mesh->global_cell_num;
+  const int nt_cur = cs_glob_time_step->nt_cur;
+
+  /* Per-thread buffers for created parcels */
+
+  const int n_threads = cs_glob_n_threads;
+
+  _parcel_buffer_t *pb;
+  BFT_MALLOC(pb, n_threads, _parcel_buffer_t);
+
+  for (int t_id = 0; t_id < n_threads; t_id++) {
+    pb[t_id].extents = p_am->extents;
+    pb[t_id].n_parcels = 0;
+    pb[t_id].n_max = 0;
+    pb[t_id].p_buffer = NULL;
+  }
+
+  parcel_idx[0] = 0;
+
+  cs_lnum_t n_particles = particle_idx[n_cells] - particle_idx[0];
+
+# pragma omp parallel if (n_particles > CS_THR_MIN)
+  {
+    cs_lnum_t s_id, e_id;
+    _thread_cell_range(n_cells, particle_idx, &s_id, &e_id);
+
+#if defined(HAVE_OPENMP)
+    _parcel_buffer_t *t_pb = pb + omp_get_thread_num();
+#else
+    _parcel_buffer_t *t_pb = pb;
+#endif
+
+    for (cs_lnum_t i = s_id; i < e_id; i++) {
+
+      cs_lnum_t cell_id = cell_ids[i];
+      cs_gnum_t g_cell_id = (global_cell_num != NULL) ?
+        global_cell_num[cell_id] : (cs_gnum_t)cell_id + 1;
+
+      _agglo_random_t r;
+      r.n_values = 2;
+      r.n_used = 2;
+      cs_random_stream_init(&(r.rs), g_cell_id, nt_cur,
+                            CS_LAGR_RNG_AGGLOMERATION);
+
+      _agglo_cell_t c = {
+        .p_am = p_am,
+        .p_buffer = p_set->p_buffer + p_am->extents*particle_idx[i],
+        .n_p = particle_idx[i+1] - particle_idx[i],
+        .pb = t_pb,
+        .pb_start = t_pb->n_parcels
+      };
+
+      _agglomerate_cell(&c,
+                        cell_id,
+                        cell_vol[cell_id],
+                        dt,
+                        minimum_particle_diam,
+                        &r);
+
+      parcel_idx[i+1] = t_pb->n_parcels - c.pb_start;
+
+    }
+  }
+
+  for (cs_lnum_t i = 0; i < n_cells; i++)
+    parcel_idx[i+1] += parcel_idx[i];
+
+  /* Thread ranges are ordered, so parcels are ordered by cell
+     when concatenating thread buffers */
+
+  BFT_MALLOC(*parcels, parcel_idx[n_cells]*p_am->extents, unsigned char);
+
+  size_t shift = 0;
+  for (int t_id = 0; t_id < n_threads; t_id++) {
+    size_t size = pb[t_id].n_parcels*p_am->extents;
+    if (size > 0)
+      memcpy(*parcels + shift, pb[t_id].p_buffer, size);
+    shift += size;
+    BFT_FREE(pb[t_id].p_buffer);
+  }
 
-  return ret_val;
+  BFT_FREE(pb);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -90,23 +90,34 @@ cs_lagr_agglo_merge_arrays(cs_lnum_2_t  arr1[],
  * 2) Agglomeration happens between two parcels
  * 3) Particles in the same cell are contiguous in the particle list
  *
- * \param[in]  cell_id                current cell id
- * \param[in]  dt                     time step
- * \param[in]  minimum_particle_diam  minumum diameter (monomere diameter)
- * \param[in]  start_particle         index of the first particle
- * \param[in]  end_particle           index after the last particle
+ * Cells are handled independently (and in parallel using threads), with
+ * random numbers drawn from counter-based streams associated with each
+ * cell, so that results do not depend on the number of threads or ranks.
  *
- * \returns a modified list of particles, containing newly
- *          created parcels at the end
+ * Parcels created by agglomeration are not added to the particle set,
+ * but returned in a buffer, ordered by cell.
+ *
+ * \param[in]   dt                     time step
+ * \param[in]   minimum_particle_diam  minumum diameter (monomere diameter)
+ * \param[in]   n_cells                number of cells to handle
+ * \param[in]   cell_ids               ids of cells to handle
+ * \param[in]   particle_idx           index of particles in each handled
+ *                                     cell (size: n_cells + 1)
+ * \param[out]  parcel_idx             index of created parcels for each
+ *                                     handled cell (size: n_cells + 1)
+ * \param[out]  parcels                created parcels data (to be freed
+ *                                     by the caller)
  */
 /*----------------------------------------------------------------------------*/
 
-cs_lnum_t
-cs_lagr_agglomeration(cs_lnum_t  cell_id,
-                      cs_real_t  dt,
-                      cs_real_t  minimum_particle_diam,
-                      cs_lnum_t  start_particle,
-                      cs_lnum_t  end_particle);
+void
+cs_lagr_agglomeration(cs_real_t          dt,
+                      cs_real_t          minimum_particle_diam,
+                      cs_lnum_t          n_cells,
+                      const cs_lnum_t    cell_ids[],
+                      const cs_lnum_t    particle_idx[],
+                      cs_lnum_t          parcel_idx[],
+                      unsigned char    **parcels);
 
 /*----------------------------------------------------------------------------*/
 
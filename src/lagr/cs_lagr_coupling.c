@@ -60,6 +60,7 @@
 #include "cs_time_step.h"
 
 #include "cs_lagr.h"
+#include "cs_lagr_coupling_kernels.h"
 #include "cs_lagr_particle.h"
 
 /*----------------------------------------------------------------------------
@@ -100,6 +101,13 @@ static const cs_real_t  _c_stephan = 5.6703e-8;
  *          particle interacts with a boundary, then the source terms
  *          are computed as if nor == 1.
  *
+ * \remark  Contributions of particles are first computed independently,
+ *          then added to cells using an index of particles by cell,
+ *          so that each cell is updated by a single thread, in the same
+ *          order as a serial loop on particles (see
+ *          \ref cs_lagr_coupling_accumulate). Results thus do not depend
+ *          on the number of threads.
+ *
  * \param[in]   taup    dynamic characteristic time
  * \param[in]   tempct  thermal charactersitic time
  * \param[out]  tsfext  external forces
@@ -170,6 +178,8 @@ cs_lagr_coupling(const cs_real_t  taup[],
   cs_real_t *volp = NULL, *volm = NULL;
   BFT_MALLOC(volp, ncel, cs_real_t);
   BFT_MALLOC(volm, ncel, cs_real_t);
+
+# pragma omp parallel for if (ncel > CS_THR_MIN)
   for (cs_lnum_t iel = 0; iel < ncel; iel++) {
     volp[iel] = 0.0;
     volm[iel] = 0.0;
@@ -177,17 +187,49 @@ cs_lagr_coupling(const cs_real_t  taup[],
 
   for (cs_lnum_t ivar = 0; ivar < ntersl; ivar++) {
 
+#   pragma omp parallel for if (ncel > CS_THR_MIN)
     for (cs_lnum_t iel = 0; iel < ncel; iel++)
       tslag[ncelet * ivar + iel]  = 0.0;
 
   }
 
+  /* Index of particles by cell, for conflict-free accumulation
+     of particle contributions (p_ids remains NULL if particles
+     are already sorted by cell) */
+
+  const cs_lnum_t *cell_idx = cs_lagr_particle_set_get_cell_index(p_set, ncel);
+  cs_lnum_t *_cell_idx = NULL, *p_ids = NULL;
+
+  if (cell_idx == NULL) {
+
+    cs_lnum_t *p_cell_id;
+    BFT_MALLOC(p_cell_id, nbpart, cs_lnum_t);
+    BFT_MALLOC(p_ids, nbpart, cs_lnum_t);
+    BFT_MALLOC(_cell_idx, ncel + 1, cs_lnum_t);
+
+#   pragma omp parallel for if (nbpart > CS_THR_MIN)
+    for (cs_lnum_t npt = 0; npt < nbpart; npt++)
+      p_cell_id[npt] = cs_lagr_particles_get_lnum(p_set, npt, CS_LAGR_CELL_ID);
+
+    cs_lagr_coupling_cell_order(nbpart, ncel, p_cell_id, _cell_idx, p_ids);
+
+    BFT_FREE(p_cell_id);
+
+    cell_idx = _cell_idx;
+  }
+
+  /* Particle contributions (at most 6 values per particle) */
+
+  cs_real_t *p_st;
+  BFT_MALLOC(p_st, nbpart*6, cs_real_t);
+
   /* Preliminary computations
      ======================== */
 
   /* Finalization of external forces (if the particle interacts with a
      domain boundary, revert to order 1). */
 
+# pragma omp parallel for if (nbpart > CS_THR_MIN)
   for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
 
     cs_real_t aux1 = dtp / taup[npt];
@@ -203,6 +245,7 @@ cs_lagr_coupling(const cs_real_t  taup[],
 
   }
 
+# pragma omp parallel for if (nbpart > CS_THR_MIN)
   for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
 
     cs_real_t  p_stat_w = cs_lagr_particles_get_real(p_set, npt,
@@ -234,14 +277,17 @@ cs_lagr_coupling(const cs_real_t  taup[],
     else
       t_st_vel = st_vel;
 
+#   pragma omp parallel for if (ncel > CS_THR_MIN)
     for (cs_lnum_t i = 0; i < ncel; i++) {
       for (cs_lnum_t j = 0; j < 3; j++)
         t_st_vel[i][j] = 0;
     }
 
+#   pragma omp parallel for if (nbpart > CS_THR_MIN)
     for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
 
       unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
+      cs_real_t *_p_st = p_st + npt*6;
 
       cs_real_t  p_stat_w = cs_lagr_particle_get_real(particle, p_am,
                                                       CS_LAGR_STAT_WEIGHT);
@@ -253,21 +299,25 @@ cs_lagr_coupling(const cs_real_t  taup[],
       cs_real_t  p_mass = cs_lagr_particle_get_real(particle, p_am,
                                                     CS_LAGR_MASS);
 
-      cs_lnum_t iel = cs_lagr_particle_get_lnum(particle, p_am, CS_LAGR_CELL_ID);
-
       /* Volume and mass of particles in cell */
-      volp[iel] += p_stat_w * cs_math_pi * pow(prev_p_diam, 3) / 6.0;
-      volm[iel] += p_stat_w * prev_p_mass;
+      _p_st[0] = p_stat_w * cs_math_pi * pow(prev_p_diam, 3) / 6.0;
+      _p_st[1] = p_stat_w * prev_p_mass;
 
       /* Momentum source term */
-      t_st_vel[iel][0] += - auxl1[npt];
-      t_st_vel[iel][1] += - auxl2[npt];
-      t_st_vel[iel][2] += - auxl3[npt];
-      tslag[iel + (lag_st->itsli-1) * ncelet]
-        += - 2.0 * p_stat_w * p_mass / taup[npt];
+      _p_st[2] = - auxl1[npt];
+      _p_st[3] = - auxl2[npt];
+      _p_st[4] = - auxl3[npt];
+      _p_st[5] = - 2.0 * p_stat_w * p_mass / taup[npt];
 
     }
 
+    cs_lagr_coupling_accumulate(ncel, cell_idx, p_ids, 1, 6, p_st, volp);
+    cs_lagr_coupling_accumulate(ncel, cell_idx, p_ids, 1, 6, p_st + 1, volm);
+    cs_lagr_coupling_accumulate(ncel, cell_idx, p_ids, 3, 6, p_st + 2,
+                                (cs_real_t *)t_st_vel);
+    cs_lagr_coupling_accumulate(ncel, cell_idx, p_ids, 1, 6, p_st + 5,
+                                tslag + (lag_st->itsli-1) * ncelet);
+
   /* Turbulence source terms
      ======================= */
 
@@ -277,12 +327,11 @@ cs_lagr_coupling(const cs_real_t  taup[],
          (difficult to write something for v2, which loses its meaning as
          "Rij comonent") */
 
+#     pragma omp parallel for if (nbpart > CS_THR_MIN)
       for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
 
         unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
 
-        cs_lnum_t  iel         = cs_lagr_particle_get_lnum(particle, p_am,
-                                                           CS_LAGR_CELL_ID);
         cs_real_t *prev_f_vel  = cs_lagr_particle_attr_n(particle, p_am, 1,
                                                          CS_LAGR_VELOCITY_SEEN);
         cs_real_t *f_vel       = cs_lagr_particle_attr(particle, p_am,
@@ -292,12 +341,14 @@ cs_lagr_coupling(const cs_real_t  taup[],
         cs_real_t vvf = 0.5 * (prev_f_vel[1] + f_vel[1]);
         cs_real_t wwf = 0.5 * (prev_f_vel[2] + f_vel[2]);
 
-        tslag[iel + (lag_st->itske-1) * ncelet] += - uuf * auxl1[npt]
-                                                   - vvf * auxl2[npt]
-                                                   - wwf * auxl3[npt];
+        p_st[npt] = - uuf * auxl1[npt] - vvf * auxl2[npt] - wwf * auxl3[npt];
 
       }
 
+      cs_lagr_coupling_accumulate(ncel, cell_idx, p_ids, 1, 1, p_st,
+                                  tslag + (lag_st->itske-1) * ncelet);
+
+#     pragma omp parallel for if (ncel > CS_THR_MIN)
       for (cs_lnum_t iel = 0; iel < ncel; iel++)
         tslag[iel + (lag_st->itske-1) * ncelet]
           += - extra->vel->val[iel * 3    ] * t_st_vel[iel][0]
@@ -312,17 +363,17 @@ cs_lagr_coupling(const cs_real_t  taup[],
       else
         t_st_rij = st_rij;
 
+#     pragma omp parallel for if (ncel > CS_THR_MIN)
       for (cs_lnum_t i = 0; i < ncel; i++) {
         for (cs_lnum_t j = 0; j < 6; j++)
           t_st_rij[i][j] = 0;
       }
 
+#     pragma omp parallel for if (nbpart > CS_THR_MIN)
       for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
 
         unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
-
-        cs_lnum_t  iel         = cs_lagr_particle_get_lnum(particle, p_am,
-                                                           CS_LAGR_CELL_ID);
+        cs_real_t *_p_st = p_st + npt*6;
 
         cs_real_t *prev_f_vel  = cs_lagr_particle_attr_n(particle, p_am, 1,
                                                          CS_LAGR_VELOCITY_SEEN);
@@ -333,14 +384,19 @@ cs_lagr_coupling(const cs_real_t  taup[],
         cs_real_t vvf = 0.5 * (prev_f_vel[1] + f_vel[1]);
         cs_real_t wwf = 0.5 * (prev_f_vel[2] + f_vel[2]);
 
-        t_st_rij[iel][0] += - 2.0 * uuf * auxl1[npt];
-        t_st_rij[iel][1] += - 2.0 * vvf * auxl2[npt];
-        t_st_rij[iel][2] += - 2.0 * wwf * auxl3[npt];
-        t_st_rij[iel][3] += - uuf * auxl2[npt] - vvf * auxl1[npt];
-        t_st_rij[iel][4] += - vvf * auxl3[npt] - wwf * auxl2[npt];
-        t_st_rij[iel][5] += - uuf * auxl3[npt] - wwf * auxl1[npt];
+        _p_st[0] = - 2.0 * uuf * auxl1[npt];
+        _p_st[1] = - 2.0 * vvf * auxl2[npt];
+        _p_st[2] = - 2.0 * wwf * auxl3[npt];
+        _p_st[3] = - uuf * auxl2[npt] - vvf * auxl1[npt];
+        _p_st[4] = - vvf * auxl3[npt] - wwf * auxl2[npt];
+        _p_st[5] = - uuf * auxl3[npt] - wwf * auxl1[npt];
 
       }
+
+      cs_lagr_coupling_accumulate(ncel, cell_idx, p_ids, 6, 6, p_st,
+                                  (cs_real_t *)t_st_rij);
+
+#     pragma omp parallel for if (ncel > CS_THR_MIN)
       for (cs_lnum_t iel = 0; iel < ncel; iel++) {
 
         t_st_rij[iel][0] += - 2.0 * extra->vel->val[iel * 3    ]
@@ -374,6 +430,7 @@ cs_lagr_coupling(const cs_real_t  taup[],
       && (   cs_glob_lagr_specific_physics->impvar == 1
           || cs_glob_lagr_specific_physics->idpvar == 1)) {
 
+#   pragma omp parallel for if (nbpart > CS_THR_MIN)
     for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
 
       unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
@@ -386,14 +443,13 @@ cs_lagr_coupling(const cs_real_t  taup[],
         = cs_lagr_particle_get_real_n(particle, p_am, 0, CS_LAGR_MASS);
 
       /* Fluid mass source term > 0 -> add mass to fluid */
-      cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_am,
-                                                    CS_LAGR_CELL_ID);
-
-      tslag[cell_id + (lag_st->itsmas-1) * ncelet]
-        += - p_stat_w * (p_mass - prev_p_mass) / dtp;
+      p_st[npt] = - p_stat_w * (p_mass - prev_p_mass) / dtp;
 
     }
 
+    cs_lagr_coupling_accumulate(ncel, cell_idx, p_ids, 1, 1, p_st,
+                                tslag + (lag_st->itsmas-1) * ncelet);
+
   }
 
   /* Thermal source terms
@@ -404,11 +460,10 @@ cs_lagr_coupling(const cs_real_t  taup[],
     if (   cs_glob_lagr_model->physical_model == CS_LAGR_PHYS_HEAT
         && cs_glob_lagr_specific_physics->itpvar == 1) {
 
+#     pragma omp parallel for if (nbpart > CS_THR_MIN)
       for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
 
         unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
-        cs_lnum_t  iel = cs_lagr_particle_get_lnum(particle, p_am,
-                                                   CS_LAGR_CELL_ID);
         cs_real_t  p_mass = cs_lagr_particle_get_real_n(particle, p_am, 0,
                                                         CS_LAGR_MASS);
         cs_real_t  prev_p_mass = cs_lagr_particle_get_real_n(particle, p_am, 1,
@@ -424,15 +479,21 @@ cs_lagr_coupling(const cs_real_t  taup[],
         cs_real_t  p_stat_w = cs_lagr_particle_get_real(particle, p_am,
                                                         CS_LAGR_STAT_WEIGHT);
 
-        tslag[iel + (lag_st->itste-1) * ncelet]
-          += - (p_mass * p_tmp * p_cp
-             - prev_p_mass * prev_p_tmp * prev_p_cp) / dtp * p_stat_w;
-        tslag[iel + (lag_st->itsti-1) * ncelet]
-          += tempct[nbpart + npt] * p_stat_w;
+        p_st[npt*2]     = - (p_mass * p_tmp * p_cp
+                             - prev_p_mass * prev_p_tmp * prev_p_cp)
+                          / dtp * p_stat_w;
+        p_st[npt*2 + 1] = tempct[nbpart + npt] * p_stat_w;
 
       }
+
+      cs_lagr_coupling_accumulate(ncel, cell_idx, p_ids, 1, 2, p_st,
+                                  tslag + (lag_st->itste-1) * ncelet);
+      cs_lagr_coupling_accumulate(ncel, cell_idx, p_ids, 1, 2, p_st + 1,
+                                  tslag + (lag_st->itsti-1) * ncelet);
+
       if (extra->radiative_model > 0) {
 
+#       pragma omp parallel for if (nbpart > CS_THR_MIN)
         for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
 
           unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
@@ -451,10 +512,13 @@ cs_lagr_coupling(const cs_real_t  taup[],
                           * (extra->luminance->val[iel]
                              - 4.0 * _c_stephan * cs_math_pow4(p_tmp));
 
-          tslag[iel + (lag_st->itste-1) * ncelet] += aux1 * p_stat_w;
+          p_st[npt] = aux1 * p_stat_w;
 
         }
 
+        cs_lagr_coupling_accumulate(ncel, cell_idx, p_ids, 1, 1, p_st,
+                                    tslag + (lag_st->itste-1) * ncelet);
+
       }
 
     }
@@ -465,14 +529,11 @@ cs_lagr_coupling(const cs_real_t  taup[],
 
       else {
 
+#       pragma omp parallel for if (nbpart > CS_THR_MIN)
         for (cs_lnum_t npt = 0; npt < nbpart; npt++) {
 
           unsigned char *particle = p_set->p_buffer + p_am->extents * npt;
-
-          cs_lnum_t  iel = cs_lagr_particle_get_lnum(particle, p_am,
-                                                     CS_LAGR_CELL_ID);
-          cs_lnum_t icha = cs_lagr_particle_get_lnum(particle, p_am,
-                                                     CS_LAGR_COAL_ID);
+          cs_real_t *_p_st = p_st + npt*6;
 
           cs_real_t  p_mass = cs_lagr_particle_get_real_n(particle, p_am, 0,
                                                           CS_LAGR_MASS);
@@ -491,21 +552,37 @@ cs_lagr_coupling(const cs_real_t  taup[],
           cs_real_t  p_stat_w = cs_lagr_particle_get_real
                                   (particle, p_am, CS_LAGR_STAT_WEIGHT);
 
-          tslag[iel + (lag_st->itste-1) * ncelet]
-            += - (  p_mass * p_tmp * p_cp
-               - prev_p_mass * prev_p_tmp * prev_p_cp) / dtp * p_stat_w;
-          tslag[iel + (lag_st->itsti-1) * ncelet]
-            += tempct[nbpart + npt] * p_stat_w;
-          tslag[iel + (lag_st->itsmv1[icha]-1) * ncelet]
-            += p_stat_w * cpgd1[npt];
-          tslag[iel + (lag_st->itsmv2[icha]-1) * ncelet]
-            += p_stat_w * cpgd2[npt];
-          tslag[iel + (lag_st->itsco-1) * ncelet]
-            += p_stat_w * cpght[npt];
-          tslag[iel + (lag_st->itsfp4-1) * ncelet] = 0.0;
+          _p_st[0] = - (  p_mass * p_tmp * p_cp
+                        - prev_p_mass * prev_p_tmp * prev_p_cp)
+                     / dtp * p_stat_w;
+          _p_st[1] = tempct[nbpart + npt] * p_stat_w;
+          _p_st[2] = p_stat_w * cpgd1[npt];
+          _p_st[3] = p_stat_w * cpgd2[npt];
+          _p_st[4] = p_stat_w * cpght[npt];
 
         }
 
+        cs_lagr_coupling_accumulate(ncel, cell_idx, p_ids, 1, 6, p_st,
+                                    tslag + (lag_st->itste-1) * ncelet);
+        cs_lagr_coupling_accumulate(ncel, cell_idx, p_ids, 1, 6, p_st + 1,
+                                    tslag + (lag_st->itsti-1) * ncelet);
+        cs_lagr_coupling_accumulate(ncel, cell_idx, p_ids, 1, 6, p_st + 4,
+                                    tslag + (lag_st->itsco-1) * ncelet);
+
+        /* Devolatilization terms depend on the coal of each particle;
+           the itsfp4 source term remains zero */
+
+#       pragma omp parallel for if (nbpart > CS_THR_MIN)
+        for (cs_lnum_t iel = 0; iel < ncel; iel++) {
+          for (cs_lnum_t i = cell_idx[iel]; i < cell_idx[iel+1]; i++) {
+            cs_lnum_t npt = (p_ids != NULL) ? p_ids[i] : i;
+            cs_lnum_t icha = cs_lagr_particles_get_lnum(p_set, npt,
+                                                        CS_LAGR_COAL_ID);
+            tslag[iel + (lag_st->itsmv1[icha]-1) * ncelet] += p_st[npt*6 + 2];
+            tslag[iel + (lag_st->itsmv2[icha]-1) * ncelet] += p_st[npt*6 + 3];
+          }
+        }
+
       }
 
     }
@@ -560,6 +637,7 @@ cs_lagr_coupling(const cs_real_t  taup[],
 
     for (int ivar = 0; ivar < ntersl; ivar++) {
 
+#     pragma omp parallel for if (ncel > CS_THR_MIN)
       for (cs_lnum_t iel = 0; iel < ncel; iel++)
         st_val[iel + ivar * ncelet]
           =  (  tslag[iel + ncelet * ivar]
@@ -569,6 +647,7 @@ cs_lagr_coupling(const cs_real_t  taup[],
     }
 
     if (st_vel != NULL) {
+#     pragma omp parallel for if (ncel > CS_THR_MIN)
       for (cs_lnum_t iel = 0; iel < ncel; iel++) {
         for (cs_lnum_t j = 0; j < 3; j++) {
           st_vel[iel][j]
@@ -579,6 +658,7 @@ cs_lagr_coupling(const cs_real_t  taup[],
     }
 
     if (st_rij != NULL) {
+#     pragma omp parallel for if (ncel > CS_THR_MIN)
       for (cs_lnum_t iel = 0; iel < ncel; iel++) {
         for (cs_lnum_t j = 0; j < 6; j++) {
           st_rij[iel][j]
@@ -592,6 +672,7 @@ cs_lagr_coupling(const cs_real_t  taup[],
   else {
 
     for (int ivar = 0; ivar < ntersl; ivar++) {
+#     pragma omp parallel for if (ncel > CS_THR_MIN)
       for (cs_lnum_t iel = 0; iel < ncel; iel++)
         st_val[iel + ncelet * ivar] = tslag[iel + ncelet * ivar];
     }
@@ -604,6 +685,10 @@ cs_lagr_coupling(const cs_real_t  taup[],
   if (t_st_rij != st_rij)
     BFT_FREE(t_st_rij);
 
+  BFT_FREE(p_st);
+  BFT_FREE(p_ids);
+  BFT_FREE(_cell_idx);
+
   BFT_FREE(volp);
   BFT_FREE(volm);
 
@@ -0,0 +1,177 @@
+/*============================================================================
+ * Conflict-free accumulation of particle contributions to cells.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <assert.h>
+
+/*----------------------------------------------------------------------------
+ *  Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_lagr_coupling_kernels.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Additional doxygen documentation
+ *============================================================================*/
+
+/*!
+  \file cs_lagr_coupling_kernels.c
+
+  Kernels used to accumulate particle contributions (such as two-way
+  coupling source terms) to cell values. Rather than scattering values
+  particle by particle, which prevents threading, particles are
+  grouped by cell, and each cell is updated by a single thread.
+  Contributions of a given cell are added in increasing particle id order,
+  so results are bit-identical to those of a serial loop on particles.
+*/
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Build an index of particles by cell.
+ *
+ * Particles of cell i are p_ids[cell_idx[i]] to p_ids[cell_idx[i+1] - 1],
+ * in increasing id order.
+ *
+ * \param[in]   n_particles  number of particles
+ * \param[in]   n_cells      number of cells
+ * \param[in]   p_cell_id    cell id of each particle (size: n_particles)
+ * \param[out]  cell_idx     index of particles by cell (size: n_cells + 1)
+ * \param[out]  p_ids        particle ids ordered by cell (size: n_particles)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_coupling_cell_order(cs_lnum_t        n_particles,
+                            cs_lnum_t        n_cells,
+                            const cs_lnum_t  p_cell_id[],
+                            cs_lnum_t        cell_idx[],
+                            cs_lnum_t        p_ids[])
+{
+  /* Stable counting sort */
+
+# pragma omp parallel for if (n_cells > CS_THR_MIN)
+  for (cs_lnum_t i = 0; i < n_cells + 1; i++)
+    cell_idx[i] = 0;
+
+  for (cs_lnum_t i = 0; i < n_particles; i++) {
+    assert(p_cell_id[i] > -1 && p_cell_id[i] < n_cells);
+    cell_idx[p_cell_id[i] + 1] += 1;
+  }
+
+  for (cs_lnum_t i = 0; i < n_cells; i++)
+    cell_idx[i+1] += cell_idx[i];
+
+  /* Use cell_idx[i] as insertion position for cell i-1, so that
+     the index is shifted back in place once all particles are added */
+
+  for (cs_lnum_t i = 0; i < n_particles; i++) {
+    cs_lnum_t j = cell_idx[p_cell_id[i]];
+    cell_idx[p_cell_id[i]] += 1;
+    p_ids[j] = i;
+  }
+
+  for (cs_lnum_t i = n_cells; i > 0; i--)
+    cell_idx[i] = cell_idx[i-1];
+  cell_idx[0] = 0;
+
+  assert(cell_idx[n_cells] == n_particles);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Add particle contributions to cell values.
+ *
+ * Each cell is updated by a single thread, adding contributions of its
+ * particles in the order given by the index, so results are identical to
+ * those of a serial loop on particles (in increasing id order if the index
+ * was built by \ref cs_lagr_coupling_cell_order), whatever the number of
+ * threads.
+ *
+ * \param[in]       n_cells   number of cells
+ * \param[in]       cell_idx  index of particles by cell (size: n_cells + 1)
+ * \param[in]       p_ids     particle ids ordered by cell, or NULL if
+ *                            particles are already sorted by cell
+ * \param[in]       dim       number of values per particle and cell
+ * \param[in]       p_stride  stride between values of successive particles
+ * \param[in]       p_val     particle contributions
+ * \param[in, out]  c_val     cell values (interleaved, size: n_cells*dim)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_coupling_accumulate(cs_lnum_t          n_cells,
+                            const cs_lnum_t    cell_idx[],
+                            const cs_lnum_t    p_ids[],
+                            cs_lnum_t          dim,
+                            cs_lnum_t          p_stride,
+                            const cs_real_t    p_val[restrict],
+                            cs_real_t          c_val[restrict])
+{
+  const cs_lnum_t n_particles = cell_idx[n_cells];
+
+  /* Dynamic scheduling balances the load for uneven particle
+     distributions; it does not change the order of additions */
+
+# pragma omp parallel for schedule(dynamic, 64) \
+                          if (n_particles > CS_THR_MIN)
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+
+    cs_real_t *restrict _c_val = c_val + c_id*dim;
+
+    if (p_ids != NULL) {
+      for (cs_lnum_t i = cell_idx[c_id]; i < cell_idx[c_id+1]; i++) {
+        const cs_real_t *_p_val = p_val + p_ids[i]*p_stride;
+        for (cs_lnum_t j = 0; j < dim; j++)
+          _c_val[j] += _p_val[j];
+      }
+    }
+    else {
+      for (cs_lnum_t i = cell_idx[c_id]; i < cell_idx[c_id+1]; i++) {
+        const cs_real_t *_p_val = p_val + i*p_stride;
+        for (cs_lnum_t j = 0; j < dim; j++)
+          _c_val[j] += _p_val[j];
+      }
+    }
+
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
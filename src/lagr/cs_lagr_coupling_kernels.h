@@ -0,0 +1,96 @@
+#ifndef __CS_LAGR_COUPLING_KERNELS_H__
+#define __CS_LAGR_COUPLING_KERNELS_H__
+
+/*============================================================================
+ * Conflict-free accumulation of particle contributions to cells.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Build an index of particles by cell.
+ *
+ * Particles of cell i are p_ids[cell_idx[i]] to p_ids[cell_idx[i+1] - 1],
+ * in increasing id order.
+ *
+ * \param[in]   n_particles  number of particles
+ * \param[in]   n_cells      number of cells
+ * \param[in]   p_cell_id    cell id of each particle (size: n_particles)
+ * \param[out]  cell_idx     index of particles by cell (size: n_cells + 1)
+ * \param[out]  p_ids        particle ids ordered by cell (size: n_particles)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_coupling_cell_order(cs_lnum_t        n_particles,
+                            cs_lnum_t        n_cells,
+                            const cs_lnum_t  p_cell_id[],
+                            cs_lnum_t        cell_idx[],
+                            cs_lnum_t        p_ids[]);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Add particle contributions to cell values.
+ *
+ * Each cell is updated by a single thread, adding contributions of its
+ * particles in the order given by the index, so results are identical to
+ * those of a serial loop on particles (in increasing id order if the index
+ * was built by \ref cs_lagr_coupling_cell_order), whatever the number of
+ * threads.
+ *
+ * \param[in]       n_cells   number of cells
+ * \param[in]       cell_idx  index of particles by cell (size: n_cells + 1)
+ * \param[in]       p_ids     particle ids ordered by cell, or NULL if
+ *                            particles are already sorted by cell
+ * \param[in]       dim       number of values per particle and cell
+ * \param[in]       p_stride  stride between values of successive particles
+ * \param[in]       p_val     particle contributions
+ * \param[in, out]  c_val     cell values (interleaved, size: n_cells*dim)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_coupling_accumulate(cs_lnum_t          n_cells,
+                            const cs_lnum_t    cell_idx[],
+                            const cs_lnum_t    p_ids[],
+                            cs_lnum_t          dim,
+                            cs_lnum_t          p_stride,
+                            const cs_real_t    p_val[restrict],
+                            cs_real_t          c_val[restrict]);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_LAGR_COUPLING_KERNELS_H__ */
@@ -80,6 +80,8 @@ BEGIN_C_DECLS
  * Static global variables
  *============================================================================*/
 
+static cs_lagr_wall_face_cache_t  *_wall_face_cache = NULL;
+
 /*============================================================================
  * Prototypes for functions intended for use only by Fortran wrappers.
  * (descriptions follow, with function bodies).
@@ -164,3 +166,106 @@ cs_lagr_geom(void)
   }
 
 }
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Update the wall face data cache used by the deposition model.
+ *
+ * Friction velocity and viscous scales are computed once per time step
+ * in a threaded pass over boundary faces, rather than for each particle
+ * near a wall. The local frame projection matrices are built here if
+ * needed, so that the unit wall normal (their first row) is available
+ * with the cache.
+ *
+ * \param[in]  vislen  viscous length scale on boundary faces
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_geom_wall_face_cache_update(const cs_real_t  vislen[])
+{
+  const cs_lnum_t n_b_faces = cs_glob_mesh->n_b_faces;
+
+  const cs_lagr_extra_module_t *extra = cs_glob_lagr_extra_module;
+  const char *elt_type = cs_glob_lagr_boundary_conditions->elt_type;
+
+  if (cs_glob_lagr_b_face_proj == NULL)
+    cs_lagr_geom();
+
+  if (_wall_face_cache == NULL) {
+    BFT_MALLOC(_wall_face_cache, 1, cs_lagr_wall_face_cache_t);
+    _wall_face_cache->n_b_faces = 0;
+    _wall_face_cache->is_depo = NULL;
+    _wall_face_cache->ustar = NULL;
+    _wall_face_cache->lvisq = NULL;
+    _wall_face_cache->tvisq = NULL;
+  }
+
+  cs_lagr_wall_face_cache_t *wc = _wall_face_cache;
+
+  if (wc->n_b_faces != n_b_faces) {
+    wc->n_b_faces = n_b_faces;
+    BFT_REALLOC(wc->is_depo, n_b_faces, char);
+    BFT_REALLOC(wc->ustar, n_b_faces, cs_real_t);
+    BFT_REALLOC(wc->lvisq, n_b_faces, cs_real_t);
+    BFT_REALLOC(wc->tvisq, n_b_faces, cs_real_t);
+  }
+
+  const cs_real_t *ustar = extra->ustar->val;
+
+# pragma omp parallel for if (n_b_faces > CS_THR_MIN)
+  for (cs_lnum_t face_id = 0; face_id < n_b_faces; face_id++) {
+
+    const char b_type = elt_type[face_id];
+
+    wc->is_depo[face_id] = (   b_type == CS_LAGR_DEPO1
+                            || b_type == CS_LAGR_DEPO2
+                            || b_type == CS_LAGR_DEPO_DLVO) ? 1 : 0;
+
+    cs_real_t _ustar = ustar[face_id];
+    cs_real_t lvisq = vislen[face_id];
+
+    wc->ustar[face_id] = _ustar;
+    wc->lvisq[face_id] = lvisq;
+    wc->tvisq[face_id] = (_ustar > 0.0) ? lvisq / _ustar : cs_math_big_r;
+
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return the wall face data cache used by the deposition model.
+ *
+ * \return  pointer to wall face data cache, or NULL if not built
+ */
+/*----------------------------------------------------------------------------*/
+
+const cs_lagr_wall_face_cache_t *
+cs_lagr_geom_wall_face_cache(void)
+{
+  return _wall_face_cache;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Free geometric information needed by the deposition model.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_geom_finalize(void)
+{
+  BFT_FREE(cs_glob_lagr_b_face_proj);
+
+  if (_wall_face_cache != NULL) {
+    BFT_FREE(_wall_face_cache->is_depo);
+    BFT_FREE(_wall_face_cache->ustar);
+    BFT_FREE(_wall_face_cache->lvisq);
+    BFT_FREE(_wall_face_cache->tvisq);
+    BFT_FREE(_wall_face_cache);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
@@ -41,6 +41,23 @@ BEGIN_C_DECLS
  * Type definitions
  *============================================================================*/
 
+/*! Wall face quantities used by the deposition model, updated once
+  per Lagrangian time step and shared by all near-wall particles */
+
+typedef struct {
+
+  cs_lnum_t     n_b_faces;   /*!< number of boundary faces */
+
+  char         *is_depo;     /*!< 1 for faces of deposition type
+                                  (CS_LAGR_DEPO1, CS_LAGR_DEPO2 or
+                                  CS_LAGR_DEPO_DLVO), 0 otherwise */
+
+  cs_real_t    *ustar;       /*!< wall friction velocity */
+  cs_real_t    *lvisq;       /*!< viscous length scale */
+  cs_real_t    *tvisq;       /*!< viscous time scale */
+
+} cs_lagr_wall_face_cache_t;
+
 /*=============================================================================
  * Global variables
  *============================================================================*/
@@ -58,6 +75,37 @@ BEGIN_C_DECLS
 void
 cs_lagr_geom(void);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Update the wall face data cache used by the deposition model.
+ *
+ * \param[in]  vislen  viscous length scale on boundary faces
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_geom_wall_face_cache_update(const cs_real_t  vislen[]);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return the wall face data cache used by the deposition model.
+ *
+ * \return  pointer to wall face data cache, or NULL if not built
+ */
+/*----------------------------------------------------------------------------*/
+
+const cs_lagr_wall_face_cache_t *
+cs_lagr_geom_wall_face_cache(void);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Free geometric information needed by the deposition model.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_geom_finalize(void);
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
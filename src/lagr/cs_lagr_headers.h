@@ -34,6 +34,7 @@
 #include "cs_lagr_car.h"
 #include "cs_lagr_clogging.h"
 #include "cs_lagr_coupling.h"
+#include "cs_lagr_coupling_kernels.h"
 #include "cs_lagr_deposition_model.h"
 #include "cs_lagr_dlvo.h"
 #include "cs_lagr_orientation.h"
@@ -56,8 +57,10 @@
 #include "cs_lagr_resuspension.h"
 #include "cs_lagr_roughness.h"
 #include "cs_lagr_sde.h"
+#include "cs_lagr_sde_kernels.h"
 #include "cs_lagr_sde_model.h"
 #include "cs_lagr_stat.h"
+#include "cs_lagr_stream.h"
 #include "cs_lagr_tracking.h"
 
 /*----------------------------------------------------------------------------*/
@@ -63,6 +63,8 @@
 #include "cs_physical_constants.h"
 #include "cs_prototypes.h"
 #include "cs_time_step.h"
+#include "cs_timer.h"
+#include "cs_timer_stats.h"
 
 #include "cs_field.h"
 #include "cs_field_pointer.h"
@@ -87,6 +89,46 @@ BEGIN_C_DECLS
 
 /*! \cond DOXYGEN_SHOULD_SKIP_THIS */
 
+/*=============================================================================
+ * Local Macro definitions
+ *============================================================================*/
+
+/* Size of random value buffers for serial distribution among ranks */
+
+#define _RANDOM_BUFFER_SIZE  256
+
+/*============================================================================
+ * Local structure definitions
+ *============================================================================*/
+
+/* Particles injected for a given zone and set at the current time step */
+
+typedef struct {
+
+  const cs_lagr_injection_set_t  *zis;  /* associated injection set */
+
+  cs_lnum_t         n_elts;             /* number of zone elements */
+  const cs_lnum_t  *elt_ids;            /* zone element ids */
+  cs_lnum_t        *elt_particle_idx;   /* start index of new particles
+                                           for each element (size:
+                                           n_elts + 1) */
+
+  cs_lnum_t         n_inject;           /* local number of new particles */
+  cs_gnum_t         p_gnum_s;           /* global number of first local
+                                           new particle */
+
+} _injection_batch_t;
+
+/*============================================================================
+ * Static global variables
+ *============================================================================*/
+
+/* Local number of particles injected and elapsed time
+   at last call to cs_lagr_injection */
+
+static cs_lnum_t  _n_injected = 0;
+static double     _injection_wtime = 0.;
+
 /*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
 
 /*============================================================================
@@ -136,7 +178,13 @@ _segment_binary_search(cs_lnum_t     n,
 /*!
  * \brief Distribute new particles in a given region.
  *
+ * Random values are drawn from counter-based streams keyed by global
+ * particle numbers, so that the distribution does not depend on the
+ * number of threads. Global numbers (g_shift + 1) to (g_shift + n_g_particles)
+ * are assigned to the new particles, in rank order.
+ *
  * \param[in]   n_g_particles     global number of particles to inject
+ * \param[in]   g_shift           global number shift for injected particles
  * \param[in]   n_elts            number of elements in region
  * \param[in]   elt_id            element ids (or NULL)
  * \param[in]   elt_weight        parent element weights
@@ -144,6 +192,8 @@ _segment_binary_search(cs_lnum_t     n,
  * \param[in]   elt_profile       optional profile values for elements (or NULL)
  * \param[out]  elt_particle_idx  start index of added particles for each
  *                                element (size: n_elts + 1)
+ * \param[out]  p_gnum_s          global number of first particle added
+ *                                on local rank
  *
  * \return  number of particles added on local rank
  */
@@ -151,13 +201,18 @@ _segment_binary_search(cs_lnum_t     n,
 
 static cs_lnum_t
 _distribute_particles(cs_gnum_t         n_g_particles,
+                      cs_gnum_t         g_shift,
                       cs_lnum_t         n_elts,
                       const cs_lnum_t   elt_id[],
                       const cs_real_t   elt_weight[],
                       const cs_real_t  *elt_profile,
-                      cs_lnum_t         elt_particle_idx[])
+                      cs_lnum_t         elt_particle_idx[],
+                      cs_gnum_t        *p_gnum_s)
 {
+  const int nt_cur = cs_glob_time_step->nt_cur;
+
   cs_lnum_t n_particles = (cs_glob_n_ranks > 1) ? 0 : n_g_particles;
+  cs_gnum_t rank_shift = 0;
 
   /* Compute local element weight */
 
@@ -215,15 +270,15 @@ _distribute_particles(cs_gnum_t         n_g_particles,
     int l_rank = cs_glob_rank_id;
     int r_rank = 0; /* Root rank for serialized operations */
 
-    cs_lnum_t  *n_rank_particles = NULL;
+    cs_gnum_t  *n_rank_particles = NULL;
     double     *cm_weight = NULL;
 
     if (l_rank == r_rank) {
 
-      BFT_MALLOC(n_rank_particles, n_ranks, cs_lnum_t);
+      BFT_MALLOC(n_rank_particles, n_ranks*2, cs_gnum_t);
       BFT_MALLOC(cm_weight, n_ranks, double);
 
-      for (int i = 0; i < n_ranks; i++)
+      for (int i = 0; i < n_ranks*2; i++)
         n_rank_particles[i] = 0;
 
     }
@@ -247,27 +302,48 @@ _distribute_particles(cs_gnum_t         n_g_particles,
 
         /* Compute distribution */
 
-        for (cs_gnum_t i = 0; i < n_g_particles; i++) {
-          cs_real_t r;
-          cs_random_uniform(1, &r);
-          int r_id = _segment_binary_search(n_ranks, r, cm_weight);
-          n_rank_particles[r_id] += 1;
+        cs_random_stream_t  rs;
+        cs_random_stream_init(&rs, g_shift + 1, nt_cur,
+                              CS_LAGR_RNG_INJ_RANKS);
+
+        cs_real_t r[_RANDOM_BUFFER_SIZE];
+
+        for (cs_gnum_t i = 0; i < n_g_particles; i += _RANDOM_BUFFER_SIZE) {
+          cs_lnum_t n_r = CS_MIN(n_g_particles - i, _RANDOM_BUFFER_SIZE);
+          cs_random_stream_uniform(&rs, n_r, r);
+          for (cs_lnum_t j = 0; j < n_r; j++) {
+            int r_id = _segment_binary_search(n_ranks, r[j], cm_weight);
+            n_rank_particles[r_id*2] += 1;
+          }
         }
 
       }
 
+      /* Global number shift of particles on each rank */
+
+      for (int i = 1; i < n_ranks; i++)
+        n_rank_particles[i*2 + 1] =   n_rank_particles[(i-1)*2 + 1]
+                                    + n_rank_particles[(i-1)*2];
+
       BFT_FREE(cm_weight);
     }
 
-    MPI_Scatter(n_rank_particles, 1, CS_MPI_LNUM,
-                &n_particles, 1, CS_MPI_LNUM,
+    cs_gnum_t  l_count[2] = {0, 0};
+
+    MPI_Scatter(n_rank_particles, 2, CS_MPI_GNUM,
+                l_count, 2, CS_MPI_GNUM,
                 r_rank, cs_glob_mpi_comm);
 
+    n_particles = l_count[0];
+    rank_shift = l_count[1];
+
     BFT_FREE(n_rank_particles);
   }
 
 #endif /* defined(HAVE_MPI) */
 
+  *p_gnum_s = g_shift + rank_shift + 1;
+
   /* Check for empty zones */
 
   if (n_particles > 0 && n_elts < 1)
@@ -284,11 +360,26 @@ _distribute_particles(cs_gnum_t         n_g_particles,
 
   /* Compute distribution */
 
-  for (cs_lnum_t i = 0; i < n_particles; i++) {
-    cs_real_t r;
-    cs_random_uniform(1, &r);
-    cs_lnum_t e_id = _segment_binary_search(n_elts, r, elt_cm_weight);
-    elt_particle_idx[e_id+1] += 1;
+  if (n_particles > 0) {
+
+    cs_real_t *r;
+    cs_lnum_t *p_elt_id;
+    BFT_MALLOC(r, n_particles, cs_real_t);
+    BFT_MALLOC(p_elt_id, n_particles, cs_lnum_t);
+
+    cs_random_keyed_uniform(n_particles, NULL, *p_gnum_s, nt_cur,
+                            CS_LAGR_RNG_INJ_ELTS, 1, r);
+
+#   pragma omp parallel for if (n_particles > CS_THR_MIN)
+    for (cs_lnum_t i = 0; i < n_particles; i++)
+      p_elt_id[i] = _segment_binary_search(n_elts, r[i], elt_cm_weight);
+
+    for (cs_lnum_t i = 0; i < n_particles; i++)
+      elt_particle_idx[p_elt_id[i] + 1] += 1;
+
+    BFT_FREE(p_elt_id);
+    BFT_FREE(r);
+
   }
 
   BFT_FREE(elt_cm_weight);
@@ -613,6 +704,7 @@ _get_particle_face_ids(cs_lnum_t         n_faces,
  * \param[in]      face_ids          matching face ids if zone is a boundary
  * \param[in]      elt_particle_idx  starting id of new particles for a given
  *                                   element (size: n_elts+1)
+ * \param[in]      p_gnum_s          global number of first new particle
  */
 /*----------------------------------------------------------------------------*/
 
@@ -622,7 +714,8 @@ _init_particles(cs_lagr_particle_set_t         *p_set,
                 int                             time_id,
                 cs_lnum_t                       n_elts,
                 const cs_lnum_t                *face_ids,
-                const cs_lnum_t                 elt_particle_idx[])
+                const cs_lnum_t                 elt_particle_idx[],
+                cs_gnum_t                       p_gnum_s)
 {
   const cs_lagr_attribute_map_t  *p_am = p_set->p_am;
 
@@ -667,8 +760,21 @@ _init_particles(cs_lagr_particle_set_t         *p_set,
 
   const cs_real_t pis6 = cs_math_pi / 6.0;
 
-  /* Loop on zone elements where particles are injected */
+  const int nt_cur = cs_glob_time_step->nt_cur;
+  const cs_lnum_t n_new = elt_particle_idx[n_elts];
+
+  /* Velocity gradient for initial angular velocity of spheroids */
 
+  if (cs_glob_lagr_model->shape == 2)
+    cs_lagr_gradients(0, extra->grad_pr, extra->grad_vel);
+
+  /* Loop on zone elements where particles are injected;
+     random values are drawn from a stream for each particle, so
+     elements may be handled by threads (except when a Fortran
+     enthalpy to temperature conversion is required). */
+
+# pragma omp parallel for schedule(dynamic, 16) \
+                          if (n_new > CS_THR_MIN && cval_h == NULL)
   for (cs_lnum_t li = 0; li < n_elts; li++) {
 
     cs_lnum_t n_e_p = elt_particle_idx[li+1] - elt_particle_idx[li];
@@ -690,10 +796,19 @@ _init_particles(cs_lagr_particle_set_t         *p_set,
       cs_lnum_t cell_id = cs_lagr_particles_get_lnum(p_set, p_id,
                                                      CS_LAGR_CELL_ID);
 
-      /* Random value associated with each particle */
+      cs_random_stream_t  rs;
+      cs_random_stream_init(&rs,
+                            p_gnum_s + (p_id - p_set->n_particles),
+                            nt_cur,
+                            CS_LAGR_RNG_INJ_ATTRIBUTES);
+
+      /* Random value associated with each particle, and value used
+         for the deposition model */
 
-      cs_real_t part_random = -1;
-      cs_random_uniform(1, &part_random);
+      cs_real_t r_u[2];
+      cs_random_stream_uniform(&rs, 2, r_u);
+
+      cs_real_t part_random = r_u[0];
       cs_lagr_particle_set_real(particle, p_am, CS_LAGR_RANDOM_VALUE,
                                 part_random);
 
@@ -800,10 +915,10 @@ _init_particles(cs_lagr_particle_set_t         *p_set,
           }
 
           /* Compute orientation from uniform orientation on a unit-sphere */
-          cs_real_t theta0 ;
-          cs_real_t phi0 ;
-          cs_random_uniform(1, &theta0) ;
-          cs_random_uniform(1, &phi0) ;
+          cs_real_t r_o[2];
+          cs_random_stream_uniform(&rs, 2, r_o);
+          cs_real_t theta0 = r_o[0];
+          cs_real_t phi0 = r_o[1];
           theta0   = acos(2.0*theta0-1.0) ;
           phi0     = phi0*2.0*cs_math_pi ;
           orientation[0] = sin(theta0)*cos(phi0) ;
@@ -826,18 +941,14 @@ _init_particles(cs_lagr_particle_set_t         *p_set,
           cs_real_t trans_m[3][3];
           // Generate the first two vectors
           for (cs_lnum_t id = 0; id < 3; id++) {
-            cs_random_uniform(1, &trans_m[id][0]); /* (?,0) */
-            cs_random_uniform(1, &trans_m[id][1]); /* (?,1) */
-            cs_random_uniform(1, &trans_m[id][2]); /* (?,2) */
+            cs_random_stream_uniform(&rs, 3, trans_m[id]);
             cs_real_3_t loc_vector =  {-1.+2*trans_m[id][0],
               -1.+2*trans_m[id][1],
               -1.+2*trans_m[id][2]};
             cs_real_t norm_trans_m = cs_math_3_norm( loc_vector );
             while ( norm_trans_m > 1 )
             {
-              cs_random_uniform(1, &trans_m[id][0]); /* (?,0) */
-              cs_random_uniform(1, &trans_m[id][1]); /* (?,1) */
-              cs_random_uniform(1, &trans_m[id][2]); /* (?,2) */
+              cs_random_stream_uniform(&rs, 3, trans_m[id]);
               loc_vector[0] = -1.+2*trans_m[id][0];
               loc_vector[1] = -1.+2*trans_m[id][1];
               loc_vector[2] = -1.+2*trans_m[id][2];
@@ -877,7 +988,7 @@ _init_particles(cs_lagr_particle_set_t         *p_set,
 
           // Write Euler angles
           cs_real_t random;
-          cs_random_uniform(1, &random);
+          cs_random_stream_uniform(&rs, 1, &random);
           if (random >= 0.5)
             euler[0] = pow(0.25*(trans_m[0][0]+trans_m[1][1]+trans_m[2][2]+1.),
                            0.5);
@@ -889,8 +1000,6 @@ _init_particles(cs_lagr_particle_set_t         *p_set,
           euler[3] = 0.25 * (trans_m[1][0] - trans_m[0][1]) / euler[0];
 
           /* Compute initial angular velocity */
-          // Get velocity gradient
-          cs_lagr_gradients(0, extra->grad_pr, extra->grad_vel);
           // Local reference frame
           cs_real_t grad_vf_r[3][3];
           cs_math_33_transform_a_to_r(extra->grad_vel[cell_id],
@@ -919,7 +1028,7 @@ _init_particles(cs_lagr_particle_set_t         *p_set,
 
         for (i_r = 0; i_r < 20; i_r++) {
           double    random;
-          cs_random_normal(1, &random);
+          cs_random_stream_normal(&rs, 1, &random);
 
           cs_real_t diam =   zis->diameter
                            + random * zis->diameter_variance;
@@ -1077,10 +1186,8 @@ _init_particles(cs_lagr_particle_set_t         *p_set,
 
       if (cs_glob_lagr_model->deposition == 1) {
 
-        cs_real_t random;
-        cs_random_uniform(1, &random);
         cs_lagr_particle_set_real(particle, p_am,
-                                  CS_LAGR_INTERF, 5.0 + 15.0 * random);
+                                  CS_LAGR_INTERF, 5.0 + 15.0 * r_u[1]);
         cs_lagr_particle_set_real(particle, p_am,
                                   CS_LAGR_YPLUS, 1000.0);
         cs_lagr_particle_set_lnum(particle, p_am,
@@ -1409,6 +1516,9 @@ cs_lagr_injection(int        time_id,
        (unsigned long long)n_g_particles_next,
        (unsigned long long)(cs_lagr_get_n_g_particles_max()));
 
+    _n_injected = 0;
+    _injection_wtime = 0.;
+
     return;
 
   }
@@ -1416,9 +1526,21 @@ cs_lagr_injection(int        time_id,
   /* Now inject new particles
      ------------------------ */
 
-  cs_lnum_t n_elts_m = CS_MAX(mesh->n_b_faces, mesh->n_cells);
-  cs_lnum_t *elt_particle_idx = NULL;
-  BFT_MALLOC(elt_particle_idx, n_elts_m+1, cs_lnum_t);
+  int t_stat_id = cs_timer_stats_id_by_name("particle_injection_stage");
+  int t_top_id = cs_timer_stats_switch(t_stat_id);
+
+  double t_start = cs_timer_wtime();
+
+  /* First pass: distribute particles of all active injection sets,
+     so that the particle set is resized only once; the global number
+     of each new particle is used as a key for random streams, so results
+     do not depend on the number of threads. */
+
+  int n_batches = 0, n_batches_max = 0;
+  _injection_batch_t *batches = NULL;
+
+  cs_gnum_t g_shift = pc->n_g_cumulative_total;
+  cs_lnum_t n_inject_tot = 0, n_inject_max = 0;
 
   /* Loop in injection type (boundary, volume) */
 
@@ -1492,211 +1614,289 @@ cs_lagr_injection(int        time_id,
                                       elt_profile);
         }
 
-        cs_lnum_t n_inject = _distribute_particles(zis->n_inject,
-                                                   n_z_elts,
-                                                   z_elt_ids,
-                                                   elt_weight,
-                                                   elt_profile,
-                                                   elt_particle_idx);
+        if (n_batches >= n_batches_max) {
+          n_batches_max = CS_MAX(n_batches_max*2, 4);
+          BFT_REALLOC(batches, n_batches_max, _injection_batch_t);
+        }
+
+        _injection_batch_t *batch = batches + n_batches;
+        n_batches += 1;
+
+        batch->zis = zis;
+        batch->n_elts = n_z_elts;
+        batch->elt_ids = z_elt_ids;
+        BFT_MALLOC(batch->elt_particle_idx, n_z_elts+1, cs_lnum_t);
+
+        batch->n_inject = _distribute_particles(zis->n_inject,
+                                                g_shift,
+                                                n_z_elts,
+                                                z_elt_ids,
+                                                elt_weight,
+                                                elt_profile,
+                                                batch->elt_particle_idx,
+                                                &(batch->p_gnum_s));
 
         BFT_FREE(elt_profile);
 
-        if (cs_lagr_particle_set_resize(p_set->n_particles + n_inject) < 0)
-          bft_error(__FILE__, __LINE__, 0,
-                    "Lagrangian module internal error: \n"
-                    "  resizing of particle set impossible but previous\n"
-                    "  size computation did not detect this issue.");
+        g_shift += (cs_gnum_t)(zis->n_inject);
+        n_inject_tot += batch->n_inject;
+        n_inject_max = CS_MAX(n_inject_max, batch->n_inject);
 
-        /* Define particle coordinates and place on faces/cells */
+      } /* end of loop on sets */
 
-        if (zis->location_id == CS_MESH_LOCATION_BOUNDARY_FACES)
-          cs_lagr_new(p_set,
-                      n_z_elts,
-                      z_elt_ids,
-                      elt_particle_idx);
-        else
-          cs_lagr_new_v(p_set,
-                        n_z_elts,
-                        z_elt_ids,
-                        elt_particle_idx);
+    } /* end of loop on zones */
 
-        BFT_FREE(elt_profile);
+  } /* end of loop on zone types (boundary/volume) */
 
-        /* Initialize other particle attributes */
+  if (cs_lagr_particle_set_resize(p_set->n_particles + n_inject_tot) < 0)
+    bft_error(__FILE__, __LINE__, 0,
+              "Lagrangian module internal error: \n"
+              "  resizing of particle set impossible but previous\n"
+              "  size computation did not detect this issue.");
 
-        _init_particles(p_set,
-                        zis,
-                        time_id,
-                        n_z_elts,
-                        z_elt_ids,
-                        elt_particle_idx);
+  /* Random values buffer for positions, velocity seen
+     and deposition model (at most 5 values per particle) */
 
-        assert(n_inject == elt_particle_idx[n_z_elts]);
+  cs_real_t *r_buf = NULL;
+  BFT_MALLOC(r_buf, n_inject_max*5, cs_real_t);
 
-        cs_lnum_t particle_range[2] = {p_set->n_particles,
-                                       p_set->n_particles + n_inject};
+  /* Second pass: generate particles for each batch */
 
-        cs_lagr_new_particle_init(particle_range,
-                                  time_id,
-                                  visc_length);
+  for (int b_id = 0; b_id < n_batches; b_id++) {
 
-        /* Advanced user modification:
+    _injection_batch_t *batch = batches + b_id;
 
-           WARNING: the user may change the particle coordinates but is
-           prevented from changing the previous location (otherwise, if
-           the particle is not in the same cell anymore, it would be lost).
+    const cs_lagr_injection_set_t *zis = batch->zis;
 
-           Moreover, a precaution has to be taken when calling
-           "current to previous" in the tracking stage.
-        */
+    cs_lagr_zone_data_t *zd
+      = (zis->location_id == CS_MESH_LOCATION_BOUNDARY_FACES) ?
+        zda[0] : zda[1];
+    const int z_id = zis->zone_id;
 
-        {
-          cs_lnum_t *particle_face_ids = NULL;
+    const cs_lnum_t n_inject = batch->n_inject;
+    const cs_lnum_t n_z_elts = batch->n_elts;
+    const cs_lnum_t *z_elt_ids = batch->elt_ids;
+    const cs_lnum_t *elt_particle_idx = batch->elt_particle_idx;
 
-          if (zis->location_id == CS_MESH_LOCATION_BOUNDARY_FACES)
-            particle_face_ids = _get_particle_face_ids(n_z_elts,
-                                                       z_elt_ids,
-                                                       elt_particle_idx);
+    /* Define particle coordinates and place on faces/cells */
 
-          cs_lnum_t *saved_cell_id;
-          cs_real_3_t *saved_coords;
-          BFT_MALLOC(saved_cell_id, n_inject, cs_lnum_t);
-          BFT_MALLOC(saved_coords, n_inject, cs_real_3_t);
+    if (zis->location_id == CS_MESH_LOCATION_BOUNDARY_FACES) {
+      cs_random_keyed_uniform(n_inject, NULL, batch->p_gnum_s, ts->nt_cur,
+                              CS_LAGR_RNG_INJ_POSITION, 3, r_buf);
+      cs_lagr_new_rand(p_set,
+                       n_z_elts,
+                       z_elt_ids,
+                       elt_particle_idx,
+                       r_buf);
+    }
+    else {
+      cs_random_keyed_uniform(n_inject, NULL, batch->p_gnum_s, ts->nt_cur,
+                              CS_LAGR_RNG_INJ_POSITION, 5, r_buf);
+      cs_lagr_new_v_rand(p_set,
+                         n_z_elts,
+                         z_elt_ids,
+                         elt_particle_idx,
+                         r_buf);
+    }
 
-          for (cs_lnum_t i = 0; i < n_inject; i++) {
-            cs_lnum_t p_id = particle_range[0] + i;
+    /* Initialize other particle attributes */
 
-            saved_cell_id[i] = cs_lagr_particles_get_lnum(p_set,
-                                                           p_id,
-                                                           CS_LAGR_CELL_ID);
-            const cs_real_t *p_coords
-              = cs_lagr_particles_attr_const(p_set,
-                                             p_id,
-                                             CS_LAGR_COORDS);
-            for (cs_lnum_t j = 0; j < 3; j++)
-              saved_coords[i][j] = p_coords[j];
-          }
+    _init_particles(p_set,
+                    zis,
+                    time_id,
+                    n_z_elts,
+                    z_elt_ids,
+                    elt_particle_idx,
+                    batch->p_gnum_s);
 
-          cs_user_lagr_in(p_set,
-                          zis,
-                          particle_range,
-                          particle_face_ids,
-                          visc_length);
+    assert(n_inject == elt_particle_idx[n_z_elts]);
 
-          /* For safety, build values at previous time step, but reset saved values
-             for previous cell number and particle coordinates */
+    cs_lnum_t particle_range[2] = {p_set->n_particles,
+                                   p_set->n_particles + n_inject};
 
-          for (cs_lnum_t i = 0; i < n_inject; i++) {
-            cs_lnum_t p_id = particle_range[0] + i;
+    cs_real_t *r_n = NULL, *r_u = NULL;
 
-            cs_lagr_particles_current_to_previous(p_set, p_id);
+    if (cs_glob_lagr_model->idistu == 1) {
+      r_n = r_buf;
+      cs_random_keyed_normal(n_inject, NULL, batch->p_gnum_s, ts->nt_cur,
+                             CS_LAGR_RNG_INJ_VEL_SEEN, 3, r_n);
+    }
+    if (cs_glob_lagr_model->deposition == 1) {
+      r_u = r_buf + n_inject*3;
+      cs_random_keyed_uniform(n_inject, NULL, batch->p_gnum_s, ts->nt_cur,
+                              CS_LAGR_RNG_INJ_DEPOSITION, 1, r_u);
+    }
 
-            cs_lagr_particles_set_lnum_n(p_set,
-                                         p_id,
-                                         1,
-                                         CS_LAGR_CELL_ID,
-                                         saved_cell_id[i]);
-            cs_real_t *p_coords_prev
-              = cs_lagr_particles_attr_n(p_set,
-                                         p_id,
-                                         1,
-                                         CS_LAGR_COORDS);
-            for (cs_lnum_t j = 0; j < 3; j++)
-              p_coords_prev[j] = saved_coords[i][j];
-          }
+    cs_lagr_new_particle_init_rand(particle_range,
+                                   time_id,
+                                   visc_length,
+                                   r_n,
+                                   r_u);
 
-          BFT_FREE(saved_coords);
-          BFT_FREE(saved_cell_id);
+    /* Advanced user modification:
 
-          /* Add particle tracking events for boundary injection */
+       WARNING: the user may change the particle coordinates but is
+       prevented from changing the previous location (otherwise, if
+       the particle is not in the same cell anymore, it would be lost).
 
-          if (   particle_face_ids != NULL
-              && cs_lagr_stat_is_active(CS_LAGR_STAT_GROUP_TRACKING_EVENT)) {
+       Moreover, a precaution has to be taken when calling
+       "current to previous" in the tracking stage.
+    */
 
-            cs_lagr_event_set_t  *events
-              = cs_lagr_event_set_boundary_interaction();
+    {
+      cs_lnum_t *particle_face_ids = NULL;
 
-            /* Event set "expected" size: n boundary faces*2 */
-            cs_lnum_t events_min_size = mesh->n_b_faces * 2;
-            if (events->n_events_max < events_min_size)
-              cs_lagr_event_set_resize(events, events_min_size);
+      if (zis->location_id == CS_MESH_LOCATION_BOUNDARY_FACES)
+        particle_face_ids = _get_particle_face_ids(n_z_elts,
+                                                   z_elt_ids,
+                                                   elt_particle_idx);
 
-            for (cs_lnum_t i = 0; i < n_inject; i++) {
-              cs_lnum_t p_id = particle_range[0] + i;
+      cs_lnum_t *saved_cell_id;
+      cs_real_3_t *saved_coords;
+      BFT_MALLOC(saved_cell_id, n_inject, cs_lnum_t);
+      BFT_MALLOC(saved_coords, n_inject, cs_real_3_t);
 
-              cs_lnum_t event_id = events->n_events;
-              events->n_events += 1;
+#     pragma omp parallel for if (n_inject > CS_THR_MIN)
+      for (cs_lnum_t i = 0; i < n_inject; i++) {
+        cs_lnum_t p_id = particle_range[0] + i;
 
-              if (event_id >= events->n_events_max) {
-                /* flush events */
-                cs_lagr_stat_update_event(events,
-                                          CS_LAGR_STAT_GROUP_TRACKING_EVENT);
-                events->n_events = 0;
-                event_id = 0;
-              }
+        saved_cell_id[i] = cs_lagr_particles_get_lnum(p_set,
+                                                       p_id,
+                                                       CS_LAGR_CELL_ID);
+        const cs_real_t *p_coords
+          = cs_lagr_particles_attr_const(p_set,
+                                         p_id,
+                                         CS_LAGR_COORDS);
+        for (cs_lnum_t j = 0; j < 3; j++)
+          saved_coords[i][j] = p_coords[j];
+      }
 
-              cs_lagr_event_init_from_particle(events, p_set, event_id, p_id);
+      cs_user_lagr_in(p_set,
+                      zis,
+                      particle_range,
+                      particle_face_ids,
+                      visc_length);
+
+      /* For safety, build values at previous time step, but reset saved values
+         for previous cell number and particle coordinates */
+
+#     pragma omp parallel for if (n_inject > CS_THR_MIN)
+      for (cs_lnum_t i = 0; i < n_inject; i++) {
+        cs_lnum_t p_id = particle_range[0] + i;
+
+        cs_lagr_particles_current_to_previous(p_set, p_id);
+
+        cs_lagr_particles_set_lnum_n(p_set,
+                                     p_id,
+                                     1,
+                                     CS_LAGR_CELL_ID,
+                                     saved_cell_id[i]);
+        cs_real_t *p_coords_prev
+          = cs_lagr_particles_attr_n(p_set,
+                                     p_id,
+                                     1,
+                                     CS_LAGR_COORDS);
+        for (cs_lnum_t j = 0; j < 3; j++)
+          p_coords_prev[j] = saved_coords[i][j];
+      }
 
-              cs_lnum_t face_id = particle_face_ids[i];
-              cs_lagr_events_set_lnum(events,
-                                      event_id,
-                                      CS_LAGR_E_FACE_ID,
-                                      face_id);
+      BFT_FREE(saved_coords);
+      BFT_FREE(saved_cell_id);
 
-              cs_lnum_t *e_flag = cs_lagr_events_attr(events,
-                                                      event_id,
-                                                      CS_LAGR_E_FLAG);
+      /* Add particle tracking events for boundary injection */
 
-              *e_flag = *e_flag | CS_EVENT_INFLOW;
+      if (   particle_face_ids != NULL
+          && cs_lagr_stat_is_active(CS_LAGR_STAT_GROUP_TRACKING_EVENT)) {
 
-            }
+        cs_lagr_event_set_t  *events
+          = cs_lagr_event_set_boundary_interaction();
+
+        /* Event set "expected" size: n boundary faces*2 */
+        cs_lnum_t events_min_size = mesh->n_b_faces * 2;
+        if (events->n_events_max < events_min_size)
+          cs_lagr_event_set_resize(events, events_min_size);
+
+        for (cs_lnum_t i = 0; i < n_inject; i++) {
+          cs_lnum_t p_id = particle_range[0] + i;
+
+          cs_lnum_t event_id = events->n_events;
+          events->n_events += 1;
 
+          if (event_id >= events->n_events_max) {
+            /* flush events */
+            cs_lagr_stat_update_event(events,
+                                      CS_LAGR_STAT_GROUP_TRACKING_EVENT);
+            events->n_events = 0;
+            event_id = 0;
           }
 
-          BFT_FREE(particle_face_ids);
+          cs_lagr_event_init_from_particle(events, p_set, event_id, p_id);
+
+          cs_lnum_t face_id = particle_face_ids[i];
+          cs_lagr_events_set_lnum(events,
+                                  event_id,
+                                  CS_LAGR_E_FACE_ID,
+                                  face_id);
+
+          cs_lnum_t *e_flag = cs_lagr_events_attr(events,
+                                                  event_id,
+                                                  CS_LAGR_E_FLAG);
+
+          *e_flag = *e_flag | CS_EVENT_INFLOW;
 
         }
 
-        /* check some particle attributes consistency */
+      }
 
-        _check_particles(p_set, zis, n_z_elts, elt_particle_idx);
+      BFT_FREE(particle_face_ids);
 
-        /* update counters and balances */
+    }
 
-        cs_real_t z_weight = 0.;
+    /* check some particle attributes consistency */
 
-        for (cs_lnum_t p_id = particle_range[0];
-             p_id < particle_range[1];
-             p_id++) {
-          cs_real_t s_weight = cs_lagr_particles_get_real(p_set, p_id,
-                                                          CS_LAGR_STAT_WEIGHT);
-          cs_real_t flow_rate = (  s_weight
-                                 * cs_lagr_particles_get_real(p_set, p_id,
-                                                              CS_LAGR_MASS));
+    _check_particles(p_set, zis, n_z_elts, elt_particle_idx);
 
-          zd->particle_flow_rate[z_id*n_stats] += flow_rate;
+    /* update counters and balances */
 
-          if (n_stats > 1) {
-            int class_id = cs_lagr_particles_get_lnum(p_set, p_id,
-                                                      CS_LAGR_STAT_CLASS);
-            if (class_id > 0 && class_id < n_stats)
-              zd->particle_flow_rate[z_id*n_stats + class_id] += flow_rate;
-          }
+    cs_real_t z_weight = 0.;
 
-          z_weight += s_weight;
-        }
+    for (cs_lnum_t p_id = particle_range[0];
+         p_id < particle_range[1];
+         p_id++) {
+      cs_real_t s_weight = cs_lagr_particles_get_real(p_set, p_id,
+                                                      CS_LAGR_STAT_WEIGHT);
+      cs_real_t flow_rate = (  s_weight
+                             * cs_lagr_particles_get_real(p_set, p_id,
+                                                          CS_LAGR_MASS));
 
-        p_set->n_particles += n_inject;
-        p_set->n_part_new += n_inject;
-        p_set->weight_new += z_weight;
+      zd->particle_flow_rate[z_id*n_stats] += flow_rate;
 
-      } /* end of loop on sets */
+      if (n_stats > 1) {
+        int class_id = cs_lagr_particles_get_lnum(p_set, p_id,
+                                                  CS_LAGR_STAT_CLASS);
+        if (class_id > 0 && class_id < n_stats)
+          zd->particle_flow_rate[z_id*n_stats + class_id] += flow_rate;
+      }
 
-    } /* end of loop on zones */
+      z_weight += s_weight;
+    }
 
-  } /* end of loop on zone types (boundary/volume) */
+    p_set->n_particles += n_inject;
+    p_set->n_part_new += n_inject;
+    p_set->cell_sorted = false;
+    p_set->weight_new += z_weight;
+
+    BFT_FREE(batch->elt_particle_idx);
 
-  BFT_FREE(elt_particle_idx);
+  } /* end of loop on batches */
+
+  BFT_FREE(r_buf);
+  BFT_FREE(batches);
+
+  _n_injected = n_inject_tot;
+  _injection_wtime = cs_timer_wtime() - t_start;
+
+  cs_timer_stats_switch(t_top_id);
 
   /* Update global particle counters */
 
@@ -1704,6 +1904,26 @@ cs_lagr_injection(int        time_id,
   pc->n_g_total += pc->n_g_new;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return local number of particles injected and elapsed time
+ *        at the last call to \ref cs_lagr_injection.
+ *
+ * \param[out]  n_injected  local number of injected particles, or NULL
+ * \param[out]  wtime       elapsed (wall-clock) time, or NULL
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_injection_get_stats(cs_lnum_t  *n_injected,
+                            double     *wtime)
+{
+  if (n_injected != NULL)
+    *n_injected = _n_injected;
+  if (wtime != NULL)
+    *wtime = _injection_wtime;
+}
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
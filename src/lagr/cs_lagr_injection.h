@@ -59,6 +59,20 @@ cs_lagr_injection(int        time_id,
                   const int  itypfb[],
                   cs_real_t  visc_length[]);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return local number of particles injected and elapsed time
+ *        at the last call to \ref cs_lagr_injection.
+ *
+ * \param[out]  n_injected  local number of injected particles, or NULL
+ * \param[out]  wtime       elapsed (wall-clock) time, or NULL
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_injection_get_stats(cs_lnum_t  *n_injected,
+                            double     *wtime);
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -57,6 +57,7 @@
 #include "cs_field.h"
 
 #include "cs_lagr.h"
+#include "cs_lagr_injection.h"
 #include "cs_lagr_particle.h"
 #include "cs_lagr_tracking.h"
 #include "cs_lagr_post.h"
@@ -598,6 +599,24 @@ cs_lagr_log_iteration(void)
      (unsigned long long)(pc->n_g_new),
      pc->w_new);
 
+  /* Injection throughput (based on slowest rank) */
+
+  {
+    cs_lnum_t n_injected = 0;
+    double wtime = 0.;
+    cs_lagr_injection_get_stats(&n_injected, &wtime);
+
+    cs_gnum_t n_g_injected = n_injected;
+    cs_parall_counter(&n_g_injected, 1);
+    cs_parall_max(1, CS_DOUBLE, &wtime);
+
+    if (n_g_injected > 0 && wtime > 0.)
+      cs_log_printf
+        (CS_LOG_DEFAULT,
+         _("ln  injection rate (particles/s)                        %14.5E\n"),
+         (double)n_g_injected / wtime);
+  }
+
   if (cs_glob_lagr_model->physical_model == CS_LAGR_PHYS_COAL && cs_glob_lagr_model->fouling == 1)
     cs_log_printf
       (CS_LOG_DEFAULT,
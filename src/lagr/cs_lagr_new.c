@@ -208,6 +208,7 @@ _face_sub_surfaces(cs_lnum_t        n_vertices,
  * \param[in]   acc_surf_r     accumulated surface ratio associated to
  *                             each edge (or negative edge lengths in
  *                             degenerate cases)
+ * \param[in]   r_u            uniform random values in [0, 1] (size: 3)
  * \param[out]  coords         coordinates of point in face
  */
 /*----------------------------------------------------------------------------*/
@@ -218,15 +219,14 @@ _random_point_in_face(cs_lnum_t        n_vertices,
                       const cs_real_t  vertex_coords[][3],
                       const cs_real_t  face_center[3],
                       const cs_real_t  acc_surf_r[],
+                      const cs_real_t  r_u[3],
                       cs_real_t        coords[3])
 {
   cs_lnum_t tri_id = 0;
-  cs_real_t r[3];
+  cs_real_t r[3] = {r_u[0], r_u[1], r_u[2]};
 
   /* determine triangle to choose */
 
-  cs_random_uniform(3, r);
-
   if (r[2] > 1) /* account for possible ? rounding errors */
     r[2] = 1;
 
@@ -303,76 +303,129 @@ cs_lagr_new(cs_lagr_particle_set_t  *particles,
             cs_lnum_t                n_faces,
             const cs_lnum_t          face_ids[],
             const cs_lnum_t          face_particle_idx[])
+{
+  cs_lagr_new_rand(particles, n_faces, face_ids, face_particle_idx, NULL);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Inject a series of particles at random positions on given faces,
+ * using given random values.
+ *
+ * The fluid velocity and other variables and attributes are computed here.
+ *
+ * Random values may be provided by the caller (for example using
+ * counter-based streams, so that they do not depend on the number of
+ * threads); if NULL, they are drawn from the global generator.
+ * Faces are then handled by threads.
+ *
+ * \param[in,out]  particles          pointer to particle set
+ * \param[in]      n_faces            number of faces in zone
+ * \param[in]      face_ids           ids of faces in zone
+ * \param[in]      face_particle_idx  starting index of added particles
+ *                                    for each face in zone
+ * \param[in]      r                  uniform random values in [0, 1],
+ *                                    3 per added particle, or NULL
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_new_rand(cs_lagr_particle_set_t  *particles,
+                 cs_lnum_t                n_faces,
+                 const cs_lnum_t          face_ids[],
+                 const cs_lnum_t          face_particle_idx[],
+                 const cs_real_t          r[])
 {
   const double d_eps = 1e-3;
 
   cs_mesh_t  *mesh = cs_glob_mesh;
   cs_mesh_quantities_t *fvq  = cs_glob_mesh_quantities;
 
-  cs_real_t  *acc_surf_r = NULL;
-  cs_lnum_t   n_vertices_max = 0;
+  const cs_lnum_t n_new = face_particle_idx[n_faces];
+
+  /* Use global generator if random values are not provided */
+
+  const cs_real_t *_r = r;
+  cs_real_t *r_g = NULL;
+
+  if (r == NULL && n_new > 0) {
+    BFT_MALLOC(r_g, n_new*3, cs_real_t);
+    cs_random_uniform(n_new*3, r_g);
+    _r = r_g;
+  }
 
   /* Loop on faces */
 
-  for (cs_lnum_t li = 0; li < n_faces; li++) {
+# pragma omp parallel if (n_new > CS_THR_MIN)
+  {
+    cs_real_t  *acc_surf_r = NULL;
+    cs_lnum_t   n_vertices_max = 0;
 
-    cs_lnum_t n_f_p = face_particle_idx[li+1] - face_particle_idx[li];
+#   pragma omp for schedule(dynamic, 16)
+    for (cs_lnum_t li = 0; li < n_faces; li++) {
 
-    if (n_f_p < 1)
-      continue;
+      cs_lnum_t n_f_p = face_particle_idx[li+1] - face_particle_idx[li];
 
-    cs_lnum_t p_s_id = particles->n_particles + face_particle_idx[li];
+      if (n_f_p < 1)
+        continue;
 
-    const cs_lnum_t face_id = (face_ids != NULL) ? face_ids[li] : li;
+      cs_lnum_t p_s_id = particles->n_particles + face_particle_idx[li];
+      const cs_real_t *r_f = _r + 3*face_particle_idx[li];
 
-    cs_lnum_t n_vertices =   mesh->b_face_vtx_idx[face_id+1]
-                           - mesh->b_face_vtx_idx[face_id];
+      const cs_lnum_t face_id = (face_ids != NULL) ? face_ids[li] : li;
 
-    const cs_lnum_t *vertex_ids =   mesh->b_face_vtx_lst
-                                  + mesh->b_face_vtx_idx[face_id];
+      cs_lnum_t n_vertices =   mesh->b_face_vtx_idx[face_id+1]
+                             - mesh->b_face_vtx_idx[face_id];
 
-    if (n_vertices > n_vertices_max) {
-      n_vertices_max = n_vertices*2;
-      BFT_REALLOC(acc_surf_r, n_vertices_max, cs_real_t);
-    }
+      const cs_lnum_t *vertex_ids =   mesh->b_face_vtx_lst
+                                    + mesh->b_face_vtx_idx[face_id];
 
-    _face_sub_surfaces(n_vertices,
-                       vertex_ids,
-                       (const cs_real_3_t *)mesh->vtx_coord,
-                       fvq->b_face_cog + 3*face_id,
-                       acc_surf_r);
+      if (n_vertices > n_vertices_max) {
+        n_vertices_max = n_vertices*2;
+        BFT_REALLOC(acc_surf_r, n_vertices_max, cs_real_t);
+      }
+
+      _face_sub_surfaces(n_vertices,
+                         vertex_ids,
+                         (const cs_real_3_t *)mesh->vtx_coord,
+                         fvq->b_face_cog + 3*face_id,
+                         acc_surf_r);
 
-    /* distribute new particles */
+      /* distribute new particles */
 
-    cs_lnum_t c_id = mesh->b_face_cells[face_id];
-    const cs_real_t *c_cen = fvq->cell_cen + c_id*3;
+      cs_lnum_t c_id = mesh->b_face_cells[face_id];
+      const cs_real_t *c_cen = fvq->cell_cen + c_id*3;
 
-    for (cs_lnum_t i = 0; i < n_f_p; i++) {
+      for (cs_lnum_t i = 0; i < n_f_p; i++) {
 
-      cs_lnum_t p_id = p_s_id + i;
+        cs_lnum_t p_id = p_s_id + i;
 
-      cs_lagr_particles_set_lnum(particles, p_id, CS_LAGR_CELL_ID, c_id);
+        cs_lagr_particles_set_lnum(particles, p_id, CS_LAGR_CELL_ID, c_id);
 
-      cs_real_t *part_coord
-        = cs_lagr_particles_attr(particles, p_id, CS_LAGR_COORDS);
+        cs_real_t *part_coord
+          = cs_lagr_particles_attr(particles, p_id, CS_LAGR_COORDS);
 
-      _random_point_in_face(n_vertices,
-                            vertex_ids,
-                            (const cs_real_3_t *)mesh->vtx_coord,
-                            fvq->b_face_cog + 3*face_id,
-                            acc_surf_r,
-                            part_coord);
+        _random_point_in_face(n_vertices,
+                              vertex_ids,
+                              (const cs_real_3_t *)mesh->vtx_coord,
+                              fvq->b_face_cog + 3*face_id,
+                              acc_surf_r,
+                              r_f + 3*i,
+                              part_coord);
 
-      /* For safety, move particle slightly inside cell */
+        /* For safety, move particle slightly inside cell */
 
-      for (cs_lnum_t j = 0; j < 3; j++)
-        part_coord[j] += (c_cen[j] - part_coord[j])*d_eps;
+        for (cs_lnum_t j = 0; j < 3; j++)
+          part_coord[j] += (c_cen[j] - part_coord[j])*d_eps;
+
+      }
 
     }
 
+    BFT_FREE(acc_surf_r);
   }
 
-  BFT_FREE(acc_surf_r);
+  BFT_FREE(r_g);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -396,6 +449,40 @@ cs_lagr_new_v(cs_lagr_particle_set_t  *particles,
               cs_lnum_t                n_cells,
               const cs_lnum_t          cell_ids[],
               const cs_lnum_t          cell_particle_idx[])
+{
+  cs_lagr_new_v_rand(particles, n_cells, cell_ids, cell_particle_idx, NULL);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Inject a series of particles at random positions on given cells,
+ * using given random values.
+ *
+ * \warning Currently works only for tri and quadrangular faces.
+ *
+ * The fluid velocity and other variables and attributes are computed here.
+ *
+ * Random values may be provided by the caller (for example using
+ * counter-based streams, so that they do not depend on the number of
+ * threads); if NULL, they are drawn from the global generator.
+ * Cells are then handled by threads.
+ *
+ * \param[in,out]  particles          pointer to particle set
+ * \param[in]      n_cells            number of cells in zone
+ * \param[in]      cell_ids           ids of cells in zone
+ * \param[in]      cell_particle_idx  starting index of added particles
+ *                                    for each cell in zone
+ * \param[in]      r                  uniform random values in [0, 1],
+ *                                    5 per added particle, or NULL
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_new_v_rand(cs_lagr_particle_set_t  *particles,
+                   cs_lnum_t                n_cells,
+                   const cs_lnum_t          cell_ids[],
+                   const cs_lnum_t          cell_particle_idx[],
+                   const cs_real_t          r[])
 {
   const double w_eps = 1e-24;
   const double d_eps = 1e-3;
@@ -408,217 +495,239 @@ cs_lagr_new_v(cs_lagr_particle_set_t  *particles,
   cs_lagr_get_cell_face_connectivity(&cell_face_idx,
                                      &cell_face_lst);
 
-  cs_lnum_t  *cell_subface_index = NULL;
-  cs_real_t  *acc_vol_r = NULL;
-  cs_real_t  *acc_surf_r = NULL;
-  cs_lnum_t  n_divisions_max = 0, n_faces_max = 0;
+  const cs_lnum_t n_new = cell_particle_idx[n_cells];
+
+  /* Use global generator if random values are not provided */
+
+  const cs_real_t *_r = r;
+  cs_real_t *r_g = NULL;
+
+  if (r == NULL && n_new > 0) {
+    BFT_MALLOC(r_g, n_new*5, cs_real_t);
+    cs_random_uniform(n_new*5, r_g);
+    _r = r_g;
+  }
 
   /* Loop on cells */
 
-  for (cs_lnum_t li = 0; li < n_cells; li++) {
+# pragma omp parallel if (n_new > CS_THR_MIN)
+  {
+    cs_lnum_t  *cell_subface_index = NULL;
+    cs_real_t  *acc_vol_r = NULL;
+    cs_real_t  *acc_surf_r = NULL;
+    cs_lnum_t  n_divisions_max = 0, n_faces_max = 0;
 
-    cs_lnum_t n_c_p = cell_particle_idx[li+1] - cell_particle_idx[li];
+#   pragma omp for schedule(dynamic, 16)
+    for (cs_lnum_t li = 0; li < n_cells; li++) {
 
-    if (n_c_p < 1) /* ignore cells with no injected particles */
-      continue;
+      cs_lnum_t n_c_p = cell_particle_idx[li+1] - cell_particle_idx[li];
 
-    cs_lnum_t p_s_id = particles->n_particles +  cell_particle_idx[li];
+      if (n_c_p < 1) /* ignore cells with no injected particles */
+        continue;
 
-    const cs_lnum_t cell_id = (cell_ids != NULL) ? cell_ids[li] : li;
-    const cs_lnum_t n_cell_faces = cell_face_idx[cell_id+1] - cell_face_idx[cell_id];
+      cs_lnum_t p_s_id = particles->n_particles +  cell_particle_idx[li];
+      const cs_real_t *r_c = _r + 5*cell_particle_idx[li];
 
-    const cs_real_t *cell_cen = fvq->cell_cen + cell_id*3;
+      const cs_lnum_t cell_id = (cell_ids != NULL) ? cell_ids[li] : li;
+      const cs_lnum_t n_cell_faces =   cell_face_idx[cell_id+1]
+                                     - cell_face_idx[cell_id];
 
-    if (n_cell_faces > n_faces_max) {
-      n_faces_max = n_cell_faces*2;
-      BFT_REALLOC(cell_subface_index, n_faces_max+1, cs_lnum_t);
-      BFT_REALLOC(acc_vol_r, n_faces_max, cs_real_t);
-    }
+      const cs_real_t *cell_cen = fvq->cell_cen + cell_id*3;
 
-    cell_subface_index[0] = 0;
+      if (n_cell_faces > n_faces_max) {
+        n_faces_max = n_cell_faces*2;
+        BFT_REALLOC(cell_subface_index, n_faces_max+1, cs_lnum_t);
+        BFT_REALLOC(acc_vol_r, n_faces_max, cs_real_t);
+      }
 
-    /* Loop on cell faces to determine volumes */
+      cell_subface_index[0] = 0;
 
-    bool fallback = false;
-    cs_real_t t_vol = 0;
+      /* Loop on cell faces to determine volumes */
 
-    for (cs_lnum_t i = 0; i < n_cell_faces; i++) {
+      bool fallback = false;
+      cs_real_t t_vol = 0;
 
-      cs_lnum_t face_id, n_vertices;
-      const cs_lnum_t *vertex_ids;
-      const cs_real_t *face_cog, *face_normal;
+      for (cs_lnum_t i = 0; i < n_cell_faces; i++) {
 
-      /* Outward normal: always well oriented for external faces,
-         depend on the connectivity for internal faces */
+        cs_lnum_t face_id, n_vertices;
+        const cs_lnum_t *vertex_ids;
+        const cs_real_t *face_cog, *face_normal;
 
-      cs_real_t v_mult = 1;
+        /* Outward normal: always well oriented for external faces,
+           depend on the connectivity for internal faces */
 
-      const cs_lnum_t face_num = cell_face_lst[cell_face_idx[cell_id] + i];
+        cs_real_t v_mult = 1;
 
-      if (face_num > 0) { /* Interior face */
+        const cs_lnum_t face_num = cell_face_lst[cell_face_idx[cell_id] + i];
 
-        face_id = face_num - 1;
+        if (face_num > 0) { /* Interior face */
 
-        if (cell_id == mesh->i_face_cells[face_id][1])
-          v_mult = -1;
-        cs_lnum_t vtx_s = mesh->i_face_vtx_idx[face_id];
-        n_vertices = mesh->i_face_vtx_idx[face_id+1] - vtx_s;
-        vertex_ids = mesh->i_face_vtx_lst + vtx_s;
-        face_cog = fvq->i_face_cog + (3*face_id);
-        face_normal = fvq->i_face_normal + (3*face_id);
+          face_id = face_num - 1;
 
-      }
-      else { /* Boundary faces */
+          if (cell_id == mesh->i_face_cells[face_id][1])
+            v_mult = -1;
+          cs_lnum_t vtx_s = mesh->i_face_vtx_idx[face_id];
+          n_vertices = mesh->i_face_vtx_idx[face_id+1] - vtx_s;
+          vertex_ids = mesh->i_face_vtx_lst + vtx_s;
+          face_cog = fvq->i_face_cog + (3*face_id);
+          face_normal = fvq->i_face_normal + (3*face_id);
 
-        assert(face_num < 0);
+        }
+        else { /* Boundary faces */
 
-        face_id = -face_num - 1;
+          assert(face_num < 0);
 
-        cs_lnum_t vtx_s = mesh->b_face_vtx_idx[face_id];
-        n_vertices = mesh->b_face_vtx_idx[face_id+1] - vtx_s;
-        vertex_ids = mesh->b_face_vtx_lst + vtx_s;
-        face_cog = fvq->b_face_cog + (3*face_id);
-        face_normal = fvq->b_face_normal + (3*face_id);
+          face_id = -face_num - 1;
 
-      }
+          cs_lnum_t vtx_s = mesh->b_face_vtx_idx[face_id];
+          n_vertices = mesh->b_face_vtx_idx[face_id+1] - vtx_s;
+          vertex_ids = mesh->b_face_vtx_lst + vtx_s;
+          face_cog = fvq->b_face_cog + (3*face_id);
+          face_normal = fvq->b_face_normal + (3*face_id);
 
-      cell_subface_index[i+1] = cell_subface_index[i] + n_vertices;
+        }
 
-      if (cell_subface_index[i+1] > n_divisions_max) {
-        n_divisions_max = cell_subface_index[i+1]*2;
-        BFT_REALLOC(acc_surf_r, n_divisions_max, cs_real_t);
-      }
+        cell_subface_index[i+1] = cell_subface_index[i] + n_vertices;
 
-      cs_real_t f_surf
-        = _face_sub_surfaces(n_vertices,
-                             vertex_ids,
-                             (const cs_real_3_t *)mesh->vtx_coord,
-                             face_cog,
-                             acc_surf_r + cell_subface_index[i]);
+        if (cell_subface_index[i+1] > n_divisions_max) {
+          n_divisions_max = cell_subface_index[i+1]*2;
+          BFT_REALLOC(acc_surf_r, n_divisions_max, cs_real_t);
+        }
 
-      cs_real_t fh = 0;
-      if (f_surf > 0) {
-        /* face normal should have length f_surf, so no need to divide here */
-        for (cs_lnum_t j = 0; j < 3; j++)
-          fh += (face_cog[j] - cell_cen[j]) * face_normal[j];
-      }
-      fh *= v_mult;
+        cs_real_t f_surf
+          = _face_sub_surfaces(n_vertices,
+                               vertex_ids,
+                               (const cs_real_3_t *)mesh->vtx_coord,
+                               face_cog,
+                               acc_surf_r + cell_subface_index[i]);
 
-      t_vol += CS_ABS(fh);
-      acc_vol_r[i] = t_vol;
+        cs_real_t fh = 0;
+        if (f_surf > 0) {
+          /* face normal should have length f_surf, so no need to divide here */
+          for (cs_lnum_t j = 0; j < 3; j++)
+            fh += (face_cog[j] - cell_cen[j]) * face_normal[j];
+        }
+        fh *= v_mult;
 
-      if (fh <= 0 || f_surf <= 0)
-        fallback = true;
+        t_vol += CS_ABS(fh);
+        acc_vol_r[i] = t_vol;
 
-    }
+        if (fh <= 0 || f_surf <= 0)
+          fallback = true;
 
-    if (t_vol >= w_eps) {
-      for (cs_lnum_t i = 0; i < n_cell_faces; i++)
-        acc_vol_r[i] /= t_vol;
-    }
-    else {
-      for (cs_lnum_t i = 0; i < n_cell_faces; i++)
-        acc_vol_r[i] = 1;
-    }
-    acc_vol_r[n_cell_faces - 1] = 1;
-
-    /* If needed, apply fallback to all faces, as in non-convex cases,
-       some cones may be partially masked by inverted cones;
-       weight is not based strictly on edge length in this case,
-       but bias cannot be avoid in this mode anyways, so do not bother
-       with extra steps. */
-
-    if (fallback) {
-      for (cs_lnum_t i = 0; i < cell_subface_index[n_cell_faces]; i++) {
-        if (acc_surf_r[i] > 0)
-          acc_surf_r[i] *= -1;
       }
-    }
-
-    /* distribute new particles */
 
-    for (cs_lnum_t i = 0; i < n_c_p; i++) {
+      if (t_vol >= w_eps) {
+        for (cs_lnum_t i = 0; i < n_cell_faces; i++)
+          acc_vol_r[i] /= t_vol;
+      }
+      else {
+        for (cs_lnum_t i = 0; i < n_cell_faces; i++)
+          acc_vol_r[i] = 1;
+      }
+      acc_vol_r[n_cell_faces - 1] = 1;
+
+      /* If needed, apply fallback to all faces, as in non-convex cases,
+         some cones may be partially masked by inverted cones;
+         weight is not based strictly on edge length in this case,
+         but bias cannot be avoid in this mode anyways, so do not bother
+         with extra steps. */
+
+      if (fallback) {
+        for (cs_lnum_t i = 0; i < cell_subface_index[n_cell_faces]; i++) {
+          if (acc_surf_r[i] > 0)
+            acc_surf_r[i] *= -1;
+        }
+      }
 
-      cs_lnum_t p_id = p_s_id + i;
+      /* distribute new particles */
 
-      cs_lagr_particles_set_lnum(particles, p_id, CS_LAGR_CELL_ID, cell_id);
+      for (cs_lnum_t i = 0; i < n_c_p; i++) {
 
-      cs_real_t *part_coord
-        = cs_lagr_particles_attr(particles, p_id, CS_LAGR_COORDS);
+        cs_lnum_t p_id = p_s_id + i;
 
-      /* search for matching center-to-face cone */
+        cs_lagr_particles_set_lnum(particles, p_id, CS_LAGR_CELL_ID, cell_id);
 
-      cs_real_t r[2];
-      cs_random_uniform(2, r);
+        cs_real_t *part_coord
+          = cs_lagr_particles_attr(particles, p_id, CS_LAGR_COORDS);
 
-      cs_lnum_t c_id = 0;
-      while (c_id < n_cell_faces && r[0] > acc_vol_r[c_id])
-        c_id++;
+        /* search for matching center-to-face cone */
 
-      cs_lnum_t face_id, n_vertices;
-      const cs_lnum_t *vertex_ids;
-      const cs_real_t *face_cog;
+        const cs_real_t *r_p = r_c + 5*i;
 
-      const cs_lnum_t face_num = cell_face_lst[cell_face_idx[cell_id] + c_id];
+        cs_lnum_t c_id = 0;
+        while (c_id < n_cell_faces && r_p[0] > acc_vol_r[c_id])
+          c_id++;
 
-      if (face_num > 0) { /* Interior face */
+        cs_lnum_t face_id, n_vertices;
+        const cs_lnum_t *vertex_ids;
+        const cs_real_t *face_cog;
 
-        face_id = face_num - 1;
+        const cs_lnum_t face_num = cell_face_lst[cell_face_idx[cell_id] + c_id];
 
-        cs_lnum_t vtx_s = mesh->i_face_vtx_idx[face_id];
-        n_vertices = mesh->i_face_vtx_idx[face_id+1] - vtx_s;
-        vertex_ids = mesh->i_face_vtx_lst + vtx_s;
-        face_cog = fvq->i_face_cog + (3*face_id);
+        if (face_num > 0) { /* Interior face */
 
-      }
-      else { /* Boundary faces */
+          face_id = face_num - 1;
 
-        assert(face_num < 0);
+          cs_lnum_t vtx_s = mesh->i_face_vtx_idx[face_id];
+          n_vertices = mesh->i_face_vtx_idx[face_id+1] - vtx_s;
+          vertex_ids = mesh->i_face_vtx_lst + vtx_s;
+          face_cog = fvq->i_face_cog + (3*face_id);
 
-        face_id = -face_num - 1;
+        }
+        else { /* Boundary faces */
 
-        cs_lnum_t vtx_s = mesh->b_face_vtx_idx[face_id];
-        n_vertices = mesh->b_face_vtx_idx[face_id+1] - vtx_s;
-        vertex_ids = mesh->b_face_vtx_lst + vtx_s;
-        face_cog = fvq->b_face_cog + (3*face_id);
+          assert(face_num < 0);
 
-      }
+          face_id = -face_num - 1;
 
-      _random_point_in_face(n_vertices,
-                            vertex_ids,
-                            (const cs_real_3_t *)mesh->vtx_coord,
-                            face_cog,
-                            acc_surf_r + cell_subface_index[c_id],
-                            part_coord);
+          cs_lnum_t vtx_s = mesh->b_face_vtx_idx[face_id];
+          n_vertices = mesh->b_face_vtx_idx[face_id+1] - vtx_s;
+          vertex_ids = mesh->b_face_vtx_lst + vtx_s;
+          face_cog = fvq->b_face_cog + (3*face_id);
 
-      /* In regular case, place point on segment joining cell center and
-         point in cell; volume of truncated cone proportional to
-         cube of distance along segment, so distribution compensates for this */
+        }
 
-      if (fallback == false) {
+        _random_point_in_face(n_vertices,
+                              vertex_ids,
+                              (const cs_real_3_t *)mesh->vtx_coord,
+                              face_cog,
+                              acc_surf_r + cell_subface_index[c_id],
+                              r_p + 2,
+                              part_coord);
 
-        cs_real_t t = pow(r[1], 1./3.) * (1.0 - d_eps);
-        for (cs_lnum_t j = 0; j < 3; j++)
-          part_coord[j] += (cell_cen[j] - part_coord[j]) * (1. - t);
-      }
+        /* In regular case, place point on segment joining cell center and
+           point in cell; volume of truncated cone proportional to
+           cube of distance along segment, so distribution compensates
+           for this */
 
-      /* Move particle slightly towards cell center cell
-         (assuming cell is star-shaped) */
+        if (fallback == false) {
 
-      else {
-        if (fvq->cell_vol[cell_id] > 0) {
+          cs_real_t t = pow(r_p[1], 1./3.) * (1.0 - d_eps);
           for (cs_lnum_t j = 0; j < 3; j++)
-            part_coord[j] += (cell_cen[j] - part_coord[j])*d_eps;
+            part_coord[j] += (cell_cen[j] - part_coord[j]) * (1. - t);
         }
-      }
 
-    } /* end of loop on new particles */
+        /* Move particle slightly towards cell center cell
+           (assuming cell is star-shaped) */
 
-  } /* end of loop on cells */
+        else {
+          if (fvq->cell_vol[cell_id] > 0) {
+            for (cs_lnum_t j = 0; j < 3; j++)
+              part_coord[j] += (cell_cen[j] - part_coord[j])*d_eps;
+          }
+        }
+
+      } /* end of loop on new particles */
+
+    } /* end of loop on cells */
 
-  BFT_FREE(acc_surf_r);
-  BFT_FREE(acc_vol_r);
-  BFT_FREE(cell_subface_index);
+    BFT_FREE(acc_surf_r);
+    BFT_FREE(acc_vol_r);
+    BFT_FREE(cell_subface_index);
+  }
+
+  BFT_FREE(r_g);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -639,6 +748,39 @@ void
 cs_lagr_new_particle_init(const cs_lnum_t  particle_range[2],
                           int              time_id,
                           const cs_real_t  visc_length[])
+{
+  cs_lagr_new_particle_init_rand(particle_range, time_id, visc_length,
+                                 NULL, NULL);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Initialization for new particles, using given random values.
+ *
+ * The fluid velocity seen is computed here.
+ *
+ * Random values may be provided by the caller (for example using
+ * counter-based streams, so that they do not depend on the number of
+ * threads); if NULL, they are drawn from the global generator.
+ *
+ * \param[in]  particle_range  start and past-the-end ids of new particles
+ *                             for this zone and class
+ * \param[in]  time_id         associated time id (0: current, 1: previous)
+ * \param[in]  visc_length     viscous layer thickness
+ *                             (size: number of mesh boundary faces)
+ * \param[in]  r_n             normal random values for the velocity seen,
+ *                             3 per particle, or NULL
+ * \param[in]  r_u             uniform random values in [0, 1] for the
+ *                             deposition model, 1 per particle, or NULL
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_new_particle_init_rand(const cs_lnum_t  particle_range[2],
+                               int              time_id,
+                               const cs_real_t  visc_length[],
+                               const cs_real_t  r_n[],
+                               const cs_real_t  r_u[])
 {
   cs_lagr_particle_set_t  *pset = cs_glob_lagr_particle_set;
   const cs_lagr_attribute_map_t  *p_am = pset->p_am;
@@ -698,24 +840,20 @@ cs_lagr_new_particle_init(const cs_lnum_t  particle_range[2],
   /* Random draws and computation of particle characteristic times */
 
   cs_lnum_t  n = particle_range[1] - particle_range[0];
-  cs_real_3_t  *vagaus;
-
-  BFT_MALLOC(vagaus, n, cs_real_3_t);
+  const cs_real_t  *vagaus = NULL;
+  cs_real_t  *r_g = NULL;
 
   if (cs_glob_lagr_model->idistu == 1 && n > 0) {
-    cs_random_normal(n*3, (cs_real_t *)vagaus);
-  }
-
-  else {
-
-    for (cs_lnum_t i = 0; i < n; i++) {
-      vagaus[i][0] = 0.0;
-      vagaus[i][1] = 0.0;
-      vagaus[i][2] = 0.0;
+    if (r_n != NULL)
+      vagaus = r_n;
+    else {
+      BFT_MALLOC(r_g, n*3, cs_real_t);
+      cs_random_normal(n*3, r_g);
+      vagaus = r_g;
     }
-
   }
 
+# pragma omp parallel for if (n > CS_THR_MIN)
   for (cs_lnum_t p_id = particle_range[0]; p_id < particle_range[1]; p_id++) {
 
     unsigned char *particle = pset->p_buffer + p_am->extents * p_id;
@@ -741,8 +879,14 @@ cs_lagr_new_particle_init(const cs_lnum_t  particle_range[2],
 
     cs_real_t tu = sqrt(d2s3 * w);
 
-    for (cs_lnum_t i = 0; i < 3; i++)
-      vel_seen[i] = vel[iel][i] + vagaus[l_id][i] * tu;
+    if (vagaus != NULL) {
+      for (cs_lnum_t i = 0; i < 3; i++)
+        vel_seen[i] = vel[iel][i] + vagaus[l_id*3 + i] * tu;
+    }
+    else {
+      for (cs_lnum_t i = 0; i < 3; i++)
+        vel_seen[i] = vel[iel][i];
+    }
 
     cs_lagr_particle_set_lnum(particle, p_am, CS_LAGR_P_FLAG, 0);
 
@@ -751,7 +895,7 @@ cs_lagr_new_particle_init(const cs_lnum_t  particle_range[2],
 
   }
 
-  BFT_FREE(vagaus);
+  BFT_FREE(r_g);
 
   /* Compute velocity fluctuation if deposition model is active */
 
@@ -759,6 +903,9 @@ cs_lagr_new_particle_init(const cs_lnum_t  particle_range[2],
 
     const cs_mesh_adjacencies_t  *ma = cs_glob_mesh_adjacencies;
 
+    /* Values from the global generator are drawn in particle order */
+
+#   pragma omp parallel for if (r_u != NULL && n > CS_THR_MIN)
     for (cs_lnum_t p_id = particle_range[0]; p_id < particle_range[1]; p_id++) {
 
       unsigned char *particle = pset->p_buffer + p_am->extents * p_id;
@@ -828,7 +975,10 @@ cs_lagr_new_particle_init(const cs_lnum_t  particle_range[2],
       else {
 
         cs_real_t random;
-        cs_random_uniform(1, &random);
+        if (r_u != NULL)
+          random = r_u[p_id - particle_range[0]];
+        else
+          cs_random_uniform(1, &random);
 
         if (random < 0.25)
           cs_lagr_particle_set_lnum(particle,
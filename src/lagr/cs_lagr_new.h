@@ -75,6 +75,35 @@ cs_lagr_new(cs_lagr_particle_set_t  *particles,
             const cs_lnum_t          face_ids[],
             const cs_lnum_t          face_particle_idx[]);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Inject a series of particles at random positions on given faces,
+ * using given random values.
+ *
+ * The fluid velocity and other variables and attributes are computed here.
+ *
+ * Random values may be provided by the caller (for example using
+ * counter-based streams, so that they do not depend on the number of
+ * threads); if NULL, they are drawn from the global generator.
+ * Faces are then handled by threads.
+ *
+ * \param[in,out]  particles          pointer to particle set
+ * \param[in]      n_faces            number of faces in zone
+ * \param[in]      face_ids           ids of faces in zone
+ * \param[in]      face_particle_idx  starting index of added particles
+ *                                    for each face in zone
+ * \param[in]      r                  uniform random values in [0, 1],
+ *                                    3 per added particle, or NULL
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_new_rand(cs_lagr_particle_set_t  *particles,
+                 cs_lnum_t                n_faces,
+                 const cs_lnum_t          face_ids[],
+                 const cs_lnum_t          face_particle_idx[],
+                 const cs_real_t          r[]);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Inject a series of particles at random positions on given cells.
@@ -97,6 +126,37 @@ cs_lagr_new_v(cs_lagr_particle_set_t  *particles,
               const cs_lnum_t          cell_ids[],
               const cs_lnum_t          cell_particle_idx[]);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Inject a series of particles at random positions on given cells,
+ * using given random values.
+ *
+ * \warning Currently works only for tri and quadrangular faces.
+ *
+ * The fluid velocity and other variables and attributes are computed here.
+ *
+ * Random values may be provided by the caller (for example using
+ * counter-based streams, so that they do not depend on the number of
+ * threads); if NULL, they are drawn from the global generator.
+ * Cells are then handled by threads.
+ *
+ * \param[in,out]  particles          pointer to particle set
+ * \param[in]      n_cells            number of cells in zone
+ * \param[in]      cell_ids           ids of cells in zone
+ * \param[in]      cell_particle_idx  starting index of added particles
+ *                                    for each cell in zone
+ * \param[in]      r                  uniform random values in [0, 1],
+ *                                    5 per added particle, or NULL
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_new_v_rand(cs_lagr_particle_set_t  *particles,
+                   cs_lnum_t                n_cells,
+                   const cs_lnum_t          cell_ids[],
+                   const cs_lnum_t          cell_particle_idx[],
+                   const cs_real_t          r[]);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Initialization for new particles.
@@ -116,6 +176,35 @@ cs_lagr_new_particle_init(const cs_lnum_t  particle_range[2],
                           int              time_id,
                           const cs_real_t  visc_length[]);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Initialization for new particles, using given random values.
+ *
+ * The fluid velocity seen is computed here.
+ *
+ * Random values may be provided by the caller (for example using
+ * counter-based streams, so that they do not depend on the number of
+ * threads); if NULL, they are drawn from the global generator.
+ *
+ * \param[in]  particle_range  start and past-the-end ids of new particles
+ *                             for this zone and class
+ * \param[in]  time_id         associated time id (0: current, 1: previous)
+ * \param[in]  visc_length     viscous layer thickness
+ *                             (size: number of mesh boundary faces)
+ * \param[in]  r_n             normal random values for the velocity seen,
+ *                             3 per particle, or NULL
+ * \param[in]  r_u             uniform random values in [0, 1] for the
+ *                             deposition model, 1 per particle, or NULL
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_new_particle_init_rand(const cs_lnum_t  particle_range[2],
+                               int              time_id,
+                               const cs_real_t  visc_length[],
+                               const cs_real_t  r_n[],
+                               const cs_real_t  r_u[]);
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -55,6 +55,7 @@
 #include "cs_order.h"
 #include "cs_parall.h"
 #include "cs_random.h"
+#include "cs_scratch.h"
 #include "cs_timer_stats.h"
 
 #include "cs_lagr.h"
@@ -509,6 +510,9 @@ _create_particle_set(cs_lnum_t                       n_particles_max,
 
   new_set->p_am = p_am;
 
+  new_set->cell_sorted = false;
+  new_set->cell_idx = NULL;
+
   return new_set;
 }
 
@@ -526,6 +530,7 @@ _destroy_particle_set(cs_lagr_particle_set_t **set)
 
     cs_lagr_particle_set_t *_set = *set;
     BFT_FREE(_set->p_buffer);
+    BFT_FREE(_set->cell_idx);
 
     BFT_FREE(*set);
   }
@@ -1175,6 +1180,132 @@ cs_lagr_particle_set_resize(cs_lnum_t  n_min_particles)
   return retval;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Sort particles of a set by cell, and update the associated
+ *        cell index.
+ *
+ * Particles already located in the range of their cell are not moved,
+ * so the cost of this operation is low when only a few particles change
+ * cells; the order of particles within a cell is not preserved.
+ *
+ * \param[in, out]  particles  associated particle set
+ * \param[in]       n_cells    number of cells
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_particle_set_sort_by_cell(cs_lagr_particle_set_t  *particles,
+                                  cs_lnum_t                n_cells)
+{
+  const size_t extents = particles->p_am->extents;
+  const ptrdiff_t c_displ = particles->p_am->displ[0][CS_LAGR_CELL_ID];
+  const cs_lnum_t n_particles = particles->n_particles;
+
+  unsigned char *p_buffer = particles->p_buffer;
+
+# define _CELL_ID(_p_id) \
+  (*((const cs_lnum_t *)(p_buffer + extents*(_p_id) + c_displ)))
+
+  BFT_REALLOC(particles->cell_idx, n_cells + 1, cs_lnum_t);
+
+  cs_lnum_t *cell_idx = particles->cell_idx;
+
+  /* Count particles per cell, checking if they are already sorted */
+
+  for (cs_lnum_t i = 0; i < n_cells + 1; i++)
+    cell_idx[i] = 0;
+
+  bool sorted = true;
+  cs_lnum_t prev_cell_id = 0;
+
+  for (cs_lnum_t i = 0; i < n_particles; i++) {
+    cs_lnum_t cell_id = _CELL_ID(i);
+    assert(cell_id > -1 && cell_id < n_cells);
+    cell_idx[cell_id + 1] += 1;
+    if (cell_id < prev_cell_id)
+      sorted = false;
+    prev_cell_id = cell_id;
+  }
+
+  for (cs_lnum_t i = 0; i < n_cells; i++)
+    cell_idx[i+1] += cell_idx[i];
+
+  assert(cell_idx[n_cells] == n_particles);
+
+  /* In-place bucket sort; a particle is only moved if it is not
+     in the range of its cell, and is then moved directly to
+     the first free position in that range */
+
+  if (sorted == false) {
+
+    cs_scratch_mark_t s_mark = cs_scratch_mark();
+
+    cs_lnum_t *next;
+    unsigned char *tmp;
+    CS_SCRATCH_ALLOC(next, n_cells, cs_lnum_t);
+    CS_SCRATCH_ALLOC(tmp, extents, unsigned char);
+
+    for (cs_lnum_t i = 0; i < n_cells; i++)
+      next[i] = cell_idx[i];
+
+    for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+      while (next[c_id] < cell_idx[c_id+1]) {
+        cs_lnum_t i = next[c_id];
+        cs_lnum_t d_id = _CELL_ID(i);
+        if (d_id == c_id) {
+          next[c_id] += 1;
+          continue;
+        }
+        while (_CELL_ID(next[d_id]) == d_id)
+          next[d_id] += 1;
+        cs_lnum_t j = next[d_id];
+        next[d_id] += 1;
+        memcpy(tmp, p_buffer + extents*j, extents);
+        memcpy(p_buffer + extents*j, p_buffer + extents*i, extents);
+        memcpy(p_buffer + extents*i, tmp, extents);
+      }
+    }
+
+    cs_scratch_release(s_mark);
+
+  }
+
+# undef _CELL_ID
+
+  particles->cell_sorted = true;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Return the index of particles by cell if particles are currently
+ *        sorted by cell.
+ *
+ * Particles of cell i are those with ids cell_idx[i] to cell_idx[i+1] - 1.
+ * The index becomes invalid when particles are added, removed, or moved.
+ *
+ * \param[in]  particles  associated particle set
+ * \param[in]  n_cells    number of cells
+ *
+ * \return  pointer to index of particles by cell (size: n_cells + 1),
+ *          or NULL if particles are not sorted by cell
+ */
+/*----------------------------------------------------------------------------*/
+
+const cs_lnum_t *
+cs_lagr_particle_set_get_cell_index(const cs_lagr_particle_set_t  *particles,
+                                    cs_lnum_t                      n_cells)
+{
+  const cs_lnum_t *cell_idx = NULL;
+
+  if (   particles->cell_sorted
+      && particles->cell_idx != NULL
+      && particles->cell_idx[n_cells] == particles->n_particles)
+    cell_idx = particles->cell_idx;
+
+  return cell_idx;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Set reallocation factor for particle sets.
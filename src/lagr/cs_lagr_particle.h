@@ -244,6 +244,13 @@ typedef struct {
                                                    (p_am + i for time n-i) */
   unsigned char                  *p_buffer;   /*!< Particles data buffer */
 
+  bool        cell_sorted;                    /*!< true if particles are
+                                                   sorted by cell since the
+                                                   last displacement */
+  cs_lnum_t  *cell_idx;                       /*!< index of particles by cell
+                                                   (size: n_cells + 1), valid
+                                                   if cell_sorted is true */
+
 } cs_lagr_particle_set_t;
 
 /*=============================================================================
@@ -1384,6 +1391,42 @@ cs_lagr_particle_source_term_const(void                           *particle,
 int
 cs_lagr_particle_set_resize(cs_lnum_t  n_min_particles);
 
+/*----------------------------------------------------------------------------
+ * Sort particles of a set by cell, and update the associated cell index.
+ *
+ * Particles already located in the range of their cell are not moved,
+ * so the cost of this operation is low when only a few particles change
+ * cells; the order of particles within a cell is not preserved.
+ *
+ * parameters:
+ *   particles <-> associated particle set
+ *   n_cells   <-- number of cells
+ *----------------------------------------------------------------------------*/
+
+void
+cs_lagr_particle_set_sort_by_cell(cs_lagr_particle_set_t  *particles,
+                                  cs_lnum_t                n_cells);
+
+/*----------------------------------------------------------------------------
+ * Return the index of particles by cell if particles are currently
+ * sorted by cell.
+ *
+ * Particles of cell i are those with ids cell_idx[i] to cell_idx[i+1] - 1.
+ * The index becomes invalid when particles are added, removed, or moved.
+ *
+ * parameters:
+ *   particles <-- associated particle set
+ *   n_cells   <-- number of cells
+ *
+ * returns:
+ *   pointer to index of particles by cell (size: n_cells + 1), or NULL
+ *   if particles are not sorted by cell
+ *----------------------------------------------------------------------------*/
+
+const cs_lnum_t *
+cs_lagr_particle_set_get_cell_index(const cs_lagr_particle_set_t  *particles,
+                                    cs_lnum_t                      n_cells);
+
 /*----------------------------------------------------------------------------
  * Set reallocation factor for particle sets.
  *
@@ -45,6 +45,8 @@
 #include "bft_printf.h"
 
 #include "cs_base.h"
+#include "cs_file.h"
+#include "cs_mesh.h"
 #include "cs_mesh_location.h"
 
 #include "cs_parameters.h"
@@ -53,8 +55,10 @@
 #include "cs_post.h"
 
 #include "cs_lagr.h"
+#include "cs_lagr_extract.h"
 #include "cs_lagr_particle.h"
 #include "cs_lagr_stat.h"
+#include "cs_lagr_stream.h"
 
 /*----------------------------------------------------------------------------
  *  Header for the current file
@@ -68,6 +72,14 @@ BEGIN_C_DECLS
 
 /*! \cond DOXYGEN_SHOULD_SKIP_THIS */
 
+/*============================================================================
+ * Local macro definitions
+ *============================================================================*/
+
+/* Directory name separator */
+
+#define DIR_SEPARATOR '/'
+
 /*============================================================================
  * Local types and structures
  *============================================================================*/
@@ -85,6 +97,13 @@ typedef struct {
     postprocessed as separate scalars */
   int  attr_output[CS_LAGR_N_ATTRIBUTES];
 
+  /*! time step interval for streaming output of particle attributes,
+    or 0 if not active */
+  int     stream_interval;
+
+  /*! fraction of particles included in streaming output */
+  double  stream_density;
+
 } cs_lagr_post_options_t;
 
 /*============================================================================
@@ -229,6 +248,116 @@ _write_particle_vars(cs_lagr_post_options_t  *options,
   }
 }
 
+/*----------------------------------------------------------------------------
+ * Write particle attributes to a streaming output file.
+ *
+ * Each rank writes the values of its (possibly sampled) particles as a
+ * contiguous block of each section, ranks being ordered by id, so that
+ * neither an export mesh nor a global numbering needs to be built.
+ * Coordinates are always written, other attributes if their
+ * postprocessing is active.
+ *
+ * parameters:
+ *   options <-- postprocessing options
+ *   ts      <-- time step structure
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_particle_stream(const cs_lagr_post_options_t  *options,
+                       const cs_time_step_t          *ts)
+{
+  const cs_lagr_particle_set_t  *p_set = cs_glob_lagr_particle_set;
+
+  if (p_set == NULL)
+    return;
+
+  /* Select particles; sampling relies on the random value
+     associated with each particle, so it is independent of the
+     partitioning and consistent across time steps */
+
+  cs_lnum_t n_particles = p_set->n_particles;
+  cs_lnum_t *particle_list = NULL;
+
+  if (options->stream_density < 1) {
+    BFT_MALLOC(particle_list, p_set->n_particles, cs_lnum_t);
+    cs_lagr_get_particle_list(cs_glob_mesh->n_cells,
+                              NULL,
+                              options->stream_density,
+                              &n_particles,
+                              particle_list);
+  }
+
+  /* Open file */
+
+  const char dir[] = "postprocessing";
+  char file_name[64];
+
+  if (cs_glob_rank_id < 1) {
+    if (cs_file_mkdir_default(dir) != 0)
+      bft_error(__FILE__, __LINE__, 0,
+                _("The %s directory cannot be created"), dir);
+  }
+
+  snprintf(file_name, 63, "%s%cparticles_%05d.csc",
+           dir, DIR_SEPARATOR, ts->nt_cur);
+  file_name[63] = '\0';
+
+  cs_lagr_stream_t *s = cs_lagr_stream_create(file_name,
+                                              n_particles,
+                                              ts->nt_cur,
+                                              ts->t_cur);
+
+  /* Write attributes, using a single buffer */
+
+  unsigned char *buf = NULL;
+  size_t buf_size = 0;
+
+  for (cs_lagr_attribute_t attr_id = 0;
+       attr_id < CS_LAGR_N_ATTRIBUTES;
+       attr_id++) {
+
+    if (attr_id != CS_LAGR_COORDS && options->attr_output[attr_id] < 1)
+      continue;
+
+    size_t  extents, size;
+    ptrdiff_t  displ;
+    cs_datatype_t  datatype;
+    int  count;
+
+    cs_lagr_get_attr_info(p_set, 0, attr_id,
+                          &extents, &size, &displ, &datatype, &count);
+
+    if (count == 0)
+      continue;
+
+    if (buf_size < n_particles*size) {
+      buf_size = n_particles*size;
+      BFT_REALLOC(buf, buf_size, unsigned char);
+    }
+
+    cs_lagr_get_particle_values(p_set,
+                                attr_id,
+                                datatype,
+                                count,
+                                -1,
+                                n_particles,
+                                particle_list,
+                                buf);
+
+    cs_lagr_stream_write(s,
+                         cs_lagr_attribute_name[attr_id],
+                         datatype,
+                         count,
+                         buf);
+
+  }
+
+  cs_lagr_stream_destroy(&s);
+
+  BFT_FREE(buf);
+  BFT_FREE(particle_list);
+}
+
 /*----------------------------------------------------------------------------
  * Function for additional postprocessing of Lagrangian data.
  *
@@ -411,6 +540,50 @@ cs_lagr_post_set_attr(cs_lagr_attribute_t  attr_id,
     _lagr_post_options.attr_output[attr_id] = 1;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Activate or deactivate streaming output of particle attributes.
+ *
+ * Streaming output files (postprocessing/particles_<time step>.csc)
+ * use the kernel IO format, each rank writing the attributes of its
+ * particles directly as a block of each section, without building an
+ * export mesh. Coordinates are always written, and other attributes
+ * if their postprocessing is active.
+ *
+ * \param[in]  interval  time step interval for output, or 0 to deactivate
+ * \param[in]  density   fraction of particles to output (sampling is
+ *                       based on the random value of each particle)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_post_set_stream(int     interval,
+                        double  density)
+{
+  _lagr_post_options.stream_interval = CS_MAX(interval, 0);
+  _lagr_post_options.stream_density = CS_MIN(CS_MAX(density, 0.), 1.);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Write streaming output of particle attributes if active
+ *        for the current time step.
+ *
+ * \param[in]  ts  time step structure
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_post_stream_write(const cs_time_step_t  *ts)
+{
+  const int interval = _lagr_post_options.stream_interval;
+
+  if (interval < 1 || ts->nt_cur % interval != 0)
+    return;
+
+  _write_particle_stream(&_lagr_post_options, ts);
+}
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -32,6 +32,7 @@
 #include "assert.h"
 #include "cs_base.h"
 #include "cs_field.h"
+#include "cs_time_step.h"
 
 #include "cs_lagr.h"
 #include "cs_lagr_particle.h"
@@ -91,6 +92,32 @@ void
 cs_lagr_post_set_attr(cs_lagr_attribute_t  attr_id,
                       bool                 active);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Activate or deactivate streaming output of particle attributes.
+ *
+ * \param[in]  interval  time step interval for output, or 0 to deactivate
+ * \param[in]  density   fraction of particles to output (sampling is
+ *                       based on the random value of each particle)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_post_set_stream(int     interval,
+                        double  density);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Write streaming output of particle attributes if active
+ *        for the current time step.
+ *
+ * \param[in]  ts  time step structure
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_post_stream_write(const cs_time_step_t  *ts);
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -470,6 +470,8 @@ cs_lagr_precipitation_injection(cs_real_t   *vela,
   }
 
   p_set->n_particles += nbprec_tot;
+  if (nbprec_tot > 0)
+    p_set->cell_sorted = false;
 
   BFT_FREE(cell);
   BFT_FREE(nbdiss);
@@ -48,6 +48,8 @@
 
 #include "cs_field.h"
 #include "cs_field_pointer.h"
+#include "cs_file.h"
+#include "cs_lagr.h"
 #include "cs_lagr_extract.h"
 #include "cs_lagr_tracking.h"
 #include "cs_log.h"
@@ -873,6 +875,51 @@ cs_lagr_restart_write_particle_data(cs_restart_t  *r)
   return retval;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Count particles per cell in the Lagrangian checkpoint.
+ *
+ * Counts are defined on a cell block distribution, so this may be called
+ * before the mesh is partitioned. They are only available when restarting
+ * particle tracking, and when the global number of cells matches that of
+ * the checkpoint.
+ *
+ * \param[in]   cell_bi     cell block distribution info
+ * \param[out]  cell_count  number of particles for each cell of the block
+ *
+ * \return  true if counts were read, false otherwise
+ */
+/*----------------------------------------------------------------------------*/
+
+bool
+cs_lagr_restart_cell_particle_count(const cs_block_dist_info_t  *cell_bi,
+                                    cs_lnum_t                    cell_count[])
+{
+  if (   cs_glob_lagr_time_scheme->iilagr == CS_LAGR_OFF
+      || cs_glob_lagr_time_scheme->isuila != 1)
+    return false;
+
+  if (   !cs_file_isreg("restart/lagrangian")
+      && !cs_file_isreg("restart/lagrangian.csc"))
+    return false;
+
+  char sec_name[128];
+  _lagr_section_name(CS_LAGR_COORDS, -1, sec_name);
+
+  cs_restart_t *r = cs_restart_create("lagrangian.csc",
+                                      NULL,
+                                      CS_RESTART_MODE_READ);
+
+  int retcode = cs_restart_read_particles_cell_count(r,
+                                                     sec_name,
+                                                     cell_bi,
+                                                     cell_count);
+
+  cs_restart_destroy(&r);
+
+  return (retcode == CS_RESTART_SUCCESS) ? true : false;
+}
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -32,6 +32,7 @@
  *----------------------------------------------------------------------------*/
 
 #include "cs_defs.h"
+#include "cs_block_dist.h"
 #include "cs_field.h"
 #include "cs_map.h"
 #include "cs_restart.h"
@@ -78,6 +79,26 @@ cs_lagr_restart_read_particle_data(cs_restart_t  *r);
 int
 cs_lagr_restart_write_particle_data(cs_restart_t  *r);
 
+/*----------------------------------------------------------------------------
+ * Count particles per cell in the Lagrangian checkpoint.
+ *
+ * Counts are defined on a cell block distribution, so this may be called
+ * before the mesh is partitioned. They are only available when restarting
+ * particle tracking, and when the global number of cells matches that of
+ * the checkpoint.
+ *
+ * parameters:
+ *   cell_bi    <-- cell block distribution info
+ *   cell_count --> number of particles for each cell of the block
+ *
+ * returns:
+ *   true if counts were read, false otherwise
+ *----------------------------------------------------------------------------*/
+
+bool
+cs_lagr_restart_cell_particle_count(const cs_block_dist_info_t  *cell_bi,
+                                    cs_lnum_t                    cell_count[]);
+
 /*----------------------------------------------------------------------------*/
 
 END_C_DECLS
@@ -51,13 +51,16 @@
 #include "cs_physical_model.h"
 #include "cs_prototypes.h"
 #include "cs_random.h"
+#include "cs_scratch.h"
 #include "cs_thermal_model.h"
 
 #include "cs_lagr.h"
 #include "cs_lagr_adh.h"
 #include "cs_lagr_deposition_model.h"
 #include "cs_lagr_event.h"
+#include "cs_lagr_geom.h"
 #include "cs_lagr_roughness.h"
+#include "cs_lagr_sde_kernels.h"
 #include "cs_lagr_tracking.h"
 #include "cs_lagr_prototypes.h"
 
@@ -143,6 +146,139 @@ _add_resuspension_event(cs_lagr_event_set_t     *events,
   events->n_events += 1;
 }
 
+/*----------------------------------------------------------------------------*/
+/*! \brief Integration of SDEs by 1st order time scheme for spherical
+ *         particles without Brownian motion, by blocks of particles.
+ *
+ * Particle attributes and per-particle terms are gathered into contiguous
+ * arrays for each block, integrated by cs_lagr_sde_kernel_order_1,
+ * and scattered back.
+ *
+ * \param[in]  dtp       time step
+ * \param[in]  taup      dynamic characteristic time
+ * \param[in]  tlag      lagrangian fluid characteristic time
+ * \param[in]  piil      term in integration of UP SDEs
+ * \param[in]  bx        turbulence characteristics
+ * \param[in]  vagaus    gaussian random variables
+ * \param[in]  force_p   taup times forces on particles (m/s)
+ * \param[in]  cvar_vel  fluid velocity
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_lages1_sphere(cs_real_t           dtp,
+               const cs_real_t     taup[],
+               const cs_real_3_t   tlag[],
+               const cs_real_3_t   piil[],
+               const cs_real_33_t  bx[],
+               const cs_real_33_t  vagaus[],
+               const cs_real_3_t   force_p[],
+               const cs_real_3_t   cvar_vel[])
+{
+  cs_lagr_particle_set_t  *p_set = cs_glob_lagr_particle_set;
+  const cs_lagr_attribute_map_t  *p_am = p_set->p_am;
+
+  const int nor = cs_glob_lagr_time_step->nor;
+  const cs_lnum_t b_size = CS_LAGR_SDE_BLOCK_SIZE;
+
+  cs_lnum_t *p_id;
+  cs_real_t *b_taup, *b_tlag, *b_tci, *b_force, *b_bx;
+  cs_real_t *b_vel, *b_vel_seen, *b_displ;
+  cs_real_3_t *b_vagaus;
+
+  cs_scratch_mark_t mark = cs_scratch_mark();
+
+  CS_SCRATCH_ALLOC(p_id, b_size, cs_lnum_t);
+  CS_SCRATCH_ALLOC(b_taup, b_size, cs_real_t);
+  CS_SCRATCH_ALLOC(b_tlag, 3*b_size, cs_real_t);
+  CS_SCRATCH_ALLOC(b_tci, 3*b_size, cs_real_t);
+  CS_SCRATCH_ALLOC(b_force, 3*b_size, cs_real_t);
+  CS_SCRATCH_ALLOC(b_bx, 3*b_size, cs_real_t);
+  CS_SCRATCH_ALLOC(b_vel, 3*b_size, cs_real_t);
+  CS_SCRATCH_ALLOC(b_vel_seen, 3*b_size, cs_real_t);
+  CS_SCRATCH_ALLOC(b_displ, 3*b_size, cs_real_t);
+  CS_SCRATCH_ALLOC(b_vagaus, 3*b_size, cs_real_3_t);
+
+  cs_lnum_t ip = 0;
+
+  while (ip < p_set->n_particles) {
+
+    /* Select active particles for the next block */
+
+    cs_lnum_t n = 0;
+
+    for (; ip < p_set->n_particles && n < b_size; ip++) {
+      if (cs_lagr_particles_get_flag(p_set, ip, CS_LAGR_PART_FIXED))
+        continue;
+      if (cs_lagr_particles_get_lnum(p_set, ip, CS_LAGR_CELL_ID) >= 0)
+        p_id[n++] = ip;
+    }
+
+    /* Gather, with arrays for each component contiguous */
+
+    for (cs_lnum_t i = 0; i < n; i++) {
+
+      const cs_lnum_t j = p_id[i];
+      const unsigned char *particle = p_set->p_buffer + p_am->extents * j;
+
+      cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_am,
+                                                    CS_LAGR_CELL_ID);
+      const cs_real_t *old_part_vel
+        = cs_lagr_particle_attr_n_const(particle, p_am, 1, CS_LAGR_VELOCITY);
+      const cs_real_t *old_part_vel_seen
+        = cs_lagr_particle_attr_n_const(particle, p_am, 1,
+                                        CS_LAGR_VELOCITY_SEEN);
+
+      b_taup[i] = taup[j];
+
+      for (int id = 0; id < 3; id++) {
+        cs_lnum_t k = id*b_size + i;
+        b_tlag[k] = tlag[j][id];
+        b_tci[k] = piil[j][id] * tlag[j][id] + cvar_vel[cell_id][id];
+        b_force[k] = force_p[j][id];
+        b_bx[k] = bx[j][id][nor-1];
+        b_vel[k] = old_part_vel[id];
+        b_vel_seen[k] = old_part_vel_seen[id];
+        for (int l = 0; l < 3; l++)
+          b_vagaus[k][l] = vagaus[j][id][l];
+      }
+
+    }
+
+    /* Integrate */
+
+    cs_lagr_sde_kernel_order_1(n, dtp, b_taup, b_tlag, b_tci, b_force, b_bx,
+                               b_vagaus, b_vel, b_vel_seen, b_displ);
+
+    /* Scatter */
+
+    for (cs_lnum_t i = 0; i < n; i++) {
+
+      unsigned char *particle = p_set->p_buffer + p_am->extents * p_id[i];
+
+      const cs_real_t *old_part_coords
+        = cs_lagr_particle_attr_n_const(particle, p_am, 1, CS_LAGR_COORDS);
+      cs_real_t *part_coords
+        = cs_lagr_particle_attr(particle, p_am, CS_LAGR_COORDS);
+      cs_real_t *part_vel
+        = cs_lagr_particle_attr(particle, p_am, CS_LAGR_VELOCITY);
+      cs_real_t *part_vel_seen
+        = cs_lagr_particle_attr(particle, p_am, CS_LAGR_VELOCITY_SEEN);
+
+      for (int id = 0; id < 3; id++) {
+        cs_lnum_t k = id*b_size + i;
+        part_coords[id] = old_part_coords[id] + b_displ[k];
+        part_vel[id] = b_vel[k];
+        part_vel_seen[id] = b_vel_seen[k];
+      }
+
+    }
+
+  }
+
+  cs_scratch_release(mark);
+}
+
 /*----------------------------------------------------------------------------*/
 /*! \brief Integration of SDEs by 1st order time scheme
  *
@@ -194,6 +330,14 @@ _lages1(cs_real_t           dtp,
   const cs_real_3_t *cvar_vel
     = (const cs_real_3_t *)(extra->vel->vals[_prev_id]);
 
+  /* Spherical particles without Brownian motion are integrated by blocks */
+
+  if (   cs_glob_lagr_model->shape == 0
+      && cs_glob_lagr_brownian->lamvbr != 1) {
+    _lages1_sphere(dtp, taup, tlag, piil, bx, vagaus, force_p, cvar_vel);
+    return;
+  }
+
   /* Integrate SDE's over particles */
 
   for (cs_lnum_t ip = 0; ip < p_set->n_particles; ip++) {
@@ -925,7 +1069,6 @@ _lages2(cs_real_t           dtp,
  * \param[in]  romp      particles associated density
  * \param[in]  force_p   taup times forces on particles (m/s)
  * \param[in]  tempf     temperature of the fluid (K)
- * \param[in]  vislen    FIXME
  * \param[in]  events    associated events set
  * \param[in]  depint    interface location near-wall/core-flow
  */
@@ -940,7 +1083,6 @@ _lagesd(cs_real_t             dtp,
         const cs_real_t       romp[],
         const cs_real_3_t     force_p[],
         cs_real_t             tempf,
-        const cs_real_t       vislen[],
         cs_lagr_event_set_t  *events,
         cs_real_t            *depint,
         cs_lnum_t            *nresnew)
@@ -997,14 +1139,13 @@ _lagesd(cs_real_t             dtp,
 
   assert(face_id > -1);
 
-  cs_real_t ustar = extra->ustar->val[face_id];
-  cs_real_t lvisq = vislen[face_id];
+  /* Wall face quantities computed once per time step */
+
+  const cs_lagr_wall_face_cache_t *wc = cs_lagr_geom_wall_face_cache();
 
-  cs_real_t tvisq;
-  if (ustar > 0.0)
-    tvisq = lvisq / ustar;
-  else
-    tvisq = cs_math_big_r;
+  cs_real_t ustar = wc->ustar[face_id];
+  cs_real_t lvisq = wc->lvisq[face_id];
+  cs_real_t tvisq = wc->tvisq[face_id];
 
   /* Constants for the calculation of bxp and tlp  */
   cs_real_t c0 = 2.1;
@@ -2247,7 +2388,6 @@ _lagesd(cs_real_t             dtp,
  * \param[in] vagaus    gaussian random variables
  * \param[in] romp      particles associated density
  * \param[in] force_p   taup times forces on particles (m/s)
- * \param[in] vislen    FIXME
  */
 /*----------------------------------------------------------------------------*/
 
@@ -2260,7 +2400,6 @@ _lagdep(cs_real_t           dtp,
         const cs_real_33_t  vagaus[],
         const cs_real_t     romp[],
         const cs_real_3_t   force_p[],
-        const cs_real_t     vislen[],
         cs_lnum_t          *nresnew)
 {
   /* Particles management */
@@ -2546,7 +2685,6 @@ _lagdep(cs_real_t           dtp,
                 romp,
                 force_p,
                 tempf,
-                vislen,
                 events,
                 &depint,
                 nresnew);
@@ -2610,7 +2748,6 @@ _lagdep(cs_real_t           dtp,
  * \param[in]  gradpr    pressure gradient
  * \param[in]  gradvf    fluid velocity gradient
  * \param[out] terbru    FIXME
- * \param[in]  vislen    FIXME
  */
 /*----------------------------------------------------------------------------*/
 
@@ -2624,7 +2761,6 @@ cs_lagr_sde(cs_real_t           dt_p,
             const cs_real_3_t   gradpr[],
             const cs_real_33_t  gradvf[],
             cs_real_t           terbru[],
-            const cs_real_t     vislen[],
             cs_lnum_t          *nresnew)
 {
   cs_real_t *romp;
@@ -2789,7 +2925,6 @@ cs_lagr_sde(cs_real_t           dt_p,
               (const cs_real_33_t *)vagaus,
               romp,
               (const cs_real_3_t *)force_p,
-              vislen,
               nresnew);
 
   }
@@ -53,7 +53,6 @@ BEGIN_C_DECLS
  * \param[in]  gradpr    pressure gradient
  * \param[in]  gradvf    fluid velocity gradient
  * \param[out] terbru    FIXME
- * \param[in]  vislen    FIXME
  */
 /*----------------------------------------------------------------------------*/
 
@@ -67,7 +66,6 @@ cs_lagr_sde(cs_real_t           dt_p,
             const cs_real_3_t   gradpr[],
             const cs_real_33_t  gradvf[],
             cs_real_t           terbru[],
-            const cs_real_t     vislen[],
             cs_lnum_t          *nresnew);
 
 /*----------------------------------------------------------------------------*/
@@ -0,0 +1,294 @@
+/*============================================================================
+ * Batched kernels for the integration of particle SDEs.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <math.h>
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "cs_math.h"
+
+/*----------------------------------------------------------------------------
+ *  Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_lagr_sde_kernels.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Additional doxygen documentation
+ *============================================================================*/
+
+/*!
+  \file cs_lagr_sde_kernels.c
+
+  Kernels operating on blocks of particles whose attributes have been
+  gathered into contiguous arrays, so that the integration loops may be
+  vectorized. Callers are responsible for gathering and scattering
+  particle attributes; the arithmetic is identical to that of the
+  per-particle integration, so results do not depend on the path used.
+*/
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief First order integration of the velocity, velocity seen and
+ *        displacement SDEs for a block of spherical particles.
+ *
+ * Per-component arrays are stored by blocks, so that the value for
+ * component j of particle i is at index j*CS_LAGR_SDE_BLOCK_SIZE + i.
+ *
+ * The transcendental function calls, which are not vectorized, are
+ * separated from the arithmetic, which is.
+ *
+ * \param[in]       n         number of particles in block
+ *                            (at most CS_LAGR_SDE_BLOCK_SIZE)
+ * \param[in]       dtp       time step
+ * \param[in]       taup      dynamic characteristic time
+ * \param[in]       tlag      fluid characteristic time
+ * \param[in]       tci       piil * tlag + fluid velocity
+ * \param[in]       force     taup times forces on particles
+ * \param[in]       bx        turbulence characteristics
+ * \param[in]       vagaus    gaussian random variables
+ * \param[in, out]  vel       particle velocity (previous -> new)
+ * \param[in, out]  vel_seen  velocity seen (previous -> new)
+ * \param[out]      displ     particle displacement
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_sde_kernel_order_1(cs_lnum_t          n,
+                           cs_real_t          dtp,
+                           const cs_real_t    taup[restrict],
+                           const cs_real_t    tlag[restrict],
+                           const cs_real_t    tci[restrict],
+                           const cs_real_t    force[restrict],
+                           const cs_real_t    bx[restrict],
+                           const cs_real_3_t  vagaus[restrict],
+                           cs_real_t          vel[restrict],
+                           cs_real_t          vel_seen[restrict],
+                           cs_real_t          displ[restrict])
+{
+  const cs_lnum_t b_size = CS_LAGR_SDE_BLOCK_SIZE;
+  const cs_real_t epzero = cs_math_epzero;
+
+  cs_real_t aux1[CS_LAGR_SDE_BLOCK_SIZE], aux2[CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_t aux3[CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_t p11[CS_LAGR_SDE_BLOCK_SIZE], p21[CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_t p22[CS_LAGR_SDE_BLOCK_SIZE], p31[CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_t p32[CS_LAGR_SDE_BLOCK_SIZE], p33[CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_t gaome[CS_LAGR_SDE_BLOCK_SIZE], omega2[CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_t grga2[CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_t q21[CS_LAGR_SDE_BLOCK_SIZE], q3x[CS_LAGR_SDE_BLOCK_SIZE];
+
+  assert(n <= b_size);
+
+  /* The particle relaxation factor is shared by all components */
+
+# pragma omp simd
+  for (cs_lnum_t i = 0; i < n; i++)
+    aux1[i] = exp(-dtp / taup[i]);
+
+  for (int id = 0; id < 3; id++) {
+
+    const cs_real_t *restrict tl = tlag + id*b_size;
+    const cs_real_t *restrict b = bx + id*b_size;
+    const cs_real_t *restrict tc = tci + id*b_size;
+    const cs_real_t *restrict f = force + id*b_size;
+    const cs_real_3_t *restrict g = vagaus + id*b_size;
+    cs_real_t *restrict up = vel + id*b_size;
+    cs_real_t *restrict us = vel_seen + id*b_size;
+    cs_real_t *restrict dx = displ + id*b_size;
+
+#   pragma omp simd
+    for (cs_lnum_t i = 0; i < n; i++)
+      aux2[i] = exp(-dtp / tl[i]);
+
+    /* Stochastic integral on the flow-seen velocity */
+
+#   pragma omp simd
+    for (cs_lnum_t i = 0; i < n; i++) {
+      cs_real_t aux6 = cs_math_pow2(b[i]) * tl[i];
+      cs_real_t gama2 = 0.5 * (1.0 - aux2[i] * aux2[i]);
+      p11[i] = gama2 * aux6;
+    }
+
+#   pragma omp simd
+    for (cs_lnum_t i = 0; i < n; i++)
+      p11[i] = sqrt(p11[i]);
+
+    /* Stochastic integrals on the particle velocity and position */
+
+#   pragma omp simd
+    for (cs_lnum_t i = 0; i < n; i++) {
+
+      const cs_real_t tp = taup[i];
+      const cs_real_t a1 = aux1[i], a2 = aux2[i];
+
+      /* Guarded denominator (the quotient is discarded when p11 vanishes) */
+      const cs_real_t d11 = (p11[i] > epzero) ? p11[i] : 1.0;
+
+      cs_real_t a3 = tl[i] / (tl[i] - tp);
+      cs_real_t aux4 = tl[i] / (tl[i] + tp);
+      cs_real_t aux5 = tl[i] * (1.0 - a2);
+      cs_real_t aux6 = cs_math_pow2(b[i]) * tl[i];
+      cs_real_t aux7 = tl[i] - tp;
+      cs_real_t aux8 = cs_math_pow2(b[i]) * cs_math_pow2(a3);
+      cs_real_t aa = tp * (1.0 - a1);
+
+      cs_real_t aux9  = 0.5 * tl[i] * (1.0 - a2 * a2);
+      cs_real_t aux10 = 0.5 * tp * (1.0 - a1 * a1);
+      cs_real_t aux11 = tp * tl[i] * (1.0 - a1 * a2) / (tp + tl[i]);
+
+      cs_real_t gagam = (aux9 - aux11) * (aux8 / a3);
+
+      grga2[i] = (aux9 - 2.0 * aux11 + aux10) * aux8;
+      q21[i] = gagam / d11;
+
+      gaome[i] = (  (tl[i] - tp) * (aux5 - aa)
+                  - tl[i] * aux9
+                  - tp * aux10
+                  + (tl[i] + tp) * aux11)
+                 * aux8;
+      cs_real_t omegam = a3 * (  (tl[i] - tp) * (1.0 - a2)
+                               - 0.5 * tl[i] * (1.0 - a2 * a2)
+                               + cs_math_pow2(tp) / (tl[i] + tp)
+                                 * (1.0 - a1 * a2)) * aux6;
+      cs_real_t o2 =   aux7 * (aux7 * dtp - 2.0 * (tl[i] * aux5 - tp * aa))
+                     + 0.5 * tl[i] * tl[i] * aux5 * (1.0 + a2)
+                     + 0.5 * tp * tp * aa * (1.0 + a1)
+                     - 2.0 * aux4 * tl[i] * tp * tp * (1.0 - a1 * a2);
+      omega2[i] = aux8 * o2;
+
+      q3x[i] = omegam / d11;
+
+      aux3[i] = a3;
+    }
+
+    /* Quotients are computed unconditionally (with guarded denominators,
+       so as not to raise floating-point exceptions) and selected in
+       separate loops, so that the divisions are not made conditional
+       (which would prevent vectorization) */
+
+#   pragma omp simd
+    for (cs_lnum_t i = 0; i < n; i++) {
+      bool p11_ok = (CS_ABS(p11[i]) > epzero);
+      cs_real_t q22 = CS_MAX(0.0, grga2[i] - cs_math_pow2(q21[i]));
+      p21[i] = (p11_ok) ? q21[i] : 0.0;
+      p22[i] = (p11_ok) ? q22 : 0.0;
+      p31[i] = (p11[i] > epzero) ? q3x[i] : 0.0;
+    }
+
+#   pragma omp simd
+    for (cs_lnum_t i = 0; i < n; i++)
+      p22[i] = sqrt(p22[i]);
+
+#   pragma omp simd
+    for (cs_lnum_t i = 0; i < n; i++) {
+      const cs_real_t d22 = (p22[i] > epzero) ? p22[i] : 1.0;
+      q3x[i] = (gaome[i] - p31[i] * p21[i]) / d22;
+    }
+
+#   pragma omp simd
+    for (cs_lnum_t i = 0; i < n; i++)
+      p32[i] = (p22[i] > epzero) ? q3x[i] : 0.0;
+
+#   pragma omp simd
+    for (cs_lnum_t i = 0; i < n; i++) {
+      cs_real_t v33 = omega2[i] - cs_math_pow2(p31[i]) - cs_math_pow2(p32[i]);
+      p33[i] = CS_MAX(0.0, v33);
+    }
+
+#   pragma omp simd
+    for (cs_lnum_t i = 0; i < n; i++)
+      p33[i] = sqrt(p33[i]);
+
+    /* Final values */
+
+#   pragma omp simd
+    for (cs_lnum_t i = 0; i < n; i++) {
+
+      const cs_real_t tp = taup[i];
+      const cs_real_t a1 = aux1[i], a2 = aux2[i], a3 = aux3[i];
+
+      cs_real_t aux5 = tl[i] * (1.0 - a2);
+
+      /* Trajectory terms */
+
+      cs_real_t aa = tp * (1.0 - a1);
+      cs_real_t bb = (aux5 - aa) * a3;
+      cs_real_t cc = dtp - aa - bb;
+
+      cs_real_t ter1x = aa * up[i];
+      cs_real_t ter2x = bb * us[i];
+      cs_real_t ter3x = cc * tc[i];
+      cs_real_t ter4x = (dtp - aa) * f[i];
+      cs_real_t ter5x =   p31[i] * g[i][0] + p32[i] * g[i][1]
+                        + p33[i] * g[i][2];
+
+      /* Flow-seen velocity terms */
+
+      cs_real_t ter1f = us[i] * a2;
+      cs_real_t ter2f = tc[i] * (1.0 - a2);
+      cs_real_t ter3f = p11[i] * g[i][0];
+
+      /* Particle velocity terms */
+
+      cs_real_t dd = a3 * (a2 - a1);
+      cs_real_t ee = 1.0 - a1;
+
+      cs_real_t ter1p = up[i] * a1;
+      cs_real_t ter2p = us[i] * dd;
+      cs_real_t ter3p = tc[i] * (ee - dd);
+      cs_real_t ter4p = f[i] * ee;
+      cs_real_t ter5p = p21[i] * g[i][0] + p22[i] * g[i][1];
+
+      dx[i] = ter1x + ter2x + ter3x + ter4x + ter5x;
+      us[i] = ter1f + ter2f + ter3f;
+      up[i] = ter1p + ter2p + ter3p + ter4p + ter5p;
+
+    }
+
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
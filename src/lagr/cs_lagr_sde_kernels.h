@@ -0,0 +1,90 @@
+#ifndef __CS_LAGR_SDE_KERNELS_H__
+#define __CS_LAGR_SDE_KERNELS_H__
+
+/*============================================================================
+ * Batched kernels for the integration of particle SDEs.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*============================================================================
+ * Macro definitions
+ *============================================================================*/
+
+/*
+ * Number of particles gathered in a block for batched SDE integration.
+ */
+
+#define CS_LAGR_SDE_BLOCK_SIZE 128
+
+/*============================================================================
+ * Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief First order integration of the velocity, velocity seen and
+ *        displacement SDEs for a block of spherical particles.
+ *
+ * Per-component arrays are stored by blocks, so that the value for
+ * component j of particle i is at index j*CS_LAGR_SDE_BLOCK_SIZE + i.
+ *
+ * \param[in]       n         number of particles in block
+ *                            (at most CS_LAGR_SDE_BLOCK_SIZE)
+ * \param[in]       dtp       time step
+ * \param[in]       taup      dynamic characteristic time
+ * \param[in]       tlag      fluid characteristic time
+ * \param[in]       tci       piil * tlag + fluid velocity
+ * \param[in]       force     taup times forces on particles
+ * \param[in]       bx        turbulence characteristics
+ * \param[in]       vagaus    gaussian random variables
+ * \param[in, out]  vel       particle velocity (previous -> new)
+ * \param[in, out]  vel_seen  velocity seen (previous -> new)
+ * \param[out]      displ     particle displacement
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_sde_kernel_order_1(cs_lnum_t          n,
+                           cs_real_t          dtp,
+                           const cs_real_t    taup[restrict],
+                           const cs_real_t    tlag[restrict],
+                           const cs_real_t    tci[restrict],
+                           const cs_real_t    force[restrict],
+                           const cs_real_t    bx[restrict],
+                           const cs_real_3_t  vagaus[restrict],
+                           cs_real_t          vel[restrict],
+                           cs_real_t          vel_seen[restrict],
+                           cs_real_t          displ[restrict]);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_LAGR_SDE_KERNELS_H__ */
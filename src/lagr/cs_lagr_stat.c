@@ -42,6 +42,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(HAVE_OPENMP)
+#include <omp.h>
+#endif
+
 /*----------------------------------------------------------------------------
  *  Local headers
  *----------------------------------------------------------------------------*/
@@ -59,6 +63,7 @@
 #include "cs_order.h"
 #include "cs_parall.h"
 #include "cs_restart_default.h"
+#include "cs_scratch.h"
 #include "cs_timer_stats.h"
 #include "cs_time_step.h"
 
@@ -66,6 +71,7 @@
 #include "cs_array_reduce.h"
 #include "cs_field.h"
 #include "cs_field_pointer.h"
+#include "cs_load_balance.h"
 
 #include "cs_lagr_tracking.h"
 #include "cs_lagr.h"
@@ -244,6 +250,18 @@ typedef struct {
 
 } cs_lagr_moment_input_t;
 
+/* Particle-based moment update helper structure */
+
+typedef struct {
+
+  const cs_lagr_moment_t  *mt;        /* Associated moment */
+  int                      attr_id;   /* Associated particle attribute id */
+  cs_real_t               *val;       /* Moment values */
+  cs_real_t               *mean_val;  /* Associated mean values for variance
+                                         moments, NULL otherwise */
+
+} cs_lagr_moment_update_t;
+
 /*============================================================================
  * Local structure definitions
  *============================================================================*/
@@ -2814,9 +2832,245 @@ _location_attr(int location_id)
   return location_attr;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Compute particle range bounds for a local thread, aligned on
+ *        cell boundaries for a particle set sorted by cell.
+ *
+ * When called inside an OpenMP parallel section, this will return the
+ * start and past-the-end particle ids for the range assigned to that thread,
+ * so that particles of a given cell are all handled by the same thread.
+ * In other cases, the start id is 0, and the past-the-end id is n_particles.
+ *
+ * \param[in]   p_set     associated particle set
+ * \param[in]   cell_idx  index of particles by cell
+ * \param[out]  s_id      start id for the current thread
+ * \param[out]  e_id      past-the-end id for the current thread
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_cell_aligned_thread_range(const cs_lagr_particle_set_t  *p_set,
+                           const cs_lnum_t                cell_idx[],
+                           cs_lnum_t                     *s_id,
+                           cs_lnum_t                     *e_id)
+{
+  const cs_lnum_t n = p_set->n_particles;
+
+#if defined(HAVE_OPENMP)
+  int t_id = omp_get_thread_num();
+  int n_t = omp_get_num_threads();
+  cs_lnum_t t_n = (n + n_t - 1) / n_t;
+  cs_lnum_t b_id[2] = {t_id*t_n, (t_id+1)*t_n};
+
+  /* Move bounds back to the start of the matching cell, so that
+     adjacent threads share the same bounds */
+
+  for (int i = 0; i < 2; i++) {
+    if (b_id[i] >= n)
+      b_id[i] = n;
+    else if (b_id[i] > 0) {
+      cs_lnum_t cell_id = cs_lagr_particles_get_lnum(p_set, b_id[i],
+                                                     CS_LAGR_CELL_ID);
+      b_id[i] = cell_idx[cell_id];
+    }
+  }
+
+  *s_id = b_id[0];
+  *e_id = b_id[1];
+#else
+  CS_UNUSED(cell_idx);
+  *s_id = 0;
+  *e_id = n;
+#endif
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Update all particle-based moments associated with a given weight
+ *        accumulator for a range of particles.
+ *
+ * All moments are updated in a single pass on particles, so particle weights
+ * are computed only once. For a given cell, particles are handled in
+ * increasing id order, so results do not depend on the partitioning of
+ * particles, as long as all particles of a given cell are in the same range.
+ *
+ * \param[in]       p_set      associated particle set
+ * \param[in]       mwa        associated weight accumulator
+ * \param[in]       n_moments  number of associated moments
+ * \param[in]       mu         associated moment update info
+ * \param[in]       s_id       start particle id
+ * \param[in]       e_id       past-the-end particle id
+ * \param[in]       dt_val     cell time step values
+ * \param[in]       dt_mult    0 for uniform time step, 1 for local
+ * \param[in, out]  wa_sum     weight accumulator values
+ * \param[in, out]  pval_buf   buffer for computed particle values
+ */
+/*----------------------------------------------------------------------------*/
+
+static void
+_update_particle_moments(const cs_lagr_particle_set_t   *p_set,
+                         const cs_lagr_moment_wa_t      *mwa,
+                         int                             n_moments,
+                         const cs_lagr_moment_update_t   mu[],
+                         cs_lnum_t                       s_id,
+                         cs_lnum_t                       e_id,
+                         const cs_real_t                 dt_val[],
+                         cs_lnum_t                       dt_mult,
+                         cs_real_t                      *restrict wa_sum,
+                         cs_real_t                      *pval_buf)
+{
+  const cs_lagr_attribute_map_t *p_am = p_set->p_am;
+
+  for (cs_lnum_t part = s_id; part < e_id; part++) {
+
+    unsigned char *particle = p_set->p_buffer + p_am->extents * part;
+
+    cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_am,
+                                                  CS_LAGR_CELL_ID);
+
+    int p_class = 0;
+    if (p_am->displ[0][CS_LAGR_STAT_CLASS] > 0)
+      p_class = cs_lagr_particle_get_lnum(particle, p_am, CS_LAGR_STAT_CLASS);
+
+    if (cell_id < 0 || (p_class != mwa->class && mwa->class != 0))
+      continue;
+
+    /* weight associated to current particle */
+
+    cs_real_t p_weight;
+
+    if (mwa->p_data_func == NULL)
+      p_weight = cs_lagr_particle_get_real(particle, p_am,
+                                           CS_LAGR_STAT_WEIGHT);
+    else
+      mwa->p_data_func(mwa->data_input, particle, p_am, &p_weight);
+    p_weight *= dt_val[cell_id*dt_mult];
+
+    /* Case where accumulator has no moments */
+
+    if (n_moments == 0) {
+      if (p_weight > 1e-100)
+        wa_sum[cell_id] += p_weight;
+      continue;
+    }
+
+    /* new weight for the cell: weight attached to
+       current particle (=dt*weight) plus old weight */
+
+    const cs_real_t wa_sum_c = wa_sum[cell_id];
+    const cs_real_t wa_sum_n = CS_MAX(p_weight + wa_sum_c, 1e-100);
+
+    for (int m_id = 0; m_id < n_moments; m_id++) {
+
+      const cs_lagr_moment_t *mt = mu[m_id].mt;
+      cs_real_t *restrict val = mu[m_id].val;
+      cs_real_t *restrict mean_val = mu[m_id].mean_val;
+
+      const cs_real_t *pval = pval_buf;
+      if (mt->p_data_func == NULL)
+        pval = cs_lagr_particle_attr_const(particle, p_am, mu[m_id].attr_id);
+      else
+        mt->p_data_func(mt->data_input, particle, p_am, pval_buf);
+
+      if (mt->m_type == CS_LAGR_MOMENT_VARIANCE) {
+
+        if (mt->dim == 6) { /* variance-covariance matrix */
+
+          assert(mt->data_dim == 3);
+
+          double delta[3], delta_n[3], r[3], m_n[3];
+
+          for (int l = 0; l < 3; l++) {
+
+            cs_lnum_t jl = cell_id*6 + l;
+            cs_lnum_t jml = cell_id*3 + l;
+            delta[l]   = pval[l] - mean_val[jml];
+            r[l] = delta[l] * (p_weight / wa_sum_n);
+            m_n[l] = mean_val[jml] + r[l];
+            delta_n[l] = pval[l] - m_n[l];
+            val[jl] = (  val[jl]*wa_sum_c
+                       + p_weight*delta[l]*delta_n[l]) / wa_sum_n;
+
+          }
+
+          /* Covariance terms.
+             Note we could have a symmetric formula using
+             0.5*(delta[i]*delta_n[j] + delta[j]*delta_n[i])
+             instead of
+             delta[i]*delta_n[j]
+             but unit tests in cs_moment_test.c do not seem to favor
+             one variant over the other; we use the simplest one.  */
+
+          cs_lnum_t j3 = cell_id*6 + 3,
+                    j4 = cell_id*6 + 4,
+                    j5 = cell_id*6 + 5;
+
+          val[j3] = (  val[j3]*wa_sum_c
+                     + p_weight*delta[0]*delta_n[1]) / wa_sum_n;
+          val[j4] = (  val[j4]*wa_sum_c
+                     + p_weight*delta[1]*delta_n[2]) / wa_sum_n;
+          val[j5] = (  val[j5]*wa_sum_c
+                     + p_weight*delta[0]*delta_n[2]) / wa_sum_n;
+
+          /* update mean value */
+
+          for (cs_lnum_t l = 0; l < 3; l++)
+            mean_val[cell_id*3 + l] += r[l];
+
+        }
+
+        else { /* simple variance */
+
+          const cs_lnum_t dim = mt->dim;
+
+          for (cs_lnum_t l = 0; l < dim; l++) {
+
+            double delta = pval[l] - mean_val[cell_id*dim+l];
+            double r = delta * (p_weight / wa_sum_n);
+            double m_n = mean_val[cell_id*dim+l] + r;
+
+            val[cell_id*dim+l]
+              = (  val[cell_id*dim+l]*wa_sum_c
+                 + (p_weight*delta*(pval[l]-m_n))) / wa_sum_n;
+
+            /* update mean value */
+
+            mean_val[cell_id*dim+l] += r;
+
+          }
+
+        }
+
+      }
+
+      else if (mt->m_type == CS_LAGR_MOMENT_MEAN) {
+
+        const cs_lnum_t dim = mt->dim;
+
+        for (cs_lnum_t l = 0; l < dim; l++)
+          val[cell_id*dim+l] +=   (pval[l] - val[cell_id*dim+l])
+                                * p_weight / wa_sum_n;
+
+      } /* End of test if moment is a variance or a mean */
+
+    } /* End of loop on moments */
+
+    /* update weight accumulator */
+
+    wa_sum[cell_id] += p_weight;
+
+  } /* End of loop on particles */
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Update all particle-based moment and time moment accumulators.
+ *
+ * All particle-based moments sharing a weight accumulator are updated in
+ * a single pass on particles. When particles are sorted by cell, that
+ * pass is threaded, with particles of a given cell handled by a single
+ * thread, so no cell value is updated concurrently.
  */
 /*----------------------------------------------------------------------------*/
 
@@ -2828,6 +3082,9 @@ _cs_lagr_stat_update_all(void)
   const cs_real_t *dt_val = _dt_val();
   cs_lnum_t dt_mult = (cs_glob_time_step->is_local) ? 1 : 0;
 
+  const cs_lnum_t *cell_idx
+    = cs_lagr_particle_set_get_cell_index(p_set, cs_glob_mesh->n_cells);
+
   /* First, update mesh-based statistics */
 
   _cs_lagr_stat_update_mesh_stats(ts);
@@ -2850,11 +3107,7 @@ _cs_lagr_stat_update_all(void)
     _ensure_init_wa(mwa);
     cs_real_t *g_wa_sum = _mwa_val(mwa);
 
-    const cs_lnum_t n_w_elts = cs_mesh_location_get_n_elts(mwa->location_id)[0];
-
-    /* Local weight array allocation */
-
-    cs_real_t *restrict l_wa_sum = NULL;
+    cs_scratch_mark_t s_mark = cs_scratch_mark();
 
     /* Compute mesh-based weight now if applicable
        (possibly sharing it across moments) */
@@ -2862,7 +3115,13 @@ _cs_lagr_stat_update_all(void)
     cs_real_t m_w0[1];
     cs_real_t *restrict m_weight = _compute_current_weight_m(mwa, dt_val, m_w0);
 
-    /* Loop on variances first, then means */
+    /* Update mesh-based moments, and select particle-based moments;
+       loop on variances first, then means, so that means updated
+       with their matching variance are not selected again. */
+
+    int n_p_moments = 0, max_data_dim = 0;
+    cs_lagr_moment_update_t *mu;
+    CS_SCRATCH_ALLOC(mu, _n_lagr_moments, cs_lagr_moment_update_t);
 
     for (int m_type = CS_LAGR_MOMENT_VARIANCE;
          m_type >= (int)CS_LAGR_MOMENT_MEAN;
@@ -2878,186 +3137,37 @@ _cs_lagr_stat_update_all(void)
             && mwa->nt_start <= ts->nt_cur
             && mt->nt_cur < ts->nt_cur) {
 
-          int attr_id = cs_lagr_stat_type_to_attr_id(mt->stat_type);
-
           _ensure_init_moment(mt);
 
-          /* Copy weight sum content to a local array
-             for every new moment inside the current class */
-
-          if (m_weight == NULL && l_wa_sum == NULL)
-            BFT_MALLOC(l_wa_sum, n_w_elts, cs_real_t);
-
-          for (cs_lnum_t j = 0; j < n_w_elts; j++)
-            l_wa_sum[j] = g_wa_sum[j];
-
           /* Case where data is particle-based */
           /*-----------------------------------*/
 
           if (mt->m_data_func == NULL) {
 
-            cs_field_t *f = cs_field_by_id(mt->f_id);
-            cs_real_t *restrict val = f->val;
+            assert(mt->class == mwa->class);
 
-            /* prepare submoment definition */
+            cs_lagr_moment_update_t *_mu = mu + n_p_moments;
+            n_p_moments += 1;
 
-            cs_lagr_moment_t *mt_mean = NULL;
-            cs_real_t *restrict mean_val = NULL;
+            _mu->mt = mt;
+            _mu->attr_id = cs_lagr_stat_type_to_attr_id(mt->stat_type);
+            _mu->val = cs_field_by_id(mt->f_id)->val;
+            _mu->mean_val = NULL;
 
             /* Check if lower moment is defined and attached */
 
             if (mt->m_type == CS_LAGR_MOMENT_VARIANCE) {
               assert(mt->l_id > -1);
-              mt_mean = _lagr_moments + mt->l_id;
+              cs_lagr_moment_t *mt_mean = _lagr_moments + mt->l_id;
               _ensure_init_moment(mt_mean);
-
-              cs_field_t *f_mean = cs_field_by_id(mt_mean->f_id);
-              mean_val = f_mean->val;
+              _mu->mean_val = cs_field_by_id(mt_mean->f_id)->val;
+              mt_mean->nt_cur = ts->nt_cur;
             }
 
-            cs_real_t *pval = NULL;
             if (mt->p_data_func != NULL)
-              BFT_MALLOC(pval, mt->data_dim, cs_real_t);
-
-            for (cs_lnum_t part = 0; part < p_set->n_particles; part++) {
-
-              unsigned char *particle
-                = p_set->p_buffer + p_set->p_am->extents * part;
-
-              cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_set->p_am,
-                                                            CS_LAGR_CELL_ID);
-
-              int p_class = 0;
-              if (p_set->p_am->displ[0][CS_LAGR_STAT_CLASS] > 0)
-                p_class = cs_lagr_particle_get_lnum(particle,
-                                                    p_set->p_am,
-                                                    CS_LAGR_STAT_CLASS);
-
-              if (cell_id >= 0 && (p_class == mt->class || mt->class == 0)) {
-
-                /* weight associated to current particle */
-
-                cs_real_t p_weight;
-
-                if (mwa->p_data_func == NULL)
-                  p_weight = cs_lagr_particle_get_real(particle,
-                                                       p_set->p_am,
-                                                       CS_LAGR_STAT_WEIGHT);
-                else
-                  mwa->p_data_func(mwa->data_input,
-                                   particle,
-                                   p_set->p_am,
-                                   &p_weight);
-                p_weight *= dt_val[cell_id*dt_mult];
-
-                if (mt->p_data_func == NULL)
-                  pval = cs_lagr_particle_attr(particle, p_set->p_am, attr_id);
-                else
-                  mt->p_data_func(mt->data_input, particle, p_set->p_am, pval);
-
-                /* update weight sum with new particle weight */
-                const cs_real_t wa_sum_n = CS_MAX(p_weight + l_wa_sum[cell_id],
-                                                  1e-100);
-
-                if (mt->m_type == CS_LAGR_MOMENT_VARIANCE) {
-
-                  if (mt->dim == 6) { /* variance-covariance matrix */
-
-                    assert(mt->data_dim == 3);
-
-                    double delta[3], delta_n[3], r[3], m_n[3];
-
-                    for (int l = 0; l < 3; l++) {
-
-                      cs_lnum_t jl = cell_id*6 + l;
-                      cs_lnum_t jml = cell_id*3 + l;
-                      delta[l]   = pval[l] - mean_val[jml];
-                      r[l] = delta[l] * (p_weight / wa_sum_n);
-                      m_n[l] = mean_val[jml] + r[l];
-                      delta_n[l] = pval[l] - m_n[l];
-                      val[jl] = (  val[jl]*l_wa_sum[cell_id]
-                                 + p_weight*delta[l]*delta_n[l]) / wa_sum_n;
-
-                    }
-
-                    /* Covariance terms.
-                       Note we could have a symmetric formula using
-                       0.5*(delta[i]*delta_n[j] + delta[j]*delta_n[i])
-                       instead of
-                       delta[i]*delta_n[j]
-                       but unit tests in cs_moment_test.c do not seem to favor
-                       one variant over the other; we use the simplest one.  */
-
-                    cs_lnum_t j3 = cell_id*6 + 3,
-                              j4 = cell_id*6 + 4,
-                              j5 = cell_id*6 + 5;
-
-                    val[j3] = (  val[j3]*l_wa_sum[cell_id]
-                               + p_weight*delta[0]*delta_n[1]) / wa_sum_n;
-                    val[j4] = (  val[j4]*l_wa_sum[cell_id]
-                               + p_weight*delta[1]*delta_n[2]) / wa_sum_n;
-                    val[j5] = (  val[j5]*l_wa_sum[cell_id]
-                               + p_weight*delta[0]*delta_n[2]) / wa_sum_n;
-
-                    /* update mean value */
-
-                    for (cs_lnum_t l = 0; l < 3; l++)
-                      mean_val[cell_id*3 + l] += r[l];
-
-                  }
-
-                  else { /* simple variance */
-
-                    /* new weight for the cell: weight attached to
-                       current particle (=dt*weight) plus old weight */
-
-                    const cs_lnum_t dim = mt->dim;
-
-                    for (cs_lnum_t l = 0; l < dim; l++) {
-
-                      double delta = pval[l] - mean_val[cell_id*dim+l];
-                      double r = delta * (p_weight / wa_sum_n);
-                      double m_n = mean_val[cell_id*dim+l] + r;
-
-                      val[cell_id*dim+l]
-                        = (  val[cell_id*dim+l]*l_wa_sum[cell_id]
-                           + (p_weight*delta*(pval[l]-m_n))) / wa_sum_n;
-
-                      /* update mean value */
-
-                      mean_val[cell_id*dim+l] += r;
-
-                    }
-
-                  }
-
-                }
-
-                else if (mt->m_type == CS_LAGR_MOMENT_MEAN) {
-
-                  const cs_lnum_t dim = mt->dim;
-
-                  for (cs_lnum_t l = 0; l < dim; l++)
-                    val[cell_id*dim+l] +=   (pval[l] - val[cell_id*dim+l])
-                                          * p_weight / wa_sum_n;
-
-                } /* End of test if moment is a variance or a mean */
-
-                /* update local weight associated to current moment and class */
-
-                l_wa_sum[cell_id] += p_weight;
-
-              } /* End of test if particle is in a cell
-                   and if particle class corresponds to moment class */
-
-            } /* end of loop on particles */
-
-            if (mt->p_data_func != NULL)
-              BFT_FREE(pval);
+              max_data_dim = CS_MAX(max_data_dim, mt->data_dim);
 
             mt->nt_cur = ts->nt_cur;
-            if (mt->m_type == CS_LAGR_MOMENT_VARIANCE)
-              mt_mean->nt_cur = ts->nt_cur;
           }
 
           /* Case where data is mesh-based */
@@ -3071,67 +3181,54 @@ _cs_lagr_stat_update_all(void)
 
         } /* end of test if moment is for the current class */
 
-      } /* End of loop on moment types */
+      } /* End of loop on moments */
 
-    } /* End of loop on moments */
+    } /* End of loop on moment types */
 
-    /* At end of loop on moments inside a class, update
-       global class weight array */
+    /* Update global class weight array, and particle-based moments
+       if present */
 
-    if (l_wa_sum != NULL) {
-      for (cs_lnum_t i = 0; i < n_w_elts; i++)
-        g_wa_sum[i] = l_wa_sum[i];
-      BFT_FREE(l_wa_sum);
-    }
-    else if (m_weight != NULL) {
+    if (m_weight != NULL) {
+      assert(n_p_moments == 0);
       _update_wa_m(mwa, m_weight);
       if (m_weight != m_w0)
         BFT_FREE(m_weight);
     }
-    else if (n_w_elts > 0) { /* Case where accumulator has no moments */
 
-      for (cs_lnum_t part = 0; part < p_set->n_particles; part++) {
+    else if (cell_idx != NULL) {
 
-        unsigned char *particle
-          = p_set->p_buffer + p_set->p_am->extents * part;
+#     pragma omp parallel if (p_set->n_particles > CS_THR_MIN)
+      {
+        cs_lnum_t s_id, e_id;
+        _cell_aligned_thread_range(p_set, cell_idx, &s_id, &e_id);
 
-        cs_lnum_t cell_id = cs_lagr_particle_get_lnum(particle, p_set->p_am,
-                                                      CS_LAGR_CELL_ID);
+        cs_scratch_mark_t t_mark = cs_scratch_mark();
 
-        int p_class = 0;
-        if (p_set->p_am->displ[0][CS_LAGR_STAT_CLASS] > 0)
-          p_class = cs_lagr_particle_get_lnum(particle,
-                                              p_set->p_am,
-                                              CS_LAGR_STAT_CLASS);
+        cs_real_t *pval_buf;
+        CS_SCRATCH_ALLOC(pval_buf, max_data_dim, cs_real_t);
 
-        if (cell_id >= 0 && (p_class == mwa->class || mwa->class == 0)) {
+        _update_particle_moments(p_set, mwa, n_p_moments, mu,
+                                 s_id, e_id, dt_val, dt_mult,
+                                 g_wa_sum, pval_buf);
 
-          /* weight associated to current particle */
-
-          cs_real_t p_weight;
-
-          if (mwa->p_data_func == NULL)
-            p_weight = cs_lagr_particle_get_real(particle,
-                                                 p_set->p_am,
-                                                 CS_LAGR_STAT_WEIGHT);
-          else
-            mwa->p_data_func(mwa->data_input,
-                             particle,
-                             p_set->p_am,
-                             &p_weight);
-          p_weight *= dt_val[cell_id*dt_mult];
+        cs_scratch_release(t_mark);
+      }
 
-          /* update accumulator weight */
+    }
 
-          if (p_weight > 1e-100)
-            g_wa_sum[cell_id] += p_weight;
+    else {
 
-        }
+      cs_real_t *pval_buf;
+      CS_SCRATCH_ALLOC(pval_buf, max_data_dim, cs_real_t);
 
-      } /* end of loop on particles */
+      _update_particle_moments(p_set, mwa, n_p_moments, mu,
+                               0, p_set->n_particles, dt_val, dt_mult,
+                               g_wa_sum, pval_buf);
 
     }
 
+    cs_scratch_release(s_mark);
+
   } /* End of loop on active weight accumulators */
 }
 
@@ -4374,6 +4471,52 @@ cs_lagr_stat_map_cell_dt(const cs_real_t  *dt)
   _p_dt = dt;
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Redistribute statistics weight accumulators during a mesh
+ *        redistribution (see cs_load_balance.c).
+ *
+ * Moments and accumulators stored as fields are migrated with other fields.
+ * Other accumulators defined on base mesh locations are migrated here;
+ * those defined on other mesh locations are resized, and their accumulation
+ * restarted.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_stat_redistribute(void)
+{
+  const cs_time_step_t  *ts = cs_glob_time_step;
+
+  for (int i = 0; i < _n_lagr_moments_wa; i++) {
+    cs_lagr_moment_wa_t *mwa = _lagr_moments_wa + i;
+    if (   mwa->location_id == CS_MESH_LOCATION_NONE
+        || mwa->f_id > -1 || mwa->val == NULL)
+      continue;
+    if (mwa->location_id <= CS_MESH_LOCATION_VERTICES) {
+      void *p = mwa->val;
+      cs_load_balance_redistribute_array(mwa->location_id,
+                                         CS_REAL_TYPE,
+                                         1,
+                                         &p);
+      mwa->val = p;
+    }
+    else {
+      cs_lnum_t n_w_elts = cs_mesh_location_get_n_elts(mwa->location_id)[0];
+      BFT_REALLOC(mwa->val, n_w_elts, cs_real_t);
+      for (cs_lnum_t j = 0; j < n_w_elts; j++)
+        mwa->val[j] = 0.;
+      mwa->nt_start = ts->nt_cur;
+      mwa->t_start = ts->t_cur;
+    }
+  }
+
+  /* Mapped time step is a field value array, which was reallocated */
+
+  if (_p_dt != NULL)
+    _p_dt = CS_F_(dt)->val;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Lagrangian statistics initialization.
@@ -4681,6 +4824,9 @@ cs_lagr_stat_prepare(void)
 void
 cs_lagr_stat_update(void)
 {
+  int t_stat_id = cs_timer_stats_id_by_name("particle_statistics_stage");
+  int t_top_id = cs_timer_stats_switch(t_stat_id);
+
   /* Update statistics for events first */
 
   cs_lagr_event_set_t *bi_events = cs_lagr_event_set_boundary_interaction();
@@ -4705,6 +4851,8 @@ cs_lagr_stat_update(void)
 
   _cs_lagr_stat_set_active_event_time(CS_LAGR_STAT_GROUP_TRACKING_EVENT,
                                       ts->nt_cur-1);
+
+  cs_timer_stats_switch(t_top_id);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -577,6 +577,16 @@ cs_lagr_stat_type_by_name(const char  *name);
 void
 cs_lagr_stat_map_cell_dt(const cs_real_t  *dt);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Redistribute statistics weight accumulators during a mesh
+ *        redistribution (see cs_load_balance.c).
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_stat_redistribute(void);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Lagrangian statistics initialization.
@@ -0,0 +1,470 @@
+/*============================================================================
+ * Block-distributed particle attribute stream files.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(HAVE_MPI)
+#include <mpi.h>
+#endif
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "bft_error.h"
+#include "bft_mem.h"
+
+#include "cs_block_dist.h"
+#include "cs_file.h"
+#include "cs_io.h"
+
+/*----------------------------------------------------------------------------
+ *  Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_lagr_stream.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*=============================================================================
+ * Additional doxygen documentation
+ *============================================================================*/
+
+/*!
+  \file cs_lagr_stream.c
+
+  Particle attribute stream files use the kernel IO format, with
+  a "n_particles" section, "nt_cur" and "t_cur" sections for the associated
+  time, and one "particles:<name>" section per attribute, each holding
+  the values of all particles, interleaved if an attribute has several
+  components. They are written and read using block-distributed file
+  access, so that neither an export mesh nor a global gather is needed.
+  Particles are numbered in the order of the writing ranks.
+
+  Such files may be dumped using the \c cs_io_dump tool, and read back
+  using \ref cs_lagr_stream_open and \ref cs_lagr_stream_read.
+*/
+
+/*! \cond DOXYGEN_SHOULD_SKIP_THIS */
+
+/*=============================================================================
+ * Local Macro definitions
+ *============================================================================*/
+
+#define CS_LAGR_STREAM_MAGIC "Lagrangian particle stream, R0"
+
+/*============================================================================
+ * Type definitions
+ *============================================================================*/
+
+struct _cs_lagr_stream_t {
+
+  cs_io_t    *fh;              /* Associated kernel IO file */
+
+  cs_gnum_t   n_g_particles;   /* Global number of particles */
+  cs_gnum_t   g_range[2];      /* Global number range of local particles */
+
+  int         nt_cur;          /* Associated time step number */
+  double      t_cur;           /* Associated physical time */
+
+};
+
+/*============================================================================
+ * Private function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Build the section name associated with an attribute.
+ *
+ * parameters:
+ *   name     <-- attribute name
+ *   sec_name --> section name
+ *----------------------------------------------------------------------------*/
+
+static void
+_sec_name(const char  *name,
+          char         sec_name[64])
+{
+  snprintf(sec_name, 63, "particles:%s", name);
+  sec_name[63] = '\0';
+}
+
+/*----------------------------------------------------------------------------
+ * Position a stream file opened for reading at an indexed section.
+ *
+ * parameters:
+ *   s        <-> pointer to particle stream structure
+ *   sec_name <-- section name
+ *   header   --> section header
+ *
+ * returns:
+ *   0 in case of success, 1 if the section is not present
+ *----------------------------------------------------------------------------*/
+
+static int
+_set_section(cs_lagr_stream_t    *s,
+             const char          *sec_name,
+             cs_io_sec_header_t  *header)
+{
+  size_t n_sections = cs_io_get_index_size(s->fh);
+
+  for (size_t i = 0; i < n_sections; i++) {
+    if (strcmp(cs_io_get_indexed_sec_name(s->fh, i), sec_name) == 0)
+      return cs_io_set_indexed_position(s->fh, header, i);
+  }
+
+  return 1;
+}
+
+/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Create a particle stream file for writing.
+ *
+ * Local particles are assigned a contiguous block of global numbers,
+ * ranks being ordered by id.
+ *
+ * This is a collective operation.
+ *
+ * \param[in]  path         file path
+ * \param[in]  n_particles  number of local particles
+ * \param[in]  nt_cur       associated time step number
+ * \param[in]  t_cur        associated physical time
+ *
+ * \return  pointer to particle stream structure
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_lagr_stream_t *
+cs_lagr_stream_create(const char  *path,
+                      cs_lnum_t    n_particles,
+                      int          nt_cur,
+                      double       t_cur)
+{
+  cs_lagr_stream_t *s = NULL;
+  BFT_MALLOC(s, 1, cs_lagr_stream_t);
+
+  s->n_g_particles = n_particles;
+  s->g_range[0] = 1;
+  s->g_range[1] = n_particles + 1;
+  s->nt_cur = nt_cur;
+  s->t_cur = t_cur;
+
+  cs_file_access_t  method;
+
+#if defined(HAVE_MPI)
+
+  if (cs_glob_n_ranks > 1) {
+    cs_gnum_t n_l_particles = n_particles, g_end = 0;
+    MPI_Scan(&n_l_particles, &g_end, 1, CS_MPI_GNUM, MPI_SUM,
+             cs_glob_mpi_comm);
+    s->g_range[0] = g_end - n_l_particles + 1;
+    s->g_range[1] = g_end + 1;
+    MPI_Allreduce(&n_l_particles, &(s->n_g_particles), 1, CS_MPI_GNUM,
+                  MPI_SUM, cs_glob_mpi_comm);
+  }
+
+  MPI_Info  hints;
+  cs_file_get_default_access(CS_FILE_MODE_WRITE, &method, &hints);
+  s->fh = cs_io_initialize(path,
+                           CS_LAGR_STREAM_MAGIC,
+                           CS_IO_MODE_WRITE,
+                           method,
+                           CS_IO_ECHO_NONE,
+                           hints,
+                           cs_glob_mpi_comm,
+                           cs_glob_mpi_comm);
+
+#else
+
+  cs_file_get_default_access(CS_FILE_MODE_WRITE, &method);
+  s->fh = cs_io_initialize(path,
+                           CS_LAGR_STREAM_MAGIC,
+                           CS_IO_MODE_WRITE,
+                           method,
+                           CS_IO_ECHO_NONE);
+
+#endif
+
+  cs_io_write_global("n_particles", 1, 1, 0, 1, CS_GNUM_TYPE,
+                     &(s->n_g_particles), s->fh);
+  cs_io_write_global("nt_cur", 1, 0, 0, 1, CS_INT_TYPE, &nt_cur, s->fh);
+  cs_io_write_global("t_cur", 1, 0, 0, 1, CS_DOUBLE, &t_cur, s->fh);
+
+  return s;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Open a particle stream file for reading.
+ *
+ * Particles are distributed over ranks in blocks, based on the default
+ * file rank step and minimum block size.
+ *
+ * This is a collective operation.
+ *
+ * \param[in]  path  file path
+ *
+ * \return  pointer to particle stream structure
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_lagr_stream_t *
+cs_lagr_stream_open(const char  *path)
+{
+  cs_lagr_stream_t *s = NULL;
+  BFT_MALLOC(s, 1, cs_lagr_stream_t);
+
+  int rank_step = 1, min_block_size = 0;
+  cs_file_access_t  method;
+
+#if defined(HAVE_MPI)
+
+  MPI_Info  hints;
+  MPI_Comm  block_comm, comm;
+
+  cs_file_get_default_comm(&rank_step, &min_block_size, &block_comm, &comm);
+  cs_file_get_default_access(CS_FILE_MODE_READ, &method, &hints);
+
+  s->fh = cs_io_initialize_with_index(path,
+                                      CS_LAGR_STREAM_MAGIC,
+                                      method,
+                                      CS_IO_ECHO_NONE,
+                                      hints,
+                                      block_comm,
+                                      comm);
+
+#else
+
+  cs_file_get_default_access(CS_FILE_MODE_READ, &method);
+
+  s->fh = cs_io_initialize_with_index(path,
+                                      CS_LAGR_STREAM_MAGIC,
+                                      method,
+                                      CS_IO_ECHO_NONE);
+
+#endif
+
+  /* Metadata */
+
+  cs_io_sec_header_t  header;
+
+  s->n_g_particles = 0;
+  s->nt_cur = -1;
+  s->t_cur = 0.;
+
+  if (_set_section(s, "n_particles", &header) != 0)
+    bft_error(__FILE__, __LINE__, 0,
+              _("File \"%s\":\n"
+                "missing \"%s\" section."), path, "n_particles");
+
+  cs_io_set_cs_gnum(&header, s->fh);
+  cs_io_read_global(&header, &(s->n_g_particles), s->fh);
+
+  if (_set_section(s, "nt_cur", &header) == 0) {
+    cs_io_set_int(&header, s->fh);
+    cs_io_read_global(&header, &(s->nt_cur), s->fh);
+  }
+
+  if (_set_section(s, "t_cur", &header) == 0) {
+    if (header.type_read != CS_DOUBLE)
+      bft_error(__FILE__, __LINE__, 0,
+                _("File \"%s\":\n"
+                  "unexpected datatype for section \"%s\"."), path, "t_cur");
+    cs_io_read_global(&header, &(s->t_cur), s->fh);
+  }
+
+  /* Block distribution (minimum size based on coordinates) */
+
+  cs_block_dist_info_t bi
+    = cs_block_dist_compute_sizes(CS_MAX(cs_glob_rank_id, 0),
+                                  cs_glob_n_ranks,
+                                  rank_step,
+                                  min_block_size / (3*sizeof(cs_real_t)),
+                                  s->n_g_particles);
+
+  s->g_range[0] = bi.gnum_range[0];
+  s->g_range[1] = bi.gnum_range[1];
+
+  return s;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Close a particle stream file and free the associated structure.
+ *
+ * This is a collective operation.
+ *
+ * \param[in, out]  s  pointer to particle stream structure pointer
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_stream_destroy(cs_lagr_stream_t  **s)
+{
+  cs_lagr_stream_t *_s = *s;
+
+  if (_s == NULL)
+    return;
+
+  cs_io_finalize(&(_s->fh));
+
+  BFT_FREE(*s);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Query particle stream file metadata.
+ *
+ * Any of the output arguments may be NULL.
+ *
+ * \param[in]   s              pointer to particle stream structure
+ * \param[out]  n_g_particles  global number of particles
+ * \param[out]  n_particles    number of local particles
+ * \param[out]  nt_cur         associated time step number
+ * \param[out]  t_cur          associated physical time
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_stream_get_info(const cs_lagr_stream_t  *s,
+                        cs_gnum_t               *n_g_particles,
+                        cs_lnum_t               *n_particles,
+                        int                     *nt_cur,
+                        double                  *t_cur)
+{
+  if (n_g_particles != NULL)
+    *n_g_particles = s->n_g_particles;
+  if (n_particles != NULL)
+    *n_particles = s->g_range[1] - s->g_range[0];
+  if (nt_cur != NULL)
+    *nt_cur = s->nt_cur;
+  if (t_cur != NULL)
+    *t_cur = s->t_cur;
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Write values of a particle attribute to a stream file.
+ *
+ * Values are byte-swapped in place if needed, so their contents
+ * are undefined after this call.
+ *
+ * This is a collective operation.
+ *
+ * \param[in]       s         pointer to particle stream structure
+ * \param[in]       name      attribute name
+ * \param[in]       datatype  datatype of values
+ * \param[in]       stride    number of values per particle
+ * \param[in, out]  values    local particle values (size: n_particles*stride)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_stream_write(cs_lagr_stream_t  *s,
+                     const char        *name,
+                     cs_datatype_t      datatype,
+                     int                stride,
+                     void              *values)
+{
+  char sec_name[64];
+  _sec_name(name, sec_name);
+
+  cs_io_write_block_buffer(sec_name,
+                           s->n_g_particles,
+                           s->g_range[0],
+                           s->g_range[1],
+                           1,
+                           0,
+                           stride,
+                           datatype,
+                           values,
+                           s->fh);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Read values of a particle attribute from a stream file.
+ *
+ * This is a collective operation.
+ *
+ * \param[in]   s         pointer to particle stream structure
+ * \param[in]   name      attribute name
+ * \param[in]   datatype  expected datatype of values
+ * \param[in]   stride    expected number of values per particle
+ * \param[out]  values    local particle values (size: n_particles*stride)
+ *
+ * \return  0 in case of success, 1 if the attribute is not present
+ */
+/*----------------------------------------------------------------------------*/
+
+int
+cs_lagr_stream_read(cs_lagr_stream_t  *s,
+                    const char        *name,
+                    cs_datatype_t      datatype,
+                    int                stride,
+                    void              *values)
+{
+  char sec_name[64];
+  _sec_name(name, sec_name);
+
+  cs_io_sec_header_t  header;
+
+  if (_set_section(s, sec_name, &header) != 0)
+    return 1;
+
+  if (   header.type_read != datatype
+      || header.n_location_vals != (size_t)stride
+      || (cs_gnum_t)header.n_vals != s->n_g_particles*stride)
+    bft_error(__FILE__, __LINE__, 0,
+              _("File \"%s\":\n"
+                "section \"%s\" does not match the expected datatype\n"
+                "and number of values per particle (%d)."),
+              cs_io_get_name(s->fh), sec_name, stride);
+
+  cs_io_read_block(&header, s->g_range[0], s->g_range[1], values, s->fh);
+
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
@@ -0,0 +1,175 @@
+#ifndef __CS_LAGR_STREAM_H__
+#define __CS_LAGR_STREAM_H__
+
+/*============================================================================
+ * Block-distributed particle attribute stream files.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*============================================================================
+ * Type definitions
+ *============================================================================*/
+
+/* Opaque particle stream file structure */
+
+typedef struct _cs_lagr_stream_t  cs_lagr_stream_t;
+
+/*=============================================================================
+ * Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Create a particle stream file for writing.
+ *
+ * Local particles are assigned a contiguous block of global numbers,
+ * ranks being ordered by id.
+ *
+ * This is a collective operation.
+ *
+ * \param[in]  path         file path
+ * \param[in]  n_particles  number of local particles
+ * \param[in]  nt_cur       associated time step number
+ * \param[in]  t_cur        associated physical time
+ *
+ * \return  pointer to particle stream structure
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_lagr_stream_t *
+cs_lagr_stream_create(const char  *path,
+                      cs_lnum_t    n_particles,
+                      int          nt_cur,
+                      double       t_cur);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Open a particle stream file for reading.
+ *
+ * Particles are distributed over ranks in blocks, based on the default
+ * file rank step and minimum block size.
+ *
+ * This is a collective operation.
+ *
+ * \param[in]  path  file path
+ *
+ * \return  pointer to particle stream structure
+ */
+/*----------------------------------------------------------------------------*/
+
+cs_lagr_stream_t *
+cs_lagr_stream_open(const char  *path);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Close a particle stream file and free the associated structure.
+ *
+ * This is a collective operation.
+ *
+ * \param[in, out]  s  pointer to particle stream structure pointer
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_stream_destroy(cs_lagr_stream_t  **s);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Query particle stream file metadata.
+ *
+ * Any of the output arguments may be NULL.
+ *
+ * \param[in]   s              pointer to particle stream structure
+ * \param[out]  n_g_particles  global number of particles
+ * \param[out]  n_particles    number of local particles
+ * \param[out]  nt_cur         associated time step number
+ * \param[out]  t_cur          associated physical time
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_stream_get_info(const cs_lagr_stream_t  *s,
+                        cs_gnum_t               *n_g_particles,
+                        cs_lnum_t               *n_particles,
+                        int                     *nt_cur,
+                        double                  *t_cur);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Write values of a particle attribute to a stream file.
+ *
+ * Values are byte-swapped in place if needed, so their contents
+ * are undefined after this call.
+ *
+ * This is a collective operation.
+ *
+ * \param[in]       s         pointer to particle stream structure
+ * \param[in]       name      attribute name
+ * \param[in]       datatype  datatype of values
+ * \param[in]       stride    number of values per particle
+ * \param[in, out]  values    local particle values (size: n_particles*stride)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_stream_write(cs_lagr_stream_t  *s,
+                     const char        *name,
+                     cs_datatype_t      datatype,
+                     int                stride,
+                     void              *values);
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Read values of a particle attribute from a stream file.
+ *
+ * This is a collective operation.
+ *
+ * \param[in]   s         pointer to particle stream structure
+ * \param[in]   name      attribute name
+ * \param[in]   datatype  expected datatype of values
+ * \param[in]   stride    expected number of values per particle
+ * \param[out]  values    local particle values (size: n_particles*stride)
+ *
+ * \return  0 in case of success, 1 if the attribute is not present
+ */
+/*----------------------------------------------------------------------------*/
+
+int
+cs_lagr_stream_read(cs_lagr_stream_t  *s,
+                    const char        *name,
+                    cs_datatype_t      datatype,
+                    int                stride,
+                    void              *values);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_LAGR_STREAM_H__ */
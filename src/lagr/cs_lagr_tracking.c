@@ -69,6 +69,7 @@
 #include "cs_porous_model.h"
 #include "cs_random.h"
 #include "cs_rotation.h"
+#include "cs_scratch.h"
 #include "cs_search.h"
 #include "cs_timer_stats.h"
 #include "cs_turbomachinery.h"
@@ -79,6 +80,7 @@
 #include "cs_lagr.h"
 #include "cs_lagr_deposition_model.h"
 #include "cs_lagr_event.h"
+#include "cs_lagr_geom.h"
 #include "cs_lagr_particle.h"
 #include "cs_lagr_prototypes.h"
 #include "cs_lagr_post.h"
@@ -184,8 +186,8 @@ typedef struct {
   unsigned char  *send_buf;
 
 #if defined(HAVE_MPI)
-  MPI_Request  *request;
-  MPI_Status   *status;
+  MPI_Request  *request;      /* counter receive and send, particle send
+                                 and receive requests (n_c_domains each) */
 #endif
 
 } cs_lagr_halo_t;
@@ -209,6 +211,21 @@ typedef struct {
 
 } cs_lagr_track_builder_t;
 
+/* Local propagation parameters, so that particles received from other
+   ranks may be tracked as soon as they are available */
+
+typedef struct {
+
+  cs_lagr_event_set_t  *events;                /* events structure, or NULL */
+  int                   displacement_step_id;  /* id of displacement step */
+  int                   failsafe_mode;         /* with (0) / without (1)
+                                                  failure capability */
+  const int            *b_face_zone_id;        /* boundary face zone id */
+  const cs_real_t      *visc_length;           /* viscous layer thickness */
+  const cs_field_t     *u;                     /* fluid velocity field */
+
+} cs_lagr_propagation_t;
+
 /*============================================================================
  * Static global variables
  *============================================================================*/
@@ -219,6 +236,10 @@ static  cs_lagr_track_builder_t  *_particle_track_builder = NULL;
 
 static  int            _max_propagation_loops = 100;
 
+/* Reduction batch for displacement completion check */
+
+static  cs_parall_batch_t  *_sync_batch = NULL;
+
 /* MPI datatype associated to each particle "structure" */
 
 #if defined(HAVE_MPI)
@@ -502,10 +523,9 @@ _create_lagr_halo(size_t  extents)
 #if defined(HAVE_MPI)
   if (cs_glob_n_ranks > 1) {
 
-    cs_lnum_t  request_size = 2 * halo->n_c_domains;
+    cs_lnum_t  request_size = 4 * halo->n_c_domains;
 
     BFT_MALLOC(lagr_halo->request, request_size, MPI_Request);
-    BFT_MALLOC(lagr_halo->status,  request_size, MPI_Status);
 
   }
 #endif
@@ -607,7 +627,6 @@ _delete_lagr_halo(cs_lagr_halo_t   **halo)
 #if defined(HAVE_MPI)
     if (cs_glob_n_ranks > 1) {
       BFT_FREE(h->request);
-      BFT_FREE(h->status);
     }
 #endif
 
@@ -1867,9 +1886,6 @@ _local_propagation(cs_lagr_particle_set_t         *particles,
   const cs_mesh_t  *mesh = cs_glob_mesh;
   const cs_mesh_quantities_t  *fvq = cs_glob_mesh_quantities;
 
-  const cs_real_3_t *restrict b_face_normal
-    = (const cs_real_3_t *restrict)fvq->b_face_normal;
-
   const cs_real_3_t *restrict i_face_cog
     = (const cs_real_3_t *restrict)fvq->i_face_cog;
   const cs_real_3_t *restrict b_face_cog
@@ -1972,9 +1988,9 @@ _local_propagation(cs_lagr_particle_set_t         *particles,
         cs_real_t *fluid_vel = &(u->val[cell_id*3]);
         cs_real_t fluid_vel_proj[3];
 
-        /* normal vector coordinates */
-        cs_real_3_t normal;
-        cs_math_3_normalise(b_face_normal[*neighbor_face_id], normal);
+        /* unit normal: first row of the local frame projection matrix */
+        const cs_real_t *normal
+          = cs_glob_lagr_b_face_proj[*neighbor_face_id][0];
 
         /* (V . n) * n  */
         cs_real_t v_dot_n = cs_math_3_dot_product(particle_velocity_seen, normal);
@@ -2205,9 +2221,9 @@ _local_propagation(cs_lagr_particle_set_t         *particles,
             cs_real_t *fluid_vel = &(u->val[cell_id*3]);
             cs_real_t fluid_vel_proj[3];
 
-            /* normal vector coordinates */
-            cs_real_3_t normal;
-            cs_math_3_normalise(b_face_normal[*neighbor_face_id], normal);
+            /* unit normal: first row of the local frame projection matrix */
+            const cs_real_t *normal
+              = cs_glob_lagr_b_face_proj[*neighbor_face_id][0];
 
             /* (V . n) * n  */
             cs_real_t v_dot_n = cs_math_3_dot_product(particle_velocity_seen, normal);
@@ -2270,29 +2286,76 @@ _local_propagation(cs_lagr_particle_set_t         *particles,
 }
 
 /*----------------------------------------------------------------------------
- * Exchange counters on the number of particles to send and to receive
+ * Move particles of a given range which need to be tracked as far as
+ * possible while remaining on the local rank.
+ *
+ * parameters:
+ *   particles <-> pointer to particle set
+ *   prop      <-- local propagation parameters
+ *   s_id      <-- id of first particle in range
+ *   e_id      <-- past-the-end id of particles in range
+ *----------------------------------------------------------------------------*/
+
+static void
+_propagate_particles(cs_lagr_particle_set_t       *particles,
+                     const cs_lagr_propagation_t  *prop,
+                     cs_lnum_t                     s_id,
+                     cs_lnum_t                     e_id)
+{
+  for (cs_lnum_t i = s_id; i < e_id; i++) {
+
+    cs_lagr_tracking_state_t cur_part_state
+      = _get_tracking_info(particles, i)->state;
+
+    if (cur_part_state == CS_LAGR_PART_TO_SYNC) {
+
+      /* Main particle displacement stage */
+
+      cur_part_state = _local_propagation(particles,
+                                          prop->events,
+                                          i,
+                                          prop->displacement_step_id,
+                                          prop->failsafe_mode,
+                                          prop->b_face_zone_id,
+                                          prop->visc_length,
+                                          prop->u);
+
+      _tracking_info(particles, i)->state = cur_part_state;
+
+    }
+
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Start exchange of counters on the number of particles to send and
+ * to receive.
+ *
+ * Requests are completed by _finish_counter_exchange.
  *
  * parameters:
  *  halo        <--  pointer to a cs_halo_t structure
- *  lag_halo    <--  pointer to a cs_lagr_halo_t structure
+ *  lag_halo    <->  pointer to a cs_lagr_halo_t structure
  *----------------------------------------------------------------------------*/
 
 static void
-_exchange_counter(const cs_halo_t  *halo,
-                  cs_lagr_halo_t   *lag_halo)
+_start_counter_exchange(const cs_halo_t  *halo,
+                        cs_lagr_halo_t   *lag_halo)
 {
   int local_rank_id = (cs_glob_n_ranks == 1) ? 0 : -1;
 
 #if defined(HAVE_MPI)
   if (cs_glob_n_ranks > 1) {
 
-    int  rank;
-    int  request_count = 0;
     const int  local_rank = cs_glob_rank_id;
+    const int  n_c_domains = halo->n_c_domains;
+
+    MPI_Request  *recv_request = lag_halo->request;
+    MPI_Request  *send_request = lag_halo->request + n_c_domains;
 
     /* Receive data from distant ranks */
 
-    for (rank = 0; rank < halo->n_c_domains; rank++) {
+    for (int rank = 0; rank < n_c_domains; rank++) {
 
       if (halo->c_domain_rank[rank] != local_rank)
         MPI_Irecv(&(lag_halo->recv_count[rank]),
@@ -2301,22 +2364,17 @@ _exchange_counter(const cs_halo_t  *halo,
                   halo->c_domain_rank[rank],
                   halo->c_domain_rank[rank],
                   cs_glob_mpi_comm,
-                  &(lag_halo->request[request_count++]));
-      else
+                  &(recv_request[rank]));
+      else {
+        recv_request[rank] = MPI_REQUEST_NULL;
         local_rank_id = rank;
+      }
 
     }
 
-    /* We wait for posting all receives
-       (often recommended in the past, apparently not anymore) */
-
-#if 0
-    MPI_Barrier(cs_glob_mpi_comm)
-#endif
-
     /* Send data to distant ranks */
 
-    for (rank = 0; rank < halo->n_c_domains; rank++) {
+    for (int rank = 0; rank < n_c_domains; rank++) {
 
       /* If this is not the local rank */
 
@@ -2327,14 +2385,12 @@ _exchange_counter(const cs_halo_t  *halo,
                   halo->c_domain_rank[rank],
                   local_rank,
                   cs_glob_mpi_comm,
-                  &(lag_halo->request[request_count++]));
+                  &(send_request[rank]));
+      else
+        send_request[rank] = MPI_REQUEST_NULL;
 
     }
 
-    /* Wait for all exchanges */
-
-    MPI_Waitall(request_count, lag_halo->request, lag_halo->status);
-
   }
 #endif /* defined(HAVE_MPI) */
 
@@ -2343,16 +2399,135 @@ _exchange_counter(const cs_halo_t  *halo,
   if (halo->n_transforms > 0)
     if (local_rank_id > -1)
       lag_halo->recv_count[local_rank_id] = lag_halo->send_count[local_rank_id];
+}
+
+/*----------------------------------------------------------------------------
+ * Complete exchange of counters on the number of particles to receive,
+ * and resize the particle set accordingly.
+ *
+ * parameters:
+ *  halo        <--  pointer to a cs_halo_t structure
+ *  lag_halo    <->  pointer to a cs_lagr_halo_t structure
+ *  particles   <->  set of particles to update
+ *----------------------------------------------------------------------------*/
+
+static void
+_finish_counter_exchange(const cs_halo_t         *halo,
+                         cs_lagr_halo_t          *lag_halo,
+                         cs_lagr_particle_set_t  *particles)
+{
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1)
+    MPI_Waitall(2*halo->n_c_domains, lag_halo->request, MPI_STATUSES_IGNORE);
+#endif
+
+  cs_lnum_t  n_recv_particles = 0;
+
+  for (int i = 0; i < halo->n_c_domains; i++) {
+    lag_halo->recv_shift[i] = n_recv_particles;
+    n_recv_particles += lag_halo->recv_count[i];
+  }
+
+  /* Resize particle set only if needed */
+
+  cs_lagr_particle_set_resize(particles->n_particles + n_recv_particles);
+}
+
+/*----------------------------------------------------------------------------
+ * Start sending particles to distant ranks.
+ *
+ * Requests are completed by _exchange_particles.
+ *
+ * parameters:
+ *  halo      <-- pointer to a cs_halo_t structure
+ *  lag_halo  <-> pointer to a cs_lagr_halo_t structure
+ *----------------------------------------------------------------------------*/
+
+static void
+_start_particle_sends(const cs_halo_t  *halo,
+                      cs_lagr_halo_t   *lag_halo)
+{
+#if defined(HAVE_MPI)
+
+  if (cs_glob_n_ranks > 1) {
+
+    const int  local_rank = cs_glob_rank_id;
+    const size_t tot_extents = lag_halo->extents;
+
+    MPI_Request  *send_request = lag_halo->request + 2*halo->n_c_domains;
+
+    for (int rank = 0; rank < halo->n_c_domains; rank++) {
 
+      /* If this is not the local rank */
+
+      if (   halo->c_domain_rank[rank] != local_rank
+          && lag_halo->send_count[rank] > 0) {
+        cs_lnum_t shift = lag_halo->send_shift[rank];
+        void  *send_buf = lag_halo->send_buf + tot_extents*shift;
+        MPI_Isend(send_buf,
+                  lag_halo->send_count[rank],
+                  _cs_mpi_particle_type,
+                  halo->c_domain_rank[rank],
+                  local_rank,
+                  cs_glob_mpi_comm,
+                  &(send_request[rank]));
+      }
+      else
+        send_request[rank] = MPI_REQUEST_NULL;
+
+    }
+
+  }
+
+#else
+
+  CS_UNUSED(halo);
+  CS_UNUSED(lag_halo);
+
+#endif /* defined(HAVE_MPI) */
 }
 
 /*----------------------------------------------------------------------------
- * Exchange particles
+ * Track a range of particles received from another rank (or through
+ * periodicity).
+ *
+ * parameters:
+ *  particles <-> set of particles to update
+ *  prop      <-- local propagation parameters
+ *  s_id      <-- id of first received particle
+ *  e_id      <-- past-the-end id of received particles
+ *----------------------------------------------------------------------------*/
+
+static void
+_track_received_particles(cs_lagr_particle_set_t       *particles,
+                          const cs_lagr_propagation_t  *prop,
+                          cs_lnum_t                     s_id,
+                          cs_lnum_t                     e_id)
+{
+  for (cs_lnum_t i = s_id; i < e_id; i++)
+    _tracking_info(particles, i)->state = CS_LAGR_PART_TO_SYNC;
+
+  /* Received particles belong to the next displacement step */
+
+  cs_lagr_propagation_t  r_prop = *prop;
+  r_prop.displacement_step_id += 1;
+
+  _propagate_particles(particles, &r_prop, s_id, e_id);
+}
+
+/*----------------------------------------------------------------------------
+ * Receive particles, and track them as they become available.
+ *
+ * Particles received from each rank are tracked in rank order, while
+ * messages from following ranks are still in flight, so that results do
+ * not depend on message arrival order. The particle set only includes
+ * particles received so far when a given range is tracked.
  *
  * parameters:
  *  halo      <-- pointer to a cs_halo_t structure
  *  lag_halo  <-> pointer to a cs_lagr_halo_t structure
- *  particles <-- set of particles to update
+ *  particles <-> set of particles to update
+ *  prop      <-- local propagation parameters
  *----------------------------------------------------------------------------*/
 
 #if defined(__INTEL_COMPILER)
@@ -2362,147 +2537,146 @@ _exchange_counter(const cs_halo_t  *halo,
 #endif
 
 static void
-_exchange_particles(const cs_halo_t         *halo,
-                    cs_lagr_halo_t          *lag_halo,
-                    cs_lagr_particle_set_t  *particles)
+_exchange_particles(const cs_halo_t              *halo,
+                    cs_lagr_halo_t               *lag_halo,
+                    cs_lagr_particle_set_t       *particles,
+                    const cs_lagr_propagation_t  *prop)
 {
   int local_rank_id = (cs_glob_n_ranks == 1) ? 0 : -1;
 
   const size_t tot_extents = lag_halo->extents;
+  const int  n_c_domains = halo->n_c_domains;
+
+  const cs_lnum_t  n_prev_particles = particles->n_particles;
 
   cs_lnum_t  n_recv_particles = 0;
+  for (int rank = 0; rank < n_c_domains; rank++)
+    n_recv_particles += lag_halo->recv_count[rank];
+
+  /* The particle set was resized by _finish_counter_exchange */
 
 #if defined(HAVE_MPI)
 
+  MPI_Request  *send_request = NULL, *recv_request = NULL;
+
   if (cs_glob_n_ranks > 1) {
 
-    int  rank;
-    int  request_count = 0;
     const int  local_rank = cs_glob_rank_id;
 
-    /* Receive data from distant ranks */
+    send_request = lag_halo->request + 2*n_c_domains;
+    recv_request = lag_halo->request + 3*n_c_domains;
 
-    for (rank = 0; rank < halo->n_c_domains; rank++) {
+    /* Receive data from distant ranks */
 
-      cs_lnum_t shift =   particles->n_particles
-                        + lag_halo->recv_shift[rank];
+    for (int rank = 0; rank < n_c_domains; rank++) {
 
-      if (lag_halo->recv_count[rank] > 0) {
+      recv_request[rank] = MPI_REQUEST_NULL;
 
-        if (halo->c_domain_rank[rank] != local_rank) {
-          void  *recv_buf = particles->p_buffer + tot_extents*shift;
-          n_recv_particles += lag_halo->recv_count[rank];
-          MPI_Irecv(recv_buf,
-                    lag_halo->recv_count[rank],
-                    _cs_mpi_particle_type,
-                    halo->c_domain_rank[rank],
-                    halo->c_domain_rank[rank],
-                    cs_glob_mpi_comm,
-                    &(lag_halo->request[request_count++]));
-        }
-        else
-          local_rank_id = rank;
+      if (halo->c_domain_rank[rank] == local_rank)
+        local_rank_id = rank;
 
+      else if (lag_halo->recv_count[rank] > 0) {
+        cs_lnum_t shift = n_prev_particles + lag_halo->recv_shift[rank];
+        void  *recv_buf = particles->p_buffer + tot_extents*shift;
+        MPI_Irecv(recv_buf,
+                  lag_halo->recv_count[rank],
+                  _cs_mpi_particle_type,
+                  halo->c_domain_rank[rank],
+                  halo->c_domain_rank[rank],
+                  cs_glob_mpi_comm,
+                  &(recv_request[rank]));
       }
 
     }
 
-    /* We wait for posting all receives
-       (often recommended in the past, apparently not anymore) */
-
-#if 0
-    MPI_Barrier(cs_glob_mpi_comm);
-#endif
-
-    /* Send data to distant ranks */
-
-    for (rank = 0; rank < halo->n_c_domains; rank++) {
-
-      /* If this is not the local rank */
+  }
 
-      if (   halo->c_domain_rank[rank] != local_rank
-          && lag_halo->send_count[rank] > 0) {
-        cs_lnum_t shift = lag_halo->send_shift[rank];
-        void  *send_buf = lag_halo->send_buf + tot_extents*shift;
-        MPI_Isend(send_buf,
-                  lag_halo->send_count[rank],
-                  _cs_mpi_particle_type,
-                  halo->c_domain_rank[rank],
-                  local_rank,
-                  cs_glob_mpi_comm,
-                  &(lag_halo->request[request_count++]));
+#endif /* defined(HAVE_MPI) */
 
-      }
+  /* Track received particles, in rank order */
 
-    }
+  for (int rank = 0; rank < n_c_domains; rank++) {
 
-    /* Wait for all exchanges */
+    const cs_lnum_t  s_id = n_prev_particles + lag_halo->recv_shift[rank];
+    const cs_lnum_t  n_recv = lag_halo->recv_count[rank];
 
-    MPI_Waitall(request_count, lag_halo->request, lag_halo->status);
+    if (n_recv < 1)
+      continue;
 
-  }
-#endif /* defined(HAVE_MPI) */
+    /* Copy local values in case of periodicity */
 
-  /* Copy local values in case of periodicity */
+    if (rank == local_rank_id) {
 
-  if (halo->n_transforms > 0) {
-    if (local_rank_id > -1) {
+      if (halo->n_transforms == 0)
+        continue;
 
-      cs_lnum_t  recv_shift =   particles->n_particles
-                              + lag_halo->recv_shift[local_rank_id];
       cs_lnum_t  send_shift = lag_halo->send_shift[local_rank_id];
 
-      assert(   lag_halo->recv_count[local_rank_id]
-             == lag_halo->send_count[local_rank_id]);
-
-      n_recv_particles += lag_halo->send_count[local_rank_id];
+      assert(n_recv == lag_halo->send_count[local_rank_id]);
 
-      for (cs_lnum_t i = 0; i < lag_halo->send_count[local_rank_id]; i++) {
-        memcpy(particles->p_buffer + tot_extents*(recv_shift + i),
+      for (cs_lnum_t i = 0; i < n_recv; i++) {
+        memcpy(particles->p_buffer + tot_extents*(s_id + i),
                lag_halo->send_buf + tot_extents*(send_shift + i),
                tot_extents);
       }
+
     }
+
+#if defined(HAVE_MPI)
+
+    else if (cs_glob_n_ranks > 1)
+      MPI_Wait(&(recv_request[rank]), MPI_STATUS_IGNORE);
+
+#endif /* defined(HAVE_MPI) */
+
+    particles->n_particles = s_id + n_recv;
+
+    _track_received_particles(particles, prop, s_id, s_id + n_recv);
+
   }
 
-  /* Update particle count and weight */
+  particles->n_particles = n_prev_particles + n_recv_particles;
 
-  cs_real_t tot_weight = 0.;
+#if defined(HAVE_MPI)
 
-  for (cs_lnum_t i = 0; i < n_recv_particles; i++) {
+  /* Wait for sends, as the send buffer may be reused */
 
-    cs_lnum_t j = particles->n_particles + i;
+  if (cs_glob_n_ranks > 1)
+    MPI_Waitall(n_c_domains, send_request, MPI_STATUSES_IGNORE);
 
-    cs_real_t cur_part_stat_weight
-      = cs_lagr_particles_get_real(particles, j, CS_LAGR_STAT_WEIGHT);
+#endif /* defined(HAVE_MPI) */
 
-    tot_weight += cur_part_stat_weight;
+  /* Update particle weight */
 
-    _tracking_info(particles, j)->state = CS_LAGR_PART_TO_SYNC;
+  cs_real_t tot_weight = 0.;
 
-  }
+  for (cs_lnum_t i = n_prev_particles; i < particles->n_particles; i++)
+    tot_weight += cs_lagr_particles_get_real(particles, i,
+                                             CS_LAGR_STAT_WEIGHT);
 
-  particles->n_particles += n_recv_particles;
   particles->weight += tot_weight;
 }
 
 /*----------------------------------------------------------------------------
- * Determine particle halo sizes
+ * Determine particle halo send sizes, and start exchange of counters.
  *
  * parameters:
  *   mesh      <-- pointer to associated mesh
  *   lag_halo  <-> pointer to particle halo structure to update
  *   particles <-- set of particles to update
+ *
+ * returns:
+ *   number of particles to send
  *----------------------------------------------------------------------------*/
 
-static void
+static cs_lnum_t
 _lagr_halo_count(const cs_mesh_t               *mesh,
                  cs_lagr_halo_t                *lag_halo,
                  const cs_lagr_particle_set_t  *particles)
 {
   cs_lnum_t  i, ghost_id;
 
-  cs_lnum_t  n_recv_particles = 0, n_send_particles = 0;
+  cs_lnum_t  n_send_particles = 0;
 
   const cs_halo_t  *halo = mesh->halo;
 
@@ -2529,51 +2703,44 @@ _lagr_halo_count(const cs_mesh_t               *mesh,
 
   } /* End of loop on particles */
 
-  /* Exchange counters */
+  /* Start exchange of counters */
 
-  _exchange_counter(halo, lag_halo);
+  _start_counter_exchange(halo, lag_halo);
 
   for (i = 0; i < halo->n_c_domains; i++) {
-    n_recv_particles += lag_halo->recv_count[i];
+    lag_halo->send_shift[i] = n_send_particles;
     n_send_particles += lag_halo->send_count[i];
   }
 
-  lag_halo->send_shift[0] = 0;
-  lag_halo->recv_shift[0] = 0;
-
-  for (i = 1; i < halo->n_c_domains; i++) {
-
-    lag_halo->send_shift[i] =  lag_halo->send_shift[i-1]
-                             + lag_halo->send_count[i-1];
+  /* Resize halo only if needed */
 
-    lag_halo->recv_shift[i] =  lag_halo->recv_shift[i-1]
-                             + lag_halo->recv_count[i-1];
-
-  }
-
-  /* Resize particle set and/or halo only if needed */
-
-  cs_lagr_particle_set_resize(particles->n_particles + n_recv_particles);
   _resize_lagr_halo(lag_halo, n_send_particles);
+
+  return n_send_particles;
 }
 
 /*----------------------------------------------------------------------------
  * Update particle sets, including halo synchronization.
  *
+ * Particles changing domain are sent as soon as the local set is updated,
+ * and received particles are tracked as soon as they arrive. The global
+ * check for displacement completion is overlapped with these exchanges.
+ *
  * parameters:
  *   particles <-> set of particles to update
+ *   prop      <-- local propagation parameters
  *
  * returns:
  *   1 if displacement needs to continue, 0 if finished
  *----------------------------------------------------------------------------*/
 
 static int
-_sync_particle_set(cs_lagr_particle_set_t  *particles)
+_sync_particle_set(cs_lagr_particle_set_t       *particles,
+                   const cs_lagr_propagation_t  *prop)
 {
   cs_lnum_t  i, k, tr_id, rank, shift, ghost_id;
   cs_real_t matrix[3][4];
 
-  cs_lnum_t  n_recv_particles = 0;
   cs_lnum_t  particle_count = 0;
 
   cs_lnum_t  n_merged_particles = 0;
@@ -2599,16 +2766,31 @@ _sync_particle_set(cs_lagr_particle_set_t  *particles)
 
   int continue_displacement = 0;
 
+  cs_scratch_mark_t s_mark = cs_scratch_mark();
+  cs_lnum_t *send_id = NULL;
+
   if (halo != NULL) {
 
-    _lagr_halo_count(mesh, lag_halo, particles);
+    if (_lagr_halo_count(mesh, lag_halo, particles) > 0)
+      continue_displacement = 1;
+
+    /* Send counts are being exchanged, so use a separate
+       array for insertion positions in the send buffer */
 
-    for (i = 0; i < halo->n_c_domains; i++) {
-      n_recv_particles += lag_halo->recv_count[i];
-      lag_halo->send_count[i] = 0;
-    }
+    CS_SCRATCH_ALLOC(send_id, halo->n_c_domains, cs_lnum_t);
+    for (i = 0; i < halo->n_c_domains; i++)
+      send_id[i] = lag_halo->send_shift[i];
   }
 
+  /* Start global check for displacement completion */
+
+  if (_sync_batch == NULL)
+    _sync_batch = cs_parall_batch_create();
+
+  cs_parall_batch_add(_sync_batch, CS_PARALL_MAX, 1, CS_INT_TYPE,
+                      &continue_displacement);
+  cs_parall_batch_start(_sync_batch);
+
   /* Loop on particles, transferring particles to synchronize to send_buf
      for particle set, and removing particles that otherwise exited the domain */
 
@@ -2624,8 +2806,6 @@ _sync_particle_set(cs_lagr_particle_set_t  *particles)
 
     if (cur_part_state == CS_LAGR_PART_TO_SYNC_NEXT) {
 
-      continue_displacement = 1;
-
       ghost_id =   cs_lagr_particles_get_lnum(particles, i, CS_LAGR_CELL_ID)
                  - halo->n_local_elts;
       rank = lag_halo->rank[ghost_id];
@@ -2634,7 +2814,7 @@ _sync_particle_set(cs_lagr_particle_set_t  *particles)
       cs_lagr_particles_set_lnum(particles, i, CS_LAGR_CELL_ID,
                                  lag_halo->dist_cell_id[ghost_id]);
 
-      shift = lag_halo->send_shift[rank] + lag_halo->send_count[rank];
+      shift = send_id[rank];
 
       /* Update if needed last_face_num */
 
@@ -2759,7 +2939,7 @@ _sync_particle_set(cs_lagr_particle_set_t  *particles)
              particles->p_buffer + extents*i,
              extents);
 
-      lag_halo->send_count[rank] += 1;
+      send_id[rank] += 1;
 
       /* Remove the particle from the local set (do not copy it) */
 
@@ -2813,10 +2993,17 @@ _sync_particle_set(cs_lagr_particle_set_t  *particles)
 
   /* Exchange particles, then update set */
 
-  if (halo != NULL)
-    _exchange_particles(halo, lag_halo, particles);
+  if (halo != NULL) {
+    _start_particle_sends(halo, lag_halo);
+    _finish_counter_exchange(halo, lag_halo, particles);
+    _exchange_particles(halo, lag_halo, particles, prop);
+  }
+
+  cs_scratch_release(s_mark);
+
+  /* Complete global check */
 
-  cs_parall_max(1, CS_INT_TYPE, &continue_displacement);
+  cs_parall_batch_wait(_sync_batch);
 
   return continue_displacement;
 }
@@ -2941,84 +3128,26 @@ _initialize_displacement(cs_lagr_particle_set_t  *particles)
 }
 
 /*----------------------------------------------------------------------------
- * Update particle set structures: compact array.
+ * Update particle set structures: sort particles by cell.
  *
  * parameters:
  *   particles        <-> pointer to particle set structure
- *   part_b_mass_flux <-> particle mass flux array, or NULL
  *----------------------------------------------------------------------------*/
 
 static void
 _finalize_displacement(cs_lagr_particle_set_t  *particles)
 {
-  const cs_lagr_attribute_map_t  *p_am = particles->p_am;
-  const cs_lnum_t  n_cells = cs_glob_mesh->n_cells;
-
-  const cs_lnum_t n_particles = particles->n_particles;
-
-  cs_lnum_t *cell_idx;
-  unsigned char *swap_buffer;
-  size_t swap_buffer_size = p_am->extents * ((size_t)n_particles);
-
-  BFT_MALLOC(cell_idx, n_cells+1, cs_lnum_t);
-  BFT_MALLOC(swap_buffer, swap_buffer_size, unsigned char);
-
-  /* Cell index (count first) */
-
-  for (cs_lnum_t i = 0; i < n_cells+1; i++)
-    cell_idx[i] = 0;
-
-  /* Copy unordered particle data to buffer */
-
-  for (cs_lnum_t i = 0; i < n_particles; i++) {
-
+#if defined(DEBUG) && !defined(NDEBUG)
+  for (cs_lnum_t i = 0; i < particles->n_particles; i++) {
     cs_lnum_t cur_part_state = _get_tracking_info(particles, i)->state;
-
     assert(   cur_part_state < CS_LAGR_PART_OUT
            && cur_part_state != CS_LAGR_PART_TO_SYNC);
-
-    cs_lnum_t cell_id = cs_lagr_particles_get_lnum(particles, i,
-                                                   CS_LAGR_CELL_ID);
-
-    memcpy(swap_buffer + p_am->extents*i,
-           particles->p_buffer + p_am->extents*i,
-           p_am->extents);
-
-    cell_idx[cell_id+1] += 1;
-
   }
+#endif
 
-  /* Convert count to index */
-
-  for (cs_lnum_t i = 1; i < n_cells; i++)
-    cell_idx[i+1] += cell_idx[i];
-
-  assert(n_particles == cell_idx[n_cells]);
-
-  /* Now copy particle data and update some statistics */
-
-  const cs_lnum_t p_extents = particles->p_am->extents;
-  const cs_lnum_t cell_num_displ = particles->p_am->displ[0][CS_LAGR_CELL_ID];
-
-  for (cs_lnum_t i = 0; i < n_particles; i++) {
-
-    cs_lnum_t cell_id
-      = *((const cs_lnum_t *)(swap_buffer + p_extents*i + cell_num_displ));
-
-    assert(cell_id > -1);
-
-    cs_lnum_t particle_id = cell_idx[cell_id];
-
-    cell_idx[cell_id] += 1;
-
-    memcpy(particles->p_buffer + p_am->extents*particle_id,
-           swap_buffer + p_am->extents*i,
-           p_am->extents);
-
-  }
+  /* Particles which did not change cells are not moved */
 
-  BFT_FREE(swap_buffer);
-  BFT_FREE(cell_idx);
+  cs_lagr_particle_set_sort_by_cell(particles, cs_glob_mesh->n_cells);
 
 #if 0 && defined(DEBUG) && !defined(NDEBUG)
   bft_printf("\n Particle set after %s\n", __func__);
@@ -3113,47 +3242,37 @@ cs_lagr_tracking_particle_movement(const cs_real_t  visc_length[])
 
   assert(particles != NULL);
 
+  /* Particles will change cells */
+
+  particles->cell_sorted = false;
+
   const int *b_face_zone_id = cs_boundary_zone_face_class_id();
 
   _initialize_displacement(particles);
 
+  cs_lagr_propagation_t  prop = {.events = events,
+                                 .displacement_step_id = 0,
+                                 .failsafe_mode = failsafe_mode,
+                                 .b_face_zone_id = b_face_zone_id,
+                                 .visc_length = visc_length,
+                                 .u = u};
+
   /* Main loop on particles: global propagation */
 
   while (continue_displacement) {
 
-    /* Local propagation */
-
-    for (cs_lnum_t i = 0; i < particles->n_particles; i++) {
-
-      /* Local copies of the current and previous particles state vectors
-         to be used in case of the first pass of _local_propagation fails */
-
-      cs_lagr_tracking_state_t cur_part_state
-        = _get_tracking_info(particles, i)->state;
-
-      if (cur_part_state == CS_LAGR_PART_TO_SYNC) {
+    prop.displacement_step_id = displacement_step_id;
 
-        /* Main particle displacement stage */
-
-        cur_part_state = _local_propagation(particles,
-                                            events,
-                                            i,
-                                            displacement_step_id,
-                                            failsafe_mode,
-                                            b_face_zone_id,
-                                            visc_length,
-                                            u);
-
-        _tracking_info(particles, i)->state = cur_part_state;
-
-      }
+    /* Local propagation (particles received from other ranks
+       during the previous step have already been handled) */
 
-    } /* End of loop on particles */
+    _propagate_particles(particles, &prop, 0, particles->n_particles);
 
     /* Update of the particle set structure. Delete exited particles,
-       update for particles which change domain. */
+       update for particles which change domain, and track
+       received particles. */
 
-    continue_displacement = _sync_particle_set(particles);
+    continue_displacement = _sync_particle_set(particles, &prop);
 
 #if 0
     bft_printf("\n Particle set after sync\n");
@@ -3335,6 +3454,20 @@ cs_lagr_tracking_particle_movement(const cs_real_t  visc_length[])
   cs_timer_stats_switch(t_top_id);
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Discard mesh-dependent tracking structures after a mesh change.
+ *
+ * They will be rebuilt on the next particle displacement.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_tracking_update_mesh(void)
+{
+  _particle_track_builder = _destroy_track_builder(_particle_track_builder);
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Finalize Lagrangian module.
@@ -3358,6 +3491,9 @@ cs_lagr_tracking_finalize(void)
   /* Destroy builder */
   _particle_track_builder = _destroy_track_builder(_particle_track_builder);
 
+  if (_sync_batch != NULL)
+    cs_parall_batch_destroy(&_sync_batch);
+
   /* Destroy internal condition structure*/
 
   cs_lagr_finalize_internal_cond();
@@ -3414,11 +3550,12 @@ cs_lagr_test_wall_cell(const void                     *particle,
 
   cs_lnum_t  *cell_b_face_idx = cs_glob_mesh_adjacencies->cell_b_faces_idx;
   cs_lnum_t  *cell_b_faces = cs_glob_mesh_adjacencies->cell_b_faces;
-  const cs_real_3_t *restrict b_face_normal
-    = (const cs_real_3_t *restrict)cs_glob_mesh_quantities->b_face_normal;
   const cs_real_3_t *restrict b_face_cog
     = (const cs_real_3_t *restrict)cs_glob_mesh_quantities->b_face_cog;
 
+  const cs_lagr_wall_face_cache_t *wc = cs_lagr_geom_wall_face_cache();
+  assert(wc != NULL);
+
   const cs_real_t  *particle_coord
     = cs_lagr_particle_attr_const(particle, p_am, CS_LAGR_COORDS);
 
@@ -3428,17 +3565,10 @@ cs_lagr_test_wall_cell(const void                     *particle,
   for (cs_lnum_t i = start; i < end; i++) {
     cs_lnum_t f_id = cell_b_faces[i];
 
-    assert(cs_glob_lagr_boundary_conditions != NULL);
-
-    const char b_type = cs_glob_lagr_boundary_conditions->elt_type[f_id];
-
-    if (   (b_type == CS_LAGR_DEPO1)
-        || (b_type == CS_LAGR_DEPO2)
-        || (b_type == CS_LAGR_DEPO_DLVO)) {
+    if (wc->is_depo[f_id]) {
 
-      /* normal vector coordinates */
-      cs_real_3_t normal;
-      cs_math_3_normalise(b_face_normal[f_id], normal);
+      /* unit normal: first row of the local frame projection matrix */
+      const cs_real_t *normal = cs_glob_lagr_b_face_proj[f_id][0];
 
       /* [(x_f - x_p) . n ] / L */
       cs_real_t dist_norm = CS_ABS(
@@ -98,6 +98,17 @@ cs_lagr_tracking_particle_movement(const cs_real_t  visc_length[]);
 void
 cs_lagr_tracking_finalize(void);
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Discard mesh-dependent tracking structures after a mesh change.
+ *
+ * They will be rebuilt on the next particle displacement.
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_lagr_tracking_update_mesh(void);
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Determine the number of the closest wall face from the particle
@@ -292,6 +292,19 @@ module lagran
 
     !---------------------------------------------------------------------------
 
+    !> \brief Return fortran compatible pointer to source terms array
+
+    subroutine cs_lagr_map_c_arrays(dim_tslagr, p_tslagr)         &
+      bind(C, name='cs_lagr_map_c_arrays')
+      use, intrinsic ::  iso_c_binding
+
+      implicit none
+      integer(c_int), dimension(2) :: dim_tslagr
+      type(c_ptr), intent(out)     :: p_tslagr
+    end subroutine cs_lagr_map_c_arrays
+
+    !---------------------------------------------------------------------------
+
     subroutine cs_lagr_init_par ()&
       bind(C, name='cs_lagr_init_par')
 
@@ -403,6 +416,26 @@ contains
 
   !=============================================================================
 
+  ! Update mapping of auxiliary arrays after a mesh redistribution
+
+  subroutine map_lagr_arrays(tslagr)
+
+    implicit none
+
+    double precision, dimension(:,:), pointer  :: tslagr
+    integer(c_int),   dimension(2)             :: dim_tslagr
+    type(c_ptr)                                :: p_tslagr
+
+    call cs_lagr_map_c_arrays(dim_tslagr, p_tslagr)
+
+    call c_f_pointer(p_tslagr, tslagr, [dim_tslagr])
+
+    return
+
+  end subroutine map_lagr_arrays
+
+  !=============================================================================
+
   subroutine lagran_init_map
 
     use ppincl, only: iccoal, icfuel, ieljou, ielarc, icoebu, icod3p,          &
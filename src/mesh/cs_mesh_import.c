@@ -0,0 +1,2259 @@
+/*============================================================================
+ * Distributed import of external mesh formats
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------
+ * Standard C library headers
+ *----------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(HAVE_MPI)
+#include <mpi.h>
+#endif
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "bft_error.h"
+#include "bft_mem.h"
+#include "bft_printf.h"
+
+#include "cs_all_to_all.h"
+#include "cs_base.h"
+#include "cs_block_dist.h"
+#include "cs_file.h"
+#include "cs_io.h"
+#include "cs_mesh_builder.h"
+#include "cs_order.h"
+#include "cs_part_to_block.h"
+#include "cs_timer.h"
+
+/*----------------------------------------------------------------------------
+ *  Header for the current file
+ *----------------------------------------------------------------------------*/
+
+#include "cs_mesh_import.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*! \cond DOXYGEN_SHOULD_SKIP_THIS */
+
+/*=============================================================================
+ * Local Macro Definitions
+ *============================================================================*/
+
+/* Minimum size of text blocks read by a rank (bytes) */
+
+#define CS_MESH_IMPORT_MIN_TEXT_BLOCK  1048576
+
+/* Maximum length of text lines in binary files (bytes) */
+
+#define CS_MESH_IMPORT_MAX_LINE  1024
+
+/* Number of values exchanged for each face or face element:
+   sorted vertex numbers (4), oriented vertex numbers (4),
+   cell number, and group class id */
+
+#define _FACE_STRIDE 10
+
+/*=============================================================================
+ * Local Type Definitions
+ *============================================================================*/
+
+/* Gmsh section markers */
+
+typedef enum {
+
+  GMSH_MESH_FORMAT,
+  GMSH_END_MESH_FORMAT,
+  GMSH_PHYSICAL_NAMES,
+  GMSH_END_PHYSICAL_NAMES,
+  GMSH_NODES,
+  GMSH_END_NODES,
+  GMSH_ELEMENTS,
+  GMSH_END_ELEMENTS,
+  GMSH_N_MARKERS
+
+} _gmsh_marker_t;
+
+/* Data read by the local rank */
+
+typedef struct {
+
+  /* Physical names (replicated on all ranks) */
+
+  int          n_phys;
+  int         *phys_dim_tag;     /* (dimension, tag) couples */
+  char       **phys_name;
+
+  /* Nodes */
+
+  cs_lnum_t    n_nodes;
+  cs_gnum_t   *node_tag;
+  cs_real_t   *node_coords;
+
+  /* Cells (3d elements) */
+
+  cs_lnum_t    n_cells;
+  int         *cell_type;        /* base Gmsh type */
+  int         *cell_phys;        /* physical tag */
+  cs_gnum_t   *cell_vtx;         /* vertex tags, then numbers (stride 8) */
+
+  /* Face elements (2d elements) */
+
+  cs_lnum_t    n_f_elts;
+  int         *f_elt_phys;       /* physical tag */
+  cs_gnum_t   *f_elt_vtx;        /* vertex tags, then numbers (stride 4,
+                                    padded with 0) */
+
+} _gmsh_data_t;
+
+/*============================================================================
+ * Static global variables
+ *============================================================================*/
+
+static const char *_gmsh_marker_name[] = {"$MeshFormat",
+                                          "$EndMeshFormat",
+                                          "$PhysicalNames",
+                                          "$EndPhysicalNames",
+                                          "$Nodes",
+                                          "$EndNodes",
+                                          "$Elements",
+                                          "$EndElements"};
+
+/* Number of nodes, dimension, and matching linear type of Gmsh elements */
+
+#define _GMSH_N_TYPES 20
+
+static const int _gmsh_n_nodes[_GMSH_N_TYPES]
+  = {0, 2, 3, 4, 4, 8, 6, 5, 3, 6, 9, 10, 27, 18, 14, 1, 8, 20, 15, 13};
+
+static const int _gmsh_dim[_GMSH_N_TYPES]
+  = {-1, 1, 2, 2, 3, 3, 3, 3, 1, 2, 2, 3, 3, 3, 3, 0, 2, 3, 3, 3};
+
+static const int _gmsh_linear_type[_GMSH_N_TYPES]
+  = {0, 1, 2, 3, 4, 5, 6, 7, 1, 2, 3, 4, 5, 6, 7, 15, 3, 5, 6, 7};
+
+/* Number of vertices of linear elements */
+
+static const int _gmsh_n_vertices[8] = {0, 2, 3, 4, 4, 8, 6, 5};
+
+/* Faces of linear cells (tetrahedra, hexahedra, prisms, pyramids), with
+   vertices ordered so that face normals point outwards; -1 marks unused
+   positions */
+
+static const int _cell_n_faces[8] = {0, 0, 0, 0, 4, 6, 5, 5};
+
+static const int _cell_face_vtx[8][6][4]
+= {{{-1}}, {{-1}}, {{-1}}, {{-1}},
+   {{0, 2, 1, -1}, {0, 1, 3, -1}, {0, 3, 2, -1}, {1, 2, 3, -1}},
+   {{0, 3, 2, 1}, {4, 5, 6, 7}, {0, 1, 5, 4},
+    {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}},
+   {{0, 2, 1, -1}, {3, 4, 5, -1},
+    {0, 1, 4, 3}, {1, 2, 5, 4}, {2, 0, 3, 5}},
+   {{0, 3, 2, 1}, {0, 1, 4, -1}, {1, 2, 4, -1},
+    {2, 3, 4, -1}, {3, 0, 4, -1}}};
+
+/*============================================================================
+ * Private function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------
+ * Compute the exclusive prefix sum of a local count over all ranks.
+ *
+ * parameters:
+ *   n_local <-- local count
+ *   n_g     --> global count, or NULL
+ *
+ * returns:
+ *   sum of counts on previous ranks
+ *----------------------------------------------------------------------------*/
+
+static cs_gnum_t
+_exscan(cs_gnum_t   n_local,
+        cs_gnum_t  *n_g)
+{
+  cs_gnum_t shift = 0, _n_g = n_local;
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1) {
+    MPI_Scan(&n_local, &shift, 1, CS_MPI_GNUM, MPI_SUM, cs_glob_mpi_comm);
+    shift -= n_local;
+    MPI_Allreduce(&n_local, &_n_g, 1, CS_MPI_GNUM, MPI_SUM,
+                  cs_glob_mpi_comm);
+  }
+#endif
+
+  if (n_g != NULL)
+    *n_g = _n_g;
+
+  return shift;
+}
+
+/*----------------------------------------------------------------------------
+ * Distribute array values to a block distribution based on global numbers.
+ *
+ * Block values not matching any source entity are left unchanged.
+ *
+ * parameters:
+ *   bi       <-- block distribution info
+ *   n_ents   <-- number of local entities
+ *   gnum     <-- global number of local entities
+ *   datatype <-- data type
+ *   stride   <-- number of values per entity
+ *   src      <-- local values
+ *   dest     <-> block values
+ *----------------------------------------------------------------------------*/
+
+static void
+_to_block(cs_block_dist_info_t   bi,
+          cs_lnum_t              n_ents,
+          const cs_gnum_t        gnum[],
+          cs_datatype_t          datatype,
+          int                    stride,
+          const void            *src,
+          void                  *dest)
+{
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1) {
+    cs_part_to_block_t *d
+      = cs_part_to_block_create_by_gnum(cs_glob_mpi_comm, bi, n_ents, gnum);
+    cs_part_to_block_copy_array(d, datatype, stride, src, dest);
+    cs_part_to_block_destroy(&d);
+  }
+#endif
+
+  if (cs_glob_n_ranks == 1) {
+    const size_t elt_size = cs_datatype_size[datatype]*stride;
+    const unsigned char *_src = src;
+    unsigned char *_dest = dest;
+    for (cs_lnum_t i = 0; i < n_ents; i++)
+      memcpy(_dest + (gnum[i] - bi.gnum_range[0])*elt_size,
+             _src + i*elt_size,
+             elt_size);
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Open a file for block-distributed reads, using the default file access
+ * method and communicators.
+ *
+ * parameters:
+ *   path           <-- file path
+ *   file_size      --> file size (identical on all ranks)
+ *   rank_step      --> file block rank step
+ *   min_block_size --> minimum file block size (bytes), or NULL
+ *
+ * returns:
+ *   pointer to file descriptor
+ *----------------------------------------------------------------------------*/
+
+static cs_file_t *
+_open_file(const char  *path,
+           cs_gnum_t   *file_size,
+           int         *rank_step,
+           int         *min_block_size)
+{
+  cs_file_t *f = NULL;
+  cs_file_access_t method;
+
+  *file_size = 0;
+  *rank_step = 1;
+  if (min_block_size != NULL)
+    *min_block_size = 0;
+
+  if (cs_glob_rank_id < 1)
+    *file_size = cs_file_size(path);
+
+#if defined(HAVE_MPI)
+
+  MPI_Info  hints;
+  MPI_Comm  block_comm, comm;
+
+  if (cs_glob_n_ranks > 1)
+    MPI_Bcast(file_size, 1, CS_MPI_GNUM, 0, cs_glob_mpi_comm);
+
+  cs_file_get_default_comm(rank_step, min_block_size, &block_comm, &comm);
+  cs_file_get_default_access(CS_FILE_MODE_READ, &method, &hints);
+
+#else
+
+  cs_file_get_default_access(CS_FILE_MODE_READ, &method);
+
+#endif
+
+  if (*file_size == 0)
+    bft_error(__FILE__, __LINE__, 0,
+              _("File \"%s\" is empty or does not exist."), path);
+
+#if defined(HAVE_MPI)
+  f = cs_file_open(path, CS_FILE_MODE_READ, method, hints, block_comm, comm);
+#else
+  f = cs_file_open(path, CS_FILE_MODE_READ, method);
+#endif
+
+  return f;
+}
+
+/*----------------------------------------------------------------------------
+ * Read the local block of a text file.
+ *
+ * The file is read using block-distributed reads, and partial lines are
+ * exchanged with neighboring ranks, so that each rank holds the complete
+ * lines starting in its block. Line ends are replaced by '\0' characters.
+ *
+ * parameters:
+ *   path    <-- file path
+ *   n_chars --> number of characters in block
+ *   offset  --> file offset of first character in block
+ *
+ * returns:
+ *   pointer to local block (size: n_chars + 1)
+ *----------------------------------------------------------------------------*/
+
+static char *
+_read_text_block(const char  *path,
+                 size_t      *n_chars,
+                 cs_gnum_t   *offset)
+{
+  cs_gnum_t file_size = 0;
+  cs_gnum_t range[2] = {0, 0};
+
+  const int rank_id = CS_MAX(cs_glob_rank_id, 0);
+  const int n_ranks = cs_glob_n_ranks;
+
+  int rank_step = 1;
+
+  cs_file_t *f = _open_file(path, &file_size, &rank_step, NULL);
+
+  /* Byte ranges, using the file rank stepping and avoiding small blocks */
+
+  int n_blocks = n_ranks/rank_step + ((n_ranks % rank_step) ? 1 : 0);
+  while (   n_blocks > 1
+         && file_size/n_blocks < CS_MESH_IMPORT_MIN_TEXT_BLOCK) {
+    rank_step *= 2;
+    n_blocks = n_ranks/rank_step + ((n_ranks % rank_step) ? 1 : 0);
+  }
+
+  const bool active = (rank_id % rank_step == 0) ? true : false;
+  const cs_gnum_t block_size =   file_size/n_blocks
+                               + ((file_size % n_blocks) ? 1 : 0);
+
+  cs_gnum_t block_id = (active) ? rank_id/rank_step : rank_id/rank_step + 1;
+  range[0] = CS_MIN(block_id*block_size, file_size);
+  range[1] = (active) ? CS_MIN(range[0] + block_size, file_size) : range[0];
+
+  size_t n = range[1] - range[0];
+
+  char *buf = NULL;
+  BFT_MALLOC(buf, n + 1, char);
+
+  cs_file_read_block(f, buf, 1, 1, range[0] + 1, range[1] + 1);
+
+  f = cs_file_free(f);
+
+  /* Partial first line (completing the previous block's last line) */
+
+  size_t prefix_size = n;
+  for (size_t i = 0; i < n; i++) {
+    if (buf[i] == '\n') {
+      prefix_size = i+1;
+      break;
+    }
+  }
+  if (prefix_size == n && n > 0 && buf[n-1] != '\n' && range[1] < file_size)
+    bft_error(__FILE__, __LINE__, 0,
+              _("File \"%s\":\n"
+                "line longer than the %llu bytes read by a rank."),
+              path, (unsigned long long)n);
+
+  char prev_last = '\n';
+  char *suffix = NULL;
+  size_t suffix_size = 0;
+
+#if defined(HAVE_MPI)
+
+  if (n_ranks > 1) {
+
+    int prev_rank = MPI_PROC_NULL, next_rank = MPI_PROC_NULL;
+    if (active && rank_id >= rank_step)
+      prev_rank = rank_id - rank_step;
+    if (active && rank_id + rank_step < n_ranks)
+      next_rank = rank_id + rank_step;
+
+    char last = (n > 0) ? buf[n-1] : '\n';
+    MPI_Sendrecv(&last, 1, MPI_CHAR, next_rank, 0,
+                 &prev_last, 1, MPI_CHAR, prev_rank, 0,
+                 cs_glob_mpi_comm, MPI_STATUS_IGNORE);
+
+    /* An empty block forwards the previous block's end */
+    if (n == 0 && active && prev_rank != MPI_PROC_NULL && prev_last != '\n')
+      bft_error(__FILE__, __LINE__, 0,
+                _("File \"%s\":\n"
+                  "line spanning more than two rank blocks."), path);
+
+    cs_gnum_t send_size = (prev_last == '\n') ? 0 : prefix_size;
+    cs_gnum_t recv_size = 0;
+    MPI_Sendrecv(&send_size, 1, CS_MPI_GNUM, prev_rank, 0,
+                 &recv_size, 1, CS_MPI_GNUM, next_rank, 0,
+                 cs_glob_mpi_comm, MPI_STATUS_IGNORE);
+
+    suffix_size = recv_size;
+    BFT_MALLOC(suffix, suffix_size + 1, char);
+    MPI_Sendrecv(buf, send_size, MPI_CHAR, prev_rank, 0,
+                 suffix, suffix_size, MPI_CHAR, next_rank, 0,
+                 cs_glob_mpi_comm, MPI_STATUS_IGNORE);
+
+  }
+
+#endif
+
+  /* Keep only lines starting in this block */
+
+  size_t start = (prev_last == '\n') ? 0 : prefix_size;
+
+  if (start > 0)
+    memmove(buf, buf + start, n - start);
+  n -= start;
+
+  if (suffix_size > 0) {
+    BFT_REALLOC(buf, n + suffix_size + 1, char);
+    memcpy(buf + n, suffix, suffix_size);
+    n += suffix_size;
+  }
+  BFT_FREE(suffix);
+
+  buf[n] = '\0';
+  for (size_t i = 0; i < n; i++) {
+    if (buf[i] == '\n' || buf[i] == '\r')
+      buf[i] = '\0';
+  }
+
+  *n_chars = n;
+  *offset = range[0] + start;
+
+  return buf;
+}
+
+/*----------------------------------------------------------------------------
+ * Locate Gmsh section markers.
+ *
+ * For section start markers, the returned position is that of the first
+ * line of the section; for end markers, it is that of the marker itself.
+ *
+ * parameters:
+ *   path    <-- file path (for messages)
+ *   buf     <-- local text block
+ *   n_chars <-- number of characters in block
+ *   offset  <-- file offset of first character in block
+ *   pos     --> marker positions (1 to n), or 0 if absent
+ *----------------------------------------------------------------------------*/
+
+static void
+_locate_gmsh_sections(const char  *path,
+                      const char  *buf,
+                      size_t       n_chars,
+                      cs_gnum_t    offset,
+                      cs_gnum_t    pos[GMSH_N_MARKERS])
+{
+  cs_gnum_t l_pos[GMSH_N_MARKERS];
+
+  for (int i = 0; i < GMSH_N_MARKERS; i++)
+    l_pos[i] = 0;
+
+  size_t i = 0;
+  while (i < n_chars) {
+    size_t l = strlen(buf + i);
+    if (buf[i] == '$') {
+      size_t l_n = l;
+      while (l_n > 0 && isspace(buf[i + l_n - 1]))
+        l_n--;
+      for (int j = 0; j < GMSH_N_MARKERS; j++) {
+        if (   l_n == strlen(_gmsh_marker_name[j])
+            && strncmp(buf + i, _gmsh_marker_name[j], l_n) == 0) {
+          if (j % 2 == 0)
+            l_pos[j] = offset + i + l + 1 + 1;
+          else
+            l_pos[j] = offset + i + 1;
+        }
+      }
+    }
+    i += l + 1;
+  }
+
+  for (int j = 0; j < GMSH_N_MARKERS; j++)
+    pos[j] = l_pos[j];
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1)
+    MPI_Allreduce(l_pos, pos, GMSH_N_MARKERS, CS_MPI_GNUM, MPI_MAX,
+                  cs_glob_mpi_comm);
+#endif
+
+  for (int j = 0; j < GMSH_N_MARKERS; j++) {
+    if (j < GMSH_PHYSICAL_NAMES || j > GMSH_END_PHYSICAL_NAMES) {
+      if (pos[j] == 0)
+        bft_error(__FILE__, __LINE__, 0,
+                  _("File \"%s\":\n"
+                    "no \"%s\" section found; only version 2 of the\n"
+                    "Gmsh format is handled."),
+                  path, _gmsh_marker_name[j]);
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Count the number of whitespace-separated tokens in a string.
+ *
+ * parameters:
+ *   s <-- string
+ *
+ * returns:
+ *   number of tokens
+ *----------------------------------------------------------------------------*/
+
+static int
+_n_tokens(const char  *s)
+{
+  int n = 0;
+  bool in_token = false;
+
+  for (const char *c = s; *c != '\0'; c++) {
+    if (isspace(*c))
+      in_token = false;
+    else if (in_token == false) {
+      in_token = true;
+      n++;
+    }
+  }
+
+  return n;
+}
+
+/*----------------------------------------------------------------------------
+ * Add an element to the local Gmsh data.
+ *
+ * Only volume and surface elements are kept; arrays must be large enough.
+ *
+ * parameters:
+ *   type <-- Gmsh element type
+ *   phys <-- physical entity tag (0 if none)
+ *   vtx  <-- element node tags (linear vertices only)
+ *   gd   <-> local Gmsh data
+ *----------------------------------------------------------------------------*/
+
+static void
+_add_element(int               type,
+             int               phys,
+             const cs_gnum_t   vtx[],
+             _gmsh_data_t     *gd)
+{
+  int l_type = _gmsh_linear_type[type];
+
+  if (_gmsh_dim[type] == 3) {
+    cs_lnum_t j = gd->n_cells;
+    gd->cell_type[j] = l_type;
+    gd->cell_phys[j] = phys;
+    for (int k = 0; k < 8; k++)
+      gd->cell_vtx[j*8 + k] = 0;
+    for (int k = 0; k < _gmsh_n_vertices[l_type]; k++)
+      gd->cell_vtx[j*8 + k] = vtx[k];
+    gd->n_cells += 1;
+  }
+  else if (_gmsh_dim[type] == 2) {
+    cs_lnum_t j = gd->n_f_elts;
+    gd->f_elt_phys[j] = phys;
+    for (int k = 0; k < 4; k++)
+      gd->f_elt_vtx[j*4 + k] = 0;
+    for (int k = 0; k < _gmsh_n_vertices[l_type]; k++)
+      gd->f_elt_vtx[j*4 + k] = vtx[k];
+    gd->n_f_elts += 1;
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Parse physical name definitions.
+ *
+ * parameters:
+ *   path       <-- file path (for messages)
+ *   names      <-- physical name definition lines, each terminated by '\0'
+ *                  (replicated on all ranks)
+ *   names_size <-- size of names array
+ *   gd         <-> local Gmsh data
+ *----------------------------------------------------------------------------*/
+
+static void
+_parse_physical_names(const char    *path,
+                      char          *names,
+                      size_t         names_size,
+                      _gmsh_data_t  *gd)
+{
+  for (size_t i = 0; i < names_size; i += strlen(names + i) + 1) {
+
+    char *s = names + i;
+    int j = gd->n_phys;
+
+    BFT_REALLOC(gd->phys_dim_tag, (j+1)*2, int);
+    BFT_REALLOC(gd->phys_name, j+1, char *);
+
+    gd->phys_dim_tag[j*2] = strtol(s, &s, 10);
+    gd->phys_dim_tag[j*2+1] = strtol(s, &s, 10);
+
+    char *n_s = strchr(s, '"');
+    char *n_e = (n_s != NULL) ? strrchr(n_s + 1, '"') : NULL;
+    if (n_e == NULL)
+      bft_error(__FILE__, __LINE__, 0,
+                _("File \"%s\":\n"
+                  "incorrect physical name definition:\n%s"),
+                path, names + i);
+
+    BFT_MALLOC(gd->phys_name[j], n_e - n_s, char);
+    memcpy(gd->phys_name[j], n_s + 1, n_e - n_s - 1);
+    gd->phys_name[j][n_e - n_s - 1] = '\0';
+
+    gd->n_phys += 1;
+
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Parse the local part of a Gmsh file.
+ *
+ * parameters:
+ *   path    <-- file path (for messages)
+ *   buf     <-> local text block
+ *   n_chars <-- number of characters in block
+ *   offset  <-- file offset of first character in block
+ *   pos     <-- marker positions
+ *   gd      <-> local Gmsh data
+ *----------------------------------------------------------------------------*/
+
+static void
+_parse_gmsh_block(const char         *path,
+                  char               *buf,
+                  size_t              n_chars,
+                  cs_gnum_t           offset,
+                  const cs_gnum_t     pos[GMSH_N_MARKERS],
+                  _gmsh_data_t       *gd)
+{
+  int format[2] = {-1, -1};
+
+  size_t names_size = 0;
+  char *names = NULL;
+
+  cs_lnum_t n_nodes_max = 0, n_elts_max = 0;
+
+  /* Count pass (section lines, including the counts line) */
+
+  for (size_t i = 0; i < n_chars; i += strlen(buf + i) + 1) {
+    cs_gnum_t l_pos = offset + i + 1;
+    if (l_pos >= pos[GMSH_NODES] && l_pos < pos[GMSH_END_NODES])
+      n_nodes_max++;
+    else if (l_pos >= pos[GMSH_ELEMENTS] && l_pos < pos[GMSH_END_ELEMENTS])
+      n_elts_max++;
+  }
+
+  BFT_MALLOC(gd->node_tag, n_nodes_max, cs_gnum_t);
+  BFT_MALLOC(gd->node_coords, n_nodes_max*3, cs_real_t);
+
+  BFT_MALLOC(gd->cell_type, n_elts_max, int);
+  BFT_MALLOC(gd->cell_phys, n_elts_max, int);
+  BFT_MALLOC(gd->cell_vtx, n_elts_max*8, cs_gnum_t);
+
+  BFT_MALLOC(gd->f_elt_phys, n_elts_max, int);
+  BFT_MALLOC(gd->f_elt_vtx, n_elts_max*4, cs_gnum_t);
+
+  /* Parsing pass */
+
+  for (size_t i = 0; i < n_chars; i += strlen(buf + i) + 1) {
+
+    cs_gnum_t l_pos = offset + i + 1;
+    char *s = buf + i;
+
+    int n_tokens = _n_tokens(s);
+    if (n_tokens < 2)  /* empty lines and counts */
+      continue;
+
+    if (l_pos >= pos[GMSH_MESH_FORMAT] && l_pos < pos[GMSH_END_MESH_FORMAT]) {
+      double version = strtod(s, &s);
+      format[0] = (int)version;
+      format[1] = strtol(s, &s, 10);
+    }
+
+    else if (   l_pos >= pos[GMSH_PHYSICAL_NAMES]
+             && l_pos < pos[GMSH_END_PHYSICAL_NAMES]) {
+      size_t l = strlen(s) + 1;
+      BFT_REALLOC(names, names_size + l, char);
+      memcpy(names + names_size, s, l);
+      names_size += l;
+    }
+
+    else if (l_pos >= pos[GMSH_NODES] && l_pos < pos[GMSH_END_NODES]) {
+      cs_lnum_t j = gd->n_nodes;
+      gd->node_tag[j] = strtoull(s, &s, 10);
+      for (int k = 0; k < 3; k++)
+        gd->node_coords[j*3 + k] = strtod(s, &s);
+      gd->n_nodes += 1;
+    }
+
+    else if (l_pos >= pos[GMSH_ELEMENTS] && l_pos < pos[GMSH_END_ELEMENTS]) {
+
+      strtoull(s, &s, 10); /* element number */
+      int type = strtol(s, &s, 10);
+      int n_tags = strtol(s, &s, 10);
+      int phys = 0;
+      for (int k = 0; k < n_tags; k++) {
+        int tag = strtol(s, &s, 10);
+        if (k == 0)
+          phys = tag;
+      }
+
+      if (type < 1 || type >= _GMSH_N_TYPES)
+        bft_error(__FILE__, __LINE__, 0,
+                  _("File \"%s\":\n"
+                    "Gmsh element type %d is not handled."), path, type);
+
+      if (n_tokens < 3 + n_tags + _gmsh_n_nodes[type])
+        bft_error(__FILE__, __LINE__, 0,
+                  _("File \"%s\":\n"
+                    "incomplete element definition:\n%s"), path, buf + i);
+
+      cs_gnum_t vtx[8];
+      for (int k = 0; k < _gmsh_n_vertices[_gmsh_linear_type[type]]; k++)
+        vtx[k] = strtoull(s, &s, 10);
+
+      _add_element(type, phys, vtx, gd);
+
+    }
+
+  }
+
+  BFT_REALLOC(gd->cell_type, gd->n_cells, int);
+  BFT_REALLOC(gd->cell_phys, gd->n_cells, int);
+  BFT_REALLOC(gd->cell_vtx, gd->n_cells*8, cs_gnum_t);
+  BFT_REALLOC(gd->f_elt_phys, gd->n_f_elts, int);
+  BFT_REALLOC(gd->f_elt_vtx, gd->n_f_elts*4, cs_gnum_t);
+
+  /* Check format */
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1) {
+    int l_format[2] = {format[0], format[1]};
+    MPI_Allreduce(l_format, format, 2, MPI_INT, MPI_MAX, cs_glob_mpi_comm);
+  }
+#endif
+
+  if (format[0] != 2 || format[1] != 0)
+    bft_error(__FILE__, __LINE__, 0,
+              _("File \"%s\":\n"
+                "only version 2 of the Gmsh format is handled\n"
+                "(version %d, file type %d)."),
+              path, format[0], format[1]);
+
+  /* Gather physical names on all ranks */
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1) {
+    int l_size = names_size;
+    int *g_size = NULL, *displ = NULL;
+    BFT_MALLOC(g_size, cs_glob_n_ranks, int);
+    BFT_MALLOC(displ, cs_glob_n_ranks, int);
+    MPI_Allgather(&l_size, 1, MPI_INT, g_size, 1, MPI_INT, cs_glob_mpi_comm);
+    names_size = 0;
+    for (int i = 0; i < cs_glob_n_ranks; i++) {
+      displ[i] = names_size;
+      names_size += g_size[i];
+    }
+    char *l_names = names;
+    BFT_MALLOC(names, names_size, char);
+    MPI_Allgatherv(l_names, l_size, MPI_CHAR,
+                   names, g_size, displ, MPI_CHAR, cs_glob_mpi_comm);
+    BFT_FREE(l_names);
+    BFT_FREE(displ);
+    BFT_FREE(g_size);
+  }
+#endif
+
+  _parse_physical_names(path, names, names_size, gd);
+
+  BFT_FREE(names);
+}
+
+/*----------------------------------------------------------------------------
+ * Swap bytes of an array of values.
+ *
+ * parameters:
+ *   buf  <-> values
+ *   size <-- size of each value
+ *   ni   <-- number of values
+ *----------------------------------------------------------------------------*/
+
+static void
+_swap_bytes(void    *buf,
+            size_t   size,
+            size_t   ni)
+{
+  unsigned char *b = buf;
+
+  for (size_t i = 0; i < ni; i++) {
+    unsigned char *p = b + i*size;
+    for (size_t j = 0; j < size/2; j++) {
+      unsigned char t = p[j];
+      p[j] = p[size - 1 - j];
+      p[size - 1 - j] = t;
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Read a text line at a given file offset (collective).
+ *
+ * parameters:
+ *   f         <-> file descriptor
+ *   file_size <-- file size
+ *   offset    <-> line start offset; updated to the next line's start
+ *   line      --> line contents, trailing whitespace removed
+ *
+ * returns:
+ *   true if a line was read, false at end of file
+ *----------------------------------------------------------------------------*/
+
+static bool
+_read_line(cs_file_t  *f,
+           cs_gnum_t   file_size,
+           cs_gnum_t  *offset,
+           char        line[CS_MESH_IMPORT_MAX_LINE])
+{
+  if (*offset >= file_size)
+    return false;
+
+  size_t n = CS_MIN(CS_MESH_IMPORT_MAX_LINE - 1, file_size - *offset);
+
+  cs_file_seek(f, *offset, CS_FILE_SEEK_SET);
+  cs_file_read_global(f, line, 1, n);
+
+  size_t l = 0;
+  while (l < n && line[l] != '\n')
+    l++;
+
+  if (l == n && *offset + n < file_size)
+    bft_error(__FILE__, __LINE__, 0,
+              _("File \"%s\":\n"
+                "line longer than %d characters."),
+              cs_file_get_name(f), CS_MESH_IMPORT_MAX_LINE - 1);
+
+  *offset += (l < n) ? l + 1 : n;
+
+  while (l > 0 && isspace(line[l-1]))
+    l--;
+  line[l] = '\0';
+
+  return true;
+}
+
+/*----------------------------------------------------------------------------
+ * Read the local part of a binary Gmsh file.
+ *
+ * Section headers and physical names are read by all ranks; element block
+ * headers are then scanned, so that node and element records, whose sizes
+ * are fixed within each block, may be read using block-distributed reads.
+ *
+ * parameters:
+ *   path <-- file path
+ *   gd   <-> local Gmsh data
+ *
+ * returns:
+ *   true if the file is a binary Gmsh file (and was read), false otherwise
+ *----------------------------------------------------------------------------*/
+
+static bool
+_read_gmsh_binary(const char    *path,
+                  _gmsh_data_t  *gd)
+{
+  const int rank_id = CS_MAX(cs_glob_rank_id, 0);
+  const int n_ranks = cs_glob_n_ranks;
+
+  cs_gnum_t file_size = 0;
+  int rank_step = 1, min_block_size = 0;
+
+  cs_file_t *f = _open_file(path, &file_size, &rank_step, &min_block_size);
+
+  char line[CS_MESH_IMPORT_MAX_LINE];
+  cs_gnum_t offset = 0;
+
+  /* Format */
+
+  double version = 0;
+  int file_type = 0, data_size = 0;
+
+  if (   _read_line(f, file_size, &offset, line)
+      && strcmp(line, "$MeshFormat") == 0
+      && _read_line(f, file_size, &offset, line))
+    sscanf(line, "%lf %d %d", &version, &file_type, &data_size);
+
+  if (file_type != 1) {
+    f = cs_file_free(f);
+    return false;
+  }
+
+  if ((int)version != 2 || data_size != sizeof(double))
+    bft_error(__FILE__, __LINE__, 0,
+              _("File \"%s\":\n"
+                "only the version 2 Gmsh format with 8-byte reals is handled\n"
+                "(version %g, data size %d)."),
+              path, version, data_size);
+
+  /* Byte order, given by the binary representation of 1 */
+
+  bool swap = false;
+  int32_t one = 0;
+
+  if (offset + sizeof(int32_t) <= file_size) {
+    cs_file_seek(f, offset, CS_FILE_SEEK_SET);
+    cs_file_read_global(f, &one, sizeof(int32_t), 1);
+    offset += sizeof(int32_t);
+    if (one != 1) {
+      _swap_bytes(&one, sizeof(int32_t), 1);
+      swap = true;
+    }
+  }
+
+  if (one != 1)
+    bft_error(__FILE__, __LINE__, 0,
+              _("File \"%s\":\n"
+                "unable to determine the byte order of binary data."), path);
+
+  /* Sections; node and element data is skipped, and element block headers
+     are saved (data offset, type, number of elements, number of tags) */
+
+  size_t names_size = 0;
+  char *names = NULL;
+
+  cs_gnum_t n_g_nodes = 0, n_g_elts = 0, nodes_offset = 0;
+  bool have_nodes = false, have_elements = false;
+
+  int n_e_blocks = 0;
+  cs_gnum_t *e_block = NULL;
+
+  while (   have_elements == false
+         && _read_line(f, file_size, &offset, line)) {
+
+    if (strcmp(line, "$PhysicalNames") == 0) {
+      _read_line(f, file_size, &offset, line);
+      int n_names = atoi(line);
+      for (int i = 0; i < n_names; i++) {
+        if (_read_line(f, file_size, &offset, line) == false)
+          break;
+        size_t l = strlen(line) + 1;
+        BFT_REALLOC(names, names_size + l, char);
+        memcpy(names + names_size, line, l);
+        names_size += l;
+      }
+    }
+
+    else if (strcmp(line, "$Nodes") == 0) {
+      _read_line(f, file_size, &offset, line);
+      n_g_nodes = strtoull(line, NULL, 10);
+      nodes_offset = offset;
+      offset += n_g_nodes*(sizeof(int32_t) + 3*sizeof(double));
+      have_nodes = true;
+    }
+
+    else if (strcmp(line, "$Elements") == 0) {
+
+      _read_line(f, file_size, &offset, line);
+      n_g_elts = strtoull(line, NULL, 10);
+
+      for (cs_gnum_t n = 0; n < n_g_elts; ) {
+
+        int32_t header[3] = {0, 0, 0};
+
+        if (offset + sizeof(header) <= file_size) {
+          cs_file_seek(f, offset, CS_FILE_SEEK_SET);
+          cs_file_read_global(f, header, sizeof(int32_t), 3);
+          if (swap)
+            _swap_bytes(header, sizeof(int32_t), 3);
+        }
+
+        int type = header[0];
+        if (type < 1 || type >= _GMSH_N_TYPES)
+          bft_error(__FILE__, __LINE__, 0,
+                    _("File \"%s\":\n"
+                      "Gmsh element type %d is not handled."), path, type);
+
+        if (header[1] < 1 || header[2] < 0 || n + header[1] > n_g_elts)
+          bft_error(__FILE__, __LINE__, 0,
+                    _("File \"%s\":\n"
+                      "incorrect element block header at offset %llu."),
+                    path, (unsigned long long)offset);
+
+        BFT_REALLOC(e_block, (n_e_blocks+1)*4, cs_gnum_t);
+        e_block[n_e_blocks*4]     = offset + sizeof(header);
+        e_block[n_e_blocks*4 + 1] = type;
+        e_block[n_e_blocks*4 + 2] = header[1];
+        e_block[n_e_blocks*4 + 3] = header[2];
+        n_e_blocks += 1;
+
+        offset +=   sizeof(header)
+                  + (cs_gnum_t)header[1] * sizeof(int32_t)
+                    * (1 + header[2] + _gmsh_n_nodes[type]);
+        n += header[1];
+
+      }
+
+      have_elements = true;
+    }
+
+    /* Other lines (section ends and other sections) are ignored */
+
+  }
+
+  if (have_nodes == false || have_elements == false || offset > file_size)
+    bft_error(__FILE__, __LINE__, 0,
+              _("File \"%s\":\n"
+                "missing or incomplete $Nodes or $Elements section."), path);
+
+  /* Nodes */
+
+  const size_t node_size = sizeof(int32_t) + 3*sizeof(double);
+
+  cs_block_dist_info_t bi
+    = cs_block_dist_compute_sizes(rank_id,
+                                  n_ranks,
+                                  rank_step,
+                                  min_block_size / node_size,
+                                  n_g_nodes);
+
+  cs_lnum_t n_nodes = bi.gnum_range[1] - bi.gnum_range[0];
+
+  unsigned char *buf = NULL;
+  BFT_MALLOC(buf, n_nodes*node_size, unsigned char);
+
+  cs_file_seek(f, nodes_offset, CS_FILE_SEEK_SET);
+  cs_file_read_block(f, buf, 1, node_size,
+                     bi.gnum_range[0], bi.gnum_range[1]);
+
+  BFT_MALLOC(gd->node_tag, n_nodes, cs_gnum_t);
+  BFT_MALLOC(gd->node_coords, n_nodes*3, cs_real_t);
+
+  for (cs_lnum_t i = 0; i < n_nodes; i++) {
+    int32_t tag;
+    double coords[3];
+    memcpy(&tag, buf + i*node_size, sizeof(int32_t));
+    memcpy(coords, buf + i*node_size + sizeof(int32_t), 3*sizeof(double));
+    if (swap) {
+      _swap_bytes(&tag, sizeof(int32_t), 1);
+      _swap_bytes(coords, sizeof(double), 3);
+    }
+    gd->node_tag[i] = tag;
+    for (int k = 0; k < 3; k++)
+      gd->node_coords[i*3 + k] = coords[k];
+  }
+  gd->n_nodes = n_nodes;
+
+  /* Elements (block distribution assuming 8 integers per element) */
+
+  bi = cs_block_dist_compute_sizes(rank_id,
+                                   n_ranks,
+                                   rank_step,
+                                   min_block_size / (8*sizeof(int32_t)),
+                                   n_g_elts);
+
+  cs_lnum_t n_elts_max = bi.gnum_range[1] - bi.gnum_range[0];
+
+  BFT_MALLOC(gd->cell_type, n_elts_max, int);
+  BFT_MALLOC(gd->cell_phys, n_elts_max, int);
+  BFT_MALLOC(gd->cell_vtx, n_elts_max*8, cs_gnum_t);
+
+  BFT_MALLOC(gd->f_elt_phys, n_elts_max, int);
+  BFT_MALLOC(gd->f_elt_vtx, n_elts_max*4, cs_gnum_t);
+
+  cs_gnum_t b_start = 1;
+
+  for (int b_id = 0; b_id < n_e_blocks; b_id++) {
+
+    const int type = e_block[b_id*4 + 1];
+    const cs_gnum_t b_size = e_block[b_id*4 + 2];
+    const int n_tags = e_block[b_id*4 + 3];
+    const int rec_size = 1 + n_tags + _gmsh_n_nodes[type];
+
+    /* Intersection of local range with file block, relative to block */
+
+    cs_gnum_t range[2];
+    for (int k = 0; k < 2; k++) {
+      range[k] = CS_MAX(bi.gnum_range[k], b_start);
+      range[k] = CS_MIN(range[k], b_start + b_size) - b_start;
+    }
+
+    size_t n = range[1] - range[0];
+
+    BFT_REALLOC(buf, n*rec_size*sizeof(int32_t), unsigned char);
+
+    cs_file_seek(f, e_block[b_id*4], CS_FILE_SEEK_SET);
+    cs_file_read_block(f, buf, 1, rec_size*sizeof(int32_t),
+                       range[0] + 1, range[1] + 1);
+
+    int32_t *rec = (int32_t *)buf;
+    if (swap)
+      _swap_bytes(rec, sizeof(int32_t), n*rec_size);
+
+    for (size_t i = 0; i < n; i++) {
+      const int32_t *r = rec + i*rec_size;
+      cs_gnum_t vtx[8];
+      for (int k = 0; k < _gmsh_n_vertices[_gmsh_linear_type[type]]; k++)
+        vtx[k] = r[1 + n_tags + k];
+      _add_element(type, (n_tags > 0) ? r[1] : 0, vtx, gd);
+    }
+
+    b_start += b_size;
+  }
+
+  BFT_FREE(buf);
+  BFT_FREE(e_block);
+
+  f = cs_file_free(f);
+
+  BFT_REALLOC(gd->cell_type, gd->n_cells, int);
+  BFT_REALLOC(gd->cell_phys, gd->n_cells, int);
+  BFT_REALLOC(gd->cell_vtx, gd->n_cells*8, cs_gnum_t);
+  BFT_REALLOC(gd->f_elt_phys, gd->n_f_elts, int);
+  BFT_REALLOC(gd->f_elt_vtx, gd->n_f_elts*4, cs_gnum_t);
+
+  /* Physical names (read identically on all ranks) */
+
+  _parse_physical_names(path, names, names_size, gd);
+
+  BFT_FREE(names);
+
+  return true;
+}
+
+/*----------------------------------------------------------------------------
+ * Compare (dimension, tag) couples.
+ *----------------------------------------------------------------------------*/
+
+static int
+_compare_dim_tag(const void  *x,
+                 const void  *y)
+{
+  const int *a = x, *b = y;
+
+  if (a[0] != b[0])
+    return (a[0] < b[0]) ? -1 : 1;
+  else if (a[1] != b[1])
+    return (a[1] < b[1]) ? -1 : 1;
+
+  return 0;
+}
+
+/*----------------------------------------------------------------------------
+ * Compare strings (qsort function).
+ *----------------------------------------------------------------------------*/
+
+static int
+_compare_names(const void  *x,
+               const void  *y)
+{
+  return strcmp(*(const char *const *)x, *(const char *const *)y);
+}
+
+/*----------------------------------------------------------------------------
+ * Build group classes from physical entities, and replace physical tags
+ * by group class ids (1 to n, 0 for none).
+ *
+ * Each physical entity used by cells or face elements defines a group
+ * class, whose single group is the physical name if defined, or the
+ * physical tag otherwise (converted to a group when read). The last
+ * group class is the default one, with no group; it is assigned to cells
+ * with no physical entity.
+ *
+ * parameters:
+ *   gd             <-> local Gmsh data
+ *   n_gc           --> number of group classes
+ *   n_groups       --> number of groups
+ *   group_idx      --> group names index (1 to n)
+ *   group          --> group names
+ *   gc_properties  --> group class properties
+ *----------------------------------------------------------------------------*/
+
+static void
+_define_group_classes(_gmsh_data_t   *gd,
+                      int            *n_gc,
+                      int            *n_groups,
+                      int           **group_idx,
+                      char          **group,
+                      int           **gc_properties)
+{
+  int n_l = 0;
+  int *dim_tag = NULL;
+
+  /* Local (dimension, tag) couples */
+
+  BFT_MALLOC(dim_tag, (gd->n_cells + gd->n_f_elts)*2, int);
+
+  for (cs_lnum_t i = 0; i < gd->n_cells; i++) {
+    if (gd->cell_phys[i] > 0) {
+      dim_tag[n_l*2] = 3;
+      dim_tag[n_l*2 + 1] = gd->cell_phys[i];
+      n_l++;
+    }
+  }
+  for (cs_lnum_t i = 0; i < gd->n_f_elts; i++) {
+    if (gd->f_elt_phys[i] > 0) {
+      dim_tag[n_l*2] = 2;
+      dim_tag[n_l*2 + 1] = gd->f_elt_phys[i];
+      n_l++;
+    }
+  }
+
+  int n = 0;
+  if (n_l > 0) {
+    qsort(dim_tag, n_l, 2*sizeof(int), _compare_dim_tag);
+    n = 1;
+    for (int i = 1; i < n_l; i++) {
+      if (_compare_dim_tag(dim_tag + i*2, dim_tag + (n-1)*2) != 0) {
+        dim_tag[n*2] = dim_tag[i*2];
+        dim_tag[n*2+1] = dim_tag[i*2+1];
+        n++;
+      }
+    }
+  }
+
+  /* Merge with other ranks */
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1) {
+    int l_size = n*2, g_size = 0;
+    int *size = NULL, *displ = NULL, *g_dim_tag = NULL;
+    BFT_MALLOC(size, cs_glob_n_ranks, int);
+    BFT_MALLOC(displ, cs_glob_n_ranks, int);
+    MPI_Allgather(&l_size, 1, MPI_INT, size, 1, MPI_INT, cs_glob_mpi_comm);
+    for (int i = 0; i < cs_glob_n_ranks; i++) {
+      displ[i] = g_size;
+      g_size += size[i];
+    }
+    BFT_MALLOC(g_dim_tag, g_size, int);
+    MPI_Allgatherv(dim_tag, l_size, MPI_INT,
+                   g_dim_tag, size, displ, MPI_INT, cs_glob_mpi_comm);
+    BFT_FREE(displ);
+    BFT_FREE(size);
+    BFT_FREE(dim_tag);
+    dim_tag = g_dim_tag;
+    n_l = g_size / 2;
+    n = 0;
+    if (n_l > 0) {
+      qsort(dim_tag, n_l, 2*sizeof(int), _compare_dim_tag);
+      n = 1;
+      for (int i = 1; i < n_l; i++) {
+        if (_compare_dim_tag(dim_tag + i*2, dim_tag + (n-1)*2) != 0) {
+          dim_tag[n*2] = dim_tag[i*2];
+          dim_tag[n*2+1] = dim_tag[i*2+1];
+          n++;
+        }
+      }
+    }
+  }
+#endif
+
+  /* Replace physical tags by group class ids */
+
+  for (cs_lnum_t i = 0; i < gd->n_cells; i++) {
+    int key[2] = {3, gd->cell_phys[i]};
+    const int *p = (gd->cell_phys[i] > 0) ?
+      bsearch(key, dim_tag, n, 2*sizeof(int), _compare_dim_tag) : NULL;
+    gd->cell_phys[i] = (p != NULL) ? (p - dim_tag)/2 + 1 : n + 1;
+  }
+  for (cs_lnum_t i = 0; i < gd->n_f_elts; i++) {
+    int key[2] = {2, gd->f_elt_phys[i]};
+    const int *p = (gd->f_elt_phys[i] > 0) ?
+      bsearch(key, dim_tag, n, 2*sizeof(int), _compare_dim_tag) : NULL;
+    gd->f_elt_phys[i] = (p != NULL) ? (p - dim_tag)/2 + 1 : 0;
+  }
+
+  /* Group names (sorted) */
+
+  const char **gc_name = NULL;
+  const char **names = NULL;
+  int _n_groups = 0;
+
+  BFT_MALLOC(gc_name, n, const char *);
+  BFT_MALLOC(names, n, const char *);
+
+  for (int i = 0; i < n; i++) {
+    gc_name[i] = NULL;
+    for (int j = 0; j < gd->n_phys; j++) {
+      if (_compare_dim_tag(dim_tag + i*2, gd->phys_dim_tag + j*2) == 0) {
+        gc_name[i] = gd->phys_name[j];
+        names[_n_groups++] = gd->phys_name[j];
+        break;
+      }
+    }
+  }
+
+  if (_n_groups > 0) {
+    qsort(names, _n_groups, sizeof(char *), _compare_names);
+    int k = 1;
+    for (int i = 1; i < _n_groups; i++) {
+      if (strcmp(names[i], names[k-1]) != 0)
+        names[k++] = names[i];
+    }
+    _n_groups = k;
+  }
+
+  int *_group_idx = NULL;
+  char *_group = NULL;
+
+  BFT_MALLOC(_group_idx, _n_groups + 1, int);
+  _group_idx[0] = 1;
+  for (int i = 0; i < _n_groups; i++)
+    _group_idx[i+1] = _group_idx[i] + strlen(names[i]) + 1;
+
+  BFT_MALLOC(_group, _group_idx[_n_groups], char);
+  for (int i = 0; i < _n_groups; i++)
+    strcpy(_group + _group_idx[i] - 1, names[i]);
+
+  /* Group class properties: group (< 0) or color (> 0), and default
+     group class (with no group) */
+
+  int *_gc_properties = NULL;
+  BFT_MALLOC(_gc_properties, n + 1, int);
+
+  for (int i = 0; i < n; i++) {
+    if (gc_name[i] != NULL) {
+      const char **p = bsearch(gc_name + i, names, _n_groups,
+                               sizeof(char *), _compare_names);
+      _gc_properties[i] = - (p - names + 1);
+    }
+    else
+      _gc_properties[i] = dim_tag[i*2 + 1];
+  }
+  _gc_properties[n] = 0;
+
+  BFT_FREE(names);
+  BFT_FREE(gc_name);
+  BFT_FREE(dim_tag);
+
+  *n_gc = n + 1;
+  *n_groups = _n_groups;
+  *group_idx = _group_idx;
+  *group = _group;
+  *gc_properties = _gc_properties;
+}
+
+/*----------------------------------------------------------------------------
+ * Convert Gmsh node tags to compact vertex global numbers.
+ *
+ * Node tags are distributed to ranks by blocks of tags; only nodes
+ * referenced by cells are numbered, in increasing tag order, and their
+ * coordinates are then distributed by blocks of vertex numbers.
+ *
+ * parameters:
+ *   path         <-- file path (for messages)
+ *   gd           <-> local Gmsh data (nodes freed, element vertex tags
+ *                    replaced by vertex numbers)
+ *   n_g_vertices --> global number of vertices
+ *   tb_gnum      --> vertex number of tags in local tag block
+ *   tb_coords    --> coordinates of tags in local tag block
+ *   tb           --> tag block distribution info
+ *----------------------------------------------------------------------------*/
+
+static void
+_number_vertices(const char             *path,
+                 _gmsh_data_t           *gd,
+                 cs_gnum_t              *n_g_vertices,
+                 cs_gnum_t             **tb_gnum,
+                 cs_real_t             **tb_coords,
+                 cs_block_dist_info_t   *tb)
+{
+  cs_gnum_t max_tag = 0;
+
+  for (cs_lnum_t i = 0; i < gd->n_nodes; i++)
+    max_tag = CS_MAX(max_tag, gd->node_tag[i]);
+  for (cs_lnum_t i = 0; i < gd->n_cells*8; i++)
+    max_tag = CS_MAX(max_tag, gd->cell_vtx[i]);
+  for (cs_lnum_t i = 0; i < gd->n_f_elts*4; i++)
+    max_tag = CS_MAX(max_tag, gd->f_elt_vtx[i]);
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1) {
+    cs_gnum_t l_max = max_tag;
+    MPI_Allreduce(&l_max, &max_tag, 1, CS_MPI_GNUM, MPI_MAX,
+                  cs_glob_mpi_comm);
+  }
+#endif
+
+  *tb = cs_block_dist_compute_sizes(cs_glob_rank_id,
+                                    cs_glob_n_ranks,
+                                    1,
+                                    0,
+                                    max_tag);
+
+  const cs_lnum_t n_tb = tb->gnum_range[1] - tb->gnum_range[0];
+
+  /* Tag status: bit 1 if node is defined, bit 2 if referenced by a cell */
+
+  int *tb_flag = NULL;
+  cs_gnum_t *_tb_gnum = NULL;
+  cs_real_t *_tb_coords = NULL;
+
+  BFT_MALLOC(tb_flag, n_tb, int);
+  BFT_MALLOC(_tb_gnum, n_tb, cs_gnum_t);
+  BFT_MALLOC(_tb_coords, n_tb*3, cs_real_t);
+
+  for (cs_lnum_t i = 0; i < n_tb; i++)
+    tb_flag[i] = 0;
+
+  {
+    int *node_flag = NULL;
+    BFT_MALLOC(node_flag, gd->n_nodes, int);
+    for (cs_lnum_t i = 0; i < gd->n_nodes; i++)
+      node_flag[i] = 1;
+
+    _to_block(*tb, gd->n_nodes, gd->node_tag, CS_INT_TYPE, 1,
+              node_flag, tb_flag);
+    _to_block(*tb, gd->n_nodes, gd->node_tag, CS_REAL_TYPE, 3,
+              gd->node_coords, _tb_coords);
+
+    BFT_FREE(node_flag);
+    BFT_FREE(gd->node_tag);
+    BFT_FREE(gd->node_coords);
+    gd->n_nodes = 0;
+  }
+
+  /* Send cell and face element vertex tags to tag block ranks */
+
+  const cs_lnum_t n_c_req = gd->n_cells*8, n_f_req = gd->n_f_elts*4;
+  cs_gnum_t *c_req = gd->cell_vtx, *f_req = gd->f_elt_vtx;
+  cs_lnum_t n_c_recv = n_c_req, n_f_recv = n_f_req;
+
+#if defined(HAVE_MPI)
+
+  cs_all_to_all_t *c_d = NULL, *f_d = NULL;
+
+  if (cs_glob_n_ranks > 1) {
+
+    /* Padding values (0) are sent to the first block */
+
+    cs_gnum_t *dest_tag = NULL;
+    BFT_MALLOC(dest_tag, CS_MAX(n_c_req, n_f_req), cs_gnum_t);
+
+    for (cs_lnum_t i = 0; i < n_c_req; i++)
+      dest_tag[i] = CS_MAX(gd->cell_vtx[i], 1);
+    c_d = cs_all_to_all_create_from_block(n_c_req, 0, dest_tag, *tb,
+                                          cs_glob_mpi_comm);
+    c_req = cs_all_to_all_copy_array(c_d, CS_GNUM_TYPE, 1, false,
+                                     gd->cell_vtx, NULL);
+    n_c_recv = cs_all_to_all_n_elts_dest(c_d);
+
+    for (cs_lnum_t i = 0; i < n_f_req; i++)
+      dest_tag[i] = CS_MAX(gd->f_elt_vtx[i], 1);
+    f_d = cs_all_to_all_create_from_block(n_f_req, 0, dest_tag, *tb,
+                                          cs_glob_mpi_comm);
+    f_req = cs_all_to_all_copy_array(f_d, CS_GNUM_TYPE, 1, false,
+                                     gd->f_elt_vtx, NULL);
+    n_f_recv = cs_all_to_all_n_elts_dest(f_d);
+
+    BFT_FREE(dest_tag);
+
+  }
+
+#endif
+
+  cs_gnum_t n_missing = 0;
+
+  for (cs_lnum_t i = 0; i < n_c_recv; i++) {
+    if (c_req[i] > 0)
+      tb_flag[c_req[i] - tb->gnum_range[0]] |= 2;
+  }
+
+  /* Number referenced nodes */
+
+  cs_gnum_t n_l_vertices = 0;
+  for (cs_lnum_t i = 0; i < n_tb; i++) {
+    if (tb_flag[i] & 2) {
+      if (tb_flag[i] & 1)
+        n_l_vertices++;
+      else
+        n_missing++;
+    }
+  }
+
+  cs_gnum_t shift = _exscan(n_l_vertices, n_g_vertices);
+
+  n_l_vertices = 0;
+  for (cs_lnum_t i = 0; i < n_tb; i++) {
+    if (tb_flag[i] == 3) {
+      _tb_gnum[i] = shift + n_l_vertices + 1;
+      n_l_vertices++;
+    }
+    else
+      _tb_gnum[i] = 0;
+  }
+
+  BFT_FREE(tb_flag);
+
+  _exscan(n_missing, &n_missing);
+  if (n_missing > 0)
+    bft_error(__FILE__, __LINE__, 0,
+              _("File \"%s\":\n"
+                "%llu nodes referenced by elements are not defined."),
+              path, (unsigned long long)n_missing);
+
+  /* Replace tags by vertex numbers (0 for face element vertices not
+     referenced by cells) and return them to the requesting ranks */
+
+  for (cs_lnum_t i = 0; i < n_c_recv; i++) {
+    if (c_req[i] > 0)
+      c_req[i] = _tb_gnum[c_req[i] - tb->gnum_range[0]];
+  }
+  for (cs_lnum_t i = 0; i < n_f_recv; i++) {
+    if (f_req[i] > 0)
+      f_req[i] = _tb_gnum[f_req[i] - tb->gnum_range[0]];
+  }
+
+#if defined(HAVE_MPI)
+
+  if (cs_glob_n_ranks > 1) {
+
+    cs_all_to_all_copy_array(c_d, CS_GNUM_TYPE, 1, true,
+                             c_req, gd->cell_vtx);
+    cs_all_to_all_copy_array(f_d, CS_GNUM_TYPE, 1, true,
+                             f_req, gd->f_elt_vtx);
+
+    BFT_FREE(c_req);
+    BFT_FREE(f_req);
+
+    cs_all_to_all_destroy(&c_d);
+    cs_all_to_all_destroy(&f_d);
+
+  }
+
+#endif
+
+  *tb_gnum = _tb_gnum;
+  *tb_coords = _tb_coords;
+}
+
+/*----------------------------------------------------------------------------
+ * Build faces from cells and match them.
+ *
+ * Faces of local cells and face elements are sent to the rank handling
+ * the block of their smallest vertex number, where faces sharing the same
+ * vertices are matched. The face is oriented outwards relative to
+ * the cell with the lowest number.
+ *
+ * parameters:
+ *   path         <-- file path (for messages)
+ *   gd           <-> local Gmsh data (cells and face elements freed)
+ *   n_g_vertices <-- global number of vertices
+ *   cell_shift   <-- global number of cells on previous ranks
+ *   n_faces      --> number of local faces
+ *   face_cells   --> face -> cells connectivity (global numbers, 0 for
+ *                    boundary faces)
+ *   face_gc_id   --> face group class id
+ *   face_vtx     --> face vertices (stride 4, padded with 0)
+ *----------------------------------------------------------------------------*/
+
+static void
+_build_faces(const char        *path,
+             _gmsh_data_t      *gd,
+             cs_gnum_t          n_g_vertices,
+             cs_gnum_t          cell_shift,
+             cs_lnum_t         *n_faces,
+             cs_gnum_t        **face_cells,
+             int              **face_gc_id,
+             cs_gnum_t        **face_vtx)
+{
+  cs_lnum_t n_send = gd->n_f_elts;
+
+  for (cs_lnum_t i = 0; i < gd->n_cells; i++)
+    n_send += _cell_n_faces[gd->cell_type[i]];
+
+  cs_gnum_t *send_buf = NULL, *send_key = NULL;
+
+  BFT_MALLOC(send_buf, n_send*_FACE_STRIDE, cs_gnum_t);
+  BFT_MALLOC(send_key, n_send, cs_gnum_t);
+
+  cs_lnum_t k = 0;
+
+  for (cs_lnum_t i = 0; i < gd->n_cells; i++) {
+    const int type = gd->cell_type[i];
+    const cs_gnum_t *c_vtx = gd->cell_vtx + i*8;
+    for (int j = 0; j < _cell_n_faces[type]; j++) {
+      cs_gnum_t *f = send_buf + k*_FACE_STRIDE;
+      for (int l = 0; l < 4; l++) {
+        int v_id = _cell_face_vtx[type][j][l];
+        f[4+l] = (v_id > -1) ? c_vtx[v_id] : 0;
+      }
+      f[8] = cell_shift + i + 1;
+      f[9] = gd->cell_phys[i];
+      k++;
+    }
+  }
+
+  for (cs_lnum_t i = 0; i < gd->n_f_elts; i++) {
+    cs_gnum_t *f = send_buf + k*_FACE_STRIDE;
+    for (int l = 0; l < 4; l++)
+      f[4+l] = gd->f_elt_vtx[i*4 + l];
+    f[8] = 0;
+    f[9] = gd->f_elt_phys[i];
+    k++;
+  }
+
+  BFT_FREE(gd->cell_type);
+  BFT_FREE(gd->cell_vtx);
+  BFT_FREE(gd->f_elt_vtx);
+  BFT_FREE(gd->f_elt_phys);
+
+  /* Sorted keys (face element vertices not referenced by cells
+     have number 0, so their key is "invalidated" by sorting last) */
+
+  for (cs_lnum_t i = 0; i < n_send; i++) {
+    cs_gnum_t *f = send_buf + i*_FACE_STRIDE;
+    int n_vtx = (f[7] > 0) ? 4 : 3;
+    bool missing = false;
+    for (int l = 0; l < n_vtx; l++) {
+      cs_gnum_t v = f[4+l];
+      if (v == 0)
+        missing = true;
+      int m = l;
+      while (m > 0 && f[m-1] > v) {
+        f[m] = f[m-1];
+        m--;
+      }
+      f[m] = v;
+    }
+    if (n_vtx == 3)
+      f[3] = 0;
+    if (missing) { /* face element not adjacent to any cell */
+      f[0] = n_g_vertices + 1;
+      f[8] = 0;
+    }
+    send_key[i] = CS_MIN(f[0], n_g_vertices);
+    if (send_key[i] < 1)
+      send_key[i] = 1;
+  }
+
+  /* Exchange faces */
+
+  cs_lnum_t n_recv = n_send;
+  cs_gnum_t *recv_buf = send_buf;
+
+#if defined(HAVE_MPI)
+
+  if (cs_glob_n_ranks > 1) {
+
+    cs_block_dist_info_t bi
+      = cs_block_dist_compute_sizes(cs_glob_rank_id,
+                                    cs_glob_n_ranks,
+                                    1,
+                                    0,
+                                    n_g_vertices);
+
+    cs_all_to_all_t *d
+      = cs_all_to_all_create_from_block(n_send,
+                                        CS_ALL_TO_ALL_NO_REVERSE,
+                                        send_key,
+                                        bi,
+                                        cs_glob_mpi_comm);
+
+    recv_buf = cs_all_to_all_copy_array(d, CS_GNUM_TYPE, _FACE_STRIDE,
+                                        false, send_buf, NULL);
+    n_recv = cs_all_to_all_n_elts_dest(d);
+
+    cs_all_to_all_destroy(&d);
+
+    BFT_FREE(send_buf);
+
+  }
+
+#endif
+
+  BFT_FREE(send_key);
+
+  /* Match faces */
+
+  cs_lnum_t *order = cs_order_gnum_s(NULL, recv_buf, _FACE_STRIDE, n_recv);
+
+  cs_lnum_t _n_faces = 0;
+  cs_gnum_t n_orphans = 0, n_non_conforming = 0;
+
+  cs_gnum_t *_face_cells = NULL, *_face_vtx = NULL;
+  int *_face_gc_id = NULL;
+
+  BFT_MALLOC(_face_cells, n_recv*2, cs_gnum_t);
+  BFT_MALLOC(_face_vtx, n_recv*4, cs_gnum_t);
+  BFT_MALLOC(_face_gc_id, n_recv, int);
+
+  cs_lnum_t s_id = 0;
+
+  while (s_id < n_recv) {
+
+    const cs_gnum_t *f0 = recv_buf + order[s_id]*_FACE_STRIDE;
+
+    cs_lnum_t e_id = s_id + 1;
+    while (e_id < n_recv) {
+      const cs_gnum_t *f1 = recv_buf + order[e_id]*_FACE_STRIDE;
+      if (   f1[0] != f0[0] || f1[1] != f0[1]
+          || f1[2] != f0[2] || f1[3] != f0[3])
+        break;
+      e_id++;
+    }
+
+    /* Cell faces (at most 2) and face element group class */
+
+    const cs_gnum_t *c_f[2] = {NULL, NULL};
+    int n_c_faces = 0, gc_id = 0;
+
+    for (cs_lnum_t i = s_id; i < e_id; i++) {
+      const cs_gnum_t *f = recv_buf + order[i]*_FACE_STRIDE;
+      if (f[8] > 0) {
+        if (n_c_faces < 2)
+          c_f[n_c_faces] = f;
+        n_c_faces++;
+      }
+      else if (f[9] > 0)
+        gc_id = f[9];
+    }
+
+    if (n_c_faces == 0)
+      n_orphans += e_id - s_id;
+
+    else if (n_c_faces > 2)
+      n_non_conforming += 1;
+
+    else {
+      if (n_c_faces == 2 && c_f[1][8] < c_f[0][8]) {
+        const cs_gnum_t *tmp = c_f[0];
+        c_f[0] = c_f[1];
+        c_f[1] = tmp;
+      }
+      _face_cells[_n_faces*2] = c_f[0][8];
+      _face_cells[_n_faces*2 + 1] = (n_c_faces == 2) ? c_f[1][8] : 0;
+      for (int l = 0; l < 4; l++)
+        _face_vtx[_n_faces*4 + l] = c_f[0][4+l];
+      _face_gc_id[_n_faces] = gc_id;
+      _n_faces++;
+    }
+
+    s_id = e_id;
+
+  }
+
+  BFT_FREE(order);
+  BFT_FREE(recv_buf);
+
+  BFT_REALLOC(_face_cells, _n_faces*2, cs_gnum_t);
+  BFT_REALLOC(_face_vtx, _n_faces*4, cs_gnum_t);
+  BFT_REALLOC(_face_gc_id, _n_faces, int);
+
+  _exscan(n_non_conforming, &n_non_conforming);
+  if (n_non_conforming > 0)
+    bft_error(__FILE__, __LINE__, 0,
+              _("File \"%s\":\n"
+                "%llu faces are shared by more than 2 cells."),
+              path, (unsigned long long)n_non_conforming);
+
+  _exscan(n_orphans, &n_orphans);
+  if (n_orphans > 0)
+    bft_printf(_("   %llu face elements not adjacent to any cell ignored.\n"),
+               (unsigned long long)n_orphans);
+
+  *n_faces = _n_faces;
+  *face_cells = _face_cells;
+  *face_gc_id = _face_gc_id;
+  *face_vtx = _face_vtx;
+}
+
+/*----------------------------------------------------------------------------
+ * Write face -> vertices connectivity in block distribution.
+ *
+ * parameters:
+ *   mb     <-- mesh builder
+ *   pp_out <-> output file
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_face_vertices(const cs_mesh_builder_t  *mb,
+                     cs_io_t                  *pp_out)
+{
+  cs_gnum_t idx_range[4];
+  cs_gnum_t *face_vtx_idx_g = NULL;
+
+  const cs_gnum_t n_g_faces = mb->n_g_faces;
+  const cs_lnum_t n_block_faces
+    = mb->face_bi.gnum_range[1] - mb->face_bi.gnum_range[0];
+
+  /* Copy index from block to global values */
+
+  BFT_MALLOC(face_vtx_idx_g, n_block_faces + 1, cs_gnum_t);
+
+  cs_gnum_t block_size = mb->face_vertices_idx[n_block_faces];
+
+  face_vtx_idx_g[0] = _exscan(block_size, NULL) + 1;
+  for (cs_lnum_t i = 0; i < n_block_faces; i++)
+    face_vtx_idx_g[i+1] =   face_vtx_idx_g[i]
+                          + mb->face_vertices_idx[i+1]
+                          - mb->face_vertices_idx[i];
+
+  idx_range[0] = mb->face_bi.gnum_range[0];
+  idx_range[1] = mb->face_bi.gnum_range[1];
+  if (mb->face_bi.gnum_range[0] >= n_g_faces) {
+    idx_range[0] += 1;
+    idx_range[1] += 1;
+  }
+  else if (mb->face_bi.gnum_range[1] >= n_g_faces + 1)
+    idx_range[1] += 1;
+
+  idx_range[2] = face_vtx_idx_g[0];
+  idx_range[3] = face_vtx_idx_g[0] + block_size;
+
+  cs_io_write_block_buffer("face_vertices_index",
+                           n_g_faces + 1,
+                           idx_range[0],
+                           idx_range[1],
+                           2, /* location_id, */
+                           1, /* index id */
+                           1, /* n_location_vals */
+                           CS_GNUM_TYPE,
+                           face_vtx_idx_g,
+                           pp_out);
+
+  BFT_FREE(face_vtx_idx_g);
+
+  cs_io_write_block_buffer("face_vertices",
+                           mb->n_g_face_connect_size,
+                           idx_range[2],
+                           idx_range[3],
+                           2, /* location_id, */
+                           1, /* index id */
+                           1, /* n_location_vals */
+                           CS_GNUM_TYPE,
+                           mb->face_vertices,
+                           pp_out);
+}
+
+/*----------------------------------------------------------------------------
+ * Write mesh builder data as preprocessor data.
+ *
+ * parameters:
+ *   out_path       <-- output file path
+ *   mb             <-- mesh builder
+ *   n_g_cells      <-- global number of cells
+ *   n_g_vertices   <-- global number of vertices
+ *   n_gc           <-- number of group classes
+ *   n_groups       <-- number of groups
+ *   group_idx      <-- group names index (1 to n)
+ *   group          <-- group names
+ *   gc_properties  <-- group class properties
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_mesh_input(const char               *out_path,
+                  const cs_mesh_builder_t  *mb,
+                  cs_gnum_t                 n_g_cells,
+                  cs_gnum_t                 n_g_vertices,
+                  int                       n_gc,
+                  int                       n_groups,
+                  const int                 group_idx[],
+                  const char                group[],
+                  const int                 gc_properties[])
+{
+  cs_file_access_t  method;
+  cs_io_t  *pp_out = NULL;
+
+  const cs_gnum_t n_g_faces = mb->n_g_faces;
+  const int n_gc_props_max = 1;
+  const cs_datatype_t int_type = (sizeof(int) == 8) ? CS_INT64 : CS_INT32;
+
+#if defined(HAVE_MPI)
+  MPI_Info  hints;
+  MPI_Comm  block_comm, comm;
+  cs_file_get_default_comm(NULL, NULL, &block_comm, &comm);
+  cs_file_get_default_access(CS_FILE_MODE_WRITE, &method, &hints);
+  pp_out = cs_io_initialize(out_path,
+                            "Face-based mesh definition, R0",
+                            CS_IO_MODE_WRITE,
+                            method,
+                            CS_IO_ECHO_OPEN_CLOSE,
+                            hints,
+                            block_comm,
+                            comm);
+#else
+  cs_file_get_default_access(CS_FILE_MODE_WRITE, &method);
+  pp_out = cs_io_initialize(out_path,
+                            "Face-based mesh definition, R0",
+                            CS_IO_MODE_WRITE,
+                            method,
+                            CS_IO_ECHO_OPEN_CLOSE);
+#endif
+
+  /* Dimensions */
+
+  cs_io_write_global("start_block:dimensions", 0, 0, 0, 0, CS_DATATYPE_NULL,
+                     NULL, pp_out);
+
+  cs_io_write_global("n_cells", 1, 1, 0, 1, CS_GNUM_TYPE,
+                     &n_g_cells, pp_out);
+  cs_io_write_global("n_faces", 1, 2, 0, 1, CS_GNUM_TYPE,
+                     &n_g_faces, pp_out);
+  cs_io_write_global("n_vertices", 1, 3, 0, 1, CS_GNUM_TYPE,
+                     &n_g_vertices, pp_out);
+  cs_io_write_global("face_vertices_size", 1, 0, 0, 1, CS_GNUM_TYPE,
+                     &(mb->n_g_face_connect_size), pp_out);
+  cs_io_write_global("n_group_classes", 1, 0, 0, 1, int_type,
+                     &n_gc, pp_out);
+  cs_io_write_global("n_group_class_props_max", 1, 0, 0, 1, int_type,
+                     &n_gc_props_max, pp_out);
+
+  if (n_groups > 0) {
+    cs_io_write_global("n_groups", 1, 0, 0, 1, int_type,
+                       &n_groups, pp_out);
+    cs_io_write_global("group_name_index", n_groups + 1, 0, 0, 1, int_type,
+                       group_idx, pp_out);
+    cs_io_write_global("group_name", group_idx[n_groups] - 1, 0, 0, 1,
+                       CS_CHAR, group, pp_out);
+  }
+
+  cs_io_write_global("group_class_properties", n_gc*n_gc_props_max,
+                     0, 0, 1, int_type, gc_properties, pp_out);
+
+  cs_io_write_global("end_block:dimensions", 0, 0, 0, 0, CS_DATATYPE_NULL,
+                     NULL, pp_out);
+
+  /* Data */
+
+  cs_io_write_global("start_block:data", 0, 0, 0, 0, CS_DATATYPE_NULL,
+                     NULL, pp_out);
+
+  cs_io_write_block_buffer("face_cells",
+                           n_g_faces,
+                           mb->face_bi.gnum_range[0],
+                           mb->face_bi.gnum_range[1],
+                           2, /* location_id, */
+                           0, /* index id */
+                           2, /* n_location_vals */
+                           CS_GNUM_TYPE,
+                           mb->face_cells,
+                           pp_out);
+
+  cs_io_write_block_buffer("cell_group_class_id",
+                           n_g_cells,
+                           mb->cell_bi.gnum_range[0],
+                           mb->cell_bi.gnum_range[1],
+                           1, /* location_id, */
+                           0, /* index id */
+                           1, /* n_location_vals */
+                           int_type,
+                           mb->cell_gc_id,
+                           pp_out);
+
+  cs_io_write_block_buffer("face_group_class_id",
+                           n_g_faces,
+                           mb->face_bi.gnum_range[0],
+                           mb->face_bi.gnum_range[1],
+                           2, /* location_id, */
+                           0, /* index id */
+                           1, /* n_location_vals */
+                           int_type,
+                           mb->face_gc_id,
+                           pp_out);
+
+  _write_face_vertices(mb, pp_out);
+
+  cs_io_write_block_buffer("vertex_coords",
+                           n_g_vertices,
+                           mb->vertex_bi.gnum_range[0],
+                           mb->vertex_bi.gnum_range[1],
+                           3, /* location_id, */
+                           0, /* index id */
+                           3, /* n_location_vals */
+                           CS_REAL_TYPE,
+                           mb->vertex_coords,
+                           pp_out);
+
+  cs_io_write_global("end_block:data", 0, 0, 0, 0, CS_DATATYPE_NULL,
+                     NULL, pp_out);
+
+  cs_io_finalize(&pp_out);
+}
+
+/*! (DOXYGEN_SHOULD_SKIP_THIS) \endcond */
+
+/*============================================================================
+ * Public function definitions
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Import a Gmsh mesh file in parallel and save it as preprocessor
+ *        (mesh_input) data.
+ *
+ * Each rank reads a block of the file, builds the faces of the cells it
+ * read, and faces are matched on ranks determined by their vertices, so
+ * that the memory required on each rank is proportional to the block size,
+ * not to the global mesh size. The resulting data is written using
+ * block-distributed writes, and may then be read using
+ * \ref cs_preprocessor_data_add_file.
+ *
+ * Version 2 of the Gmsh format is handled, in either its ASCII or binary
+ * variant (with byte swapping if needed). Physical entities are converted to groups (using the physical names when
+ * defined), and high order elements are reduced to their linear vertices.
+ *
+ * This is a collective operation.
+ *
+ * \param[in]  path      path of Gmsh file to read
+ * \param[in]  out_path  path of mesh_input file to write
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_mesh_import_gmsh(const char  *path,
+                    const char  *out_path)
+{
+  double t0 = cs_timer_wtime();
+
+  bft_printf(_("\n Importing Gmsh mesh file: \"%s\"\n"), path);
+
+  _gmsh_data_t gd;
+  memset(&gd, 0, sizeof(_gmsh_data_t));
+
+  /* Read and parse local block */
+
+  if (_read_gmsh_binary(path, &gd) == false) {
+    size_t n_chars = 0;
+    cs_gnum_t offset = 0;
+    cs_gnum_t pos[GMSH_N_MARKERS];
+
+    char *buf = _read_text_block(path, &n_chars, &offset);
+
+    _locate_gmsh_sections(path, buf, n_chars, offset, pos);
+    _parse_gmsh_block(path, buf, n_chars, offset, pos, &gd);
+
+    BFT_FREE(buf);
+  }
+
+  double t1 = cs_timer_wtime();
+
+  /* Group classes */
+
+  int n_gc = 0, n_groups = 0;
+  int *group_idx = NULL, *gc_properties = NULL;
+  char *group = NULL;
+
+  _define_group_classes(&gd, &n_gc, &n_groups,
+                        &group_idx, &group, &gc_properties);
+
+  for (int i = 0; i < gd.n_phys; i++)
+    BFT_FREE(gd.phys_name[i]);
+  BFT_FREE(gd.phys_name);
+  BFT_FREE(gd.phys_dim_tag);
+
+  /* Vertices */
+
+  cs_gnum_t n_g_vertices = 0;
+  cs_gnum_t *tb_gnum = NULL;
+  cs_real_t *tb_coords = NULL;
+  cs_block_dist_info_t tb;
+
+  _number_vertices(path, &gd, &n_g_vertices, &tb_gnum, &tb_coords, &tb);
+
+  /* Faces */
+
+  cs_gnum_t n_g_cells = 0;
+  cs_gnum_t cell_shift = _exscan(gd.n_cells, &n_g_cells);
+
+  cs_lnum_t n_faces = 0;
+  cs_gnum_t *face_cells = NULL, *face_vtx = NULL;
+  int *face_gc_id = NULL;
+
+  _build_faces(path, &gd, n_g_vertices, cell_shift,
+               &n_faces, &face_cells, &face_gc_id, &face_vtx);
+
+  for (cs_lnum_t i = 0; i < n_faces; i++) {
+    if (face_gc_id[i] == 0)
+      face_gc_id[i] = n_gc;
+  }
+
+  double t2 = cs_timer_wtime();
+
+  /* Distribute data to blocks */
+
+  int block_rank_step = 1, block_min_size = 0;
+
+#if defined(HAVE_MPI)
+  cs_file_get_default_comm(&block_rank_step, &block_min_size, NULL, NULL);
+#endif
+
+  cs_mesh_builder_t *mb = cs_mesh_builder_create();
+
+  cs_gnum_t face_shift = _exscan(n_faces, &(mb->n_g_faces));
+  cs_gnum_t n_g_b_faces = 0;
+
+  {
+    cs_gnum_t n_b_faces = 0;
+    for (cs_lnum_t i = 0; i < n_faces; i++) {
+      if (face_cells[i*2 + 1] == 0)
+        n_b_faces++;
+    }
+    _exscan(n_b_faces, &n_g_b_faces);
+  }
+
+  cs_mesh_builder_define_block_dist(mb,
+                                    cs_glob_rank_id,
+                                    cs_glob_n_ranks,
+                                    block_rank_step,
+                                    block_min_size,
+                                    n_g_cells,
+                                    mb->n_g_faces,
+                                    n_g_vertices);
+
+  {
+    cs_gnum_t *gnum = NULL;
+
+    /* Cells */
+
+    const cs_lnum_t n_b_cells
+      = mb->cell_bi.gnum_range[1] - mb->cell_bi.gnum_range[0];
+
+    BFT_MALLOC(gnum, gd.n_cells, cs_gnum_t);
+    for (cs_lnum_t i = 0; i < gd.n_cells; i++)
+      gnum[i] = cell_shift + i + 1;
+
+    BFT_MALLOC(mb->cell_gc_id, n_b_cells, int);
+    _to_block(mb->cell_bi, gd.n_cells, gnum, CS_INT_TYPE, 1,
+              gd.cell_phys, mb->cell_gc_id);
+
+    BFT_FREE(gd.cell_phys);
+
+    /* Faces */
+
+    const cs_lnum_t n_b_faces
+      = mb->face_bi.gnum_range[1] - mb->face_bi.gnum_range[0];
+
+    BFT_REALLOC(gnum, n_faces, cs_gnum_t);
+    for (cs_lnum_t i = 0; i < n_faces; i++)
+      gnum[i] = face_shift + i + 1;
+
+    BFT_MALLOC(mb->face_cells, n_b_faces*2, cs_gnum_t);
+    _to_block(mb->face_bi, n_faces, gnum, CS_GNUM_TYPE, 2,
+              face_cells, mb->face_cells);
+    BFT_FREE(face_cells);
+
+    BFT_MALLOC(mb->face_gc_id, n_b_faces, int);
+    _to_block(mb->face_bi, n_faces, gnum, CS_INT_TYPE, 1,
+              face_gc_id, mb->face_gc_id);
+    BFT_FREE(face_gc_id);
+
+    cs_gnum_t *b_face_vtx = NULL;
+    BFT_MALLOC(b_face_vtx, n_b_faces*4, cs_gnum_t);
+    _to_block(mb->face_bi, n_faces, gnum, CS_GNUM_TYPE, 4,
+              face_vtx, b_face_vtx);
+    BFT_FREE(face_vtx);
+
+    BFT_MALLOC(mb->face_vertices_idx, n_b_faces + 1, cs_lnum_t);
+    BFT_MALLOC(mb->face_vertices, n_b_faces*4, cs_gnum_t);
+    mb->face_vertices_idx[0] = 0;
+    cs_lnum_t k = 0;
+    for (cs_lnum_t i = 0; i < n_b_faces; i++) {
+      for (int l = 0; l < 4; l++) {
+        if (b_face_vtx[i*4 + l] > 0)
+          mb->face_vertices[k++] = b_face_vtx[i*4 + l];
+      }
+      mb->face_vertices_idx[i+1] = k;
+    }
+    BFT_REALLOC(mb->face_vertices, k, cs_gnum_t);
+    BFT_FREE(b_face_vtx);
+
+    _exscan(k, &(mb->n_g_face_connect_size));
+
+    /* Vertices */
+
+    const cs_lnum_t n_tb = tb.gnum_range[1] - tb.gnum_range[0];
+    const cs_lnum_t n_b_vtx
+      = mb->vertex_bi.gnum_range[1] - mb->vertex_bi.gnum_range[0];
+
+    k = 0;
+    for (cs_lnum_t i = 0; i < n_tb; i++) {
+      if (tb_gnum[i] > 0) {
+        tb_gnum[k] = tb_gnum[i];
+        for (int l = 0; l < 3; l++)
+          tb_coords[k*3 + l] = tb_coords[i*3 + l];
+        k++;
+      }
+    }
+
+    BFT_MALLOC(mb->vertex_coords, n_b_vtx*3, cs_real_t);
+    _to_block(mb->vertex_bi, k, tb_gnum, CS_REAL_TYPE, 3,
+              tb_coords, mb->vertex_coords);
+
+    BFT_FREE(tb_gnum);
+    BFT_FREE(tb_coords);
+    BFT_FREE(gnum);
+  }
+
+  /* Write output */
+
+  _write_mesh_input(out_path, mb, n_g_cells, n_g_vertices,
+                    n_gc, n_groups, group_idx, group, gc_properties);
+
+  const cs_gnum_t n_g_faces = mb->n_g_faces;
+
+  cs_mesh_builder_destroy(&mb);
+
+  BFT_FREE(group_idx);
+  BFT_FREE(group);
+  BFT_FREE(gc_properties);
+
+  double t3 = cs_timer_wtime();
+
+  bft_printf(_("   Number of cells:          %llu\n"
+               "   Number of interior faces: %llu\n"
+               "   Number of boundary faces: %llu\n"
+               "   Number of vertices:       %llu\n"
+               "   Number of groups:         %d\n"
+               "   Read time:                %.3g s\n"
+               "   Faces build time:         %.3g s\n"
+               "   Write time:               %.3g s\n"),
+             (unsigned long long)n_g_cells,
+             (unsigned long long)(n_g_faces - n_g_b_faces),
+             (unsigned long long)n_g_b_faces,
+             (unsigned long long)n_g_vertices,
+             n_groups, t1 - t0, t2 - t1, t3 - t2);
+}
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
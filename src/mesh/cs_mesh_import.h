@@ -0,0 +1,75 @@
+#ifndef __CS_MESH_IMPORT_H__
+#define __CS_MESH_IMPORT_H__
+
+/*============================================================================
+ * Distributed import of external mesh formats
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+ *  Local headers
+ *----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+/*----------------------------------------------------------------------------*/
+
+BEGIN_C_DECLS
+
+/*============================================================================
+ *  Public function prototypes
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Import a Gmsh mesh file in parallel and save it as preprocessor
+ *        (mesh_input) data.
+ *
+ * Each rank reads a block of the file, builds the faces of the cells it
+ * read, and faces are matched on ranks determined by their vertices, so
+ * that the memory required on each rank is proportional to the block size,
+ * not to the global mesh size. The resulting data is written using
+ * block-distributed writes, and may then be read using
+ * \ref cs_preprocessor_data_add_file.
+ *
+ * Version 2 of the Gmsh format is handled, in either its ASCII or binary
+ * variant (with byte swapping if needed). Physical entities are converted to groups (using the physical names when
+ * defined), and high order elements are reduced to their linear vertices.
+ *
+ * This is a collective operation.
+ *
+ * \param[in]  path      path of Gmsh file to read
+ * \param[in]  out_path  path of mesh_input file to write
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_mesh_import_gmsh(const char  *path,
+                    const char  *out_path);
+
+/*----------------------------------------------------------------------------*/
+
+END_C_DECLS
+
+#endif /* __CS_MESH_IMPORT_H__ */
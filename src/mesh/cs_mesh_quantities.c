@@ -51,6 +51,7 @@
 #include "cs_math.h"
 #include "cs_mesh.h"
 #include "cs_mesh_connect.h"
+#include "cs_numa.h"
 #include "cs_parall.h"
 #include "cs_bad_cells_regularisation.h"
 
@@ -2323,28 +2324,36 @@ cs_mesh_quantities_compute_preprocess(const cs_mesh_t       *m,
   /* If this is not an update, allocate members of the structure */
 
   if (mq->i_face_normal == NULL)
-    BFT_MALLOC(mq->i_face_normal, n_i_faces*3, cs_real_t);
+    CS_NUMA_MALLOC(mq->i_face_normal, n_i_faces, 3, cs_real_t,
+                   m->i_face_numbering);
 
   if (mq->i_face_cog == NULL)
-    BFT_MALLOC(mq->i_face_cog, n_i_faces*3, cs_real_t);
+    CS_NUMA_MALLOC(mq->i_face_cog, n_i_faces, 3, cs_real_t,
+                   m->i_face_numbering);
 
   if (mq->b_face_normal == NULL)
-    BFT_MALLOC(mq->b_face_normal, n_b_faces*3, cs_real_t);
+    CS_NUMA_MALLOC(mq->b_face_normal, n_b_faces, 3, cs_real_t,
+                   m->b_face_numbering);
 
   if (mq->b_face_cog == NULL)
-    BFT_MALLOC(mq->b_face_cog, n_b_faces*3, cs_real_t);
+    CS_NUMA_MALLOC(mq->b_face_cog, n_b_faces, 3, cs_real_t,
+                   m->b_face_numbering);
 
   if (mq->cell_cen == NULL)
-    BFT_MALLOC(mq->cell_cen, n_cells_with_ghosts*3, cs_real_t);
+    CS_NUMA_MALLOC(mq->cell_cen, n_cells_with_ghosts, 3, cs_real_t,
+                   m->cell_numbering);
 
   if (mq->cell_vol == NULL)
-    BFT_MALLOC(mq->cell_vol, n_cells_with_ghosts, cs_real_t);
+    CS_NUMA_MALLOC(mq->cell_vol, n_cells_with_ghosts, 1, cs_real_t,
+                   m->cell_numbering);
 
   if (mq->i_face_surf == NULL)
-    BFT_MALLOC(mq->i_face_surf, n_i_faces, cs_real_t);
+    CS_NUMA_MALLOC(mq->i_face_surf, n_i_faces, 1, cs_real_t,
+                   m->i_face_numbering);
 
   if (mq->b_face_surf == NULL)
-    BFT_MALLOC(mq->b_face_surf, n_b_faces, cs_real_t);
+    CS_NUMA_MALLOC(mq->b_face_surf, n_b_faces, 1, cs_real_t,
+                   m->b_face_numbering);
 
   /* Compute face centers of gravity, normals, and surfaces */
 
@@ -2587,28 +2596,36 @@ cs_mesh_quantities_compute(const cs_mesh_t       *m,
   mq->tot_f_vol = mq->tot_vol;
 
   if (mq->i_dist == NULL)
-    BFT_MALLOC(mq->i_dist, n_i_faces, cs_real_t);
+    CS_NUMA_MALLOC(mq->i_dist, n_i_faces, 1, cs_real_t,
+                   m->i_face_numbering);
 
   if (mq->b_dist == NULL)
-    BFT_MALLOC(mq->b_dist, n_b_faces, cs_real_t);
+    CS_NUMA_MALLOC(mq->b_dist, n_b_faces, 1, cs_real_t,
+                   m->b_face_numbering);
 
   if (mq->weight == NULL)
-    BFT_MALLOC(mq->weight, n_i_faces, cs_real_t);
+    CS_NUMA_MALLOC(mq->weight, n_i_faces, 1, cs_real_t,
+                   m->i_face_numbering);
 
   if (mq->dijpf == NULL)
-    BFT_MALLOC(mq->dijpf, n_i_faces*dim, cs_real_t);
+    CS_NUMA_MALLOC(mq->dijpf, n_i_faces, dim, cs_real_t,
+                   m->i_face_numbering);
 
   if (mq->diipb == NULL)
-    BFT_MALLOC(mq->diipb, n_b_faces*dim, cs_real_t);
+    CS_NUMA_MALLOC(mq->diipb, n_b_faces, dim, cs_real_t,
+                   m->b_face_numbering);
 
   if (mq->dofij == NULL)
-    BFT_MALLOC(mq->dofij, n_i_faces*dim, cs_real_t);
+    CS_NUMA_MALLOC(mq->dofij, n_i_faces, dim, cs_real_t,
+                   m->i_face_numbering);
 
   if (mq->diipf == NULL)
-    BFT_MALLOC(mq->diipf, n_i_faces*dim, cs_real_t);
+    CS_NUMA_MALLOC(mq->diipf, n_i_faces, dim, cs_real_t,
+                   m->i_face_numbering);
 
   if (mq->djjpf == NULL)
-    BFT_MALLOC(mq->djjpf, n_i_faces*dim, cs_real_t);
+    CS_NUMA_MALLOC(mq->djjpf, n_i_faces, dim, cs_real_t,
+                   m->i_face_numbering);
 
   if (mq->b_sym_flag == NULL)
     BFT_MALLOC(mq->b_sym_flag, n_b_faces, int);
@@ -32,6 +32,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <limits.h>
 #include <locale.h>
 #include <math.h>
 #include <stdio.h>
@@ -98,6 +99,7 @@ extern "C" {
 #include "cs_mesh.h"
 #include "cs_mesh_builder.h"
 #include "cs_order.h"
+#include "cs_parall.h"
 #include "cs_part_to_block.h"
 #include "cs_timer.h"
 
@@ -210,6 +212,11 @@ static int                       *_part_extra_partitions_list = NULL;
 
 static bool                       _part_uniform_sfc_block_size = false;
 
+static int                        _part_n_constraints = 1;
+static double                    *_part_cell_weight = NULL; /* weights for
+                                                               next call,
+                                                               on cell_bi */
+
 #if defined(WIN32) || defined(_WIN32)
 static const char _dir_separator = '\\';
 #else
@@ -936,6 +943,263 @@ _precompute_cell_center_l(const cs_mesh_builder_t  *mb,
   BFT_FREE(weight);
 }
 
+/*----------------------------------------------------------------------------
+ * Define cell ranks from space-filling curve ordering and cell weights.
+ *
+ * The curve is split into portions of (approximately) equal total weight,
+ * using a prefix sum of weights in curve order.
+ *
+ * With multiple constraints, cells having nonzero secondary weights are
+ * distributed first, based on the sum of their weights normalized by the
+ * matching totals. Remaining cells are then distributed so as to complete
+ * each rank's share of the first constraint. Each rank thus receives up
+ * to 2 portions of the curve, and all constraints are balanced unless
+ * secondary weights are very unevenly distributed among the cells having
+ * them.
+ *
+ * parameters:
+ *   n_g_cells     <-- global number of cells
+ *   n_ranks       <-- number of ranks in partition
+ *   n_cells       <-- number of local cells
+ *   cell_num      <-- cell position along curve (1 to n numbering)
+ *   n_constraints <-- number of weights per cell
+ *   cell_weight   <-- cell weights (interlaced)
+ *   cell_rank     --> cell rank
+ *----------------------------------------------------------------------------*/
+
+static void
+_cell_rank_by_sfc_weights(cs_gnum_t         n_g_cells,
+                          int               n_ranks,
+                          cs_lnum_t         n_cells,
+                          const cs_gnum_t   cell_num[],
+                          int               n_constraints,
+                          const double      cell_weight[],
+                          int               cell_rank[])
+{
+  const int stride = n_constraints;
+
+  cs_lnum_t n_sfc_cells = n_cells;
+  double *sfc_weight = NULL;
+  int *sfc_rank = NULL;
+
+  /* Distribute weights by blocks in curve order */
+
+#if defined(HAVE_MPI)
+
+  cs_all_to_all_t *d = NULL;
+
+  if (cs_glob_n_ranks > 1) {
+
+    cs_block_dist_info_t sfc_bi
+      = cs_block_dist_compute_sizes(cs_glob_rank_id,
+                                    cs_glob_n_ranks,
+                                    1,
+                                    0,
+                                    n_g_cells);
+
+    d = cs_all_to_all_create_from_block(n_cells,
+                                        CS_ALL_TO_ALL_USE_DEST_ID,
+                                        cell_num,
+                                        sfc_bi,
+                                        cs_glob_mpi_comm);
+
+    sfc_weight = cs_all_to_all_copy_array(d,
+                                          CS_DOUBLE,
+                                          stride,
+                                          false,
+                                          cell_weight,
+                                          NULL);
+
+    n_sfc_cells = cs_all_to_all_n_elts_dest(d);
+
+  }
+
+#endif
+
+  if (cs_glob_n_ranks == 1) {
+    BFT_MALLOC(sfc_weight, n_cells*stride, double);
+    for (cs_lnum_t i = 0; i < n_cells; i++) {
+      for (int k = 0; k < stride; k++)
+        sfc_weight[(cell_num[i] - 1)*stride + k] = cell_weight[i*stride + k];
+    }
+  }
+
+  /* Sums of each constraint, and of the first constraint for cells
+     with secondary weights */
+
+  double w_sum[CS_PARTITION_MAX_CONSTRAINTS + 1];
+  for (int k = 0; k < stride + 1; k++)
+    w_sum[k] = 0;
+
+  char *is_sec = NULL;
+  BFT_MALLOC(is_sec, n_sfc_cells, char);
+
+  for (cs_lnum_t i = 0; i < n_sfc_cells; i++) {
+    is_sec[i] = 0;
+    for (int k = 0; k < stride; k++) {
+      w_sum[k] += sfc_weight[i*stride + k];
+      if (k > 0 && sfc_weight[i*stride + k] > 0)
+        is_sec[i] = 1;
+    }
+    if (is_sec[i])
+      w_sum[stride] += sfc_weight[i*stride];
+  }
+
+  cs_parall_sum(stride + 1, CS_DOUBLE, w_sum);
+
+  /* Single weight along curve for each cell */
+
+  double *c_weight = NULL;
+  BFT_MALLOC(c_weight, n_sfc_cells, double);
+
+  for (cs_lnum_t i = 0; i < n_sfc_cells; i++) {
+    c_weight[i] = sfc_weight[i*stride];
+    if (is_sec[i]) {
+      c_weight[i] /= w_sum[stride];
+      for (int k = 1; k < stride; k++) {
+        if (w_sum[k] > 0)
+          c_weight[i] += sfc_weight[i*stride + k] / w_sum[k];
+      }
+    }
+  }
+
+  /* Prefix sum of weights along curve, for cells with and without
+     secondary weights */
+
+  double w_loc[2] = {0, 0}, w_start[2] = {0, 0}, w_tot[2] = {0, 0};
+
+  for (cs_lnum_t i = 0; i < n_sfc_cells; i++) {
+    if (is_sec[i])
+      w_loc[0] += c_weight[i];
+    else
+      w_loc[1] += c_weight[i];
+  }
+
+  w_tot[0] = w_loc[0];
+  w_tot[1] = w_loc[1];
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1) {
+    MPI_Exscan(w_loc, w_start, 2, MPI_DOUBLE, MPI_SUM, cs_glob_mpi_comm);
+    if (cs_glob_rank_id == 0) {
+      w_start[0] = 0;
+      w_start[1] = 0;
+    }
+    MPI_Allreduce(w_loc, w_tot, 2, MPI_DOUBLE, MPI_SUM, cs_glob_mpi_comm);
+  }
+#endif
+
+  BFT_MALLOC(sfc_rank, n_sfc_cells, int);
+
+  /* Cells with secondary weights first */
+
+  double *r_weight = NULL;
+
+  if (w_tot[0] > 0) {
+
+    BFT_MALLOC(r_weight, n_ranks, double);
+    for (int r = 0; r < n_ranks; r++)
+      r_weight[r] = 0;
+
+    double w_cur = w_start[0];
+    double r_mult = (double)n_ranks / w_tot[0];
+
+    for (cs_lnum_t i = 0; i < n_sfc_cells; i++) {
+      if (is_sec[i]) {
+        int r = (w_cur + 0.5*c_weight[i]) * r_mult;
+        r = CS_MAX(CS_MIN(r, n_ranks - 1), 0);
+        sfc_rank[i] = r;
+        r_weight[r] += sfc_weight[i*stride];
+        w_cur += c_weight[i];
+      }
+    }
+
+    cs_parall_sum(n_ranks, CS_DOUBLE, r_weight);
+
+  }
+
+  /* Other cells */
+
+  if (r_weight == NULL) {
+
+    double w_cur = w_start[1];
+    double r_mult = (w_tot[1] > 0) ? (double)n_ranks / w_tot[1] : 0;
+
+    for (cs_lnum_t i = 0; i < n_sfc_cells; i++) {
+      int r = (w_cur + 0.5*c_weight[i]) * r_mult;
+      sfc_rank[i] = CS_MAX(CS_MIN(r, n_ranks - 1), 0);
+      w_cur += c_weight[i];
+    }
+
+  }
+  else {
+
+    /* Complete each rank's share of the first constraint;
+       r_weight is replaced by the cumulative target weights */
+
+    double w_mean = w_sum[0] / n_ranks;
+    double t_cur = 0;
+
+    for (int r = 0; r < n_ranks; r++) {
+      t_cur += CS_MAX(w_mean - r_weight[r], 0.);
+      r_weight[r] = t_cur;
+    }
+
+    if (t_cur <= 0) {
+      for (int r = 0; r < n_ranks; r++)
+        r_weight[r] = r + 1;
+      t_cur = n_ranks;
+    }
+
+    double w_cur = w_start[1];
+    double t_mult = (w_tot[1] > 0) ? t_cur / w_tot[1] : 0;
+
+    for (cs_lnum_t i = 0; i < n_sfc_cells; i++) {
+      if (is_sec[i] == 0) {
+        double t = (w_cur + 0.5*c_weight[i]) * t_mult;
+        int r_min = 0, r_max = n_ranks - 1;
+        while (r_min < r_max) {
+          int r_mid = (r_min + r_max) / 2;
+          if (r_weight[r_mid] > t)
+            r_max = r_mid;
+          else
+            r_min = r_mid + 1;
+        }
+        sfc_rank[i] = r_min;
+        w_cur += c_weight[i];
+      }
+    }
+
+    BFT_FREE(r_weight);
+
+  }
+
+  BFT_FREE(c_weight);
+  BFT_FREE(is_sec);
+  BFT_FREE(sfc_weight);
+
+  /* Return ranks to initial distribution */
+
+#if defined(HAVE_MPI)
+  if (d != NULL) {
+    cs_all_to_all_copy_array(d,
+                             CS_INT_TYPE,
+                             1,
+                             true, /* reverse */
+                             sfc_rank,
+                             cell_rank);
+    cs_all_to_all_destroy(&d);
+  }
+#endif
+
+  if (cs_glob_n_ranks == 1) {
+    for (cs_lnum_t i = 0; i < n_cells; i++)
+      cell_rank[i] = sfc_rank[cell_num[i] - 1];
+  }
+
+  BFT_FREE(sfc_rank);
+}
+
 /*----------------------------------------------------------------------------
  * Define cell ranks using a space-filling curve.
  *
@@ -943,9 +1207,11 @@ _precompute_cell_center_l(const cs_mesh_builder_t  *mb,
  *   n_g_cells   <-- global number of cells
  *   n_ranks     <-- number of ranks in partition
  *   mb          <-- pointer to mesh builder helper structure
- *   sfc_type    <-- type of space-filling curve
- *   cell_rank   --> cell rank (1 to n numbering)
- *   comm        <-- associated MPI communicator
+ *   sfc_type      <-- type of space-filling curve
+ *   n_constraints <-- number of weights per cell
+ *   cell_weight   <-- cell weights (interlaced), or NULL
+ *   cell_rank     --> cell rank (1 to n numbering)
+ *   comm          <-- associated MPI communicator
  *----------------------------------------------------------------------------*/
 
 #if defined(HAVE_MPI)
@@ -955,6 +1221,8 @@ _cell_rank_by_sfc(cs_gnum_t                 n_g_cells,
                   int                       n_ranks,
                   const cs_mesh_builder_t  *mb,
                   fvm_io_num_sfc_t          sfc_type,
+                  int                       n_constraints,
+                  const double              cell_weight[],
                   int                       cell_rank[],
                   MPI_Comm                  comm)
 
@@ -965,6 +1233,8 @@ _cell_rank_by_sfc(cs_gnum_t                 n_g_cells,
                   int                       n_ranks,
                   const cs_mesh_builder_t  *mb,
                   fvm_io_num_sfc_t          sfc_type,
+                  int                       n_constraints,
+                  const double              cell_weight[],
                   int                       cell_rank[])
 
 #endif
@@ -990,10 +1260,10 @@ _cell_rank_by_sfc(cs_gnum_t                 n_g_cells,
   BFT_MALLOC(cell_center, n_cells*3, cs_coord_t);
 
 #if defined(HAVE_MPI)
-  if (n_ranks > 1)
+  if (cs_glob_n_ranks > 1)
     _precompute_cell_center_g(mb, cell_center, comm);
 #endif
-  if (n_ranks == 1)
+  if (cs_glob_n_ranks == 1)
     _precompute_cell_center_l(mb, cell_center);
 
   end_time = cs_timer_time();
@@ -1019,7 +1289,16 @@ _cell_rank_by_sfc(cs_gnum_t                 n_g_cells,
 
   /* Determine rank based on global numbering with SFC ordering; */
 
-  if (_part_uniform_sfc_block_size == false) {
+  if (cell_weight != NULL)
+    _cell_rank_by_sfc_weights(n_g_cells,
+                              n_ranks,
+                              n_cells,
+                              cell_num,
+                              n_constraints,
+                              cell_weight,
+                              cell_rank);
+
+  else if (_part_uniform_sfc_block_size == false) {
 
     cs_gnum_t cells_per_rank = n_g_cells / n_ranks;
     cs_lnum_t rmdr = n_g_cells - cells_per_rank * (cs_gnum_t)n_ranks;
@@ -1354,15 +1633,19 @@ _metis_cell_cells(size_t       n_cells,
  *   n_parts       <-- number of partitions
  *   cell_cell_idx <-- cell->cells index
  *   cell_cell     <-- cell->cells connectivity
+ *   n_constraints <-- number of weights per cell
+ *   cell_weight   <-- cell weights (interlaced), or NULL
  *   cell_part     --> cell partition
  *----------------------------------------------------------------------------*/
 
 static void
-_part_metis(size_t   n_cells,
-            int      n_parts,
-            idx_t   *cell_idx,
-            idx_t   *cell_neighbors,
-            int     *cell_part)
+_part_metis(size_t         n_cells,
+            int            n_parts,
+            idx_t         *cell_idx,
+            idx_t         *cell_neighbors,
+            int            n_constraints,
+            const double  *cell_weight,
+            int           *cell_part)
 {
   size_t i;
   double  start_time, end_time;
@@ -1374,9 +1657,17 @@ _part_metis(size_t   n_cells,
   idx_t   _n_cells = n_cells;
   idx_t   _n_parts = n_parts;
   idx_t  *_cell_part = NULL;
+  idx_t  *vwgt = NULL;
 
   start_time = cs_timer_wtime();
 
+  if (cell_weight != NULL) {
+    _n_constraints = n_constraints;
+    BFT_MALLOC(vwgt, n_cells*n_constraints, idx_t);
+    for (i = 0; i < n_cells*n_constraints; i++)
+      vwgt[i] = cell_weight[i];
+  }
+
   if (sizeof(idx_t) == sizeof(int))
     _cell_part = (idx_t *)cell_part;
 
@@ -1394,7 +1685,7 @@ _part_metis(size_t   n_cells,
                              &_n_constraints,
                              cell_idx,
                              cell_neighbors,
-                             NULL,       /* vwgt:   cell weights */
+                             vwgt,       /* vwgt:   cell weights */
                              NULL,       /* vsize:  size of the vertices */
                              NULL,       /* adjwgt: face weights */
                              &_n_parts,
@@ -1417,7 +1708,7 @@ _part_metis(size_t   n_cells,
                         &_n_constraints,
                         cell_idx,
                         cell_neighbors,
-                        NULL,       /* vwgt:   cell weights */
+                        vwgt,       /* vwgt:   cell weights */
                         NULL,       /* vsize:  size of the vertices */
                         NULL,       /* adjwgt: face weights */
                         &_n_parts,
@@ -1441,6 +1732,8 @@ _part_metis(size_t   n_cells,
                 "  METIS_PartGraphKway:        %.3g s\n",
                 (double)(end_time - start_time));
 
+  BFT_FREE(vwgt);
+
   if (sizeof(idx_t) != sizeof(int)) {
     for (i = 0; i < n_cells; i++)
       cell_part[i] = _cell_part[i];
@@ -1461,18 +1754,22 @@ _part_metis(size_t   n_cells,
  *   n_parts       <-- number of partitions
  *   cell_cell_idx <-- cell->cells index
  *   cell_cell     <-- cell->cells connectivity
+ *   n_constraints <-- number of weights per cell
+ *   cell_weight   <-- cell weights (interlaced), or NULL
  *   cell_part     --> cell partition
  *   comm          <-- associated MPI communicator
  *----------------------------------------------------------------------------*/
 
 static void
-_part_parmetis(cs_gnum_t   n_g_cells,
-               cs_gnum_t   cell_range[2],
-               int         n_parts,
-               idx_t      *cell_idx,
-               idx_t      *cell_neighbors,
-               int        *cell_part,
-               MPI_Comm    comm)
+_part_parmetis(cs_gnum_t      n_g_cells,
+               cs_gnum_t      cell_range[2],
+               int            n_parts,
+               idx_t         *cell_idx,
+               idx_t         *cell_neighbors,
+               int            n_constraints,
+               const double  *cell_weight,
+               int           *cell_part,
+               MPI_Comm       comm)
 {
   size_t i;
   double  start_time, end_time;
@@ -1532,21 +1829,33 @@ _part_parmetis(cs_gnum_t   n_g_cells,
     idx_t  options[3] = {0, 1, 15}; /* By default if options[0] = 0 */
     idx_t  numflag  = 0; /* 0 to n-1 numbering (C type) */
     idx_t  wgtflag  = 0; /* No weighting for faces or cells */
+    idx_t  *vwgt = NULL;
+
+    if (cell_weight != NULL) {
+      wgtflag = 2; /* Weights on cells only */
+      ncon = n_constraints;
+      BFT_MALLOC(vwgt, n_cells*ncon, idx_t);
+      for (i = 0; i < n_cells*ncon; i++)
+        vwgt[i] = cell_weight[i];
+    }
 
     real_t wgt = 1.0/n_parts;
-    real_t ubvec[]  = {1.5};
+    real_t ubvec[CS_PARTITION_MAX_CONSTRAINTS];
     real_t *tpwgts = NULL;
 
-    BFT_MALLOC(tpwgts, n_parts, real_t);
+    for (j = 0; j < ncon; j++)
+      ubvec[j] = 1.5;
 
-    for (j = 0; j < n_parts; j++)
+    BFT_MALLOC(tpwgts, n_parts*ncon, real_t);
+
+    for (j = 0; j < n_parts*ncon; j++)
       tpwgts[j] = wgt;
 
     int retval = ParMETIS_V3_PartKway
                    (vtxdist,
                     cell_idx,
                     cell_neighbors,
-                    NULL,       /* vwgt:   cell weights */
+                    vwgt,       /* vwgt:   cell weights */
                     NULL,       /* adjwgt: face weights */
                     &wgtflag,
                     &numflag,
@@ -1560,6 +1869,7 @@ _part_parmetis(cs_gnum_t   n_g_cells,
                     &comm);
 
     BFT_FREE(tpwgts);
+    BFT_FREE(vwgt);
 
     edgecut = _edgecut;
 
@@ -1851,15 +2161,17 @@ _scotch_cell_cells(size_t        n_cells,
  *   n_parts       <-- number of partitions
  *   cell_cell_idx <-- cell->cells index
  *   cell_cell     <-- cell->cells connectivity
+ *   cell_weight   <-- cell weights, or NULL
  *   cell_part     --> cell partition
  *----------------------------------------------------------------------------*/
 
 static void
-_part_scotch(SCOTCH_Num   n_cells,
-             int          n_parts,
-             SCOTCH_Num  *cell_idx,
-             SCOTCH_Num  *cell_neighbors,
-             int         *cell_part)
+_part_scotch(SCOTCH_Num     n_cells,
+             int            n_parts,
+             SCOTCH_Num    *cell_idx,
+             SCOTCH_Num    *cell_neighbors,
+             const double  *cell_weight,
+             int           *cell_part)
 {
   SCOTCH_Num  i;
   SCOTCH_Graph  grafdat;  /* Scotch graph object to interface with libScotch */
@@ -1871,6 +2183,7 @@ _part_scotch(SCOTCH_Num   n_cells,
 
   SCOTCH_Num    edgecut = 0; /* <-- Number of faces on partition */
   SCOTCH_Num  *_cell_part = NULL;
+  SCOTCH_Num  *velotab = NULL;
 
   /* Initialization */
 
@@ -1881,6 +2194,12 @@ _part_scotch(SCOTCH_Num   n_cells,
   else
     BFT_MALLOC(_cell_part, n_cells, SCOTCH_Num);
 
+  if (cell_weight != NULL) {
+    BFT_MALLOC(velotab, n_cells, SCOTCH_Num);
+    for (i = 0; i < n_cells; i++)
+      velotab[i] = cell_weight[i];
+  }
+
   bft_printf(_("\n"
                " Partitioning %llu cells to %d domains\n"
                "   (SCOTCH_graphPart).\n"),
@@ -1896,7 +2215,7 @@ _part_scotch(SCOTCH_Num   n_cells,
                         n_cells,            /* vertnbr */
                         cell_idx,           /* verttab */
                         NULL,               /* vendtab: verttab + 1 or NULL */
-                        NULL,               /* velotab: vertex weights */
+                        velotab,            /* velotab: vertex weights */
                         NULL,               /* vlbltab; vertex labels */
                         cell_idx[n_cells],  /* edgenbr */
                         cell_neighbors,     /* edgetab */
@@ -1914,6 +2233,8 @@ _part_scotch(SCOTCH_Num   n_cells,
 
   SCOTCH_graphExit(&grafdat);
 
+  BFT_FREE(velotab);
+
   /* Shift cell_part values to 1 to n numbering and free possible temporary */
 
   if (sizeof(SCOTCH_Num) != sizeof(int)) {
@@ -1972,18 +2293,20 @@ _part_scotch(SCOTCH_Num   n_cells,
  *   n_parts       <-- number of partitions
  *   cell_cell_idx <-- cell->cells index
  *   cell_cell     <-- cell->cells connectivity
+ *   cell_weight   <-- cell weights, or NULL
  *   cell_part     --> cell partition
  *   comm          <-- associated MPI communicator
  *----------------------------------------------------------------------------*/
 
 static void
-_part_ptscotch(cs_gnum_t    n_g_cells,
-               cs_gnum_t    cell_range[2],
-               int          n_parts,
-               SCOTCH_Num  *cell_idx,
-               SCOTCH_Num  *cell_neighbors,
-               int         *cell_part,
-               MPI_Comm     comm)
+_part_ptscotch(cs_gnum_t      n_g_cells,
+               cs_gnum_t      cell_range[2],
+               int            n_parts,
+               SCOTCH_Num    *cell_idx,
+               SCOTCH_Num    *cell_neighbors,
+               const double  *cell_weight,
+               int           *cell_part,
+               MPI_Comm       comm)
 {
   int  n_ranks;
   SCOTCH_Num  i;
@@ -1996,6 +2319,7 @@ _part_ptscotch(cs_gnum_t    n_g_cells,
 
   SCOTCH_Num    n_cells = cell_range[1] - cell_range[0];
   SCOTCH_Num  *_cell_part = NULL;
+  SCOTCH_Num  *veloloctab = NULL;
 
   /* Initialization */
 
@@ -2008,6 +2332,12 @@ _part_ptscotch(cs_gnum_t    n_g_cells,
   else
     BFT_MALLOC(_cell_part, n_cells, SCOTCH_Num);
 
+  if (cell_weight != NULL) {
+    BFT_MALLOC(veloloctab, n_cells, SCOTCH_Num);
+    for (i = 0; i < n_cells; i++)
+      veloloctab[i] = cell_weight[i];
+  }
+
   bft_printf(_("\n"
                " Partitioning %llu cells to %d domains on %d ranks\n"
                "   (SCOTCH_dgraphPart).\n"),
@@ -2025,7 +2355,7 @@ _part_ptscotch(cs_gnum_t    n_g_cells,
                 n_cells,            /* vertlocmax (= vertlocnbr) */
                 cell_idx,           /* vertloctab */
                 NULL,               /* vendloctab: vertloctab + 1 or NULL */
-                NULL,               /* veloloctab: vertex weights */
+                veloloctab,         /* veloloctab: vertex weights */
                 NULL,               /* vlblloctab; vertex labels */
                 cell_idx[n_cells],  /* edgelocnbr */
                 cell_idx[n_cells],  /* edgelocsiz */
@@ -2046,6 +2376,8 @@ _part_ptscotch(cs_gnum_t    n_g_cells,
 
   SCOTCH_dgraphExit(&grafdat);
 
+  BFT_FREE(veloloctab);
+
   /* Shift cell_part values to 1 to n numbering and free possible temporary */
 
   if (sizeof(SCOTCH_Num) != sizeof(int)) {
@@ -2069,6 +2401,198 @@ _part_ptscotch(cs_gnum_t    n_g_cells,
 
 #endif /* defined(HAVE_PTSCOTCH) */
 
+/*----------------------------------------------------------------------------
+ * Combine multi-constraint cell weights into a single weight per cell.
+ *
+ * This is used to approximate multi-constraint partitioning with
+ * partitioners handling a single constraint; weights are simply summed,
+ * so they are assumed to be expressed in comparable units (such as an
+ * estimated cost).
+ *
+ * The caller is responsible for freeing the returned array.
+ *
+ * parameters:
+ *   n_cells       <-- number of cells
+ *   n_constraints <-- number of weights per cell
+ *   cell_weight   <-- cell weights (interlaced)
+ *
+ * returns:
+ *   combined cell weights, or NULL if cell_weight is NULL
+ *----------------------------------------------------------------------------*/
+
+static double *
+_combine_cell_weights(cs_lnum_t      n_cells,
+                      int            n_constraints,
+                      const double   cell_weight[])
+{
+  if (cell_weight == NULL)
+    return NULL;
+
+  double *c_weight = NULL;
+  BFT_MALLOC(c_weight, n_cells, double);
+
+  for (cs_lnum_t i = 0; i < n_cells; i++) {
+    c_weight[i] = 0;
+    for (int j = 0; j < n_constraints; j++)
+      c_weight[i] += cell_weight[i*n_constraints + j];
+  }
+
+  return c_weight;
+}
+
+/*----------------------------------------------------------------------------
+ * Return integer-valued cell weights for graph-based partitioning.
+ *
+ * Weights defined on the mesh builder's cell block distribution are
+ * redistributed to the partitioner's cell range if needed, and scaled
+ * so that the mean weight is close to 100 (or less for very large meshes,
+ * so that the total weight fits in a 32-bit integer).
+ *
+ * With multiple constraints, each constraint is scaled independently,
+ * unless constraints are combined into a single weight (for partitioners
+ * which do not handle multiple constraints). Only the first constraint
+ * is required to be strictly positive.
+ *
+ * The caller is responsible for freeing the returned array.
+ *
+ * parameters:
+ *   mesh          <-- pointer to mesh structure
+ *   mb            <-- pointer to mesh builder structure
+ *   cell_range    <-- first and past-the-last cell numbers for this rank
+ *   combine       <-- if true, combine constraints into a single weight
+ *   n_constraints --> number of weights per cell in returned array
+ *
+ * returns:
+ *   cell weights for cell range (interlaced), or NULL if no weights are
+ *   defined
+ *----------------------------------------------------------------------------*/
+
+static double *
+_cell_weights_in_range(const cs_mesh_t          *mesh,
+                       const cs_mesh_builder_t  *mb,
+                       const cs_gnum_t           cell_range[2],
+                       bool                      combine,
+                       int                      *n_constraints)
+{
+  *n_constraints = 1;
+
+  if (_part_cell_weight == NULL)
+    return NULL;
+
+  cs_lnum_t n_b_cells = 0, n_p_cells = 0;
+
+  if (mb->cell_bi.gnum_range[1] > mb->cell_bi.gnum_range[0])
+    n_b_cells = mb->cell_bi.gnum_range[1] - mb->cell_bi.gnum_range[0];
+  if (cell_range[1] > cell_range[0])
+    n_p_cells = cell_range[1] - cell_range[0];
+
+  /* Combine constraints first if required */
+
+  int stride = _part_n_constraints;
+  double *b_cell_weight = _part_cell_weight;
+
+  if (combine && stride > 1) {
+    b_cell_weight = _combine_cell_weights(n_b_cells,
+                                          stride,
+                                          _part_cell_weight);
+    stride = 1;
+  }
+
+  double *cell_weight = NULL;
+  BFT_MALLOC(cell_weight, n_p_cells*stride, double);
+
+  if (   cell_range[0] == mb->cell_bi.gnum_range[0]
+      && cell_range[1] == mb->cell_bi.gnum_range[1])
+    memcpy(cell_weight, b_cell_weight, n_p_cells*stride*sizeof(double));
+
+#if defined(HAVE_MPI)
+
+  else {
+
+    cs_gnum_t *cell_gnum = NULL;
+    BFT_MALLOC(cell_gnum, n_p_cells, cs_gnum_t);
+    for (cs_lnum_t i = 0; i < n_p_cells; i++)
+      cell_gnum[i] = cell_range[0] + i;
+
+    cs_all_to_all_t *d
+      = cs_all_to_all_create_from_block(n_p_cells,
+                                        0, /* flags */
+                                        cell_gnum,
+                                        mb->cell_bi,
+                                        cs_glob_mpi_comm);
+
+    cs_gnum_t *b_gnum = cs_all_to_all_copy_array(d,
+                                                 CS_GNUM_TYPE,
+                                                 1,
+                                                 false,
+                                                 cell_gnum,
+                                                 NULL);
+
+    cs_lnum_t n_recv = cs_all_to_all_n_elts_dest(d);
+
+    double *b_weight = NULL;
+    BFT_MALLOC(b_weight, n_recv*stride, double);
+    for (cs_lnum_t i = 0; i < n_recv; i++) {
+      cs_lnum_t j = b_gnum[i] - mb->cell_bi.gnum_range[0];
+      for (int k = 0; k < stride; k++)
+        b_weight[i*stride + k] = b_cell_weight[j*stride + k];
+    }
+
+    cs_all_to_all_copy_array(d,
+                             CS_DOUBLE,
+                             stride,
+                             true, /* reverse */
+                             b_weight,
+                             cell_weight);
+
+    BFT_FREE(b_weight);
+    BFT_FREE(b_gnum);
+    BFT_FREE(cell_gnum);
+
+    cs_all_to_all_destroy(&d);
+  }
+
+#endif /* defined(HAVE_MPI) */
+
+  /* Scale weights (based on builder distribution, which has no duplicates) */
+
+  double w_sum[CS_PARTITION_MAX_CONSTRAINTS];
+  for (int k = 0; k < stride; k++)
+    w_sum[k] = 0;
+
+  for (cs_lnum_t i = 0; i < n_b_cells; i++) {
+    for (int k = 0; k < stride; k++)
+      w_sum[k] += b_cell_weight[i*stride + k];
+  }
+
+  cs_parall_sum(stride, CS_DOUBLE, w_sum);
+
+  if (b_cell_weight != _part_cell_weight)
+    BFT_FREE(b_cell_weight);
+
+  double w_scale = 100.;
+  if (mesh->n_g_cells > 0) {
+    double w_scale_max = (double)(INT_MAX/2) / (double)(mesh->n_g_cells);
+    w_scale = CS_MAX(CS_MIN(w_scale, w_scale_max), 1.);
+  }
+
+  for (int k = 0; k < stride; k++) {
+
+    double w_mult = (w_sum[k] > 0) ? w_scale * mesh->n_g_cells / w_sum[k] : 1.;
+    double w_min = (k == 0) ? 1. : 0.;
+
+    for (cs_lnum_t i = 0; i < n_p_cells; i++) {
+      double w = floor(cell_weight[i*stride + k]*w_mult + 0.5);
+      cell_weight[i*stride + k] = CS_MAX(w, w_min);
+    }
+
+  }
+
+  *n_constraints = stride;
+
+  return cell_weight;
+}
+
 /*----------------------------------------------------------------------------
  * Prepare input from mesh builder for use by partitioner.
  *
@@ -3055,6 +3579,63 @@ cs_partition_add_partitions(int  n_extra_partitions,
            sizeof(int)*n_extra_partitions);
 }
 
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Define cell weights for the next partitioning.
+ *
+ * Weights are defined on the cell block distribution of the mesh builder
+ * (i.e. mb->cell_bi) which will be passed to the next call to
+ * \ref cs_partition, and are used by the graph-based (METIS, SCOTCH) and
+ * space-filling curve partitioners (the naive block partitioning ignores
+ * them). Existing partitioning files are ignored when weights are defined.
+ *
+ * Ownership of the array is transferred; it is freed once used.
+ *
+ * \param[in]  cell_weight  cell weights (strictly positive)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_partition_set_cell_weights(double  cell_weight[])
+{
+  cs_partition_set_cell_constraint_weights(1, cell_weight);
+}
+
+/*----------------------------------------------------------------------------*/
+/*!
+ * \brief Define multiple-constraint cell weights for the next partitioning.
+ *
+ * This is similar to \ref cs_partition_set_cell_weights, with
+ * n_constraints weights per cell (interlaced), for example a fluid and a
+ * particle load. METIS, ParMETIS, and space-filling curve partitioners
+ * balance each constraint separately; SCOTCH and PT-SCOTCH only handle
+ * a single constraint, so the sum of weights is used instead; weights
+ * should thus be expressed in comparable units (such as an estimated
+ * cost) for this approximation to be meaningful.
+ *
+ * Ownership of the array is transferred; it is freed once used.
+ *
+ * \param[in]  n_constraints  number of weights per cell
+ *                            (1 to CS_PARTITION_MAX_CONSTRAINTS)
+ * \param[in]  cell_weight    cell weights (first weight strictly positive,
+ *                            others positive or zero)
+ */
+/*----------------------------------------------------------------------------*/
+
+void
+cs_partition_set_cell_constraint_weights(int     n_constraints,
+                                         double  cell_weight[])
+{
+  if (n_constraints < 1 || n_constraints > CS_PARTITION_MAX_CONSTRAINTS)
+    bft_error(__FILE__, __LINE__, 0,
+              _("%s: number of constraints (%d) must be in range [1, %d]."),
+              __func__, n_constraints, CS_PARTITION_MAX_CONSTRAINTS);
+
+  BFT_FREE(_part_cell_weight);
+  _part_n_constraints = n_constraints;
+  _part_cell_weight = cell_weight;
+}
+
 /*----------------------------------------------------------------------------*/
 /*!
  * \brief Partition mesh based on current options.
@@ -3086,6 +3667,9 @@ cs_partition(cs_mesh_t             *mesh,
   cs_lnum_t  n_faces = 0;
   cs_gnum_t  *face_cells = NULL;
 
+  int      n_constraints = 1;
+  double  *cell_weight = NULL;
+
   /* Initialize local options */
 
   if (stage == CS_PARTITION_MAIN) {
@@ -3109,8 +3693,9 @@ cs_partition(cs_mesh_t             *mesh,
   /* Read cell rank data if available */
 
   if (cs_glob_n_ranks > 1) {
-    if (   stage != CS_PARTITION_MAIN
-        || cs_partition_get_preprocess() == false) {
+    if (   (   stage != CS_PARTITION_MAIN
+            || cs_partition_get_preprocess() == false)
+        && _part_cell_weight == NULL) {
       _read_cell_rank(mesh, mb, CS_IO_ECHO_OPEN_CLOSE);
       if (mb->have_cell_rank)
         return;
@@ -3127,6 +3712,14 @@ cs_partition(cs_mesh_t             *mesh,
 
   bft_printf("\n ----------------------------------------------------------\n");
 
+  if (_part_cell_weight != NULL) {
+    if (_part_n_constraints > 1)
+      bft_printf(_("\n Partitioning using cell weights (%d constraints).\n"),
+                 _part_n_constraints);
+    else
+      bft_printf(_("\n Partitioning using cell weights.\n"));
+  }
+
   cs_log_printf(CS_LOG_PERFORMANCE,
                 _("\n"
                   "Partitioning:\n\n"));
@@ -3149,6 +3742,15 @@ cs_partition(cs_mesh_t             *mesh,
 
     n_cells = cell_range[1] - cell_range[0];
 
+    /* Among graph partitioners, only METIS and ParMETIS handle
+       multiple constraints */
+
+    cell_weight = _cell_weights_in_range(mesh,
+                                         mb,
+                                         cell_range,
+                                         (_algorithm != CS_PARTITION_METIS),
+                                         &n_constraints);
+
   }
   else {
 
@@ -3216,6 +3818,8 @@ cs_partition(cs_mesh_t             *mesh,
                          n_ranks,
                          cell_idx,
                          cell_neighbors,
+                         n_constraints,
+                         cell_weight,
                          cell_part,
                          part_comm);
 
@@ -3263,6 +3867,8 @@ cs_partition(cs_mesh_t             *mesh,
                       n_ranks,
                       cell_idx,
                       cell_neighbors,
+                      n_constraints,
+                      cell_weight,
                       cell_part);
 
         _distribute_output(mb,
@@ -3343,6 +3949,7 @@ cs_partition(cs_mesh_t             *mesh,
                          n_ranks,
                          cell_idx,
                          cell_neighbors,
+                         cell_weight,
                          cell_part,
                          part_comm);
 
@@ -3390,6 +3997,7 @@ cs_partition(cs_mesh_t             *mesh,
                        n_ranks,
                        cell_idx,
                        cell_neighbors,
+                       cell_weight,
                        cell_part);
 
         _distribute_output(mb,
@@ -3441,10 +4049,13 @@ cs_partition(cs_mesh_t             *mesh,
                         n_ranks,
                         mb,
                         sfc_type,
+                        _part_n_constraints,
+                        _part_cell_weight,
                         cell_part,
                         cs_glob_mpi_comm);
 #else
-      _cell_rank_by_sfc(mesh->n_g_cells, n_ranks, mb, sfc_type, cell_part);
+      _cell_rank_by_sfc(mesh->n_g_cells, n_ranks, mb, sfc_type,
+                        _part_n_constraints, _part_cell_weight, cell_part);
 #endif
 
       _cell_part_histogram(mb->cell_bi.gnum_range, n_ranks, cell_part);
@@ -3475,6 +4086,12 @@ cs_partition(cs_mesh_t             *mesh,
     _part_n_extra_partitions = 0;
   }
 
+  /* Cell weights are only used once */
+
+  BFT_FREE(cell_weight);
+  BFT_FREE(_part_cell_weight);
+  _part_n_constraints = 1;
+
   /* Copy to mesh builder */
 
   mb->have_cell_rank = true;
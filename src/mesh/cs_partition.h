@@ -46,6 +46,10 @@ BEGIN_C_DECLS
  * Macro definitions
  *============================================================================*/
 
+/* Maximum number of weights (constraints) per cell for partitioning */
+
+#define CS_PARTITION_MAX_CONSTRAINTS  4
+
 /*============================================================================
  * Type definitions
  *============================================================================*/
@@ -224,6 +228,48 @@ void
 cs_partition_add_partitions(int  n_extra_partitions,
                             int  extra_partitions_list[]);
 
+/*----------------------------------------------------------------------------
+ * Define cell weights for the next partitioning.
+ *
+ * Weights are defined on the cell block distribution of the mesh builder
+ * (i.e. mb->cell_bi) which will be passed to the next call to
+ * cs_partition(), and are used by the graph-based (METIS, SCOTCH) and
+ * space-filling curve partitioners (the naive block partitioning ignores
+ * them). Existing partitioning files are ignored when weights are defined.
+ *
+ * Ownership of the array is transferred; it is freed once used.
+ *
+ * parameters:
+ *   cell_weight <-- cell weights (strictly positive)
+ *----------------------------------------------------------------------------*/
+
+void
+cs_partition_set_cell_weights(double  cell_weight[]);
+
+/*----------------------------------------------------------------------------
+ * Define multiple-constraint cell weights for the next partitioning.
+ *
+ * This is similar to cs_partition_set_cell_weights(), with n_constraints
+ * weights per cell (interlaced), for example a fluid and a particle load.
+ * METIS, ParMETIS, and space-filling curve partitioners balance each
+ * constraint separately; SCOTCH and PT-SCOTCH only handle a single
+ * constraint, so the sum of weights is used instead; weights should thus
+ * be expressed in comparable units (such as an estimated cost) for this
+ * approximation to be meaningful.
+ *
+ * Ownership of the array is transferred; it is freed once used.
+ *
+ * parameters:
+ *   n_constraints <-- number of weights per cell
+ *                     (1 to CS_PARTITION_MAX_CONSTRAINTS)
+ *   cell_weight   <-- cell weights (first weight strictly positive,
+ *                     others positive or zero)
+ *----------------------------------------------------------------------------*/
+
+void
+cs_partition_set_cell_constraint_weights(int     n_constraints,
+                                         double  cell_weight[]);
+
 /*----------------------------------------------------------------------------
  * Compute partitioning for a given mesh.
  *
@@ -69,6 +69,7 @@
 #include "cs_physical_constants.h"
 #include "cs_physical_model.h"
 #include "cs_prototypes.h"
+#include "cs_scratch.h"
 #include "cs_sles.h"
 #include "cs_sles_it.h"
 #include "cs_time_step.h"
@@ -398,20 +399,22 @@ _cs_rad_transfer_sol(int                        gg_id,
   cs_field_t *f_qincid = cs_field_by_name("rad_incident_flux");
   cs_field_t *f_snplus = cs_field_by_name("rad_net_flux");
 
-  /* Allocate work arrays */
+  /* Allocate work arrays (from scratch memory, released on exit) */
+
+  cs_scratch_mark_t s_mark = cs_scratch_mark();
 
   cs_real_t *rhs0, *dpvar, *radiance, *radiance_prev;
   cs_real_t *ck_u_d = NULL;
-  BFT_MALLOC(rhs0,  n_cells_ext, cs_real_t);
-  BFT_MALLOC(dpvar, n_cells_ext, cs_real_t);
-  BFT_MALLOC(radiance, n_cells_ext, cs_real_t);
-  BFT_MALLOC(radiance_prev, n_cells_ext, cs_real_t);
+  CS_SCRATCH_ALLOC(rhs0,  n_cells_ext, cs_real_t);
+  CS_SCRATCH_ALLOC(dpvar, n_cells_ext, cs_real_t);
+  CS_SCRATCH_ALLOC(radiance, n_cells_ext, cs_real_t);
+  CS_SCRATCH_ALLOC(radiance_prev, n_cells_ext, cs_real_t);
 
   /* Specific heat capacity of the bulk phase */
   // CAUTION FOR NEPTUNE INTEGRATION HERE
 
   cs_real_t *dcp;
-  BFT_MALLOC(dcp, n_cells_ext, cs_real_t);
+  CS_SCRATCH_ALLOC(dcp, n_cells_ext, cs_real_t);
 
   if (cs_glob_fluid_properties->icp > 0) {
     const cs_field_t *f_cp = CS_F_(cp);
@@ -433,7 +436,7 @@ _cs_rad_transfer_sol(int                        gg_id,
     f_up = cs_field_by_name_try("rad_flux_up");
     f_down = cs_field_by_name_try("rad_flux_down");
 
-    BFT_MALLOC(ck_u_d,  n_cells_ext, cs_real_t);
+    CS_SCRATCH_ALLOC(ck_u_d,  n_cells_ext, cs_real_t);
     ck_u = cs_field_by_name("rad_absorption_coeff_up")->val;
     ck_d = cs_field_by_name("rad_absorption_coeff_down")->val;
 
@@ -849,8 +852,6 @@ _cs_rad_transfer_sol(int                        gg_id,
 
   }
 
-  BFT_FREE(dcp);
-
 #if 0
   /* TODO add clean generation and log of "per day source terms"
      for atmospheric radiative model */
@@ -870,11 +871,7 @@ _cs_rad_transfer_sol(int                        gg_id,
 
   /* Free memory */
 
-  BFT_FREE(ck_u_d);
-  BFT_FREE(rhs0);
-  BFT_FREE(dpvar);
-  BFT_FREE(radiance);
-  BFT_FREE(radiance_prev);
+  cs_scratch_release(s_mark);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -1357,10 +1354,14 @@ cs_rad_transfer_solve(int               bc_type[],
 
   }
 
-  /* Specific heat capacity of the bulk phase */
+  /* Specific heat capacity of the bulk phase
+     (from scratch memory, released on exit) */
   // CAUTION FOR NEPTUNE INTEGRATION HERE
+
+  cs_scratch_mark_t s_mark = cs_scratch_mark();
+
   cs_real_t *dcp;
-  BFT_MALLOC(dcp, n_cells_ext, cs_real_t);
+  CS_SCRATCH_ALLOC(dcp, n_cells_ext, cs_real_t);
 
   if (cs_glob_fluid_properties->icp > 0) {
     const cs_field_t *f_cp = CS_F_(cp);
@@ -1786,7 +1787,7 @@ cs_rad_transfer_solve(int               bc_type[],
 
   } /* end loop on grey gas */
 
-  BFT_FREE(dcp);
+  cs_scratch_release(s_mark);
   BFT_FREE(int_rad_domega);
 
   /* The total radiative flux is copied in bqinci
@@ -789,6 +789,13 @@ cs_user_lagr_model(void)
 
   cs_lagr_post_set_attr(CS_LAGR_STAT_CLASS, true);
 
+  /* Streaming output of particle attributes, every 10 time steps,
+     for 1 particle out of 10 (files are written to
+     postprocessing/particles_<nt>.csc, and may be read back using
+     cs_lagr_stream_open and cs_lagr_stream_read) */
+
+  cs_lagr_post_set_stream(10, 0.1);
+
   /*! [boundary_statistics] */
 }
 
@@ -101,6 +101,16 @@ cs_user_mesh_input(void)
   }
   /*! [mesh_input_2] */
 
+  /*! [mesh_input_3] */
+  {
+    /* Convert a Gmsh mesh in parallel, then read the converted mesh */
+
+    cs_mesh_import_gmsh("mesh_input/mesh_03.msh", "mesh_03_imported.csm");
+
+    cs_preprocessor_data_add_file("mesh_03_imported.csm", 0, NULL, NULL);
+  }
+  /*! [mesh_input_3] */
+
 }
 
 /*----------------------------------------------------------------------------*/
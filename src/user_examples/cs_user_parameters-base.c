@@ -1214,6 +1214,11 @@ cs_user_finalize_setup(cs_domain_t     *domain)
   cs_glob_log_frequency = 1;
   /*! [setup_log] */
 
+  /* Deferred logging of field statistics */
+  /*! [setup_log_deferred] */
+  cs_log_iteration_set_deferred(true);
+  /*! [setup_log_deferred] */
+
   /* Change a property's label
      (here for specific heat, first checking if it is variable) */
   /*! [setup_label] */
@@ -315,6 +315,20 @@ cs_user_linear_solvers(void)
   }
   /*! [sles_user_1] */
 
+  /* Example: select the fastest solver for pressure at run time */
+  /*-------------------------------------------------------------*/
+
+  /*! [sles_tuning_1] */
+  {
+    cs_sles_tuning_t *c = cs_sles_tuning_define(CS_F_(p)->id,
+                                                NULL,
+                                                10000); /* n_max_iter */
+
+    /* 2 timed solves per candidate, re-evaluate every 500 solves */
+    cs_sles_tuning_set_options(c, 2, 500);
+  }
+  /*! [sles_tuning_1] */
+
   /* Example: increase verbosity parameters for pressure */
   /*-----------------------------------------------------*/
 
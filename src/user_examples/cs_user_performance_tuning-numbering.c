@@ -96,6 +96,13 @@ cs_user_numbering(void)
      CS_RENUMBER_B_FACES_THREAD,      /* boundary faces numbering */
      CS_RENUMBER_VERTICES_NONE);      /* vertices numbering */
 
+  /* Memory placement: advise the use of huge pages for large mesh and
+     field arrays, and log a memory placement (NUMA locality) report
+     at startup. */
+
+  cs_numa_set_options(true,   /* huge_pages */
+                      true);  /* placement_log */
+
   /*! [performance_tuning_numbering] */
 }
 
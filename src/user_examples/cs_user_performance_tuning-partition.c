@@ -145,6 +145,27 @@ cs_user_partition(void)
   }
   /*! [performance_tuning_partition_4] */
 
+  /*! [performance_tuning_partition_5] */
+  {
+    /* Example: enable dynamic load balancing during the computation.
+     *
+     * Every 50 time steps, the rank loads are estimated from the measured
+     * cost of the fluid (per cell) and Lagrangian (per particle) stages;
+     * if the maximum load exceeds the mean load by more than 20%, the mesh
+     * is repartitioned using matching cell weights, and fields, particles,
+     * and other data are migrated to the new distribution.
+     *
+     * When particles are present, fluid and particle loads are handled as
+     * separate constraints, which METIS, ParMETIS, and space-filling
+     * curves balance independently.
+     * The resulting partitioning is written to partition_output (with
+     * METIS or SCOTCH), and may be used as partition_input for a restart. */
+
+    cs_load_balance_set_options(50,    /* check interval */
+                                1.2);  /* imbalance threshold (max/mean) */
+  }
+  /*! [performance_tuning_partition_5] */
+
 }
 
 /*----------------------------------------------------------------------------*/
@@ -341,6 +341,19 @@ cs_user_postprocess_writers(void)
                         -1,                       /* time step frequency */
                         -1.0);                    /* time value frequency */
   /*! [post_define_writer_4] */
+
+  /*! [post_define_writer_5] */
+  cs_post_define_writer(7,                        /* writer_id */
+                        "coarse",                 /* writer name */
+                        "postprocessing",         /* directory name */
+                        "ensight",                /* format name */
+                        "",                       /* format options */
+                        FVM_WRITER_FIXED_MESH,
+                        false,                    /* output_at_start */
+                        true,                     /* output at end */
+                        100,                      /* time step frequency */
+                        -1.0);                    /* time value frequency */
+  /*! [post_define_writer_5] */
 }
 
 /*----------------------------------------------------------------------------*/
@@ -628,6 +641,26 @@ cs_user_postprocess_probes(void)
                                  0);
   }
   /*! [post_define_profile_3] */
+
+  /* Define a sub-sampled representation of the volume mesh */
+
+  /*! [post_define_probes_aggregation] */
+  {
+    static int n_cells_per_probe = 16;
+    int  writer_ids[] = {7};
+
+    cs_probe_set_t  *pset =
+      cs_probe_set_create_from_local("coarse_cells",
+                                     cs_cell_aggregation_probes_define,
+                                     &n_cells_per_probe);
+
+    /* Output means over aggregates rather than probe cell values */
+    cs_probe_set_option(pset, "interpolation", "2");
+
+    cs_probe_set_associate_writers(pset, 1, writer_ids);
+    cs_probe_set_auto_var(pset, true);
+  }
+  /*! [post_define_probes_aggregation] */
 }
 
 /*----------------------------------------------------------------------------*/
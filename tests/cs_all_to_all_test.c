@@ -38,6 +38,7 @@
 
 #include "cs_base.h"
 #include "cs_block_dist.h"
+#include "cs_timer.h"
 
 #include "cs_all_to_all.h"
 
@@ -98,6 +99,202 @@ _bft_error_handler(const char  *filename,
   vfprintf(stderr, format, arg_ptr);
 }
 
+/*----------------------------------------------------------------------------
+ * Check hierarchical exchanges on successively duplicated and freed
+ * communicators (whose handles may be reused by MPI).
+ *----------------------------------------------------------------------------*/
+
+static void
+_comm_reuse_test(void)
+{
+#if defined(HAVE_MPI)
+
+  int rank = 0, size = 1, n_errors = 0;
+
+  MPI_Comm_rank(cs_glob_mpi_comm, &rank);
+  MPI_Comm_size(cs_glob_mpi_comm, &size);
+
+  cs_all_to_all_type_t a2at = cs_all_to_all_get_type();
+  cs_all_to_all_set_type(CS_ALL_TO_ALL_HIERARCHICAL);
+
+  for (int i = 0; i < 4; i++) {
+
+    MPI_Comm comm;
+    MPI_Comm_dup(cs_glob_mpi_comm, &comm);
+
+    cs_all_to_all_set_hierarchy_group_size(2 + i%2);
+
+    int dest_rank = (rank + 1) % size;
+    cs_gnum_t src_val = rank + 1;
+
+    cs_all_to_all_t *d
+      = cs_all_to_all_create(1,
+                             0, /* flags */
+                             NULL, /* dest_id */
+                             &dest_rank,
+                             comm);
+
+    cs_gnum_t *dest_val = cs_all_to_all_copy_array(d,
+                                                   CS_GNUM_TYPE,
+                                                   1,
+                                                   false, /* reverse */
+                                                   &src_val,
+                                                   NULL);
+
+    if (   cs_all_to_all_n_elts_dest(d) != 1
+        || dest_val[0] != (cs_gnum_t)((rank + size - 1) % size + 1))
+      n_errors += 1;
+
+    cs_all_to_all_destroy(&d);
+    BFT_FREE(dest_val);
+
+    MPI_Comm_free(&comm);
+  }
+
+  cs_all_to_all_set_hierarchy_group_size(0);
+  cs_all_to_all_set_type(a2at);
+
+  int n_g_errors = 0;
+  MPI_Allreduce(&n_errors, &n_g_errors, 1, MPI_INT, MPI_SUM,
+                cs_glob_mpi_comm);
+
+  bft_printf("\nHierarchical exchanges on reused communicators: %d errors\n",
+             n_g_errors);
+
+  if (n_g_errors > 0)
+    bft_error(__FILE__, __LINE__, 0,
+              "Hierarchical exchanges on reused communicators failed.");
+
+#endif /* defined(HAVE_MPI) */
+}
+
+/*----------------------------------------------------------------------------
+ * Compare timings of all-to-all algorithms for strided data exchange.
+ *
+ * Each rank sends n_elts elements to ranks chosen in a pseudo-random
+ * manner, and the result is checked against that of the default algorithm.
+ *
+ * parameters:
+ *   n_elts  <-- number of elements sent by each rank
+ *   n_iter  <-- number of timed exchanges per algorithm
+ *----------------------------------------------------------------------------*/
+
+static void
+_benchmark(cs_lnum_t  n_elts,
+           int        n_iter)
+{
+#if defined(HAVE_MPI)
+
+  const int stride = 4;
+  int rank = 0, size = 1;
+
+  MPI_Comm_rank(cs_glob_mpi_comm, &rank);
+  MPI_Comm_size(cs_glob_mpi_comm, &size);
+
+  cs_all_to_all_type_t a2at[3] = {CS_ALL_TO_ALL_MPI_DEFAULT,
+                                  CS_ALL_TO_ALL_CRYSTAL_ROUTER,
+                                  CS_ALL_TO_ALL_HIERARCHICAL};
+
+  int *dest_rank;
+  cs_real_t *src_val, *ref_val = NULL;
+  cs_lnum_t n_ref = 0;
+
+  BFT_MALLOC(dest_rank, n_elts, int);
+  BFT_MALLOC(src_val, n_elts*stride, cs_real_t);
+
+  for (cs_lnum_t ii = 0; ii < n_elts; ii++) {
+    unsigned long long k =   (unsigned long long)(rank + 1)*7919
+                           + (unsigned long long)ii*104729;
+    dest_rank[ii] = (k*2654435761ULL >> 16) % (unsigned long long)size;
+    for (int jj = 0; jj < stride; jj++)
+      src_val[ii*stride + jj] = rank*n_elts + ii + jj*0.25;
+  }
+
+  bft_printf("\n"
+             "Benchmark: %d elements of stride %d per rank, %d iterations\n"
+             "-------------------------------------------------------\n\n",
+             (int)n_elts, stride, n_iter);
+
+  for (int t_id = 0; t_id < 3; t_id++) {
+
+    cs_all_to_all_set_type(a2at[t_id]);
+
+    cs_real_t *dest_val = NULL;
+    cs_lnum_t n_elts_dest = 0;
+    int n_errors = 0;
+
+    MPI_Barrier(cs_glob_mpi_comm);
+    double t0 = cs_timer_wtime();
+
+    for (int iter = 0; iter < n_iter; iter++) {
+
+      cs_all_to_all_t *d
+        = cs_all_to_all_create(n_elts,
+                               CS_ALL_TO_ALL_ORDER_BY_SRC_RANK,
+                               NULL, /* dest_id */
+                               dest_rank,
+                               cs_glob_mpi_comm);
+
+      BFT_FREE(dest_val);
+      dest_val = cs_all_to_all_copy_array(d,
+                                          CS_REAL_TYPE,
+                                          stride,
+                                          false, /* reverse */
+                                          src_val,
+                                          NULL);
+
+      n_elts_dest = cs_all_to_all_n_elts_dest(d);
+
+      cs_all_to_all_destroy(&d);
+
+    }
+
+    MPI_Barrier(cs_glob_mpi_comm);
+    double t1 = cs_timer_wtime();
+
+    if (t_id == 0) {
+      n_ref = n_elts_dest;
+      ref_val = dest_val;
+      dest_val = NULL;
+    }
+    else {
+      if (n_elts_dest != n_ref)
+        n_errors += 1;
+      else {
+        for (cs_lnum_t ii = 0; ii < n_ref*stride; ii++) {
+          if (dest_val[ii] < ref_val[ii] || dest_val[ii] > ref_val[ii])
+            n_errors += 1;
+        }
+      }
+      BFT_FREE(dest_val);
+    }
+
+    int n_g_errors = 0;
+    MPI_Allreduce(&n_errors, &n_g_errors, 1, MPI_INT, MPI_SUM,
+                  cs_glob_mpi_comm);
+
+    bft_printf("  type %d: %12.5f s per exchange (%d errors)\n",
+               (int)a2at[t_id], (t1 - t0)/n_iter, n_g_errors);
+
+    if (n_g_errors > 0)
+      bft_error(__FILE__, __LINE__, 0,
+                "Results of all-to-all type %d differ from default.",
+                (int)a2at[t_id]);
+
+  }
+
+  BFT_FREE(ref_val);
+  BFT_FREE(src_val);
+  BFT_FREE(dest_rank);
+
+#else
+
+  CS_UNUSED(n_elts);
+  CS_UNUSED(n_iter);
+
+#endif
+}
+
 /*---------------------------------------------------------------------------*/
 
 int
@@ -132,17 +329,27 @@ main (int argc, char *argv[])
   sprintf(mem_trace_name, "cs_all_to_all_test_mem.%d", rank);
   bft_mem_init(mem_trace_name);
 
-  cs_all_to_all_type_t a2at[5] = {CS_ALL_TO_ALL_MPI_DEFAULT,
+  cs_all_to_all_type_t a2at[8] = {CS_ALL_TO_ALL_MPI_DEFAULT,
                                   CS_ALL_TO_ALL_CRYSTAL_ROUTER,
                                   CS_ALL_TO_ALL_CRYSTAL_ROUTER,
                                   CS_ALL_TO_ALL_MPI_DEFAULT,
-                                  CS_ALL_TO_ALL_CRYSTAL_ROUTER};
+                                  CS_ALL_TO_ALL_CRYSTAL_ROUTER,
+                                  CS_ALL_TO_ALL_HIERARCHICAL,
+                                  CS_ALL_TO_ALL_HIERARCHICAL,
+                                  CS_ALL_TO_ALL_HIERARCHICAL};
 
-  int a2a_flags[5] = {0, 0, CS_ALL_TO_ALL_ORDER_BY_SRC_RANK,
+  int a2a_flags[8] = {0, 0, CS_ALL_TO_ALL_ORDER_BY_SRC_RANK,
+                      CS_ALL_TO_ALL_USE_DEST_ID,
                       CS_ALL_TO_ALL_USE_DEST_ID,
+                      0, CS_ALL_TO_ALL_ORDER_BY_SRC_RANK,
                       CS_ALL_TO_ALL_USE_DEST_ID};
 
-  for (int test_id = 0; test_id < 5; test_id++) {
+  /* Use small groups so that hierarchical exchanges are
+     also tested on a single node */
+
+  cs_all_to_all_set_hierarchy_group_size(2);
+
+  for (int test_id = 0; test_id < 8; test_id++) {
 
     cs_all_to_all_set_type(a2at[test_id]);
 
@@ -161,7 +368,7 @@ main (int argc, char *argv[])
     cs_gnum_t *part_gnum = NULL;
     cs_all_to_all_t *d = NULL;
 
-    if (test_id < 3) {
+    if (!(flags & CS_ALL_TO_ALL_USE_DEST_ID)) {
 
       n_elts = 3 + rank%3;
 
@@ -338,6 +545,12 @@ main (int argc, char *argv[])
 
   }
 
+  _comm_reuse_test();
+
+  _benchmark(100000, 10);
+
+  cs_all_to_all_log_finalize();
+
   bft_mem_end();
 
 #if defined(HAVE_MPI)
@@ -0,0 +1,218 @@
+/*============================================================================
+ * Unit test and micro-benchmark for particle to cell accumulation kernels.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <bft_mem.h>
+#include <bft_printf.h>
+
+#include "cs_timer.h"
+
+#include "cs_lagr_coupling_kernels.h"
+
+/*---------------------------------------------------------------------------*/
+
+#define NPARTS 1000000
+#define NCELLS 10000
+#define DIM 6
+
+/*---------------------------------------------------------------------------*/
+
+/* Simple deterministic pseudo-random values in [0, 1[ */
+
+static double
+_rand01(unsigned long long  *state)
+{
+  *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (double)(*state >> 11) / 9007199254740992.0;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/* Serial scatter of particle contributions, as in the original
+   two-way coupling loops */
+
+static void
+_scatter_reference(cs_lnum_t         n_parts,
+                   const cs_lnum_t   p_cell_id[],
+                   const cs_real_t   p_val[],
+                   cs_real_t         c_val[])
+{
+  for (cs_lnum_t i = 0; i < n_parts; i++) {
+    for (cs_lnum_t j = 0; j < DIM; j++)
+      c_val[p_cell_id[i]*DIM + j] += p_val[i*DIM + j];
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+
+/* Count values which are not bit-identical */
+
+static cs_lnum_t
+_compare(cs_lnum_t         n,
+         const cs_real_t   v[],
+         const cs_real_t   v_ref[])
+{
+  cs_lnum_t n_diff = 0;
+
+  for (cs_lnum_t i = 0; i < n; i++) {
+    if (memcmp(v + i, v_ref + i, sizeof(cs_real_t)))
+      n_diff += 1;
+  }
+
+  return n_diff;
+}
+
+/*---------------------------------------------------------------------------*/
+
+int
+main (int argc, char *argv[])
+{
+  CS_UNUSED(argc);
+  CS_UNUSED(argv);
+
+  const cs_lnum_t n = NPARTS;
+  const cs_lnum_t n_cells = NCELLS;
+  const int n_runs = 10;
+
+  cs_lnum_t *p_cell_id, *s_cell_id, *cell_idx, *p_ids;
+  cs_real_t *p_val, *s_val, *c_val, *c_val_ref;
+
+  bft_mem_init(getenv("CS_MEM_LOG"));
+
+  BFT_MALLOC(p_cell_id, n, cs_lnum_t);
+  BFT_MALLOC(s_cell_id, n, cs_lnum_t);
+  BFT_MALLOC(cell_idx, n_cells + 1, cs_lnum_t);
+  BFT_MALLOC(p_ids, n, cs_lnum_t);
+  BFT_MALLOC(p_val, n*DIM, cs_real_t);
+  BFT_MALLOC(s_val, n*DIM, cs_real_t);
+  BFT_MALLOC(c_val, n_cells*DIM, cs_real_t);
+  BFT_MALLOC(c_val_ref, n_cells*DIM, cs_real_t);
+
+  /* Synthetic particle cloud, denser near the first cells, with
+     contributions of varying magnitude so that rounding depends on
+     the summation order */
+
+  unsigned long long s = 12345;
+
+  for (cs_lnum_t i = 0; i < n; i++) {
+    double r = _rand01(&s);
+    p_cell_id[i] = (cs_lnum_t)(r*r*n_cells);
+    for (cs_lnum_t j = 0; j < DIM; j++)
+      p_val[i*DIM + j] = (_rand01(&s) - 0.5) * pow(10., 8*_rand01(&s));
+  }
+
+  /* Particles indexed by cell */
+
+  double t_ref = 1e30, t_order = 1e30, t_acc = 1e30;
+
+  for (int run = 0; run < n_runs; run++) {
+
+    memset(c_val_ref, 0, n_cells*DIM*sizeof(cs_real_t));
+    memset(c_val, 0, n_cells*DIM*sizeof(cs_real_t));
+
+    double t0 = cs_timer_wtime();
+    _scatter_reference(n, p_cell_id, p_val, c_val_ref);
+    double t1 = cs_timer_wtime();
+    cs_lagr_coupling_cell_order(n, n_cells, p_cell_id, cell_idx, p_ids);
+    double t2 = cs_timer_wtime();
+    cs_lagr_coupling_accumulate(n_cells, cell_idx, p_ids, DIM, DIM,
+                                p_val, c_val);
+    double t3 = cs_timer_wtime();
+
+    t_ref = CS_MIN(t_ref, t1 - t0);
+    t_order = CS_MIN(t_order, t2 - t1);
+    t_acc = CS_MIN(t_acc, t3 - t2);
+  }
+
+  cs_lnum_t n_diff = _compare(n_cells*DIM, c_val, c_val_ref);
+
+  if (n_diff > 0)
+    printf("ERROR in indexed accumulation: "
+           "%ld values not bit-identical\n", (long)n_diff);
+  else
+    printf("  indexed accumulation test OK\n");
+
+  printf("\n    Particles/s (indexed):  scatter %e, "
+         "order %e, accumulate %e\n",
+         n/t_ref, n/t_order, n/t_acc);
+
+  /* Particles sorted by cell (no indirection) */
+
+  for (cs_lnum_t i = 0; i < n; i++) {
+    cs_lnum_t k = p_ids[i];
+    s_cell_id[i] = p_cell_id[k];
+    for (cs_lnum_t j = 0; j < DIM; j++)
+      s_val[i*DIM + j] = p_val[k*DIM + j];
+  }
+
+  t_ref = 1e30, t_acc = 1e30;
+
+  for (int run = 0; run < n_runs; run++) {
+
+    memset(c_val_ref, 0, n_cells*DIM*sizeof(cs_real_t));
+    memset(c_val, 0, n_cells*DIM*sizeof(cs_real_t));
+
+    double t0 = cs_timer_wtime();
+    _scatter_reference(n, s_cell_id, s_val, c_val_ref);
+    double t1 = cs_timer_wtime();
+    cs_lagr_coupling_accumulate(n_cells, cell_idx, NULL, DIM, DIM,
+                                s_val, c_val);
+    double t2 = cs_timer_wtime();
+
+    t_ref = CS_MIN(t_ref, t1 - t0);
+    t_acc = CS_MIN(t_acc, t2 - t1);
+  }
+
+  n_diff = _compare(n_cells*DIM, c_val, c_val_ref);
+
+  if (n_diff > 0)
+    printf("ERROR in sorted accumulation: "
+           "%ld values not bit-identical\n", (long)n_diff);
+  else
+    printf("  sorted accumulation test OK\n");
+
+  printf("\n    Particles/s (sorted):   scatter %e, accumulate %e\n",
+         n/t_ref, n/t_acc);
+
+  BFT_FREE(c_val_ref);
+  BFT_FREE(c_val);
+  BFT_FREE(s_val);
+  BFT_FREE(p_val);
+  BFT_FREE(p_ids);
+  BFT_FREE(cell_idx);
+  BFT_FREE(s_cell_id);
+  BFT_FREE(p_cell_id);
+
+  bft_mem_end();
+
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,417 @@
+/*============================================================================
+ * Unit test and micro-benchmark for batched particle SDE kernels.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <bft_mem.h>
+#include <bft_printf.h>
+
+#include "cs_fp_exception.h"
+#include "cs_math.h"
+#include "cs_timer.h"
+
+#include "cs_lagr_sde_kernels.h"
+
+/*---------------------------------------------------------------------------*/
+
+#define NPARTS 100000
+
+/*---------------------------------------------------------------------------*/
+
+/* Particle record, interleaving attributes as in a particle set buffer
+   (current and previous values) */
+
+typedef struct {
+
+  cs_lnum_t  cell_id;
+  cs_real_t  coords[2][3];
+  cs_real_t  velocity[2][3];
+  cs_real_t  velocity_seen[2][3];
+  cs_real_t  mass[2];
+  cs_real_t  diameter[2];
+
+} _particle_t;
+
+/*---------------------------------------------------------------------------*/
+
+/* Simple deterministic pseudo-random values in [0, 1[ */
+
+static double
+_rand01(unsigned long long  *state)
+{
+  *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (double)(*state >> 11) / 9007199254740992.0;
+}
+
+/*---------------------------------------------------------------------------*/
+
+/* Compare batched and reference values; results are bit-identical unless
+   vectorized math functions are used, in which case differences may reach
+   the square root of machine precision (the stochastic integral coefficients
+   are square roots of differences of close values) */
+
+static void
+_compare(cs_real_t   v,
+         cs_real_t   v_ref,
+         cs_lnum_t  *n_diff,
+         double     *d_max)
+{
+  if (memcmp(&v, &v_ref, sizeof(cs_real_t))) {
+    double d = fabs(v - v_ref) / CS_MAX(fabs(v_ref), 1.0);
+    *n_diff += 1;
+    *d_max = CS_MAX(*d_max, d);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void
+_init_particles(cs_lnum_t      n,
+                cs_lnum_t      n_cells,
+                _particle_t    p[],
+                cs_real_t      taup[],
+                cs_real_3_t    tlag[],
+                cs_real_3_t    piil[],
+                cs_real_33_t   bx[],
+                cs_real_33_t   vagaus[],
+                cs_real_3_t    force_p[],
+                cs_real_3_t    cvar_vel[])
+{
+  unsigned long long s = 12345;
+
+  for (cs_lnum_t i = 0; i < n_cells; i++) {
+    for (int j = 0; j < 3; j++)
+      cvar_vel[i][j] = _rand01(&s) - 0.5;
+  }
+
+  for (cs_lnum_t i = 0; i < n; i++) {
+    memset(p + i, 0, sizeof(_particle_t));
+    p[i].cell_id = (i % 17 == 0) ? -1 : (cs_lnum_t)(_rand01(&s)*n_cells);
+    taup[i] = 1e-4 + 1e-2*_rand01(&s);
+    for (int j = 0; j < 3; j++) {
+      p[i].coords[1][j] = _rand01(&s);
+      p[i].velocity[1][j] = _rand01(&s) - 0.5;
+      p[i].velocity_seen[1][j] = _rand01(&s) - 0.5;
+      tlag[i][j] = 1e-3 + 1e-1*_rand01(&s);
+      piil[i][j] = _rand01(&s) - 0.5;
+      force_p[i][j] = 1e-3*(_rand01(&s) - 0.5);
+      for (int k = 0; k < 3; k++) {
+        bx[i][j][k] = _rand01(&s);
+        vagaus[i][j][k] = 2.*_rand01(&s) - 1.;
+      }
+    }
+    /* Some particles see no turbulent diffusion, so that the
+       guarded quotients in the kernel are exercised */
+    if (i % 23 == 0)
+      memset(bx + i, 0, sizeof(cs_real_33_t));
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+
+/* Per-particle first order integration, as in the non-batched path */
+
+static void
+_order_1_reference(cs_lnum_t            n,
+                   cs_real_t            dtp,
+                   _particle_t          p[],
+                   const cs_real_t      taup[],
+                   const cs_real_3_t    tlag[],
+                   const cs_real_3_t    piil[],
+                   const cs_real_33_t   bx[],
+                   const cs_real_33_t   vagaus[],
+                   const cs_real_3_t    force_p[],
+                   const cs_real_3_t    cvar_vel[])
+{
+  const int nor = 1;
+
+  for (cs_lnum_t ip = 0; ip < n; ip++) {
+
+    cs_lnum_t cell_id = p[ip].cell_id;
+    if (cell_id < 0)
+      continue;
+
+    for (int id = 0; id < 3; id++) {
+
+      cs_real_t tl = tlag[ip][id];
+      cs_real_t tp = taup[ip];
+      cs_real_t tci = piil[ip][id] * tl + cvar_vel[cell_id][id];
+      cs_real_t force = force_p[ip][id];
+      cs_real_t up = p[ip].velocity[1][id];
+      cs_real_t us = p[ip].velocity_seen[1][id];
+
+      cs_real_t aux1 = exp(-dtp / tp);
+      cs_real_t aux2 = exp(-dtp / tl);
+      cs_real_t aux3 = tl / (tl - tp);
+      cs_real_t aux4 = tl / (tl + tp);
+      cs_real_t aux5 = tl * (1.0 - aux2);
+      cs_real_t aux6 = cs_math_pow2(bx[ip][id][nor-1]) * tl;
+      cs_real_t aux7 = tl - tp;
+      cs_real_t aux8 = cs_math_pow2(bx[ip][id][nor-1]) * cs_math_pow2(aux3);
+
+      cs_real_t aa = tp * (1.0 - aux1);
+      cs_real_t bb = (aux5 - aa) * aux3;
+      cs_real_t cc = dtp - aa - bb;
+
+      cs_real_t ter1x = aa * up;
+      cs_real_t ter2x = bb * us;
+      cs_real_t ter3x = cc * tci;
+      cs_real_t ter4x = (dtp - aa) * force;
+
+      cs_real_t ter1f = us * aux2;
+      cs_real_t ter2f = tci * (1.0 - aux2);
+
+      cs_real_t dd = aux3 * (aux2 - aux1);
+      cs_real_t ee = 1.0 - aux1;
+
+      cs_real_t ter1p = up * aux1;
+      cs_real_t ter2p = us * dd;
+      cs_real_t ter3p = tci * (ee - dd);
+      cs_real_t ter4p = force * ee;
+
+      cs_real_t gama2 = 0.5 * (1.0 - aux2 * aux2);
+      cs_real_t p11 = sqrt(gama2 * aux6);
+      cs_real_t ter3f = p11 * vagaus[ip][id][0];
+
+      cs_real_t aux9  = 0.5 * tl * (1.0 - aux2 * aux2);
+      cs_real_t aux10 = 0.5 * tp * (1.0 - aux1 * aux1);
+      cs_real_t aux11 = tp * tl * (1.0 - aux1 * aux2) / (tp + tl);
+
+      cs_real_t grga2 = (aux9 - 2.0 * aux11 + aux10) * aux8;
+      cs_real_t gagam = (aux9 - aux11) * (aux8 / aux3);
+
+      cs_real_t p21, p22;
+      if (CS_ABS(p11) > cs_math_epzero) {
+        p21 = gagam / p11;
+        p22 = grga2 - cs_math_pow2(p21);
+        p22 = sqrt(CS_MAX(0.0, p22));
+      }
+      else {
+        p21 = 0.0;
+        p22 = 0.0;
+      }
+
+      cs_real_t ter5p = p21 * vagaus[ip][id][0] + p22 * vagaus[ip][id][1];
+
+      cs_real_t gaome = (  (tl - tp) * (aux5 - aa)
+                         - tl * aux9
+                         - tp * aux10
+                         + (tl + tp) * aux11)
+                        * aux8;
+      cs_real_t omegam = aux3 * (  (tl - tp) * (1.0 - aux2)
+                                 - 0.5 * tl * (1.0 - aux2 * aux2)
+                                 + cs_math_pow2(tp) / (tl + tp)
+                                   * (1.0 - aux1 * aux2)) * aux6;
+      cs_real_t omega2 =   aux7 * (aux7 * dtp - 2.0 * (tl * aux5 - tp * aa))
+                         + 0.5 * tl * tl * aux5 * (1.0 + aux2)
+                         + 0.5 * tp * tp * aa * (1.0 + aux1)
+                         - 2.0 * aux4 * tl * tp * tp * (1.0 - aux1 * aux2);
+      omega2 = aux8 * omega2;
+
+      cs_real_t p31 = (p11 > cs_math_epzero) ? omegam / p11 : 0.0;
+      cs_real_t p32 = (p22 > cs_math_epzero) ? (gaome - p31 * p21) / p22 : 0.0;
+      cs_real_t p33 = omega2 - cs_math_pow2(p31) - cs_math_pow2(p32);
+      p33 = sqrt(CS_MAX(0.0, p33));
+
+      cs_real_t ter5x =   p31 * vagaus[ip][id][0] + p32 * vagaus[ip][id][1]
+                        + p33 * vagaus[ip][id][2];
+
+      cs_real_t displ = ter1x + ter2x + ter3x + ter4x + ter5x;
+
+      p[ip].coords[0][id] = p[ip].coords[1][id] + displ;
+      p[ip].velocity_seen[0][id] = ter1f + ter2f + ter3f;
+      p[ip].velocity[0][id] = ter1p + ter2p + ter3p + ter4p + ter5p;
+
+    }
+
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+
+/* Batched first order integration: gather, integrate, scatter */
+
+static void
+_order_1_batched(cs_lnum_t            n_parts,
+                 cs_real_t            dtp,
+                 _particle_t          p[],
+                 const cs_real_t      taup[],
+                 const cs_real_3_t    tlag[],
+                 const cs_real_3_t    piil[],
+                 const cs_real_33_t   bx[],
+                 const cs_real_33_t   vagaus[],
+                 const cs_real_3_t    force_p[],
+                 const cs_real_3_t    cvar_vel[])
+{
+  const cs_lnum_t b_size = CS_LAGR_SDE_BLOCK_SIZE;
+
+  cs_lnum_t p_id[CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_t b_taup[CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_t b_tlag[3*CS_LAGR_SDE_BLOCK_SIZE], b_tci[3*CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_t b_force[3*CS_LAGR_SDE_BLOCK_SIZE], b_bx[3*CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_t b_vel[3*CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_t b_vel_seen[3*CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_t b_displ[3*CS_LAGR_SDE_BLOCK_SIZE];
+  cs_real_3_t b_vagaus[3*CS_LAGR_SDE_BLOCK_SIZE];
+
+  cs_lnum_t ip = 0;
+
+  while (ip < n_parts) {
+
+    cs_lnum_t n = 0;
+    for (; ip < n_parts && n < b_size; ip++) {
+      if (p[ip].cell_id >= 0)
+        p_id[n++] = ip;
+    }
+
+    for (cs_lnum_t i = 0; i < n; i++) {
+      cs_lnum_t j = p_id[i];
+      cs_lnum_t cell_id = p[j].cell_id;
+      b_taup[i] = taup[j];
+      for (int id = 0; id < 3; id++) {
+        cs_lnum_t k = id*b_size + i;
+        b_tlag[k] = tlag[j][id];
+        b_tci[k] = piil[j][id] * tlag[j][id] + cvar_vel[cell_id][id];
+        b_force[k] = force_p[j][id];
+        b_bx[k] = bx[j][id][0];
+        b_vel[k] = p[j].velocity[1][id];
+        b_vel_seen[k] = p[j].velocity_seen[1][id];
+        for (int l = 0; l < 3; l++)
+          b_vagaus[k][l] = vagaus[j][id][l];
+      }
+    }
+
+    cs_lagr_sde_kernel_order_1(n, dtp, b_taup, b_tlag, b_tci, b_force, b_bx,
+                               b_vagaus, b_vel, b_vel_seen, b_displ);
+
+    for (cs_lnum_t i = 0; i < n; i++) {
+      cs_lnum_t j = p_id[i];
+      for (int id = 0; id < 3; id++) {
+        cs_lnum_t k = id*b_size + i;
+        p[j].coords[0][id] = p[j].coords[1][id] + b_displ[k];
+        p[j].velocity[0][id] = b_vel[k];
+        p[j].velocity_seen[0][id] = b_vel_seen[k];
+      }
+    }
+
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+
+int
+main (int argc, char *argv[])
+{
+  CS_UNUSED(argc);
+  CS_UNUSED(argv);
+
+  const cs_lnum_t n = NPARTS;
+  const cs_lnum_t n_cells = 1000;
+  const cs_real_t dtp = 1e-3;
+  const int n_runs = 20;
+
+  _particle_t *p, *p_ref;
+  cs_real_t *taup;
+  cs_real_3_t *tlag, *piil, *force_p, *cvar_vel;
+  cs_real_33_t *bx, *vagaus;
+
+  bft_mem_init(getenv("CS_MEM_LOG"));
+
+  /* Division by zero in the kernels must not occur, even for quotients
+     which are discarded */
+
+  cs_fp_exception_enable_trap();
+
+  BFT_MALLOC(p, n, _particle_t);
+  BFT_MALLOC(p_ref, n, _particle_t);
+  BFT_MALLOC(taup, n, cs_real_t);
+  BFT_MALLOC(tlag, n, cs_real_3_t);
+  BFT_MALLOC(piil, n, cs_real_3_t);
+  BFT_MALLOC(force_p, n, cs_real_3_t);
+  BFT_MALLOC(cvar_vel, n_cells, cs_real_3_t);
+  BFT_MALLOC(bx, n, cs_real_33_t);
+  BFT_MALLOC(vagaus, n, cs_real_33_t);
+
+  _init_particles(n, n_cells, p_ref, taup, tlag, piil, bx, vagaus,
+                  force_p, cvar_vel);
+  memcpy(p, p_ref, n*sizeof(_particle_t));
+
+  /* Velocity, velocity seen and displacement */
+
+  double t_ref = 1e30, t_batch = 1e30;
+
+  for (int run = 0; run < n_runs; run++) {
+    double t0 = cs_timer_wtime();
+    _order_1_reference(n, dtp, p_ref, taup, tlag, piil, bx, vagaus,
+                       force_p, cvar_vel);
+    double t1 = cs_timer_wtime();
+    _order_1_batched(n, dtp, p, taup, tlag, piil, bx, vagaus,
+                     force_p, cvar_vel);
+    double t2 = cs_timer_wtime();
+    t_ref = CS_MIN(t_ref, t1 - t0);
+    t_batch = CS_MIN(t_batch, t2 - t1);
+  }
+
+  cs_lnum_t n_diff = 0;
+  double d_max = 0;
+  for (cs_lnum_t i = 0; i < n; i++) {
+    for (int j = 0; j < 3; j++) {
+      _compare(p[i].coords[0][j], p_ref[i].coords[0][j], &n_diff, &d_max);
+      _compare(p[i].velocity[0][j], p_ref[i].velocity[0][j], &n_diff, &d_max);
+      _compare(p[i].velocity_seen[0][j], p_ref[i].velocity_seen[0][j],
+               &n_diff, &d_max);
+    }
+  }
+
+  if (d_max > 1e-6)
+    printf("ERROR in batched first order SDE kernel: "
+           "max. difference %e\n", d_max);
+  else
+    printf("  batched first order SDE kernel test OK "
+           "(%ld values not bit-identical)\n", (long)n_diff);
+
+  printf("\n    Particles/s (first order):  per particle %e, batched %e\n",
+         n/t_ref, n/t_batch);
+
+  BFT_FREE(vagaus);
+  BFT_FREE(bx);
+  BFT_FREE(cvar_vel);
+  BFT_FREE(force_p);
+  BFT_FREE(piil);
+  BFT_FREE(tlag);
+  BFT_FREE(taup);
+  BFT_FREE(p_ref);
+  BFT_FREE(p);
+
+  bft_mem_end();
+
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,232 @@
+/*============================================================================
+ * Unit test for particle attribute stream files.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <bft_mem.h>
+#include <bft_printf.h>
+
+#include "cs_base.h"
+#include "cs_file.h"
+
+#include "cs_lagr_stream.h"
+
+/*---------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+ * Number of particles written by a given rank (the second rank has none).
+ *----------------------------------------------------------------------------*/
+
+static cs_lnum_t
+_n_rank_particles(int  rank_id)
+{
+  return (rank_id == 1) ? 0 : 7 + 5*rank_id;
+}
+
+/*----------------------------------------------------------------------------
+ * Reference attribute values for a given particle global number.
+ *----------------------------------------------------------------------------*/
+
+static void
+_particle_values(cs_gnum_t   g_num,
+                 cs_real_t   coords[3],
+                 cs_lnum_t  *class_id)
+{
+  coords[0] = g_num;
+  coords[1] = 2.*g_num;
+  coords[2] = 0.5 - g_num;
+  *class_id = g_num % 13;
+}
+
+/*----------------------------------------------------------------------------
+ * Global number of the first local particle, ranks being ordered by id.
+ *----------------------------------------------------------------------------*/
+
+static cs_gnum_t
+_g_num_shift(cs_lnum_t  n_particles)
+{
+  cs_gnum_t shift = 0;
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1) {
+    cs_gnum_t n_l = n_particles;
+    MPI_Scan(&n_l, &shift, 1, CS_MPI_GNUM, MPI_SUM, cs_glob_mpi_comm);
+    shift -= n_l;
+  }
+#else
+  CS_UNUSED(n_particles);
+#endif
+
+  return shift;
+}
+
+/*---------------------------------------------------------------------------*/
+
+int
+main (int argc, char *argv[])
+{
+  char mem_trace_name[32];
+  int rank = 0;
+  int n_errors = 0;
+
+  const char path[] = "cs_lagr_stream_test.csc";
+
+#if defined(HAVE_MPI)
+
+  cs_base_mpi_init(&argc, &argv);
+
+  if (cs_glob_mpi_comm != MPI_COMM_NULL)
+    MPI_Comm_rank(cs_glob_mpi_comm, &rank);
+
+  /* Use small file blocks, so that particles are read on other
+     ranks than those which wrote them */
+
+  cs_file_set_default_comm(1, 0, cs_glob_mpi_comm);
+
+#else
+
+  CS_UNUSED(argc);
+  CS_UNUSED(argv);
+
+#endif /* (HAVE_MPI) */
+
+  sprintf(mem_trace_name, "cs_lagr_stream_test_mem.%d", rank);
+  bft_mem_init(mem_trace_name);
+
+  /* Write */
+
+  {
+    cs_lnum_t n_particles = _n_rank_particles(rank);
+    cs_gnum_t shift = _g_num_shift(n_particles);
+
+    cs_real_t *coords = NULL;
+    cs_lnum_t *class_id = NULL;
+    BFT_MALLOC(coords, n_particles*3, cs_real_t);
+    BFT_MALLOC(class_id, n_particles, cs_lnum_t);
+
+    for (cs_lnum_t i = 0; i < n_particles; i++)
+      _particle_values(shift + i + 1, coords + i*3, class_id + i);
+
+    cs_lagr_stream_t *s = cs_lagr_stream_create(path, n_particles, 42, 1.5);
+
+    cs_lagr_stream_write(s, "coords", CS_REAL_TYPE, 3, coords);
+    cs_lagr_stream_write(s, "stat_class", CS_LNUM_TYPE, 1, class_id);
+
+    cs_lagr_stream_destroy(&s);
+
+    BFT_FREE(class_id);
+    BFT_FREE(coords);
+  }
+
+  /* Read back, with a different distribution */
+
+  {
+    cs_gnum_t n_g_particles = 0, n_g_ref = 0;
+    cs_lnum_t n_particles = 0;
+    int nt_cur = 0;
+    double t_cur = 0;
+
+    for (int i = 0; i < cs_glob_n_ranks; i++)
+      n_g_ref += _n_rank_particles(i);
+
+    cs_lagr_stream_t *s = cs_lagr_stream_open(path);
+
+    cs_lagr_stream_get_info(s, &n_g_particles, &n_particles, &nt_cur, &t_cur);
+
+    if (n_g_particles != n_g_ref || nt_cur != 42 || fabs(t_cur - 1.5) > 0) {
+      printf("ERROR: rank %d: incorrect stream metadata\n", rank);
+      n_errors += 1;
+    }
+
+    cs_gnum_t shift = _g_num_shift(n_particles);
+
+    cs_real_t *coords = NULL;
+    cs_lnum_t *class_id = NULL;
+    BFT_MALLOC(coords, n_particles*3, cs_real_t);
+    BFT_MALLOC(class_id, n_particles, cs_lnum_t);
+
+    if (   cs_lagr_stream_read(s, "stat_class", CS_LNUM_TYPE, 1, class_id)
+        || cs_lagr_stream_read(s, "coords", CS_REAL_TYPE, 3, coords)) {
+      printf("ERROR: rank %d: missing stream attribute\n", rank);
+      n_errors += 1;
+    }
+
+    if (cs_lagr_stream_read(s, "velocity", CS_REAL_TYPE, 3, NULL) == 0) {
+      printf("ERROR: rank %d: absent attribute not reported\n", rank);
+      n_errors += 1;
+    }
+
+    cs_lagr_stream_destroy(&s);
+
+    for (cs_lnum_t i = 0; i < n_particles; i++) {
+      cs_real_t c_ref[3];
+      cs_lnum_t class_ref;
+      _particle_values(shift + i + 1, c_ref, &class_ref);
+      if (   fabs(coords[i*3] - c_ref[0]) > 0
+          || fabs(coords[i*3 + 1] - c_ref[1]) > 0
+          || fabs(coords[i*3 + 2] - c_ref[2]) > 0
+          || class_id[i] != class_ref)
+        n_errors += 1;
+    }
+
+    BFT_FREE(class_id);
+    BFT_FREE(coords);
+  }
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1) {
+    int l_errors = n_errors;
+    MPI_Allreduce(&l_errors, &n_errors, 1, MPI_INT, MPI_SUM,
+                  cs_glob_mpi_comm);
+  }
+#endif
+
+  if (n_errors > 0)
+    printf("ERROR: particle stream round trip: %d errors\n", n_errors);
+  else if (rank == 0)
+    printf("  particle stream round trip test OK\n");
+
+  bft_mem_end();
+
+#if defined(HAVE_MPI)
+  {
+    int mpi_flag;
+    MPI_Initialized(&mpi_flag);
+    if (mpi_flag != 0)
+      MPI_Finalize();
+  }
+#endif
+
+  if (n_errors > 0)
+    exit(EXIT_FAILURE);
+
+  exit(EXIT_SUCCESS);
+}
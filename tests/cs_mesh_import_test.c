@@ -0,0 +1,682 @@
+/*============================================================================
+ * Unit test for Gmsh mesh import (cs_mesh_import.c).
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+#include <assert.h>
+#include <math.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <bft_error.h>
+#include <bft_mem.h>
+#include <bft_printf.h>
+
+#include "cs_base.h"
+#include "cs_file.h"
+#include "cs_io.h"
+
+#include "cs_mesh_import.h"
+
+/*---------------------------------------------------------------------------*/
+
+/* Small mixed-element mesh: a unit cube hexahedron, with a prism on its
+   x = 1 side, a pyramid on its top side, and a tetrahedron on a
+   pyramid side; node 13 is only used by a point element */
+
+#define N_NODES 13
+
+static const double _node_coords[N_NODES][3]
+  = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+     {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1},
+     {2, 0, 0}, {2, 1, 0}, {0.5, 0.5, 2}, {-1, 0.5, 1.5},
+     {3, 3, 3}};
+
+#define N_CELLS 4
+
+static const int _cell_n_vtx[N_CELLS] = {8, 6, 5, 4};
+
+static const int _cell_vtx[N_CELLS][8]
+  = {{1, 2, 3, 4, 5, 6, 7, 8},
+     {2, 6, 9, 3, 7, 10},
+     {5, 6, 7, 8, 11},
+     {5, 11, 8, 12}};
+
+/* Expected values */
+
+#define N_FACES 17
+#define FACE_VTX_SIZE 59
+#define N_VERTICES 12
+
+static const int _gc_properties[4] = {-2, -1, 11, 0};
+static const int _cell_gc_id[N_CELLS] = {2, 3, 2, 4};
+
+/* Error handling: errors are counted, and return to the last
+   checkpoint, so that malformed files may be tested */
+
+static int _n_errors = 0;
+static jmp_buf _error_env;
+
+/*----------------------------------------------------------------------------
+ * Print message on standard output
+ *----------------------------------------------------------------------------*/
+
+static int _bft_printf_proxy
+(
+ const char     *const format,
+       va_list         arg_ptr
+)
+{
+  static FILE *f = NULL;
+
+  if (f == NULL) {
+    char filename[64];
+    int rank = 0;
+#if defined(HAVE_MPI)
+    if (cs_glob_mpi_comm != MPI_COMM_NULL)
+      MPI_Comm_rank(cs_glob_mpi_comm, &rank);
+#endif
+    sprintf (filename, "cs_mesh_import_test_out.%d", rank);
+    f = fopen(filename, "w");
+    assert(f != NULL);
+  }
+
+  return vfprintf(f, format, arg_ptr);
+}
+
+static int
+_bft_printf_flush_proxy(void)
+{
+  return fflush(NULL);
+}
+
+/*----------------------------------------------------------------------------
+ * Log error and return to last checkpoint
+ *----------------------------------------------------------------------------*/
+
+static void
+_bft_error_handler(const char  *filename,
+                   int          line_num,
+                   int          sys_err_code,
+                   const char  *format,
+                   va_list      arg_ptr)
+{
+  CS_UNUSED(filename);
+  CS_UNUSED(line_num);
+  CS_UNUSED(sys_err_code);
+
+  bft_printf("\n  expected error: ");
+  bft_printf_flush();
+
+  _bft_printf_proxy(format, arg_ptr);
+  bft_printf("\n");
+
+  _n_errors += 1;
+
+  longjmp(_error_env, 1);
+}
+
+/*----------------------------------------------------------------------------
+ * Write test mesh file, possibly with a given defect.
+ *
+ * parameters:
+ *   path    <-- file path
+ *   variant <-- 0: valid file, 1: unhandled version, 2: missing elements
+ *               section, 3: incomplete element, 4: undefined node,
+ *               5: unhandled element type
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_msh(const char  *path,
+           int          variant)
+{
+  static const int gmsh_type[N_CELLS] = {5, 6, 7, 4};
+  static const char *cell_tags[N_CELLS] = {"2 10 1", "2 11 2", "2 10 3", "0"};
+
+  if (cs_glob_rank_id < 1) {
+
+    FILE *f = fopen(path, "w");
+    assert(f != NULL);
+
+    fprintf(f, "$MeshFormat\n%s 0 8\n$EndMeshFormat\n",
+            (variant == 1) ? "4.1" : "2.2");
+
+    fprintf(f, "$PhysicalNames\n2\n2 1 \"inlet\"\n3 10 \"fluid\"\n"
+            "$EndPhysicalNames\n");
+
+    fprintf(f, "$Nodes\n%d\n", N_NODES);
+    for (int i = 0; i < N_NODES; i++)
+      fprintf(f, "%d %g %g %g\n", i+1,
+              _node_coords[i][0], _node_coords[i][1], _node_coords[i][2]);
+    fprintf(f, "$EndNodes\n");
+
+    if (variant != 2) { /* missing elements section */
+      fprintf(f, "$Elements\n%d\n", N_CELLS + 2);
+      fprintf(f, "1 3 2 1 1 1 2 3 4\n");
+      for (int i = 0; i < N_CELLS; i++) {
+        int n_vtx = _cell_n_vtx[i];
+        if (variant == 3 && i == 1)
+          n_vtx -= 1;
+        fprintf(f, "%d %d %s", i+2,
+                (variant == 5 && i == 2) ? 42 : gmsh_type[i], cell_tags[i]);
+        for (int j = 0; j < n_vtx; j++)
+          fprintf(f, " %d",
+                  (variant == 4 && i == 3 && j == 3) ? 99 : _cell_vtx[i][j]);
+        fprintf(f, "\n");
+      }
+      fprintf(f, "%d 15 2 0 4 13\n", N_CELLS + 2);
+      fprintf(f, "$EndElements\n");
+    }
+
+    fclose(f);
+  }
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1)
+    MPI_Barrier(cs_glob_mpi_comm);
+#endif
+}
+
+/*----------------------------------------------------------------------------
+ * Write binary 32-bit integers, possibly with swapped bytes.
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_int(FILE     *f,
+           bool      swap,
+           int       n,
+           ...)
+{
+  va_list ap;
+  va_start(ap, n);
+
+  for (int i = 0; i < n; i++) {
+    int32_t v = va_arg(ap, int);
+    unsigned char b[4];
+    memcpy(b, &v, 4);
+    if (swap) {
+      unsigned char t = b[0]; b[0] = b[3]; b[3] = t;
+      t = b[1]; b[1] = b[2]; b[2] = t;
+    }
+    fwrite(b, 1, 4, f);
+  }
+
+  va_end(ap);
+}
+
+/*----------------------------------------------------------------------------
+ * Write test mesh file in binary format.
+ *
+ * Element blocks are defined per element type, so that block-distributed
+ * reads span several blocks.
+ *
+ * parameters:
+ *   path <-- file path
+ *   swap <-- if true, write data with non-native byte order
+ *----------------------------------------------------------------------------*/
+
+static void
+_write_msh_binary(const char  *path,
+                  bool         swap)
+{
+  static const int gmsh_type[N_CELLS] = {5, 6, 7, 4};
+  static const int cell_phys[N_CELLS] = {10, 11, 10, 0};
+
+  if (cs_glob_rank_id < 1) {
+
+    FILE *f = fopen(path, "wb");
+    assert(f != NULL);
+
+    fprintf(f, "$MeshFormat\n2.2 1 8\n");
+    _write_int(f, swap, 1, 1);
+    fprintf(f, "\n$EndMeshFormat\n");
+
+    fprintf(f, "$PhysicalNames\n2\n2 1 \"inlet\"\n3 10 \"fluid\"\n"
+            "$EndPhysicalNames\n");
+
+    fprintf(f, "$Comments\nignored section\n$EndComments\n");
+
+    fprintf(f, "$Nodes\n%d\n", N_NODES);
+    for (int i = 0; i < N_NODES; i++) {
+      _write_int(f, swap, 1, i+1);
+      for (int k = 0; k < 3; k++) {
+        unsigned char b[8];
+        memcpy(b, &(_node_coords[i][k]), 8);
+        for (int j = 0; swap && j < 4; j++) {
+          unsigned char t = b[j]; b[j] = b[7-j]; b[7-j] = t;
+        }
+        fwrite(b, 1, 8, f);
+      }
+    }
+    fprintf(f, "\n$EndNodes\n");
+
+    fprintf(f, "$Elements\n%d\n", N_CELLS + 2);
+
+    _write_int(f, swap, 3, 3, 1, 2);
+    _write_int(f, swap, 7, 1, 1, 1, 1, 2, 3, 4);
+
+    for (int i = 0; i < N_CELLS; i++) {
+      int n_tags = (cell_phys[i] > 0) ? 2 : 0;
+      _write_int(f, swap, 3, gmsh_type[i], 1, n_tags);
+      _write_int(f, swap, 1, i+2);
+      if (n_tags > 0)
+        _write_int(f, swap, 2, cell_phys[i], i+1);
+      for (int j = 0; j < _cell_n_vtx[i]; j++)
+        _write_int(f, swap, 1, _cell_vtx[i][j]);
+    }
+
+    _write_int(f, swap, 3, 15, 1, 2);
+    _write_int(f, swap, 4, N_CELLS + 2, 0, 4, 13);
+
+    fprintf(f, "\n$EndElements\n");
+
+    fclose(f);
+  }
+
+#if defined(HAVE_MPI)
+  if (cs_glob_n_ranks > 1)
+    MPI_Barrier(cs_glob_mpi_comm);
+#endif
+}
+
+/*----------------------------------------------------------------------------
+ * Check imported mesh.
+ *
+ * All sections of the mesh_input file are read by each rank.
+ *
+ * parameters:
+ *   path <-- mesh_input file path
+ *
+ * returns:
+ *   number of errors
+ *----------------------------------------------------------------------------*/
+
+static int
+_check_mesh_input(const char  *path)
+{
+  int n_errors = 0;
+
+  cs_gnum_t n_g_cells = 0, n_g_faces = 0, n_g_vertices = 0, fvs = 0;
+  int n_gc = 0, n_groups = 0;
+  int *group_idx = NULL, *gc_properties = NULL;
+  int *cell_gc_id = NULL, *face_gc_id = NULL;
+  char *group = NULL;
+  cs_gnum_t *face_cells = NULL, *face_vtx_idx = NULL, *face_vtx = NULL;
+  cs_real_t *vtx_coords = NULL;
+
+#if defined(HAVE_MPI)
+  cs_io_t *inp = cs_io_initialize(path,
+                                  "Face-based mesh definition, R0",
+                                  CS_IO_MODE_READ,
+                                  CS_FILE_STDIO_SERIAL,
+                                  CS_IO_ECHO_NONE,
+                                  MPI_INFO_NULL,
+                                  MPI_COMM_NULL,
+                                  MPI_COMM_NULL);
+#else
+  cs_io_t *inp = cs_io_initialize(path,
+                                  "Face-based mesh definition, R0",
+                                  CS_IO_MODE_READ,
+                                  CS_FILE_STDIO_SERIAL,
+                                  CS_IO_ECHO_NONE);
+#endif
+
+  cs_io_sec_header_t header;
+
+  while (cs_io_read_header(inp, &header) == 0) {
+
+    const char *name = header.sec_name;
+
+    if (strcmp(name, "end_block:data") == 0)
+      break;
+    else if (strncmp(name, "start_block:", 12) == 0)
+      continue;
+    else if (strncmp(name, "end_block:", 10) == 0)
+      continue;
+
+    if (   strcmp(name, "n_cells") == 0
+        || strcmp(name, "n_faces") == 0
+        || strcmp(name, "n_vertices") == 0
+        || strcmp(name, "face_vertices_size") == 0) {
+      cs_gnum_t v;
+      cs_io_set_cs_gnum(&header, inp);
+      cs_io_read_global(&header, &v, inp);
+      if (strcmp(name, "n_cells") == 0)
+        n_g_cells = v;
+      else if (strcmp(name, "n_faces") == 0)
+        n_g_faces = v;
+      else if (strcmp(name, "n_vertices") == 0)
+        n_g_vertices = v;
+      else
+        fvs = v;
+    }
+    else if (strcmp(name, "n_group_classes") == 0) {
+      cs_io_set_int(&header, inp);
+      cs_io_read_global(&header, &n_gc, inp);
+    }
+    else if (strcmp(name, "n_groups") == 0) {
+      cs_io_set_int(&header, inp);
+      cs_io_read_global(&header, &n_groups, inp);
+    }
+    else if (strcmp(name, "group_name_index") == 0) {
+      cs_io_set_int(&header, inp);
+      group_idx = cs_io_read_global(&header, NULL, inp);
+    }
+    else if (strcmp(name, "group_name") == 0)
+      group = cs_io_read_global(&header, NULL, inp);
+    else if (strcmp(name, "group_class_properties") == 0) {
+      cs_io_set_int(&header, inp);
+      gc_properties = cs_io_read_global(&header, NULL, inp);
+    }
+    else if (strcmp(name, "cell_group_class_id") == 0) {
+      cs_io_set_int(&header, inp);
+      cell_gc_id = cs_io_read_global(&header, NULL, inp);
+    }
+    else if (strcmp(name, "face_group_class_id") == 0) {
+      cs_io_set_int(&header, inp);
+      face_gc_id = cs_io_read_global(&header, NULL, inp);
+    }
+    else if (strcmp(name, "face_cells") == 0) {
+      cs_io_set_cs_gnum(&header, inp);
+      face_cells = cs_io_read_global(&header, NULL, inp);
+    }
+    else if (strcmp(name, "face_vertices_index") == 0) {
+      cs_io_set_cs_gnum(&header, inp);
+      face_vtx_idx = cs_io_read_global(&header, NULL, inp);
+    }
+    else if (strcmp(name, "face_vertices") == 0) {
+      cs_io_set_cs_gnum(&header, inp);
+      face_vtx = cs_io_read_global(&header, NULL, inp);
+    }
+    else if (strcmp(name, "vertex_coords") == 0) {
+      cs_io_assert_cs_real(&header, inp);
+      vtx_coords = cs_io_read_global(&header, NULL, inp);
+    }
+    else
+      cs_io_skip(&header, inp);
+  }
+
+  cs_io_finalize(&inp);
+
+  /* Dimensions */
+
+  if (   n_g_cells != N_CELLS || n_g_faces != N_FACES
+      || n_g_vertices != N_VERTICES || fvs != FACE_VTX_SIZE) {
+    bft_printf("  counts: %llu cells, %llu faces, %llu vertices, "
+               "%llu face vertices\n",
+               (unsigned long long)n_g_cells, (unsigned long long)n_g_faces,
+               (unsigned long long)n_g_vertices, (unsigned long long)fvs);
+    return 1;
+  }
+
+  if (   face_cells == NULL || face_vtx_idx == NULL || face_vtx == NULL
+      || vtx_coords == NULL || cell_gc_id == NULL || face_gc_id == NULL
+      || gc_properties == NULL || group_idx == NULL || group == NULL) {
+    bft_printf("  missing sections\n");
+    return 1;
+  }
+
+  /* Group classes */
+
+  if (n_gc != 4 || n_groups != 2)
+    n_errors += 1;
+  else {
+    if (   strcmp(group + group_idx[0] - 1, "fluid") != 0
+        || strcmp(group + group_idx[1] - 1, "inlet") != 0)
+      n_errors += 1;
+    for (int i = 0; i < n_gc; i++) {
+      if (gc_properties[i] != _gc_properties[i])
+        n_errors += 1;
+    }
+  }
+
+  for (int i = 0; i < N_CELLS; i++) {
+    if (cell_gc_id[i] != _cell_gc_id[i])
+      n_errors += 1;
+  }
+
+  if (n_errors > 0)
+    bft_printf("  group classes: %d errors\n", n_errors);
+
+  /* Vertices (numbered in node tag order) */
+
+  for (int i = 0; i < N_VERTICES; i++) {
+    for (int k = 0; k < 3; k++) {
+      if (fabs(vtx_coords[i*3 + k] - _node_coords[i][k]) > 1e-12)
+        n_errors += 1;
+    }
+  }
+
+  /* Faces: adjacency, vertices, and orientation (outwards relative to the
+     first adjacent cell) */
+
+  double cell_cen[N_CELLS][3];
+
+  for (int i = 0; i < N_CELLS; i++) {
+    for (int k = 0; k < 3; k++) {
+      cell_cen[i][k] = 0;
+      for (int j = 0; j < _cell_n_vtx[i]; j++)
+        cell_cen[i][k] += _node_coords[_cell_vtx[i][j] - 1][k];
+      cell_cen[i][k] /= _cell_n_vtx[i];
+    }
+  }
+
+  int n_i_faces[3] = {0, 0, 0}, n_inlet = 0;
+
+  for (int f_id = 0; f_id < N_FACES; f_id++) {
+
+    cs_gnum_t c0 = face_cells[f_id*2], c1 = face_cells[f_id*2 + 1];
+    cs_gnum_t s_id = face_vtx_idx[f_id] - 1, e_id = face_vtx_idx[f_id+1] - 1;
+    int n_f_vtx = e_id - s_id;
+
+    if (c0 < 1 || c0 > N_CELLS || c1 > N_CELLS || n_f_vtx < 3) {
+      n_errors += 1;
+      continue;
+    }
+
+    /* Interior faces: hex-prism, hex-pyramid, pyramid-tetrahedron */
+
+    if (c1 > 0) {
+      if (c0 == 1 && c1 == 2 && n_f_vtx == 4)
+        n_i_faces[0] += 1;
+      else if (c0 == 1 && c1 == 3 && n_f_vtx == 4)
+        n_i_faces[1] += 1;
+      else if (c0 == 3 && c1 == 4 && n_f_vtx == 3)
+        n_i_faces[2] += 1;
+      else
+        n_errors += 1;
+    }
+
+    /* Face element group class */
+
+    if (face_gc_id[f_id] == 1) {
+      cs_gnum_t v_sum = 0;
+      for (cs_gnum_t j = s_id; j < e_id; j++)
+        v_sum += face_vtx[j];
+      if (c0 != 1 || c1 != 0 || n_f_vtx != 4 || v_sum != 1+2+3+4)
+        n_errors += 1;
+      n_inlet += 1;
+    }
+    else if (face_gc_id[f_id] != n_gc)
+      n_errors += 1;
+
+    /* Orientation */
+
+    double f_cen[3] = {0, 0, 0}, f_n[3] = {0, 0, 0};
+
+    for (int j = 0; j < n_f_vtx; j++) {
+      const cs_real_t *v0 = vtx_coords + (face_vtx[s_id + j] - 1)*3;
+      const cs_real_t *v1
+        = vtx_coords + (face_vtx[s_id + (j+1)%n_f_vtx] - 1)*3;
+      f_n[0] += (v0[1] - v1[1]) * (v0[2] + v1[2]);
+      f_n[1] += (v0[2] - v1[2]) * (v0[0] + v1[0]);
+      f_n[2] += (v0[0] - v1[0]) * (v0[1] + v1[1]);
+      for (int k = 0; k < 3; k++)
+        f_cen[k] += v0[k] / n_f_vtx;
+    }
+
+    double d = 0;
+    for (int k = 0; k < 3; k++)
+      d += f_n[k] * (f_cen[k] - cell_cen[c0 - 1][k]);
+
+    if (d <= 0)
+      n_errors += 1;
+
+  }
+
+  if (n_i_faces[0] != 1 || n_i_faces[1] != 1 || n_i_faces[2] != 1)
+    n_errors += 1;
+  if (n_inlet != 1)
+    n_errors += 1;
+
+  BFT_FREE(vtx_coords);
+  BFT_FREE(face_vtx);
+  BFT_FREE(face_vtx_idx);
+  BFT_FREE(face_cells);
+  BFT_FREE(face_gc_id);
+  BFT_FREE(cell_gc_id);
+  BFT_FREE(gc_properties);
+  BFT_FREE(group);
+  BFT_FREE(group_idx);
+
+  return n_errors;
+}
+
+/*---------------------------------------------------------------------------*/
+
+int
+main (int argc, char *argv[])
+{
+  char mem_trace_name[32];
+  int rank = 0;
+  volatile int retval = EXIT_SUCCESS;
+
+  const char msh_path[] = "cs_mesh_import_test.msh";
+  const char out_path[] = "cs_mesh_import_test.mesh_input";
+
+#if defined(HAVE_MPI)
+
+  /* Initialization */
+
+  cs_base_mpi_init(&argc, &argv);
+
+  if (cs_glob_mpi_comm != MPI_COMM_NULL)
+    MPI_Comm_rank(cs_glob_mpi_comm, &rank);
+
+#else
+
+  CS_UNUSED(argc);
+  CS_UNUSED(argv);
+
+#endif /* (HAVE_MPI) */
+
+  bft_error_handler_set(_bft_error_handler);
+  bft_printf_proxy_set(_bft_printf_proxy);
+  bft_printf_flush_proxy_set(_bft_printf_flush_proxy);
+
+  sprintf(mem_trace_name, "cs_mesh_import_test_mem.%d", rank);
+  bft_mem_init(mem_trace_name);
+
+  /* Use small file blocks, so that records are distributed over ranks */
+
+#if defined(HAVE_MPI)
+  cs_file_set_default_comm(1, 0, cs_glob_mpi_comm);
+#endif
+
+  /* Valid mesh, in ASCII, binary, and byte-swapped binary formats */
+
+  static const char *format_name[3] = {"ASCII", "binary", "swapped binary"};
+
+  for (volatile int format = 0; format < 3; format++) {
+
+    if (format == 0)
+      _write_msh(msh_path, 0);
+    else
+      _write_msh_binary(msh_path, (format == 2));
+
+    if (setjmp(_error_env) == 0) {
+      cs_mesh_import_gmsh(msh_path, out_path);
+      int n_errors = _check_mesh_input(out_path);
+      if (n_errors > 0) {
+        printf("ERROR in imported %s mesh: %d errors\n",
+               format_name[format], n_errors);
+        retval = EXIT_FAILURE;
+      }
+      else if (rank == 0)
+        printf("  mixed-element %s mesh import test OK\n",
+               format_name[format]);
+    }
+    else {
+      printf("ERROR: unexpected error importing valid %s mesh\n",
+             format_name[format]);
+      retval = EXIT_FAILURE;
+    }
+
+  }
+
+  /* Malformed meshes; errors detected by a single rank would leave
+     other ranks waiting, so these are only checked in serial mode.
+     Memory allocated before each error is not freed. */
+
+  if (cs_glob_n_ranks == 1) {
+
+    for (volatile int variant = 1; variant < 6; variant++) {
+
+      int n_errors_prev = _n_errors;
+
+      _write_msh(msh_path, variant);
+
+      if (setjmp(_error_env) == 0)
+        cs_mesh_import_gmsh(msh_path, out_path);
+
+      if (_n_errors == n_errors_prev) {
+        printf("ERROR: malformed mesh %d not reported\n", variant);
+        retval = EXIT_FAILURE;
+      }
+
+    }
+
+    if (retval == EXIT_SUCCESS)
+      printf("  malformed mesh errors test OK\n");
+
+  }
+
+  bft_mem_end();
+
+#if defined(HAVE_MPI)
+  {
+    int mpi_flag;
+    MPI_Initialized(&mpi_flag);
+    if (mpi_flag != 0)
+      MPI_Finalize();
+  }
+#endif
+
+  exit(retval);
+}
@@ -0,0 +1,436 @@
+/*============================================================================
+ * Unit test for weighted and multi-constraint partitioning.
+ *============================================================================*/
+
+/*
+  This file is part of Code_Saturne, a general-purpose CFD tool.
+
+  Copyright (C) 1998-2020 EDF S.A.
+
+  This program is free software; you can redistribute it and/or modify it under
+  the terms of the GNU General Public License as published by the Free Software
+  Foundation; either version 2 of the License, or (at your option) any later
+  version.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along with
+  this program; if not, write to the Free Software Foundation, Inc., 51 Franklin
+  Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/*----------------------------------------------------------------------------*/
+
+#include "cs_defs.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <bft_error.h>
+#include <bft_mem.h>
+#include <bft_printf.h>
+
+#include "cs_base.h"
+#include "cs_block_dist.h"
+#include "cs_mesh.h"
+#include "cs_mesh_builder.h"
+#include "cs_parall.h"
+#include "cs_partition.h"
+
+/*---------------------------------------------------------------------------*/
+
+/* Structured mesh dimensions */
+
+#define NX 24
+#define NY 16
+#define NZ 12
+
+/* Number of partitions in serial mode */
+
+#define N_PARTS_SERIAL 3
+
+/* Tolerated ratio of maximum to mean partition weight */
+
+#define MAX_IMBALANCE 1.05
+
+/*----------------------------------------------------------------------------
+ * Print message on standard output
+ *----------------------------------------------------------------------------*/
+
+static int _bft_printf_proxy
+(
+ const char     *const format,
+       va_list         arg_ptr
+)
+{
+  static FILE *f = NULL;
+
+  if (f == NULL) {
+    char filename[64];
+    int rank = 0;
+#if defined(HAVE_MPI)
+    if (cs_glob_mpi_comm != MPI_COMM_NULL)
+      MPI_Comm_rank(cs_glob_mpi_comm, &rank);
+#endif
+    sprintf (filename, "cs_partition_test_out.%d", rank);
+    f = fopen(filename, "w");
+    assert(f != NULL);
+  }
+
+  return vfprintf(f, format, arg_ptr);
+}
+
+/*----------------------------------------------------------------------------
+ * Stop the code in case of error
+ *----------------------------------------------------------------------------*/
+
+static void
+_bft_error_handler(const char  *filename,
+                   int          line_no,
+                   int          code_err_sys,
+                   const char  *format,
+                   va_list      arg_ptr)
+{
+  CS_UNUSED(filename);
+  CS_UNUSED(line_no);
+
+  bft_printf_flush();
+
+  if (code_err_sys != 0)
+    fprintf(stderr, "\nSystem error: %s\n", strerror(code_err_sys));
+
+  vfprintf(stderr, format, arg_ptr);
+  fprintf(stderr, "\n");
+
+  exit(EXIT_FAILURE);
+}
+
+/*----------------------------------------------------------------------------
+ * Return the number of particles used for a given cell.
+ *
+ * Particles are located in the x < NX/4 part of the domain only, with
+ * a varying count per cell, so balancing the sum of cell and particle
+ * weights would not balance each of them.
+ *----------------------------------------------------------------------------*/
+
+static cs_lnum_t
+_cell_particle_count(cs_gnum_t  cell_gnum)
+{
+  cs_gnum_t c_id = cell_gnum - 1;
+  cs_gnum_t i = c_id % NX;
+  cs_gnum_t j = (c_id / NX) % NY;
+  cs_gnum_t k = c_id / (NX*NY);
+
+  if (i >= NX/4)
+    return 0;
+
+  return 1 + (i + 2*j + 3*k) % 7;
+}
+
+/*----------------------------------------------------------------------------
+ * Return global vertex number matching structured indexes.
+ *----------------------------------------------------------------------------*/
+
+static inline cs_gnum_t
+_vtx_num(cs_gnum_t  i,
+         cs_gnum_t  j,
+         cs_gnum_t  k)
+{
+  return 1 + i + (NX+1)*(j + (NY+1)*k);
+}
+
+/*----------------------------------------------------------------------------
+ * Build block-distributed mesh builder data for a structured hexahedral
+ * mesh of NX.NY.NZ cells.
+ *
+ * parameters:
+ *   mesh <-> associated mesh (global sizes are set)
+ *   mb   <-> mesh builder
+ *----------------------------------------------------------------------------*/
+
+static void
+_build_structured_mesh(cs_mesh_t          *mesh,
+                       cs_mesh_builder_t  *mb)
+{
+  const int rank_id = CS_MAX(cs_glob_rank_id, 0);
+  const int n_ranks = cs_glob_n_ranks;
+
+  const cs_gnum_t n_x_faces = (NX+1)*NY*NZ;
+  const cs_gnum_t n_y_faces = NX*(NY+1)*NZ;
+  const cs_gnum_t n_z_faces = NX*NY*(NZ+1);
+
+  mesh->n_g_cells = NX*NY*NZ;
+  mesh->n_g_vertices = (NX+1)*(NY+1)*(NZ+1);
+
+  mb->n_g_faces = n_x_faces + n_y_faces + n_z_faces;
+  mb->n_g_face_connect_size = mb->n_g_faces*4;
+  mb->n_perio = 0;
+  mb->min_rank_step = 1;
+
+  mb->cell_bi = cs_block_dist_compute_sizes(rank_id, n_ranks, 1, 0,
+                                            mesh->n_g_cells);
+  mb->face_bi = cs_block_dist_compute_sizes(rank_id, n_ranks, 1, 0,
+                                            mb->n_g_faces);
+  mb->vertex_bi = cs_block_dist_compute_sizes(rank_id, n_ranks, 1, 0,
+                                              mesh->n_g_vertices);
+
+  /* Faces */
+
+  cs_lnum_t n_faces = mb->face_bi.gnum_range[1] - mb->face_bi.gnum_range[0];
+
+  BFT_MALLOC(mb->face_cells, n_faces*2, cs_gnum_t);
+  BFT_MALLOC(mb->face_vertices_idx, n_faces + 1, cs_lnum_t);
+  BFT_MALLOC(mb->face_vertices, n_faces*4, cs_gnum_t);
+
+  mb->face_vertices_idx[0] = 0;
+
+  for (cs_lnum_t f_id = 0; f_id < n_faces; f_id++) {
+
+    cs_gnum_t f = mb->face_bi.gnum_range[0] + f_id - 1;
+    cs_gnum_t i, j, k;
+    cs_gnum_t *c = mb->face_cells + f_id*2;
+    cs_gnum_t *v = mb->face_vertices + f_id*4;
+
+    if (f < n_x_faces) {
+      i = f % (NX+1); j = (f / (NX+1)) % NY; k = f / ((NX+1)*NY);
+      c[0] = (i > 0) ? 1 + (i-1) + NX*(j + NY*k) : 0;
+      c[1] = (i < NX) ? 1 + i + NX*(j + NY*k) : 0;
+      v[0] = _vtx_num(i, j, k);   v[1] = _vtx_num(i, j+1, k);
+      v[2] = _vtx_num(i, j+1, k+1); v[3] = _vtx_num(i, j, k+1);
+    }
+    else if (f < n_x_faces + n_y_faces) {
+      f -= n_x_faces;
+      i = f % NX; j = (f / NX) % (NY+1); k = f / (NX*(NY+1));
+      c[0] = (j > 0) ? 1 + i + NX*((j-1) + NY*k) : 0;
+      c[1] = (j < NY) ? 1 + i + NX*(j + NY*k) : 0;
+      v[0] = _vtx_num(i, j, k);   v[1] = _vtx_num(i, j, k+1);
+      v[2] = _vtx_num(i+1, j, k+1); v[3] = _vtx_num(i+1, j, k);
+    }
+    else {
+      f -= n_x_faces + n_y_faces;
+      i = f % NX; j = (f / NX) % NY; k = f / (NX*NY);
+      c[0] = (k > 0) ? 1 + i + NX*(j + NY*(k-1)) : 0;
+      c[1] = (k < NZ) ? 1 + i + NX*(j + NY*k) : 0;
+      v[0] = _vtx_num(i, j, k);   v[1] = _vtx_num(i+1, j, k);
+      v[2] = _vtx_num(i+1, j+1, k); v[3] = _vtx_num(i, j+1, k);
+    }
+
+    mb->face_vertices_idx[f_id + 1] = (f_id + 1)*4;
+
+  }
+
+  /* Vertices */
+
+  cs_lnum_t n_vertices
+    = mb->vertex_bi.gnum_range[1] - mb->vertex_bi.gnum_range[0];
+
+  BFT_MALLOC(mb->vertex_coords, n_vertices*3, cs_real_t);
+
+  for (cs_lnum_t v_id = 0; v_id < n_vertices; v_id++) {
+    cs_gnum_t v = mb->vertex_bi.gnum_range[0] + v_id - 1;
+    mb->vertex_coords[v_id*3]     = v % (NX+1);
+    mb->vertex_coords[v_id*3 + 1] = (v / (NX+1)) % (NY+1);
+    mb->vertex_coords[v_id*3 + 2] = v / ((NX+1)*(NY+1));
+  }
+}
+
+/*----------------------------------------------------------------------------
+ * Check balance of each constraint for a given partitioning.
+ *
+ * parameters:
+ *   mb            <-- mesh builder, with cell_rank defined
+ *   n_parts       <-- number of partitions
+ *   n_constraints <-- number of weights per cell
+ *   cell_weight   <-- cell weights (interlaced), on mb->cell_bi
+ *
+ * returns:
+ *   number of errors
+ *----------------------------------------------------------------------------*/
+
+static int
+_check_balance(const cs_mesh_builder_t  *mb,
+               int                       n_parts,
+               int                       n_constraints,
+               const double              cell_weight[])
+{
+  int n_errors = 0;
+
+  cs_lnum_t n_cells = mb->cell_bi.gnum_range[1] - mb->cell_bi.gnum_range[0];
+
+  double *part_weight;
+  BFT_MALLOC(part_weight, n_parts*n_constraints, double);
+
+  for (int i = 0; i < n_parts*n_constraints; i++)
+    part_weight[i] = 0;
+
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+    int p = mb->cell_rank[c_id];
+    if (p < 0 || p >= n_parts) {
+      n_errors++;
+      continue;
+    }
+    for (int k = 0; k < n_constraints; k++)
+      part_weight[p*n_constraints + k] += cell_weight[c_id*n_constraints + k];
+  }
+
+  cs_parall_sum(n_parts*n_constraints, CS_DOUBLE, part_weight);
+  cs_parall_sum(1, CS_INT_TYPE, &n_errors);
+
+  if (n_errors > 0)
+    printf("ERROR: %d cells assigned to invalid partitions\n", n_errors);
+
+  for (int k = 0; k < n_constraints; k++) {
+
+    double w_max = 0, w_sum = 0;
+    for (int p = 0; p < n_parts; p++) {
+      double w = part_weight[p*n_constraints + k];
+      w_max = CS_MAX(w_max, w);
+      w_sum += w;
+    }
+
+    double imbalance = (w_sum > 0) ? w_max * n_parts / w_sum : 1.;
+
+    if (cs_glob_rank_id < 1)
+      printf("  constraint %d: imbalance %5.3f (%d partitions)\n",
+             k, imbalance, n_parts);
+
+    if (imbalance > MAX_IMBALANCE) {
+      if (cs_glob_rank_id < 1)
+        printf("ERROR: constraint %d imbalance above %g\n",
+               k, MAX_IMBALANCE);
+      n_errors++;
+    }
+
+  }
+
+  BFT_FREE(part_weight);
+
+  return n_errors;
+}
+
+/*----------------------------------------------------------------------------
+ * Test balance of fluid and particle constraints with space-filling
+ * curve partitioning.
+ *
+ * returns:
+ *   number of errors
+ *----------------------------------------------------------------------------*/
+
+static int
+_multi_constraint_test(void)
+{
+  /* Only global sizes of the mesh structure are used here */
+
+  cs_mesh_t mesh;
+  memset(&mesh, 0, sizeof(cs_mesh_t));
+
+  cs_mesh_builder_t *mb = cs_mesh_builder_create();
+
+  _build_structured_mesh(&mesh, mb);
+
+  cs_lnum_t n_cells = mb->cell_bi.gnum_range[1] - mb->cell_bi.gnum_range[0];
+
+  double *cell_weight, *w_ref;
+  BFT_MALLOC(cell_weight, n_cells*2, double);
+  BFT_MALLOC(w_ref, n_cells*2, double);
+
+  for (cs_lnum_t c_id = 0; c_id < n_cells; c_id++) {
+    cs_gnum_t c_num = mb->cell_bi.gnum_range[0] + c_id;
+    cell_weight[c_id*2] = 1.;
+    cell_weight[c_id*2 + 1] = _cell_particle_count(c_num);
+  }
+
+  memcpy(w_ref, cell_weight, n_cells*2*sizeof(double));
+
+  int n_parts = cs_glob_n_ranks;
+  if (n_parts < 2) {
+    int extra_partitions[] = {N_PARTS_SERIAL};
+    n_parts = N_PARTS_SERIAL;
+    cs_partition_add_partitions(1, extra_partitions);
+  }
+
+  cs_partition_set_algorithm(CS_PARTITION_MAIN,
+                             CS_PARTITION_SFC_HILBERT_CUBE,
+                             1,
+                             false);
+
+  /* Ownership of cell_weight is transferred */
+
+  cs_partition_set_cell_constraint_weights(2, cell_weight);
+
+  cs_partition(&mesh, mb, CS_PARTITION_MAIN);
+
+  int n_errors = 0;
+
+  if (mb->cell_rank == NULL) {
+    printf("ERROR: no partitioning computed\n");
+    n_errors++;
+  }
+  else
+    n_errors = _check_balance(mb, n_parts, 2, w_ref);
+
+  BFT_FREE(w_ref);
+
+  cs_mesh_builder_destroy(&mb);
+
+  return n_errors;
+}
+
+/*============================================================================
+ * Main function
+ *============================================================================*/
+
+int
+main (int argc, char *argv[])
+{
+  char mem_trace_name[32];
+  int rank = 0;
+  int retval = EXIT_SUCCESS;
+
+#if defined(HAVE_MPI)
+
+  /* Initialization */
+
+  cs_base_mpi_init(&argc, &argv);
+
+  if (cs_glob_mpi_comm != MPI_COMM_NULL)
+    MPI_Comm_rank(cs_glob_mpi_comm, &rank);
+
+#else
+
+  CS_UNUSED(argc);
+  CS_UNUSED(argv);
+
+#endif /* (HAVE_MPI) */
+
+  bft_error_handler_set(_bft_error_handler);
+  bft_printf_proxy_set(_bft_printf_proxy);
+
+  sprintf(mem_trace_name, "cs_partition_test_mem.%d", rank);
+  bft_mem_init(mem_trace_name);
+
+  if (_multi_constraint_test() > 0)
+    retval = EXIT_FAILURE;
+  else if (rank == 0)
+    printf("  multi-constraint partitioning test OK\n");
+
+  bft_mem_end();
+
+#if defined(HAVE_MPI)
+  {
+    int mpi_flag;
+    MPI_Initialized(&mpi_flag);
+    if (mpi_flag != 0)
+      MPI_Finalize();
+  }
+#endif
+
+  exit(retval);
+}
@@ -284,6 +284,77 @@ _poisson_test(cs_lnum_t   n,
   }
 }
 
+static void
+_stream_test(cs_lnum_t   n,
+             cs_real_t  *a)
+{
+  int i, k;
+  double t1, t2;
+  double x1, x2, x4;
+  cs_real_t b[4];
+  cs_random_stream_t s;
+
+  /* Known answer test (Philox4x32-10 with zero key and counter) */
+
+  const uint64_t kat[2] = {0x6627e8d5e169c58dULL, 0xbc57ac4c9b00dbd8ULL};
+
+  cs_random_stream_seed(0);
+  cs_random_stream_init(&s, 0, 0, 0);
+  cs_random_stream_uniform(&s, 4, b);
+
+  int n_err = 0;
+  for (k = 0; k < 2; k++) {
+    double ref = ((double)(kat[k] >> 11) + 0.5) / 9007199254740992.0;
+    if (memcmp(b + k, &ref, sizeof(double)))
+      n_err++;
+  }
+  if (n_err > 0)
+    printf("ERROR in counter-based stream known answer test\n");
+  else
+    printf("  counter-based stream known answer test OK\n");
+
+  /* Keyed bulk generation must match individual streams */
+
+  cs_gnum_t ids[64];
+  cs_real_t c[64*3];
+  for (i = 0; i < 64; i++)
+    ids[i] = (i*37) % 64;
+  cs_random_keyed_normal(64, ids, 1000, 7, 3, 3, c);
+
+  n_err = 0;
+  for (i = 0; i < 64; i++) {
+    cs_random_stream_init(&s, ids[i] + 1000, 7, 3);
+    cs_random_stream_normal(&s, 3, b);
+    for (k = 0; k < 3; k++) {
+      if (memcmp(b + k, c + i*3 + k, sizeof(cs_real_t)))
+        n_err++;
+    }
+  }
+  if (n_err > 0)
+    printf("ERROR in keyed bulk generation: %d differences\n", n_err);
+  else
+    printf("  keyed bulk generation test OK\n");
+
+  /* Moments */
+
+  t1 = cs_timer_wtime();
+  cs_random_keyed_normal(n, NULL, 0, 1, 0, 1, a);
+  t2 = cs_timer_wtime();
+
+  x1 = 0.; x2 = 0.; x4 = 0.;
+  for (i = 0; i < n; i++) {
+    x1 += a[i];
+    x2 += a[i]*a[i];
+    x4 += a[i]*a[i]*a[i]*a[i];
+  }
+  x1 /= (double)n; x2 /= (double)n; x4 /= (double)n;
+
+  printf("\n    Time/keyed normal = %e seconds \n", (t2 - t1)/n);
+  printf("    Moments: \n");
+  printf("      Compare to (0.0)      (1.0)      (3.0) \n");
+  printf("              %e %e %e\n", x1, x2, x4);
+}
+
 /*---------------------------------------------------------------------------*/
 
 int
@@ -336,5 +407,14 @@ main (int argc, char *argv[])
   printf("Fischer distribution for %d values in %f seconds\n",
          NPTS, wt1 - wt0);
 
+  wt0 = cs_timer_wtime();
+
+  _stream_test(NPTS, a);
+
+  wt1 = cs_timer_wtime();
+
+  printf("Counter-based streams for %d values in %f seconds\n",
+         NPTS, wt1 - wt0);
+
   exit(EXIT_SUCCESS);
 }